@@ -3206,7 +3206,8 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
 #endif // OGLFT_NO_SOLID
 
   Texture::Texture ( const char* filename, float point_size, FT_UInt resolution )
-    : Face( filename, point_size, resolution )
+    : Face( filename, point_size, resolution ),
+      atlas_x_( 0 ), atlas_y_( 0 ), atlas_row_height_( 0 ), cache_generation_( 0 )
   {
     if ( !isValid() ) return;
 
@@ -3215,7 +3216,8 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
 
   Texture::Texture ( const FT_Byte* data_base, const FT_Long data_size,
 		     float point_size, FT_UInt resolution )
-    : Face( data_base, data_size, point_size, resolution )
+    : Face( data_base, data_size, point_size, resolution ),
+      atlas_x_( 0 ), atlas_y_( 0 ), atlas_row_height_( 0 ), cache_generation_( 0 )
   {
     if ( !isValid() ) return;
 
@@ -3223,7 +3225,8 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
   }
 
   Texture::Texture ( FT_Face face, float point_size, FT_UInt resolution )
-    : Face( face, point_size, resolution )
+    : Face( face, point_size, resolution ),
+      atlas_x_( 0 ), atlas_y_( 0 ), atlas_row_height_( 0 ), cache_generation_( 0 )
   {
     init();
   }
@@ -3390,6 +3393,52 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
     }
   }
 
+  // MK: Unscaled bounding box of a glyph, as used by measure(). Returns
+  // false if the glyph can not be loaded.
+
+  bool Texture::measureGlyph ( FT_Face face, FT_UInt glyph_index, BBox& bbox )
+  {
+    FT_Error error = FT_Load_Glyph( face, glyph_index, FT_LOAD_DEFAULT );
+    if ( error != 0 )
+      return false;
+
+    FT_Glyph glyph;
+    error = FT_Get_Glyph( face->glyph, &glyph );
+    if ( error != 0 )
+      return false;
+
+    FT_BBox ft_bbox;
+    FT_Glyph_Get_CBox( glyph, ft_glyph_bbox_unscaled, &ft_bbox );
+
+    FT_Done_Glyph( glyph );
+
+    bbox = ft_bbox;
+    bbox.advance_ = face->glyph->advance;
+
+    return true;
+  }
+
+  // Adapt the bounding box of a glyph to include its underline.
+
+  void Texture::underlineBBox ( BBox& bbox )
+  {
+    float undPos = underline_position();
+    float undThicc = underline_thickness();
+
+    // Glyph's decender can be lower than underline, so only set
+    // bbox's y_min to position of underline if underline is below
+    // lowest ink of glyph.
+    if (undPos - undThicc < bbox.y_min_) {
+      bbox.y_min_ = undPos - undThicc;
+    }
+
+    // Ink of character may start after zero or end before advance,
+    // but underline is always strictly from 0 to advance. So adapt
+    // bounding box to reflect that.
+    bbox.x_min_ = 0;
+    bbox.x_max_ = bbox.advance_.dx_;
+  }
+
 #ifndef OGLFT_NO_QT
 
   BBox Texture::measure ( const QChar c )
@@ -3407,45 +3456,115 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
     if ( glyph_index == 0 )
       return bbox;
 
-    FT_Error error = FT_Load_Glyph( faces_[f].face_, glyph_index,
-				    FT_LOAD_DEFAULT );
-    if ( error != 0 )
-      return bbox;
+    if ( !measureGlyph( faces_[f].face_, glyph_index, bbox ) )
+      return BBox();
 
-    FT_Glyph glyph;
-    error = FT_Get_Glyph( faces_[f].face_->glyph, &glyph );
-    if ( error != 0 )
-      return bbox;
+    // If underline is active, adapt bounding box:
+    if (do_draw_underline_)
+      underlineBBox( bbox );
 
-    FT_BBox ft_bbox;
-    FT_Glyph_Get_CBox( glyph, ft_glyph_bbox_unscaled, &ft_bbox );
+    return bbox;
+  }
 
-    FT_Done_Glyph( glyph );
+  // MK: Lay out a string into quads for batched drawing. Positions, bounding
+  // box and advance follow exactly what draw() and measure() would do.
 
-    bbox = ft_bbox;
-    bbox.advance_ = faces_[f].face_->glyph->advance;
+  bool Texture::layout ( const QString& s, bool underline, Layout& layout,
+			 unsigned int& cache_hits, unsigned int& cache_misses )
+  {
+    if ( character_rotation_.active_ )
+      return false;
 
-    // If underline is active, adapt bounding box:
-    if (do_draw_underline_)
-    {
-      float undPos = underline_position();
-      float undThicc = underline_thickness();
+    layout.quads_.clear();
+    layout.bbox_ = BBox();
+    layout.advance_x_ = 0;
+    layout.advance_y_ = 0;
+
+    // Underlines need the white texel block of an atlas texture:
+    if ( underline && atlas_textures_.empty() )
+      newAtlasTexture();
+
+    float undPos = underline_position();
+    float undThicc = underline_thickness();
 
-      // Glyph's decender can be lower than underline, so only set
-      // bbox's y_min to position of underline if underline is below
-      // lowest ink of glyph.
-      if (undPos - undThicc < bbox.y_min_) {
-        bbox.y_min_ = undPos - undThicc;
+    for ( unsigned int i = 0; i < s.length(); i++ ) {
+      BBox char_bbox;
+      unsigned int f;
+      FT_UInt glyph_index = 0;
+
+      for ( f = 0; f < faces_.size(); f++ ) {
+	glyph_index = FT_Get_Char_Index( faces_[f].face_, s.at( i ).unicode() );
+	if ( glyph_index != 0 ) break;
       }
 
-      // Ink of character may start after zero or end before advance,
-      // but underline is always strictly from 0 to advance. So adapt
-      // bounding box to reflect that.
-      bbox.x_min_ = 0;
-      bbox.x_max_ = bbox.advance_.dx_;
+      if ( glyph_index != 0 ) {
+	GTOCI texture_object = glyph_texobjs_.find( glyph_index );
+	std::map< FT_UInt, BBox >::const_iterator bbox_object = glyph_bboxes_.find( glyph_index );
+
+	if ( texture_object != glyph_texobjs_.end() && bbox_object != glyph_bboxes_.end() ) {
+	  cache_hits++;
+	}
+	else {
+	  cache_misses++;
+
+	  if ( texture_object == glyph_texobjs_.end() ) {
+	    bindTexture( faces_[f].face_, glyph_index );
+	    texture_object = glyph_texobjs_.find( glyph_index );
+	  }
+
+	  if ( bbox_object == glyph_bboxes_.end() &&
+	       measureGlyph( faces_[f].face_, glyph_index, char_bbox ) )
+	    bbox_object = glyph_bboxes_.insert( std::make_pair( glyph_index, char_bbox ) ).first;
+	}
+
+	if ( bbox_object != glyph_bboxes_.end() ) {
+	  char_bbox = bbox_object->second;
+	  if ( underline )
+	    underlineBBox( char_bbox );
+	}
+
+	// Draw the glyph quad and its underline, and advance, like renderGlyph():
+	if ( texture_object != glyph_texobjs_.end() ) {
+	  const TextureInfo& texture_info = texture_object->second;
+	  GlyphQuad quad;
+
+	  quad.texture_name_ = texture_info.texture_name_;
+	  quad.x0_ = layout.advance_x_ + texture_info.left_bearing_;
+	  quad.y0_ = layout.advance_y_ + texture_info.bottom_bearing_;
+	  quad.x1_ = quad.x0_ + texture_info.width_;
+	  quad.y1_ = quad.y0_ + texture_info.height_;
+	  quad.s0_ = texture_info.texture_s0_;
+	  quad.t0_ = texture_info.texture_t0_;
+	  quad.s1_ = texture_info.texture_s0_ + texture_info.texture_s_;
+	  quad.t1_ = texture_info.texture_t0_ + texture_info.texture_t_;
+
+	  if ( texture_info.width_ > 0 && texture_info.height_ > 0 )
+	    layout.quads_.push_back( quad );
+
+	  if ( underline ) {
+	    quad.texture_name_ = atlas_textures_.front();
+	    quad.x0_ = layout.advance_x_;
+	    quad.y0_ = layout.advance_y_ + undPos - undThicc;
+	    quad.x1_ = layout.advance_x_ + texture_info.advance_.x / 64.f;
+	    quad.y1_ = layout.advance_y_ + undPos;
+	    quad.s0_ = quad.s1_ = 1.f / ATLAS_SIZE;
+	    quad.t0_ = quad.t1_ = 1.f / ATLAS_SIZE;
+	    layout.quads_.push_back( quad );
+	  }
+
+	  layout.advance_x_ += texture_info.advance_.x / 64.f;
+	  layout.advance_y_ += texture_info.advance_.y / 64.f;
+	}
+      }
+
+      // Accumulate the bounding box like Face::measure():
+      if ( i == 0 )
+	layout.bbox_ = char_bbox;
+      else
+	layout.bbox_ += char_bbox;
     }
 
-    return bbox;
+    return true;
   }
 #endif /* OGLFT_NO_QT */
   GLuint Texture::compileGlyph ( FT_Face face, FT_UInt glyph_index )
@@ -3509,18 +3628,21 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
 
     glBegin( GL_QUADS );
 
-    glTexCoord2i( 0, 0 );
+    GLfloat s0 = texture_info.texture_s0_;
+    GLfloat t0 = texture_info.texture_t0_;
+
+    glTexCoord2f( s0, t0 );
     glVertex2i( texture_info.left_bearing_, texture_info.bottom_bearing_ );
 
-    glTexCoord2f( texture_info.texture_s_, 0.f );
+    glTexCoord2f( s0 + texture_info.texture_s_, t0 );
     glVertex2i( texture_info.left_bearing_ + texture_info.width_,
 		texture_info.bottom_bearing_ );
 
-    glTexCoord2f( texture_info.texture_s_, texture_info.texture_t_ );
+    glTexCoord2f( s0 + texture_info.texture_s_, t0 + texture_info.texture_t_ );
     glVertex2i( texture_info.left_bearing_ + texture_info.width_,
 		texture_info.bottom_bearing_ + texture_info.height_ );
 
-    glTexCoord2f( 0.f, texture_info.texture_t_ );
+    glTexCoord2f( s0, t0 + texture_info.texture_t_ );
     glVertex2i( texture_info.left_bearing_,
 		texture_info.bottom_bearing_ + texture_info.height_ );
     
@@ -3565,10 +3687,118 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
     GTOI fti = glyph_texobjs_.begin();
 
     for ( ; fti != glyph_texobjs_.end(); ++fti ) {
-      glDeleteTextures( 1, &fti->second.texture_name_ );
+      if ( !fti->second.in_atlas_ )
+	glDeleteTextures( 1, &fti->second.texture_name_ );
     }
 
     glyph_texobjs_.clear();
+    glyph_bboxes_.clear();
+
+    if ( !atlas_textures_.empty() )
+      glDeleteTextures( (GLsizei) atlas_textures_.size(), &atlas_textures_[0] );
+
+    atlas_textures_.clear();
+    atlas_x_ = atlas_y_ = atlas_row_height_ = 0;
+
+    cache_generation_++;
+  }
+
+  // MK: Glyph images are padded, and separated by one texel from each other,
+  // so nearest neighbour sampling never picks up texels of other glyphs.
+
+  void Texture::newAtlasTexture ( void )
+  {
+    GLuint texture_name;
+
+    glGenTextures( 1, &texture_name );
+    glBindTexture( GL_TEXTURE_2D, texture_name );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+
+    // Clear to transparent black, without any pixel transfer settings
+    // of a glyph upload applied:
+    GLubyte* clear = new GLubyte[ 2 * ATLAS_SIZE * ATLAS_SIZE ];
+    memset( clear, 0, 2 * ATLAS_SIZE * ATLAS_SIZE );
+
+    glPushAttrib( GL_PIXEL_MODE_BIT );
+    glPixelTransferi( GL_MAP_COLOR, GL_FALSE );
+    glPixelTransferf( GL_RED_SCALE, 1.f );
+    glPixelTransferf( GL_GREEN_SCALE, 1.f );
+    glPixelTransferf( GL_BLUE_SCALE, 1.f );
+    glPixelTransferf( GL_ALPHA_SCALE, 1.f );
+    glPixelTransferf( GL_RED_BIAS, 0.f );
+    glPixelTransferf( GL_GREEN_BIAS, 0.f );
+    glPixelTransferf( GL_BLUE_BIAS, 0.f );
+    glPixelTransferf( GL_ALPHA_BIAS, 0.f );
+
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, ATLAS_SIZE, ATLAS_SIZE,
+		  0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, clear );
+
+    // Opaque white 2x2 texel block at the origin for underlines:
+    memset( clear, 0xff, 8 );
+    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, 2, 2,
+		     GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, clear );
+
+    glPopAttrib();
+
+    delete[] clear;
+
+    atlas_textures_.push_back( texture_name );
+    atlas_x_ = 3;
+    atlas_y_ = 0;
+    atlas_row_height_ = 2;
+  }
+
+  void Texture::storeGlyphTexture ( TextureInfo& texture_info, int width, int height,
+				    int glyph_width, int glyph_height,
+				    GLenum format, GLenum type, const GLubyte* pixels )
+  {
+    if ( width <= ATLAS_SIZE / 4 && height <= ATLAS_SIZE / 4 ) {
+      // Start a new row, or a new atlas texture, if the glyph does not fit:
+      if ( !atlas_textures_.empty() && atlas_x_ + width > ATLAS_SIZE ) {
+	atlas_x_ = 0;
+	atlas_y_ += atlas_row_height_ + 1;
+	atlas_row_height_ = 0;
+      }
+
+      if ( atlas_textures_.empty() || atlas_y_ + height > ATLAS_SIZE )
+	newAtlasTexture();
+
+      texture_info.texture_name_ = atlas_textures_.back();
+      texture_info.in_atlas_ = true;
+      texture_info.texture_s0_ = (GLfloat) atlas_x_ / ATLAS_SIZE;
+      texture_info.texture_t0_ = (GLfloat) atlas_y_ / ATLAS_SIZE;
+      texture_info.texture_s_ = (GLfloat) glyph_width / ATLAS_SIZE;
+      texture_info.texture_t_ = (GLfloat) glyph_height / ATLAS_SIZE;
+
+      glBindTexture( GL_TEXTURE_2D, texture_info.texture_name_ );
+      glTexSubImage2D( GL_TEXTURE_2D, 0, atlas_x_, atlas_y_, width, height,
+		       format, type, pixels );
+
+      atlas_x_ += width + 1;
+      if ( height > atlas_row_height_ )
+	atlas_row_height_ = height;
+
+      return;
+    }
+
+    glGenTextures( 1, &texture_info.texture_name_ );
+    glBindTexture( GL_TEXTURE_2D, texture_info.texture_name_ );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, width, height,
+		  0, format, type, pixels );
+
+    texture_info.in_atlas_ = false;
+    texture_info.texture_s0_ = 0.f;
+    texture_info.texture_t0_ = 0.f;
+    texture_info.texture_s_ = (GLfloat) glyph_width / width;
+    texture_info.texture_t_ = (GLfloat) glyph_height / height;
   }
 
   unsigned int Texture::nearestPowerCeil ( unsigned int a )
@@ -3693,13 +3923,6 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
 
     TextureInfo texture_info;
 
-    glGenTextures( 1, &texture_info.texture_name_ );
-    glBindTexture( GL_TEXTURE_2D, texture_info.texture_name_ );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
-
     // Texture maps have be a power of 2 in size (is 1 a power of 2?), so
     // pad it out while flipping it over
     int width, height;
@@ -3730,8 +3953,8 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
     glPixelMapfv( GL_PIXEL_MAP_I_TO_B, 2, blue_map );
     glPixelMapfv( GL_PIXEL_MAP_I_TO_A, 2, alpha_map );
 
-    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, width, height,
-		  0, GL_COLOR_INDEX, GL_BITMAP, inverted_pixmap );
+    storeGlyphTexture( texture_info, width, height, face->glyph->bitmap.width,
+		       face->glyph->bitmap.rows, GL_COLOR_INDEX, GL_BITMAP, inverted_pixmap );
 
     // Save a good bit of the data about this glyph
     texture_info.left_bearing_ = face->glyph->bitmap_left;
@@ -3739,8 +3962,6 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
 					- face->glyph->bitmap_top );
     texture_info.width_ = face->glyph->bitmap.width;
     texture_info.height_ = face->glyph->bitmap.rows;
-    texture_info.texture_s_ = (GLfloat)texture_info.width_ / width;
-    texture_info.texture_t_ = (GLfloat)texture_info.height_ / height;
     texture_info.advance_ = face->glyph->advance;
 
     glyph_texobjs_[ glyph_index ] = texture_info;
@@ -3817,13 +4038,6 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
 
     TextureInfo texture_info;
 
-    glGenTextures( 1, &texture_info.texture_name_ );
-    glBindTexture( GL_TEXTURE_2D, texture_info.texture_name_ );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
-
     // Texture maps have be a power of 2 in size (is 1 a power of 2?), so
     // pad it out while flipping it over
     int width, height;
@@ -3840,8 +4054,8 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
     glPixelTransferf( GL_BLUE_BIAS, background_color_[B] );
     glPixelTransferf( GL_ALPHA_BIAS, background_color_[A] );
 
-    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, width, height,
-		  0, GL_LUMINANCE, GL_UNSIGNED_BYTE, inverted_pixmap );
+    storeGlyphTexture( texture_info, width, height, face->glyph->bitmap.width,
+		       face->glyph->bitmap.rows, GL_LUMINANCE, GL_UNSIGNED_BYTE, inverted_pixmap );
 
     glPopAttrib();
     // Save a good bit of the data about this glyph
@@ -3850,8 +4064,6 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
 				      - face->glyph->bitmap_top );
     texture_info.width_ = face->glyph->bitmap.width;
     texture_info.height_ = face->glyph->bitmap.rows;
-    texture_info.texture_s_ = (GLfloat)texture_info.width_ / width;
-    texture_info.texture_t_ = (GLfloat)texture_info.height_ / height;
     texture_info.advance_ = face->glyph->advance;
 
     glyph_texobjs_[ glyph_index ] = texture_info;
@@ -3934,13 +4146,6 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
 
     TextureInfo texture_info;
 
-    glGenTextures( 1, &texture_info.texture_name_ );
-    glBindTexture( GL_TEXTURE_2D, texture_info.texture_name_ );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
-
     // Texture maps have be a power of 2 in size (is 1 a power of 2?), so
     // pad it out while flipping it over
     int width, height;
@@ -3993,8 +4198,8 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
     // glPixelTransferf( GL_BLUE_BIAS, background_color_[B] );
     // glPixelTransferf( GL_ALPHA_BIAS, background_color_[A] );
 
-    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, width, height,
-		  0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, inverted_pixmap );
+    storeGlyphTexture( texture_info, width, height, face->glyph->bitmap.width,
+		       face->glyph->bitmap.rows, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, inverted_pixmap );
 
     //glPopAttrib();
 
@@ -4004,8 +4209,6 @@ QString Face::format_number ( const QString& format, double number ) { return( Q
 					- face->glyph->bitmap_top );
     texture_info.width_ = face->glyph->bitmap.width;
     texture_info.height_ = face->glyph->bitmap.rows;
-    texture_info.texture_s_ = (GLfloat)texture_info.width_ / width;
-    texture_info.texture_t_ = (GLfloat)texture_info.height_ / height;
     texture_info.advance_ = face->glyph->advance;
 
     glyph_texobjs_[ glyph_index ] = texture_info;
@@ -1982,13 +1982,19 @@ namespace OGLFT {
      * since we have to remember the size of the texture object itself
      * (at least implicitly). Also, we don't want to create any more
      * texture objects than we have to, so they are always cached.
+     * MK: Small glyphs share atlas textures, so the glyph occupies the
+     * rectangle from (texture_s0_, texture_t0_) to (texture_s0_ + texture_s_,
+     * texture_t0_ + texture_t_) of its texture.
      */
     struct TextureInfo {
       GLuint texture_name_;  //!< A bound texture name is an integer in OpenGL.
+      bool in_atlas_;        //!< Is texture_name_ a shared atlas texture?
       FT_Int left_bearing_,  //!< The left bearing of the transformed glyph.
 	bottom_bearing_;     //!< The bottom bearing of the transformed glyph.
       int width_,	     //!< The 2**l width of the texture.
 	height_;	     //!< The 2**m height of the texture.
+      GLfloat texture_s0_,   //!< The texture s coordinate of the glyph origin.
+	texture_t0_;	     //!< The texture t coordinate of the glyph origin.
       GLfloat texture_s_,    //!< The fraction of the texture width occupied
 			     //!< by the glyph.
 	texture_t_;	     //!< The fraction of the texture height occupied
@@ -2010,7 +2016,43 @@ namespace OGLFT {
     //! Cache of defined glyph texture objects.
     GlyphTexObjs glyph_texobjs_;
 
+    //! Cache of the measured bounding boxes of glyphs, used by layout().
+    std::map< FT_UInt, BBox > glyph_bboxes_;
+
+    //! Width and height of the atlas textures. Glyphs whose (padded) image
+    //! is larger than a quarter of this get a texture of their own.
+    static const int ATLAS_SIZE = 512;
+
+    //! Atlas textures into which the glyph images are packed, row by row.
+    //! The last one is the one currently being filled.
+    std::vector< GLuint > atlas_textures_;
+
+    //! Position of the next free spot in the current atlas texture, and
+    //! height of its current row of glyphs.
+    int atlas_x_, atlas_y_, atlas_row_height_;
+
+    //! Incremented whenever the cached glyph textures are deleted, so
+    //! users of layout() results can detect stale texture names.
+    unsigned int cache_generation_;
+
   public:
+    //! A textured quad for one glyph, or for the underline of one glyph,
+    //! relative to the origin of the string.
+    struct GlyphQuad {
+      GLuint texture_name_;	//!< Texture of the glyph.
+      GLfloat x0_, y0_, x1_, y1_;	//!< Lower left and upper right corner.
+      GLfloat s0_, t0_, s1_, t1_;	//!< Texture coordinates of the corners.
+    };
+
+    //! The result of laying out a string with layout().
+    struct Layout {
+      std::vector< GlyphQuad > quads_;	//!< Quads in drawing order.
+      BBox bbox_;			//!< Same as measure() of the string.
+      GLfloat advance_x_,		//!< MODELVIEW advance of draw() of
+	advance_y_;			//!< the string.
+    };
+
+
     /*!
      * \param filename the filename which contains the font face.
      * \param point_size the initial point size of the font to generate. A point
@@ -2120,9 +2162,55 @@ namespace OGLFT {
      */
     OGLFT_API BBox measure ( const QString& format, double number )
     { return Face::measure( format, number ); }
+
+    /*!
+     * MK: Lay out a string into a list of textured quads, which can be drawn
+     * in a batch by the caller with the current MODELVIEW set up as for
+     * draw(). Glyphs which are not yet cached get rendered into the atlas
+     * textures. Underline quads map to an opaque white texel, so they can
+     * be drawn in the same batch as the glyphs. This does not depend on,
+     * or change, the foreground color or underline setting of the face, so
+     * it does not clear any caches.
+     * \param s the (UNICODE) string to lay out.
+     * \param underline true to underline the string.
+     * \param layout receives the quads, bounding box and advance.
+     * \param cache_hits incremented for each glyph found in the cache.
+     * \param cache_misses incremented for each glyph which had to be rendered.
+     * \return false if the string can not be laid out, because character
+     * rotation is active. Use draw() then.
+     */
+    OGLFT_API bool layout ( const QString& s, bool underline, Layout& layout,
+			    unsigned int& cache_hits, unsigned int& cache_misses );
 #endif /* OGLFT_NO_QT */
 
+    /*!
+     * \return a number which changes whenever the cached glyph textures
+     * are deleted, and with them the texture names used in Layout's.
+     */
+    OGLFT_API unsigned int cacheGeneration ( void ) const { return cache_generation_; }
+
   protected:
+    /*!
+     * Store the (padded) image of a glyph in a texture: Packed into the
+     * current atlas texture if it is small enough, otherwise in a texture
+     * of its own. Fills in the texture name and coordinates of texture_info.
+     * \param texture_info receives the texture name and coordinates.
+     * \param width width of the padded image.
+     * \param height height of the padded image.
+     * \param glyph_width width of the glyph in the image.
+     * \param glyph_height height of the glyph in the image.
+     * \param format pixel format of the image.
+     * \param type pixel type of the image.
+     * \param pixels the image.
+     */
+    void storeGlyphTexture ( TextureInfo& texture_info, int width, int height,
+			     int glyph_width, int glyph_height,
+			     GLenum format, GLenum type, const GLubyte* pixels );
+    /*!
+     * Start a new, cleared, atlas texture, with an opaque white texel block
+     * at its origin for drawing underlines.
+     */
+    void newAtlasTexture ( void );
     /*!
      * OpenGL texture maps have to be a power of 2 in width and height (including
      * apparently 1 = 2**0 ). This function returns the next higher power of
@@ -2145,6 +2233,8 @@ namespace OGLFT {
     void init ( void );
     void setCharSize ( void );
     void setRotationOffset ( void );
+    bool measureGlyph ( FT_Face face, FT_UInt glyph_index, BBox& bbox );
+    void underlineBBox ( BBox& bbox );
     GLuint compileGlyph ( FT_Face face, FT_UInt glyph_index );
     void renderGlyph ( FT_Face face, FT_UInt glyph_index );
     void clearCaches ( void );
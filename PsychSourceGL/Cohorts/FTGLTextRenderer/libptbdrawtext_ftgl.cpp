@@ -6,6 +6,8 @@
  *
  * - Texture mapped renderer.
  * - Fast due to texture object and display list caching for fast glyph recycling.
+ * - Glyphs packed into atlas textures, and a LRU cache of laid out strings, so drawing
+ *   a string usually takes a single batch of textured quads.
  * - Good text layouting.
  * - Supports all Freetype-2 supported fonts, e.g., vectorgraphics TrueType fonts.
  * - Anti-Aliased drawing via Alpha-Blending.
@@ -62,6 +64,11 @@
 #include <stdio.h>
 #include <string.h>
 
+// Containers for the layout cache:
+#include <list>
+#include <map>
+#include <string>
+
 // Include all GLFT and QT stuff:
 #include "OGLFT.h"
 
@@ -88,6 +95,11 @@
 // 10 fullscreen onscreen windows, so guaranteeing for 10 onscreen windows should be good enough.
 #define MIN_GUARANTEED_CONTEXTS 10
 
+// Maximum number of laid out text strings to remember per font cache slot. Drawing or measuring
+// one of these strings again skips glyph lookup and layout, and just reuses the cached quads.
+// If usercode draws more different strings with one font setting, LRU replacement is used.
+#define MAX_LAYOUT_CACHE_ITEMS 256
+
 unsigned int nowtime = 0;
 unsigned int hitcount = 0;
 unsigned int _verbosity = 2;
@@ -106,6 +118,32 @@ FT_Vector _vector;
 double _xp;
 double _yp;
 
+// One laid out text string, with its quads as interleaved vertex array of x, y, s, t
+// coordinates, and the runs of quads which use the same texture:
+typedef struct layoutCacheItem_t {
+    std::string key;
+    unsigned int cacheGeneration;
+    OGLFT::Texture::Layout layout;
+    std::vector<GLfloat> vertices;
+    std::vector< std::pair<GLuint, GLsizei> > runs;
+} layoutCacheItem;
+
+// LRU cache of laid out strings, most recently used first, plus index by key:
+typedef std::list<layoutCacheItem> layoutCacheList;
+typedef struct layoutCache_t {
+    layoutCacheList items;
+    std::map<std::string, layoutCacheList::iterator> index;
+} layoutCache;
+
+// Glyph and layout cache statistics of one context, for PsychGetTextCacheStats():
+typedef struct textCacheStats_t {
+    double glyphHits;
+    double glyphMisses;
+    double layoutHits;
+    double layoutMisses;
+} textCacheStats;
+std::map<int, textCacheStats> cacheStats;
+
 typedef struct fontCacheItem_t {
     int contextId;
     unsigned int timestamp;
@@ -119,6 +157,7 @@ typedef struct fontCacheItem_t {
     OGLFT::TranslucentTexture    *faceT;
     OGLFT::MonochromeTexture    *faceM;
     FT_Face ft_face;
+    layoutCache* layouts;
 } fontCacheItem;
 fontCacheItem cache[MAX_CACHE_SLOTS];
 
@@ -151,6 +190,7 @@ OGLFT_API void PsychSetTextVerbosity(unsigned int verbosity);
 OGLFT_API void PsychSetTextAntiAliasing(int context, int antiAliasing);
 OGLFT_API void PsychSetAffineTransformMatrix(int context, double matrix[2][3]);
 OGLFT_API void PsychGetTextCursor(int context, double* xp, double* yp, double* height);
+OGLFT_API int PsychGetTextCacheStats(int context, double* glyphHits, double* glyphMisses, double* layoutHits, double* layoutMisses);
 
 fontCacheItem* getForContext(int contextId)
 {
@@ -242,6 +282,91 @@ fontCacheItem* getForContext(int contextId)
     return(fi);
 }
 
+// Return laid out text string for the font objects of slot fi, either from the LRU layout cache
+// of fi, or by laying it out and adding it to the cache. Returns NULL if the string can not be
+// laid out, and must be measured and drawn glyph by glyph the classic way:
+layoutCacheItem* getLayout(int context, fontCacheItem* fi, int textLen, double* text)
+{
+    int i;
+    unsigned int c, glyphHits = 0, glyphMisses = 0;
+    OGLFT::Texture* face = (fi->faceT) ? (OGLFT::Texture*) fi->faceT : (OGLFT::Texture*) fi->faceM;
+    textCacheStats* stats = &cacheStats[context];
+    bool underline = !!(_fontStyle & 4);
+    QChar* myUniChars;
+
+    if (!fi->layouts) fi->layouts = new layoutCache;
+
+    // Key is the underline flag and the unicode text:
+    std::string key(1, (underline) ? 'u' : ' ');
+    for (i = 0; i < textLen; i++) {
+        c = (unsigned int) text[i];
+        key.append((const char*) &c, sizeof(c));
+    }
+
+    std::map<std::string, layoutCacheList::iterator>::iterator hit = fi->layouts->index.find(key);
+    if (hit != fi->layouts->index.end()) {
+        // Cached, and its textures are still alive? Move to front of LRU list and return it:
+        if (hit->second->cacheGeneration == face->cacheGeneration()) {
+            fi->layouts->items.splice(fi->layouts->items.begin(), fi->layouts->items, hit->second);
+            stats->layoutHits++;
+            return(&(fi->layouts->items.front()));
+        }
+
+        // Stale. Remove it:
+        fi->layouts->items.erase(hit->second);
+        fi->layouts->index.erase(hit);
+    }
+
+    stats->layoutMisses++;
+
+    // Synthesize Unicode QString from double vector:
+    myUniChars = new QChar[textLen];
+    for(i = 0; i < textLen; i++) {
+        myUniChars[i] = QChar((unsigned int) text[i]);
+    }
+
+    QString uniCodeText = QString(myUniChars, textLen);
+    delete [] myUniChars;
+
+    fi->layouts->items.push_front(layoutCacheItem());
+    layoutCacheItem* item = &(fi->layouts->items.front());
+
+    if (!face->layout(uniCodeText, underline, item->layout, glyphHits, glyphMisses)) {
+        fi->layouts->items.pop_front();
+        return(NULL);
+    }
+
+    stats->glyphHits += glyphHits;
+    stats->glyphMisses += glyphMisses;
+
+    // Convert quads into vertex array, and find runs of quads with the same texture:
+    item->key = key;
+    item->cacheGeneration = face->cacheGeneration();
+    item->vertices.reserve(item->layout.quads_.size() * 16);
+    for (std::vector<OGLFT::Texture::GlyphQuad>::iterator q = item->layout.quads_.begin(); q != item->layout.quads_.end(); ++q) {
+        GLfloat v[16] = { q->x0_, q->y0_, q->s0_, q->t0_,  q->x1_, q->y0_, q->s1_, q->t0_,
+                          q->x1_, q->y1_, q->s1_, q->t1_,  q->x0_, q->y1_, q->s0_, q->t1_ };
+        item->vertices.insert(item->vertices.end(), v, v + 16);
+
+        if (item->runs.empty() || (item->runs.back().first != q->texture_name_))
+            item->runs.push_back(std::make_pair(q->texture_name_, (GLsizei) 0));
+
+        item->runs.back().second += 4;
+    }
+
+    fi->layouts->index[key] = fi->layouts->items.begin();
+
+    // LRU replacement if cache is full:
+    if (fi->layouts->items.size() > MAX_LAYOUT_CACHE_ITEMS) {
+        fi->layouts->index.erase(fi->layouts->items.back().key);
+        fi->layouts->items.pop_back();
+    }
+
+    if (_verbosity > 15) fprintf(stdout, "libptbdrawtext_ftgl: Layout cache miss for contextId %i. Text laid out into %i quads in %i batches.\n", context, (int) item->layout.quads_.size(), (int) item->runs.size());
+
+    return(item);
+}
+
 void PsychSetTextVerbosity(unsigned int verbosity)
 {
     _verbosity = verbosity;
@@ -275,6 +400,10 @@ int PsychRebuildFont(fontCacheItem* fi)
         fi->ft_face = NULL;
     }
 
+    // Laid out strings refer to the textures of the old font object:
+    delete(fi->layouts);
+    fi->layouts = NULL;
+
     if (_useOwnFontmapper) {
         FcResult result = FcResultMatch; // Must init this due to weirdness in libfontconfig...
         FcPattern* target = NULL;
@@ -539,8 +668,10 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
 {
     int i;
     GLuint ti;
+    GLint first;
     QChar* myUniChars;
     GLdouble modelview[4][4];
+    layoutCacheItem* item;
 
     // On first invocation after init we need to generate a useless texture object.
     // This is a weird workaround for some weird bug somewhere in FTGL...
@@ -554,14 +685,9 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
     fontCacheItem *fi = getForContext(context);
     if (!fi) return(1);
 
-    // Synthesize Unicode QString from double vector:
-    myUniChars = new QChar[textLen];
-    for(i = 0; i < textLen; i++) {
-        myUniChars[i] = QChar((unsigned int) text[i]);
-    }
-
-    QString uniCodeText = QString(myUniChars, textLen);
-    delete [] myUniChars;
+    // Get laid out text from the layout cache, or lay it out. NULL means
+    // it can't be laid out and has to be drawn glyph by glyph via OGLFT:
+    item = getLayout(context, fi, textLen, text);
 
     glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
     glPushAttrib(GL_ALL_ATTRIB_BITS);
@@ -580,27 +706,39 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
     glScaled(1., -1., 1.);
     glTranslated(0, -yStart, 0.);
 
-    // Set text color: This will be filtered by OGLFT for redundant settings:
-    if (fi->faceT) {
-        fi->faceT->setForegroundColor( _fgcolor[0], _fgcolor[1], _fgcolor[2], _fgcolor[3]);
-    }
-    else {
-        fi->faceM->setForegroundColor( _fgcolor[0], _fgcolor[1], _fgcolor[2], _fgcolor[3]);
-    }
+    // The classic path needs text color and underlining as face settings. Changing
+    // these clears all glyph caches of the face, so the layout path avoids them:
+    if (!item) {
+        // Set text color: This will be filtered by OGLFT for redundant settings:
+        if (fi->faceT) {
+            fi->faceT->setForegroundColor( _fgcolor[0], _fgcolor[1], _fgcolor[2], _fgcolor[3]);
+        }
+        else {
+            fi->faceM->setForegroundColor( _fgcolor[0], _fgcolor[1], _fgcolor[2], _fgcolor[3]);
+        }
 
-    // Enable or disable underlining, depending on requested style:
-    if (fi->faceT) {
-        fi->faceT->setDoUnderLine(!!(_fontStyle & 4));
-    }
-    else if (fi->faceM) {
-        fi->faceM->setDoUnderLine(!!(_fontStyle & 4));
+        // Enable or disable underlining, depending on requested style:
+        if (fi->faceT) {
+            fi->faceT->setDoUnderLine(!!(_fontStyle & 4));
+        }
+        else if (fi->faceM) {
+            fi->faceM->setDoUnderLine(!!(_fontStyle & 4));
+        }
     }
 
     // Rendering of background quad requested? -- True if background alpha > 0.
     if (_bgcolor[3] > 0) {
         // Yes. Compute bounding box of "to be drawn" text and render a quad in background color:
         float xmin, ymin, xmax, ymax, xadvance;
-        PsychMeasureText(context, textLen, text, &xmin, &ymin, &xmax, &ymax, &xadvance);
+        if (item) {
+            xmin = item->layout.bbox_.x_min_;
+            ymin = item->layout.bbox_.y_min_;
+            xmax = item->layout.bbox_.x_max_;
+            ymax = item->layout.bbox_.y_max_;
+        }
+        else {
+            PsychMeasureText(context, textLen, text, &xmin, &ymin, &xmax, &ymax, &xadvance);
+        }
         glColor4fv(&(_bgcolor[0]));
         glRectf(xmin + xStart, ymin + yStart, xmax + xStart, ymax + yStart);
     }
@@ -612,11 +750,45 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
 
     // Draw the text at selected start location:
     glPushMatrix();
-    if (fi->faceT) {
-        fi->faceT->draw(xStart, yStart, uniCodeText);
+    if (item) {
+        // Draw quads of laid out text, one batch per run of quads with the same
+        // texture, then advance GL_MODELVIEW like OGLFT's draw() would do:
+        glTranslatef(xStart, yStart, 0.);
+        glColor4fv(&(_fgcolor[0]));
+
+        if (!item->vertices.empty()) {
+            glVertexPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &(item->vertices[0]));
+            glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &(item->vertices[2]));
+            glEnableClientState(GL_VERTEX_ARRAY);
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            glDisableClientState(GL_COLOR_ARRAY);
+
+            first = 0;
+            for (i = 0; i < (int) item->runs.size(); i++) {
+                glBindTexture(GL_TEXTURE_2D, item->runs[i].first);
+                glDrawArrays(GL_QUADS, first, item->runs[i].second);
+                first += item->runs[i].second;
+            }
+        }
+
+        glTranslatef(item->layout.advance_x_, item->layout.advance_y_, 0.);
     }
     else {
-        fi->faceM->draw(xStart, yStart, uniCodeText);
+        // Synthesize Unicode QString from double vector:
+        myUniChars = new QChar[textLen];
+        for(i = 0; i < textLen; i++) {
+            myUniChars[i] = QChar((unsigned int) text[i]);
+        }
+
+        QString uniCodeText = QString(myUniChars, textLen);
+        delete [] myUniChars;
+
+        if (fi->faceT) {
+            fi->faceT->draw(xStart, yStart, uniCodeText);
+        }
+        else {
+            fi->faceM->draw(xStart, yStart, uniCodeText);
+        }
     }
 
     // Extract final text cursor position from GL_MODELVIEW matrix:
@@ -644,33 +816,43 @@ int PsychMeasureText(int context, int textLen, double* text, float* xmin, float*
 {
     int i;
     QChar* myUniChars;
+    OGLFT::BBox box;
+    layoutCacheItem* item;
 
     // Check if rebuild of font face needed due to parameter
     // change. Reload/Rebuild font face if so, check for errors:
     fontCacheItem *fi = getForContext(context);
     if (!fi) return(1);
 
-    // Synthesize Unicode QString from double vector:
-    myUniChars = new QChar[textLen];
-    for(i = 0; i < textLen; i++) {
-        myUniChars[i] = QChar((unsigned int) text[i]);
+    // Get bounding box of laid out text from the layout cache, or lay it out,
+    // so a following PsychDrawText() of the same text will find it cached:
+    item = getLayout(context, fi, textLen, text);
+    if (item) {
+        box = item->layout.bbox_;
     }
+    else {
+        // Synthesize Unicode QString from double vector:
+        myUniChars = new QChar[textLen];
+        for(i = 0; i < textLen; i++) {
+            myUniChars[i] = QChar((unsigned int) text[i]);
+        }
 
-    QString uniCodeText = QString(myUniChars, textLen);
-    delete [] myUniChars;
+        QString uniCodeText = QString(myUniChars, textLen);
+        delete [] myUniChars;
 
-    // Enable or disable underlining, depending on requested style:
-    if (fi->faceT) {
-        fi->faceT->setDoUnderLine(!!(_fontStyle & 4));
-    }
-    else if (fi->faceM) {
-        fi->faceM->setDoUnderLine(!!(_fontStyle & 4));
-    }
+        // Enable or disable underlining, depending on requested style:
+        if (fi->faceT) {
+            fi->faceT->setDoUnderLine(!!(_fontStyle & 4));
+        }
+        else if (fi->faceM) {
+            fi->faceM->setDoUnderLine(!!(_fontStyle & 4));
+        }
 
-    // Compute its bounding box:
-    glPushMatrix();
-    OGLFT::BBox box = (fi->faceT) ? fi->faceT->measure(uniCodeText) : fi->faceM->measure(uniCodeText);
-    glPopMatrix();
+        // Compute its bounding box:
+        glPushMatrix();
+        box = (fi->faceT) ? fi->faceT->measure(uniCodeText) : fi->faceM->measure(uniCodeText);
+        glPopMatrix();
+    }
 
     *xmin = box.x_min_;
     *ymin = box.y_min_;
@@ -685,6 +867,22 @@ int PsychMeasureText(int context, int textLen, double* text, float* xmin, float*
     return(0);
 }
 
+// Return glyph and layout cache statistics for context, accumulated since the
+// first text drawing or measuring on it:
+int PsychGetTextCacheStats(int context, double* glyphHits, double* glyphMisses, double* layoutHits, double* layoutMisses)
+{
+    textCacheStats stats = { 0, 0, 0, 0 };
+
+    if (cacheStats.count(context) > 0) stats = cacheStats[context];
+
+    *glyphHits = stats.glyphHits;
+    *glyphMisses = stats.glyphMisses;
+    *layoutHits = stats.layoutHits;
+    *layoutMisses = stats.layoutMisses;
+
+    return(0);
+}
+
 int PsychInitText(void)
 {
     _firstCall = true;
@@ -720,6 +918,7 @@ int PsychInitText(void)
 
     // Clear cache of all fonts instances:
     memset(&cache, 0, sizeof(cache));
+    cacheStats.clear();
     for (int i = 0; i < MAX_CACHE_SLOTS; i++) cache[i].contextId = -1;
 
     if (_verbosity > 2)    {
@@ -760,15 +959,27 @@ int PsychShutdownText(int context)
                     if (fi->ft_face) FT_Done_Face(fi->ft_face);
                     fi->ft_face = NULL;
                 }
+
+                delete(fi->layouts);
+                fi->layouts = NULL;
             }
         }
 
+        if ((_verbosity > 5) && (cacheStats.count(context) > 0)) {
+            textCacheStats* stats = &cacheStats[context];
+            fprintf(stdout, "libptbdrawtext_ftgl: In shutdown for context %i: Glyph cache hits %.0f, misses %.0f. Layout cache hits %.0f, misses %.0f.\n",
+                    context, stats->glyphHits, stats->glyphMisses, stats->layoutHits, stats->layoutMisses);
+        }
+
+        cacheStats.erase(context);
+
         return(0);
     }
 
     // Complete shutdown for the plugin:
     if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: Shutting down. Overall cache hit ratio was %f%%\n", (double) hitcount / (double) nowtime * 100);
     _firstCall = false;
+    cacheStats.clear();
 
     // Shutdown fontmapper library:
     // Actually, don't! Some versions of octave also use fontconfig internally, and there is only
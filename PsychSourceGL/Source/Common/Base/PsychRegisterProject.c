@@ -15,6 +15,7 @@
 */
 
 #include "Psych.h"
+#include <ctype.h>
 
 //file static variable definitions
 static PsychFunctionPtr exitFunctionREGISTER = NULL;
@@ -25,11 +26,44 @@ static char *currentFunctionNameREGISTER;
 static int numFunctionsREGISTER = 0;
 static psych_bool nameRegistered = FALSE;
 
+// Hash table for subfunction lookup by name: 1 + index into functionTableREGISTER, or 0 for an empty slot.
+// Names hash case-insensitively, so this works whatever the case sensitivity of PsychMatch():
+static int functionHashREGISTER[PSYCH_FUNCTION_HASH_SIZE];
+static int currentFunctionIndexREGISTER = -1;
+
+// State of the call profiler for each recursion level of module calls:
+typedef struct PsychCallProfile {
+    int index;          // Index of the invoked subfunction in functionTableREGISTER, or -1 if none.
+    double tEntry;      // Time of entry into the scripting glue, or 0 if not profiled.
+    double tStart;      // Time of start of the subfunction.
+    double tEnd;        // Time of end of the subfunction.
+} PsychCallProfile;
+
+static psych_bool profilingEnabled = FALSE;
+static int profileLevel = -1;
+static PsychCallProfile callProfiles[PSYCH_MAX_PROFILED_CALL_LEVELS];
+
 
 //file static function declarations
 static PsychError PsychRegisterModuleName(char *name);
 static PsychError PsychRegisterBase(PsychFunctionPtr baseFunc);
 
+/* PsychHashFunctionName()
+ *
+ * FNV-1a hash of the lower case version of subfunction name 'name'.
+ */
+static unsigned int PsychHashFunctionName(const char *name)
+{
+    unsigned int hash = 2166136261U;
+
+    while (*name) {
+        hash ^= (unsigned int) tolower((unsigned char) *name++);
+        hash *= 16777619U;
+    }
+
+    return(hash);
+}
+
 /* PsychResetRegistry()
  *
  * Called by exit glue. Resets all registered functions to empty init default.
@@ -44,6 +78,10 @@ void PsychResetRegistry(void)
     numFunctionsREGISTER = 0;
     nameRegistered = FALSE;
     memset(&functionTableREGISTER[0], 0, sizeof(functionTableREGISTER));
+    memset(&functionHashREGISTER[0], 0, sizeof(functionHashREGISTER));
+    currentFunctionIndexREGISTER = -1;
+    profilingEnabled = FALSE;
+    profileLevel = -1;
 }
 
 /*  This function is called by the special subfunction 'DescribeModuleFunctionsHelper'.
@@ -101,6 +139,159 @@ PsychError PsychDescribeModuleFunctions(void)
     return(PsychError_none);
 }
 
+/* PsychProfileModuleFunctions()
+ *
+ * Called by the special subfunction 'ProfileModuleFunctionsHelper'. Enables, disables, returns
+ * or prints the statistics of the per-subfunction call profiler.
+ */
+static int PsychCompareProfiledFunctions(const void *a, const void *b)
+{
+    double ta = functionTableREGISTER[*((const int*) a)].totalSecs;
+    double tb = functionTableREGISTER[*((const int*) b)].totalSecs;
+
+    return((ta < tb) ? 1 : ((ta > tb) ? -1 : 0));
+}
+
+PsychError PsychProfileModuleFunctions(void)
+{
+    static char useString[] = "profile = Modulename('ProfileModuleFunctionsHelper' [, mode=0]);";
+    static char synopsisString[] = "Profile the execution time of the subfunctions of this module.\n"
+                                   "'mode' 1 resets all statistics and enables profiling, 'mode' 2 disables profiling. "
+                                   "'mode' 3 also prints the statistics to the console. Profiling is disabled by default.\n"
+                                   "Returns the struct array 'profile' with one element per subfunction which was called "
+                                   "at least once while profiling was enabled, sorted by decreasing total execution time. "
+                                   "Fields are 'Name' of the subfunction, 'CallCount' of completed calls, 'TotalSecs' "
+                                   "and 'MaxSecs' total and maximum time per call from entry to exit of the module, and "
+                                   "'GlueSecs' time spent in the scripting glue before and after the subfunction itself, "
+                                   "e.g., for subfunction name lookup and return argument conversion. Calls which abort "
+                                   "with an error are not counted.";
+    static char seeAlsoString[] = "";
+    static const char *fieldNames[] = { "Name", "CallCount", "TotalSecs", "MaxSecs", "GlueSecs" };
+
+    PsychGenericScriptType  *profile;
+    PsychFunctionTableEntry *entry;
+    int                     i, n, mode;
+    int                     *indices;
+
+    //all subfunctions should have these two lines.
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if(PsychIsGiveHelp()){PsychGiveHelp();return(PsychError_none);};
+
+    PsychErrorExit(PsychCapNumInputArgs(1));
+    PsychErrorExit(PsychCapNumOutputArgs(1));
+
+    mode = 0;
+    PsychCopyInIntegerArg(1, FALSE, &mode);
+    if (mode < 0 || mode > 3) PsychErrorExitMsg(PsychError_user, "Invalid 'mode' specified. Must be 0, 1, 2 or 3.");
+
+    if (mode == 1) {
+        for (i = 0; i < numFunctionsREGISTER; i++) {
+            entry = &functionTableREGISTER[i];
+            entry->callCount = 0;
+            entry->totalSecs = entry->maxSecs = entry->glueSecs = 0;
+        }
+
+        profilingEnabled = TRUE;
+    }
+
+    if (mode == 2) profilingEnabled = FALSE;
+
+    // Collect all called subfunctions, most expensive first:
+    indices = (int*) PsychMallocTemp(sizeof(int) * (numFunctionsREGISTER + 1));
+    for (i = 0, n = 0; i < numFunctionsREGISTER; i++) if (functionTableREGISTER[i].callCount > 0) indices[n++] = i;
+    qsort(indices, n, sizeof(int), PsychCompareProfiledFunctions);
+
+    if ((mode == 3) && (n > 0)) {
+        printf("%s subfunction profile:\n", ModuleNameREGISTER);
+        printf("%-32s %12s %12s %12s %12s %12s\n", "Name", "Calls", "Total msecs", "Mean msecs", "Max msecs", "Glue msecs");
+    }
+
+    PsychAllocOutStructArray(1, FALSE, n, 5, fieldNames, &profile);
+    for (i = 0; i < n; i++) {
+        entry = &functionTableREGISTER[indices[i]];
+        PsychSetStructArrayStringElement("Name", i, entry->name, profile);
+        PsychSetStructArrayDoubleElement("CallCount", i, (double) entry->callCount, profile);
+        PsychSetStructArrayDoubleElement("TotalSecs", i, entry->totalSecs, profile);
+        PsychSetStructArrayDoubleElement("MaxSecs", i, entry->maxSecs, profile);
+        PsychSetStructArrayDoubleElement("GlueSecs", i, entry->glueSecs, profile);
+
+        if (mode == 3)
+            printf("%-32s %12.0f %12.3f %12.6f %12.6f %12.3f\n", entry->name, (double) entry->callCount, entry->totalSecs * 1000,
+                   entry->totalSecs * 1000 / (double) entry->callCount, entry->maxSecs * 1000, entry->glueSecs * 1000);
+    }
+
+    return(PsychError_none);
+}
+
+/* PsychProfileCallEntry()
+ *
+ * Called by the scripting glue on entry of a module call at recursion level 'level'.
+ */
+void PsychProfileCallEntry(int level)
+{
+    PsychCallProfile *p;
+
+    if (level < 0 || level >= PSYCH_MAX_PROFILED_CALL_LEVELS) return;
+
+    profileLevel = level;
+    p = &callProfiles[level];
+    p->index = -1;
+    p->tEntry = 0;
+
+    if (profilingEnabled) PsychGetPrecisionTimerSeconds(&p->tEntry);
+}
+
+/* PsychInvokeProjectFunction()
+ *
+ * Called by the scripting glue to execute subfunction 'func', as returned by the most recent
+ * PsychGetProjectFunction(). Timestamps its execution if the call gets profiled.
+ */
+void PsychInvokeProjectFunction(PsychFunctionPtr func)
+{
+    PsychCallProfile *p;
+    int level = profileLevel;
+
+    if ((level < 0) || (currentFunctionIndexREGISTER < 0) || (callProfiles[level].tEntry == 0)) {
+        (*func)();
+        return;
+    }
+
+    p = &callProfiles[level];
+    p->index = currentFunctionIndexREGISTER;
+    PsychGetPrecisionTimerSeconds(&p->tStart);
+    (*func)();
+    PsychGetPrecisionTimerSeconds(&p->tEnd);
+
+    // Nested module calls from within func may have changed the current level:
+    profileLevel = level;
+}
+
+/* PsychProfileCallExit()
+ *
+ * Called by the scripting glue on regular exit of a module call at recursion level 'level', to
+ * account the call to its subfunction. Calls aborted by an error never get here and don't count.
+ */
+void PsychProfileCallExit(int level)
+{
+    PsychCallProfile *p;
+    PsychFunctionTableEntry *entry;
+    double tExit;
+
+    if (level < 0 || level >= PSYCH_MAX_PROFILED_CALL_LEVELS) return;
+
+    profileLevel = level - 1;
+    p = &callProfiles[level];
+    if ((p->index < 0) || !profilingEnabled) return;
+
+    PsychGetPrecisionTimerSeconds(&tExit);
+    entry = &functionTableREGISTER[p->index];
+    entry->callCount++;
+    entry->totalSecs += tExit - p->tEntry;
+    entry->glueSecs += (p->tStart - p->tEntry) + (tExit - p->tEnd);
+    if (tExit - p->tEntry > entry->maxSecs) entry->maxSecs = tExit - p->tEntry;
+    p->index = -1;
+}
+
 /*
 	This function is called by the project to register project functions.
 	
@@ -118,6 +309,7 @@ PsychError PsychDescribeModuleFunctions(void)
 PsychError PsychRegister(char *name,  PsychFunctionPtr func)
 {
 	int i;
+	unsigned int slot;
 
 	//check to see if name is null which means we register the module base function.  
 	if(name==NULL){
@@ -146,6 +338,12 @@ PsychError PsychRegister(char *name,  PsychFunctionPtr func)
 	if(strlen(name) > PSYCH_MAX_FUNCTION_NAME_LENGTH)
 		return(PsychError_longString);
 	strcpy(functionTableREGISTER[numFunctionsREGISTER].name, name);
+
+	// Enter it into the first free slot of its hash chain. Earlier registered entries come first
+	// in each chain, so lookup finds the same function as a linear search of the table would:
+	for (slot = PsychHashFunctionName(name) & (PSYCH_FUNCTION_HASH_SIZE - 1); functionHashREGISTER[slot] > 0; slot = (slot + 1) & (PSYCH_FUNCTION_HASH_SIZE - 1));
+	functionHashREGISTER[slot] = numFunctionsREGISTER + 1;
+
 	++numFunctionsREGISTER;
 	PsychEnableSubfunctions();
 	return(PsychError_none);
@@ -170,6 +368,10 @@ PsychError PsychRegisterExit(PsychFunctionPtr exitFunc)
 PsychFunctionPtr PsychGetProjectFunction(char *command)
 {
 	int i; 
+	unsigned int slot;
+
+	// No subfunction to profile, unless we find one:
+	currentFunctionIndexREGISTER = -1;
 
 	//return the project base function
 	if(command==NULL){
@@ -183,10 +385,11 @@ PsychFunctionPtr PsychGetProjectFunction(char *command)
 	}else
 		PsychClearGiveHelp();
 	
-	//lookup the function in the table
-	for(i=0;i<numFunctionsREGISTER;i++){
+	//lookup the function in the hash table
+	for (slot = PsychHashFunctionName(command) & (PSYCH_FUNCTION_HASH_SIZE - 1); (i = functionHashREGISTER[slot] - 1) >= 0; slot = (slot + 1) & (PSYCH_FUNCTION_HASH_SIZE - 1)) {
 		if(PsychMatch(functionTableREGISTER[i].name, command)){
 			currentFunctionNameREGISTER = functionTableREGISTER[i].name;
+			currentFunctionIndexREGISTER = i;
 			return(functionTableREGISTER[i].function);
 		}
 	}
@@ -23,13 +23,27 @@
 #define PSYCH_MAX_FUNCTION_NAME_LENGTH 64
 #define PSYCH_MAX_FUNCTIONS 512
 
+// Size of the subfunction name hash table. Must be a power of two, and bigger than PSYCH_MAX_FUNCTIONS:
+#define PSYCH_FUNCTION_HASH_SIZE (2 * PSYCH_MAX_FUNCTIONS)
+
+// Maximum recursion level of module calls whose execution time gets profiled:
+#define PSYCH_MAX_PROFILED_CALL_LEVELS 16
+
 typedef struct
 {
     char name[PSYCH_MAX_FUNCTION_NAME_LENGTH+1];  // +1 for term null
     PsychFunctionPtr function;
+    psych_uint64 callCount;                       // Profiler: Number of completed calls.
+    double totalSecs;                             // Profiler: Total time from entry to exit of the scripting glue.
+    double maxSecs;                               // Profiler: Maximum time of a single call.
+    double glueSecs;                              // Profiler: Part of totalSecs spent in the glue before and after the subfunction.
 } PsychFunctionTableEntry;
 
 PsychError PsychDescribeModuleFunctions(void);
+PsychError PsychProfileModuleFunctions(void);
+void PsychProfileCallEntry(int level);
+void PsychProfileCallExit(int level);
+void PsychInvokeProjectFunction(PsychFunctionPtr func);
 PsychError PsychRegister(char *name,  PsychFunctionPtr func);
 PsychError PsychRegisterExit(PsychFunctionPtr exitFunc);
 void PsychResetRegistry(void);
@@ -241,6 +241,7 @@ PTB_EXPORT void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *p
         // This one dumps all registered subfunctions of a module into a struct array of text strings.
         // Needed by our automatic documentation generator script to find out about subfunctions of a module:
         PsychRegister((char*) "DescribeModuleFunctionsHelper", &PsychDescribeModuleFunctions);
+        PsychRegister((char*) "ProfileModuleFunctionsHelper", &PsychProfileModuleFunctions);
 
         // License management support for users to (de-)activate machine licenses and query their status:
         PsychRegister((char*) "ManageLicense", &PsychManageLicense);
@@ -272,6 +273,9 @@ PTB_EXPORT void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *p
 
     baseFunctionInvoked[recLevel]=FALSE;
 
+    // Start profiling of this call, if profiling is enabled:
+    PsychProfileCallEntry(recLevel);
+
     //if no subfunctions have been registered by the project then just invoke the project base function
     //if one of those has been registered.
     if (!PsychAreSubfunctionsEnabled()) {
@@ -321,7 +325,7 @@ PTB_EXPORT void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *p
         else if (isArgEmptyMat[0] && isArgText[1]) {
             if (isArgFunction[1]) {
                 nameFirstGLUE[recLevel] = FALSE;
-                (*(fArg[1]))();
+                PsychInvokeProjectFunction(fArg[1]);
             }
             else
                 PrintfExit("Unknown or invalid subfunction name - Typo? Check spelling of the function name.  (error state C)");
@@ -331,7 +335,7 @@ PTB_EXPORT void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *p
         else if (isArgText[0] && !isArgThere[1]) {
             if (isArgFunction[0]) {
                 nameFirstGLUE[recLevel] = TRUE;
-                (*(fArg[0]))();
+                PsychInvokeProjectFunction(fArg[0]);
             } else { //when we receive a first argument  wich is a string and it is  not recognized as a function name then call the default function
                 baseFunction = PsychGetProjectFunction(NULL);
                 if (baseFunction != NULL) {
@@ -344,7 +348,7 @@ PTB_EXPORT void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *p
         else if (isArgText[0] && isArgEmptyMat[1]) {
             if (isArgFunction[0]) {
                 nameFirstGLUE[recLevel] = TRUE;
-                (*(fArg[0]))();
+                PsychInvokeProjectFunction(fArg[0]);
             }
             else
                 PrintfExit("Unknown or invalid subfunction name - Typo? Check spelling of the function name.  (error state F)");
@@ -352,11 +356,11 @@ PTB_EXPORT void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *p
         else if (isArgText[0] && isArgText[1]) {
             if (isArgFunction[0] && !isArgFunction[1]) { //the first argument is the function name
                 nameFirstGLUE[recLevel] = TRUE;
-                (*(fArg[0]))();
+                PsychInvokeProjectFunction(fArg[0]);
             }
             else if (!isArgFunction[0] && isArgFunction[1]) { //the second argument is the function name
                 nameFirstGLUE[recLevel] = FALSE;
-                (*(fArg[1]))();
+                PsychInvokeProjectFunction(fArg[1]);
             }
             else if (!isArgFunction[0] && !isArgFunction[1]) { //neither argument is a function name
                 //PrintfExit("Invalid command (error state G)");
@@ -373,7 +377,7 @@ PTB_EXPORT void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *p
         else if (isArgText[0] && !isArgText[1]) {
             if (isArgFunction[0]) {
                 nameFirstGLUE[recLevel] = TRUE;
-                (*(fArg[0]))();
+                PsychInvokeProjectFunction(fArg[0]);
             }
             else
                 PrintfExit("Unknown or invalid subfunction name - Typo? Check spelling of the function name.  (error state H)");
@@ -393,7 +397,7 @@ PTB_EXPORT void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *p
         {
             if (isArgFunction[1]) {
                 nameFirstGLUE[recLevel] = FALSE;
-                (*(fArg[1]))();
+                PsychInvokeProjectFunction(fArg[1]);
             } else
                 PrintfExit("Unknown or invalid subfunction name - Typo? Check spelling of the function name.  (error state J)");
         }
@@ -408,6 +412,9 @@ PTB_EXPORT void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *p
         }
     } //close else
 
+    // Account this call in the subfunction profiler, if profiling is enabled:
+    PsychProfileCallExit(recLevel);
+
     PsychExitRecursion();
 }
 
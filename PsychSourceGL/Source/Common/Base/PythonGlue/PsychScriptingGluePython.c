@@ -903,6 +903,7 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         // a module into a struct array of text strings. Needed by our automatic documentation
         // generator script to find out about subfunctions of a module:
         PsychRegister((char*) "DescribeModuleFunctionsHelper",  &PsychDescribeModuleFunctions);
+        PsychRegister((char*) "ProfileModuleFunctionsHelper",  &PsychProfileModuleFunctions);
 
         firstTime = FALSE;
     }
@@ -971,6 +972,9 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
 
     baseFunctionInvoked[recLevel] = FALSE;
 
+    // Start profiling of this call, if profiling is enabled:
+    PsychProfileCallEntry(recLevel);
+
     // If no subfunctions have been registered by the project then just invoke the project base function
     // If one of those has been registered.
     if (!PsychAreSubfunctionsEnabled()) {
@@ -1028,7 +1032,7 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         else if (isArgEmptyMat[0] && isArgText[1]) {
             if (isArgFunction[1]) {
                 nameFirstGLUE[recLevel] = FALSE;
-                (*(fArg[1]))();
+                PsychInvokeProjectFunction(fArg[1]);
             }
             else
                 PsychErrorExitMsg(PsychError_user, "Unknown or invalid subfunction name - Typo? Check spelling of the function name.  (error state C)");
@@ -1039,7 +1043,7 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         else if (isArgText[0] && !isArgThere[1]) {
             if (isArgFunction[0]) {
                 nameFirstGLUE[recLevel] = TRUE;
-                (*(fArg[0]))();
+                PsychInvokeProjectFunction(fArg[0]);
             } else {
                 // When we receive a first argument  which is a string and it is not recognized as a function name then call the default function
                 // first to hopefully print a synopsis on a subfunctions-enabled module, then abort with "Unknown subfunction name".
@@ -1055,7 +1059,7 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         else if (isArgText[0] && isArgEmptyMat[1]) {
             if (isArgFunction[0]) {
                 nameFirstGLUE[recLevel] = TRUE;
-                (*(fArg[0]))();
+                PsychInvokeProjectFunction(fArg[0]);
             }
             else
                 PsychErrorExitMsg(PsychError_user, "Unknown or invalid subfunction name - Typo? Check spelling of the function name.  (error state F)");
@@ -1063,11 +1067,11 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         else if (isArgText[0] && isArgText[1]) {
             if (isArgFunction[0] && !isArgFunction[1]) { //the first argument is the function name
                 nameFirstGLUE[recLevel] = TRUE;
-                (*(fArg[0]))();
+                PsychInvokeProjectFunction(fArg[0]);
             }
             else if (!isArgFunction[0] && isArgFunction[1]) { //the second argument is the function name
                 nameFirstGLUE[recLevel] = FALSE;
-                (*(fArg[1]))();
+                PsychInvokeProjectFunction(fArg[1]);
             }
             else if (!isArgFunction[0] && !isArgFunction[1]) { //neither argument is a function name
                 //PrintfExit("Invalid command (error state G)");
@@ -1084,7 +1088,7 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         else if (isArgText[0] && !isArgText[1]) {
             if (isArgFunction[0]) {
                 nameFirstGLUE[recLevel] = TRUE;
-                (*(fArg[0]))();
+                PsychInvokeProjectFunction(fArg[0]);
             }
             else
                 PsychErrorExitMsg(PsychError_user, "Unknown or invalid subfunction name - Typo? Check spelling of the function name.  (error state H)");
@@ -1104,7 +1108,7 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         else if (!isArgText[0] && isArgText[1]) {
             if (isArgFunction[1]) {
                 nameFirstGLUE[recLevel] = FALSE;
-                (*(fArg[1]))();
+                PsychInvokeProjectFunction(fArg[1]);
             } else
                 PsychErrorExitMsg(PsychError_user, "Unknown or invalid subfunction name - Typo? Check spelling of the function name.  (error state J)");
         }
@@ -1185,6 +1189,9 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         plhs = Py_None;
     }
 
+    // Account this call in the subfunction profiler, if profiling is enabled:
+    PsychProfileCallExit(recLevel);
+
 PythonFunctionCleanup:
     // The following code is executed both at end of normal execution, and also
     // during an error return. It has to do the common cleanup work:
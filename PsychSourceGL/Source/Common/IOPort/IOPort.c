@@ -59,6 +59,7 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[nwritten, when, errmsg, prewritetime, postwritetime, lastchecktime] = IOPort('Write', handle, data [, blocking=1]);";
     synopsis[i++] = "IOPort('Flush', handle);";
     synopsis[i++] = "[data, when, errmsg] = IOPort('Read', handle [, blocking=0] [, amount]);";
+    synopsis[i++] = "[records, when, errmsg] = IOPort('ReadRecords', handle [, blocking=0] [, amount]);";
     synopsis[i++] = "navailable = IOPort('BytesAvailable', handle);";
     synopsis[i++] = "IOPort('Purge', handle);";
 
@@ -66,6 +67,10 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[handle, errmsg] = IOPort('OpenSerialPort', port [, configString]);";
     synopsis[i++] = "IOPort('ConfigureSerialPort', handle, configString);";
 
+    synopsis[i++] = "\nCommands specific to network sockets and pseudo-terminals:\n";
+    synopsis[i++] = "[handle, errmsg] = IOPort('OpenSocket', address [, configString]);";
+    synopsis[i++] = "[handle, errmsg, slaveName] = IOPort('OpenPty' [, configString]);";
+
     synopsis[i++] = NULL;  //this tells IOPORTDisplaySynopsis where to stop
     if (i > MAX_SYNOPSIS_STRINGS) {
         PrintfExit("%s: increase dimension of synopsis[] from %ld to at least %ld and recompile.",__FILE__,(long)MAX_SYNOPSIS_STRINGS,(long)i);
@@ -160,6 +165,22 @@ PsychPortIORecord* PsychGetPortIORecord(int handle)
     return(&portRecordBank[handle]);
 }
 
+// Find a free slot for a new port, return its handle:
+static int PsychGetFreePortHandle(void)
+{
+    int handle;
+
+    // Search for a free slot:
+    if (portRecordCount >= PSYCH_MAX_IOPORTS) PsychErrorExitMsg(PsychError_user, "Maximum number of open Input/Output ports exceeded.");
+
+    // Iterate until end or free slot:
+    for (handle=0; (handle < PSYCH_MAX_IOPORTS) && (portRecordBank[handle].portType); handle++);
+    if ((handle >= PSYCH_MAX_IOPORTS) || portRecordBank[handle].portType) PsychErrorExitMsg(PsychError_user, "Maximum number of open Input/Output ports exceeded.");
+
+    // handle is index into our port record...
+    return(handle);
+}
+
 // Close port referenced by 'handle':
 PsychError PsychCloseIOPort(int handle)
 {
@@ -170,7 +191,9 @@ PsychError PsychCloseIOPort(int handle)
 
     switch(portRecord->portType) {
         case kPsychIOPortSerial:
-            // Close serial port:
+        case kPsychIOPortSocket:
+        case kPsychIOPortPty:
+            // Close serial port, socket or pseudo-terminal:
             PsychIOOSCloseSerialPort(portRecord->device);
         break;
 
@@ -195,7 +218,9 @@ int PsychWriteIOPort(int handle, void* writedata, unsigned int amount, int block
 
     switch(portRecord->portType) {
         case kPsychIOPortSerial:
-            // Write to serial port:
+        case kPsychIOPortSocket:
+        case kPsychIOPortPty:
+            // Write to serial port, socket or pseudo-terminal:
             return(PsychIOOSWriteSerialPort(portRecord->device, writedata, amount, blocking, errmsg, timestamp));
         break;
 
@@ -213,7 +238,9 @@ int PsychReadIOPort(int handle, void** readbuffer, unsigned int amount, int bloc
 
     switch(portRecord->portType) {
         case kPsychIOPortSerial:
-            // Read from serial port:
+        case kPsychIOPortSocket:
+        case kPsychIOPortPty:
+            // Read from serial port, socket or pseudo-terminal:
             return(PsychIOOSReadSerialPort(portRecord->device, readbuffer, amount, blocking, errmsg, timestamp));
         break;
 
@@ -225,13 +252,39 @@ int PsychReadIOPort(int handle, void** readbuffer, unsigned int amount, int bloc
     return(0);
 }
 
+int PsychReadRecordsIOPort(int handle, double** records, double** timestamps, int* nvalues, unsigned int amount, int blocking, char* errmsg)
+{
+    PsychPortIORecord* portRecord = PsychGetPortIORecord(handle);
+
+    switch(portRecord->portType) {
+        case kPsychIOPortSerial:
+        case kPsychIOPortSocket:
+        case kPsychIOPortPty:
+            // Fetch decoded records from serial port, socket or pseudo-terminal:
+            #if PSYCH_SYSTEM != PSYCH_WINDOWS
+            return(PsychIOOSReadRecordsSerialPort(portRecord->device, records, timestamps, nvalues, amount, blocking, errmsg));
+            #else
+            PsychErrorExitMsg(PsychError_unimplemented, "Sorry, decoding of binary records is not supported on MS-Windows.");
+            #endif
+        break;
+
+        default:
+            PsychErrorExitMsg(PsychError_internal, "Unknown portType - Unsupported.");
+    }
+
+    // Not reached, just to make compiler happy:
+    return(0);
+}
+
 int PsychBytesAvailableIOPort(int handle)
 {
     PsychPortIORecord* portRecord = PsychGetPortIORecord(handle);
 
     switch(portRecord->portType) {
         case kPsychIOPortSerial:
-            // Read from serial port:
+        case kPsychIOPortSocket:
+        case kPsychIOPortPty:
+            // Query serial port, socket or pseudo-terminal:
             return(PsychIOOSBytesAvailableSerialPort(portRecord->device));
         break;
 
@@ -249,7 +302,9 @@ void PsychPurgeIOPort(int handle)
 
     switch(portRecord->portType) {
         case kPsychIOPortSerial:
-            // Purge serial port:
+        case kPsychIOPortSocket:
+        case kPsychIOPortPty:
+            // Purge serial port, socket or pseudo-terminal:
             PsychIOOSPurgeSerialPort(portRecord->device);
         break;
 
@@ -264,7 +319,9 @@ void PsychFlushIOPort(int handle)
 
     switch(portRecord->portType) {
         case kPsychIOPortSerial:
-            // Purge serial port:
+        case kPsychIOPortSocket:
+        case kPsychIOPortPty:
+            // Flush serial port, socket or pseudo-terminal:
             PsychIOOSFlushSerialPort(portRecord->device);
         break;
 
@@ -399,6 +456,7 @@ PsychError IOPORTOpenSerialPort(void)
         "algorithms that interact with the serial port! Only use if you really know what you're doing!\n\n"
         "StartBackgroundRead=readGranularity -- Enable asynchronous background read operations on the port. "
         "A parallel background thread is started which tries to fetch 'readGranularity' bytes of data, "
+        "either sleeping until new data arrives (see 'EventDrivenBackgroundRead'), or "
         "polling the port every 'PollLatency' seconds for at least 'readGranularity' bytes of data. 'InputBufferSize' must be an "
         "integral multiple of 'readGranularity' for this to work. Later IOPort('Read') commands will pull collected data from "
         "the InputBuffer in quanta of at most 'readGranularity' bytes per invocation. This function is useful for background "
@@ -406,6 +464,11 @@ PsychError IOPORTOpenSerialPort(void)
         "thread do all data collection in the background and collect the data at the end of a session with a sequence of "
         "IOPort('Read') calls. This way, data collection doesn't clutter your main experiment script.\n\n"
         "BlockingBackgroundRead=0 -- Perform blocking background reads instead of polling reads, if set to 1.\n\n"
+        "EventDrivenBackgroundRead=1 -- On OS/X and Linux, the background thread sleeps until new data arrives, then fetches "
+        "all pending data at once and splits it into 'readGranularity' quanta or lines itself. This keeps up with high data rates "
+        "of Megabaud devices at low cpu load and latency, and 'BlockingBackgroundRead' and 'PollLatency' don't apply to it. "
+        "Set to 0 to use the old polling or blocking reader instead, e.g., to work around broken serial port drivers. "
+        "Ignored on Windows.\n\n"
         "StopBackgroundRead -- Stop running background read operation, discard all pending data.\n\n"
         "ReadFilterFlags=0 -- Special flags to specify certain post-processing operations on read input data.\n"
         "* A setting of 1 will enable special filtering for serial input data from the CMU or PST response button boxes. "
@@ -415,7 +478,19 @@ PsychError IOPORTOpenSerialPort(void)
         "* A setting of 2 will filter out CR and LF character codes 10 and 13 from the inputstream.\n"
         "* A setting of 4 will implement simple line-buffering for async reads: Read up to 'readGranularity' bytes per iteration, "
         "  or until 'Terminator' character encountered, whatever comes first. Zero-Pad to full 'readGranularity' bytes in any case. "
-        "  Read timestamps in this line-buffered mode correspond to the reception of the first byte of a line, not the last one!\n"
+        "  Read timestamps in this line-buffered mode correspond to the reception of the first byte of a line, not the last one!\n\n"
+        "RecordLayout=None -- Decode each 'readGranularity' quantum of background read data as a binary record with the given "
+        "layout, e.g., the fixed size data packets of eye trackers or amplifiers. Decoding happens in the background thread, and "
+        "IOPort('ReadRecords') returns the decoded values of all records at once as a numeric matrix. The layout is a comma "
+        "separated list of fields of the form type[le|be]@offset[xcount], without spaces: 'type' is one of u8, i8, u16, i16, u24, "
+        "i24, u32, i32 for unsigned or signed integers of 8 to 32 bits, or f32, f64 for floating point numbers. 'le' or 'be' selects "
+        "little endian (the default) or big endian byte order. 'offset' is the byte offset of the field in the record, 'count' the "
+        "optional number of consecutive values of the field. E.g., 'RecordLayout=u8@1,i24be@2x8,u32@26' decodes a sample counter "
+        "byte at offset 1, 8 channels of big endian 24 bit samples at offset 2 and a 32 bit timestamp at offset 26 into 10 values "
+        "per record. All fields must fit into 'readGranularity' bytes. Only supported on OS/X and Linux.\n\n"
+        "RecordSync=-1 -- If set to a byte value between 0 and 255, each binary record must start with this sync byte, and data before "
+        "the next sync byte is dropped whenever a new record starts. This resynchronizes with the record boundaries after lost data. "
+        "-1 disables sync byte handling.\n"
         "\n\n";
 
     static char seeAlsoString[] = "'CloseAll'";
@@ -464,12 +539,7 @@ PsychError IOPORTOpenSerialPort(void)
     }
 
     // Search for a free slot:
-    if (portRecordCount >= PSYCH_MAX_IOPORTS) PsychErrorExitMsg(PsychError_user, "Maximum number of open Input/Output ports exceeded.");
-
-    // Iterate until end or free slot:
-    for (handle=0; (handle < PSYCH_MAX_IOPORTS) && (portRecordBank[handle].portType); handle++);
-    if (portRecordBank[handle].portType) PsychErrorExitMsg(PsychError_user, "Maximum number of open Input/Output ports exceeded.");
-    // handle is index into our port record...
+    handle = PsychGetFreePortHandle();
 
     // Call OS specific open routine for serial port:
     device = PsychIOOSOpenSerialPort(portSpec, finalConfig, errmsg);
@@ -502,7 +572,8 @@ PsychError IOPORTConfigureSerialPort(void)
 {
     static char useString[] = "IOPort('ConfigureSerialPort', handle, configString);";
     static char synopsisString[] =
-        "(Re-)Configure a serial port device, specified by 'handle'.\n"
+        "(Re-)Configure a serial port device, specified by 'handle'. This also works for network sockets and "
+        "pseudo-terminals, see 'OpenSocket' and 'OpenPty' for the settings which apply to them.\n"
         "The string 'configString' is a string with pairs of paramName=paramValue "
         "tokens, separated by a delimiter, e.g., a space. It allows to specify specific "
         "values 'paramValue' to specific serial port parameters 'paramName'. Not all "
@@ -532,6 +603,179 @@ PsychError IOPORTConfigureSerialPort(void)
     return(PsychIOOSConfigureSerialPort(PsychGetPortIORecord(handle)->device, configString));
 }
 
+// Open a network socket:
+PsychError IOPORTOpenSocket(void)
+{
+    static char useString[] = "[handle, errmsg] = IOPort('OpenSocket', address [, configString]);";
+    static char synopsisString[] =
+        "Open a network or Unix domain socket, return a 'handle' to it.\n"
+        "This allows to talk to devices like EEG amplifiers, trigger boxes or motion trackers, which "
+        "are connected via network, with the same 'Read', 'Write', 'BytesAvailable' etc. functions as "
+        "for serial ports, including background reads with timestamps for each received chunk of data. "
+        "Currently only supported on Linux and OS/X.\n"
+        "If a socket can't be opened, the function will abort with error, unless the "
+        "level of verbosity is set to zero, in which case the function will silently "
+        "fail, but return an invalid (negative) handle to signal the failure to the "
+        "calling script. The optional return argument 'errmsg' contains a text string "
+        "which is either empty on success, or contains a descriptive error message.\n\n"
+        "'address' defines the type of socket and its address:\n"
+        "'tcp:host:port' TCP connection to the server on machine 'host', e.g., a name or an IP address "
+        "like 192.168.0.2 or [::1], listening on 'port'.\n"
+        "'tcplisten:port' or 'tcplisten:host:port' TCP server which listens on 'port', optionally only "
+        "on the network interface with address 'host'. The call returns immediately, and the first client "
+        "which connects gets accepted by the first following 'Read', 'Write', 'BytesAvailable', 'Purge' "
+        "or 'StartBackgroundRead' operation. Blocking operations wait up to 'ReceiveTimeout' seconds for a "
+        "client to connect. Only one client gets accepted.\n"
+        "'udp:host:port' UDP socket which sends datagrams to and receives datagrams from 'host' at 'port'. "
+        "Each 'Write' sends one datagram. The optional setting 'LocalPort=port' in 'configString' selects "
+        "the local port, otherwise the operating system assigns one.\n"
+        "'udp::port' Receive only UDP socket, which receives datagrams from any sender at local 'port'.\n"
+        "'unix:path' Connection to the Unix domain stream socket server with socket file 'path'.\n"
+        "'unixlisten:path' Unix domain stream socket server, which creates socket file 'path'. It accepts "
+        "a client like 'tcplisten' does, and deletes the socket file when it gets closed.\n\n"
+        "TCP sockets are set up for low latency, ie., small writes get sent immediately.\n\n"
+        "The optional 'configString' has the same format as for 'OpenSerialPort'. Only the settings "
+        "InputBufferSize, ReceiveTimeout, PollLatency, Terminator, ReadFilterFlags, RecordLayout, RecordSync, StartBackgroundRead, "
+        "StopBackgroundRead and LocalPort apply to sockets. Background reads are always event driven. "
+        "The same settings apply to IOPort('ConfigureSerialPort') on socket handles.\n";
+
+    static char seeAlsoString[] = "'OpenPty', 'OpenSerialPort', 'ConfigureSerialPort'";
+
+    static char defaultConfig[] = "PollLatency=0.0005 ReceiveTimeout=1.0 InputBufferSize=4096";
+
+    char finalConfig[2000];
+    char errmsg[1024];
+    char* address = NULL;
+    char* configString = NULL;
+    PsychSerialDeviceRecord* device = NULL;
+    int handle;
+
+    // Setup online help:
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(2));     // The maximum number of inputs
+    PsychErrorExit(PsychRequireNumInputArgs(1)); // The required number of inputs
+    PsychErrorExit(PsychCapNumOutputArgs(2));     // The maximum number of outputs
+
+    #if PSYCH_SYSTEM == PSYCH_WINDOWS
+        PsychErrorExitMsg(PsychError_unimplemented, "Sorry, network sockets are not yet supported on MS-Windows.");
+    #endif
+
+    // Get required address:
+    PsychAllocInCharArg(1, kPsychArgRequired, &address);
+
+    // Get the optional configString and prepend it to the default string:
+    if (!PsychAllocInCharArg(2, kPsychArgOptional, &configString)) {
+        sprintf(finalConfig, "%s", defaultConfig);
+    }
+    else {
+        snprintf(finalConfig, sizeof(finalConfig), "%s %s", configString, defaultConfig);
+    }
+
+    // Search for a free slot:
+    handle = PsychGetFreePortHandle();
+
+    // Call OS specific open routine for sockets:
+    #if PSYCH_SYSTEM != PSYCH_WINDOWS
+    device = PsychIOOSOpenSocket(address, finalConfig, errmsg);
+    #endif
+
+    // Copy out optional errmsg string:
+    PsychCopyOutCharArg(2, kPsychArgOptional, errmsg);
+
+    if (device == NULL) {
+        // Could not open socket, but verbosity level is zero. Return a negative handle to signal failure:
+        PsychCopyOutDoubleArg(1, kPsychArgRequired, -1);
+        return(PsychError_none);
+    }
+
+    portRecordBank[handle].portType = kPsychIOPortSocket;
+    portRecordBank[handle].device = (void*) device;
+    portRecordCount++;
+
+    // Return handle to new socket object:
+    PsychCopyOutDoubleArg(1, kPsychArgRequired, (double) handle);
+
+    return(PsychError_none);
+}
+
+// Create a pseudo-terminal:
+PsychError IOPORTOpenPty(void)
+{
+    static char useString[] = "[handle, errmsg, slaveName] = IOPort('OpenPty' [, configString]);";
+    static char synopsisString[] =
+        "Create a new pseudo-terminal, return a 'handle' to its master side and the device file name 'slaveName' of its slave side.\n"
+        "A pseudo-terminal is a pair of connected virtual serial ports: Data written to the master can be read from the slave "
+        "and vice versa. The slave behaves like a regular serial port, so it can be opened via IOPort('OpenSerialPort', slaveName, 'Lenient') "
+        "or by any other application or device emulator. This is useful for testing and benchmarking of serial port code without "
+        "hardware, and to connect to software which emulates serial port devices. The 'Lenient' keyword is needed, as pseudo-terminals "
+        "don't have modem control lines. Currently only supported on Linux and OS/X.\n"
+        "The slave side is set up in raw mode and kept open as long as the master is open, so data written to the master gets queued "
+        "until the slave side is read, even if no client has opened it yet.\n"
+        "'errmsg' is empty on success, or contains a descriptive error message if the pseudo-terminal couldn't be created and the "
+        "level of verbosity is zero, in which case a negative 'handle' is returned instead of aborting with an error.\n"
+        "The optional 'configString' has the same format and settings as for 'OpenSocket'.\n";
+
+    static char seeAlsoString[] = "'OpenSocket', 'OpenSerialPort', 'ConfigureSerialPort'";
+
+    static char defaultConfig[] = "PollLatency=0.0005 ReceiveTimeout=1.0 InputBufferSize=4096";
+
+    char finalConfig[2000];
+    char errmsg[1024];
+    char slaveName[1000];
+    char* configString = NULL;
+    PsychSerialDeviceRecord* device = NULL;
+    int handle;
+
+    // Setup online help:
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(1));     // The maximum number of inputs
+    PsychErrorExit(PsychRequireNumInputArgs(0)); // The required number of inputs
+    PsychErrorExit(PsychCapNumOutputArgs(3));     // The maximum number of outputs
+
+    #if PSYCH_SYSTEM == PSYCH_WINDOWS
+        PsychErrorExitMsg(PsychError_unimplemented, "Sorry, pseudo-terminals are not supported on MS-Windows.");
+    #endif
+
+    // Get the optional configString and prepend it to the default string:
+    if (!PsychAllocInCharArg(1, kPsychArgOptional, &configString)) {
+        sprintf(finalConfig, "%s", defaultConfig);
+    }
+    else {
+        snprintf(finalConfig, sizeof(finalConfig), "%s %s", configString, defaultConfig);
+    }
+
+    // Search for a free slot:
+    handle = PsychGetFreePortHandle();
+
+    // Call OS specific open routine for pseudo-terminals:
+    #if PSYCH_SYSTEM != PSYCH_WINDOWS
+    device = PsychIOOSOpenPty(finalConfig, errmsg, slaveName);
+    #endif
+
+    // Copy out optional errmsg and slaveName strings:
+    PsychCopyOutCharArg(2, kPsychArgOptional, errmsg);
+    PsychCopyOutCharArg(3, kPsychArgOptional, slaveName);
+
+    if (device == NULL) {
+        // Could not create pseudo-terminal, but verbosity level is zero. Return a negative handle to signal failure:
+        PsychCopyOutDoubleArg(1, kPsychArgRequired, -1);
+        return(PsychError_none);
+    }
+
+    portRecordBank[handle].portType = kPsychIOPortPty;
+    portRecordBank[handle].device = (void*) device;
+    portRecordCount++;
+
+    // Return handle to new pseudo-terminal object:
+    PsychCopyOutDoubleArg(1, kPsychArgRequired, (double) handle);
+
+    return(PsychError_none);
+}
+
 PsychError IOPORTRead(void)
 {
     static char useString[] = "[data, when, errmsg] = IOPort('Read', handle [, blocking=0] [, amount]);";
@@ -605,6 +849,79 @@ PsychError IOPORTRead(void)
     return(PsychError_none);
 }
 
+PsychError IOPORTReadRecords(void)
+{
+    static char useString[] = "[records, when, errmsg] = IOPort('ReadRecords', handle [, blocking=0] [, amount]);";
+    static char synopsisString[] =
+        "Read decoded binary records from device, specified by 'handle'.\n"
+        "This requires an active background read operation with a 'RecordLayout' set, see help for 'OpenSerialPort' "
+        "for the 'RecordLayout', 'RecordSync' and 'StartBackgroundRead' settings. Each 'readGranularity' quantum of "
+        "received data is one record, decoded in the background into the numeric values given by 'RecordLayout'.\n"
+        "Returned 'records' will be a matrix with one column of decoded values per record, ie., as many rows as there "
+        "are values in the 'RecordLayout', and one column for each fetched record. 'when' will be a row vector with "
+        "the receive timestamp of each record. 'errmsg' will be a human readable char string with an error message "
+        "if any error occured, otherwise an empty string.\n"
+        "The optional flag 'blocking' if set to 0 will ask the function to not block, but return immediately with all "
+        "currently available records, but at most 'amount' records if 'amount' is specified. This is the default.\n"
+        "If 'blocking' is set to 1, you must specify the 'amount' of records to receive and the function will wait "
+        "until that amount of records is available, or until the 'ReceiveTimeout' expires.\n"
+        "Records and raw data share the same input buffer, so 'ReadRecords' and 'Read' consume the same data. If a "
+        "'Read' returned only part of a record, 'ReadRecords' skips the rest of that record. Only supported on OS/X and Linux.";
+
+    static char seeAlsoString[] = "'Read', 'OpenSerialPort', 'ConfigureSerialPort'";
+
+    char errmsg[1024];
+    int handle, blocking, nrecords, amount, nvalues;
+    double* records;
+    double* timestamps;
+    double* outbuffer;
+    errmsg[0] = 0;
+
+    // Setup online help:
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(3));     // The maximum number of inputs
+    PsychErrorExit(PsychRequireNumInputArgs(1)); // The required number of inputs
+    PsychErrorExit(PsychCapNumOutputArgs(3));     // The maximum number of outputs
+
+    // Get required port handle:
+    PsychCopyInIntegerArg(1, kPsychArgRequired, &handle);
+
+    // Get optional blocking flag: Defaults to 0 -- non-blocking.
+    blocking = 0;
+    PsychCopyInIntegerArg(2, kPsychArgOptional, &blocking);
+
+    // Get optional maximum or exact amount of records to read:
+    amount = INT_MAX;
+    if (!PsychCopyInIntegerArg(3, kPsychArgOptional, &amount)) {
+        // Not spec'd:
+        if (blocking > 0) PsychErrorExitMsg(PsychError_user, "When issuing a 'ReadRecords' in blocking mode, you must specify the exact 'amount' to read, but 'amount' was omitted!");
+    }
+
+    if (amount < 0) PsychErrorExitMsg(PsychError_user, "Invalid (negative) 'amount' of records to read!");
+
+    // Read records:
+    nrecords = PsychReadRecordsIOPort(handle, &records, &timestamps, &nvalues, amount, blocking, errmsg);
+    if (nrecords < 0) {
+        if (verbosity > 0) printf("IOPort: Error: %s\n", errmsg);
+        nrecords = 0;
+    }
+
+    // Return records: Decoded values are stored record after record, which is the column-major layout
+    // of a nvalues x nrecords matrix, so a plain copy does:
+    PsychAllocOutDoubleMatArg(1, kPsychArgOptional, nvalues, nrecords, 1, &outbuffer);
+    if (nrecords > 0) memcpy(outbuffer, records, sizeof(double) * nvalues * nrecords);
+
+    // Return timestamps and errmsg, if any:
+    PsychAllocOutDoubleMatArg(2, kPsychArgOptional, 1, nrecords, 1, &outbuffer);
+    if (nrecords > 0) memcpy(outbuffer, timestamps, sizeof(double) * nrecords);
+
+    PsychCopyOutCharArg(3, kPsychArgOptional, errmsg);
+
+    return(PsychError_none);
+}
+
 PsychError IOPORTWrite(void)
 {
     static char useString[] = "[nwritten, when, errmsg, prewritetime, postwritetime, lastchecktime] = IOPort('Write', handle, data [, blocking=1]);";
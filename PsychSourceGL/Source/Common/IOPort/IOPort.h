@@ -44,6 +44,8 @@
 // Types of Input/Output port we support:
 #define KPsychIOPortNone        0                // No port: This indicates a free slot.
 #define kPsychIOPortSerial      1                // Serial port.
+#define kPsychIOPortSocket      2                // Network or Unix domain socket.
+#define kPsychIOPortPty         3                // Master side of a pseudo-terminal.
 
 typedef struct PsychPortIORecord {
     unsigned int        portType;       // Type of I/O port, see defines above.
@@ -60,6 +62,9 @@ int PsychIOOSBytesAvailableSerialPort(PsychSerialDeviceRecord* device);
 void PsychIOOSFlushSerialPort(PsychSerialDeviceRecord* device);
 void PsychIOOSPurgeSerialPort(PsychSerialDeviceRecord* device);
 void PsychIOOSShutdownSerialReaderThread(PsychSerialDeviceRecord* device);
+PsychSerialDeviceRecord* PsychIOOSOpenSocket(const char* address, const char* configString, char* errmsg);
+PsychSerialDeviceRecord* PsychIOOSOpenPty(const char* configString, char* errmsg, char* slaveName);
+int PsychIOOSReadRecordsSerialPort(PsychSerialDeviceRecord* device, double** records, double** timestamps, int* nvalues, unsigned int amount, int blocking, char* errmsg);
 
 // Public subfunction prototypes
 PsychError MODULEVersion(void);
@@ -74,6 +79,7 @@ PsychError IOPORTVerbosity(void);
 PsychError IOPORTClose(void);
 PsychError IOPORTCloseAll(void);
 PsychError IOPORTRead(void);
+PsychError IOPORTReadRecords(void);
 PsychError IOPORTWrite(void);
 PsychError IOPORTBytesAvailable(void);
 PsychError IOPORTPurge(void);
@@ -83,6 +89,10 @@ PsychError IOPORTFlush(void);
 PsychError IOPORTOpenSerialPort(void);
 PsychError IOPORTConfigureSerialPort(void);
 
+// Network socket and pseudo-terminal specific functions:
+PsychError IOPORTOpenSocket(void);
+PsychError IOPORTOpenPty(void);
+
 // Initialize usage info -- function overview:
 const char** InitializeSynopsis(void);
 
@@ -95,6 +105,7 @@ PsychError PsychCloseIOPort(int handle);
 // Write function:
 int PsychWriteIOPort(int handle, void* writedata, unsigned int amount, int blocking, char* errmsg, double* timestamp);
 int    PsychReadIOPort(int handle, void** readbuffer, unsigned int amount, int blocking, char* errmsg, double* timestamp);
+int PsychReadRecordsIOPort(int handle, double** records, double** timestamps, int* nvalues, unsigned int amount, int blocking, char* errmsg);
 int PsychBytesAvailableIOPort(int handle);
 void PsychPurgeIOPort(int handle);
 void PsychFlushIOPort(int handle);
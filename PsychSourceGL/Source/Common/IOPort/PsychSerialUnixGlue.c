@@ -25,6 +25,11 @@
         Unices, ie., for GNU/Linux and Apple MacOS/X. It is used by the higher-level serial port
         routines to abstract out operating system dependencies.
 
+        TCP, UDP and Unix domain sockets, and the master side of pseudo-terminals, are file descriptors
+        as well, so they use the same PsychSerialDeviceRecord and code paths, including background reads,
+        timestamping and scheduled trigger writes. Only termios settings and modem control lines are
+        skipped for them.
+
         The code is shared and #ifdef'ed if needed, because most of it is identical for Linux and OS/X.
 */
 
@@ -200,6 +205,64 @@ int PsychSerialUnixGlueSetBlockingMinBytes(PsychSerialDeviceRecord* device, int
     return(rc);
 }
 
+// MSG_NOSIGNAL is Linux only. OS/X uses the SO_NOSIGPIPE socket option instead:
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// Write 'amount' bytes of 'writedata' to device. Writes to sockets must not raise SIGPIPE on a
+// disconnected peer, as that would kill the whole runtime environment:
+static int PsychSerialUnixGlueWrite(PsychSerialDeviceRecord* device, void* writedata, unsigned int amount)
+{
+    if (device->portType == kPsychIOPortSocket) return((int) send(device->fileDescriptor, writedata, amount, MSG_NOSIGNAL));
+
+    return((int) write(device->fileDescriptor, writedata, amount));
+}
+
+// Setup a new connected socket 'fd' for low latency operation:
+static void PsychSerialUnixGlueSetupSocket(int fd)
+{
+    int one = 1;
+
+    // Disable Nagle's algorithm on TCP sockets, so small packets, e.g., single trigger bytes,
+    // get sent immediately instead of being delayed for coalescing. Fails harmlessly on others:
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    #ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+    #endif
+}
+
+// Accept the connection of a client to a listening server socket, waiting at most 'timeout' seconds for it
+// to connect. Returns TRUE if the device is connected, FALSE otherwise. Only one client gets accepted, the
+// listening socket is closed afterwards:
+static psych_bool PsychSerialUnixGlueAcceptClient(PsychSerialDeviceRecord* device, double timeout)
+{
+    struct pollfd pfd;
+    int fd;
+
+    if (device->fileDescriptor != -1) return(TRUE);
+
+    pfd.fd = device->listenSocket;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, (int) (timeout * 1000 + 0.5)) <= 0) return(FALSE);
+
+    if ((fd = accept(device->listenSocket, NULL, NULL)) == -1) {
+        if (verbosity > 0) printf("IOPort: Error accepting client connection on server socket %s - %s(%d).\n", device->portSpec, strerror(errno), errno);
+        return(FALSE);
+    }
+
+    PsychSerialUnixGlueSetupSocket(fd);
+    close(device->listenSocket);
+    device->listenSocket = -1;
+    device->fileDescriptor = fd;
+
+    if (verbosity > 3) printf("IOPort: Accepted client connection on server socket %s.\n", device->portSpec);
+
+    return(TRUE);
+}
+
 int PsychSerialUnixGlueAsyncReadbufferBytesAvailable(PsychSerialDeviceRecord* device)
 {
     int navail = 0;
@@ -449,8 +512,9 @@ void* PsychSerialUnixGlueReaderThreadMain( void* deviceToCast)
             return(NULL);
         }
 
-        // Update linear write pointer:
+        // Update linear write pointer and wake up clients waiting for data:
         device->readerThreadWritePos += device->readGranularity;
+        PsychSignalCondition(&(device->readerSignal));
 
         // Need to unlock the mutex:
         if ((rc=PsychUnlockMutex(&(device->readerLock)))) {
@@ -473,6 +537,256 @@ void* PsychSerialUnixGlueReaderThreadMain( void* deviceToCast)
     return(NULL);
 }
 
+// Called by PsychSerialUnixGlueEventReaderThreadMain(): Finish the readGranularity bytes slot at position 'wpos',
+// received completely at time 't', and apply read filters to it. Returns the position of the next slot, or the
+// same position if the slot got discarded by a read filter:
+static int PsychSerialUnixGlueCommitSlot(PsychSerialDeviceRecord* device, int wpos, double t, double* oldt, unsigned char* lastcharacter)
+{
+    unsigned char firstbyte = device->readBuffer[wpos % device->readBufferSize];
+    double dt = t - *oldt;
+
+    *oldt = t;
+
+    if (!(device->readFilterFlags & kPsychIOPortAsyncLineBufferFiltering)) {
+        // CR and LF filtering: Discard slots starting with code 10 or 13:
+        if ((device->readFilterFlags & kPsychIOPortCRLFFiltering) && ((firstbyte == 10) || (firstbyte == 13))) return(wpos);
+
+        // CMU or PST button box filtering: Discard redundant status bytes, attach byte counter and sampling delta
+        // in microseconds to changed ones, exactly as PsychSerialUnixGlueReaderThreadMain() does:
+        if (device->readFilterFlags & kPsychIOPortCMUPSTFiltering) {
+            if ((wpos > 0) && (firstbyte == *lastcharacter)) return(wpos);
+
+            *lastcharacter = firstbyte;
+            *((unsigned int*) &(device->readBuffer[(wpos + 1) % device->readBufferSize])) = (unsigned int) device->asyncReadBytesCount;
+            *((unsigned int*) &(device->readBuffer[(wpos + 5) % device->readBufferSize])) = (unsigned int) (dt * 1e6);
+        }
+    }
+
+    return(wpos + device->readGranularity);
+}
+
+// Decode one value of a binary record field, stored at 'p':
+static double PsychSerialUnixGlueDecodeValue(const PsychIORecordField* field, const unsigned char* p)
+{
+    unsigned long long u = 0;
+    unsigned int u32;
+    float f32;
+    double f64;
+    int b;
+
+    // Assemble raw bits in native byte order:
+    if (field->bigEndian) {
+        for (b = 0; b < field->size; b++) u = (u << 8) | p[b];
+    }
+    else {
+        for (b = field->size - 1; b >= 0; b--) u = (u << 8) | p[b];
+    }
+
+    if (field->isFloat) {
+        if (field->size == 4) {
+            u32 = (unsigned int) u;
+            memcpy(&f32, &u32, sizeof(f32));
+            return((double) f32);
+        }
+
+        memcpy(&f64, &u, sizeof(f64));
+        return(f64);
+    }
+
+    // Sign-extend signed integers of less than 64 bits:
+    if (field->isSigned) return((double) (((long long) (u << (64 - 8 * field->size))) >> (64 - 8 * field->size)));
+
+    return((double) u);
+}
+
+// Called by PsychSerialUnixGlueEventReaderThreadMain(): Decode all records in the slots from readBuffer position
+// 'fromPos' up to, but excluding, 'toPos' into device->decodedRecords, according to the configured 'RecordLayout'.
+// Decoding runs field by field over the whole batch of new records, so the per-field type dispatch happens once per
+// batch, not once per value:
+static void PsychSerialUnixGlueDecodeRecords(PsychSerialDeviceRecord* device, int fromPos, int toPos)
+{
+    const PsychIORecordField* field;
+    int nslots = device->readBufferSize / device->readGranularity;
+    int first = fromPos / device->readGranularity;
+    int count = (toPos - fromPos) / device->readGranularity;
+    int f, k, r, v, slot, offset;
+
+    for (f = 0, v = 0; f < device->recordFieldCount; f++) {
+        field = &(device->recordFields[f]);
+        for (k = 0; k < field->count; k++, v++) {
+            offset = field->offset + k * field->size;
+            for (r = 0; r < count; r++) {
+                slot = (first + r) % nslots;
+                device->decodedRecords[slot * device->recordValues + v] = PsychSerialUnixGlueDecodeValue(field, &(device->readBuffer[slot * device->readGranularity + offset]));
+            }
+        }
+    }
+
+    return;
+}
+
+/* PsychSerialUnixGlueEventReaderThreadMain() -- Event driven background reader.
+ *
+ * Sleeps in poll() until new input arrives, then fetches all pending input with
+ * one bulk read() call and distributes it into readGranularity sized slots of the
+ * readBuffer in user space. This avoids the FIONREAD polling of the polling reader,
+ * and the one read() call per byte of the line-buffered reader above, so it keeps
+ * up with Megabaud data rates at low cpu load. Stored data has exactly the same
+ * layout as with PsychSerialUnixGlueReaderThreadMain(), so all client code works
+ * unmodified.
+ *
+ * Each slot is timestamped with the time of the wakeup in which its data arrived:
+ * The first byte of a line in line-buffered mode, the last byte otherwise. Completed
+ * slots are published once per wakeup, with one lock operation.
+ *
+ * If a 'RecordLayout' is configured, each slot is a binary record and gets decoded
+ * into device->decodedRecords before publishing. If a 'RecordSync' byte is set, all
+ * data before the next sync byte is dropped whenever a new record starts, so the
+ * reader resynchronizes to the record boundaries after transmission errors.
+ */
+void* PsychSerialUnixGlueEventReaderThreadMain(void* deviceToCast)
+{
+    // Big enough to fetch any UDP datagram in one piece:
+    unsigned char chunk[65536];
+    unsigned char* src;
+    unsigned char* term;
+    unsigned char lastcharacter = 0;
+    struct pollfd pfd;
+    int rc, nread, oldstate, wpos, slotFill, slotData, n, timeoutMsecs;
+    double t, oldt, slotTime;
+    psych_bool lineMode, lineDone;
+
+    // Get a handle to our device struct: These pointers must not be NULL!!!
+    PsychSerialDeviceRecord* device = (PsychSerialDeviceRecord*) deviceToCast;
+
+    // Assign a name to ourselves, for debugging:
+    PsychSetThreadName("IOPortSerialEv");
+
+    // Try to raise our priority: We ask to switch ourselves (NULL) to priority class 2 aka
+    // realtime scheduling, with a tweakPriority of +1, ie., raise the relative
+    // priority level by +1 wrt. to the current level:
+    if ((rc = PsychSetThreadPriority(NULL, 2, 1)) > 0) {
+        if (verbosity > 0) printf("PTB-ERROR: In IOPort:PsychSerialUnixGlueEventReaderThreadMain(): Failed to switch to realtime priority [%s]!\n", strerror(rc));
+    }
+
+    // Non-blocking reads with a minimum byte count of zero, so read() returns whatever is pending:
+    PsychSerialUnixGlueFcntl(device, O_NONBLOCK);
+    if (device->portType == kPsychIOPortSerial) PsychSerialUnixGlueSetBlockingMinBytes(device, 0);
+
+    lineMode = (device->readFilterFlags & kPsychIOPortAsyncLineBufferFiltering) ? TRUE : FALSE;
+
+    // Number of data bytes per slot. The CMU/PST filter reserves the last 8 bytes of each slot
+    // for its byte counter and sampling delta:
+    slotData = (!lineMode && (device->readFilterFlags & kPsychIOPortCMUPSTFiltering)) ? device->readGranularity - 8 : device->readGranularity;
+    if (slotData < 1) slotData = 1;
+
+    wpos = device->readerThreadWritePos;
+    slotFill = 0;
+    slotTime = 0;
+    PsychGetAdjustedPrecisionTimerSeconds(&oldt);
+
+    pfd.fd = device->fileDescriptor;
+    pfd.events = POLLIN;
+
+    while (1) {
+        // Test for explicit cancellation by mother-thread:
+        PsychTestCancelThread(&(device->readerThread));
+
+        // Wait for input. A partially received line gets committed zero-padded if no further input
+        // arrives within the interbyte receive timeout, like with the blocking line-buffered reader:
+        timeoutMsecs = (lineMode && (slotFill > 0) && (device->readTimeout > 0)) ? (int) (device->readTimeout * 1000 + 0.5) : 500;
+        pfd.revents = 0;
+        rc = poll(&pfd, 1, timeoutMsecs);
+        PsychGetAdjustedPrecisionTimerSeconds(&t);
+
+        nread = 0;
+        if (rc > 0) {
+            nread = (int) read(device->fileDescriptor, chunk, sizeof(chunk));
+
+            // Hangup, end of file or error without data, e.g., closed other end of a pseudo-terminal or
+            // disconnected peer of a TCP socket? Avoid spinning:
+            if ((nread == 0) || ((nread < 0) && (errno != EAGAIN) && (errno != EINTR))) PsychYieldIntervalSeconds(0.010);
+        }
+        else if ((rc < 0) && (errno != EINTR)) {
+            if (verbosity > 5) fprintf(stderr, "PTB-ERROR: In IOPort:PsychSerialUnixGlueEventReaderThreadMain(): poll() failed [%s]!\n", strerror(errno));
+            PsychYieldIntervalSeconds(0.010);
+        }
+
+        // Prevent our cancellation while we update the readBuffer and timestamps:
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &oldstate);
+
+        if ((rc == 0) && lineMode && (slotFill > 0)) {
+            // Interbyte timeout on partial line: Commit it as is:
+            device->timeStamps[(wpos / device->readGranularity) % (device->readBufferSize / device->readGranularity)] = slotTime;
+            wpos = PsychSerialUnixGlueCommitSlot(device, wpos, t, &oldt, &lastcharacter);
+            slotFill = 0;
+        }
+
+        // Distribute new data into slots:
+        for (src = chunk; nread > 0; src += n, nread -= n) {
+            // Start of a new slot? Zero-fill it, so short lines are zero-padded:
+            if (slotFill == 0) {
+                // Binary records with sync byte: Drop everything before the next sync byte:
+                if ((device->recordSync >= 0) && (*src != (unsigned char) device->recordSync)) {
+                    term = memchr(src, device->recordSync, nread);
+                    n = (term) ? (int) (term - src) : nread;
+                    device->asyncReadBytesCount += n;
+                    continue;
+                }
+
+                memset(&(device->readBuffer[wpos % device->readBufferSize]), 0, device->readGranularity);
+                slotTime = t;
+            }
+
+            // Copy as much as fits into the slot, in line-buffered mode only up to and including the terminator:
+            n = slotData - slotFill;
+            if (n > nread) n = nread;
+
+            lineDone = FALSE;
+            if (lineMode && (term = memchr(src, device->lineTerminator, n))) {
+                n = (int) (term - src) + 1;
+                lineDone = TRUE;
+            }
+
+            // Slots never wrap around the end of the readBuffer, as its size is a multiple of the slot size:
+            memcpy(&(device->readBuffer[(wpos % device->readBufferSize) + slotFill]), src, n);
+            slotFill += n;
+            device->asyncReadBytesCount += n;
+
+            if (lineDone || (slotFill == slotData)) {
+                // Slot complete: Line-buffered slots are timestamped with the arrival of their first byte:
+                device->timeStamps[(wpos / device->readGranularity) % (device->readBufferSize / device->readGranularity)] = (lineMode) ? slotTime : t;
+                wpos = PsychSerialUnixGlueCommitSlot(device, wpos, t, &oldt, &lastcharacter);
+                slotFill = 0;
+            }
+        }
+
+        // Publish all completed slots at once and wake up clients waiting for data:
+        if (wpos != device->readerThreadWritePos) {
+            // Decode new binary records first, so they are complete when clients see them:
+            if (device->decodedRecords) PsychSerialUnixGlueDecodeRecords(device, device->readerThreadWritePos, wpos);
+
+            if ((rc = PsychLockMutex(&(device->readerLock)))) {
+                fprintf(stderr, "PTB-ERROR: In IOPort:PsychSerialUnixGlueEventReaderThreadMain(): mutex_lock failed  [%s].\n", strerror(rc));
+                return(NULL);
+            }
+
+            device->readerThreadWritePos = wpos;
+            PsychSignalCondition(&(device->readerSignal));
+
+            if ((rc = PsychUnlockMutex(&(device->readerLock)))) {
+                fprintf(stderr, "PTB-ERROR: In IOPort:PsychSerialUnixGlueEventReaderThreadMain(): mutex_unlock failed  [%s].\n", strerror(rc));
+                return(NULL);
+            }
+        }
+
+        // Reenable cancellation:
+        pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &oldstate);
+    }
+
+    return(NULL);
+}
+
 void PsychIOOSShutdownSerialReaderThread(PsychSerialDeviceRecord* device)
 {
     if (device->readerThread) {
@@ -485,12 +799,17 @@ void PsychIOOSShutdownSerialReaderThread(PsychSerialDeviceRecord* device)
         // Mark it as dead:
         device->readerThread = (psych_thread) NULL;
 
-        // Release the mutex:
+        // Release the mutex and condition variable:
         PsychDestroyMutex(&(device->readerLock));
+        PsychDestroyCondition(&(device->readerSignal));
 
         // Release timestamp buffer:
         free(device->timeStamps);
         device->timeStamps = NULL;
+
+        // Release decoded records buffer, if any:
+        if (device->decodedRecords) free(device->decodedRecords);
+        device->decodedRecords = NULL;
     }
 
     return;
@@ -598,6 +917,11 @@ PsychSerialDeviceRecord* PsychIOOSOpenSerialPort(const char* portSpec, const cha
     device->readBufferSize = 0;
     device->readerThread = (psych_thread) NULL;
     device->lineTerminator = _POSIX_VDISABLE;
+    device->isEventDrivenBackgroundRead = 1;
+    device->portType = kPsychIOPortSerial;
+    device->listenSocket = -1;
+    device->ptySlaveDescriptor = -1;
+    device->recordSync = -1;
 
     // Get the current options and save them so we can restore the default settings later.
     if (tcgetattr(fileDescriptor, &(device->OriginalTTYAttrs)) == -1) {
@@ -662,6 +986,314 @@ error:
     return(NULL);
 }
 
+/* PsychSerialUnixGlueCreateFdDevice()
+ *
+ * Create the device record for an already opened socket or pseudo-terminal
+ * 'fileDescriptor' of type 'portType', or a listening server socket 'listenSocket',
+ * and configure it via 'configString'. Used by PsychIOOSOpenSocket() and PsychIOOSOpenPty().
+ *
+ * Returns the device, or NULL with an error message in 'errmsg' on failure. All
+ * passed file descriptors are closed on failure.
+ */
+static PsychSerialDeviceRecord* PsychSerialUnixGlueCreateFdDevice(const char* portSpec, unsigned int portType, int fileDescriptor, int listenSocket,
+                                                                  int ptySlaveDescriptor, const char* configString, char* errmsg)
+{
+    PsychSerialDeviceRecord* device = NULL;
+
+    device = calloc(1, sizeof(PsychSerialDeviceRecord));
+    if (NULL == device) {
+        sprintf(errmsg, "Error opening %s - Out of memory.\n", portSpec);
+        goto error;
+    }
+
+    strncpy(device->portSpec, portSpec, sizeof(device->portSpec) - 1);
+    device->portType = portType;
+    device->fileDescriptor = fileDescriptor;
+    device->listenSocket = listenSocket;
+    device->ptySlaveDescriptor = ptySlaveDescriptor;
+    device->readerThread = (psych_thread) NULL;
+    device->lineTerminator = _POSIX_VDISABLE;
+    device->isEventDrivenBackgroundRead = 1;
+    device->recordSync = -1;
+
+    if (PsychError_none != PsychIOOSConfigureSerialPort(device, configString)) {
+        sprintf(errmsg, "Error changing device settings for device %s.\n", portSpec);
+        goto error;
+    }
+
+    if (device->readBuffer == NULL) {
+        sprintf(errmsg, "Error for device %s - No InputBuffer allocated! You must specify the 'InputBuffer' size in the configuration.\n", portSpec);
+        goto error;
+    }
+
+    return(device);
+
+error:
+
+    if (device) {
+        PsychIOOSShutdownSerialReaderThread(device);
+        if (device->readBuffer) free(device->readBuffer);
+        free(device);
+    }
+
+    if (fileDescriptor != -1) close(fileDescriptor);
+    if (listenSocket != -1) close(listenSocket);
+    if (ptySlaveDescriptor != -1) close(ptySlaveDescriptor);
+
+    return(NULL);
+}
+
+/* PsychIOOSOpenSocket()
+ *
+ * Open a network or Unix domain socket and configure it.
+ *
+ * address - String with the type and address of the socket:
+ *           tcp:host:port          TCP connection to server 'host' at 'port'.
+ *           tcplisten:[host:]port  TCP server at 'port', optionally only on the interface with address 'host'.
+ *           udp:host:port          UDP socket which sends to and receives from 'host' at 'port'.
+ *           udp::port              Receive only UDP socket, which receives from any sender at 'port'.
+ *           unix:path              Unix domain stream socket connection to server socket file 'path'.
+ *           unixlisten:path        Unix domain stream socket server, creating socket file 'path'.
+ * configString - String with port configuration parameters. In addition to the generic parameters,
+ *                LocalPort=port binds UDP sockets to the given local 'port'.
+ * errmsg - Pointer to char[] buffer in which error messages should be returned, if any.
+ *
+ * Server sockets are returned immediately. The first client to connect gets accepted by the
+ * next operation on the device which needs a connection.
+ *
+ * On success, allocate a PsychSerialDeviceRecord with all relevant settings,
+ * return a pointer to it. Otherwise abort with error message.
+ */
+PsychSerialDeviceRecord* PsychIOOSOpenSocket(const char* address, const char* configString, char* errmsg)
+{
+    struct addrinfo hints, *result = NULL, *ai;
+    struct sockaddr_un unaddr;
+    struct sockaddr_in6 localaddr;
+    PsychSerialDeviceRecord* device = NULL;
+    char host[256], port[32];
+    const char* hostport;
+    const char* p;
+    psych_bool isListen = FALSE, isUnix = FALSE, isUDP = FALSE;
+    int fd = -1, listenfd = -1, rc, localPort = -1, one = 1;
+    size_t len;
+
+    errmsg[0] = 0;
+
+    if (strstr(address, "tcplisten:") == address) { isListen = TRUE; hostport = address + strlen("tcplisten:"); }
+    else if (strstr(address, "tcp:") == address) { hostport = address + strlen("tcp:"); }
+    else if (strstr(address, "udp:") == address) { isUDP = TRUE; hostport = address + strlen("udp:"); }
+    else if (strstr(address, "unixlisten:") == address) { isUnix = TRUE; isListen = TRUE; hostport = address + strlen("unixlisten:"); }
+    else if (strstr(address, "unix:") == address) { isUnix = TRUE; hostport = address + strlen("unix:"); }
+    else {
+        sprintf(errmsg, "Invalid socket address '%s'. Must start with tcp:, tcplisten:, udp:, unix: or unixlisten:\n", address);
+        goto error;
+    }
+
+    if (isUnix) {
+        // Unix domain stream socket:
+        memset(&unaddr, 0, sizeof(unaddr));
+        unaddr.sun_family = AF_UNIX;
+        if ((strlen(hostport) == 0) || (strlen(hostport) >= sizeof(unaddr.sun_path))) {
+            sprintf(errmsg, "Invalid socket address '%s': Socket file name empty or too long.\n", address);
+            goto error;
+        }
+        strcpy(unaddr.sun_path, hostport);
+
+        if ((rc = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) {
+            sprintf(errmsg, "Error creating socket for %s - %s(%d).\n", address, strerror(errno), errno);
+            goto error;
+        }
+
+        if (isListen) {
+            listenfd = rc;
+            if ((bind(listenfd, (struct sockaddr*) &unaddr, sizeof(unaddr)) == -1) || (listen(listenfd, 1) == -1)) {
+                sprintf(errmsg, "Error creating server socket %s - %s(%d). Maybe the socket file already exists?\n", address, strerror(errno), errno);
+                goto error;
+            }
+        }
+        else {
+            fd = rc;
+            if (connect(fd, (struct sockaddr*) &unaddr, sizeof(unaddr)) == -1) {
+                sprintf(errmsg, "Error connecting to socket %s - %s(%d).\n", address, strerror(errno), errno);
+                goto error;
+            }
+        }
+    }
+    else {
+        // TCP or UDP socket: Split 'hostport' at the last colon into host and port. The host may be an IPv6
+        // address in brackets, e.g., [::1]:5000, and is empty for UDP receive only sockets and all-interface servers:
+        p = strrchr(hostport, ':');
+        len = (p) ? (size_t) (p - hostport) : 0;
+        if (len >= sizeof(host) || strlen((p) ? p + 1 : hostport) >= sizeof(port)) {
+            sprintf(errmsg, "Invalid socket address '%s': Host name or port too long.\n", address);
+            goto error;
+        }
+
+        memcpy(host, hostport, len);
+        host[len] = 0;
+        strcpy(port, (p) ? p + 1 : hostport);
+        if ((len >= 2) && (host[0] == '[') && (host[len - 1] == ']')) {
+            memmove(host, host + 1, len - 2);
+            host[len - 2] = 0;
+        }
+
+        if ((strlen(port) == 0) || ((strlen(host) == 0) && !isListen && !isUDP)) {
+            sprintf(errmsg, "Invalid socket address '%s': Host or port missing.\n", address);
+            goto error;
+        }
+
+        if ((p = strstr(configString, "LocalPort=")) && ((1 != sscanf(p, "LocalPort=%i", &localPort)) || (localPort < 0) || (localPort > 65535))) {
+            sprintf(errmsg, "Invalid parameter for LocalPort= set!\n");
+            goto error;
+        }
+
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = (isUDP) ? SOCK_DGRAM : SOCK_STREAM;
+        hints.ai_flags = (strlen(host) == 0) ? AI_PASSIVE : 0;
+
+        if ((rc = getaddrinfo((strlen(host) > 0) ? host : NULL, port, &hints, &result))) {
+            sprintf(errmsg, "Could not resolve socket address '%s' - %s.\n", address, gai_strerror(rc));
+            goto error;
+        }
+
+        // Try all returned addresses until one works:
+        for (ai = result; ai; ai = ai->ai_next) {
+            if ((rc = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol)) == -1) continue;
+
+            if (isListen) {
+                // TCP server:
+                setsockopt(rc, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+                if ((bind(rc, ai->ai_addr, ai->ai_addrlen) == 0) && (listen(rc, 1) == 0)) { listenfd = rc; break; }
+            }
+            else if (isUDP) {
+                // UDP: Bind to the local port if one is requested, or to the given port for receive only sockets,
+                // then connect to the peer, so read() and write() exchange datagrams with it only:
+                if ((localPort >= 0) || (strlen(host) == 0)) {
+                    memset(&localaddr, 0, sizeof(localaddr));
+                    if (ai->ai_family == AF_INET6) {
+                        localaddr.sin6_family = AF_INET6;
+                        localaddr.sin6_port = (strlen(host) == 0) ? ((struct sockaddr_in6*) ai->ai_addr)->sin6_port : htons((unsigned short) localPort);
+                        localaddr.sin6_addr = in6addr_any;
+                    }
+                    else {
+                        ((struct sockaddr_in*) &localaddr)->sin_family = AF_INET;
+                        ((struct sockaddr_in*) &localaddr)->sin_port = (strlen(host) == 0) ? ((struct sockaddr_in*) ai->ai_addr)->sin_port : htons((unsigned short) localPort);
+                        ((struct sockaddr_in*) &localaddr)->sin_addr.s_addr = htonl(INADDR_ANY);
+                    }
+
+                    setsockopt(rc, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+                    if (bind(rc, (struct sockaddr*) &localaddr, (ai->ai_family == AF_INET6) ? sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in)) == -1) { close(rc); continue; }
+                }
+
+                if ((strlen(host) == 0) || (connect(rc, ai->ai_addr, ai->ai_addrlen) == 0)) { fd = rc; break; }
+            }
+            else {
+                // TCP client:
+                if (connect(rc, ai->ai_addr, ai->ai_addrlen) == 0) { fd = rc; break; }
+            }
+
+            close(rc);
+        }
+
+        freeaddrinfo(result);
+
+        if ((fd == -1) && (listenfd == -1)) {
+            sprintf(errmsg, "Error %s socket %s - %s(%d).\n", (isListen) ? "creating server" : "connecting", address, strerror(errno), errno);
+            goto error;
+        }
+    }
+
+    if (fd != -1) PsychSerialUnixGlueSetupSocket(fd);
+
+    device = PsychSerialUnixGlueCreateFdDevice(address, kPsychIOPortSocket, fd, listenfd, -1, configString, errmsg);
+    if (device == NULL) {
+        // Remove socket file of a failed Unix domain server socket:
+        if (isUnix && isListen) unlink(hostport);
+        goto error_closed;
+    }
+
+    return(device);
+
+error:
+
+    if (fd != -1) close(fd);
+    if (listenfd != -1) close(listenfd);
+
+error_closed:
+
+    // Return with error message:
+    if (verbosity > 0) PsychErrorExitMsg(PsychError_user, errmsg);
+
+    return(NULL);
+}
+
+/* PsychIOOSOpenPty()
+ *
+ * Create a new pseudo-terminal, open and configure its master side.
+ *
+ * configString - String with port configuration parameters.
+ * errmsg - Pointer to char[] buffer in which error messages should be returned, if any.
+ * slaveName - Pointer to char[1000] buffer which receives the device file name of the slave side.
+ *
+ * The slave side is switched to raw mode and kept open while the master is open, so data written
+ * to the master gets queued until a client opens and reads the slave, and clients can open and
+ * close the slave without causing hangups on the master.
+ *
+ * On success, allocate a PsychSerialDeviceRecord with all relevant settings,
+ * return a pointer to it. Otherwise abort with error message.
+ */
+PsychSerialDeviceRecord* PsychIOOSOpenPty(const char* configString, char* errmsg, char* slaveName)
+{
+    PsychSerialDeviceRecord* device = NULL;
+    struct termios options;
+    char* name;
+    int fd = -1, slavefd = -1;
+
+    errmsg[0] = 0;
+    slaveName[0] = 0;
+
+    if (((fd = posix_openpt(O_RDWR | O_NOCTTY)) == -1) || (grantpt(fd) == -1) || (unlockpt(fd) == -1) || ((name = ptsname(fd)) == NULL)) {
+        sprintf(errmsg, "Error creating pseudo-terminal - %s(%d).\n", strerror(errno), errno);
+        goto error;
+    }
+
+    strncpy(slaveName, name, 999);
+    slaveName[999] = 0;
+
+    if ((slavefd = open(slaveName, O_RDWR | O_NOCTTY | O_NONBLOCK)) == -1) {
+        sprintf(errmsg, "Error opening slave side %s of pseudo-terminal - %s(%d).\n", slaveName, strerror(errno), errno);
+        goto error;
+    }
+
+    // Raw mode without echo, so data passes through unmodified:
+    if ((tcgetattr(slavefd, &options) == -1) || (cfmakeraw(&options), tcsetattr(slavefd, TCSANOW, &options) == -1)) {
+        sprintf(errmsg, "Error switching pseudo-terminal %s to raw mode - %s(%d).\n", slaveName, strerror(errno), errno);
+        goto error;
+    }
+
+    device = PsychSerialUnixGlueCreateFdDevice(slaveName, kPsychIOPortPty, fd, -1, slavefd, configString, errmsg);
+    if (device == NULL) {
+        slaveName[0] = 0;
+        goto error_closed;
+    }
+
+    return(device);
+
+error:
+
+    if (fd != -1) close(fd);
+    if (slavefd != -1) close(slavefd);
+    slaveName[0] = 0;
+
+error_closed:
+
+    // Return with error message:
+    if (verbosity > 0) PsychErrorExitMsg(PsychError_system, errmsg);
+
+    return(NULL);
+}
+
 /* PsychIOOSCloseSerialPort()
  *
  * Close serial port connection/device referenced by given 'device' record.
@@ -673,27 +1305,35 @@ void PsychIOOSCloseSerialPort(PsychSerialDeviceRecord* device)
 
     PsychIOOSShutdownSerialReaderThread(device);
 
-    // Drain all send-buffers:
-    // Block until all written output has been sent from the device.
-    // Note that this call is simply passed on to the serial device driver.
-    // See tcsendbreak(3) ("man 3 tcsendbreak") for details.
-    if ((!device->dontFlushOnWrite) && (tcdrain(device->fileDescriptor) == -1)) {
-        if (verbosity > 1) printf("IOPort: WARNING: While trying to close serial port: Error waiting for drain - %s(%d).\n", strerror(errno), errno);
-    }
+    if (device->portType == kPsychIOPortSerial) {
+        // Drain all send-buffers:
+        // Block until all written output has been sent from the device.
+        // Note that this call is simply passed on to the serial device driver.
+        // See tcsendbreak(3) ("man 3 tcsendbreak") for details.
+        if ((!device->dontFlushOnWrite) && (tcdrain(device->fileDescriptor) == -1)) {
+            if (verbosity > 1) printf("IOPort: WARNING: While trying to close serial port: Error waiting for drain - %s(%d).\n", strerror(errno), errno);
+        }
 
-    // Traditionally it is good practice to reset a serial port back to
-    // the state in which you found it. This is why the original termios struct
-    // was saved.
-    if (tcsetattr(device->fileDescriptor, TCSANOW, &(device->OriginalTTYAttrs)) == -1) {
-        if (verbosity > 1) printf("IOPort: WARNING: While trying to close serial port: Could not restore original port settings - %s(%d).\n", strerror(errno), errno);
+        // Traditionally it is good practice to reset a serial port back to
+        // the state in which you found it. This is why the original termios struct
+        // was saved.
+        if (tcsetattr(device->fileDescriptor, TCSANOW, &(device->OriginalTTYAttrs)) == -1) {
+            if (verbosity > 1) printf("IOPort: WARNING: While trying to close serial port: Could not restore original port settings - %s(%d).\n", strerror(errno), errno);
+        }
     }
 
-    // Close device:
-    close(device->fileDescriptor);
+    // Close device, and for sockets and pseudo-terminals the listening server socket and slave side, if any:
+    if (device->fileDescriptor != -1) close(device->fileDescriptor);
+    if (device->listenSocket != -1) close(device->listenSocket);
+    if (device->ptySlaveDescriptor != -1) close(device->ptySlaveDescriptor);
+
+    // Remove the socket file of a Unix domain server socket:
+    if ((device->portType == kPsychIOPortSocket) && (strstr(device->portSpec, "unixlisten:") == device->portSpec)) unlink(device->portSpec + strlen("unixlisten:"));
 
     // Release read buffer and/or bounceBuffer, if any:
     if (device->readBuffer) free(device->readBuffer);
     if (device->bounceBuffer) free(device->bounceBuffer);
+    if (device->recordBounceBuffer) free(device->recordBounceBuffer);
 
     // Release memory for device struct:
     free(device);
@@ -702,6 +1342,9 @@ void PsychIOOSCloseSerialPort(PsychSerialDeviceRecord* device)
     return;
 }
 
+static PsychError PsychSerialUnixGlueConfigureCommon(PsychSerialDeviceRecord* device, const char* configString);
+static PsychError PsychSerialUnixGlueConfigureFd(PsychSerialDeviceRecord* device, const char* configString);
+
 /* PsychIOOSConfigureSerialPort()
  *
  * (Re-)configure serial port connection/device referenced by given 'device' record.
@@ -714,7 +1357,6 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
 #if PSYCH_SYSTEM == PSYCH_LINUX
     struct serial_struct serialstruct;
 #endif
-    int rc;
     struct termios options;
     int handshake;
     char* p;
@@ -723,6 +1365,9 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
     unsigned long mics = 0UL;
     psych_bool updatetermios = FALSE;
 
+    // Sockets and pseudo-terminals don't have termios settings or modem control lines:
+    if (device->portType != kPsychIOPortSerial) return(PsychSerialUnixGlueConfigureFd(device, configString));
+
     // The serial port attributes such as timeouts and baud rate are set by modifying the termios
     // structure and then calling tcsetattr() to cause the changes to take effect. Note that the
     // changes will not become effective without the tcsetattr() call.
@@ -1185,6 +1830,106 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
     }
 #endif
 
+    // Settings common to all port types:
+    return(PsychSerialUnixGlueConfigureCommon(device, configString));
+}
+
+/* PsychSerialUnixGlueParseRecordLayout()
+ *
+ * Parse a binary record layout spec, as passed via 'RecordLayout=', into the
+ * recordFields of 'device'. The spec is a comma separated list of fields, each
+ * of the form type[le|be]@offset[xcount], e.g., "u8@0,i24be@1x8,f32@25". Valid
+ * types are u8, i8, u16, i16, u24, i24, u32, i32, f32 and f64. Byte order is
+ * little endian by default. The special spec "None" disables record decoding.
+ *
+ * Returns TRUE on success, FALSE on a malformed spec.
+ */
+static psych_bool PsychSerialUnixGlueParseRecordLayout(PsychSerialDeviceRecord* device, const char* spec)
+{
+    PsychIORecordField* field;
+    char type;
+    int bits, n;
+
+    device->recordFieldCount = 0;
+    device->recordValues = 0;
+
+    if (strncmp(spec, "None", 4) == 0) return(TRUE);
+
+    while (*spec && !isspace((unsigned char) *spec)) {
+        if (device->recordFieldCount >= PSYCH_IOPORT_MAXRECORDFIELDS) {
+            if (verbosity > 0) printf("Too many fields in RecordLayout= spec! Maximum is %i.\n", PSYCH_IOPORT_MAXRECORDFIELDS);
+            return(FALSE);
+        }
+
+        field = &(device->recordFields[device->recordFieldCount]);
+        memset(field, 0, sizeof(PsychIORecordField));
+        field->count = 1;
+
+        // Type and size:
+        if ((2 != sscanf(spec, "%c%i%n", &type, &bits, &n)) || ((type != 'u') && (type != 'i') && (type != 'f')) ||
+            ((type != 'f') && (bits != 8) && (bits != 16) && (bits != 24) && (bits != 32)) || ((type == 'f') && (bits != 32) && (bits != 64))) {
+            if (verbosity > 0) printf("Invalid field type in RecordLayout= spec at '%s'! Valid types are u8, i8, u16, i16, u24, i24, u32, i32, f32 and f64.\n", spec);
+            return(FALSE);
+        }
+
+        field->size = bits / 8;
+        field->isSigned = (type == 'i') ? 1 : 0;
+        field->isFloat = (type == 'f') ? 1 : 0;
+        spec += n;
+
+        // Optional byte order:
+        if (strncmp(spec, "be", 2) == 0) {
+            field->bigEndian = 1;
+            spec += 2;
+        }
+        else if (strncmp(spec, "le", 2) == 0) {
+            spec += 2;
+        }
+
+        // Byte offset and optional count:
+        if ((1 != sscanf(spec, "@%i%n", &(field->offset), &n)) || (field->offset < 0)) {
+            if (verbosity > 0) printf("Invalid or missing @offset for field in RecordLayout= spec at '%s'!\n", spec);
+            return(FALSE);
+        }
+        spec += n;
+
+        if (*spec == 'x') {
+            if ((1 != sscanf(spec, "x%i%n", &(field->count), &n)) || (field->count < 1)) {
+                if (verbosity > 0) printf("Invalid xcount for field in RecordLayout= spec at '%s'!\n", spec);
+                return(FALSE);
+            }
+            spec += n;
+        }
+
+        if (*spec == ',') {
+            spec++;
+        }
+        else if (*spec && !isspace((unsigned char) *spec)) {
+            if (verbosity > 0) printf("Invalid character in RecordLayout= spec at '%s'!\n", spec);
+            return(FALSE);
+        }
+
+        device->recordValues += field->count;
+        device->recordFieldCount++;
+    }
+
+    return(TRUE);
+}
+
+/* PsychSerialUnixGlueConfigureCommon()
+ *
+ * Apply the settings of 'configString' which are common to all port types: Input buffering,
+ * background reads and scheduled trigger writes. Called by PsychIOOSConfigureSerialPort()
+ * and PsychSerialUnixGlueConfigureFd().
+ */
+static PsychError PsychSerialUnixGlueConfigureCommon(PsychSerialDeviceRecord* device, const char* configString)
+{
+    int rc, i;
+    char* p;
+    float infloat;
+    double indouble;
+    int inint;
+
     // Set input buffer size for receive ops:
     if ((p = strstr(configString, "InputBufferSize="))) {
 
@@ -1271,6 +2016,19 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
         device->isBlockingBackgroundRead = inint;
     }
 
+    if ((p = strstr(configString, "EventDrivenBackgroundRead="))) {
+        if (1!=sscanf(p, "EventDrivenBackgroundRead=%i", &inint)) {
+            if (verbosity > 0) printf("Invalid parameter for EventDrivenBackgroundRead= set!\n");
+            return(PsychError_invalidIntegerArg);
+        }
+
+        if (device->readerThread) {
+            if (verbosity > 0) printf("Assigned EventDrivenBackgroundRead= while background read operations are already enabled! Disable first via 'StopBackgroundRead'!\n");
+            return(PsychError_user);
+        }
+        device->isEventDrivenBackgroundRead = inint;
+    }
+
     if ((p = strstr(configString, "ReadFilterFlags="))) {
         if (1!=sscanf(p, "ReadFilterFlags=%i", &inint)) {
             if (verbosity > 0) printf("Invalid parameter for ReadFilterFlags= set!\n");
@@ -1288,6 +2046,33 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
         device->readFilterFlags = (unsigned int) inint;
     }
 
+    if ((p = strstr(configString, "RecordLayout="))) {
+        if (device->readerThread) {
+            if (verbosity > 0) printf("Assigned RecordLayout= while background read operations are already enabled! Disable first via 'StopBackgroundRead'!\n");
+            return(PsychError_user);
+        }
+
+        if (!PsychSerialUnixGlueParseRecordLayout(device, p + strlen("RecordLayout="))) {
+            device->recordFieldCount = 0;
+            device->recordValues = 0;
+            return(PsychError_user);
+        }
+    }
+
+    if ((p = strstr(configString, "RecordSync="))) {
+        if ((1!=sscanf(p, "RecordSync=%i", &inint)) || (inint < -1) || (inint > 255)) {
+            if (verbosity > 0) printf("Invalid parameter for RecordSync= set! Must be a byte value between 0 and 255, or -1 for none.\n");
+            return(PsychError_invalidIntegerArg);
+        }
+
+        if (device->readerThread) {
+            if (verbosity > 0) printf("Assigned RecordSync= while background read operations are already enabled! Disable first via 'StopBackgroundRead'!\n");
+            return(PsychError_user);
+        }
+
+        device->recordSync = inint;
+    }
+
     // Stop a background reader?
     if ((p = strstr(configString, "StopBackgroundRead"))) {
         PsychIOOSShutdownSerialReaderThread(device);
@@ -1321,6 +2106,20 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
                 return(PsychError_user);
             }
 
+            // All fields of a binary record layout must fit into one slot:
+            for (i = 0; i < device->recordFieldCount; i++) {
+                if (device->recordFields[i].offset + device->recordFields[i].count * device->recordFields[i].size > inint) {
+                    if (verbosity > 0) printf("Invalid StartBackgroundRead fetch granularity of %i bytes provided. Field %i of the RecordLayout= extends beyond the end of a record of that size!\n", inint, i + 1);
+                    return(PsychError_invalidIntegerArg);
+                }
+            }
+
+            // Server sockets need a connected client before data can be received:
+            if (!PsychSerialUnixGlueAcceptClient(device, device->readTimeout)) {
+                if (verbosity > 0) printf("Called StartBackgroundRead on server socket %s, but no client connected within 'ReceiveTimeout' seconds!\n", device->portSpec);
+                return(PsychError_user);
+            }
+
             // Setup data structures:
             device->asyncReadBytesCount = 0;
             device->readerThreadWritePos = 0;
@@ -1333,12 +2132,21 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
             // Allocate sufficiently large timestamp buffer:
             device->timeStamps = (double*) calloc(sizeof(double), device->readBufferSize / device->readGranularity);
 
-            // Create & Init the mutex:
+            // Allocate buffer for decoded binary records, one per slot, if record decoding is enabled:
+            if (device->recordFieldCount > 0) device->decodedRecords = (double*) calloc(sizeof(double), (size_t) device->recordValues * (device->readBufferSize / device->readGranularity));
+
+            // Create & Init the mutex and the condition variable for signalling new data:
             if ((rc=PsychInitMutex(&(device->readerLock)))) {
                 printf("PTB-ERROR: In StartBackgroundRead(): Could not create readerLock mutex lock [%s].\n", strerror(rc));
                 return(PsychError_system);
             }
 
+            if ((rc=PsychInitCondition(&(device->readerSignal), NULL))) {
+                printf("PTB-ERROR: In StartBackgroundRead(): Could not create readerSignal condition variable [%s].\n", strerror(rc));
+                PsychDestroyMutex(&(device->readerLock));
+                return(PsychError_system);
+            }
+
             // Perform lock->unlock mutex sequence to inject some memory ordering barriers here, so all our
             // settings are picked up by the newborn thread:
             if ((rc=PsychLockMutex(&(device->readerLock))) || (rc=PsychUnlockMutex(&(device->readerLock)))) {
@@ -1346,8 +2154,9 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
                 return(PsychError_system);
             }
 
-            // Create and startup thread:
-            if ((rc=PsychCreateThread(&(device->readerThread), NULL, PsychSerialUnixGlueReaderThreadMain, (void*) device))) {
+            // Create and startup thread. Sockets and pseudo-terminals always use the event driven reader,
+            // as the polling and blocking reader depend on termios settings. So does record decoding:
+            if ((rc=PsychCreateThread(&(device->readerThread), NULL, (device->isEventDrivenBackgroundRead || device->decodedRecords || (device->portType != kPsychIOPortSerial)) ? PsychSerialUnixGlueEventReaderThreadMain : PsychSerialUnixGlueReaderThreadMain, (void*) device))) {
                 printf("PTB-ERROR: In StartBackgroundRead(): Could not create background reader thread [%s].\n", strerror(rc));
                 return(PsychError_system);
             }
@@ -1365,13 +2174,14 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
     // Proof-of-concept test code: Not for public use!
     // Async triggerbyte emission via parallel thread requested?
     if ((p = strstr(configString, "JLFireTrigger="))) {
-        if (1!=sscanf(p, "JLFireTrigger=%f", &infloat)) {
+        // Parse as double, as float can't represent GetSecs() timestamps with sub-second precision:
+        if (1!=sscanf(p, "JLFireTrigger=%lf", &indouble)) {
             if (verbosity > 0) printf("Invalid parameter for JLFireTrigger set!\n");
             return(PsychError_user);
         }
         else {
             // Store target time in device struct:
-            device->triggerWhen = (double) infloat;
+            device->triggerWhen = indouble;
 
             // Create and startup trigger thread: It will detach itself from us, do
             // its job and then die lonely and forgotten without us caring:
@@ -1387,6 +2197,49 @@ PsychError PsychIOOSConfigureSerialPort(PsychSerialDeviceRecord* device, const c
     return(PsychError_none);
 }
 
+/* PsychSerialUnixGlueConfigureFd()
+ *
+ * (Re-)configure socket or pseudo-terminal 'device'. Only the receive timeout and line terminator
+ * of the serial port settings apply to them, everything else is common to all port types.
+ */
+static PsychError PsychSerialUnixGlueConfigureFd(PsychSerialDeviceRecord* device, const char* configString)
+{
+    char* p;
+    float infloat;
+    int inint;
+
+    if ((p = strstr(configString, "ReceiveTimeout="))) {
+        if ((1!=sscanf(p, "ReceiveTimeout=%f", &infloat)) || (infloat < 0)) {
+            if (verbosity > 0) printf("Invalid parameter for ReceiveTimeout set! Typo, or negative value provided.\n");
+            return(PsychError_user);
+        }
+
+        if (device->readerThread) {
+            if (verbosity > 0) printf("Assigned ReceiveTimeout= while background read operations are already enabled! Disable first via 'StopBackgroundRead'!\n");
+            return(PsychError_user);
+        }
+
+        // No termios quantization to 0.1 secs here, as all waits are done via poll():
+        device->readTimeout = infloat;
+    }
+
+    if ((p = strstr(configString, "Terminator="))) {
+        if (1!=sscanf(p, "Terminator=%i", &inint)) {
+            if (verbosity > 0) printf("Invalid parameter for Terminator= set!\n");
+            return(PsychError_invalidIntegerArg);
+        }
+
+        if (device->readerThread) {
+            if (verbosity > 0) printf("Assigned Terminator= while background read operations are already enabled! Disable first via 'StopBackgroundRead'!\n");
+            return(PsychError_user);
+        }
+
+        device->lineTerminator = (unsigned char) inint;
+    }
+
+    return(PsychSerialUnixGlueConfigureCommon(device, configString));
+}
+
 /* PsychIOOSWriteSerialPort()
  *
  * Write data to serial port:
@@ -1408,6 +2261,12 @@ int PsychIOOSWriteSerialPort(PsychSerialDeviceRecord* device, void* writedata, u
     unsigned int lsr = 0;   // Serial transmitter line status register.
     int outqueue_pending;    // Pending bytes in output queue.
 
+    // Server sockets need a connected client first:
+    if (!PsychSerialUnixGlueAcceptClient(device, (blocking > 0) ? device->readTimeout : 0)) {
+        sprintf(errmsg, "Error during write to device %s - No client connected to server socket.\n", device->portSpec);
+        return(-1);
+    }
+
     // Nonblocking mode?
     if (blocking <= 0) {
         // Yep. Set filedescriptor to non-blocking mode:
@@ -1420,7 +2279,7 @@ int PsychIOOSWriteSerialPort(PsychSerialDeviceRecord* device, void* writedata, u
 
         // Write the data: Take pre- and postwrite timestamps.
         PsychGetAdjustedPrecisionTimerSeconds(&timestamp[1]);
-        if ((nwritten = write(device->fileDescriptor, writedata, amount)) == -1) {
+        if ((nwritten = PsychSerialUnixGlueWrite(device, writedata, amount)) == -1) {
             sprintf(errmsg, "Error during write to device %s - %s(%d).\n", device->portSpec, strerror(errno), errno);
             return(-1);
         }
@@ -1437,7 +2296,7 @@ int PsychIOOSWriteSerialPort(PsychSerialDeviceRecord* device, void* writedata, u
 
         // Write the data: Take pre- and postwrite timestamps.
         PsychGetAdjustedPrecisionTimerSeconds(&timestamp[1]);
-        if ((nwritten = write(device->fileDescriptor, writedata, amount)) == -1) {
+        if ((nwritten = PsychSerialUnixGlueWrite(device, writedata, amount)) == -1) {
             sprintf(errmsg, "Error during write to device %s - %s(%d).\n", device->portSpec, strerror(errno), errno);
             return(-1);
         }
@@ -1485,8 +2344,9 @@ int PsychIOOSWriteSerialPort(PsychSerialDeviceRecord* device, void* writedata, u
             // Take timestamp for completeness although it doesn't make much sense in the blocking case:
             PsychGetAdjustedPrecisionTimerSeconds(&timestamp[3]);
 
-            // Flush the write buffer and wait for write completion on physical hardware:
-            if ((!device->dontFlushOnWrite) && (tcdrain(device->fileDescriptor) == -1)) {
+            // Flush the write buffer and wait for write completion on physical hardware. Sockets and
+            // pseudo-terminals have no physical transmission to wait for:
+            if ((!device->dontFlushOnWrite) && (device->portType == kPsychIOPortSerial) && (tcdrain(device->fileDescriptor) == -1)) {
                 sprintf(errmsg, "Error during write to device %s while draining the write buffers - %s(%d).\n", device->portSpec, strerror(errno), errno);
                 return(-1);
             }
@@ -1507,8 +2367,16 @@ int PsychIOOSReadSerialPort(PsychSerialDeviceRecord* device, void** readdata, un
     int nread = 0;
     int gotamount, reqamount;
     unsigned char* tmpbuffer;
+    struct pollfd pfd;
     *readdata = NULL;
 
+    // Server sockets without a connected client have no data. Wait for a client in blocking mode:
+    if (!PsychSerialUnixGlueAcceptClient(device, (blocking > 0) ? device->readTimeout : 0)) {
+        PsychGetAdjustedPrecisionTimerSeconds(timestamp);
+        errmsg[0] = 0;
+        return(0);
+    }
+
     // Clamp 'amount' of data to be read to receive buffer size:
     if (amount > device->readBufferSize) {
         // Too much. Is amount unspecified aka INT_MAX? In that case,
@@ -1559,22 +2427,51 @@ int PsychIOOSReadSerialPort(PsychSerialDeviceRecord* device, void** readdata, un
 
         // Background read active?
         if (device->readerThread) {
-            // Poll until requested amount of data is available:
-            // TODO FIXME: Could do this in a more friendly way by using condition
-            // variables, so we sleep until async reader thread signals availability
-            // of sufficient data...
+            // Sleep until the reader thread signals availability of the requested amount of data, or timeout:
             PsychGetAdjustedPrecisionTimerSeconds(&timeout);
             *timestamp = timeout;
             timeout+=device->readTimeout;
 
-            while((*timestamp < timeout) && (PsychSerialUnixGlueAsyncReadbufferBytesAvailable(device) < (int) amount)) {
+            PsychLockMutex(&(device->readerLock));
+            while((*timestamp < timeout) && (device->readerThreadWritePos - device->clientThreadReadPos < (int) amount)) {
+                PsychTimedWaitCondition(&(device->readerSignal), &(device->readerLock), timeout - *timestamp);
                 PsychGetAdjustedPrecisionTimerSeconds(timestamp);
-                PsychWaitIntervalSeconds(device->pollLatency);
             }
+            PsychUnlockMutex(&(device->readerLock));
 
             // Return amount of available data:
             nread = PsychSerialUnixGlueAsyncReadbufferBytesAvailable(device);
         }
+        else if (device->portType != kPsychIOPortSerial) {
+            // Socket or pseudo-terminal: No termios minimum byte counts and timeouts, so wait for
+            // each chunk of data via poll(), with the receive timeout as interbyte timeout:
+            if (PsychSerialUnixGlueFcntl(device, O_NONBLOCK) == -1) {
+                sprintf(errmsg, "Error setting O_NONBLOCK on device %s for blocking read - %s(%d).\n", device->portSpec, strerror(errno), errno);
+                return(-1);
+            }
+
+            tmpbuffer = device->readBuffer;
+            pfd.fd = device->fileDescriptor;
+            pfd.events = POLLIN;
+
+            while (amount > 0) {
+                pfd.revents = 0;
+                if (poll(&pfd, 1, (device->readTimeout > 0) ? (int) (device->readTimeout * 1000 + 0.5) : -1) <= 0) break;
+
+                if ((gotamount = read(device->fileDescriptor, tmpbuffer, amount)) == -1) {
+                    if ((errno == EAGAIN) || (errno == EINTR)) continue;
+                    sprintf(errmsg, "Error during blocking read from device %s - %s(%d).\n", device->portSpec, strerror(errno), errno);
+                    return(-1);
+                }
+
+                // End of file, e.g., disconnected peer?
+                if (gotamount == 0) break;
+
+                tmpbuffer += gotamount;
+                amount    -= gotamount;
+                nread     += gotamount;
+            }
+        }
         else {
             // Set filedescriptor to blocking mode:
             // Clear the O_NONBLOCK flag so subsequent I/O will block.
@@ -1736,10 +2633,98 @@ int PsychIOOSReadSerialPort(PsychSerialDeviceRecord* device, void** readdata, un
     return(nread);
 }
 
+/* PsychIOOSReadRecordsSerialPort()
+ *
+ * Fetch up to 'amount' decoded binary records from an active background read with
+ * a 'RecordLayout'. Returns the number of fetched records, with their decoded values
+ * in '*records' as an array of 'nvalues' values per record, and one receive timestamp
+ * per record in '*timestamps'. Both point to an internal buffer, valid until the next
+ * call. In 'blocking' mode, waits up to one 'ReceiveTimeout' for 'amount' records to
+ * become available. Returns -1 and an error message in 'errmsg' on error.
+ */
+int PsychIOOSReadRecordsSerialPort(PsychSerialDeviceRecord* device, double** records, double** timestamps, int* nvalues, unsigned int amount, int blocking, char* errmsg)
+{
+    double timeout, now;
+    int nrecords, i, slot, nslots, gran;
+
+    *records = NULL;
+    *timestamps = NULL;
+    *nvalues = device->recordValues;
+
+    if (!device->readerThread || !device->decodedRecords) {
+        sprintf(errmsg, "No background read operation with record decoding active on device %s. Set a RecordLayout= before StartBackgroundRead=.\n", device->portSpec);
+        return(-1);
+    }
+
+    gran = device->readGranularity;
+    nslots = device->readBufferSize / gran;
+
+    if ((amount != INT_MAX) && (amount > (unsigned int) nslots)) {
+        sprintf(errmsg, "Amount of requested records %i is more than device %s can satisfy, as its input buffer only holds %i records.\nSet a bigger readbuffer size please.\n", amount, device->portSpec, nslots);
+        return(-1);
+    }
+
+    PsychLockMutex(&(device->readerLock));
+
+    // A 'Read' may have consumed part of a record: Skip to the start of the next one:
+    if (device->clientThreadReadPos % gran) device->clientThreadReadPos += gran - (device->clientThreadReadPos % gran);
+
+    // Blocking mode: Sleep until the reader thread signals availability of the requested amount of records, or timeout:
+    if ((blocking > 0) && (amount != INT_MAX)) {
+        PsychGetAdjustedPrecisionTimerSeconds(&now);
+        timeout = now + device->readTimeout;
+        while ((now < timeout) && ((device->readerThreadWritePos - device->clientThreadReadPos) / gran < (int) amount)) {
+            PsychTimedWaitCondition(&(device->readerSignal), &(device->readerLock), timeout - now);
+            PsychGetAdjustedPrecisionTimerSeconds(&now);
+        }
+    }
+
+    nrecords = (device->readerThreadWritePos - device->clientThreadReadPos) / gran;
+
+    // Check for buffer overflow:
+    if (nrecords > nslots) {
+        sprintf(errmsg, "Error: Readbuffer overflow for background read operation on device %s. Flushing buffer to recover. At least %i records of input data have been lost, expect data corruption!\n", device->portSpec, nrecords - nslots);
+        device->clientThreadReadPos = device->readerThreadWritePos;
+        PsychUnlockMutex(&(device->readerLock));
+        return(-1);
+    }
+
+    PsychUnlockMutex(&(device->readerLock));
+
+    // Clamp available amount to requested amount:
+    if ((amount != INT_MAX) && (nrecords > (int) amount)) nrecords = (int) amount;
+
+    // (Re-)allocate output buffer, with the values of all records, followed by their timestamps:
+    if (device->recordBounceCount < nrecords) {
+        free(device->recordBounceBuffer);
+        device->recordBounceCount = (nrecords < 64) ? 64 : nrecords;
+        device->recordBounceBuffer = (double*) calloc(sizeof(double), (size_t) device->recordBounceCount * (device->recordValues + 1));
+    }
+
+    *records = device->recordBounceBuffer;
+    *timestamps = device->recordBounceBuffer + (size_t) device->recordBounceCount * device->recordValues;
+
+    // Copy records and their timestamps, taking wraparound in the ring buffer into account:
+    for (i = 0; i < nrecords; i++) {
+        slot = (device->clientThreadReadPos / gran + i) % nslots;
+        memcpy(&((*records)[i * device->recordValues]), &(device->decodedRecords[slot * device->recordValues]), sizeof(double) * device->recordValues);
+        (*timestamps)[i] = device->timeStamps[slot];
+    }
+
+    // Update of read-pointer:
+    device->clientThreadReadPos += nrecords * gran;
+
+    errmsg[0] = 0;
+    return(nrecords);
+}
+
 int PsychIOOSBytesAvailableSerialPort(PsychSerialDeviceRecord* device)
 {
     int navail = 0;
 
+    // Server sockets without a connected client have no data:
+    if (!PsychSerialUnixGlueAcceptClient(device, 0)) return(0);
+
     if (device->readerThread) {
         // Async reader poll: Calculate what is available in the internal buffer:
         navail = PsychSerialUnixGlueAsyncReadbufferBytesAvailable(device);
@@ -1757,6 +2742,9 @@ int PsychIOOSBytesAvailableSerialPort(PsychSerialDeviceRecord* device)
 
 void PsychIOOSFlushSerialPort(PsychSerialDeviceRecord* device)
 {
+    // Sockets and pseudo-terminals have no physical transmission to wait for:
+    if (device->portType != kPsychIOPortSerial) return;
+
     if (tcdrain(device->fileDescriptor)!=0) {
         if (verbosity > 0) printf("Error during 'Flush': tcdrain() on device %s returned %s(%d)\n", device->portSpec, strerror(errno), errno);
     }
@@ -1766,7 +2754,18 @@ void PsychIOOSFlushSerialPort(PsychSerialDeviceRecord* device)
 
 void PsychIOOSPurgeSerialPort(PsychSerialDeviceRecord* device)
 {
-    if (tcflush(device->fileDescriptor, TCIOFLUSH)!=0) {
+    unsigned char junk[4096];
+
+    // Server sockets without a connected client have no data:
+    if (!PsychSerialUnixGlueAcceptClient(device, 0)) return;
+
+    if (device->portType == kPsychIOPortSocket) {
+        // Sockets can't be flushed, so read and discard all pending input, unless the background reader owns it:
+        if (!device->readerThread && (PsychSerialUnixGlueFcntl(device, O_NONBLOCK) != -1)) {
+            while (read(device->fileDescriptor, junk, sizeof(junk)) > 0);
+        }
+    }
+    else if (tcflush(device->fileDescriptor, TCIOFLUSH)!=0) {
         if (verbosity > 0) printf("Error during 'Purge': tcflush(TCIFLUSH) on device %s returned %s(%d)\n", device->portSpec, strerror(errno), errno);
     }
 
@@ -35,11 +35,18 @@
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <errno.h>
+#include <ctype.h>
 #include <paths.h>
 #include <termios.h>
 #include <sysexits.h>
 #include <sys/param.h>
 #include <sys/select.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
 #include <sys/time.h>
 #include <time.h>
 #include <pthread.h>
@@ -62,6 +69,19 @@
 // None yet.
 #endif
 
+// Maximum number of fields in a binary record layout, see 'RecordLayout' config setting:
+#define PSYCH_IOPORT_MAXRECORDFIELDS 64
+
+// One field of a binary record layout: 'count' consecutive values of 'size' bytes each, starting at byte 'offset':
+typedef struct PsychIORecordField {
+    int                 size;                           // Size of each value in bytes: 1, 2, 3, 4 or 8.
+    int                 isSigned;                       // Signed integer?
+    int                 isFloat;                        // IEEE floating point, size 4 or 8?
+    int                 bigEndian;                      // Big endian byte order? Otherwise little endian.
+    int                 offset;                         // Byte offset of first value in record.
+    int                 count;                          // Number of consecutive values.
+} PsychIORecordField;
+
 typedef struct PsychSerialDeviceRecord {
     char                portSpec[1000];                 // Name string of the device file.
     int                 fileDescriptor;                 // Device handle.
@@ -85,6 +105,18 @@ typedef struct PsychSerialDeviceRecord {
     unsigned char       cookedMode;                     // Cooked input processing mode active? Set to 1 if so.
     int                 dontFlushOnWrite;               // If set to 1, don't tcdrain() after blocking writes, otherwise do.
     double              triggerWhen;                    // Target time for trigger byte emission.
+    int                 isEventDrivenBackgroundRead;    // 1 = Event driven background read with bulk reads, 0 = Polling or blocking reads as above.
+    psych_condition     readerSignal;                   // Signalled by readerThread whenever it has stored new data.
+    unsigned int        portType;                       // kPsychIOPortSerial, kPsychIOPortSocket or kPsychIOPortPty.
+    int                 listenSocket;                   // Listening server socket until a client got accepted, -1 otherwise.
+    int                 ptySlaveDescriptor;             // Slave side of a pseudo-terminal, kept open while the master is open. -1 if none.
+    PsychIORecordField  recordFields[PSYCH_IOPORT_MAXRECORDFIELDS]; // Layout of binary records, ie., of each readGranularity slot.
+    int                 recordFieldCount;               // Number of fields in recordFields[], zero if record decoding is disabled.
+    int                 recordValues;                   // Total number of decoded values per record, ie., sum of all field counts.
+    int                 recordSync;                     // Sync byte each record must start with, or -1 for none.
+    double*             decodedRecords;                 // recordValues decoded values for each slot of readBuffer. Written by readerThread.
+    double*             recordBounceBuffer;             // Output buffer for 'ReadRecords', with recordBounceCount * (recordValues + 1) values.
+    int                 recordBounceCount;              // Capacity of recordBounceBuffer in records.
 } PsychSerialDeviceRecord;
 
 #endif
@@ -67,6 +67,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("Close",  &IOPORTClose));
     PsychErrorExit(PsychRegister("CloseAll", &IOPORTCloseAll));
     PsychErrorExit(PsychRegister("Read", &IOPORTRead));
+    PsychErrorExit(PsychRegister("ReadRecords", &IOPORTReadRecords));
     PsychErrorExit(PsychRegister("Write", &IOPORTWrite));
     PsychErrorExit(PsychRegister("BytesAvailable", &IOPORTBytesAvailable));
     PsychErrorExit(PsychRegister("Purge", &IOPORTPurge));
@@ -78,6 +79,10 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("OpenSerialPort",  &IOPORTOpenSerialPort));
     PsychErrorExit(PsychRegister("ConfigureSerialPort",  &IOPORTConfigureSerialPort));
 
+    // Support for network sockets and pseudo-terminals:
+    PsychErrorExit(PsychRegister("OpenSocket",  &IOPORTOpenSocket));
+    PsychErrorExit(PsychRegister("OpenPty",  &IOPORTOpenPty));
+
     // Initialize synopsis help strings:
     InitializeSynopsis();
 
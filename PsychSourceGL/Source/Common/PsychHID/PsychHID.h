@@ -191,6 +191,7 @@ PsychError PSYCHHIDKbQueueFlush(void);                  // PsychHIDKbQueueFlush.
 PsychError PSYCHHIDKbQueueRelease(void);                // PsychHIDKbQueueRelease.c
 PsychError PSYCHHIDKbCheck(void);                       // PsychHIDKbCheck.c
 PsychError PSYCHHIDKbQueueGetEvent(void);               // PsychHIDKbCheck.c
+PsychError PSYCHHIDKbQueueGetEvents(void);              // PsychHIDKbQueueCheck.c
 
 PsychError PSYCHHIDGetReport(void);                     // PsychHIDGetReport.c
 PsychError PSYCHHIDSetReport(void);                     // PsychHIDSetReport.c
@@ -282,6 +283,7 @@ psych_bool  PsychHIDDeleteEventBuffer(int deviceIndex);
 psych_bool  PsychHIDFlushEventBuffer(int deviceIndex);
 unsigned int PsychHIDAvailEventBuffer(int deviceIndex, unsigned int flags);
 int         PsychHIDReturnEventFromEventBuffer(int deviceIndex, int outArgIndex, double maxWaitTimeSecs);
+int         PsychHIDReturnEventsFromEventBuffer(int deviceIndex, int outArgIndex, unsigned int maxEvents, double maxWaitTimeSecs);
 PsychHIDEventRecord* PsychHIDLastTouchEventFromEventBuffer(int deviceIndex, int touchID);
 int         PsychHIDAddEventToEventBuffer(int deviceIndex, PsychHIDEventRecord* evt);
 
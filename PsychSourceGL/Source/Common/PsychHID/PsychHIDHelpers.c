@@ -47,6 +47,7 @@ PsychHIDEventRecord* hidEventBuffer[PSYCH_HID_MAX_DEVICES];
 unsigned int    hidEventBufferCapacity[PSYCH_HID_MAX_DEVICES];
 unsigned int    hidEventBufferReadPos[PSYCH_HID_MAX_DEVICES];
 unsigned int    hidEventBufferWritePos[PSYCH_HID_MAX_DEVICES];
+unsigned int    hidEventBufferCookedCount[PSYCH_HID_MAX_DEVICES];
 psych_mutex     hidEventBufferMutex[PSYCH_HID_MAX_DEVICES];
 psych_condition hidEventBufferCondition[PSYCH_HID_MAX_DEVICES];
 
@@ -70,6 +71,7 @@ void PsychInitializePsychHID(void)
         hidEventBufferCapacity[i] = 10000; // Initial capacity of event buffer.
         hidEventBufferReadPos[i] = 0;
         hidEventBufferWritePos[i] = 0;
+        hidEventBufferCookedCount[i] = 0;
     }
 
 #if PSYCH_SYSTEM == PSYCH_OSX
@@ -330,18 +332,25 @@ psych_bool PsychHIDFlushEventBuffer(int deviceIndex)
 
     PsychLockMutex(&hidEventBufferMutex[deviceIndex]);
     hidEventBufferReadPos[deviceIndex] = hidEventBufferWritePos[deviceIndex];
+    hidEventBufferCookedCount[deviceIndex] = 0;
     PsychUnlockMutex(&hidEventBufferMutex[deviceIndex]);
 
     return TRUE;
 }
 
+// Is 'evt' a keypress event with valid mapped ASCII CookedKey keycode, e.g., for CharAvail()?
+static psych_bool PsychHIDIsCookedKeyPress(PsychHIDEventRecord* evt)
+{
+    return((evt->status & (1 << 0)) && (evt->cookedEventCode > 0));
+}
+
 /* Return number of events in buffer for 'deviceIndex':
  * flags == 0 -> All events.
  * flags &  1 -> Only keypress events with valid mapped ASCII CookedKey keycode.
  */
 unsigned int PsychHIDAvailEventBuffer(int deviceIndex, unsigned int flags)
 {
-    unsigned int navail, i, j;
+    unsigned int navail;
 
     if (deviceIndex < 0) deviceIndex = PsychHIDGetDefaultKbQueueDevice();
 
@@ -353,15 +362,9 @@ unsigned int PsychHIDAvailEventBuffer(int deviceIndex, unsigned int flags)
     navail = hidEventBufferWritePos[deviceIndex] - hidEventBufferReadPos[deviceIndex];
 
     // Only count of valid "CookedKey" mapped keypress events, e.g., for use by CharAvail(), requested?
-    if (flags & 1) {
-        // Yes: Iterate over all available events and only count number of keypress events
-        // with meaningful 'CookedKey' field:
-        navail = 0;
-        for (i = hidEventBufferReadPos[deviceIndex]; i < hidEventBufferWritePos[deviceIndex]; i++) {
-            j = i % hidEventBufferCapacity[deviceIndex];
-            if ((hidEventBuffer[deviceIndex][j].status & (1 << 0)) && (hidEventBuffer[deviceIndex][j].cookedEventCode > 0)) navail++;
-        }
-    }
+    // This count is kept up to date while events are added and removed:
+    if (flags & 1)
+        navail = hidEventBufferCookedCount[deviceIndex];
 
     PsychUnlockMutex(&hidEventBufferMutex[deviceIndex]);
 
@@ -397,6 +400,7 @@ int PsychHIDReturnEventFromEventBuffer(int deviceIndex, int outArgIndex, double
     if (navail) {
         memcpy(&evt, &(hidEventBuffer[deviceIndex][hidEventBufferReadPos[deviceIndex] % hidEventBufferCapacity[deviceIndex]]), sizeof(PsychHIDEventRecord));
         hidEventBufferReadPos[deviceIndex]++;
+        if (PsychHIDIsCookedKeyPress(&evt)) hidEventBufferCookedCount[deviceIndex]--;
     }
 
     PsychUnlockMutex(&hidEventBufferMutex[deviceIndex]);
@@ -450,6 +454,98 @@ int PsychHIDReturnEventFromEventBuffer(int deviceIndex, int outArgIndex, double
     }
 }
 
+/* Return up to 'maxEvents' events from buffer for 'deviceIndex' in one go, as a
+ * struct with one column vector per event property, instead of one struct per
+ * event. Waits up to 'maxWaitTimeSecs' for at least one event if the buffer is
+ * empty. Returns number of events remaining in the buffer.
+ */
+int PsychHIDReturnEventsFromEventBuffer(int deviceIndex, int outArgIndex, unsigned int maxEvents, double maxWaitTimeSecs)
+{
+    unsigned int navail, count, first, i, j, numValuators;
+    PsychHIDEventRecord *evts = NULL;
+    PsychGenericScriptType *retevents;
+    PsychGenericScriptType *outMat[12];
+    double *v[12];
+    const char *FieldNames[] = { "Type", "Time", "Pressed", "Keycode", "CookedKey", "ButtonStates", "Motion", "X", "Y", "NormX", "NormY", "Valuators" };
+
+    if (deviceIndex < 0) deviceIndex = PsychHIDGetDefaultKbQueueDevice();
+
+    count = 0;
+    navail = 0;
+    numValuators = 0;
+
+    if (hidEventBuffer[deviceIndex]) {
+        PsychLockMutex(&hidEventBufferMutex[deviceIndex]);
+        navail = hidEventBufferWritePos[deviceIndex] - hidEventBufferReadPos[deviceIndex];
+
+        // If nothing available and we're asked to wait for something, then wait:
+        if ((navail == 0) && (maxWaitTimeSecs > 0)) {
+            PsychTimedWaitCondition(&hidEventBufferCondition[deviceIndex], &hidEventBufferMutex[deviceIndex], maxWaitTimeSecs);
+            navail = hidEventBufferWritePos[deviceIndex] - hidEventBufferReadPos[deviceIndex];
+        }
+
+        // Dequeue up to maxEvents events into a temporary copy, with at most two memcpy's
+        // for the two parts of the ringbuffer, so the producer is blocked only briefly:
+        count = (navail < maxEvents) ? navail : maxEvents;
+        if (count > 0) {
+            evts = (PsychHIDEventRecord*) malloc(count * sizeof(PsychHIDEventRecord));
+            if (evts) {
+                first = hidEventBufferReadPos[deviceIndex] % hidEventBufferCapacity[deviceIndex];
+                i = hidEventBufferCapacity[deviceIndex] - first;
+                if (i > count) i = count;
+                memcpy(evts, &(hidEventBuffer[deviceIndex][first]), i * sizeof(PsychHIDEventRecord));
+                if (i < count) memcpy(&evts[i], &(hidEventBuffer[deviceIndex][0]), (count - i) * sizeof(PsychHIDEventRecord));
+
+                for (i = 0; i < count; i++)
+                    if (PsychHIDIsCookedKeyPress(&evts[i])) hidEventBufferCookedCount[deviceIndex]--;
+
+                hidEventBufferReadPos[deviceIndex] += count;
+                navail -= count;
+            }
+            else {
+                count = 0;
+            }
+        }
+
+        PsychUnlockMutex(&hidEventBufferMutex[deviceIndex]);
+    }
+
+    // Width of the 'Valuators' matrix is the maximum number of valuators of all returned events:
+    for (i = 0; i < count; i++)
+        if ((unsigned int) evts[i].numValuators > numValuators) numValuators = evts[i].numValuators;
+
+    // Allocate one column vector per property, and a count x numValuators matrix for valuators:
+    for (j = 0; j < 11; j++)
+        PsychAllocateNativeDoubleMat(count, 1, 1, &v[j], &outMat[j]);
+    PsychAllocateNativeDoubleMat(count, numValuators, 1, &v[11], &outMat[11]);
+
+    for (i = 0; i < count; i++) {
+        v[0][i]  = (double) evts[i].type;
+        v[1][i]  = evts[i].timestamp;
+        v[2][i]  = (evts[i].status & (1 << 0)) ? 1 : 0;
+        v[3][i]  = (double) evts[i].rawEventCode;
+        v[4][i]  = (double) evts[i].cookedEventCode;
+        v[5][i]  = (double) evts[i].buttonStates;
+        v[6][i]  = (evts[i].status & (1 << 1)) ? 1 : 0;
+        v[7][i]  = (double) evts[i].X;
+        v[8][i]  = (double) evts[i].Y;
+        v[9][i]  = (double) evts[i].normX;
+        v[10][i] = (double) evts[i].normY;
+
+        // Column-major matrix, padded with NaN for events with less than numValuators valuators:
+        for (j = 0; j < numValuators; j++)
+            v[11][j * count + i] = (j < (unsigned int) evts[i].numValuators) ? (double) evts[i].valuators[j] : PsychGetNanValue();
+    }
+
+    free(evts);
+
+    PsychAllocOutStructArray(outArgIndex, kPsychArgOptional, -1, 12, FieldNames, &retevents);
+    for (j = 0; j < 12; j++)
+        PsychSetStructArrayNativeElement(FieldNames[j], 0, outMat[j], retevents);
+
+    return((int) navail);
+}
+
 PsychHIDEventRecord* PsychHIDLastTouchEventFromEventBuffer(int deviceIndex, int touchID)
 {
     int nend, current;
@@ -495,6 +591,7 @@ int PsychHIDAddEventToEventBuffer(int deviceIndex, PsychHIDEventRecord* evt)
     if (navail < hidEventBufferCapacity[deviceIndex]) {
         memcpy(&(hidEventBuffer[deviceIndex][hidEventBufferWritePos[deviceIndex] % hidEventBufferCapacity[deviceIndex]]), evt, sizeof(PsychHIDEventRecord));
         hidEventBufferWritePos[deviceIndex]++;
+        if (PsychHIDIsCookedKeyPress(evt)) hidEventBufferCookedCount[deviceIndex]++;
 
         // Announce new event to potential waiters:
         PsychSignalCondition(&hidEventBufferCondition[deviceIndex]);
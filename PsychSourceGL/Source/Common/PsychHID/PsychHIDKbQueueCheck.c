@@ -142,3 +142,54 @@ PsychError PSYCHHIDKbQueueGetEvent(void)
 
     return(PsychError_none);
 }
+
+PsychError PSYCHHIDKbQueueGetEvents(void)
+{
+    static char useString[] = "[events, navail] = PsychHID('KbQueueGetEvents' [, deviceIndex][, maxEvents=inf][, maxWaitTimeSecs=0])";
+    static char synopsisString[] =
+        "Fetch all, or up to 'maxEvents', queued input events generated by a device in one go.\n"
+        "This is a faster alternative to repeated calls to PsychHID('KbQueueGetEvent') for retrieving "
+        "large numbers of events, e.g., mouse, joystick or touch-screen motion events.\n"
+        "The optional 'deviceIndex' is the index of the HID input device whose queue should be queried. "
+        "If omitted, the queue of the default device will be queried.\n"
+        "'maxEvents' is the optional maximum number of events to fetch. By default all queued events are fetched.\n"
+        "'maxWaitTimeSecs' is an optional maximum wait time for a new event in seconds, if the queue is empty. "
+        "It defaults to zero, which means to just poll for pending events.\n"
+        "The fetched events are returned in the struct 'events', which has the same fields as the 'event' "
+        "struct returned by PsychHID('KbQueueGetEvent'), see there for their meaning. However, each field "
+        "is a column vector with one row per event, in the order in which the events were queued, ie. "
+        "events.Time(i) is the time of the i'th event. The 'Valuators' field is a matrix with one row "
+        "per event, and as many columns as the event with the most valuators has. Missing values of events "
+        "with fewer valuators are filled with NaN. If no events are queued, all fields are empty.\n"
+        "The number of queued events remaining in the queue after fetching is returned in 'navail'.\n";
+    static char seeAlsoString[] = "KbQueueGetEvent, KbQueueCreate, KbQueueStart, KbQueueStop, KbQueueFlush, KbQueueRelease";
+
+    int deviceIndex;
+    unsigned int navail, maxEvents;
+    double maxEventsArg, maxWaitTimeSecs;
+
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none);};
+
+    PsychErrorExit(PsychCapNumOutputArgs(2));
+    PsychErrorExit(PsychCapNumInputArgs(3));
+
+    deviceIndex = -1;
+    PsychCopyInIntegerArg(1, kPsychArgOptional, &deviceIndex);
+
+    // Default to all events, clamp 'inf' and other huge values to all events:
+    maxEvents = UINT_MAX;
+    maxEventsArg = (double) UINT_MAX;
+    PsychCopyInDoubleArg(2, kPsychArgOptional, &maxEventsArg);
+    if (!(maxEventsArg >= 1)) PsychErrorExitMsg(PsychError_user, "Invalid 'maxEvents' specified. Must be at least 1.");
+    if (maxEventsArg < (double) UINT_MAX) maxEvents = (unsigned int) maxEventsArg;
+
+    maxWaitTimeSecs = 0;
+    PsychCopyInDoubleArg(3, kPsychArgOptional, &maxWaitTimeSecs);
+
+    // Get all, or up to maxEvents, events from buffer, return them as 1st return argument:
+    navail = PsychHIDReturnEventsFromEventBuffer(deviceIndex, 1, maxEvents, maxWaitTimeSecs);
+    PsychCopyOutDoubleArg(2, FALSE, (double) navail);
+
+    return(PsychError_none);
+}
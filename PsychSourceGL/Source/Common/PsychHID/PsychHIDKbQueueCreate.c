@@ -103,6 +103,12 @@ static char synopsisString[] =
 "     Linux and Windows only.\n"
 "     For mouse and touchpad devices, this usually reports relative motion, ie.\n"
 "     movement deltas, instead of absolute position values.\n"
+"+8 = Read events directly from the Linux kernel evdev device of the input device,\n"
+"     bypassing the X-Server, and use the timestamps assigned by the kernel when it\n"
+"     received the input. Supported on Linux/X11 only, not for touch devices.\n"
+"     Needs read access to the /dev/input/event* device file, usually by membership\n"
+"     of the user in the Unix group 'input'. Falls back to X-Server input otherwise.\n"
+"     Motion events report relative motion, ie. movement deltas, as with flag +4.\n"
 "\n\n"
 "'windowHandle' Optional windowing system specific handle for an associated onscreen window.\n"
 "\n";
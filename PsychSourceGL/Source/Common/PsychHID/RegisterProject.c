@@ -57,6 +57,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("KbQueueFlush", &PSYCHHIDKbQueueFlush));
     PsychErrorExit(PsychRegister("KbQueueRelease", &PSYCHHIDKbQueueRelease));
     PsychErrorExit(PsychRegister("KbQueueGetEvent", &PSYCHHIDKbQueueGetEvent));
+    PsychErrorExit(PsychRegister("KbQueueGetEvents", &PSYCHHIDKbQueueGetEvents));
 
     PsychErrorExit(PsychRegister("RawState",  &PSYCHHIDGetRawState));
     PsychErrorExit(PsychRegister("KbCheck",  &PSYCHHIDKbCheck));
@@ -0,0 +1,605 @@
+/*
+ *        PsychToolbox3/Source/Common/PsychPortAudio/PsychPADSP.c
+ *
+ *        PLATFORMS:        All
+ *
+ *        DESCRIPTION:
+ *
+ *        Realtime signal processing for PsychPortAudio: Insert chains of biquad and FIR filter
+ *        stages, and a polyphase sample rate converter. See PsychPADSP.h for details.
+ *
+ *        NOTES:
+ *
+ *        All processing functions are called from the audio callback, so they must not allocate
+ *        memory or block. All memory is allocated at creation time.
+ */
+
+#include "PsychPADSP.h"
+#include "PsychPAMixKernels.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Length of the interpolation filter of the sample rate converter in input frames, and
+// number of tabulated filter phases. Coefficients between phases are interpolated linearly:
+#define PSYCH_PA_SRC_TAPS       32
+#define PSYCH_PA_SRC_PHASES     128
+
+// FFT size for partitioned convolution:
+#define PSYCH_PA_FIR_FFTSIZE    (2 * PSYCH_PA_FIR_BLOCKSIZE)
+#define PSYCH_PA_FIR_BINS       (PSYCH_PA_FIR_FFTSIZE / 2 + 1)
+
+// Per channel state of a partitioned convolution FIR filter:
+typedef struct PsychPAFIRChannel {
+    float*  filterRe;       // partitions * PSYCH_PA_FIR_BINS spectra of filter partitions.
+    float*  filterIm;
+    float*  fdlRe;          // Frequency domain delay line of input block spectra, same layout.
+    float*  fdlIm;
+    float*  inBlock;        // Last two input blocks, ie., PSYCH_PA_FIR_FFTSIZE samples.
+    float*  outBlock;       // Current output block of PSYCH_PA_FIR_BLOCKSIZE samples.
+    float*  delayLine;      // Direct convolution: 2 * ntaps input history.
+    float*  taps;           // Direct convolution: Filter taps.
+} PsychPAFIRChannel;
+
+struct PsychPADSPStage {
+    int                 type;           // kPsychPADSPBiquad or kPsychPADSPFIR.
+    int                 channels;       // Number of interleaved channels.
+    int                 latency;        // Latency in sample frames.
+    PsychPADSPStage*    next;           // Next stage in chain, or NULL.
+
+    // Biquad:
+    int                 sections;       // Number of sections.
+    float*              coeffs;         // 5 coefficients b0, b1, b2, a1, a2 per section.
+    float*              state;          // 8 floats per group of 4 channels per section.
+
+    // FIR:
+    int                 ntaps;          // Number of taps.
+    int                 partitions;     // Number of partitions for fast convolution, 0 for direct convolution.
+    int                 fill;           // Fast convolution: Frames in current input block. Direct: Delay line position.
+    PsychPAFIRChannel*  fir;            // Per channel state.
+    float*              fftRe;          // FFT scratch buffers.
+    float*              fftIm;
+    float*              accRe;          // Spectrum accumulation scratch buffers.
+    float*              accIm;
+    float*              twiddleRe;      // FFT twiddle factors.
+    float*              twiddleIm;
+    int*                bitrev;         // FFT bit reversal permutation.
+};
+
+// Iterative radix-2 complex FFT of size PSYCH_PA_FIR_FFTSIZE in place. The inverse transform is unscaled:
+static void PsychPAFFT(PsychPADSPStage* s, float* re, float* im, psych_bool inverse)
+{
+    int n = PSYCH_PA_FIR_FFTSIZE;
+    int i, j, k, len, half, step;
+    float tr, ti, wr, wi;
+
+    for (i = 0; i < n; i++) {
+        j = s->bitrev[i];
+        if (j > i) {
+            tr = re[i]; re[i] = re[j]; re[j] = tr;
+            ti = im[i]; im[i] = im[j]; im[j] = ti;
+        }
+    }
+
+    for (len = 2; len <= n; len <<= 1) {
+        half = len >> 1;
+        step = n / len;
+        for (i = 0; i < n; i += len) {
+            for (k = 0; k < half; k++) {
+                wr = s->twiddleRe[k * step];
+                wi = (inverse) ? -s->twiddleIm[k * step] : s->twiddleIm[k * step];
+                j = i + k + half;
+                tr = re[j] * wr - im[j] * wi;
+                ti = re[j] * wi + im[j] * wr;
+                re[j] = re[i + k] - tr;
+                im[j] = im[i + k] - ti;
+                re[i + k] += tr;
+                im[i + k] += ti;
+            }
+        }
+    }
+}
+
+// Spectrum of 'count' real samples from 'src', zero-padded to FFT size, into 'dstRe' and 'dstIm':
+static void PsychPARealSpectrum(PsychPADSPStage* s, const float* src, int count, float* dstRe, float* dstIm)
+{
+    int i;
+
+    for (i = 0; i < PSYCH_PA_FIR_FFTSIZE; i++) {
+        s->fftRe[i] = (i < count) ? src[i] : 0.0f;
+        s->fftIm[i] = 0.0f;
+    }
+
+    PsychPAFFT(s, s->fftRe, s->fftIm, FALSE);
+
+    // Real input, so only the non-redundant half of the spectrum is needed:
+    memcpy(dstRe, s->fftRe, PSYCH_PA_FIR_BINS * sizeof(float));
+    memcpy(dstIm, s->fftIm, PSYCH_PA_FIR_BINS * sizeof(float));
+}
+
+static PsychPADSPStage* PsychPAAllocDSPStage(int type, int channels)
+{
+    PsychPADSPStage* s = (PsychPADSPStage*) calloc(1, sizeof(PsychPADSPStage));
+    if (s) {
+        s->type = type;
+        s->channels = channels;
+    }
+
+    return(s);
+}
+
+PsychPADSPStage* PsychPACreateBiquadStage(int channels, int sections, const double* sos, const char** errmsg)
+{
+    PsychPADSPStage* s;
+    int i, groups = (channels + 3) / 4;
+    double a0;
+
+    if ((sections < 1) || (sections > PSYCH_PA_BIQUAD_MAXSECTIONS)) {
+        *errmsg = "Invalid number of biquad sections. Must be between 1 and 64.";
+        return(NULL);
+    }
+
+    for (i = 0; i < sections; i++) {
+        if (sos[i + 3 * sections] == 0) {
+            *errmsg = "Invalid biquad coefficients: The a0 coefficient of each section must be non-zero.";
+            return(NULL);
+        }
+    }
+
+    s = PsychPAAllocDSPStage(kPsychPADSPBiquad, channels);
+    if (s) {
+        s->sections = sections;
+        s->coeffs = (float*) malloc(sections * 5 * sizeof(float));
+        s->state = (float*) calloc(sections * groups * 8, sizeof(float));
+    }
+
+    if (!s || !s->coeffs || !s->state) {
+        PsychPADeleteDSPChain(s);
+        *errmsg = "Out of memory while trying to create biquad filter.";
+        return(NULL);
+    }
+
+    // Column major sections-by-6 matrix of rows [b0 b1 b2 a0 a1 a2]. Normalize by a0:
+    for (i = 0; i < sections; i++) {
+        a0 = sos[i + 3 * sections];
+        s->coeffs[i * 5 + 0] = (float) (sos[i + 0 * sections] / a0);
+        s->coeffs[i * 5 + 1] = (float) (sos[i + 1 * sections] / a0);
+        s->coeffs[i * 5 + 2] = (float) (sos[i + 2 * sections] / a0);
+        s->coeffs[i * 5 + 3] = (float) (sos[i + 4 * sections] / a0);
+        s->coeffs[i * 5 + 4] = (float) (sos[i + 5 * sections] / a0);
+    }
+
+    return(s);
+}
+
+PsychPADSPStage* PsychPACreateFIRStage(int channels, int tapChannels, int ntaps, const double* taps, const char** errmsg)
+{
+    PsychPADSPStage* s;
+    PsychPAFIRChannel* fc;
+    float* block;
+    int c, p, i, n;
+
+    if ((ntaps < 1) || (ntaps > PSYCH_PA_FIR_MAXTAPS)) {
+        *errmsg = "Invalid number of FIR filter taps. Must be between 1 and 96000.";
+        return(NULL);
+    }
+
+    if ((tapChannels != 1) && (tapChannels != channels)) {
+        *errmsg = "Invalid FIR filter taps matrix. Must have one row, or one row per channel.";
+        return(NULL);
+    }
+
+    s = PsychPAAllocDSPStage(kPsychPADSPFIR, channels);
+    if (!s) goto outofmemory;
+
+    s->ntaps = ntaps;
+    s->fir = (PsychPAFIRChannel*) calloc(channels, sizeof(PsychPAFIRChannel));
+    if (!s->fir) goto outofmemory;
+
+    if (ntaps <= PSYCH_PA_FIR_DIRECTTAPS) {
+        // Short filter: Direct convolution without latency:
+        for (c = 0; c < channels; c++) {
+            fc = &(s->fir[c]);
+            fc->taps = (float*) malloc(ntaps * sizeof(float));
+            fc->delayLine = (float*) calloc(2 * ntaps, sizeof(float));
+            if (!fc->taps || !fc->delayLine) goto outofmemory;
+
+            for (i = 0; i < ntaps; i++) fc->taps[i] = (float) taps[((tapChannels > 1) ? c : 0) + i * tapChannels];
+        }
+
+        return(s);
+    }
+
+    // Long filter: Uniformly partitioned overlap-save fast convolution:
+    n = PSYCH_PA_FIR_FFTSIZE;
+    s->partitions = (ntaps + PSYCH_PA_FIR_BLOCKSIZE - 1) / PSYCH_PA_FIR_BLOCKSIZE;
+    s->latency = PSYCH_PA_FIR_BLOCKSIZE;
+
+    s->fftRe = (float*) malloc(n * sizeof(float));
+    s->fftIm = (float*) malloc(n * sizeof(float));
+    s->accRe = (float*) malloc(PSYCH_PA_FIR_BINS * sizeof(float));
+    s->accIm = (float*) malloc(PSYCH_PA_FIR_BINS * sizeof(float));
+    s->twiddleRe = (float*) malloc(n / 2 * sizeof(float));
+    s->twiddleIm = (float*) malloc(n / 2 * sizeof(float));
+    s->bitrev = (int*) malloc(n * sizeof(int));
+    block = (float*) malloc(PSYCH_PA_FIR_BLOCKSIZE * sizeof(float));
+    if (!s->fftRe || !s->fftIm || !s->accRe || !s->accIm || !s->twiddleRe || !s->twiddleIm || !s->bitrev || !block) {
+        free(block);
+        goto outofmemory;
+    }
+
+    for (i = 0; i < n / 2; i++) {
+        s->twiddleRe[i] = (float) cos(-2.0 * M_PI * i / n);
+        s->twiddleIm[i] = (float) sin(-2.0 * M_PI * i / n);
+    }
+
+    for (i = 0; i < n; i++) {
+        int j, r = 0;
+        for (j = 1; j < n; j <<= 1) r = (r << 1) | ((i & j) ? 1 : 0);
+        s->bitrev[i] = r;
+    }
+
+    for (c = 0; c < channels; c++) {
+        fc = &(s->fir[c]);
+        fc->filterRe = (float*) malloc(s->partitions * PSYCH_PA_FIR_BINS * sizeof(float));
+        fc->filterIm = (float*) malloc(s->partitions * PSYCH_PA_FIR_BINS * sizeof(float));
+        fc->fdlRe = (float*) calloc(s->partitions * PSYCH_PA_FIR_BINS, sizeof(float));
+        fc->fdlIm = (float*) calloc(s->partitions * PSYCH_PA_FIR_BINS, sizeof(float));
+        fc->inBlock = (float*) calloc(n, sizeof(float));
+        fc->outBlock = (float*) calloc(PSYCH_PA_FIR_BLOCKSIZE, sizeof(float));
+        if (!fc->filterRe || !fc->filterIm || !fc->fdlRe || !fc->fdlIm || !fc->inBlock || !fc->outBlock) {
+            free(block);
+            goto outofmemory;
+        }
+
+        // Spectra of the zero-padded filter partitions. The inverse FFT is unscaled, so apply
+        // the 1/n normalization to the filter spectra right away:
+        for (p = 0; p < s->partitions; p++) {
+            for (i = 0; i < PSYCH_PA_FIR_BLOCKSIZE; i++)
+                block[i] = (p * PSYCH_PA_FIR_BLOCKSIZE + i < ntaps) ? (float) (taps[((tapChannels > 1) ? c : 0) + (p * PSYCH_PA_FIR_BLOCKSIZE + i) * tapChannels] / n) : 0.0f;
+
+            PsychPARealSpectrum(s, block, PSYCH_PA_FIR_BLOCKSIZE, fc->filterRe + p * PSYCH_PA_FIR_BINS, fc->filterIm + p * PSYCH_PA_FIR_BINS);
+        }
+    }
+
+    free(block);
+
+    return(s);
+
+outofmemory:
+    PsychPADeleteDSPChain(s);
+    *errmsg = "Out of memory while trying to create FIR filter.";
+    return(NULL);
+}
+
+// Fast convolution of one complete input block of channel 'fc', producing its next output block:
+static void PsychPAConvolveBlock(PsychPADSPStage* s, PsychPAFIRChannel* fc)
+{
+    int p, k, slot;
+    float *xr, *xi, *hr, *hi;
+
+    // Spectrum of the last two input blocks goes into the delay line slot of the current block.
+    // Slot 0 always holds the newest spectrum, so shift the older ones one partition up:
+    memmove(fc->fdlRe + PSYCH_PA_FIR_BINS, fc->fdlRe, (s->partitions - 1) * PSYCH_PA_FIR_BINS * sizeof(float));
+    memmove(fc->fdlIm + PSYCH_PA_FIR_BINS, fc->fdlIm, (s->partitions - 1) * PSYCH_PA_FIR_BINS * sizeof(float));
+    PsychPARealSpectrum(s, fc->inBlock, PSYCH_PA_FIR_FFTSIZE, fc->fdlRe, fc->fdlIm);
+
+    // Multiply-accumulate each past input block spectrum with the matching filter partition spectrum:
+    memset(s->accRe, 0, PSYCH_PA_FIR_BINS * sizeof(float));
+    memset(s->accIm, 0, PSYCH_PA_FIR_BINS * sizeof(float));
+    for (p = 0; p < s->partitions; p++) {
+        slot = p * PSYCH_PA_FIR_BINS;
+        xr = fc->fdlRe + slot; xi = fc->fdlIm + slot;
+        hr = fc->filterRe + slot; hi = fc->filterIm + slot;
+        for (k = 0; k < PSYCH_PA_FIR_BINS; k++) {
+            s->accRe[k] += xr[k] * hr[k] - xi[k] * hi[k];
+            s->accIm[k] += xr[k] * hi[k] + xi[k] * hr[k];
+        }
+    }
+
+    // Rebuild the conjugate symmetric full spectrum and transform back. The second half of the
+    // result is free of circular aliasing and is the next output block:
+    for (k = 0; k < PSYCH_PA_FIR_BINS; k++) {
+        s->fftRe[k] = s->accRe[k];
+        s->fftIm[k] = s->accIm[k];
+    }
+
+    for (k = PSYCH_PA_FIR_BINS; k < PSYCH_PA_FIR_FFTSIZE; k++) {
+        s->fftRe[k] = s->accRe[PSYCH_PA_FIR_FFTSIZE - k];
+        s->fftIm[k] = -s->accIm[PSYCH_PA_FIR_FFTSIZE - k];
+    }
+
+    PsychPAFFT(s, s->fftRe, s->fftIm, TRUE);
+    memcpy(fc->outBlock, s->fftRe + PSYCH_PA_FIR_BLOCKSIZE, PSYCH_PA_FIR_BLOCKSIZE * sizeof(float));
+
+    // Current input block becomes the previous one:
+    memcpy(fc->inBlock, fc->inBlock + PSYCH_PA_FIR_BLOCKSIZE, PSYCH_PA_FIR_BLOCKSIZE * sizeof(float));
+}
+
+static void PsychPAProcessFIR(PsychPADSPStage* s, float* buffer, psych_int64 frames)
+{
+    PsychPAFIRChannel* fc;
+    psych_int64 i;
+    int c, k, pos, chunk;
+    float y;
+
+    if (s->partitions == 0) {
+        // Direct convolution: The delay line holds each input twice, so the last ntaps inputs are
+        // always contiguous, newest first, starting at the current position:
+        for (i = 0; i < frames; i++, buffer += s->channels) {
+            pos = (s->fill > 0) ? s->fill - 1 : s->ntaps - 1;
+            for (c = 0; c < s->channels; c++) {
+                fc = &(s->fir[c]);
+                fc->delayLine[pos] = fc->delayLine[pos + s->ntaps] = buffer[c];
+
+                y = 0.0f;
+                for (k = 0; k < s->ntaps; k++) y += fc->taps[k] * fc->delayLine[pos + k];
+                buffer[c] = y;
+            }
+            s->fill = pos;
+        }
+
+        return;
+    }
+
+    // Fast convolution: Exchange input samples for output samples of the previous block, a
+    // block at a time, and convolve whenever an input block is complete:
+    while (frames > 0) {
+        chunk = PSYCH_PA_FIR_BLOCKSIZE - s->fill;
+        if (chunk > frames) chunk = (int) frames;
+
+        for (c = 0; c < s->channels; c++) {
+            fc = &(s->fir[c]);
+            for (k = 0; k < chunk; k++) {
+                fc->inBlock[PSYCH_PA_FIR_BLOCKSIZE + s->fill + k] = buffer[k * s->channels + c];
+                buffer[k * s->channels + c] = fc->outBlock[s->fill + k];
+            }
+        }
+
+        s->fill += chunk;
+        buffer += chunk * s->channels;
+        frames -= chunk;
+
+        if (s->fill == PSYCH_PA_FIR_BLOCKSIZE) {
+            for (c = 0; c < s->channels; c++) PsychPAConvolveBlock(s, &(s->fir[c]));
+            s->fill = 0;
+        }
+    }
+}
+
+static void PsychPAProcessBiquad(PsychPADSPStage* s, float* buffer, psych_int64 frames)
+{
+    int i, g, j, lanes, groups = (s->channels + 3) / 4;
+    const float* coeffs;
+    float* state;
+    float* buf;
+    psych_int64 f;
+    float x, y;
+
+    for (i = 0; i < s->sections; i++) {
+        coeffs = s->coeffs + i * 5;
+        for (g = 0; g < groups; g++) {
+            state = s->state + (i * groups + g) * 8;
+            lanes = s->channels - g * 4;
+
+            if (lanes >= 4) {
+                psychPAMix.biquad4(buffer + g * 4, s->channels, frames, coeffs, state);
+            }
+            else {
+                // Less than 4 remaining channels: Same arithmetic as the kernel, per channel:
+                for (f = 0, buf = buffer + g * 4; f < frames; f++, buf += s->channels) {
+                    for (j = 0; j < lanes; j++) {
+                        x = buf[j];
+                        y = coeffs[0] * x + state[j];
+                        state[j] = (coeffs[1] * x - coeffs[3] * y) + state[4 + j];
+                        state[4 + j] = coeffs[2] * x - coeffs[4] * y;
+                        buf[j] = y;
+                    }
+                }
+            }
+
+            // Flush decaying filter state to zero before it becomes denormal, which would
+            // slow down processing of silence massively on many cpus:
+            for (j = 0; j < 8; j++) if (fabsf(state[j]) < 1e-25f) state[j] = 0.0f;
+        }
+    }
+}
+
+PsychPADSPStage** PsychPAGetDSPChainTail(PsychPADSPStage** chain)
+{
+    while (*chain) chain = &((*chain)->next);
+
+    return(chain);
+}
+
+int PsychPAGetDSPChainLength(PsychPADSPStage* chain, int* latencyFrames)
+{
+    int n = 0;
+
+    if (latencyFrames) *latencyFrames = 0;
+
+    for (; chain; chain = chain->next) {
+        if (latencyFrames) *latencyFrames += chain->latency;
+        n++;
+    }
+
+    return(n);
+}
+
+void PsychPAProcessDSPChain(PsychPADSPStage* chain, float* buffer, psych_int64 frames)
+{
+    for (; chain; chain = chain->next) {
+        if (chain->type == kPsychPADSPBiquad)
+            PsychPAProcessBiquad(chain, buffer, frames);
+        else
+            PsychPAProcessFIR(chain, buffer, frames);
+    }
+}
+
+void PsychPADeleteDSPChain(PsychPADSPStage* chain)
+{
+    PsychPADSPStage* next;
+    PsychPAFIRChannel* fc;
+    int c;
+
+    for (; chain; chain = next) {
+        next = chain->next;
+
+        if (chain->fir) {
+            for (c = 0; c < chain->channels; c++) {
+                fc = &(chain->fir[c]);
+                free(fc->filterRe);
+                free(fc->filterIm);
+                free(fc->fdlRe);
+                free(fc->fdlIm);
+                free(fc->inBlock);
+                free(fc->outBlock);
+                free(fc->delayLine);
+                free(fc->taps);
+            }
+            free(chain->fir);
+        }
+
+        free(chain->coeffs);
+        free(chain->state);
+        free(chain->fftRe);
+        free(chain->fftIm);
+        free(chain->accRe);
+        free(chain->accIm);
+        free(chain->twiddleRe);
+        free(chain->twiddleIm);
+        free(chain->bitrev);
+        free(chain);
+    }
+}
+
+// Sample rate converter:
+
+PsychPAResampler* PsychPACreateResampler(int channels, double inRate, double outRate, psych_int64 maxOutFrames)
+{
+    PsychPAResampler* r;
+    double cutoff, t, v, sum;
+    int p, k;
+
+    r = (PsychPAResampler*) calloc(1, sizeof(PsychPAResampler));
+    if (!r) return(NULL);
+
+    r->channels = channels;
+    r->ratio = inRate / outRate;
+    r->taps = PSYCH_PA_SRC_TAPS;
+    r->phases = PSYCH_PA_SRC_PHASES;
+    r->maxOutFrames = maxOutFrames;
+    r->capacity = r->taps + (psych_int64) ceil(maxOutFrames * r->ratio) + 4;
+
+    r->filter = (float*) malloc((r->phases + 1) * r->taps * sizeof(float));
+    r->coeffs = (float*) malloc(r->taps * sizeof(float));
+    r->history = (float*) malloc(r->capacity * channels * sizeof(float));
+    r->inBuffer = (float*) malloc(((psych_int64) ceil(maxOutFrames * r->ratio) + r->taps) * channels * sizeof(float));
+    r->outBuffer = (float*) malloc(maxOutFrames * channels * sizeof(float));
+    if (!r->filter || !r->coeffs || !r->history || !r->inBuffer || !r->outBuffer) {
+        PsychPADeleteResampler(r);
+        return(NULL);
+    }
+
+    // Blackman windowed sinc lowpass. Cutoff slightly below the lower of both Nyquist frequencies,
+    // in units of the input Nyquist frequency, to suppress aliasing when downsampling:
+    cutoff = 0.91 * ((r->ratio > 1.0) ? 1.0 / r->ratio : 1.0);
+    for (p = 0; p <= r->phases; p++) {
+        sum = 0;
+        for (k = 0; k < r->taps; k++) {
+            // Time offset of tap k from the output frame, for a fractional position of p / phases:
+            t = (double) (k - (r->taps / 2 - 1)) - (double) p / r->phases;
+            v = (t == 0) ? cutoff : sin(M_PI * cutoff * t) / (M_PI * t);
+            v *= 0.42 + 0.5 * cos(M_PI * t / (r->taps / 2)) + 0.08 * cos(2 * M_PI * t / (r->taps / 2));
+            r->filter[p * r->taps + k] = (float) v;
+            sum += v;
+        }
+
+        // Normalize each phase to unity gain at DC:
+        for (k = 0; k < r->taps; k++) r->filter[p * r->taps + k] = (float) (r->filter[p * r->taps + k] / sum);
+    }
+
+    PsychPAResetResampler(r);
+
+    return(r);
+}
+
+void PsychPADeleteResampler(PsychPAResampler* r)
+{
+    if (!r) return;
+
+    free(r->filter);
+    free(r->coeffs);
+    free(r->history);
+    free(r->inBuffer);
+    free(r->outBuffer);
+    free(r);
+}
+
+void PsychPAResetResampler(PsychPAResampler* r)
+{
+    // History starts with enough silence for the filter to produce the very first input
+    // frame as output, centered on the current position:
+    r->frames = r->taps / 2 - 1;
+    r->position = (double) r->frames;
+    memset(r->history, 0, r->frames * r->channels * sizeof(float));
+}
+
+psych_int64 PsychPAResamplerInputFrames(PsychPAResampler* r, psych_int64 outFrames)
+{
+    psych_int64 needed;
+
+    if (outFrames <= 0) return(0);
+
+    // Last input frame required by the filter of the last output frame:
+    needed = (psych_int64) floor(r->position + (double) (outFrames - 1) * r->ratio) + r->taps / 2 + 1;
+
+    return((needed > r->frames) ? needed - r->frames : 0);
+}
+
+double PsychPAResamplerLead(PsychPAResampler* r)
+{
+    return((double) r->frames - r->position);
+}
+
+void PsychPAResample(PsychPAResampler* r, const float* in, psych_int64 inFrames, float* out, psych_int64 outFrames)
+{
+    psych_int64 j, i0, drop;
+    int k, c, p, channels = r->channels;
+    const float *h0, *h1, *x;
+    double pos, frac;
+    float ff;
+
+    memcpy(r->history + r->frames * channels, in, inFrames * channels * sizeof(float));
+    r->frames += inFrames;
+
+    for (j = 0; j < outFrames; j++, out += channels) {
+        pos = r->position + (double) j * r->ratio;
+        i0 = (psych_int64) floor(pos);
+        frac = (pos - (double) i0) * r->phases;
+        p = (int) frac;
+        ff = (float) (frac - p);
+
+        // Interpolate filter between the two closest tabulated phases:
+        h0 = r->filter + p * r->taps;
+        h1 = h0 + r->taps;
+        for (k = 0; k < r->taps; k++) r->coeffs[k] = h0[k] + ff * (h1[k] - h0[k]);
+
+        for (c = 0; c < channels; c++) out[c] = 0.0f;
+
+        x = r->history + (i0 - r->taps / 2 + 1) * channels;
+        for (k = 0; k < r->taps; k++, x += channels) {
+            for (c = 0; c < channels; c++) out[c] += r->coeffs[k] * x[c];
+        }
+    }
+
+    // Advance and discard history which no future output frame needs anymore:
+    r->position += (double) outFrames * r->ratio;
+    drop = (psych_int64) floor(r->position) - r->taps / 2 + 1;
+    if (drop > 0) {
+        memmove(r->history, r->history + drop * channels, (r->frames - drop) * channels * sizeof(float));
+        r->frames -= drop;
+        r->position -= (double) drop;
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ *        PsychToolbox3/Source/Common/PsychPortAudio/PsychPADSP.h
+ *
+ *        PLATFORMS:        All
+ *
+ *        DESCRIPTION:
+ *
+ *        Realtime signal processing for the paCallback() of PsychPortAudio:
+ *
+ *        Insert chains of filter stages, which process the sound output of a device in place,
+ *        e.g., for equalization of headphones or speakers. Stages are either cascades of biquad
+ *        IIR filter sections, or FIR filters. Long FIR filters are computed as uniformly partitioned
+ *        fast convolution, at the price of a latency of PSYCH_PA_FIR_BLOCKSIZE sample frames.
+ *
+ *        A polyphase sample rate converter, which allows slave devices to play sound at a different
+ *        sample rate than their master device.
+ */
+
+//begin include once
+#ifndef PSYCH_IS_INCLUDED_PsychPADSP
+#define PSYCH_IS_INCLUDED_PsychPADSP
+
+#include "Psych.h"
+
+// Filters with at most this many taps are computed by direct convolution without latency, longer
+// ones by partitioned fast convolution, with partitions and latency of PSYCH_PA_FIR_BLOCKSIZE frames:
+#define PSYCH_PA_FIR_DIRECTTAPS     64
+#define PSYCH_PA_FIR_BLOCKSIZE      64
+
+// Maximum number of taps of FIR filters, ie., 1 second at 96 kHz:
+#define PSYCH_PA_FIR_MAXTAPS        96000
+
+// Maximum number of biquad sections per filter stage:
+#define PSYCH_PA_BIQUAD_MAXSECTIONS 64
+
+// Filter stage types:
+#define kPsychPADSPBiquad           0
+#define kPsychPADSPFIR              1
+
+typedef struct PsychPADSPStage PsychPADSPStage;
+
+// Create a cascade of 'sections' biquad filter sections for 'channels' channel interleaved sound.
+// 'sos' is a sections-by-6 matrix in column major order, each row of the form [b0 b1 b2 a0 a1 a2],
+// as returned by tf2sos() et al. Each row is normalized by its a0. Returns NULL and an error message
+// in 'errmsg' on failure:
+PsychPADSPStage* PsychPACreateBiquadStage(int channels, int sections, const double* sos, const char** errmsg);
+
+// Create an FIR filter stage for 'channels' channel interleaved sound. 'taps' is a 'tapChannels'-by-'ntaps'
+// matrix in column major order, with one row of filter taps per channel, or a single row which is used
+// for all channels. Returns NULL and an error message in 'errmsg' on failure:
+PsychPADSPStage* PsychPACreateFIRStage(int channels, int tapChannels, int ntaps, const double* taps, const char** errmsg);
+
+// Return the location of the NULL link at the end of the insert chain with head link 'chain', ie.,
+// where to store a pointer to a new stage to append it:
+PsychPADSPStage** PsychPAGetDSPChainTail(PsychPADSPStage** chain);
+
+// Number of stages in insert chain 'chain' and their total latency in sample frames:
+int PsychPAGetDSPChainLength(PsychPADSPStage* chain, int* latencyFrames);
+
+// Process 'frames' sample frames of interleaved 'buffer' in place by all stages of 'chain':
+void PsychPAProcessDSPChain(PsychPADSPStage* chain, float* buffer, psych_int64 frames);
+
+// Delete all stages of insert chain 'chain':
+void PsychPADeleteDSPChain(PsychPADSPStage* chain);
+
+// Sample rate converter:
+typedef struct PsychPAResampler {
+    int         channels;       // Number of interleaved channels.
+    double      ratio;          // Input frames per output frame, ie., input rate / output rate.
+    int         taps;           // Length of interpolation filter in input frames.
+    int         phases;         // Number of tabulated filter phases.
+    float*      filter;         // (phases + 1) * taps tabulated filter coefficients.
+    float*      coeffs;         // Scratch buffer for the interpolated filter of one output frame.
+    float*      history;        // Input history of 'capacity' frames.
+    psych_int64 capacity;       // Capacity of history in frames.
+    psych_int64 frames;         // Number of valid frames in history.
+    double      position;       // Position of next output frame in history, in input frames.
+    float*      inBuffer;       // Scratch buffer for new input frames, used by the caller.
+    float*      outBuffer;      // Scratch buffer for output frames, used by the caller.
+    psych_int64 maxOutFrames;   // Capacity of outBuffer, and maximum output frames per processing step.
+} PsychPAResampler;
+
+// Create a resampler for 'channels' channels from 'inRate' Hz to 'outRate' Hz, which produces up to
+// 'maxOutFrames' output frames per call to PsychPAResample(). Returns NULL on failure:
+PsychPAResampler* PsychPACreateResampler(int channels, double inRate, double outRate, psych_int64 maxOutFrames);
+
+// Delete resampler:
+void PsychPADeleteResampler(PsychPAResampler* r);
+
+// Reset resampler to its initial, silent state:
+void PsychPAResetResampler(PsychPAResampler* r);
+
+// Number of new input frames PsychPAResample() needs to produce 'outFrames' output frames:
+psych_int64 PsychPAResamplerInputFrames(PsychPAResampler* r, psych_int64 outFrames);
+
+// Time offset in input frames between the next output frame and the first input frame passed to the
+// next PsychPAResample() call, ie., how far input is pulled ahead of output to compensate filter delay:
+double PsychPAResamplerLead(PsychPAResampler* r);
+
+// Resample: Consume 'inFrames' new input frames from 'in', as requested by PsychPAResamplerInputFrames(),
+// and produce 'outFrames' output frames in 'out':
+void PsychPAResample(PsychPAResampler* r, const float* in, psych_int64 inFrames, float* out, psych_int64 outFrames);
+
+//end include once
+#endif
@@ -0,0 +1,255 @@
+/*
+ *        PsychToolbox3/Source/Common/PsychPortAudio/PsychPAFileBuffer.c
+ *
+ *        PLATFORMS:        All
+ *
+ *        DESCRIPTION:
+ *
+ *        Read-only memory mapping of sound files for disk-backed PsychPortAudio audio buffers.
+ *        See PsychPAFileBuffer.h for details.
+ *
+ *        NOTES:
+ *
+ *        Sample data is used in place, so only little-endian 32 bit float samples are supported,
+ *        and the sample data must start at a 4 byte aligned file offset. This is the case for
+ *        all WAV files written by common software, e.g., by psychwavwrite() or audiowrite().
+ */
+
+#include "PsychPAFileBuffer.h"
+
+#if PSYCH_SYSTEM != PSYCH_WINDOWS
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Read little-endian 16 and 32 bit integers from a byte stream:
+static unsigned int PsychPAReadLE16(const unsigned char* p)
+{
+    return((unsigned int) p[0] | ((unsigned int) p[1] << 8));
+}
+
+static unsigned int PsychPAReadLE32(const unsigned char* p)
+{
+    return((unsigned int) p[0] | ((unsigned int) p[1] << 8) | ((unsigned int) p[2] << 16) | ((unsigned int) p[3] << 24));
+}
+
+// Parse RIFF WAVE header of a mapped file. Returns 0 if this is not a WAV file, 1 if it is a
+// usable float WAV file, with sample data location and format assigned, or -1 with 'errmsg'
+// assigned if this is a WAV file we can not use:
+static int PsychPAParseWAVHeader(const unsigned char* base, psych_int64 size, psych_int64* dataOffset, psych_int64* dataSize,
+                                 psych_int64* channels, double* sampleRate, const char** errmsg)
+{
+    psych_int64 pos, chunkSize;
+    unsigned int formatTag = 0, bitsPerSample = 0;
+    psych_bool haveFormat = FALSE;
+
+    if ((size < 12) || memcmp(base, "RIFF", 4) || memcmp(base + 8, "WAVE", 4)) return(0);
+
+    // Walk the chunk list until we find the "data" chunk. The "fmt " chunk must precede it:
+    for (pos = 12; pos + 8 <= size; pos += 8 + chunkSize + (chunkSize & 1)) {
+        chunkSize = (psych_int64) PsychPAReadLE32(base + pos + 4);
+
+        if (!memcmp(base + pos, "fmt ", 4)) {
+            if ((chunkSize < 16) || (pos + 8 + chunkSize > size)) break;
+
+            formatTag = PsychPAReadLE16(base + pos + 8);
+            *channels = (psych_int64) PsychPAReadLE16(base + pos + 10);
+            *sampleRate = (double) PsychPAReadLE32(base + pos + 12);
+            bitsPerSample = PsychPAReadLE16(base + pos + 22);
+
+            // WAVE_FORMAT_EXTENSIBLE: Real format tag is in the first two bytes of the SubFormat GUID:
+            if ((formatTag == 0xfffe) && (chunkSize >= 40)) formatTag = PsychPAReadLE16(base + pos + 32);
+
+            haveFormat = TRUE;
+        }
+        else if (!memcmp(base + pos, "data", 4)) {
+            if (!haveFormat) break;
+
+            // Only WAVE_FORMAT_IEEE_FLOAT with 32 bits per sample can be used in place:
+            if ((formatTag != 3) || (bitsPerSample != 32)) {
+                *errmsg = "WAV file does not contain 32 bit floating point samples. Only float32 WAV files can be used for file-backed audio buffers.";
+                return(-1);
+            }
+
+            *dataOffset = pos + 8;
+
+            // Clamp size of data chunk to file size, to cope with truncated files, or streaming writers
+            // which didn't update the chunk size:
+            *dataSize = (*dataOffset + chunkSize > size) ? size - *dataOffset : chunkSize;
+
+            if (*dataOffset & 3) {
+                *errmsg = "WAV file sample data does not start at a 4 byte aligned file offset, so it can not be used in place.";
+                return(-1);
+            }
+
+            return(1);
+        }
+    }
+
+    *errmsg = "WAV file is malformed: No valid 'fmt ' chunk followed by a 'data' chunk found.";
+    return(-1);
+}
+
+const char* PsychPAMapSoundFile(const char* filename, psych_int64 rawChannels, PsychPAFileMapping* mapping,
+                                float** samples, psych_int64* channels, psych_int64* frames, double* sampleRate)
+{
+    const char* errmsg = NULL;
+    psych_int64 dataOffset = 0, dataSize = 0;
+    int rc;
+
+    mapping->base = NULL;
+    mapping->size = 0;
+
+    #if PSYCH_SYSTEM == PSYCH_WINDOWS
+    {
+        HANDLE file, filemapping;
+        LARGE_INTEGER fileSize;
+
+        file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE) return("Could not open sound file for reading.");
+
+        if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart <= 0)) {
+            CloseHandle(file);
+            return("Could not query size of sound file, or sound file is empty.");
+        }
+
+        filemapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(file);
+        if (filemapping == NULL) return("Could not create file mapping for sound file.");
+
+        // The view keeps the file mapping alive, so we can close the mapping handle right away:
+        mapping->base = MapViewOfFile(filemapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(filemapping);
+        if (mapping->base == NULL) return("Could not map sound file into memory. Maybe out of address space?");
+
+        mapping->size = (psych_int64) fileSize.QuadPart;
+    }
+    #else
+    {
+        struct stat st;
+        void* base;
+        int fd;
+
+        fd = open(filename, O_RDONLY);
+        if (fd < 0) return("Could not open sound file for reading.");
+
+        if (fstat(fd, &st) || (st.st_size <= 0)) {
+            close(fd);
+            return("Could not query size of sound file, or sound file is empty.");
+        }
+
+        // The mapping keeps the file alive, so we can close the file descriptor right away:
+        base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) return("Could not map sound file into memory. Maybe out of address space?");
+
+        // Playback is mostly sequential, so let the kernel use aggressive readahead:
+        madvise(base, (size_t) st.st_size, MADV_SEQUENTIAL);
+
+        mapping->base = base;
+        mapping->size = (psych_int64) st.st_size;
+    }
+    #endif
+
+    // WAV file or raw sample data?
+    rc = PsychPAParseWAVHeader((const unsigned char*) mapping->base, mapping->size, &dataOffset, &dataSize, channels, sampleRate, &errmsg);
+    if (rc == 0) {
+        // Raw interleaved float samples of rawChannels channels:
+        if (rawChannels < 1) {
+            errmsg = "Sound file is not a WAV file. Raw sample files require passing a 'pahandle' to define their channel count.";
+        }
+        else {
+            dataOffset = 0;
+            dataSize = mapping->size;
+            *channels = rawChannels;
+            *sampleRate = 0;
+        }
+    }
+
+    if (!errmsg && (*channels < 1)) errmsg = "Sound file has an invalid channel count of zero.";
+
+    if (!errmsg) {
+        *frames = dataSize / ((psych_int64) sizeof(float) * *channels);
+        if (*frames < 1) errmsg = "Sound file does not contain at least one complete sample frame.";
+    }
+
+    if (errmsg) {
+        PsychPAUnmapSoundFile(mapping);
+        return(errmsg);
+    }
+
+    *samples = (float*) ((unsigned char*) mapping->base + dataOffset);
+
+    // Kick off reading the start of the sound right away, so playback can start without waiting for the disk:
+    PsychPAPrefetchSamples(*samples, *frames * *channels);
+
+    return(NULL);
+}
+
+void PsychPAUnmapSoundFile(PsychPAFileMapping* mapping)
+{
+    if (mapping->base) {
+        #if PSYCH_SYSTEM == PSYCH_WINDOWS
+        UnmapViewOfFile(mapping->base);
+        #else
+        munmap(mapping->base, (size_t) mapping->size);
+        #endif
+    }
+
+    mapping->base = NULL;
+    mapping->size = 0;
+}
+
+// Maximum amount of data to prefetch in one call, to bound the work per hint:
+#define PSYCH_PA_PREFETCH_MAXBYTES (16 * 1024 * 1024)
+
+#if PSYCH_SYSTEM == PSYCH_WINDOWS
+// PrefetchVirtualMemory() only exists on Windows-8 and later, so we look it up at runtime:
+typedef struct PsychPAMemoryRangeEntry {
+    PVOID  VirtualAddress;
+    SIZE_T NumberOfBytes;
+} PsychPAMemoryRangeEntry;
+
+typedef BOOL (WINAPI *PrefetchVirtualMemoryPROC)(HANDLE hProcess, ULONG_PTR NumberOfEntries, PsychPAMemoryRangeEntry* VirtualAddresses, ULONG Flags);
+#endif
+
+void PsychPAPrefetchSamples(const float* samples, psych_int64 count)
+{
+    size_t start, end, pagesize;
+
+    if (!samples || (count <= 0)) return;
+
+    start = (size_t) samples;
+    end = start + (size_t) (((count * (psych_int64) sizeof(float)) > PSYCH_PA_PREFETCH_MAXBYTES) ? PSYCH_PA_PREFETCH_MAXBYTES : count * sizeof(float));
+
+    #if PSYCH_SYSTEM == PSYCH_WINDOWS
+    {
+        static PrefetchVirtualMemoryPROC prefetchVirtualMemory = NULL;
+        static psych_bool initialized = FALSE;
+        PsychPAMemoryRangeEntry range;
+        SYSTEM_INFO si;
+
+        if (!initialized) {
+            prefetchVirtualMemory = (PrefetchVirtualMemoryPROC) GetProcAddress(GetModuleHandleA("kernel32.dll"), "PrefetchVirtualMemory");
+            initialized = TRUE;
+        }
+
+        if (!prefetchVirtualMemory) return;
+
+        GetSystemInfo(&si);
+        pagesize = (size_t) si.dwPageSize;
+        start &= ~(pagesize - 1);
+        range.VirtualAddress = (PVOID) start;
+        range.NumberOfBytes = (SIZE_T) (end - start);
+        prefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    #else
+    pagesize = (size_t) sysconf(_SC_PAGESIZE);
+    start &= ~(pagesize - 1);
+    madvise((void*) start, end - start, MADV_WILLNEED);
+    #endif
+
+    return;
+}
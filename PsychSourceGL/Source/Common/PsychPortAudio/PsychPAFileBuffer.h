@@ -0,0 +1,44 @@
+/*
+ *        PsychToolbox3/Source/Common/PsychPortAudio/PsychPAFileBuffer.h
+ *
+ *        PLATFORMS:        All
+ *
+ *        DESCRIPTION:
+ *
+ *        Disk-backed audio buffers for PsychPortAudio: Read-only memory mapping of sound files
+ *        with 32 bit float samples, either as WAV files or as raw interleaved sample data, so
+ *        their samples can be used directly as content of PsychPortAudio audio buffers without
+ *        reading the whole file into memory first. Pages of the file are read in on demand by
+ *        the operating system, and ahead of time via PsychPAPrefetchSamples().
+ */
+
+//begin include once
+#ifndef PSYCH_IS_INCLUDED_PsychPAFileBuffer
+#define PSYCH_IS_INCLUDED_PsychPAFileBuffer
+
+#include "Psych.h"
+
+typedef struct PsychPAFileMapping {
+    void*       base;           // Start of read-only mapping of the whole file.
+    psych_int64 size;           // Size of the mapping in bytes.
+} PsychPAFileMapping;
+
+// Map sound file 'filename' read-only into memory. WAV files with 32 bit float samples define
+// their own channel count and sample rate. Any other file is treated as raw interleaved 32 bit
+// float samples of 'rawChannels' channels and unknown sample rate 0. On success, returns NULL,
+// sets up 'mapping' and returns the location, channel count, number of sample frames and sample
+// rate of the sound data in 'samples', 'channels', 'frames' and 'sampleRate'. On failure returns
+// a message describing the problem and leaves nothing mapped:
+const char* PsychPAMapSoundFile(const char* filename, psych_int64 rawChannels, PsychPAFileMapping* mapping,
+                                float** samples, psych_int64* channels, psych_int64* frames, double* sampleRate);
+
+// Unmap a file mapped via PsychPAMapSoundFile():
+void PsychPAUnmapSoundFile(PsychPAFileMapping* mapping);
+
+// Ask the operating system to asynchronously read in the pages backing 'count' samples starting
+// at 'samples', so they are resident before they get played. This is only a hint and safe to call
+// on any address range, even if it is not, or no longer, mapped:
+void PsychPAPrefetchSamples(const float* samples, psych_int64 count);
+
+//end include once
+#endif
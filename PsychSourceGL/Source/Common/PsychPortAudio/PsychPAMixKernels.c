@@ -0,0 +1,836 @@
+/*
+ *        PsychToolbox3/Source/Common/PsychPortAudio/PsychPAMixKernels.c
+ *
+ *        PLATFORMS:        All
+ *
+ *        DESCRIPTION:
+ *
+ *        Scalar and SIMD sample processing kernels for the PsychPortAudio paCallback().
+ *        See PsychPAMixKernels.h for details.
+ *
+ *        The SIMD variants are compiled with per-function target attributes on gcc and
+ *        clang, so the module as a whole still runs on cpus without SSE2 or AVX. They
+ *        only get called after cpu feature detection confirmed their availability.
+ *
+ *        NOTES:
+ *
+ *        This code runs in the realtime audio callback: No memory allocation, locking,
+ *        i/o or other unbounded operations allowed in any of the kernels!
+ */
+
+#include "PsychPAMixKernels.h"
+
+// x86 and x86_64: SSE2 and AVX:
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PSYCHPA_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// 64-bit ARM: NEON is part of the base instruction set and IEEE compliant:
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define PSYCHPA_HAVE_NEON_SIMD 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PSYCHPA_TARGET(t) __attribute__((target(t)))
+#else
+#define PSYCHPA_TARGET(t)
+#endif
+
+// Portable scalar kernels: Reference implementation, and fallback for all cpus:
+
+static void PsychPAFill_Scalar(float* dst, float value, psych_int64 count)
+{
+    psych_int64 i;
+    for (i = 0; i < count; i++) dst[i] = value;
+}
+
+static void PsychPAScale_Scalar(float* dst, float gain, psych_int64 count)
+{
+    psych_int64 i;
+    for (i = 0; i < count; i++) dst[i] *= gain;
+}
+
+static void PsychPACopyScaled_Scalar(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i;
+    for (i = 0; i < count; i++) dst[i] = src[i] * gain;
+}
+
+static void PsychPAMulScaled_Scalar(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i;
+    for (i = 0; i < count; i++) dst[i] *= src[i] * gain;
+}
+
+static void PsychPAMixScaled_Scalar(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i;
+    for (i = 0; i < count; i++) dst[i] += src[i] * gain;
+}
+
+static void PsychPACopyPattern8_Scalar(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i;
+    for (i = 0; i < count; i++) dst[i] = src[i] * gain[i & 7];
+}
+
+static void PsychPAMulPattern8_Scalar(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i;
+    for (i = 0; i < count; i++) dst[i] *= src[i] * gain[i & 7];
+}
+
+static void PsychPAMixPattern8_Scalar(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i;
+    for (i = 0; i < count; i++) dst[i] += src[i] * gain[i & 7];
+}
+
+static void PsychPAInt16ToFloat_Scalar(float* dst, const short* src, psych_int64 count)
+{
+    psych_int64 i;
+    for (i = 0; i < count; i++) dst[i] = (float) src[i] * (1.0f / 32768.0f);
+}
+
+// Packed int24 has no SIMD friendly layout, so all kernel sets use this one:
+static void PsychPAInt24ToFloat_Scalar(float* dst, const unsigned char* src, psych_int64 count)
+{
+    psych_int64 i;
+    int v;
+
+    for (i = 0; i < count; i++, src += 3) {
+        // Assemble the 24 bits in the upper bits of an int, then sign-extend by arithmetic shift:
+        v = (int) (((psych_uint32) src[0] << 8) | ((psych_uint32) src[1] << 16) | ((psych_uint32) src[2] << 24)) >> 8;
+        dst[i] = (float) v * (1.0f / 8388608.0f);
+    }
+}
+
+// Exact half to float conversion: Shift exponent and mantissa into place, then rebias the exponent
+// by a multiply with 2^112, which also takes care of half denormals. Inf and NaN get their exponent
+// restored afterwards:
+static void PsychPAHalfToFloat_Scalar(float* dst, const psych_uint16* src, psych_int64 count)
+{
+    psych_int64 i;
+    union { psych_uint32 u; float f; } v;
+
+    for (i = 0; i < count; i++) {
+        v.u = ((psych_uint32) (src[i] & 0x7fff)) << 13;
+        v.f *= 5.192296858534828e+33f;
+        if ((src[i] & 0x7c00) == 0x7c00) v.u |= 0x7f800000;
+        v.u |= ((psych_uint32) (src[i] & 0x8000)) << 16;
+        dst[i] = v.f;
+    }
+}
+
+// Biquad section in transposed direct form II on 4 adjacent channels of 'frames' frames of
+// interleaved 'buf' with 'stride' channels. coeffs[] = { b0, b1, b2, a1, a2 }, state[] holds
+// the two delay elements of each of the 4 channels, ie., z1[0..3] followed by z2[0..3]:
+static void PsychPABiquad4_Scalar(float* buf, psych_int64 stride, psych_int64 frames, const float* coeffs, float* state)
+{
+    psych_int64 i;
+    int j;
+    float x, y;
+
+    for (i = 0; i < frames; i++, buf += stride) {
+        for (j = 0; j < 4; j++) {
+            x = buf[j];
+            y = coeffs[0] * x + state[j];
+            state[j] = (coeffs[1] * x - coeffs[3] * y) + state[4 + j];
+            state[4 + j] = coeffs[2] * x - coeffs[4] * y;
+            buf[j] = y;
+        }
+    }
+}
+
+#ifdef PSYCHPA_HAVE_X86_SIMD
+
+// SSE2 kernels: 4 samples per iteration, unaligned loads and stores:
+
+PSYCHPA_TARGET("sse2") static void PsychPAFill_SSE2(float* dst, float value, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m128 v = _mm_set1_ps(value);
+
+    for (; i + 4 <= count; i += 4) _mm_storeu_ps(dst + i, v);
+    for (; i < count; i++) dst[i] = value;
+}
+
+PSYCHPA_TARGET("sse2") static void PsychPAScale_SSE2(float* dst, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m128 g = _mm_set1_ps(gain);
+
+    for (; i + 4 <= count; i += 4) _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), g));
+    for (; i < count; i++) dst[i] *= gain;
+}
+
+PSYCHPA_TARGET("sse2") static void PsychPACopyScaled_SSE2(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m128 g = _mm_set1_ps(gain);
+
+    for (; i + 4 <= count; i += 4) _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), g));
+    for (; i < count; i++) dst[i] = src[i] * gain;
+}
+
+PSYCHPA_TARGET("sse2") static void PsychPAMulScaled_SSE2(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m128 g = _mm_set1_ps(gain);
+
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+    for (; i < count; i++) dst[i] *= src[i] * gain;
+}
+
+PSYCHPA_TARGET("sse2") static void PsychPAMixScaled_SSE2(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m128 g = _mm_set1_ps(gain);
+
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+    for (; i < count; i++) dst[i] += src[i] * gain;
+}
+
+PSYCHPA_TARGET("sse2") static void PsychPACopyPattern8_SSE2(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m128 g0 = _mm_loadu_ps(gain);
+    __m128 g1 = _mm_loadu_ps(gain + 4);
+
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), g0));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_loadu_ps(src + i + 4), g1));
+    }
+    for (; i < count; i++) dst[i] = src[i] * gain[i & 7];
+}
+
+PSYCHPA_TARGET("sse2") static void PsychPAMulPattern8_SSE2(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m128 g0 = _mm_loadu_ps(gain);
+    __m128 g1 = _mm_loadu_ps(gain + 4);
+
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g0)));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(_mm_loadu_ps(src + i + 4), g1)));
+    }
+    for (; i < count; i++) dst[i] *= src[i] * gain[i & 7];
+}
+
+PSYCHPA_TARGET("sse2") static void PsychPAMixPattern8_SSE2(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m128 g0 = _mm_loadu_ps(gain);
+    __m128 g1 = _mm_loadu_ps(gain + 4);
+
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g0)));
+        _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(_mm_loadu_ps(src + i + 4), g1)));
+    }
+    for (; i < count; i++) dst[i] += src[i] * gain[i & 7];
+}
+
+// The recursion prevents vectorization along time, so this vectorizes across 4 channels:
+PSYCHPA_TARGET("sse2") static void PsychPABiquad4_SSE2(float* buf, psych_int64 stride, psych_int64 frames, const float* coeffs, float* state)
+{
+    psych_int64 i;
+    __m128 b0 = _mm_set1_ps(coeffs[0]), b1 = _mm_set1_ps(coeffs[1]), b2 = _mm_set1_ps(coeffs[2]);
+    __m128 a1 = _mm_set1_ps(coeffs[3]), a2 = _mm_set1_ps(coeffs[4]);
+    __m128 z1 = _mm_loadu_ps(state), z2 = _mm_loadu_ps(state + 4);
+    __m128 x, y;
+
+    for (i = 0; i < frames; i++, buf += stride) {
+        x = _mm_loadu_ps(buf);
+        y = _mm_add_ps(_mm_mul_ps(b0, x), z1);
+        z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), z2);
+        z2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+        _mm_storeu_ps(buf, y);
+    }
+
+    _mm_storeu_ps(state, z1);
+    _mm_storeu_ps(state + 4, z2);
+}
+
+PSYCHPA_TARGET("sse2") static void PsychPAInt16ToFloat_SSE2(float* dst, const short* src, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m128 s = _mm_set1_ps(1.0f / 32768.0f);
+    __m128i v;
+
+    for (; i + 8 <= count; i += 8) {
+        // Sign-extend 16 -> 32 bits by unpacking each value into the upper half, then shifting it down:
+        v = _mm_loadu_si128((const __m128i*) (src + i));
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), s));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), s));
+    }
+    for (; i < count; i++) dst[i] = (float) src[i] * (1.0f / 32768.0f);
+}
+
+// AVX kernels: 8 samples per iteration. No FMA, so we round exactly like the scalar code:
+
+PSYCHPA_TARGET("avx") static void PsychPAFill_AVX(float* dst, float value, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m256 v = _mm256_set1_ps(value);
+
+    for (; i + 8 <= count; i += 8) _mm256_storeu_ps(dst + i, v);
+    for (; i < count; i++) dst[i] = value;
+}
+
+PSYCHPA_TARGET("avx") static void PsychPAScale_AVX(float* dst, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m256 g = _mm256_set1_ps(gain);
+
+    for (; i + 8 <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), g));
+    for (; i < count; i++) dst[i] *= gain;
+}
+
+PSYCHPA_TARGET("avx") static void PsychPACopyScaled_AVX(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m256 g = _mm256_set1_ps(gain);
+
+    for (; i + 8 <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), g));
+    for (; i < count; i++) dst[i] = src[i] * gain;
+}
+
+PSYCHPA_TARGET("avx") static void PsychPAMulScaled_AVX(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m256 g = _mm256_set1_ps(gain);
+
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+    for (; i < count; i++) dst[i] *= src[i] * gain;
+}
+
+PSYCHPA_TARGET("avx") static void PsychPAMixScaled_AVX(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m256 g = _mm256_set1_ps(gain);
+
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+    for (; i < count; i++) dst[i] += src[i] * gain;
+}
+
+PSYCHPA_TARGET("avx") static void PsychPACopyPattern8_AVX(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m256 g = _mm256_loadu_ps(gain);
+
+    for (; i + 8 <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), g));
+    for (; i < count; i++) dst[i] = src[i] * gain[i & 7];
+}
+
+PSYCHPA_TARGET("avx") static void PsychPAMulPattern8_AVX(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m256 g = _mm256_loadu_ps(gain);
+
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+    for (; i < count; i++) dst[i] *= src[i] * gain[i & 7];
+}
+
+PSYCHPA_TARGET("avx") static void PsychPAMixPattern8_AVX(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    __m256 g = _mm256_loadu_ps(gain);
+
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+    for (; i < count; i++) dst[i] += src[i] * gain[i & 7];
+}
+
+// Hardware half to float conversion of F16C capable cpus. Only used together with the AVX kernels:
+PSYCHPA_TARGET("avx,f16c") static void PsychPAHalfToFloat_F16C(float* dst, const psych_uint16* src, psych_int64 count)
+{
+    psych_int64 i = 0;
+
+    for (; i + 8 <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*) (src + i))));
+    if (i < count) PsychPAHalfToFloat_Scalar(dst + i, src + i, count - i);
+}
+
+static psych_bool PsychPACpuHasSSE2(void)
+{
+    #if defined(__x86_64__) || defined(_M_X64)
+        // Part of the x86_64 base instruction set:
+        return(TRUE);
+    #elif defined(_MSC_VER)
+        int regs[4];
+        __cpuid(regs, 1);
+        return((regs[3] & (1 << 26)) ? TRUE : FALSE);
+    #else
+        __builtin_cpu_init();
+        return(__builtin_cpu_supports("sse2") ? TRUE : FALSE);
+    #endif
+}
+
+static psych_bool PsychPACpuHasAVX(void)
+{
+    #if defined(_MSC_VER)
+        int regs[4];
+        __cpuid(regs, 1);
+
+        // Cpu supports AVX and XSAVE, and the OS saves/restores ymm registers on context switch?
+        if ((regs[2] & (1 << 27)) && (regs[2] & (1 << 28)))
+            return(((_xgetbv(0) & 6) == 6) ? TRUE : FALSE);
+
+        return(FALSE);
+    #else
+        __builtin_cpu_init();
+        return(__builtin_cpu_supports("avx") ? TRUE : FALSE);
+    #endif
+}
+
+static psych_bool PsychPACpuHasF16C(void)
+{
+    #if defined(_MSC_VER)
+        int regs[4];
+        __cpuid(regs, 1);
+        return((regs[2] & (1 << 29)) ? TRUE : FALSE);
+    #else
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return(FALSE);
+        return((ecx & (1 << 29)) ? TRUE : FALSE);
+    #endif
+}
+
+#endif
+
+#ifdef PSYCHPA_HAVE_NEON_SIMD
+
+// NEON kernels: 4 samples per iteration, no fused multiply-add:
+
+static void PsychPAFill_NEON(float* dst, float value, psych_int64 count)
+{
+    psych_int64 i = 0;
+    float32x4_t v = vdupq_n_f32(value);
+
+    for (; i + 4 <= count; i += 4) vst1q_f32(dst + i, v);
+    for (; i < count; i++) dst[i] = value;
+}
+
+static void PsychPAScale_NEON(float* dst, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    float32x4_t g = vdupq_n_f32(gain);
+
+    for (; i + 4 <= count; i += 4) vst1q_f32(dst + i, vmulq_f32(vld1q_f32(dst + i), g));
+    for (; i < count; i++) dst[i] *= gain;
+}
+
+static void PsychPACopyScaled_NEON(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    float32x4_t g = vdupq_n_f32(gain);
+
+    for (; i + 4 <= count; i += 4) vst1q_f32(dst + i, vmulq_f32(vld1q_f32(src + i), g));
+    for (; i < count; i++) dst[i] = src[i] * gain;
+}
+
+static void PsychPAMulScaled_NEON(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    float32x4_t g = vdupq_n_f32(gain);
+
+    for (; i + 4 <= count; i += 4) vst1q_f32(dst + i, vmulq_f32(vld1q_f32(dst + i), vmulq_f32(vld1q_f32(src + i), g)));
+    for (; i < count; i++) dst[i] *= src[i] * gain;
+}
+
+static void PsychPAMixScaled_NEON(float* dst, const float* src, float gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    float32x4_t g = vdupq_n_f32(gain);
+
+    for (; i + 4 <= count; i += 4) vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vmulq_f32(vld1q_f32(src + i), g)));
+    for (; i < count; i++) dst[i] += src[i] * gain;
+}
+
+static void PsychPACopyPattern8_NEON(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    float32x4_t g0 = vld1q_f32(gain);
+    float32x4_t g1 = vld1q_f32(gain + 4);
+
+    for (; i + 8 <= count; i += 8) {
+        vst1q_f32(dst + i, vmulq_f32(vld1q_f32(src + i), g0));
+        vst1q_f32(dst + i + 4, vmulq_f32(vld1q_f32(src + i + 4), g1));
+    }
+    for (; i < count; i++) dst[i] = src[i] * gain[i & 7];
+}
+
+static void PsychPAMulPattern8_NEON(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    float32x4_t g0 = vld1q_f32(gain);
+    float32x4_t g1 = vld1q_f32(gain + 4);
+
+    for (; i + 8 <= count; i += 8) {
+        vst1q_f32(dst + i, vmulq_f32(vld1q_f32(dst + i), vmulq_f32(vld1q_f32(src + i), g0)));
+        vst1q_f32(dst + i + 4, vmulq_f32(vld1q_f32(dst + i + 4), vmulq_f32(vld1q_f32(src + i + 4), g1)));
+    }
+    for (; i < count; i++) dst[i] *= src[i] * gain[i & 7];
+}
+
+static void PsychPAMixPattern8_NEON(float* dst, const float* src, const float* gain, psych_int64 count)
+{
+    psych_int64 i = 0;
+    float32x4_t g0 = vld1q_f32(gain);
+    float32x4_t g1 = vld1q_f32(gain + 4);
+
+    for (; i + 8 <= count; i += 8) {
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vmulq_f32(vld1q_f32(src + i), g0)));
+        vst1q_f32(dst + i + 4, vaddq_f32(vld1q_f32(dst + i + 4), vmulq_f32(vld1q_f32(src + i + 4), g1)));
+    }
+    for (; i < count; i++) dst[i] += src[i] * gain[i & 7];
+}
+
+static void PsychPAInt16ToFloat_NEON(float* dst, const short* src, psych_int64 count)
+{
+    psych_int64 i = 0;
+    float32x4_t s = vdupq_n_f32(1.0f / 32768.0f);
+
+    for (; i + 4 <= count; i += 4) vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(src + i))), s));
+    for (; i < count; i++) dst[i] = (float) src[i] * (1.0f / 32768.0f);
+}
+
+static void PsychPABiquad4_NEON(float* buf, psych_int64 stride, psych_int64 frames, const float* coeffs, float* state)
+{
+    psych_int64 i;
+    float32x4_t b0 = vdupq_n_f32(coeffs[0]), b1 = vdupq_n_f32(coeffs[1]), b2 = vdupq_n_f32(coeffs[2]);
+    float32x4_t a1 = vdupq_n_f32(coeffs[3]), a2 = vdupq_n_f32(coeffs[4]);
+    float32x4_t z1 = vld1q_f32(state), z2 = vld1q_f32(state + 4);
+    float32x4_t x, y;
+
+    // Separate multiplies and adds instead of vmlaq_f32(), as fused multiply-add would round differently:
+    for (i = 0; i < frames; i++, buf += stride) {
+        x = vld1q_f32(buf);
+        y = vaddq_f32(vmulq_f32(b0, x), z1);
+        z1 = vaddq_f32(vsubq_f32(vmulq_f32(b1, x), vmulq_f32(a1, y)), z2);
+        z2 = vsubq_f32(vmulq_f32(b2, x), vmulq_f32(a2, y));
+        vst1q_f32(buf, y);
+    }
+
+    vst1q_f32(state, z1);
+    vst1q_f32(state + 4, z2);
+}
+
+static void PsychPAHalfToFloat_NEON(float* dst, const psych_uint16* src, psych_int64 count)
+{
+    psych_int64 i = 0;
+
+    for (; i + 4 <= count; i += 4) vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+    if (i < count) PsychPAHalfToFloat_Scalar(dst + i, src + i, count - i);
+}
+
+#endif
+
+static const PsychPAMixKernels psychPAMixScalar = {
+    kPsychPAMixKernelsScalar, "Scalar",
+    PsychPAFill_Scalar, PsychPAScale_Scalar, PsychPACopyScaled_Scalar, PsychPAMulScaled_Scalar, PsychPAMixScaled_Scalar,
+    PsychPACopyPattern8_Scalar, PsychPAMulPattern8_Scalar, PsychPAMixPattern8_Scalar,
+    PsychPAInt16ToFloat_Scalar, PsychPAInt24ToFloat_Scalar, PsychPAHalfToFloat_Scalar,
+    PsychPABiquad4_Scalar
+};
+
+#ifdef PSYCHPA_HAVE_X86_SIMD
+static const PsychPAMixKernels psychPAMixSSE2 = {
+    kPsychPAMixKernelsSSE2, "SSE2",
+    PsychPAFill_SSE2, PsychPAScale_SSE2, PsychPACopyScaled_SSE2, PsychPAMulScaled_SSE2, PsychPAMixScaled_SSE2,
+    PsychPACopyPattern8_SSE2, PsychPAMulPattern8_SSE2, PsychPAMixPattern8_SSE2,
+    PsychPAInt16ToFloat_SSE2, PsychPAInt24ToFloat_Scalar, PsychPAHalfToFloat_Scalar,
+    PsychPABiquad4_SSE2
+};
+
+static const PsychPAMixKernels psychPAMixAVX = {
+    kPsychPAMixKernelsAVX, "AVX",
+    PsychPAFill_AVX, PsychPAScale_AVX, PsychPACopyScaled_AVX, PsychPAMulScaled_AVX, PsychPAMixScaled_AVX,
+    PsychPACopyPattern8_AVX, PsychPAMulPattern8_AVX, PsychPAMixPattern8_AVX,
+    PsychPAInt16ToFloat_SSE2, PsychPAInt24ToFloat_Scalar, PsychPAHalfToFloat_Scalar,
+    PsychPABiquad4_SSE2
+};
+#endif
+
+#ifdef PSYCHPA_HAVE_NEON_SIMD
+static const PsychPAMixKernels psychPAMixNEON = {
+    kPsychPAMixKernelsNEON, "NEON",
+    PsychPAFill_NEON, PsychPAScale_NEON, PsychPACopyScaled_NEON, PsychPAMulScaled_NEON, PsychPAMixScaled_NEON,
+    PsychPACopyPattern8_NEON, PsychPAMulPattern8_NEON, PsychPAMixPattern8_NEON,
+    PsychPAInt16ToFloat_NEON, PsychPAInt24ToFloat_Scalar, PsychPAHalfToFloat_NEON,
+    PsychPABiquad4_NEON
+};
+#endif
+
+// Currently selected kernels. Start with the always safe scalar ones:
+PsychPAMixKernels psychPAMix = {
+    kPsychPAMixKernelsScalar, "Scalar",
+    PsychPAFill_Scalar, PsychPAScale_Scalar, PsychPACopyScaled_Scalar, PsychPAMulScaled_Scalar, PsychPAMixScaled_Scalar,
+    PsychPACopyPattern8_Scalar, PsychPAMulPattern8_Scalar, PsychPAMixPattern8_Scalar,
+    PsychPAInt16ToFloat_Scalar, PsychPAInt24ToFloat_Scalar, PsychPAHalfToFloat_Scalar,
+    PsychPABiquad4_Scalar
+};
+
+int PsychPAGetBestMixKernelsId(void)
+{
+    #ifdef PSYCHPA_HAVE_X86_SIMD
+    if (PsychPACpuHasAVX()) return(kPsychPAMixKernelsAVX);
+    if (PsychPACpuHasSSE2()) return(kPsychPAMixKernelsSSE2);
+    #endif
+
+    #ifdef PSYCHPA_HAVE_NEON_SIMD
+    return(kPsychPAMixKernelsNEON);
+    #endif
+
+    return(kPsychPAMixKernelsScalar);
+}
+
+int PsychPASelectMixKernels(int id)
+{
+    int best = PsychPAGetBestMixKernelsId();
+
+    if (id == kPsychPAMixKernelsAuto) id = best;
+
+    // Only allow implementations the cpu supports. AVX capable cpus also support SSE2:
+    if ((id != kPsychPAMixKernelsScalar) && (id != best) && !((id == kPsychPAMixKernelsSSE2) && (best == kPsychPAMixKernelsAVX)))
+        id = kPsychPAMixKernelsScalar;
+
+    switch (id) {
+        #ifdef PSYCHPA_HAVE_X86_SIMD
+        case kPsychPAMixKernelsAVX:
+            psychPAMix = psychPAMixAVX;
+            if (PsychPACpuHasF16C()) psychPAMix.halfToFloat = PsychPAHalfToFloat_F16C;
+            break;
+
+        case kPsychPAMixKernelsSSE2:
+            psychPAMix = psychPAMixSSE2;
+            break;
+        #endif
+
+        #ifdef PSYCHPA_HAVE_NEON_SIMD
+        case kPsychPAMixKernelsNEON:
+            psychPAMix = psychPAMixNEON;
+            break;
+        #endif
+
+        default:
+            psychPAMix = psychPAMixScalar;
+    }
+
+    return(psychPAMix.id);
+}
+
+// Is mappings[] the identity mapping k -> k for all 'channels'?
+static psych_bool PsychPAIsIdentityMapping(const int* mappings, psych_int64 channels)
+{
+    psych_int64 k;
+
+    for (k = 0; k < channels; k++) if (mappings[k] != k) return(FALSE);
+
+    return(TRUE);
+}
+
+// Are all 'channels' volumes[] the same value?
+static psych_bool PsychPAIsUniformVolume(const float* volumes, psych_int64 channels)
+{
+    psych_int64 k;
+
+    for (k = 1; k < channels; k++) if (volumes[k] != volumes[0]) return(FALSE);
+
+    return(TRUE);
+}
+
+void PsychPAMixMapped(float* dst, psych_int64 dstchannels, const float* src, psych_int64 srcchannels,
+                      const int* mappings, const float* volumes, psych_int64 frames, int op)
+{
+    psych_int64 j, k;
+    float pattern[8];
+
+    if ((frames <= 0) || (srcchannels <= 0)) return;
+
+    // Fast path: Identity mapping, ie. source and target are the same interleaved layout,
+    // so we can process the whole buffer as one linear array of samples:
+    if ((srcchannels == dstchannels) && PsychPAIsIdentityMapping(mappings, srcchannels)) {
+        if (PsychPAIsUniformVolume(volumes, srcchannels)) {
+            // Same gain for all channels, the common case:
+            switch (op) {
+                case kPsychPAMixAdd:
+                    psychPAMix.mixScaled(dst, src, volumes[0], frames * srcchannels);
+                    break;
+
+                case kPsychPAMixMultiply:
+                    psychPAMix.mulScaled(dst, src, volumes[0], frames * srcchannels);
+                    break;
+
+                default:
+                    psychPAMix.copyScaled(dst, src, volumes[0], frames * srcchannels);
+            }
+
+            return;
+        }
+
+        if ((8 % srcchannels) == 0) {
+            // 1, 2, 4 or 8 channels with different gains: Gains repeat every 8 samples:
+            for (k = 0; k < 8; k++) pattern[k] = volumes[k % srcchannels];
+
+            switch (op) {
+                case kPsychPAMixAdd:
+                    psychPAMix.mixPattern8(dst, src, pattern, frames * srcchannels);
+                    break;
+
+                case kPsychPAMixMultiply:
+                    psychPAMix.mulPattern8(dst, src, pattern, frames * srcchannels);
+                    break;
+
+                default:
+                    psychPAMix.copyPattern8(dst, src, pattern, frames * srcchannels);
+            }
+
+            return;
+        }
+    }
+
+    // Generic path: Arbitrary routing of source channels to target channels:
+    switch (op) {
+        case kPsychPAMixAdd:
+            for (j = 0; j < frames; j++, dst += dstchannels)
+                for (k = 0; k < srcchannels; k++) dst[mappings[k]] += *(src++) * volumes[k];
+            break;
+
+        case kPsychPAMixMultiply:
+            for (j = 0; j < frames; j++, dst += dstchannels)
+                for (k = 0; k < srcchannels; k++) dst[mappings[k]] *= *(src++) * volumes[k];
+            break;
+
+        default:
+            for (j = 0; j < frames; j++, dst += dstchannels)
+                for (k = 0; k < srcchannels; k++) dst[mappings[k]] = *(src++) * volumes[k];
+    }
+}
+
+void PsychPAGatherMapped(float* dst, psych_int64 dstchannels, const float* src, psych_int64 srcchannels,
+                         const int* mappings, float gain, psych_int64 frames)
+{
+    psych_int64 j, k;
+
+    if ((frames <= 0) || (dstchannels <= 0)) return;
+
+    // Fast path: Identity mapping is a plain gain-scaled copy:
+    if ((srcchannels == dstchannels) && PsychPAIsIdentityMapping(mappings, dstchannels)) {
+        psychPAMix.copyScaled(dst, src, gain, frames * dstchannels);
+        return;
+    }
+
+    for (j = 0; j < frames; j++, src += srcchannels)
+        for (k = 0; k < dstchannels; k++) *(dst++) = gain * src[mappings[k]];
+}
+
+void PsychPAFillMapped(float* dst, psych_int64 dstchannels, const int* mappings, psych_int64 nmapped,
+                       float value, psych_int64 frames)
+{
+    psych_int64 j, k;
+
+    if ((nmapped == dstchannels) && PsychPAIsIdentityMapping(mappings, nmapped)) {
+        psychPAMix.fill(dst, value, frames * dstchannels);
+        return;
+    }
+
+    for (j = 0; j < frames; j++, dst += dstchannels)
+        for (k = 0; k < nmapped; k++) dst[mappings[k]] = value;
+}
+
+void PsychPAConvertSamples(float* dst, const void* src, int format, psych_int64 offset, psych_int64 count)
+{
+    switch (format) {
+        case kPsychPASampleInt16:
+            psychPAMix.int16ToFloat(dst, (const short*) src + offset, count);
+            break;
+
+        case kPsychPASampleInt24:
+            psychPAMix.int24ToFloat(dst, (const unsigned char*) src + 3 * offset, count);
+            break;
+
+        case kPsychPASampleFloat16:
+            psychPAMix.halfToFloat(dst, (const psych_uint16*) src + offset, count);
+            break;
+
+        default:
+            memcpy(dst, (const float*) src + offset, (size_t) count * sizeof(float));
+    }
+}
+
+// Round to nearest and clamp to [minv, maxv]:
+static int PsychPAQuantize(double value, double scale, int minv, int maxv)
+{
+    value = floor(value * scale + 0.5);
+    return((value < minv) ? minv : ((value > maxv) ? maxv : (int) value));
+}
+
+// Float to half conversion with round to nearest even, overflow to Inf and correct denormals:
+static psych_uint16 PsychPAFloatToHalf(float value)
+{
+    union { psych_uint32 u; float f; } v;
+    psych_uint32 sign, odd;
+
+    v.f = value;
+    sign = (v.u >> 16) & 0x8000;
+    v.u &= 0x7fffffff;
+
+    // Inf or NaN, or too big for half: Inf or quiet NaN:
+    if (v.u >= 0x47800000) return((psych_uint16) (sign | ((v.u > 0x7f800000) ? 0x7e00 : 0x7c00)));
+
+    // Half denormal or zero: Let the float adder do the rounding for us, by adding 0.5, which aligns
+    // the half denormal mantissa with the low bits of the float mantissa:
+    if (v.u < 0x38800000) {
+        v.f += 0.5f;
+        return((psych_uint16) (sign | (v.u - 0x3f000000)));
+    }
+
+    // Normal: Rebias exponent and round the 13 dropped mantissa bits to nearest even:
+    odd = (v.u >> 13) & 1;
+    v.u = v.u - ((psych_uint32) 112 << 23) + 0xfff + odd;
+    return((psych_uint16) (sign | (v.u >> 13)));
+}
+
+void PsychPAStoreSamples(void* dst, int format, psych_int64 offset, const double* srcd, const float* srcf,
+                         double gain, psych_int64 count)
+{
+    psych_int64 i;
+    double value;
+    int q;
+
+    for (i = 0; i < count; i++) {
+        value = gain * ((srcd) ? srcd[i] : (double) srcf[i]);
+
+        switch (format) {
+            case kPsychPASampleInt16:
+                ((short*) dst)[offset + i] = (short) PsychPAQuantize(value, 32768.0, -32768, 32767);
+                break;
+
+            case kPsychPASampleInt24:
+                q = PsychPAQuantize(value, 8388608.0, -8388608, 8388607);
+                ((unsigned char*) dst)[3 * (offset + i) + 0] = (unsigned char) (q & 0xff);
+                ((unsigned char*) dst)[3 * (offset + i) + 1] = (unsigned char) ((q >> 8) & 0xff);
+                ((unsigned char*) dst)[3 * (offset + i) + 2] = (unsigned char) ((q >> 16) & 0xff);
+                break;
+
+            case kPsychPASampleFloat16:
+                ((psych_uint16*) dst)[offset + i] = PsychPAFloatToHalf((float) value);
+                break;
+
+            default:
+                ((float*) dst)[offset + i] = (float) value;
+        }
+    }
+}
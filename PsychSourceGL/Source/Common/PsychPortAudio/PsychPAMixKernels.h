@@ -0,0 +1,123 @@
+/*
+ *        PsychToolbox3/Source/Common/PsychPortAudio/PsychPAMixKernels.h
+ *
+ *        PLATFORMS:        All
+ *
+ *        DESCRIPTION:
+ *
+ *        Sample processing kernels for the paCallback() of PsychPortAudio: Fill, gain-apply,
+ *        mix and AM-modulate of interleaved float sample buffers, as used by master devices
+ *        to mix and merge their slaves, and by all devices to emit sound.
+ *
+ *        Each kernel exists as portable scalar C implementation, and as SIMD implementation
+ *        for SSE2 and AVX on x86/x86_64 and NEON on ARM. The best implementation supported
+ *        by the running cpu is selected once at PsychPortAudioInitialize() time. All SIMD
+ *        kernels perform the same float operations in the same order as the scalar kernels,
+ *        so results are bit-identical, regardless of selected implementation.
+ *
+ *        A biquad filter kernel implements the IIR filter stages of the DSP insert chains of
+ *        PsychPADSP.c. It processes 4 channels in parallel, as the recursion of the filter
+ *        prevents vectorization along the time axis.
+ *
+ *        Audio buffers can also store their samples in compact int16, packed int24 or float16
+ *        formats. Conversion kernels turn those into float samples for mixing, and helpers
+ *        quantize float samples into those formats when buffers get filled.
+ */
+
+//begin include once
+#ifndef PSYCH_IS_INCLUDED_PsychPAMixKernels
+#define PSYCH_IS_INCLUDED_PsychPAMixKernels
+
+#include "Psych.h"
+
+// Kernel implementation ids, as used by PsychPASelectMixKernels() and
+// returned by PsychPAGetMixKernelsId():
+#define kPsychPAMixKernelsAuto      -1
+#define kPsychPAMixKernelsScalar    0
+#define kPsychPAMixKernelsSSE2      1
+#define kPsychPAMixKernelsAVX       2
+#define kPsychPAMixKernelsNEON      3
+
+// Combine operation for PsychPAMixMapped():
+#define kPsychPAMixAdd              0   // dst += src * volume
+#define kPsychPAMixMultiply         1   // dst *= src * volume
+#define kPsychPAMixStore            2   // dst  = src * volume
+
+// Sample storage formats of audio buffers:
+#define kPsychPASampleFloat32       0   // 32 bit IEEE float, the native format.
+#define kPsychPASampleInt16         1   // 16 bit signed integer, full scale 32768.
+#define kPsychPASampleInt24         2   // 24 bit signed integer packed into 3 little-endian bytes, full scale 8388608.
+#define kPsychPASampleFloat16       3   // 16 bit IEEE half precision float.
+#define kPsychPASampleFormatCount   4
+
+// Bytes per sample of a given sample storage format:
+#define PsychPASampleFormatBytes(format) (((format) == kPsychPASampleInt24) ? 3 : (((format) == kPsychPASampleFloat32) ? 4 : 2))
+
+typedef struct PsychPAMixKernels {
+    int         id;
+    const char* name;
+    // dst[i] = value:
+    void (*fill)(float* dst, float value, psych_int64 count);
+    // dst[i] *= gain:
+    void (*scale)(float* dst, float gain, psych_int64 count);
+    // dst[i] = src[i] * gain:
+    void (*copyScaled)(float* dst, const float* src, float gain, psych_int64 count);
+    // dst[i] *= src[i] * gain:
+    void (*mulScaled)(float* dst, const float* src, float gain, psych_int64 count);
+    // dst[i] += src[i] * gain:
+    void (*mixScaled)(float* dst, const float* src, float gain, psych_int64 count);
+    // Same as the three above, but with gain[i % 8] from an 8 element gain pattern:
+    void (*copyPattern8)(float* dst, const float* src, const float* gain, psych_int64 count);
+    void (*mulPattern8)(float* dst, const float* src, const float* gain, psych_int64 count);
+    void (*mixPattern8)(float* dst, const float* src, const float* gain, psych_int64 count);
+    // dst[i] = src[i] converted from compact storage formats to float in range [-1, +1):
+    void (*int16ToFloat)(float* dst, const short* src, psych_int64 count);
+    void (*int24ToFloat)(float* dst, const unsigned char* src, psych_int64 count);
+    void (*halfToFloat)(float* dst, const psych_uint16* src, psych_int64 count);
+    // Biquad filter section on 4 adjacent channels of interleaved 'buf' with 'stride' channels,
+    // with coeffs[] = { b0, b1, b2, a1, a2 } and 8 element filter 'state':
+    void (*biquad4)(float* buf, psych_int64 stride, psych_int64 frames, const float* coeffs, float* state);
+} PsychPAMixKernels;
+
+// Currently selected kernel set. Read-only for everybody but PsychPASelectMixKernels():
+extern PsychPAMixKernels psychPAMix;
+
+// Select kernel implementation 'id', or the best one for the running cpu if id is
+// kPsychPAMixKernelsAuto. Falls back to scalar kernels if the requested implementation
+// is not supported. Returns the id of the selected implementation:
+int PsychPASelectMixKernels(int id);
+
+// Id of the best kernel implementation supported by the running cpu:
+int PsychPAGetBestMixKernelsId(void);
+
+// Mix, modulate or store 'frames' sample frames of 'srcchannels' channel interleaved
+// 'src' into 'dstchannels' channel interleaved 'dst', routing source channel k into
+// target channel mappings[k], applying per-channel gain volumes[k] on the way. 'op'
+// is one of kPsychPAMixAdd, kPsychPAMixMultiply or kPsychPAMixStore. Identity channel
+// mappings take a vectorized fast path:
+void PsychPAMixMapped(float* dst, psych_int64 dstchannels, const float* src, psych_int64 srcchannels,
+                      const int* mappings, const float* volumes, psych_int64 frames, int op);
+
+// Gather 'frames' sample frames of 'dstchannels' channels from the 'srcchannels' channel
+// interleaved 'src' into interleaved 'dst', fetching target channel k from source channel
+// mappings[k] and applying 'gain'. Identity mappings take a vectorized fast path:
+void PsychPAGatherMapped(float* dst, psych_int64 dstchannels, const float* src, psych_int64 srcchannels,
+                         const int* mappings, float gain, psych_int64 frames);
+
+// Set the 'nmapped' target channels mappings[0..nmapped-1] of 'frames' sample frames in
+// 'dstchannels' channel interleaved 'dst' to 'value':
+void PsychPAFillMapped(float* dst, psych_int64 dstchannels, const int* mappings, psych_int64 nmapped,
+                       float value, psych_int64 frames);
+
+// Convert 'count' samples, starting at sample index 'offset' of 'src' with storage 'format',
+// into float samples in 'dst':
+void PsychPAConvertSamples(float* dst, const void* src, int format, psych_int64 offset, psych_int64 count);
+
+// Quantize 'count' samples from either double 'srcd' or float 'srcf' - whichever is non-NULL -
+// each multiplied by 'gain', into 'dst' with storage 'format', starting at its sample index 'offset'.
+// Integer formats are rounded to nearest and clamped to their range:
+void PsychPAStoreSamples(void* dst, int format, psych_int64 offset, const double* srcd, const float* srcf,
+                         double gain, psych_int64 count);
+
+//end include once
+#endif
@@ -0,0 +1,218 @@
+/*
+ *        PsychToolbox3/Source/Common/PsychPortAudio/PsychPANullDevice.c
+ *
+ *        PLATFORMS:        All
+ *
+ *        DESCRIPTION:
+ *
+ *        Virtual null audio device for PsychPortAudio. See PsychPANullDevice.h for details.
+ */
+
+#include "PsychPANullDevice.h"
+
+// Buffersize in sample frames if none is requested:
+#define PSYCH_PA_NULLSTREAM_BUFFERSIZE  256
+
+typedef struct PsychPANullStream {
+    PaStreamCallback*           callback;           // Stream callback, ie., paCallback() of PsychPortAudio.
+    PaStreamFinishedCallback*   finishedCallback;   // Optional callback to call when render thread exits.
+    void*                       userData;           // Passed to both callbacks.
+    PaStreamInfo                info;               // Samplerate and latencies, as returned by PsychPANullGetStreamInfo().
+    unsigned long               framesPerBuffer;    // Sample frames per callback invocation.
+    int                         inchannels;         // Capture channels, zero if none.
+    int                         outchannels;        // Playback channels, zero if none.
+    float*                      inbuffer;           // Silence fed to the callback for capture.
+    float*                      outbuffer;          // Receives rendered output samples from the callback.
+    psych_bool                  realtime;           // Pace in realtime, or render as fast as possible?
+    FILE*                       sink;               // Optional file to write output samples to.
+    psych_thread                thread;             // Render thread.
+    psych_bool                  threadRunning;      // Render thread created and not yet joined?
+    volatile psych_bool         stopped;            // Stream stopped, ie., not started or stopped via Stop/Abort?
+    volatile psych_bool         active;             // Render thread calling the callback?
+    volatile psych_bool         stopRequest;        // Request for render thread to exit.
+    volatile double             cpuLoad;            // Smoothed fraction of buffer duration spent in callback.
+} PsychPANullStream;
+
+static void* PsychPANullRenderThreadMain(void* arg)
+{
+    PsychPANullStream* s = (PsychPANullStream*) arg;
+    PaStreamCallbackTimeInfo timeInfo;
+    double bufferDuration = (double) s->framesPerBuffer / s->info.sampleRate;
+    double tStart, tVirtual, t0, t1;
+    psych_int64 frames = 0;
+    int rc = paContinue;
+
+    PsychSetThreadName("PsychPANullDev");
+
+    // The virtual clock starts at current system time, and advances by the duration of each
+    // rendered buffer. In realtime mode we wait for the system clock to catch up with it:
+    PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+    tVirtual = tStart;
+
+    while ((rc == paContinue) && !s->stopRequest) {
+        // Synthetic timestamps, with the first output sample played one output latency after
+        // the current time, and the first input sample captured one input latency before it:
+        timeInfo.currentTime = tVirtual;
+        timeInfo.outputBufferDacTime = tVirtual + s->info.outputLatency;
+        timeInfo.inputBufferAdcTime = tVirtual - s->info.inputLatency;
+
+        PsychGetAdjustedPrecisionTimerSeconds(&t0);
+        rc = s->callback(s->inbuffer, s->outbuffer, s->framesPerBuffer, &timeInfo, 0, s->userData);
+        PsychGetAdjustedPrecisionTimerSeconds(&t1);
+
+        // Lowpass filtered cpu load, like PortAudio's own cpu load measurement:
+        s->cpuLoad = 0.9 * s->cpuLoad + 0.1 * ((t1 - t0) / bufferDuration);
+
+        if (s->sink && s->outbuffer)
+            fwrite(s->outbuffer, sizeof(float) * s->outchannels, s->framesPerBuffer, s->sink);
+
+        frames += (psych_int64) s->framesPerBuffer;
+        tVirtual = tStart + (double) frames / s->info.sampleRate;
+
+        if (s->realtime) PsychWaitUntilSeconds(tVirtual);
+    }
+
+    s->active = FALSE;
+
+    if (s->finishedCallback) s->finishedCallback(s->userData);
+
+    return(NULL);
+}
+
+PaError PsychPANullOpenStream(PaStream** stream, int inchannels, int outchannels, double sampleRate,
+                              unsigned long framesPerBuffer, psych_bool realtime, const char* sinkFile,
+                              PaStreamCallback* callback, void* userData)
+{
+    PsychPANullStream* s;
+
+    *stream = NULL;
+    if ((sampleRate <= 0) || (inchannels < 0) || (outchannels < 0) || (inchannels + outchannels == 0)) return(paInvalidChannelCount);
+
+    s = (PsychPANullStream*) calloc(1, sizeof(PsychPANullStream));
+    if (NULL == s) return(paInsufficientMemory);
+
+    s->callback = callback;
+    s->userData = userData;
+    s->framesPerBuffer = (framesPerBuffer == paFramesPerBufferUnspecified) ? PSYCH_PA_NULLSTREAM_BUFFERSIZE : framesPerBuffer;
+    s->inchannels = inchannels;
+    s->outchannels = outchannels;
+    s->realtime = realtime;
+    s->stopped = TRUE;
+
+    // Behave like a double-buffered sound card: Output is played one buffer after the
+    // current buffer is done, input was captured during the last buffer:
+    s->info.structVersion = 1;
+    s->info.sampleRate = sampleRate;
+    s->info.outputLatency = (outchannels > 0) ? (double) (2 * s->framesPerBuffer) / sampleRate : 0.0;
+    s->info.inputLatency = (inchannels > 0) ? (double) s->framesPerBuffer / sampleRate : 0.0;
+
+    if (inchannels > 0) s->inbuffer = (float*) calloc(s->framesPerBuffer * inchannels, sizeof(float));
+    if (outchannels > 0) s->outbuffer = (float*) calloc(s->framesPerBuffer * outchannels, sizeof(float));
+
+    if (((inchannels > 0) && !s->inbuffer) || ((outchannels > 0) && !s->outbuffer)) {
+        PsychPANullCloseStream((PaStream*) s);
+        return(paInsufficientMemory);
+    }
+
+    if (sinkFile && (outchannels > 0)) {
+        s->sink = fopen(sinkFile, "wb");
+        if (NULL == s->sink) {
+            PsychPANullCloseStream((PaStream*) s);
+            return(paInvalidDevice);
+        }
+    }
+
+    *stream = (PaStream*) s;
+
+    return(paNoError);
+}
+
+PaError PsychPANullCloseStream(PaStream* stream)
+{
+    PsychPANullStream* s = (PsychPANullStream*) stream;
+
+    PsychPANullAbortStream(stream);
+
+    if (s->sink) fclose(s->sink);
+    free(s->inbuffer);
+    free(s->outbuffer);
+    free(s);
+
+    return(paNoError);
+}
+
+PaError PsychPANullStartStream(PaStream* stream)
+{
+    PsychPANullStream* s = (PsychPANullStream*) stream;
+
+    if (!s->stopped) return(paStreamIsNotStopped);
+
+    s->stopRequest = FALSE;
+    s->stopped = FALSE;
+    s->active = TRUE;
+    s->cpuLoad = 0.0;
+
+    if (PsychCreateThread(&(s->thread), NULL, PsychPANullRenderThreadMain, (void*) s)) {
+        s->active = FALSE;
+        s->stopped = TRUE;
+        return(paInternalError);
+    }
+
+    s->threadRunning = TRUE;
+
+    return(paNoError);
+}
+
+PaError PsychPANullStopStream(PaStream* stream)
+{
+    PsychPANullStream* s = (PsychPANullStream*) stream;
+
+    if (s->stopped) return(paStreamIsStopped);
+
+    // Nothing is buffered beyond the current callback invocation, so stopping and aborting
+    // are the same: Wait for the render thread to finish its current buffer and exit:
+    s->stopRequest = TRUE;
+    if (s->threadRunning) {
+        PsychDeleteThread(&(s->thread));
+        s->threadRunning = FALSE;
+    }
+
+    s->stopped = TRUE;
+
+    return(paNoError);
+}
+
+PaError PsychPANullAbortStream(PaStream* stream)
+{
+    return(PsychPANullStopStream(stream));
+}
+
+PaError PsychPANullIsStreamStopped(PaStream* stream)
+{
+    return((((PsychPANullStream*) stream)->stopped) ? 1 : 0);
+}
+
+PaError PsychPANullIsStreamActive(PaStream* stream)
+{
+    return((((PsychPANullStream*) stream)->active) ? 1 : 0);
+}
+
+PaError PsychPANullSetStreamFinishedCallback(PaStream* stream, PaStreamFinishedCallback* finishedCallback)
+{
+    PsychPANullStream* s = (PsychPANullStream*) stream;
+
+    if (!s->stopped) return(paStreamIsNotStopped);
+    s->finishedCallback = finishedCallback;
+
+    return(paNoError);
+}
+
+const PaStreamInfo* PsychPANullGetStreamInfo(PaStream* stream)
+{
+    return(&(((PsychPANullStream*) stream)->info));
+}
+
+double PsychPANullGetStreamCpuLoad(PaStream* stream)
+{
+    return(((PsychPANullStream*) stream)->cpuLoad);
+}
@@ -0,0 +1,51 @@
+/*
+ *        PsychToolbox3/Source/Common/PsychPortAudio/PsychPANullDevice.h
+ *
+ *        PLATFORMS:        All
+ *
+ *        DESCRIPTION:
+ *
+ *        Virtual null audio device for PsychPortAudio: A stand-in for a PortAudio stream which
+ *        doesn't talk to any sound hardware. Instead, a render thread calls the regular stream
+ *        callback of PsychPortAudio with synthetic timestamps from a virtual clock, feeds it with
+ *        silent input samples, and either discards the rendered output samples, or writes them
+ *        into a raw 32 bit float sample file.
+ *
+ *        The render thread either paces itself in realtime, like a real sound card would, or
+ *        renders as fast as possible, advancing the virtual clock by the duration of each
+ *        rendered buffer. The latter allows offline rendering of sound, and benchmarking of the
+ *        cost of the audio callback independent of sound hardware and drivers.
+ *
+ *        The functions mirror their PortAudio counterparts, so PsychPortAudio can dispatch
+ *        stream operations to either implementation, depending on whether the device was opened
+ *        as null device.
+ */
+
+//begin include once
+#ifndef PSYCH_IS_INCLUDED_PsychPANullDevice
+#define PSYCH_IS_INCLUDED_PsychPANullDevice
+
+#include "Psych.h"
+#include "portaudio.h"
+
+// Open a null device stream with 'inchannels' capture and 'outchannels' playback channels,
+// running at 'sampleRate' Hz and calling 'callback' with 'userData' for every 'framesPerBuffer'
+// sample frames. 'realtime' selects realtime pacing, otherwise the stream renders as fast as
+// possible. If 'sinkFile' is non-NULL, rendered output samples are written into that file:
+PaError PsychPANullOpenStream(PaStream** stream, int inchannels, int outchannels, double sampleRate,
+                              unsigned long framesPerBuffer, psych_bool realtime, const char* sinkFile,
+                              PaStreamCallback* callback, void* userData);
+
+// Counterparts to Pa_CloseStream() et al.:
+PaError PsychPANullCloseStream(PaStream* stream);
+PaError PsychPANullStartStream(PaStream* stream);
+PaError PsychPANullStopStream(PaStream* stream);
+PaError PsychPANullAbortStream(PaStream* stream);
+PaError PsychPANullIsStreamStopped(PaStream* stream);
+PaError PsychPANullIsStreamActive(PaStream* stream);
+PaError PsychPANullSetStreamFinishedCallback(PaStream* stream, PaStreamFinishedCallback* finishedCallback);
+const PaStreamInfo* PsychPANullGetStreamInfo(PaStream* stream);
+double PsychPANullGetStreamCpuLoad(PaStream* stream);
+
+//end include once
+#endif
@@ -22,6 +22,16 @@
  */
 
 #include "PsychPortAudio.h"
+#include "PsychPAMixKernels.h"
+#include "PsychPAFileBuffer.h"
+#include "PsychPANullDevice.h"
+#include "PsychPADSP.h"
+
+// Zero-copy adoption of sound data needs the Python buffer protocol, which is only part of the
+// limited Python api since Python 3.11:
+#if (PSYCH_LANGUAGE == PSYCH_PYTHON) && (!defined(Py_LIMITED_API) || (Py_LIMITED_API >= 0x030b0000))
+#define PSYCH_PA_ZEROCOPY 1
+#endif
 
 static unsigned int verbosity = 4;
 
@@ -127,6 +137,9 @@ static const char *synopsisSYNOPSIS[MAX_SYNOPSIS_STRINGS];
 // Maximum number of attached slave devices we support per open master device:
 #define MAX_PSYCH_AUDIO_SLAVES_PER_DEVICE 1024
 
+// Maximum number of worker threads for parallel rendering of slaves per master device:
+#define MAX_PSYCH_AUDIO_SLAVE_WORKERS 64
+
 // Initial size (and increment) of audio buffer list. List will grow by that
 // many slots whenever it needs to grow:
 #define PSYCH_AUDIO_BUFFERLIST_INCREMENT 1024
@@ -149,6 +162,55 @@ static const char *synopsisSYNOPSIS[MAX_SYNOPSIS_STRINGS];
 // mutex lock hold times for low-level debugging and tuning:
 //#define MUTEX_LOCK_TIME_STATS 1
 
+// Number of bins of the paCallback lock wait and execution time histograms. Bin 0 counts
+// durations below 1 usec, bin i counts durations of 2^(i-1) to 2^i usecs, the last bin
+// counts all durations of 2^(bins-2) usecs or more:
+#define PSYCH_PA_TIMING_HISTOGRAM_BINS 16
+
+// Capacity of the per-device lock-free command queue in commands. Must be a power of two:
+#define PSYCH_PA_CMDQUEUE_SIZE 512
+
+// Readahead of file-backed audio buffers: How many seconds of sound ahead of the current playback
+// position to keep resident in memory, and how often the prefetch thread updates its hints:
+#define PSYCH_PA_PREFETCH_SECS      2.0
+#define PSYCH_PA_PREFETCH_INTERVAL  0.020
+
+// Number of samples converted per step when playing buffers with compact sample formats:
+#define PSYCH_PA_CONVERT_BLOCK 1024
+
+// Number of sample frames per step when resampling the output of slaves with their own samplerate:
+#define PSYCH_PA_SRC_CHUNK 1024
+
+// Special 'deviceid' for 'Open' to select the virtual null device, and the host api type id
+// we assign to such devices. No real PortAudio backend ever has that type:
+#define kPsychPANullDeviceId        -2
+#define kPsychPANullHostAPI         paInDevelopment
+
+// Stream operations on the stream of device 'dev', dispatched to either the null device or to PortAudio:
+#define PsychPAStartStream(dev)         ((dev)->isNullDevice ? PsychPANullStartStream((dev)->stream) : Pa_StartStream((dev)->stream))
+#define PsychPAStopStream(dev)          ((dev)->isNullDevice ? PsychPANullStopStream((dev)->stream) : Pa_StopStream((dev)->stream))
+#define PsychPAAbortStream(dev)         ((dev)->isNullDevice ? PsychPANullAbortStream((dev)->stream) : Pa_AbortStream((dev)->stream))
+#define PsychPACloseStreamHandle(dev)   ((dev)->isNullDevice ? PsychPANullCloseStream((dev)->stream) : Pa_CloseStream((dev)->stream))
+#define PsychPAIsStreamActive(dev)      ((dev)->isNullDevice ? PsychPANullIsStreamActive((dev)->stream) : Pa_IsStreamActive((dev)->stream))
+#define PsychPAIsStreamStopped(dev)     ((dev)->isNullDevice ? PsychPANullIsStreamStopped((dev)->stream) : Pa_IsStreamStopped((dev)->stream))
+#define PsychPAGetStreamInfo(dev)       ((dev)->isNullDevice ? PsychPANullGetStreamInfo((dev)->stream) : Pa_GetStreamInfo((dev)->stream))
+#define PsychPAGetStreamCpuLoad(dev)    ((dev)->isNullDevice ? PsychPANullGetStreamCpuLoad((dev)->stream) : Pa_GetStreamCpuLoad((dev)->stream))
+#define PsychPASetStreamFinishedCallback(dev, cb) ((dev)->isNullDevice ? PsychPANullSetStreamFinishedCallback((dev)->stream, cb) : Pa_SetStreamFinishedCallback((dev)->stream, cb))
+
+// Commands for the lock-free command queue:
+#define kPsychPACmdChannelVolume    1   // Set outChannelVolumes[arg] = value1.
+#define kPsychPACmdLoop             2   // Set loopStartFrame = value1, loopEndFrame = value2.
+#define kPsychPACmdRepetitions      3   // Set repeatCount = value1.
+#define kPsychPACmdStopTime         4   // Set reqStopTime = value1.
+#define kPsychPACmdReqState         5   // Set reqstate = arg, if device is active.
+
+typedef struct PsychPACommand {
+    int             cmd;                    // Command code kPsychPACmdXXX.
+    int             arg;                    // Integer argument.
+    double          value1;                 // First value argument.
+    double          value2;                 // Second value argument.
+} PsychPACommand;
+
 typedef struct PsychPASchedule {
     unsigned int    mode;                   // Mode of schedule slot: 0 = Invalid slot, > 0 valid slot, where different bits in the int mean something...
     double          repetitions;            // Number of repetitions for the playloop defined in this slot.
@@ -170,6 +232,7 @@ typedef struct PsychPADevice {
     PaStream *stream;                       // Pointer to associated portaudio stream.
     const PaStreamInfo*     streaminfo;     // Pointer to stream info structure, provided by PortAudio.
     PaHostApiTypeId         hostAPI;        // Type of host API.
+    psych_bool              isNullDevice;   // Is 'stream' a virtual null device stream, instead of a PortAudio stream?
     int                     indeviceidx;    // Device index of capture device. -1 if none open.
     int                     outdeviceidx;   // Device index of output device. -1 if none open.
     volatile double         reqStartTime;   // Requested start time in system time (secs).
@@ -225,6 +288,7 @@ typedef struct PsychPADevice {
     float*    slaveInBuffer;        // Temporary input buffer for slaves to receive their input data. Used as output from distributor. NULL on non-masters.
     float*    slaveGainBuffer;      // Temporary output buffer for AM modulator slaves to store their gain output data. NULL on non AMModulators for slaves.
     int    modulatorSlave;          // pahandle of a slave device that acts as a modulator for this device. -1 if none assigned.
+    struct PsychPASlaveWorkerPool* slaveWorkers; // Worker thread pool for parallel rendering of slaves. NULL on non-masters or for serial rendering.
     double    firstsampleonset;     // Cached sample onset time from paCallback.
     double    cst;                  // Cached captured sample onset time from paCallback.
     double    now;                  // Cached invocation time from paCallback.
@@ -232,6 +296,36 @@ typedef struct PsychPADevice {
     // Mixer volume related:
     float*    outChannelVolumes;    // Array of per-outputchannel volume settings on slave devices, NULL and not used on non-slave devices.
     float    masterVolume;          // Master volume setting for all non-slave audio devices, i.e., masters and regular devices. Unused on slaves.
+
+    // Lock-free command queue related:
+    PsychPACommand* cmdQueue;       // Single-producer single-consumer ring of commands from the interpreter thread to paCallback. NULL if disabled.
+    volatile psych_uint64 cmdHead;  // Index of next command to apply. Only advanced by the consumer.
+    volatile psych_uint64 cmdTail;  // Index after last committed command. Only advanced by the producer.
+    psych_uint64 cmdPending;        // Index after last posted, but not yet committed command. Only used by the producer.
+
+    // paCallback timing statistics. Only written by paCallback:
+    volatile psych_uint64 statsResetRequest; // Incremented by the interpreter thread to request a reset of the statistics.
+    psych_uint64 statsResetDone;    // Value of statsResetRequest at last reset by paCallback.
+    psych_uint64 lockMisses;        // Number of buffers skipped, because the device mutex was busy in command queue mode.
+    psych_uint64 lockMissFrames;    // Number of sample frames of these skipped buffers.
+    psych_int64 skipFrames;         // Sample frames skipped since the last processed buffer, which playback still has to advance over.
+    double    maxLockWait;          // Worst-case time spent waiting for the device mutex in paCallback.
+    double    maxExecTime;          // Worst-case execution time of paCallback.
+    psych_uint64 lockWaitHistogram[PSYCH_PA_TIMING_HISTOGRAM_BINS]; // Histogram of mutex wait times.
+    psych_uint64 execTimeHistogram[PSYCH_PA_TIMING_HISTOGRAM_BINS]; // Histogram of execution times.
+
+    // Readahead hints for file-backed buffers, written by paCallback, read by the prefetch thread:
+    const float* volatile prefetchPos;      // Next samples to play in current playloop.
+    volatile psych_int64  prefetchCount;    // Number of samples to prefetch from prefetchPos.
+    const float* volatile prefetchWrapPos;  // Start of current playloop, for samples to play after wraparound.
+    volatile psych_int64  prefetchWrapCount;// Number of samples to prefetch from prefetchWrapPos.
+
+    // Realtime signal processing:
+    PsychPADSPStage* volatile dspChain;     // Insert chain of filters to apply to the sound output of this device. NULL if none.
+    PsychPADSPStage* volatile dspChainInUse;// Chain currently processed by the audio thread, NULL if none. Protects it against release.
+    PsychPAResampler* resampler;    // Sample rate converter from slave rate to master rate on slaves with own samplerate. NULL otherwise.
+    PaStreamInfo resampledStreamInfo;   // Stream info with own samplerate of such slaves. 'streaminfo' points to it if resampler is in use.
+    double    resampledOnset;       // Onset time of the first sample frame passed to the paCallback of such slaves, computed by the master.
 } PsychPADevice;
 
 PsychPADevice audiodevices[MAX_PSYCH_AUDIO_DEVS];
@@ -242,6 +336,12 @@ psych_bool    lockToCore1 = TRUE;               // NO LONGER USED: Lock all engi
 psych_bool    pulseaudio_autosuspend = TRUE;    // Should we try to suspend the Pulseaudio sound server on Linux while we're active?
 psych_bool    pulseaudio_isSuspended = FALSE;   // Is PulseAudio suspended by us?
 unsigned int  workaroundsMask = 0;              // Bitmask of enabled workarounds.
+int           mixKernelsRequest = kPsychPAMixKernelsAuto; // Requested implementation of sample mixing kernels. Auto-select by default.
+int           slaveWorkerThreads = 0;           // Number of worker threads for parallel rendering of slaves on new master devices. 0 = Serial rendering.
+psych_bool    useCommandQueue = FALSE;          // Use lock-free command queues for state changes on new devices?
+volatile int  fileBufferCount = 0;              // Number of existing file-backed audio buffers.
+psych_thread  prefetchThread;                   // Readahead thread for file-backed audio buffers.
+volatile psych_bool prefetchThreadRunning = FALSE; // Is the readahead thread running? Cleared to ask it to exit.
 
 double debugdummy1, debugdummy2;
 
@@ -259,10 +359,32 @@ struct PsychPABuffer_Struct {
     float*     outputbuffer;        // Pointer to float memory buffer with sound output data.
     psych_int64 outputbuffersize;   // Size of output buffer in bytes.
     psych_int64 outchannels;        // Number of channels.
+    PsychPAFileMapping* mapping;    // Read-only mapping of the sound file backing outputbuffer, or NULL for buffers in regular memory.
+    int         format;             // Sample storage format kPsychPASampleXXX of outputbuffer. outputbuffer is only a float* for kPsychPASampleFloat32.
+    void*       owner;              // Runtime owned memory adopted as outputbuffer without copy, or NULL. Released on buffer deletion.
 };
 
 typedef struct PsychPABuffer_Struct PsychPABuffer;
 
+// Atomic operations on 64 bit counters shared between the interpreter thread, paCallback and slave worker threads:
+#if defined(_MSC_VER)
+#define PsychPAAtomicFetchAdd(p, v) InterlockedExchangeAdd64((volatile LONG64*) (p), (LONG64) (v))
+#define PsychPAAtomicStore(p, v)    InterlockedExchange64((volatile LONG64*) (p), (LONG64) (v))
+#define PsychPAAtomicLoad(p)        InterlockedCompareExchange64((volatile LONG64*) (p), 0, 0)
+#define PsychPAAtomicCAS(p, o, n)   (InterlockedCompareExchange64((volatile LONG64*) (p), (LONG64) (n), (LONG64) (o)) == (LONG64) (o))
+#define PsychPAAtomicExchangePtr(p, v)  InterlockedExchangePointer((PVOID volatile*) (p), (PVOID) (v))
+#define PsychPAAtomicStorePtr(p, v)     InterlockedExchangePointer((PVOID volatile*) (p), (PVOID) (v))
+#define PsychPAAtomicLoadPtr(p)         InterlockedCompareExchangePointer((PVOID volatile*) (p), NULL, NULL)
+#else
+#define PsychPAAtomicFetchAdd(p, v) __atomic_fetch_add((p), (v), __ATOMIC_SEQ_CST)
+#define PsychPAAtomicStore(p, v)    __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define PsychPAAtomicLoad(p)        __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define PsychPAAtomicCAS(p, o, n)   __sync_bool_compare_and_swap((p), (o), (n))
+#define PsychPAAtomicExchangePtr(p, v)  __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#define PsychPAAtomicStorePtr(p, v)     __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define PsychPAAtomicLoadPtr(p)         __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#endif
+
 psych_mutex    bufferListmutex;            // Mutex lock for the audio bufferList.
 PsychPABuffer*  bufferList;                // Pointer to start of audio bufferList.
 int    bufferListCount;                    // Number of slots allocated in bufferList.
@@ -310,10 +432,9 @@ psych_bool PsychPAInvalidateBufferReferences(int handle)
     return(anylocked);
 }
 
-// Create a new audiobuffer for 'outchannels' audio channels and 'nrFrames' samples
-// per channel. Init header, allocate zero-filled memory, enqeue in bufferList.
-// Resize/Grow bufferList if neccessary. Return handle to buffer.
-int PsychPACreateAudioBuffer(psych_int64 outchannels, psych_int64 nrFrames)
+// Find a free slot in the bufferList for a new audiobuffer. Resize/Grow bufferList
+// if neccessary. Return handle to the slot.
+static int PsychPAGetFreeBufferSlot(void)
 {
     PsychPABuffer* tmpptr;
     int i, handle;
@@ -369,9 +490,20 @@ int PsychPACreateAudioBuffer(psych_int64 outchannels, psych_int64 nrFrames)
     // Invalidate all potential stale references to the new 'handle' in all schedules:
     PsychPAInvalidateBufferReferences(handle);
 
+    return(handle);
+}
+
+// Create a new audiobuffer for 'outchannels' audio channels and 'nrFrames' samples
+// per channel, stored in sample 'format'. Init header, allocate zero-filled memory,
+// enqeue in bufferList. Return handle to buffer.
+int PsychPACreateAudioBuffer(psych_int64 outchannels, psych_int64 nrFrames, int format)
+{
+    int handle = PsychPAGetFreeBufferSlot();
+
     // Allocate actual data buffer:
-    bufferList[handle].outputbuffersize = outchannels * nrFrames * sizeof(float);
+    bufferList[handle].outputbuffersize = outchannels * nrFrames * PsychPASampleFormatBytes(format);
     bufferList[handle].outchannels = outchannels;
+    bufferList[handle].format = format;
 
     if (NULL == ( bufferList[handle].outputbuffer = (float*) calloc(1, (size_t) bufferList[handle].outputbuffersize) )) {
         // Out of memory: Release bufferList header and error out:
@@ -382,6 +514,185 @@ int PsychPACreateAudioBuffer(psych_int64 outchannels, psych_int64 nrFrames)
     return(handle);
 }
 
+// Readahead thread for file-backed audio buffers: Periodically asks the os to page in the
+// sound data ahead of the current playback position of all active devices, as published by
+// paCallback. Doesn't take any locks: The hints are harmless even if they are stale.
+static void* PsychPAPrefetchThreadMain(void* arg)
+{
+    PsychPADevice* dev;
+    int i;
+
+    (void) arg;
+    PsychSetThreadName("PsychPAPrefetch");
+
+    while (prefetchThreadRunning) {
+        for (i = 0; i < MAX_PSYCH_AUDIO_DEVS; i++) {
+            dev = &audiodevices[i];
+            if ((NULL == dev->stream) || (dev->state == 0)) continue;
+
+            PsychPAPrefetchSamples(dev->prefetchPos, dev->prefetchCount);
+            PsychPAPrefetchSamples(dev->prefetchWrapPos, dev->prefetchWrapCount);
+        }
+
+        PsychYieldIntervalSeconds(PSYCH_PA_PREFETCH_INTERVAL);
+    }
+
+    return(NULL);
+}
+
+static void PsychPAStopPrefetchThread(void)
+{
+    if (!prefetchThreadRunning) return;
+
+    prefetchThreadRunning = FALSE;
+    PsychDeleteThread(&prefetchThread);
+}
+
+#ifdef PSYCH_PA_ZEROCOPY
+// Get a reference to the sample memory of the Python object in argument 'position' without copying
+// it, via the Python buffer protocol, e.g., of a NumPy array. The memory must be a C-contiguous array
+// of frames x channels, or a 1D single channel array, of float32, int16 or float16 samples. Returns the
+// Py_buffer which holds the reference, and the sample format, channel count and frame count:
+static Py_buffer* PsychPAGetPythonSampleBuffer(int position, int* format, psych_int64* channels, psych_int64* frames)
+{
+    PyObject* obj = (PyObject*) PsychGetInArgPyPtr(position);
+    Py_buffer* view;
+    const char* fmt;
+
+    view = (Py_buffer*) calloc(1, sizeof(Py_buffer));
+    if (NULL == view) PsychErrorExitMsg(PsychError_outofMemory, "Insufficient free memory for allocating new zero-copy audio buffer!");
+
+    if ((NULL == obj) || PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)) {
+        PyErr_Clear();
+        free(view);
+        PsychErrorExitMsg(PsychError_user, "Zero-copy 'bufferdata' must be a C-contiguous array which supports the Python buffer protocol, e.g., a NumPy array.");
+        return(NULL);
+    }
+
+    // Only native byte order is supported, which is little-endian on all our platforms:
+    fmt = (view->format) ? view->format : "B";
+    if ((*fmt == '<') || (*fmt == '=') || (*fmt == '@')) fmt++;
+
+    *format = -1;
+    if (!strcmp(fmt, "f") && (view->itemsize == 4)) *format = kPsychPASampleFloat32;
+    if (!strcmp(fmt, "h") && (view->itemsize == 2)) *format = kPsychPASampleInt16;
+    if (!strcmp(fmt, "e") && (view->itemsize == 2)) *format = kPsychPASampleFloat16;
+
+    if ((*format < 0) || (view->ndim < 1) || (view->ndim > 2) || ((size_t) view->buf % (size_t) view->itemsize)) {
+        PyBuffer_Release(view);
+        free(view);
+        PsychErrorExitMsg(PsychError_user, "Zero-copy 'bufferdata' must be a 1D or 2D array of aligned float32, int16 or float16 samples in native byte order.");
+        return(NULL);
+    }
+
+    *frames = (psych_int64) view->shape[0];
+    *channels = (view->ndim == 2) ? (psych_int64) view->shape[1] : 1;
+
+    return(view);
+}
+#endif
+
+// Create a new file-backed audiobuffer from sound file 'filename', by mapping the file read-only
+// into memory. Raw sample files have 'rawChannels' channels. If 'sampleRate' is non-zero, a WAV
+// file must have that sample rate. Return handle to buffer.
+int PsychPACreateFileAudioBuffer(const char* filename, psych_int64 rawChannels, double sampleRate)
+{
+    PsychPAFileMapping* mapping;
+    const char* errmsg;
+    float* samples;
+    psych_int64 channels, frames;
+    double fileRate;
+    int handle, rc;
+
+    mapping = (PsychPAFileMapping*) calloc(1, sizeof(PsychPAFileMapping));
+    if (NULL == mapping) PsychErrorExitMsg(PsychError_outofMemory, "Insufficient free memory for allocating new file-backed audio buffer!");
+
+    if ((errmsg = PsychPAMapSoundFile(filename, rawChannels, mapping, &samples, &channels, &frames, &fileRate))) {
+        free(mapping);
+        printf("PTB-ERROR: Failed to map sound file '%s' for file-backed audio buffer: %s\n", filename, errmsg);
+        PsychErrorExitMsg(PsychError_user, "Could not create file-backed audio buffer from given sound file.");
+    }
+
+    if ((sampleRate > 0) && (fileRate > 0) && (fileRate != sampleRate)) {
+        PsychPAUnmapSoundFile(mapping);
+        free(mapping);
+        printf("PTB-ERROR: Sound file '%s' has a sample rate of %f Hz, but audio device runs at %f Hz.\n", filename, fileRate, sampleRate);
+        PsychErrorExitMsg(PsychError_user, "Sample rate of sound file doesn't match sample rate of selected audio device.");
+    }
+
+    if ((rawChannels > 0) && (channels != rawChannels)) {
+        PsychPAUnmapSoundFile(mapping);
+        free(mapping);
+        printf("PTB-ERROR: Audio device has %i output channels, but sound file '%s' has non-matching number of %i channels.\n", (int) rawChannels, filename, (int) channels);
+        PsychErrorExitMsg(PsychError_user, "Number of channels of sound file doesn't match number of output channels of selected audio device.");
+    }
+
+    handle = PsychPAGetFreeBufferSlot();
+    bufferList[handle].outputbuffer = samples;
+    bufferList[handle].outputbuffersize = channels * frames * sizeof(float);
+    bufferList[handle].outchannels = channels;
+    bufferList[handle].format = kPsychPASampleFloat32;
+    bufferList[handle].mapping = mapping;
+    fileBufferCount++;
+
+    // Start readahead thread on first use:
+    if (!prefetchThreadRunning) {
+        prefetchThreadRunning = TRUE;
+        if ((rc = PsychCreateThread(&prefetchThread, NULL, PsychPAPrefetchThreadMain, NULL))) {
+            prefetchThreadRunning = FALSE;
+            if (verbosity > 1) printf("PsychPortAudio-WARNING: Failed to create readahead thread for file-backed audio buffers [%s]. Playback may glitch on slow disks.\n", strerror(rc));
+        }
+    }
+
+    return(handle);
+}
+
+// Release the sample memory of an audiobuffer, or the file mapping if it is a file-backed buffer:
+static void PsychPAReleaseAudioBufferData(PsychPABuffer* buffer)
+{
+    if (buffer->mapping) {
+        PsychPAUnmapSoundFile(buffer->mapping);
+        free(buffer->mapping);
+        buffer->mapping = NULL;
+        fileBufferCount--;
+    }
+    else if (buffer->owner) {
+        // Drop our reference to adopted runtime memory, so the runtime can free it:
+        #ifdef PSYCH_PA_ZEROCOPY
+        PyBuffer_Release((Py_buffer*) buffer->owner);
+        #endif
+        free(buffer->owner);
+        buffer->owner = NULL;
+    }
+    else if (NULL != buffer->outputbuffer) {
+        free(buffer->outputbuffer);
+    }
+
+    buffer->outputbuffer = NULL;
+}
+
+// Return number of samples in audiobuffer 'buffer':
+static psych_int64 PsychPAGetAudioBufferSampleCount(PsychPABuffer* buffer)
+{
+    return(buffer->outputbuffersize / PsychPASampleFormatBytes(buffer->format));
+}
+
+// Return float samples of audiobuffer 'buffer'. Buffers with compact sample formats get converted
+// into a temporary float array, which is auto-released at the end of the current module call:
+static float* PsychPAGetAudioBufferFloatSamples(PsychPABuffer* buffer)
+{
+    float* samples;
+    psych_int64 count;
+
+    if (buffer->format == kPsychPASampleFloat32) return(buffer->outputbuffer);
+
+    count = PsychPAGetAudioBufferSampleCount(buffer);
+    samples = (float*) PsychMallocTemp((size_t) count * sizeof(float));
+    PsychPAConvertSamples(samples, buffer->outputbuffer, buffer->format, 0, count);
+
+    return(samples);
+}
+
 // Delete all audio buffers and bufferList itself: Called during shutdown.
 void PsychPADeleteAllAudioBuffers(void)
 {
@@ -395,9 +706,7 @@ void PsychPADeleteAllAudioBuffers(void)
         PsychPAInvalidateBufferReferences(-1);
 
         // Free all audio buffers:
-        for (i = 0; i < bufferListCount; i++) {
-            if (NULL != bufferList[i].outputbuffer) free(bufferList[i].outputbuffer);
-        }
+        for (i = 0; i < bufferListCount; i++) PsychPAReleaseAudioBufferData(&(bufferList[i]));
 
         // Release memory for bufferheader array itself:
         free(bufferList);
@@ -437,7 +746,7 @@ psych_bool PsychPAUpdateBufferReferences(void)
         // Device open?
         if (audiodevices[i].stream) {
             // Schedule attached and device active?
-            if ((audiodevices[i].schedule) && ((audiodevices[i].state > 0) && Pa_IsStreamActive(audiodevices[i].stream))) {
+            if ((audiodevices[i].schedule) && ((audiodevices[i].state > 0) && PsychPAIsStreamActive(&audiodevices[i]))) {
                 // Active schedule. Scan it and mark all referenced buffers as locked:
                 for (j = 0; j < audiodevices[i].schedule_size; j++) {
                     // Slot active and with valid bufferhandle?
@@ -477,7 +786,7 @@ int PsychPADeleteAudioBuffer(int handle, int waitmode)
     }
 
     // Delete buffer:
-    if (NULL != buffer->outputbuffer) free(buffer->outputbuffer);
+    PsychPAReleaseAudioBufferData(buffer);
     memset(buffer, 0, sizeof(PsychPABuffer));
 
     // Success:
@@ -498,6 +807,16 @@ static void PsychPALockDeviceMutex(PsychPADevice* dev)
     }
 }
 
+// Try to lock the device mutex without blocking. Returns TRUE if the lock was acquired:
+static psych_bool PsychPATryLockDeviceMutex(PsychPADevice* dev)
+{
+    #ifdef MUTEX_LOCK_TIME_STATS
+    PsychGetAdjustedPrecisionTimerSeconds(&debugdummy1);
+    #endif
+
+    return((!uselocking || (PsychTryLockMutex(&(dev->mutex)) == 0)) ? TRUE : FALSE);
+}
+
 static void PsychPAUnlockDeviceMutex(PsychPADevice* dev)
 {
     if (uselocking) {
@@ -545,6 +864,123 @@ static void PsychPAWaitForChange(PsychPADevice* dev)
     }
 }
 
+// Lock-free command queue:
+//
+// If enabled via 'EngineTunables', some frequent state changes by the interpreter thread, e.g., volume,
+// playloop and asynchronous stop requests, are posted into a per-device single-producer single-consumer
+// ring of commands, instead of grabbing the device mutex to apply them directly. The paCallback applies
+// all committed commands at the start of each buffer, so it doesn't contend with the interpreter thread
+// for the device mutex. The interpreter thread is the only producer. Consumers are the paCallback, or the
+// interpreter thread itself while holding the device mutex, so there is only one consumer at a time.
+
+// Post command to the queue of 'dev', but don't make it visible to the consumer yet. Returns FALSE if the queue is full:
+static psych_bool PsychPAPostCommand(PsychPADevice* dev, int cmd, int arg, double value1, double value2)
+{
+    PsychPACommand* slot;
+
+    if (dev->cmdPending - PsychPAAtomicLoad(&dev->cmdHead) >= PSYCH_PA_CMDQUEUE_SIZE) return(FALSE);
+
+    slot = &(dev->cmdQueue[dev->cmdPending & (PSYCH_PA_CMDQUEUE_SIZE - 1)]);
+    slot->cmd = cmd;
+    slot->arg = arg;
+    slot->value1 = value1;
+    slot->value2 = value2;
+    dev->cmdPending++;
+
+    return(TRUE);
+}
+
+// Commit all posted commands to the consumer in one atomic step if 'commit' is TRUE, otherwise discard them. Returns 'commit':
+static psych_bool PsychPACommitCommands(PsychPADevice* dev, psych_bool commit)
+{
+    if (commit)
+        PsychPAAtomicStore(&dev->cmdTail, dev->cmdPending);
+    else
+        dev->cmdPending = dev->cmdTail;
+
+    return(commit);
+}
+
+// Apply all committed commands of 'dev'. Called by paCallback or with device mutex held:
+static void PsychPAApplyCommands(PsychPADevice* dev)
+{
+    PsychPACommand* cmd;
+    psych_uint64 head, tail;
+
+    if (NULL == dev->cmdQueue) return;
+
+    tail = PsychPAAtomicLoad(&dev->cmdTail);
+    for (head = dev->cmdHead; head != tail; head++) {
+        cmd = &(dev->cmdQueue[head & (PSYCH_PA_CMDQUEUE_SIZE - 1)]);
+        switch (cmd->cmd) {
+            case kPsychPACmdChannelVolume:
+                dev->outChannelVolumes[cmd->arg] = (float) cmd->value1;
+                break;
+
+            case kPsychPACmdLoop:
+                dev->loopStartFrame = (psych_int64) cmd->value1;
+                dev->loopEndFrame = (psych_int64) cmd->value2;
+                break;
+
+            case kPsychPACmdRepetitions:
+                dev->repeatCount = cmd->value1;
+                break;
+
+            case kPsychPACmdStopTime:
+                dev->reqStopTime = cmd->value1;
+                break;
+
+            case kPsychPACmdReqState:
+                if (dev->state > 0) dev->reqstate = (unsigned int) cmd->arg;
+                break;
+        }
+    }
+
+    // Release consumed slots to the producer:
+    PsychPAAtomicStore(&dev->cmdHead, tail);
+}
+
+// Shall state changes on 'dev' be sent via the command queue? Only if the queue is enabled
+// and the device is active, so the paCallback will consume the commands soon:
+static psych_bool PsychPAUseCommandQueue(PsychPADevice* dev)
+{
+    return((dev->cmdQueue != NULL) && (dev->state > 0));
+}
+
+// Reset paCallback timing statistics of 'dev'. Only safe if paCallback of 'dev' is not running,
+// otherwise use PsychPARequestCallbackStatsReset():
+static void PsychPAResetCallbackStats(PsychPADevice* dev)
+{
+    dev->statsResetDone = PsychPAAtomicLoad(&dev->statsResetRequest);
+    dev->lockMisses = 0;
+    dev->lockMissFrames = 0;
+    dev->maxLockWait = 0;
+    dev->maxExecTime = 0;
+    memset(dev->lockWaitHistogram, 0, sizeof(dev->lockWaitHistogram));
+    memset(dev->execTimeHistogram, 0, sizeof(dev->execTimeHistogram));
+}
+
+// Request reset of paCallback timing statistics of 'dev' from the interpreter thread. The reset
+// is done by paCallback itself at its next invocation, so it doesn't race with statistics updates:
+static void PsychPARequestCallbackStatsReset(PsychPADevice* dev)
+{
+    PsychPAAtomicFetchAdd(&dev->statsResetRequest, 1);
+}
+
+// Map a duration in seconds to its timing histogram bin:
+static int PsychPATimingHistogramBin(double duration)
+{
+    int bin = 0;
+
+    duration *= 1e6;
+    while ((duration >= 1.0) && (bin < PSYCH_PA_TIMING_HISTOGRAM_BINS - 1)) {
+        duration *= 0.5;
+        bin++;
+    }
+
+    return(bin);
+}
+
 // Callback function which gets called when a portaudio stream (aka our engine) goes idle for any reason:
 // This will reset the device state to "idle/stopped" aka 0, reset pending stop requests and signal
 // the master thread if it is waiting for this to happen:
@@ -602,7 +1038,7 @@ void PALogger(const char* msg)
 // 4 = Abort bufferfill operation for this host audio buffer via zerofill, but don't switch to idle mode / don't stop engine.
 //     Instead switch back to hot-standby so playback can be picked up again at a later point in time.
 //       This is used to reschedule start of playback for a following slot at a later time.
-int PsychPAProcessSchedule(PsychPADevice* dev, psych_int64 *playposition, float** ret_playoutbuffer, psych_int64* ret_outsbsize, psych_int64* ret_outsboffset, double* ret_repeatCount, psych_int64* ret_playpositionlimit)
+int PsychPAProcessSchedule(PsychPADevice* dev, psych_int64 *playposition, void** ret_playoutbuffer, int* ret_playoutformat, psych_int64* ret_outsbsize, psych_int64* ret_outsboffset, double* ret_repeatCount, psych_int64* ret_playpositionlimit)
 {
     psych_int64     loopStartFrame, loopEndFrame;
     psych_int64     outsbsize, outsboffset;
@@ -616,6 +1052,7 @@ int PsychPAProcessSchedule(PsychPADevice* dev, psych_int64 *playposition, float*
     if (dev->schedule == NULL) {
         // Yes: Assign settings from dev-struct:
         *ret_playoutbuffer = dev->outputbuffer;
+        *ret_playoutformat = kPsychPASampleFloat32;
         outsbsize = dev->outputbuffersize / sizeof(float);
 
         // Fetch boundaries of playback loop:
@@ -711,6 +1148,7 @@ int PsychPAProcessSchedule(PsychPADevice* dev, psych_int64 *playposition, float*
             else if (dev->schedule[slotid].bufferhandle <= 0) {
                 // Default device playoutbuffer:
                 *ret_playoutbuffer = dev->outputbuffer;
+                *ret_playoutformat = kPsychPASampleFloat32;
                 outsbsize = dev->outputbuffersize / sizeof(float);
             }
             else
@@ -721,11 +1159,12 @@ int PsychPAProcessSchedule(PsychPADevice* dev, psych_int64 *playposition, float*
                 PsychLockMutex(&bufferListmutex);
 
                 if (bufferList && (dev->schedule[slotid].bufferhandle < bufferListCount)) {
-                    // Fetch pointer to actual audio data buffer:
+                    // Fetch pointer to actual audio data buffer and its sample format:
                     *ret_playoutbuffer = bufferList[dev->schedule[slotid].bufferhandle].outputbuffer;
+                    *ret_playoutformat = bufferList[dev->schedule[slotid].bufferhandle].format;
 
                     // Retrieve buffersize in samples:
-                    outsbsize = bufferList[dev->schedule[slotid].bufferhandle].outputbuffersize / sizeof(float);
+                    outsbsize = bufferList[dev->schedule[slotid].bufferhandle].outputbuffersize / PsychPASampleFormatBytes(*ret_playoutformat);
 
                     // Another child protection:
                     if (outchannels != bufferList[dev->schedule[slotid].bufferhandle].outchannels) {
@@ -791,7 +1230,499 @@ int PsychPAProcessSchedule(PsychPADevice* dev, psych_int64 *playposition, float*
     return(0);
 }
 
-/* paCallback: PortAudo I/O processing callback.
+// Called exclusively from paCallback: Return the number of samples that can be emitted
+// in one go during playback, without exceeding the 'remaining' capacity of the hosts output
+// buffer, the 'untilStop' sample count until a requested stop time, the 'untilLimit' sample
+// count until end of all repetitions of the playloop (unless repeatCount is infinite), or the
+// 'untilWrap' sample count until wraparound at the end of the current playloop:
+static psych_int64 PsychPAPlayoutChunkSize(psych_int64 remaining, psych_int64 untilStop, double repeatCount, psych_int64 untilLimit, psych_int64 untilWrap)
+{
+    psych_int64 chunk = remaining;
+
+    if (chunk > untilStop) chunk = untilStop;
+    if ((repeatCount != -1) && (chunk > untilLimit)) chunk = untilLimit;
+    if (chunk > untilWrap) chunk = untilWrap;
+
+    return(chunk);
+}
+
+// Called exclusively from paCallback, with device-mutex held: Advance playback position and schedule
+// by 'frames' sample frames without emitting any sound, as if they had been played. Used to skip over
+// the frames of host buffers which were skipped due to a busy device mutex, so the remaining sound and
+// the following schedule slots are still played at their intended times:
+static void PsychPASkipPlayback(PsychPADevice* dev, psych_int64 frames)
+{
+    psych_int64 playposition = dev->playposition;
+    psych_int64 remaining = frames * (psych_int64) dev->outchannels;
+    psych_int64 outsbsize, outsboffset, playpositionlimit, chunk;
+    double repeatCount;
+    void *playoutbuffer;
+    int playoutformat, parc = 0;
+
+    while ((remaining > 0) && ((parc = PsychPAProcessSchedule(dev, &playposition, &playoutbuffer, &playoutformat, &outsbsize, &outsboffset, &repeatCount, &playpositionlimit)) == 0)) {
+        chunk = PsychPAPlayoutChunkSize(remaining, remaining, repeatCount, playpositionlimit - playposition, remaining);
+        playposition += chunk;
+        remaining -= chunk;
+    }
+
+    dev->playposition = playposition;
+
+    // A pause-and-restart command was reached in the skipped frames? Switch back to hot-standby
+    // for the rescheduled start, as regular playback would have done:
+    if (parc == 4) {
+        dev->state = 1;
+        dev->reqstate = 255;
+        PsychPASignalChange(dev);
+    }
+}
+
+// Worker thread pool of a master device for parallel rendering of its slaves:
+typedef struct PsychPASlaveWorker {
+    struct PsychPASlaveWorkerPool* pool;
+    psych_thread    thread;
+    psych_condition workSignal;                 // Signalled by master when a new batch of jobs is available.
+    int             index;
+} PsychPASlaveWorker;
+
+typedef struct PsychPASlaveWorkerPool {
+    int                 numWorkers;             // Number of worker threads.
+    PsychPASlaveWorker* workers;                // Array of worker thread descriptors.
+    psych_mutex         mutex;                  // Protects shutdown, and is used by the workers for waiting on their workSignal.
+    psych_bool          shutdown;               // Request to workers to terminate.
+    volatile psych_uint64 generation;           // Batch counter. Incremented for each new batch of jobs.
+    volatile psych_uint64 ticket;               // (generation << 32) + index of next job to claim for current batch.
+    volatile psych_uint64 jobsDone;             // Number of completed jobs in current batch.
+    // Parameters of current batch, as set up by master paCallback:
+    PsychPADevice*      master;
+    int                 numJobs;
+    const float*        in;
+    unsigned long       framesPerBuffer;
+    const PaStreamCallbackTimeInfo* timeInfo;
+    PaStreamCallbackFlags statusFlags;
+    int                 jobSlaves[MAX_PSYCH_AUDIO_SLAVES_PER_DEVICE];   // pahandle of slave to render per job.
+    float*              jobScratch[MAX_PSYCH_AUDIO_SLAVES_PER_DEVICE];  // Per-job scratch buffers for slave in-, output and gain.
+    psych_int64         scratchFrames;          // Capacity of jobScratch buffers in sample frames. Fixed at pool creation.
+} PsychPASlaveWorkerPool;
+
+static int paCallback( const void *inputBuffer, void *outputBuffer, unsigned long framesPerBuffer,
+                       const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags, void *userData );
+
+// Called from PsychPARenderSlave() for playback slave 'slaveId' with its own samplerate: Execute its
+// paCallback in chunks at the slaves samplerate, resample its output to the samplerate of master 'dev',
+// and apply the result to the gain values in 'slaveOut':
+static void PsychPARenderResampledSlave(PsychPADevice* dev, int slaveId, float* slaveOut, unsigned long framesPerBuffer,
+                                        const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags)
+{
+    PsychPADevice* slave = &(audiodevices[slaveId]);
+    PsychPAResampler* r = slave->resampler;
+    psych_int64 done, chunk, inFrames, outchannels = slave->outchannels;
+    int dirty = 0;
+
+    for (done = 0; done < (psych_int64) framesPerBuffer; done += chunk) {
+        chunk = (psych_int64) framesPerBuffer - done;
+        if (chunk > r->maxOutFrames) chunk = r->maxOutFrames;
+
+        inFrames = PsychPAResamplerInputFrames(r, chunk);
+        if (inFrames > 0) {
+            // The first new input frame is played after all frames still buffered in the resampler.
+            // The slaves paCallback uses this as its buffer onset time, instead of the masters:
+            slave->resampledOnset = dev->firstsampleonset + (double) done / dev->streaminfo->sampleRate +
+                                    PsychPAResamplerLead(r) / slave->streaminfo->sampleRate;
+
+            // Same neutral gain prefill as for regular slaves. Silence if the slave doesn't output anything:
+            psychPAMix.fill(r->inBuffer, 1.0f, inFrames * outchannels);
+            slave->slaveDirty = 0;
+            paCallback(NULL, (void*) r->inBuffer, (unsigned long) inFrames, timeInfo, statusFlags, (void*) slave);
+            if (slave->slaveDirty)
+                dirty = 1;
+            else
+                psychPAMix.fill(r->inBuffer, 0.0f, inFrames * outchannels);
+        }
+
+        PsychPAResample(r, r->inBuffer, inFrames, r->outBuffer, chunk);
+        psychPAMix.mulScaled(&(slaveOut[done * outchannels]), r->outBuffer, 1.0f, chunk * outchannels);
+    }
+
+    slave->slaveDirty = dirty;
+}
+
+// Apply the insert chain of 'dev' to 'frames' sample frames of 'buffer'. Called only by the thread
+// which renders 'dev'. Marks the chain as in use while processing it, so 'DeleteInserts' won't
+// release it meanwhile. This never blocks:
+static void PsychPARunDSPChain(PsychPADevice* dev, float* buffer, psych_int64 frames)
+{
+    PsychPADSPStage* chain = PsychPAAtomicLoadPtr(&(dev->dspChain));
+
+    if (NULL == chain) return;
+
+    PsychPAAtomicStorePtr(&(dev->dspChainInUse), chain);
+
+    // Only process if the chain wasn't detached before we marked it as in use:
+    if (PsychPAAtomicLoadPtr(&(dev->dspChain)) == chain) PsychPAProcessDSPChain(chain, buffer, frames);
+
+    PsychPAAtomicStorePtr(&(dev->dspChainInUse), NULL);
+}
+
+// Called from paCallback of master 'dev' or its slave worker threads: Render one regular
+// (non output capture, non modulator) slave 'slaveId', including execution of its attached
+// AM modulator slave, if any. The slaves captured input data is distributed from the masters
+// inputbuffer 'in' into scratch buffer 'slaveIn', its output lands in 'slaveOut', and the
+// gain output of its modulator in 'slaveGain':
+static void PsychPARenderSlave(PsychPADevice* dev, int slaveId, const float* in, float* slaveIn, float* slaveOut, float* slaveGain,
+                               unsigned long framesPerBuffer, const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags)
+{
+    int modulatorSlave;
+
+    // Gain modulator slave for this real slave attached, valid and active?
+    // If this is the case, we need to unconditionally execute it here, regardless
+    // of what the actual 'slaveId' device is up to. Otherwise we can run into
+    // time sync issues and ugly deadlocks in the calling code:
+    modulatorSlave = audiodevices[slaveId].modulatorSlave;
+    if ((modulatorSlave > -1) && (audiodevices[modulatorSlave].stream) &&
+        (audiodevices[modulatorSlave].opmode & kPortAudioIsAMModulatorForSlave) && (audiodevices[modulatorSlave].state > 0)) {
+        // Yes. Execute it:
+        audiodevices[modulatorSlave].slaveDirty = 0;
+
+        // Prefill buffer with neutral 1.0:
+        psychPAMix.fill(slaveGain, 1.0f, (psych_int64) framesPerBuffer * audiodevices[modulatorSlave].outchannels);
+
+        // This will potentially fill the slaveGain buffer with gain modulation values.
+        // The passed slaveIn buffer is meaningless for a modulator slave and only contains random junk...
+        paCallback( (const void*) slaveIn, (void*) slaveGain, framesPerBuffer, timeInfo, statusFlags, (void*) &(audiodevices[modulatorSlave]));
+    }
+    else {
+        // No. Either no modulator slave or slave not currently active. Signal this
+        // by setting modulatorSlave to a -1 value:
+        modulatorSlave = -1;
+    }
+
+    // Skip actual slaves processing if its state is zero == completely inactive.
+    if (audiodevices[slaveId].state <= 0) {
+        // Start from silence on next playback start:
+        if (audiodevices[slaveId].resampler) PsychPAResetResampler(audiodevices[slaveId].resampler);
+        return;
+    }
+
+    // Slave is active, need to process it:
+
+    // Reset dirty flag for this slave:
+    audiodevices[slaveId].slaveDirty = 0;
+
+    // Is this a playback slave?
+    if (audiodevices[slaveId].opmode & kPortAudioPlayBack) {
+        // Prefill slaves output buffer with 1.0, a neutral gain value for playback slaves
+        // without a AM modulator attached. The same prefill is needed with AM modulator,
+        // this time to make the modulator itself happy:
+        psychPAMix.fill(slaveOut, 1.0f, (psych_int64) framesPerBuffer * audiodevices[slaveId].outchannels);
+
+        // Ok, the outbuffer is filled with a neutral 1.0 gain value. This will work
+        // even if no per-slave gain modulation is provided by a modulator slave.
+
+        // An attached but inactive AM modulator with mode kPortAudioAMModulatorNeutralIsZero for this slave needs special treatment:
+        if (audiodevices[slaveId].modulatorSlave > -1) {
+            int myModulator = audiodevices[slaveId].modulatorSlave;
+
+            if ((audiodevices[myModulator].stream) && (audiodevices[myModulator].opmode & kPortAudioIsAMModulatorForSlave) &&
+                (audiodevices[myModulator].opmode & kPortAudioAMModulatorNeutralIsZero)) {
+                // Neutral should be zero, so zero-fill all our slaves channels to which its AM modulator is attached.
+                // This way non-attached channels stay at a neutral gain of 1 from prefill above and are unaffected by the modulator.
+                // Channels that are supposed to be fed by the modulator get zero-gain, so if the modulator is stopped, the effect
+                // will be as if the modulator had written zeros to "gate/mute" the slaves channel:
+                PsychPAFillMapped(slaveOut, audiodevices[slaveId].outchannels, audiodevices[myModulator].outputmappings,
+                                  audiodevices[myModulator].outchannels, 0.0f, (psych_int64) framesPerBuffer);
+            }
+        }
+
+        // Is a modulator slave active and did it write any gain AM values?
+        if ((modulatorSlave > -1) && (audiodevices[modulatorSlave].slaveDirty)) {
+            // Yes. Need to distribute them to proper channels in slaveOut, applying the
+            // modulators per-channel volumes on the way:
+            PsychPAMixMapped(slaveOut, audiodevices[slaveId].outchannels, slaveGain, audiodevices[modulatorSlave].outchannels,
+                             audiodevices[modulatorSlave].outputmappings, audiodevices[modulatorSlave].outChannelVolumes, (psych_int64) framesPerBuffer,
+                             kPsychPAMixStore);
+        }
+    }    // Ok, the slaveOut buffer for this playback slave is prefilled with valid gain modulation data to apply to the actual sound output.
+
+    // Capture enabled on slave? If so, we need to distribute our captured audio data to it:
+    if (audiodevices[slaveId].opmode & kPortAudioCapture) {
+        // For each target channel of each sampleFrame in the slave devices inputbuffer,
+        // fetch from corresponding source channel of our device:
+        PsychPAGatherMapped(slaveIn, audiodevices[slaveId].inchannels, in, dev->inchannels,
+                            audiodevices[slaveId].inputmappings, 1.0f, (psych_int64) framesPerBuffer);
+    }
+
+    // Temporary input buffer is filled for slave callback: Execute it.
+    if (audiodevices[slaveId].resampler)
+        PsychPARenderResampledSlave(dev, slaveId, slaveOut, framesPerBuffer, timeInfo, statusFlags);
+    else
+        paCallback( (const void*) slaveIn, (void*) slaveOut, framesPerBuffer, timeInfo, statusFlags, (void*) &(audiodevices[slaveId]));
+
+    // Apply insert chain of playback slave to its output:
+    if ((audiodevices[slaveId].opmode & kPortAudioPlayBack) && audiodevices[slaveId].slaveDirty)
+        PsychPARunDSPChain(&(audiodevices[slaveId]), slaveOut, (psych_int64) framesPerBuffer);
+}
+
+// Called from paCallback of master 'dev' after PsychPARenderSlave() for slave 'slaveId': Merge & mix
+// the slaves output from 'slaveOut' into the masters 'outputBuffer', if the slave produced any:
+static void PsychPAMixSlave(PsychPADevice* dev, int slaveId, float* outputBuffer, const float* slaveOut,
+                            psych_int64 committedFrames, unsigned long framesPerBuffer)
+{
+    // Check if the paCallback actually filled anything into the slaveOut buffer:
+    if ((audiodevices[slaveId].opmode & kPortAudioPlayBack) && audiodevices[slaveId].slaveDirty) {
+        // Slave has written meaningful data to its output buffer. Merge & mix it:
+
+        // Special AM-Modulator slave? If so, this slave doesn't provide audio data for mixing,
+        // but instead a time-series of gain modulation samples for amplitude modulation. Multiply
+        // the master channels samples with the slaves "gain samples" to apply AM modulation.
+        // Otherwise do a regular mix: Mix all output channels of the slave into the proper target
+        // channels of the master by simple addition. Apply per-channel volume settings of the slave
+        // during mix or modulation. Process from first non-silence sample slot (after silenceframes
+        // prefix) until end of buffer:
+        PsychPAMixMapped(&(outputBuffer[committedFrames * dev->outchannels]), dev->outchannels,
+                         &(slaveOut[committedFrames * audiodevices[slaveId].outchannels]), audiodevices[slaveId].outchannels,
+                         audiodevices[slaveId].outputmappings, audiodevices[slaveId].outChannelVolumes,
+                         (psych_int64) framesPerBuffer - committedFrames,
+                         (audiodevices[slaveId].opmode & kPortAudioIsAMModulator) ? kPsychPAMixMultiply : kPsychPAMixAdd);
+    }
+}
+
+// Scratch buffers of a render job: Slave input buffer first, followed by output and gain buffers:
+static void PsychPAGetJobScratch(PsychPASlaveWorkerPool* pool, int job, float** slaveIn, float** slaveOut, float** slaveGain)
+{
+    *slaveIn = pool->jobScratch[job];
+    *slaveOut = *slaveIn + pool->scratchFrames * pool->master->inchannels;
+    *slaveGain = *slaveOut + pool->scratchFrames * pool->master->outchannels;
+}
+
+// Claim and render jobs of batch 'generation' until no unclaimed jobs are left. Executed
+// by the master paCallback and all worker threads in parallel:
+static void PsychPARunSlaveJobs(PsychPASlaveWorkerPool* pool, psych_uint64 generation)
+{
+    psych_uint64 ticket;
+    float *slaveIn, *slaveOut, *slaveGain;
+    int job;
+
+    for (;;) {
+        // Claim next job. A ticket from a different generation means we are late
+        // to the party and that batch is already done, or a new batch has started
+        // that we will see on our next wakeup. Only claim via compare-and-swap, so
+        // a late thread can't steal a job from a new batch without executing it:
+        ticket = PsychPAAtomicLoad(&pool->ticket);
+        if ((ticket >> 32) != (generation & 0xffffffff)) return;
+
+        job = (int) (ticket & 0xffffffff);
+        if (job >= pool->numJobs) return;
+
+        if (!PsychPAAtomicCAS(&pool->ticket, ticket, ticket + 1)) continue;
+
+        PsychPAGetJobScratch(pool, job, &slaveIn, &slaveOut, &slaveGain);
+        PsychPARenderSlave(pool->master, pool->jobSlaves[job], pool->in, slaveIn, slaveOut, slaveGain,
+                           pool->framesPerBuffer, pool->timeInfo, pool->statusFlags);
+
+        // Job done. The master polls this counter for batch completion:
+        PsychPAAtomicFetchAdd(&pool->jobsDone, 1);
+    }
+}
+
+// Main routine of slave rendering worker threads:
+static void* PsychPASlaveWorkerMain(void* arg)
+{
+    PsychPASlaveWorker* worker = (PsychPASlaveWorker*) arg;
+    PsychPASlaveWorkerPool* pool = worker->pool;
+    psych_uint64 generation = 0;
+    char threadName[16];
+    int rc;
+
+    sprintf(threadName, "PsychPAWorker%i", worker->index);
+    PsychSetThreadName(threadName);
+
+    // Pin ourselves to one cpu core, spreading the workers over all cores except the first one, which
+    // usually has to service most hardware interrupts. OSX has no api for hard pinning of threads to cores,
+    // only for affinity hints, so there we leave the placement to the os scheduler:
+    #if PSYCH_SYSTEM == PSYCH_LINUX
+    {
+        cpu_set_t cpuset;
+        int ncpus = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+        if (ncpus > 1) {
+            CPU_ZERO(&cpuset);
+            CPU_SET((worker->index + 1) % ncpus, &cpuset);
+            if ((rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset)) && (verbosity > 4))
+                printf("PsychPortAudio: Failed to pin slave worker thread %i to cpu core [%s].\n", worker->index, strerror(rc));
+        }
+    }
+    #endif
+
+    #if PSYCH_SYSTEM == PSYCH_WINDOWS
+    {
+        SYSTEM_INFO sysinfo;
+        GetSystemInfo(&sysinfo);
+
+        if (sysinfo.dwNumberOfProcessors > 1) {
+            if ((0 == SetThreadAffinityMask(GetCurrentThread(), ((DWORD_PTR) 1) << ((worker->index + 1) % sysinfo.dwNumberOfProcessors))) && (verbosity > 4))
+                printf("PsychPortAudio: Failed to pin slave worker thread %i to cpu core.\n", worker->index);
+        }
+    }
+    #endif
+
+    // Switch to realtime scheduling, just as the audio callback thread which will wait for us:
+    if ((rc = PsychSetThreadPriority(NULL, 2, 4)) > 0) {
+        if (verbosity > 1) printf("PTB-WARNING: In PsychPortAudio slave worker thread %i: Failed to switch to realtime priority [%s]! Audio may glitch.\n", worker->index, strerror(rc));
+    }
+
+    PsychLockMutex(&pool->mutex);
+
+    while (!pool->shutdown) {
+        // Sleep until a new batch of jobs is available. The master signals us without taking the
+        // mutex, so a wakeup can get lost on some systems. That only means we skip that batch, as
+        // the master renders all jobs which are not claimed by any worker itself:
+        if (PsychPAAtomicLoad(&pool->generation) == generation) {
+            PsychWaitCondition(&worker->workSignal, &pool->mutex);
+            continue;
+        }
+
+        generation = PsychPAAtomicLoad(&pool->generation);
+        PsychUnlockMutex(&pool->mutex);
+
+        // Participate in rendering:
+        PsychPARunSlaveJobs(pool, generation);
+
+        PsychLockMutex(&pool->mutex);
+    }
+
+    PsychUnlockMutex(&pool->mutex);
+
+    return(NULL);
+}
+
+// Create a worker pool with 'numWorkers' threads for parallel rendering of the slaves of master 'dev',
+// for host buffers of at most 'maxFrames' sample frames:
+static PsychPASlaveWorkerPool* PsychPACreateSlaveWorkerPool(PsychPADevice* dev, int numWorkers, psych_int64 maxFrames)
+{
+    PsychPASlaveWorkerPool* pool;
+    int i, rc;
+
+    pool = (PsychPASlaveWorkerPool*) calloc(1, sizeof(PsychPASlaveWorkerPool));
+    if (NULL == pool) PsychErrorExitMsg(PsychError_outofMemory, "Insufficient memory during slave worker pool creation!");
+
+    pool->workers = (PsychPASlaveWorker*) calloc(numWorkers, sizeof(PsychPASlaveWorker));
+    if (NULL == pool->workers) {
+        free(pool);
+        PsychErrorExitMsg(PsychError_outofMemory, "Insufficient memory during slave worker pool creation!");
+    }
+
+    pool->master = dev;
+    pool->scratchFrames = maxFrames;
+    PsychInitMutex(&pool->mutex);
+
+    for (i = 0; i < numWorkers; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        PsychInitCondition(&(pool->workers[i].workSignal), NULL);
+        if ((rc = PsychCreateThread(&(pool->workers[i].thread), NULL, PsychPASlaveWorkerMain, (void*) &(pool->workers[i])))) {
+            if (verbosity > 1) printf("PTB-WARNING: PsychPortAudio: Could only create %i of %i slave worker threads [%s].\n", i, numWorkers, strerror(rc));
+            PsychDestroyCondition(&(pool->workers[i].workSignal));
+            break;
+        }
+    }
+
+    pool->numWorkers = i;
+
+    return(pool);
+}
+
+// Shutdown all worker threads of 'pool' and release it. Master paCallback must no longer be running:
+static void PsychPADestroySlaveWorkerPool(PsychPASlaveWorkerPool* pool)
+{
+    int i;
+
+    PsychLockMutex(&pool->mutex);
+    pool->shutdown = TRUE;
+    for (i = 0; i < pool->numWorkers; i++) PsychSignalCondition(&(pool->workers[i].workSignal));
+    PsychUnlockMutex(&pool->mutex);
+
+    for (i = 0; i < pool->numWorkers; i++) {
+        PsychDeleteThread(&(pool->workers[i].thread));
+        PsychDestroyCondition(&(pool->workers[i].workSignal));
+    }
+
+    for (i = 0; i < MAX_PSYCH_AUDIO_SLAVES_PER_DEVICE; i++) free(pool->jobScratch[i]);
+
+    PsychDestroyMutex(&pool->mutex);
+    free(pool->workers);
+    free(pool);
+}
+
+// Make sure 'pool' has a job scratch buffer for job 'job'. Called when attaching a slave to the master,
+// before the slave becomes visible to the masters paCallback, so the callback never allocates memory.
+// Returns FALSE if out of memory:
+static psych_bool PsychPAAllocSlaveJobScratch(PsychPASlaveWorkerPool* pool, int job)
+{
+    if (NULL == pool->jobScratch[job])
+        pool->jobScratch[job] = (float*) malloc(sizeof(float) * (size_t) (pool->scratchFrames * (pool->master->inchannels + 2 * pool->master->outchannels)));
+
+    return((pool->jobScratch[job]) ? TRUE : FALSE);
+}
+
+// Called exclusively from paCallback of master 'dev': Render all regular slaves in parallel on the
+// masters worker pool, then mix their outputs into 'outputBuffer' sequentially, in slave slot order,
+// so the result is identical to serial rendering. Returns the number of rendered and mixed slaves.
+// This never blocks: Workers are woken up without taking any locks, and completion is polled:
+static int PsychPARenderSlavesParallel(PsychPADevice* dev, const float* in, float* outputBuffer, psych_int64 committedFrames,
+                                       unsigned long framesPerBuffer, const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags)
+{
+    PsychPASlaveWorkerPool* pool = dev->slaveWorkers;
+    float *slaveIn, *slaveOut, *slaveGain;
+    psych_uint64 generation;
+    int i, slaveId, numSlavesHandled, numJobs;
+
+    // Collect render jobs. Modulators for slaves are rendered as part of their parent slaves job:
+    numJobs = 0;
+    numSlavesHandled = 0;
+    for (i = 0; (i < MAX_PSYCH_AUDIO_SLAVES_PER_DEVICE) && (numSlavesHandled < dev->slaveCount); i++) {
+        slaveId = dev->slaves[i];
+        if ((slaveId > -1) && !(audiodevices[slaveId].opmode & kPortAudioIsOutputCapture)) {
+            numSlavesHandled++;
+            if (audiodevices[slaveId].opmode & kPortAudioIsAMModulatorForSlave) continue;
+
+            pool->jobSlaves[numJobs++] = slaveId;
+        }
+    }
+
+    // Publish new batch to workers:
+    pool->numJobs = numJobs;
+    pool->in = in;
+    pool->framesPerBuffer = framesPerBuffer;
+    pool->timeInfo = timeInfo;
+    pool->statusFlags = statusFlags;
+
+    generation = PsychPAAtomicLoad(&pool->generation) + 1;
+    PsychPAAtomicStore(&pool->jobsDone, 0);
+    PsychPAAtomicStore(&pool->ticket, (generation & 0xffffffff) << 32);
+    PsychPAAtomicStore(&pool->generation, generation);
+
+    // Wake up the workers. Signalling without holding the mutex is allowed and does not block:
+    for (i = 0; i < pool->numWorkers; i++) PsychSignalCondition(&(pool->workers[i].workSignal));
+
+    // Participate in rendering ourselves, until no unclaimed jobs are left:
+    PsychPARunSlaveJobs(pool, generation);
+
+    // Spin until the workers have finished the jobs they claimed. This is bounded by the time needed
+    // to render one slave, as we rendered all jobs which were not yet claimed ourselves:
+    while (PsychPAAtomicLoad(&pool->jobsDone) < (psych_uint64) numJobs);
+
+    // Deterministic reduction: Mix all slave outputs in slave slot order into the masters output buffer:
+    if (outputBuffer) {
+        for (i = 0; i < numJobs; i++) {
+            PsychPAGetJobScratch(pool, i, &slaveIn, &slaveOut, &slaveGain);
+            PsychPAMixSlave(dev, pool->jobSlaves[i], outputBuffer, slaveOut, committedFrames, framesPerBuffer);
+        }
+    }
+
+    return(numSlavesHandled);
+}
+
+/* PsychPAProcessCallback: PortAudo I/O processing, executed by paCallback().
  *
  * This callback is called by PortAudios playback/capture engine whenever
  * it needs new data for playback or has new data from capture. We are expected
@@ -805,33 +1736,34 @@ int PsychPAProcessSchedule(PsychPADevice* dev, psych_int64 *playposition, float*
  * things like calling PortAudio functions, allocating memory, file i/o or
  * other unbounded operations!
  */
-static int paCallback( const void *inputBuffer, void *outputBuffer,
-                       unsigned long framesPerBuffer,
-                       const PaStreamCallbackTimeInfo* timeInfo,
-                       PaStreamCallbackFlags statusFlags,
-                       void *userData )
+static int PsychPAProcessCallback( const void *inputBuffer, void *outputBuffer,
+                                   unsigned long framesPerBuffer,
+                                   const PaStreamCallbackTimeInfo* timeInfo,
+                                   PaStreamCallbackFlags statusFlags,
+                                   void *userData )
 {
     // Assign all variables, especially our dev device structure
     // with info about this stream:
     PsychPADevice* dev = (PsychPADevice*) userData;
     float *out = (float*) outputBuffer;
     float *in = (float*) inputBuffer;
-    float *playoutbuffer;
-    float *tmpBuffer, *mixBuffer;
+    void *playoutbuffer;
+    int playoutformat;
+    const float *playoutsamples = NULL;
+    float convbuffer[PSYCH_PA_CONVERT_BLOCK];
     float masterVolume, neutralValue;
-    psych_int64  j, k;
     psych_int64 i, silenceframes, committedFrames, max_i;
     psych_int64 inchannels, outchannels;
     psych_int64  playposition, outsbsize, insbsize, recposition;
-    psych_int64  outsboffset;
+    psych_int64  outsboffset, chunk;
     unsigned int reqstate;
     double now, firstsampleonset, onsetDelta, offsetDelta, captureStartTime;
-    double repeatCount;
+    double repeatCount, tLock, lockWait;
     psych_int64 playpositionlimit;
     PaHostApiTypeId hA;
     psych_bool stopEngine;
-    psych_bool isMaster, isSlave;
-    int slaveId, modulatorSlave, parc, numSlavesHandled;
+    psych_bool isMaster, isSlave, locked;
+    int slaveId, parc, numSlavesHandled;
 
     // Device struct attached to stream? If no device struct
     // is attached, we can't continue and tell the engine to abort
@@ -929,7 +1861,7 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
         }
         #endif
 
-        if (hA==paCoreAudio || hA==paDirectSound || hA==paMME || hA==paALSA) {
+        if (hA==paCoreAudio || hA==paDirectSound || hA==paMME || hA==paALSA || hA==kPsychPANullHostAPI) {
             // On these systems, DAC-time is already returned in the system timebase,
             // so a simple query will return the onset time of the first sample. Well,
             // looks as if we need to add the device inherent latency, because
@@ -993,8 +1925,9 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
         // offset time to compute when to stop. It's also used for checking for skipped buffers and other problems...
     }
     else {
-        // We're a slave device: Just fetch precooked timestamps from our master:
-        firstsampleonset = audiodevices[dev->pamaster].firstsampleonset;
+        // We're a slave device: Just fetch precooked timestamps from our master. Slaves
+        // with their own samplerate get their onset from the master per call instead:
+        firstsampleonset = (dev->resampler) ? dev->resampledOnset : audiodevices[dev->pamaster].firstsampleonset;
         captureStartTime = audiodevices[dev->pamaster].cst;
         now = audiodevices[dev->pamaster].now;
     }
@@ -1004,8 +1937,56 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
     dev->cst = captureStartTime;
     dev->now = now;
 
-    // Acquire device lock: We'll likely hold it until exit from paCallback:
-    PsychPALockDeviceMutex(dev);
+    // Acquire device lock: We'll likely hold it until exit from paCallback. With the lock-free command
+    // queue enabled, we must never block, so we only spin on trying to get the lock for at most a tenth
+    // of the buffer duration. If it is still busy, the interpreter thread is executing an operation which
+    // does not go through the queue, and we skip this buffer:
+    PsychGetAdjustedPrecisionTimerSeconds(&tLock);
+    if (dev->cmdQueue) {
+        lockWait = tLock;
+        while (!(locked = PsychPATryLockDeviceMutex(dev)) && ((lockWait - tLock) < 0.1 * (double) framesPerBuffer / dev->streaminfo->sampleRate))
+            PsychGetAdjustedPrecisionTimerSeconds(&lockWait);
+
+        if (!locked) {
+            // Remember the skipped frames, so the next processed buffer continues playback at the
+            // position it would have had without the skip:
+            dev->lockMisses++;
+            dev->lockMissFrames += framesPerBuffer;
+            dev->skipFrames += framesPerBuffer;
+
+            // Output silence. Slaves don't mark their output dirty, so their master ignores it:
+            if (outputBuffer && !isSlave) memset(outputBuffer, 0, (size_t) (framesPerBuffer * dev->outchannels * sizeof(float)));
+
+            return(paContinue);
+        }
+    }
+    else {
+        PsychPALockDeviceMutex(dev);
+    }
+    PsychGetAdjustedPrecisionTimerSeconds(&lockWait);
+
+    // Keep statistics of time spent waiting for the lock:
+    lockWait -= tLock;
+    if (lockWait > dev->maxLockWait) dev->maxLockWait = lockWait;
+    dev->lockWaitHistogram[PsychPATimingHistogramBin(lockWait)]++;
+
+    // Apply all state changes posted via the lock-free command queue since last invocation:
+    PsychPAApplyCommands(dev);
+
+    // Buffers skipped due to lock misses since last invocation? Advance active playback over their
+    // frames. A master didn't render its slaves for these buffers, so they need to skip them as well:
+    if (dev->skipFrames > 0) {
+        if (isMaster) {
+            for (i = 0; i < MAX_PSYCH_AUDIO_SLAVES_PER_DEVICE; i++) {
+                slaveId = dev->slaves[i];
+                if (slaveId > -1)
+                    audiodevices[slaveId].skipFrames += (psych_int64) ((double) dev->skipFrames * audiodevices[slaveId].streaminfo->sampleRate / dev->streaminfo->sampleRate + 0.5);
+            }
+        }
+
+        if ((dev->state == 2) && (dev->opmode & kPortAudioPlayBack)) PsychPASkipPlayback(dev, dev->skipFrames);
+        dev->skipFrames = 0;
+    }
 
     // Cache requested state:
     reqstate = dev->reqstate;
@@ -1052,6 +2033,7 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
     // NULL-out pointer to buffer with sound data to play. It will get initialized later on
     // in PsychPAProcessSchedule():
     playoutbuffer = NULL;
+    playoutformat = kPsychPASampleFloat32;
 
     // Query number of output channels:
     outchannels = (psych_int64) dev->outchannels;
@@ -1231,7 +2213,8 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
                 }
                 else {
                     // Slow-path: Usually a 1.0 fill for AM modulator mode:
-                    for (i = 0; i < silenceframes * outchannels; i++) *(out++) = neutralValue;
+                    psychPAMix.fill(out, neutralValue, silenceframes * outchannels);
+                    out+= (silenceframes * outchannels);
                 }
 
                 // Decrement remaining real audio data count:
@@ -1306,161 +2289,34 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
             memset(outputBuffer, 0, (size_t) (framesPerBuffer * outchannels * sizeof(float)));
         }
 
-        // Iterate over all slave device callbacks: Or at least until all registered slaves are handled.
-        numSlavesHandled = 0;
-        for (i = 0; (i < MAX_PSYCH_AUDIO_SLAVES_PER_DEVICE) && (numSlavesHandled < dev->slaveCount); i++) {
-            // Valid slave slot?
-            slaveId = dev->slaves[i];
-
-            // We skip invalid slots and output capturer slaves:
-            if ((slaveId > -1) && !(audiodevices[slaveId].opmode & kPortAudioIsOutputCapture)) {
-                // Valid slave:
-
-                // Is this device an AM modulator attached to a slave?
-                if (audiodevices[slaveId].opmode & kPortAudioIsAMModulatorForSlave) {
-                    // Yes. Mark it as handled, then skip it. It will be called as part
-                    // of processing of its parent slave:
+        // Have a worker pool for parallel rendering of slaves, more than one slave to render, and
+        // a host buffer which fits into the preallocated job scratch buffers of the pool?
+        if (dev->slaveWorkers && (dev->slaveCount > 1) && ((psych_int64) framesPerBuffer <= dev->slaveWorkers->scratchFrames)) {
+            // Yes. Render all regular slaves in parallel, then mix them in slave slot order:
+            numSlavesHandled = PsychPARenderSlavesParallel(dev, in, (float*) outputBuffer, committedFrames, framesPerBuffer, timeInfo, statusFlags);
+        }
+        else {
+            // Iterate over all slave device callbacks: Or at least until all registered slaves are handled.
+            numSlavesHandled = 0;
+            for (i = 0; (i < MAX_PSYCH_AUDIO_SLAVES_PER_DEVICE) && (numSlavesHandled < dev->slaveCount); i++) {
+                // Valid slave slot?
+                slaveId = dev->slaves[i];
+
+                // We skip invalid slots and output capturer slaves:
+                if ((slaveId > -1) && !(audiodevices[slaveId].opmode & kPortAudioIsOutputCapture)) {
+                    // Valid slave: One more slave handled:
                     numSlavesHandled++;
-                    continue;
-                }
-
-                // This is a "real" audio slave, not a modulator or such:
-
-                // Gain modulator slave for this real slave attached, valid and active?
-                // If this is the case, we need to unconditionally execute it here, regardless
-                // of what the actual 'slaveId' device is up to. Otherwise we can run into
-                // time sync issues and ugly deadlocks in the calling code:
-                modulatorSlave = audiodevices[slaveId].modulatorSlave;
-                if ((modulatorSlave > -1) && (audiodevices[modulatorSlave].stream) &&
-                    (audiodevices[modulatorSlave].opmode & kPortAudioIsAMModulatorForSlave) && (audiodevices[modulatorSlave].state > 0)) {
-                    // Yes. Execute it:
-                    audiodevices[modulatorSlave].slaveDirty = 0;
-
-                    // Prefill buffer with neutral 1.0:
-                    tmpBuffer = dev->slaveGainBuffer;
-                    for (j = 0; j < framesPerBuffer * audiodevices[modulatorSlave].outchannels; j++) *(tmpBuffer++) = 1.0;
-
-                    // This will potentially fill the slaveGainBuffer with gain modulation values.
-                    // The passed slaveInBuffer is meaningless for a modulator slave and only contains random junk...
-                    paCallback( (const void*) dev->slaveInBuffer, (void*) dev->slaveGainBuffer, (unsigned long) framesPerBuffer, timeInfo, statusFlags, (void*) &(audiodevices[modulatorSlave]));
-                }
-                else {
-                    // No. Either no modulator slave or slave not currently active. Signal this
-                    // by setting modulatorSlave to a -1 value:
-                    modulatorSlave = -1;
-                }
-
-                // Skip actual slaves processing if its state is zero == completely inactive.
-                if (audiodevices[slaveId].state > 0) {
-                    // Slave is active, need to process it:
 
-                    // Reset dirty flag for this slave:
-                    audiodevices[slaveId].slaveDirty = 0;
-
-                    // Is this a playback slave?
-                    if (audiodevices[slaveId].opmode & kPortAudioPlayBack) {
-                        // Prefill slaves output buffer with 1.0, a neutral gain value for playback slaves
-                        // without a AM modulator attached. The same prefill is needed with AM modulator,
-                        // this time to make the modulator itself happy:
-                        tmpBuffer = dev->slaveOutBuffer;
-                        for (j = 0; j < framesPerBuffer * audiodevices[slaveId].outchannels; j++) *(tmpBuffer++) = 1.0;
-
-                        // Ok, the outbuffer is filled with a neutral 1.0 gain value. This will work
-                        // even if no per-slave gain modulation is provided by a modulator slave.
-
-                        // An attached but inactive AM modulator with mode kPortAudioAMModulatorNeutralIsZero for this slave needs special treatment:
-                        if (audiodevices[slaveId].modulatorSlave > -1) {
-                            int myModulator = audiodevices[slaveId].modulatorSlave;
-
-                            if ((audiodevices[myModulator].stream) && (audiodevices[myModulator].opmode & kPortAudioIsAMModulatorForSlave) &&
-                                (audiodevices[myModulator].opmode & kPortAudioAMModulatorNeutralIsZero)) {
-                                // Neutral should be zero, so zero-fill all our slaves channels to which its AM modulator is attached.
-                                // This way non-attached channels stay at a neutral gain of 1 from prefill above and are unaffected by the modulator.
-                                // Channels that are supposed to be fed by the modulator get zero-gain, so if the modulator is stopped, the effect
-                                // will be as if the modulator had written zeros to "gate/mute" the slaves channel:
-                                mixBuffer = dev->slaveOutBuffer;
-                                for (j = 0; j < framesPerBuffer; j++) {
-                                    // Iterate over all target channels in the slave device outputbuffer:
-                                    for (k = 0; k < audiodevices[myModulator].outchannels; k++) {
-                                        // Set new init gain to zero for a target channel to which the modulator is attached:
-                                        mixBuffer[(j * audiodevices[slaveId].outchannels) + audiodevices[myModulator].outputmappings[k]] = 0.0;
-                                    }
-                                }
-                            }
-                        }
-
-                        // Is a modulator slave active and did it write any gain AM values?
-                        if ((modulatorSlave > -1) && (audiodevices[modulatorSlave].slaveDirty)) {
-                            // Yes. Need to distribute them to proper channels in slaveOutBuffer:
-                            tmpBuffer = dev->slaveGainBuffer;
-                            mixBuffer = dev->slaveOutBuffer;
-                            for (j = 0; j < framesPerBuffer; j++) {
-                                // Iterate over all target channels in the slave device outputbuffer:
-                                for (k = 0; k < audiodevices[modulatorSlave].outchannels; k++) {
-                                    // Modulate current sample in intermixbuffer via multiplication:
-                                    mixBuffer[(j * audiodevices[slaveId].outchannels) + audiodevices[modulatorSlave].outputmappings[k]] = *(tmpBuffer++) * audiodevices[modulatorSlave].outChannelVolumes[k];
-                                }
-                            }
-                        }
-                    }    // Ok, the slaveOutBuffer for this playback slave is prefilled with valid gain modulation data to apply to the actual sound output.
-
-                    // Capture enabled on slave? If so, we need to distribute our captured audio data to it:
-                    if (audiodevices[slaveId].opmode & kPortAudioCapture) {
-                        tmpBuffer = dev->slaveInBuffer;
-                        // For each sampleFrame in the input buffer:
-                        for (j = 0; j < framesPerBuffer; j++) {
-                            // Iterate over all target channels in the slave devices inputbuffer:
-                            for (k = 0; k < audiodevices[slaveId].inchannels; k++) {
-                                // And fetch from corrsponding source channel of our device:
-                                *(tmpBuffer++) = in[(j * inchannels) + audiodevices[slaveId].inputmappings[k]];
-                            }
-                        }
-                    }
+                    // Is this device an AM modulator attached to a slave? If so skip it. It will be
+                    // called as part of processing of its parent slave:
+                    if (audiodevices[slaveId].opmode & kPortAudioIsAMModulatorForSlave) continue;
 
-                    // Temporary input buffer is filled for slave callback: Execute it.
-                    paCallback( (const void*) dev->slaveInBuffer, (void*) dev->slaveOutBuffer, (unsigned long) framesPerBuffer, timeInfo, statusFlags, (void*) &(audiodevices[slaveId]));
-
-                    // Check if the paCallback actually filled anything into the dev->slaveOutBuffer:
-                    if ((audiodevices[slaveId].opmode & kPortAudioPlayBack) && audiodevices[slaveId].slaveDirty) {
-                        // Slave has written meaningful data to its output buffer. Merge & mix it:
-
-                        // Process from first non-silence sample slot (after silenceframes prefix) until end of buffer:
-                        tmpBuffer = &(dev->slaveOutBuffer[committedFrames * audiodevices[slaveId].outchannels]);
-                        mixBuffer = (float*) outputBuffer;
-
-                        // Special AM-Modulator slave?
-                        if (audiodevices[slaveId].opmode & kPortAudioIsAMModulator) {
-                            // Yes: This slave doesn't provide audio data for mixing, but instead
-                            // a time-series of gain modulation samples for amplitude modulation.
-                            // Multiply the master channels samples with the slaves "gain samples"
-                            // to apply AM modulation:
-                            for (j = committedFrames; j < framesPerBuffer; j++) {
-                                // Iterate over all target channels in the slave device outputbuffer:
-                                for (k = 0; k < audiodevices[slaveId].outchannels; k++) {
-                                    // Modulate current sample in intermixbuffer via multiplication:
-                                    mixBuffer[(j * outchannels) + audiodevices[slaveId].outputmappings[k]] *= *(tmpBuffer++) * audiodevices[slaveId].outChannelVolumes[k];
-                                }
-                            }
-                        }
-                        else {
-                            // Regular mix: Mix all output channels of the slave into the proper target channels
-                            // of the master by simple addition. Apply per-channel volume settings of the slave
-                            // during mix:
-                            for (j = committedFrames; j < framesPerBuffer; j++) {
-                                // Iterate over all target channels in the slave device outputbuffer:
-                                for (k = 0; k < audiodevices[slaveId].outchannels; k++) {
-                                    // Mix current sample via addition:
-                                    mixBuffer[(j * outchannels) + audiodevices[slaveId].outputmappings[k]] += *(tmpBuffer++) * audiodevices[slaveId].outChannelVolumes[k];
-                                }
-                            }
-                        }
-                    }
+                    // This is a "real" audio slave, not a modulator or such: Execute it, then merge & mix its output:
+                    PsychPARenderSlave(dev, slaveId, in, dev->slaveInBuffer, dev->slaveOutBuffer, dev->slaveGainBuffer, framesPerBuffer, timeInfo, statusFlags);
+                    if (NULL != outputBuffer) PsychPAMixSlave(dev, slaveId, (float*) outputBuffer, dev->slaveOutBuffer, committedFrames, framesPerBuffer);
                 }
-
-                // One more slave handled:
-                numSlavesHandled++;
-            }
-        }    // Next slave...
+            }    // Next slave...
+        }
 
         // Done merging sound data from slaves. Mastercode can now process special output capture slaves
         // and other special post-mix slaves:
@@ -1478,21 +2334,11 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
                     // Output capture enabled on slave? If so, we need to distribute our output audio data to it:
                     if ((audiodevices[slaveId].opmode & kPortAudioCapture) && (audiodevices[slaveId].opmode & kPortAudioIsOutputCapture)) {
                         // Our target buffer is the slaveOutBuffer here, because it is guaranteed to exist and
-                        // have sufficient capacity:
-                        tmpBuffer = dev->slaveOutBuffer;
-
-                        // Our input is the mixBuffer from previous mixes:
-                        mixBuffer = (float*) outputBuffer;
-
-                        // For each sampleFrame in the mixBuffer:
-                        for (j = 0; j < framesPerBuffer; j++) {
-                            // Iterate over all target channels in the slave devices inputbuffer:
-                            for (k = 0; k < audiodevices[slaveId].inchannels; k++) {
-                                // And fetch from corrsponding mixBuffer channel of our device, applying the same
-                                // masterVolume setting that the master output device will apply later:
-                                *(tmpBuffer++) = masterVolume * mixBuffer[(j * outchannels) + audiodevices[slaveId].inputmappings[k]];
-                            }
-                        }
+                        // have sufficient capacity. Our input is the mixBuffer from previous mixes. Fetch from
+                        // corresponding mixBuffer channels of our device, applying the same masterVolume setting
+                        // that the master output device will apply later:
+                        PsychPAGatherMapped(dev->slaveOutBuffer, audiodevices[slaveId].inchannels, (float*) outputBuffer, outchannels,
+                                            audiodevices[slaveId].inputmappings, masterVolume, (psych_int64) framesPerBuffer);
                     }
 
                     // Temporary input buffer is filled for slave callback: dev->slaveOutBuffer acts as the input
@@ -1608,43 +2454,64 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
         // or max_i timeout reached for end of processing, or no more valid slots available
         // in current schedule. Assign all relevant parameters from schedule:
         while (!stopEngine && (i < framesPerBuffer * outchannels) && (i < max_i) &&
-            ((parc = PsychPAProcessSchedule(dev, &playposition, &playoutbuffer, &outsbsize, &outsboffset, &repeatCount, &playpositionlimit)) == 0)) {
+            ((parc = PsychPAProcessSchedule(dev, &playposition, &playoutbuffer, &playoutformat, &outsbsize, &outsboffset, &repeatCount, &playpositionlimit)) == 0)) {
             // Process this slot:
 
-            if (!isMaster && !isSlave) {
-                // Non-master, non-slave device: This is a regular sound device.
-                // Copy requested number of samples for each channel into the output buffer: Take the case of
-                // "loop forever" and "loop repeatCount" times into account, as well as stop times:
-                for (; (i < framesPerBuffer * outchannels) && (i < max_i) && ((repeatCount == -1) || (playposition < playpositionlimit)); i++) {
-                    *(out++) = playoutbuffer[outsboffset + ( playposition % outsbsize )] * masterVolume;
-                    playposition++;
+            // Copy requested number of samples for each channel into the output buffer: Take the case of
+            // "loop forever" and "loop repeatCount" times into account, as well as stop times. Samples
+            // are processed in chunks which don't wrap around the end of the current playloop, so the
+            // vectorized mix kernels can operate on contiguous runs of samples:
+            while ((i < framesPerBuffer * outchannels) && (i < max_i) && ((repeatCount == -1) || (playposition < playpositionlimit))) {
+                chunk = PsychPAPlayoutChunkSize((psych_int64) framesPerBuffer * outchannels - i, max_i - i, repeatCount, playpositionlimit - playposition,
+                                                outsbsize - (playposition % outsbsize));
+
+                if (!isMaster) {
+                    if (playoutformat == kPsychPASampleFloat32) {
+                        playoutsamples = &(((float*) playoutbuffer)[outsboffset + (playposition % outsbsize)]);
+                    }
+                    else {
+                        // Compact int16, int24 or float16 storage: Convert to float in blocks for mixing:
+                        if (chunk > PSYCH_PA_CONVERT_BLOCK) chunk = PSYCH_PA_CONVERT_BLOCK;
+                        PsychPAConvertSamples(convbuffer, playoutbuffer, playoutformat, outsboffset + (playposition % outsbsize), chunk);
+                        playoutsamples = convbuffer;
+                    }
+                }
+
+                if (!isMaster && !isSlave) {
+                    // Non-master, non-slave device: This is a regular sound device.
+                    psychPAMix.copyScaled(out, playoutsamples, masterVolume, chunk);
                 }
-            }
-            else if (!isMaster) {
-                // Non-master device: This is a slave.
-                // Copy requested number of samples for each channel into the output buffer: Take the case of
-                // "loop forever" and "loop repeatCount" times into account, as well as stop times:
-                for (; (i < framesPerBuffer * outchannels) && (i < max_i) && ((repeatCount == -1) || (playposition < playpositionlimit)); i++) {
-                    // We multiply in order to apply possible per-channel, per-sample gain values as
-                    // defined by the master - i.e., by an AM modulator that is attached to us:
-                    *(out++) *= playoutbuffer[outsboffset + ( playposition % outsbsize )] * masterVolume;
-                    playposition++;
+                else if (!isMaster) {
+                    // Non-master device: This is a slave. We multiply in order to apply possible per-channel,
+                    // per-sample gain values as defined by the master - i.e., by an AM modulator that is attached to us:
+                    psychPAMix.mulScaled(out, playoutsamples, masterVolume, chunk);
                 }
-            }
-            else {
-                // Master device: We don't output our own audio data. Just apply the masterVolume
-                // gain setting common to all output channels of the device:
-                for (; (i < framesPerBuffer * outchannels) && (i < max_i) && ((repeatCount == -1) || (playposition < playpositionlimit)); i++) {
-                    *(out++) *= masterVolume;
-                    playposition++;
+                else {
+                    // Master device: We don't output our own audio data. Just apply the masterVolume
+                    // gain setting common to all output channels of the device:
+                    psychPAMix.scale(out, masterVolume, chunk);
                 }
+
+                out += chunk;
+                i += chunk;
+                playposition += chunk;
+            }
+
+            // Publish where playback will continue, so the prefetch thread can page in file-backed buffers ahead of us:
+            if ((fileBufferCount > 0) && (playoutformat == kPsychPASampleFloat32)) {
+                chunk = (psych_int64) (PSYCH_PA_PREFETCH_SECS * dev->streaminfo->sampleRate) * outchannels;
+                dev->prefetchPos = &(((float*) playoutbuffer)[outsboffset + (playposition % outsbsize)]);
+                dev->prefetchCount = outsbsize - (playposition % outsbsize);
+                if (dev->prefetchCount > chunk) dev->prefetchCount = chunk;
+                dev->prefetchWrapPos = &(((float*) playoutbuffer)[outsboffset]);
+                dev->prefetchWrapCount = ((repeatCount != 1) && (chunk > dev->prefetchCount)) ? chunk - dev->prefetchCount : 0;
             }
 
             // Store updated playposition in device structure:
             dev->playposition = playposition;
 
             // Abort condition?
-            if ((i >= max_i) || ((parc = PsychPAProcessSchedule(dev, &playposition, &playoutbuffer, &outsbsize, &outsboffset, &repeatCount, &playpositionlimit)) > 0)) stopEngine = TRUE;
+            if ((i >= max_i) || ((parc = PsychPAProcessSchedule(dev, &playposition, &playoutbuffer, &playoutformat, &outsbsize, &outsboffset, &repeatCount, &playpositionlimit)) > 0)) stopEngine = TRUE;
             }
 
             // Store updated playposition in device structure:
@@ -1670,9 +2537,10 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
 
                 // We need to zero-fill the remainder of the buffer and tell the engine
                 // to finish playback:
-                while(i < framesPerBuffer * outchannels) {
-                    *out++ = neutralValue;
-                    i++;
+                if (i < (psych_int64) framesPerBuffer * outchannels) {
+                    psychPAMix.fill(out, neutralValue, (psych_int64) framesPerBuffer * outchannels - i);
+                    out += (psych_int64) framesPerBuffer * outchannels - i;
+                    i = (psych_int64) framesPerBuffer * outchannels;
                 }
 
                 // Signal that engine is stopped/will stop very soonish:
@@ -1715,6 +2583,44 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
     return(paContinue);
 }
 
+/* paCallback: PortAudo I/O processing callback.
+ *
+ * Executes the actual processing in PsychPAProcessCallback(), and keeps
+ * statistics about its execution time.
+ */
+static int paCallback( const void *inputBuffer, void *outputBuffer,
+                       unsigned long framesPerBuffer,
+                       const PaStreamCallbackTimeInfo* timeInfo,
+                       PaStreamCallbackFlags statusFlags,
+                       void *userData )
+{
+    PsychPADevice* dev = (PsychPADevice*) userData;
+    double tStart, tEnd;
+    int rc;
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+
+    // Reset of our statistics requested by the interpreter thread?
+    if (dev && (dev->statsResetDone != PsychPAAtomicLoad(&dev->statsResetRequest))) PsychPAResetCallbackStats(dev);
+
+    rc = PsychPAProcessCallback(inputBuffer, outputBuffer, framesPerBuffer, timeInfo, statusFlags, userData);
+
+    // Apply insert chain to the final sound output of regular and master devices. Slaves get
+    // theirs applied by their master in PsychPARenderSlave():
+    if (dev && outputBuffer && !(dev->opmode & kPortAudioIsSlave)) PsychPARunDSPChain(dev, (float*) outputBuffer, (psych_int64) framesPerBuffer);
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tEnd);
+
+    // Statistics are only updated by the callback of a device, so no need for locking:
+    if (dev) {
+        tEnd -= tStart;
+        if (tEnd > dev->maxExecTime) dev->maxExecTime = tEnd;
+        dev->execTimeHistogram[PsychPATimingHistogramBin(tEnd)]++;
+    }
+
+    return(rc);
+}
+
 void PsychPACloseStream(int id)
 {
     int pamaster, i;
@@ -1769,10 +2675,10 @@ void PsychPACloseStream(int id)
             // Portaudio shutdown.
 
             // Stop, shutdown and release audio stream:
-            Pa_StopStream(stream);
+            PsychPAStopStream(&audiodevices[id]);
 
             // Unregister the stream finished callback:
-            Pa_SetStreamFinishedCallback(stream, NULL);
+            PsychPASetStreamFinishedCallback(&audiodevices[id], NULL);
 
             // Our device thread, callbacks and hardware are stopped, all mutexes are unlocked,
             // all our potential slaves are inactive as well. We can safely destroy our slaves,
@@ -1794,13 +2700,14 @@ void PsychPACloseStream(int id)
                 printf("PTB-WARNING:PsychPortAudio('Close'): Audio device with handle %i had broken audio timestamping - and therefore timing - during this run. Don't trust the timing!\n", id);
 
             // Close and destroy the hardware portaudio stream:
-            Pa_CloseStream(stream);
+            PsychPACloseStreamHandle(&audiodevices[id]);
         }
 
         // Common destruct path for all types of devices:
 
         // Release stream reference to now dead stream:
         audiodevices[id].stream = NULL;
+        audiodevices[id].isNullDevice = FALSE;
 
         // Free associated sound outputbuffer:
         if(audiodevices[id].outputbuffer) {
@@ -1823,6 +2730,18 @@ void PsychPACloseStream(int id)
             audiodevices[id].schedule_size = 0;
         }
 
+        // Shutdown and release slave rendering worker pool, if any:
+        if(audiodevices[id].slaveWorkers) {
+            PsychPADestroySlaveWorkerPool(audiodevices[id].slaveWorkers);
+            audiodevices[id].slaveWorkers = NULL;
+        }
+
+        // Free lock-free command queue, if any:
+        if(audiodevices[id].cmdQueue) {
+            free(audiodevices[id].cmdQueue);
+            audiodevices[id].cmdQueue = NULL;
+        }
+
         // Free associated sound intermixbuffers:
         if(audiodevices[id].slaveOutBuffer) {
             free(audiodevices[id].slaveOutBuffer);
@@ -1862,6 +2781,17 @@ void PsychPACloseStream(int id)
             audiodevices[id].outChannelVolumes = NULL;
         }
 
+        // Free insert chain and sample rate converter, if any:
+        if(audiodevices[id].dspChain) {
+            PsychPADeleteDSPChain(audiodevices[id].dspChain);
+            audiodevices[id].dspChain = NULL;
+        }
+
+        if(audiodevices[id].resampler) {
+            PsychPADeleteResampler(audiodevices[id].resampler);
+            audiodevices[id].resampler = NULL;
+        }
+
         // If we use locking, we need to destroy the per-device mutex:
         if (uselocking && PsychDestroyMutex(&(audiodevices[id].mutex))) printf("PsychPortAudio: CRITICAL! Failed to release Mutex object for pahandle %i! Prepare for trouble!\n", id);
 
@@ -1890,7 +2820,7 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "count = PsychPortAudio('GetOpenDeviceCount');";
     synopsis[i++] = "devices = PsychPortAudio('GetDevices' [,devicetype] [, deviceIndex]);";
     synopsis[i++] = "\nGeneral settings:\n";
-    synopsis[i++] = "[oldyieldInterval, oldMutexEnable, lockToCore1, audioserver_autosuspend, workarounds] = PsychPortAudio('EngineTunables' [, yieldInterval][, MutexEnable][, lockToCore1][, audioserver_autosuspend][, workarounds]);";
+    synopsis[i++] = "[oldyieldInterval, oldMutexEnable, lockToCore1, audioserver_autosuspend, workarounds, mixKernels, slaveWorkerThreads, commandQueue] = PsychPortAudio('EngineTunables' [, yieldInterval][, MutexEnable][, lockToCore1][, audioserver_autosuspend][, workarounds][, mixKernels][, slaveWorkerThreads][, commandQueue]);";
     synopsis[i++] = "oldRunMode = PsychPortAudio('RunMode', pahandle [,runMode]);";
     synopsis[i++] = "\n\nDevice setup and shutdown:\n";
     synopsis[i++] = "pahandle = PsychPortAudio('Open' [, deviceid][, mode][, reqlatencyclass][, freq][, channels][, buffersize][, suggestedLatency][, selectchannels][, specialFlags=0]);";
@@ -1899,6 +2829,9 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "oldOpMode = PsychPortAudio('SetOpMode', pahandle [, opModeOverride]);";
     synopsis[i++] = "oldbias = PsychPortAudio('LatencyBias', pahandle [,biasSecs]);";
     synopsis[i++] = "[oldMasterVolume, oldChannelVolumes] = PsychPortAudio('Volume', pahandle [, masterVolume][, channelVolumes]);";
+    synopsis[i++] = "oldRate = PsychPortAudio('SlaveSampleRate', pahandle [, sampleRate]);";
+    synopsis[i++] = "nrInserts = PsychPortAudio('AddInsert', pahandle, type, coefficients);";
+    synopsis[i++] = "PsychPortAudio('DeleteInserts', pahandle);";
     #if (PSYCH_SYSTEM == PSYCH_OSX) && !defined(paMacCoreChangeDeviceParameters)
     synopsis[i++] = "enable = PsychPortAudio('DirectInputMonitoring', pahandle, enable [, inputChannel = -1][, outputChannel = 0][, gainLevel = 0.0][, stereoPan = 0.5]);";
     #endif
@@ -2044,7 +2977,8 @@ PsychError PsychPortAudioExit(void)
         }
         audiodevicecount = 0;
 
-        // Delete all audio buffers and the bufferlist itself:
+        // Stop readahead for file-backed buffers, then delete all audio buffers and the bufferlist itself:
+        PsychPAStopPrefetchThread();
         PsychPADeleteAllAudioBuffers();
 
         // Release audiobufferlist mutex lock:
@@ -2195,6 +3129,11 @@ void PsychPortAudioInitialize(void)
         // lock all threads to core 1 by default:
         lockToCore1 = (PsychIsMSVista()) ? FALSE : TRUE;
 
+        // Select the fastest sample mixing kernels supported by the running cpu, or
+        // the ones requested via 'EngineTunables':
+        PsychPASelectMixKernels(mixKernelsRequest);
+        if (verbosity > 3) printf("PTB-INFO: Using %s sample mixing kernels.\n", psychPAMix.name);
+
         pa_initialized = TRUE;
     }
 }
@@ -2203,8 +3142,8 @@ void PsychPortAudioInitialize(void)
  */
 PsychError PSYCHPORTAUDIOOpen(void)
 {
-    static char useString[] = "pahandle = PsychPortAudio('Open' [, deviceid][, mode][, reqlatencyclass][, freq][, channels][, buffersize][, suggestedLatency][, selectchannels][, specialFlags=0]);";
-    //                                                            1             2         3                    4        5            6              7                      8                      9
+    static char useString[] = "pahandle = PsychPortAudio('Open' [, deviceid][, mode][, reqlatencyclass][, freq][, channels][, buffersize][, suggestedLatency][, selectchannels][, specialFlags=0][, nullSinkFile]);";
+    //                                                            1             2         3                    4        5            6              7                      8                      9                   10
     static char synopsisString[] =
     "Open a PortAudio audio device and initialize it. Returns a 'pahandle' device handle for the device.\n\n"
     "On most operating systems you can open each physical sound device only once per running session. If "
@@ -2213,7 +3152,8 @@ PsychError PSYCHPORTAUDIOOpen(void)
     "All parameters are optional and have reasonable defaults. 'deviceid' Index to select amongst multiple "
     "logical audio devices supported by PortAudio. Defaults to whatever the systems default sound device is. "
     "Different device id's may select the same physical device, but controlled by a different low-level sound "
-    "system. E.g., Windows has about five different sound subsystems. 'mode' Mode of operation. Defaults to "
+    "system. E.g., Windows has about five different sound subsystems. A 'deviceid' of -2 selects a virtual null "
+"device, see below. 'mode' Mode of operation. Defaults to "
     "1 == sound playback only. Can be set to 2 == audio capture, or 3 for simultaneous capture and playback of sound. "
     "Note however that mode 3 (full duplex) does not work reliably on all sound hardware. On some hardware this mode "
     "may crash hard! There is also a special monitoring mode == 7, which only works for full duplex devices "
@@ -2277,7 +3217,20 @@ PsychError PSYCHPORTAUDIOOpen(void)
     "audio quantization artifacts. Dithering can improve signal to noise ratio and quality of output sound, but it is more "
     "compute intense and it could change very low-level properties of the audio signal, because what you hear is not exactly "
     "what you specified.\n"
-    "16 = Never dither audio data, not even in normal mode.\n\n";
+    "16 = Never dither audio data, not even in normal mode.\n"
+    "32 = Render as fast as possible, instead of in realtime. Only for the virtual null device.\n\n"
+    "The virtual null device, selected via 'deviceid' -2, doesn't use any sound hardware. It behaves like a perfect "
+    "sound card with any number of channels, any sample rate, a default 'buffersize' of 256 sample frames and a "
+    "latency of two buffers, but its output is discarded and its input is silence. All other functionality, e.g., "
+    "slave devices, AM modulators, schedules, output capture slaves and status reporting, works as usual. This "
+    "allows to test scripts on machines without suitable sound hardware, and to measure the processing cost of "
+    "a given setup via the 'CPULoad' and 'ExecTimeHistogram' fields returned by 'GetStatus', without any "
+    "interference by sound drivers. By default it runs in realtime. With 'specialFlags' 32 it renders as fast "
+    "as possible instead, with all timestamps referring to a virtual clock which starts at system time when the "
+    "device is started, and advances by the duration of each rendered buffer. This allows offline rendering of "
+    "sound much faster than realtime. The optional 'nullSinkFile' is the name of a file into which all sound "
+    "output of the null device gets written as raw interleaved 32 bit floating point samples. To get the output "
+    "into memory instead, attach an output capture slave device, see 'PsychPortAudio OpenSlave?'.\n\n";
 
     static char seeAlsoString[] = "Close GetDeviceSettings ";
 
@@ -2288,7 +3241,9 @@ PsychError PSYCHPORTAUDIOOpen(void)
     int  m, n, p;
     double* mychannelmap;
     double suggestedLatency, lowlatency;
+    psych_int64 maxFrames;
     PaHostApiIndex paHostAPI;
+    PaHostApiTypeId hostApiType;
     PaStreamParameters outputParameters;
     PaStreamParameters inputParameters;
     const PaDeviceInfo* inputDevInfo, *outputDevInfo, *referenceDevInfo;
@@ -2296,6 +3251,11 @@ PsychError PSYCHPORTAUDIOOpen(void)
     PaError err;
     PaStream *stream = NULL;
     const char* demoOnlyModeStr = NULL;
+    char* nullSinkFile = NULL;
+
+    // Properties of the virtual null device:
+    static const PaDeviceInfo nullDeviceInfo = { 2, "PsychPortAudio null device", -1, MAX_PSYCH_AUDIO_CHANNELS_PER_DEVICE,
+                                                 MAX_PSYCH_AUDIO_CHANNELS_PER_DEVICE, 0.0, 0.0, 0.0, 0.0, 48000.0 };
 
     #if PSYCH_SYSTEM == PSYCH_OSX
         #ifdef paMacCoreChangeDeviceParameters
@@ -2327,7 +3287,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
     PsychPushHelp(useString, synopsisString, seeAlsoString);
     if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none); };
 
-    PsychErrorExit(PsychCapNumInputArgs(9));     // The maximum number of inputs
+    PsychErrorExit(PsychCapNumInputArgs(10));    // The maximum number of inputs
     PsychErrorExit(PsychRequireNumInputArgs(0)); // The required number of inputs
     PsychErrorExit(PsychCapNumOutputArgs(1));     // The maximum number of outputs
 
@@ -2343,17 +3303,17 @@ PsychError PSYCHPORTAUDIOOpen(void)
     // Make sure PortAudio is online:
     PsychPortAudioInitialize();
 
-    // Sanity check: Any hardware found?
-    if (Pa_GetDeviceCount() == 0) PsychErrorExitMsg(PsychError_user, "Could not find *any* audio hardware on your system! Either your machine doesn't have audio hardware, or somethings seriously screwed.");
+    // Request optional deviceid:
+    PsychCopyInIntegerArg(1, kPsychArgOptional, &deviceid);
+    if (deviceid < kPsychPANullDeviceId) PsychErrorExitMsg(PsychError_user, "Invalid deviceid provided. Valid values are -2 to maximum number of devices.");
+
+    // Sanity check: Any hardware found? Not needed for the virtual null device:
+    if ((deviceid != kPsychPANullDeviceId) && (Pa_GetDeviceCount() == 0)) PsychErrorExitMsg(PsychError_user, "Could not find *any* audio hardware on your system! Either your machine doesn't have audio hardware, or somethings seriously screwed.");
 
     // We default to generic system settings for host api specific settings:
     outputParameters.hostApiSpecificStreamInfo = NULL;
     inputParameters.hostApiSpecificStreamInfo  = NULL;
 
-    // Request optional deviceid:
-    PsychCopyInIntegerArg(1, kPsychArgOptional, &deviceid);
-    if (deviceid < -1) PsychErrorExitMsg(PsychError_user, "Invalid deviceid provided. Valid values are -1 to maximum number of devices.");
-
     // Request optional mode of operation:
     PsychCopyInIntegerArg(2, kPsychArgOptional, &mode);
     if (mode < 1 || mode > 15 || mode & kPortAudioIsAMModulator || mode & kPortAudioIsAMModulatorForSlave || mode & kPortAudioIsOutputCapture || ((mode & kPortAudioMonitoring) && ((mode & kPortAudioFullDuplex) != kPortAudioFullDuplex))) {
@@ -2367,7 +3327,12 @@ PsychError PSYCHPORTAUDIOOpen(void)
     PsychCopyInIntegerArg(3, kPsychArgOptional, &latencyclass);
     if (latencyclass < 0 || latencyclass > 4) PsychErrorExitMsg(PsychError_user, "Invalid reqlatencyclass provided. Valid values are 0 to 4.");
 
-    if (deviceid == -1) {
+    if (deviceid == kPsychPANullDeviceId) {
+        // Virtual null device requested: No hardware device indices involved:
+        outputParameters.device = (PaDeviceIndex) kPsychPANullDeviceId;
+        inputParameters.device = (PaDeviceIndex) kPsychPANullDeviceId;
+    }
+    else if (deviceid == -1) {
         // Default devices requested:
         if (latencyclass == 0) {
             // High latency mode. Picks system default devices on non-Linux, from
@@ -2499,8 +3464,14 @@ PsychError PSYCHPORTAUDIOOpen(void)
     }
 
     // Query properties of selected device(s):
-    inputDevInfo  = Pa_GetDeviceInfo(inputParameters.device);
-    outputDevInfo = Pa_GetDeviceInfo(outputParameters.device);
+    if (deviceid == kPsychPANullDeviceId) {
+        inputDevInfo  = &nullDeviceInfo;
+        outputDevInfo = &nullDeviceInfo;
+    }
+    else {
+        inputDevInfo  = Pa_GetDeviceInfo(inputParameters.device);
+        outputDevInfo = Pa_GetDeviceInfo(outputParameters.device);
+    }
 
     // Select one of them as "reference" info devices: It's properties are used whenever
     // no more specialized info is available. We use the output device (if any) as reference,
@@ -2510,6 +3481,9 @@ PsychError PSYCHPORTAUDIOOpen(void)
     // Sanity check: Any hardware found?
     if (referenceDevInfo == NULL) PsychErrorExitMsg(PsychError_user, "Could not find *any* audio hardware on your system - or at least not with the provided deviceid, if any!");
 
+    // Type of host api backend to use:
+    hostApiType = (deviceid == kPsychPANullDeviceId) ? kPsychPANullHostAPI : Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type;
+
     // Check if current set of selected/available devices is compatible with our playback mode:
     if (((mode & kPortAudioPlayBack) || (mode & kPortAudioMonitoring)) && ((outputDevInfo == NULL) || (outputDevInfo && outputDevInfo->maxOutputChannels <= 0))) {
         PsychErrorExitMsg(PsychError_user, "Audio output requested, but there isn't any audio output device available or you provided a deviceid for something else than an output device!");
@@ -2586,7 +3560,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
     #endif
 
     #if PSYCH_SYSTEM == PSYCH_WINDOWS
-    if (Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type == paWASAPI) {
+    if (hostApiType == paWASAPI) {
         inputParameters.hostApiSpecificStreamInfo = (PaWasapiStreamInfo*) &inwasapiapisettings;
         outputParameters.hostApiSpecificStreamInfo = (PaWasapiStreamInfo*) &outwasapiapisettings;
 
@@ -2621,7 +3595,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
         }
 
         #ifdef PA_ASIO_H
-        if (Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type == paASIO) {
+        if (hostApiType == paASIO) {
             // MS-Windows and connected to an ASIO device. Try to assign channel mapping:
             if (mode & kPortAudioPlayBack) {
                 // Playback mappings:
@@ -2660,7 +3634,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
         else
         #endif
         #if PSYCH_SYSTEM == PSYCH_WINDOWS
-        if (Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type != paASIO) {
+        if (hostApiType != paASIO) {
             // Compute and apply channelmap:
             if (mode & kPortAudioPlayBack) {
                 PaWinWaveFormatChannelMask channelMask = (PaWinWaveFormatChannelMask) 0;
@@ -2678,7 +3652,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
                     printf("\n\n");
                 }
 
-                switch (Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type) {
+                switch (hostApiType) {
                     case paWASAPI:
                         outwasapiapisettings.flags |= paWinWasapiUseChannelMask;
                         outwasapiapisettings.channelMask = channelMask;
@@ -2716,7 +3690,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
         #endif
 
         #if PSYCH_SYSTEM == PSYCH_OSX && defined(paMacCoreChangeDeviceParameters)
-            if (Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type == paCoreAudio) {
+            if (hostApiType == paCoreAudio) {
                 // macOS CoreAudio. Try to assign channel mapping:
                 if (mode & kPortAudioPlayBack) {
                     // Playback mappings:
@@ -2790,6 +3764,14 @@ PsychError PSYCHPORTAUDIOOpen(void)
     // Copy in optional specialFlags:
     PsychCopyInIntegerArg(9, kPsychArgOptional, &specialFlags);
 
+    // Get optional output file for the null device:
+    PsychAllocInCharArg(10, kPsychArgOptional, &nullSinkFile);
+    if (nullSinkFile && (deviceid != kPsychPANullDeviceId))
+        PsychErrorExitMsg(PsychError_user, "Invalid 'nullSinkFile' provided. Only the virtual null device with 'deviceid' -2 supports this.");
+
+    if ((specialFlags & 32) && (deviceid != kPsychPANullDeviceId))
+        PsychErrorExitMsg(PsychError_user, "Invalid 'specialFlags' 32 provided. Only the virtual null device with 'deviceid' -2 can render as fast as possible.");
+
     // Set channel count:
     outputParameters.channelCount = mynrchannels[0];    // Number of output channels.
     inputParameters.channelCount = mynrchannels[1];     // Number of input channels.
@@ -2810,8 +3792,8 @@ PsychError PSYCHPORTAUDIOOpen(void)
         // Extra buffersize validation possible on OSX with upstream portaudio:
         #if (PSYCH_SYSTEM == PSYCH_OSX) && defined(paMacCoreChangeDeviceParameters)
         long minBufferSizeFrames, maxBufferSizeFrames;
-        if (paNoError == PaMacCore_GetBufferSizeRange(outputDevInfo ? outputParameters.device : inputParameters.device,
-                                                      &minBufferSizeFrames, &maxBufferSizeFrames)) {
+        if ((hostApiType == paCoreAudio) && (paNoError == PaMacCore_GetBufferSizeRange(outputDevInfo ? outputParameters.device : inputParameters.device,
+                                                                                       &minBufferSizeFrames, &maxBufferSizeFrames))) {
             if (verbosity > 3)
                 printf("PTB-INFO: Allowable host audiobuffersize range is %i to %i sample frames.\n",
                        (int) minBufferSizeFrames, (int) maxBufferSizeFrames);
@@ -2846,7 +3828,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
     // Set requested latency: In class 0 we choose device recommendation for dropout-free operation, in
     // all higher (lowlat) classes we request zero or low latency. PortAudio will
     // clamp this request to something safe internally.
-    switch (Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type) {
+    switch (hostApiType) {
         case paCoreAudio:    // CoreAudio is sometimes broken and causes sound dropouts at low latencies on 10.14 Mojave.
             lowlatency = (latencyclass > 1) ? 0.0 : 0.010;    // Go easy on it and only ask for 10 msecs latency at default
             break;                                            // latency class, otherwise for minimum, as in the past.
@@ -2905,7 +3887,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
     }
 
     #if PSYCH_SYSTEM == PSYCH_WINDOWS
-    if (Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type == paWASAPI) {
+    if (hostApiType == paWASAPI) {
         if (latencyclass > 1) {
             inwasapiapisettings.flags |= paWinWasapiExclusive;
             outwasapiapisettings.flags |= paWinWasapiExclusive;
@@ -2966,7 +3948,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
 
         // On ALSA in aggressive low-latency mode, reduce number of periods (aka device buffers) to 2 for double-buffering.
         // The default in Portaudio is 4 periods, so that's what we use in non-aggressive mode
-        if (Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type == paALSA)
+        if (hostApiType == paALSA)
             PaAlsa_SetNumPeriods((latencyclass > 2) ? 2 : 4);
 
         // Check if the requested sample format and settings are likely supported by Audio API:
@@ -2990,7 +3972,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
         // Execute check if Linux is 5.13+, skip otherwise with err = paNoError. Our setup will always execute the check on non-Linux:
         if ((major > 5) || (major == 5 && minor >= 13))
     #endif
-            if (!(workaroundsMask & 0x2)) // Only perform test if not disabled by workaround bit 1.
+            if (!(workaroundsMask & 0x2) && (deviceid != kPsychPANullDeviceId)) // Only perform test if not disabled by workaround bit 1, and on real hardware.
                 err = Pa_IsFormatSupported(((mode & kPortAudioCapture) ?  &inputParameters : NULL), ((mode & kPortAudioPlayBack) ? &outputParameters : NULL), freq);
 
     if ((err != paNoError) && (err != paDeviceUnavailable)) {
@@ -3074,7 +4056,20 @@ PsychError PSYCHPORTAUDIOOpen(void)
     }
 
     // Try to create & open stream:
-    if (err == paNoError)
+    if ((err == paNoError) && (deviceid == kPsychPANullDeviceId)) {
+        // Virtual null device, driven by its own render thread:
+        err = PsychPANullOpenStream(&stream, ((mode & kPortAudioCapture) ? mynrchannels[1] : 0), ((mode & kPortAudioPlayBack) ? mynrchannels[0] : 0),
+                                    freq, buffersize, (specialFlags & 32) ? FALSE : TRUE, nullSinkFile, paCallback, &audiodevices[id]);
+        if (err != paNoError) {
+            if (err == paInvalidDevice)
+                printf("PTB-ERROR: Failed to open virtual null audio device: Could not create the 'nullSinkFile' %s for writing.\n", nullSinkFile);
+            else
+                printf("PTB-ERROR: Failed to open virtual null audio device: %s\n", Pa_GetErrorText(err));
+
+            PsychErrorExitMsg(PsychError_user, "Failed to open virtual null audio device.");
+        }
+    }
+    else if (err == paNoError)
         err = Pa_OpenStream(
                             &stream,                                                        /* Return stream pointer here on success. */
                             ((mode & kPortAudioCapture) ?  &inputParameters : NULL),        /* Requested input settings, or NULL in pure playback case. */
@@ -3119,8 +4114,9 @@ PsychError PSYCHPORTAUDIOOpen(void)
     audiodevices[id].runMode = 1; // Keep engine running by default. Minimal extra cpu-load for significant reduction in startup latency.
     audiodevices[id].latencyclass = latencyclass;
     audiodevices[id].stream = stream;
-    audiodevices[id].streaminfo = Pa_GetStreamInfo(stream);
-    audiodevices[id].hostAPI = Pa_GetHostApiInfo(referenceDevInfo->hostApi)->type;
+    audiodevices[id].isNullDevice = (deviceid == kPsychPANullDeviceId) ? TRUE : FALSE;
+    audiodevices[id].streaminfo = PsychPAGetStreamInfo(&audiodevices[id]);
+    audiodevices[id].hostAPI = hostApiType;
     audiodevices[id].startTime = 0.0;
     audiodevices[id].reqStartTime = 0.0;
     audiodevices[id].reqStopTime = DBL_MAX;
@@ -3148,6 +4144,7 @@ PsychError PSYCHPORTAUDIOOpen(void)
     audiodevices[id].slaves = NULL;
     audiodevices[id].pamaster = -1;
     audiodevices[id].modulatorSlave = -1;
+    audiodevices[id].slaveWorkers = NULL;
     audiodevices[id].slaveOutBuffer = NULL;
     audiodevices[id].slaveGainBuffer = NULL;
     audiodevices[id].slaveInBuffer = NULL;
@@ -3155,6 +4152,25 @@ PsychError PSYCHPORTAUDIOOpen(void)
     audiodevices[id].masterVolume = 1.0;
     audiodevices[id].playposition = 0;
     audiodevices[id].totalplaycount = 0;
+    audiodevices[id].cmdQueue = NULL;
+    audiodevices[id].cmdHead = 0;
+    audiodevices[id].cmdTail = 0;
+    audiodevices[id].cmdPending = 0;
+    audiodevices[id].prefetchPos = NULL;
+    audiodevices[id].prefetchCount = 0;
+    audiodevices[id].prefetchWrapPos = NULL;
+    audiodevices[id].prefetchWrapCount = 0;
+    audiodevices[id].dspChain = NULL;
+    audiodevices[id].resampler = NULL;
+    audiodevices[id].resampledOnset = 0;
+    audiodevices[id].skipFrames = 0;
+    PsychPAResetCallbackStats(&(audiodevices[id]));
+
+    // Create lock-free command queue, if requested:
+    if (useCommandQueue && uselocking) {
+        audiodevices[id].cmdQueue = (PsychPACommand*) calloc(PSYCH_PA_CMDQUEUE_SIZE, sizeof(PsychPACommand));
+        if (NULL == audiodevices[id].cmdQueue) PsychErrorExitMsg(PsychError_outofMemory, "Insufficient memory during command queue creation!");
+    }
 
     // If this is a master, create a slave device list and init it to "empty":
     if (mode & kPortAudioIsMaster) {
@@ -3186,20 +4202,47 @@ PsychError PSYCHPORTAUDIOOpen(void)
     // If we use locking, this will create & init the associated event variable:
     PsychPACreateSignal(&(audiodevices[id]));
 
+    // Masters get a worker thread pool for parallel rendering of their slaves, if requested:
+    if ((mode & kPortAudioIsMaster) && (slaveWorkerThreads > 0)) {
+        if (uselocking) {
+            // Job scratch buffers of the pool get sized for the biggest host buffer we can reasonably expect,
+            // ie. twice the stream latency, the requested buffersize, or at least 4096 frames. Bigger host
+            // buffers will fall back to serial rendering of slaves:
+            maxFrames = (psych_int64) (2.0 * ((audiodevices[id].streaminfo->outputLatency > audiodevices[id].streaminfo->inputLatency) ?
+                                               audiodevices[id].streaminfo->outputLatency : audiodevices[id].streaminfo->inputLatency) * audiodevices[id].streaminfo->sampleRate);
+            if (maxFrames < 4096) maxFrames = 4096;
+            if (maxFrames < (psych_int64) buffersize) maxFrames = (psych_int64) buffersize;
+
+            audiodevices[id].slaveWorkers = PsychPACreateSlaveWorkerPool(&(audiodevices[id]), slaveWorkerThreads, maxFrames);
+            if (verbosity > 3) printf("PTB-INFO: Master device %i renders its slaves in parallel on %i worker threads.\n", id, audiodevices[id].slaveWorkers->numWorkers);
+        }
+        else if (verbosity > 1) {
+            printf("PTB-WARNING: Parallel rendering of slaves disabled for master device %i, as engine mutex locking is disabled.\n", id);
+        }
+    }
+
     // Register the stream finished callback:
-    Pa_SetStreamFinishedCallback(audiodevices[id].stream, PAStreamFinishedCallback);
+    PsychPASetStreamFinishedCallback(&audiodevices[id], PAStreamFinishedCallback);
 
     if (verbosity > 3) {
         printf("PTB-INFO: New audio device %i with handle %i opened as PortAudio stream:\n", deviceid, id);
 
-        if (audiodevices[id].opmode & kPortAudioPlayBack) {
-            printf("PTB-INFO: For %i channels Playback: Audio subsystem is %s, Audio device name is ", (int) audiodevices[id].outchannels, Pa_GetHostApiInfo(outputDevInfo->hostApi)->name);
-            printf("%s\n", outputDevInfo->name);
+        if (deviceid == kPsychPANullDeviceId) {
+            printf("PTB-INFO: Virtual null device with %i playback and %i capture channels, rendering %s.\n",
+                   (audiodevices[id].opmode & kPortAudioPlayBack) ? (int) audiodevices[id].outchannels : 0,
+                   (audiodevices[id].opmode & kPortAudioCapture) ? (int) audiodevices[id].inchannels : 0,
+                   (specialFlags & 32) ? "as fast as possible" : "in realtime");
         }
+        else {
+            if (audiodevices[id].opmode & kPortAudioPlayBack) {
+                printf("PTB-INFO: For %i channels Playback: Audio subsystem is %s, Audio device name is ", (int) audiodevices[id].outchannels, Pa_GetHostApiInfo(outputDevInfo->hostApi)->name);
+                printf("%s\n", outputDevInfo->name);
+            }
 
-        if (audiodevices[id].opmode & kPortAudioCapture) {
-            printf("PTB-INFO: For %i channels Capture: Audio subsystem is %s, Audio device name is ", (int) audiodevices[id].inchannels, Pa_GetHostApiInfo(inputDevInfo->hostApi)->name);
-            printf("%s\n", inputDevInfo->name);
+            if (audiodevices[id].opmode & kPortAudioCapture) {
+                printf("PTB-INFO: For %i channels Capture: Audio subsystem is %s, Audio device name is ", (int) audiodevices[id].inchannels, Pa_GetHostApiInfo(inputDevInfo->hostApi)->name);
+                printf("%s\n", inputDevInfo->name);
+            }
         }
 
         printf("PTB-INFO: Real samplerate %f Hz. Input latency %f msecs, Output latency %f msecs.\n",
@@ -3515,7 +4558,8 @@ PsychError PSYCHPORTAUDIOOpenSlave(void)
     audiodevices[id].opmode = mode;
     audiodevices[id].runMode = 1;
     audiodevices[id].stream = audiodevices[pamaster].stream;
-    audiodevices[id].streaminfo = Pa_GetStreamInfo(audiodevices[pamaster].stream);
+    audiodevices[id].isNullDevice = audiodevices[pamaster].isNullDevice;
+    audiodevices[id].streaminfo = PsychPAGetStreamInfo(&audiodevices[pamaster]);
     audiodevices[id].hostAPI = audiodevices[pamaster].hostAPI;
     audiodevices[id].startTime = 0.0;
     audiodevices[id].reqStartTime = 0.0;
@@ -3542,12 +4586,32 @@ PsychError PSYCHPORTAUDIOOpenSlave(void)
     audiodevices[id].slaves = NULL;
     audiodevices[id].pamaster = -1;
     audiodevices[id].modulatorSlave = -1;
+    audiodevices[id].slaveWorkers = NULL;
     audiodevices[id].slaveOutBuffer = NULL;
     audiodevices[id].slaveGainBuffer = NULL;
     audiodevices[id].slaveInBuffer = NULL;
     audiodevices[id].masterVolume = 1.0;
     audiodevices[id].playposition = 0;
     audiodevices[id].totalplaycount = 0;
+    audiodevices[id].cmdQueue = NULL;
+    audiodevices[id].cmdHead = 0;
+    audiodevices[id].cmdTail = 0;
+    audiodevices[id].cmdPending = 0;
+    audiodevices[id].prefetchPos = NULL;
+    audiodevices[id].prefetchCount = 0;
+    audiodevices[id].prefetchWrapPos = NULL;
+    audiodevices[id].prefetchWrapCount = 0;
+    audiodevices[id].dspChain = NULL;
+    audiodevices[id].resampler = NULL;
+    audiodevices[id].resampledOnset = 0;
+    audiodevices[id].skipFrames = 0;
+    PsychPAResetCallbackStats(&(audiodevices[id]));
+
+    // Create lock-free command queue, if requested:
+    if (useCommandQueue && uselocking) {
+        audiodevices[id].cmdQueue = (PsychPACommand*) calloc(PSYCH_PA_CMDQUEUE_SIZE, sizeof(PsychPACommand));
+        if (NULL == audiodevices[id].cmdQueue) PsychErrorExitMsg(PsychError_outofMemory, "Insufficient memory during command queue creation!");
+    }
 
     // Setup per-channel output volumes for slave: Each channel starts with a 1.0 setting, ie., max volume:
     if (audiodevices[id].outchannels > 0) {
@@ -3584,6 +4648,13 @@ PsychError PSYCHPORTAUDIOOpenSlave(void)
         PsychErrorExitMsg(PsychError_user, "Can't attach slave audio device to specified master. Maximum number of allowable slaves for master exceeded!");
     }
 
+    // Parallel rendering of slaves on the masters worker pool needs one job scratch buffer per slave, allocated
+    // here, as the masters paCallback must not allocate memory:
+    if (audiodevices[pamaster].slaveWorkers && !PsychPAAllocSlaveJobScratch(audiodevices[pamaster].slaveWorkers, audiodevices[pamaster].slaveCount)) {
+        PsychPAUnlockDeviceMutex(&audiodevices[pamaster]);
+        PsychErrorExitMsg(PsychError_outofMemory, "Insufficient memory for attaching slave audio device to master!");
+    }
+
     // Sufficient space for slaves: Find us the first free slot and attach us:
     for (i=0; (i < MAX_PSYCH_AUDIO_SLAVES_PER_DEVICE) && (audiodevices[pamaster].slaves[i] > -1); i++);
 
@@ -3763,8 +4834,8 @@ PsychError PSYCHPORTAUDIOFillAudioBuffer(void)
 
         // Assign properties:
         inchannels = inbuffer->outchannels;
-        insamples  = inbuffer->outputbuffersize / sizeof(float) / inchannels;
-        indatafloat = inbuffer->outputbuffer;
+        insamples  = PsychPAGetAudioBufferSampleCount(inbuffer) / inchannels;
+        indatafloat = PsychPAGetAudioBufferFloatSamples(inbuffer);
     }
     else {
         // Regular double matrix with sound data from runtime?
@@ -3925,7 +4996,11 @@ PsychError PSYCHPORTAUDIOFillAudioBuffer(void)
             PsychErrorExitMsg(PsychError_user, "Audiodevice no longer in playback mode (Auto stopped?!?)! Can't continue a streaming buffer refill while stopped. Check your code!");
         }
 
-        // Ok, device locked and enough headroom for batch streaming refill:
+        // Ok, device locked and enough headroom for batch streaming refill. Drop the lock during the copy,
+        // so paCallback doesn't have to wait for it: The engine plays out from 'playposition' and won't
+        // reach the free space behind 'writeposition' that we fill, unless it underruns anyway, and
+        // 'writeposition' is only touched by us:
+        PsychPAUnlockDeviceMutex(&audiodevices[pahandle]);
 
         // Copy the data, convert it from double to float, take ringbuffer wraparound into account:
         if (indata || userfloat) {
@@ -3968,6 +5043,8 @@ PsychError PSYCHPORTAUDIOFillAudioBuffer(void)
             }
         }
 
+        PsychPALockDeviceMutex(&audiodevices[pahandle]);
+
         // Retrieve total count of played out samples from engine:
         totalplaycount = audiodevices[pahandle].totalplaycount;
 
@@ -4012,7 +5089,9 @@ PsychError PSYCHPORTAUDIORefillBuffer(void)
     "Refill part of an audio data playback buffer of a PortAudio audio device. 'pahandle' is the handle of the device "
     "whose buffer is to be filled.\n"
     "'bufferhandle' is the handle of the buffer: Use a handle of zero for the standard "
-    "buffer created and accessed via 'FillBuffer'.\n"
+    "buffer created and accessed via 'FillBuffer'. Buffers created with a compact 'sampleFormat' "
+    "in 'CreateBuffer' get the new data quantized into their format. File-backed and zero-copy buffers "
+    "can not be refilled.\n"
     #if PSYCH_LANGUAGE == PSYCH_MATLAB
     "'bufferdata' is a matrix with audio data in double() or single() format. "
     "Each row of the matrix specifies one sound channel, each column one sample for each channel. "
@@ -4080,6 +5159,9 @@ PsychError PSYCHPORTAUDIORefillBuffer(void)
         // Deref bufferHandle: Issue error if no buffer with such a handle exists:
         buffer = PsychPAGetAudioBuffer(bufferhandle);
 
+        // File-backed and adopted buffers are read-only:
+        if (buffer->mapping || buffer->owner) PsychErrorExitMsg(PsychError_user, "Target audio buffer 'bufferHandle' is a read-only file-backed or zero-copy buffer. Can't refill it!");
+
         // Validate matching output channel count:
         if (buffer->outchannels != audiodevices[pahandle].outchannels) {
             printf("PsychPortAudio-ERROR: Audio channel count %i of audiobuffer with handle %i doesn't match channel count %i of audio device!\n",
@@ -4095,8 +5177,8 @@ PsychError PSYCHPORTAUDIORefillBuffer(void)
 
         // Assign properties:
         inchannels = inbuffer->outchannels;
-        insamples = inbuffer->outputbuffersize / sizeof(float) / inchannels;
-        indatafloat = inbuffer->outputbuffer;
+        insamples = PsychPAGetAudioBufferSampleCount(inbuffer) / inchannels;
+        indatafloat = PsychPAGetAudioBufferFloatSamples(inbuffer);
     }
     else {
         // Regular double matrix with sound data from runtime:
@@ -4134,9 +5216,9 @@ PsychError PSYCHPORTAUDIORefillBuffer(void)
 
     // Assign bufferpointer based on bufferhandle:
     if (bufferhandle > 0) {
-        // Generic buffer:
+        // Generic buffer: Size in units of float samples, regardless of its sample format:
         outdata = buffer->outputbuffer;
-        outbuffersize = (size_t) buffer->outputbuffersize;
+        outbuffersize = (size_t) PsychPAGetAudioBufferSampleCount(buffer) * sizeof(float);
     }
     else {
         // Standard playout buffer:
@@ -4162,6 +5244,13 @@ PsychError PSYCHPORTAUDIORefillBuffer(void)
         buffersize = sizeof(float) * (size_t) inchannels * (size_t) insamples;
     }
 
+    // Buffer with compact sample format? Quantize the data into it, then we're done:
+    if (buffer && (buffer->format != kPsychPASampleFloat32)) {
+        PsychPAStoreSamples(buffer->outputbuffer, buffer->format, inchannels * startIndex, indata, indatafloat,
+                            (indata || userfloat) ? PA_ANTICLAMPGAIN : 1.0, (psych_int64) (buffersize / sizeof(float)));
+        return(PsychError_none);
+    }
+
     // Map startIndex to offset in buffer:
     outdata += (size_t) inchannels * (size_t) startIndex;
 
@@ -4268,7 +5357,7 @@ PsychError PSYCHPORTAUDIODeleteBuffer(void)
  */
 PsychError PSYCHPORTAUDIOCreateBuffer(void)
 {
-    static char useString[] = "bufferhandle = PsychPortAudio('CreateBuffer' [, pahandle], bufferdata);";
+    static char useString[] = "bufferhandle = PsychPortAudio('CreateBuffer' [, pahandle], bufferdata [, sampleFormat=0][, zeroCopy=0]);\nbufferhandle = PsychPortAudio('CreateBuffer' [, pahandle], soundfilename);";
     static char synopsisString[] =
     "Create a new dynamic audio data playback buffer for a PortAudio audio device and fill it with initial data.\n"
     "Return a 'bufferhandle' to the new buffer. 'pahandle' is the optional handle of the device "
@@ -4284,6 +5373,30 @@ PsychError PSYCHPORTAUDIOCreateBuffer(void)
     "intentionally a very restricted interface. For lowest latency and best timing we want you to provide audio "
     "data exactly at the optimal format and sample rate, so the driver can save computation time and latency for "
     "expensive sample rate conversion, sample format conversion, and bounds checking/clipping.\n\n"
+    "Instead of a matrix, you can also pass the name of a sound file 'soundfilename' to create a file-backed "
+    "buffer for streaming playback of long sounds straight from disk: The file is mapped read-only into memory, "
+    "instead of being read into memory, so buffer creation is instant, regardless of file size, and memory "
+    "consumption stays constant. Sound data is read from disk on demand during playback, with a readahead of "
+    "a few seconds ahead of the current playback position of all playing devices. The file must be either a "
+    "WAV file with 32 bit floating point samples, or a raw file with interleaved 32 bit floating point samples, "
+    "ie., sample frames of 'channels' consecutive float32 values each. Raw files require 'pahandle', as their "
+    "channel count is taken from that audio device. For WAV files and a given 'pahandle', channel count and "
+    "sample rate must match the audio device. Samples must be in range -1.0 to +1.0, as no sample conversion "
+    "or clamping happens. File-backed buffers can be used for 'FillBuffer', 'RefillBuffer' as source, and in "
+    "playback schedules and playloops like any other buffer, but they are read-only: They can not be the "
+    "target of 'RefillBuffer'. Don't modify or truncate the sound file while the buffer exists!\n\n"
+    "'sampleFormat' optional: Storage format of the samples in the buffer: 0 = 32 bit float (default), "
+    "1 = 16 bit integer, 2 = packed 24 bit integer, 3 = 16 bit half precision float. Formats 1 to 3 reduce "
+    "memory consumption of large banks of sounds by a factor of 2, 1.33 and 2 respectively, at the expense "
+    "of reduced precision: The given 'bufferdata' gets quantized into the storage format at buffer creation "
+    "and refill time, and is converted back to float during playback.\n"
+    "'zeroCopy' optional: If set to 1, the buffer does not copy 'bufferdata', but uses the memory of the "
+    "given array directly, which makes buffer creation instant, regardless of sound length. The array must "
+    "be a C-contiguous array of float32, int16 or float16 samples, which also defines 'sampleFormat'. "
+    "Samples are not clamped, and int16 samples are interpreted with a full scale of 32768. The array is kept "
+    "alive until the buffer is deleted, ie., until 'DeleteBuffer' confirmed that no playing schedule uses the "
+    "buffer anymore. Don't modify the array while it is played. Zero-copy buffers are read-only for 'RefillBuffer'. "
+    "This is only supported with Python, and with Python 3.11 or later if the limited Python api is used.\n\n"
     "You can refill the buffer anytime via the PsychPortAudio('RefillBuffer') call.\n"
     "You can delete the buffer via the PsychPortAudio('DeleteBuffer') call, once it is not used anymore. \n"
     "You can attach the buffer to an audio playback schedule for actual audio playback via the "
@@ -4295,39 +5408,87 @@ PsychError PSYCHPORTAUDIOCreateBuffer(void)
 
     PsychPABuffer* buffer;
     psych_int64 inchannels, insamples, p;
-    size_t buffersize;
     double*    indata = NULL;
     float* indatafloat = NULL;
-    float*  outdata = NULL;
     int pahandle   = -1;
     int bufferhandle = 0;
+    int sampleFormat = -1;
+    int zeroCopy = 0;
+    char* filename = NULL;
+    #ifdef PSYCH_PA_ZEROCOPY
+    Py_buffer* view = NULL;
+    int viewFormat = -1;
+    #endif
     psych_bool c_layout = PsychUseCMemoryLayoutIfOptimal(TRUE);
 
     // Setup online help:
     PsychPushHelp(useString, synopsisString, seeAlsoString);
     if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none); };
 
-    PsychErrorExit(PsychCapNumInputArgs(2));     // The maximum number of inputs
+    PsychErrorExit(PsychCapNumInputArgs(4));     // The maximum number of inputs
     PsychErrorExit(PsychRequireNumInputArgs(0)); // The required number of inputs
     PsychErrorExit(PsychCapNumOutputArgs(1));     // The maximum number of outputs
 
     // Make sure PortAudio is online:
     PsychPortAudioInitialize();
 
-    // Get data matrix with initial buffer content:
-    if (!PsychAllocInDoubleMatArg64(2, kPsychArgAnything, &inchannels, &insamples, &p, &indata)) {
-        // Or regular float matrix instead:
-        PsychAllocInFloatMatArg64(2, kPsychArgRequired, &inchannels, &insamples, &p, &indatafloat);
+    // Sound file name instead of data matrix? Then create a file-backed buffer:
+    if (PsychGetArgType(2) == PsychArgType_char) {
+        PsychAllocInCharArg(2, kPsychArgRequired, &filename);
+
+        if (PsychCopyInIntegerArg(1, kPsychArgOptional, &pahandle)) {
+            if (pahandle < 0 || pahandle>=MAX_PSYCH_AUDIO_DEVS || audiodevices[pahandle].stream == NULL) PsychErrorExitMsg(PsychError_user, "Invalid audio device handle provided.");
+            if ((audiodevices[pahandle].opmode & kPortAudioPlayBack) == 0) PsychErrorExitMsg(PsychError_user, "Audio device has not been opened for audio playback, so this call doesn't make sense.");
+            bufferhandle = PsychPACreateFileAudioBuffer(filename, audiodevices[pahandle].outchannels, audiodevices[pahandle].streaminfo->sampleRate);
+        }
+        else {
+            bufferhandle = PsychPACreateFileAudioBuffer(filename, 0, 0);
+        }
+
+        PsychCopyOutDoubleArg(1, FALSE, (double) bufferhandle);
+        return(PsychError_none);
+    }
+
+    // Get optional sample storage format and zero-copy flag:
+    PsychCopyInIntegerArg(3, kPsychArgOptional, &sampleFormat);
+    if (sampleFormat < -1 || sampleFormat >= kPsychPASampleFormatCount) PsychErrorExitMsg(PsychError_user, "Invalid 'sampleFormat' provided. Valid values are 0 to 3.");
+
+    PsychCopyInIntegerArg(4, kPsychArgOptional, &zeroCopy);
+    if (zeroCopy < 0 || zeroCopy > 1) PsychErrorExitMsg(PsychError_user, "Invalid 'zeroCopy' flag provided. Must be 0 or 1.");
+
+    if (zeroCopy) {
+        #ifdef PSYCH_PA_ZEROCOPY
+        // Get a reference to the memory of the sound data array, without copying:
+        view = PsychPAGetPythonSampleBuffer(2, &viewFormat, &inchannels, &insamples);
+        if ((sampleFormat != -1) && (sampleFormat != viewFormat)) {
+            PyBuffer_Release(view);
+            free(view);
+            PsychErrorExitMsg(PsychError_user, "Given 'sampleFormat' does not match the sample data type of the zero-copy 'bufferdata' array.");
+        }
+
+        sampleFormat = viewFormat;
+        #else
+        PsychErrorExitMsg(PsychError_unimplemented, "Zero-copy buffers are only supported with Python, and with Python 3.11 or later if the limited Python api is used.");
+        #endif
     }
+    else {
+        // Get data matrix with initial buffer content:
+        if (!PsychAllocInDoubleMatArg64(2, kPsychArgAnything, &inchannels, &insamples, &p, &indata)) {
+            // Or regular float matrix instead:
+            PsychAllocInFloatMatArg64(2, kPsychArgRequired, &inchannels, &insamples, &p, &indatafloat);
+        }
+
+        if (p != 1)
+            PsychErrorExitMsg(PsychError_user, "Audio data matrix must be a 2D matrix, but this one is not a 2D matrix!");
 
-    if (p != 1)
-        PsychErrorExitMsg(PsychError_user, "Audio data matrix must be a 2D matrix, but this one is not a 2D matrix!");
+        // Swap inchannels <-> insamples to take transposed 2D matrix of C vs. Fortran layout into account:
+        if (c_layout) {
+            p = inchannels;
+            inchannels = insamples;
+            insamples = p;
+        }
 
-    // Swap inchannels <-> insamples to take transposed 2D matrix of C vs. Fortran layout into account:
-    if (c_layout) {
-        p = inchannels;
-        inchannels = insamples;
-        insamples = p;
+        if (sampleFormat == -1) sampleFormat = kPsychPASampleFloat32;
     }
 
     // If the optional pahandle is provided...
@@ -4338,6 +5499,13 @@ PsychError PSYCHPORTAUDIOCreateBuffer(void)
         if ((audiodevices[pahandle].opmode & kPortAudioPlayBack) == 0) PsychErrorExitMsg(PsychError_user, "Audio device has not been opened for audio playback, so this call doesn't make sense.");
 
         if (inchannels != audiodevices[pahandle].outchannels) {
+            #ifdef PSYCH_PA_ZEROCOPY
+            if (view) {
+                PyBuffer_Release(view);
+                free(view);
+            }
+            #endif
+
             printf("PTB-ERROR: Audio device %i has %i output channels, but provided matrix has non-matching number of %i %s.\n",
                 pahandle, (int) audiodevices[pahandle].outchannels, (int) inchannels, (c_layout) ? "columns" : "rows");
             if (c_layout)
@@ -4347,30 +5515,39 @@ PsychError PSYCHPORTAUDIOCreateBuffer(void)
         }
     }
 
-    if (inchannels < 1) PsychErrorExitMsg(PsychError_user, "You must provide at least a vector for creation of at least one audio channel in your audio buffer!");
-    if (insamples < 1) PsychErrorExitMsg(PsychError_user, "You must provide at least 1 sample for creation of your audio buffer!");
+    if ((inchannels < 1) || (insamples < 1)) {
+        #ifdef PSYCH_PA_ZEROCOPY
+        if (view) {
+            PyBuffer_Release(view);
+            free(view);
+        }
+        #endif
+
+        if (inchannels < 1) PsychErrorExitMsg(PsychError_user, "You must provide at least a vector for creation of at least one audio channel in your audio buffer!");
+        PsychErrorExitMsg(PsychError_user, "You must provide at least 1 sample for creation of your audio buffer!");
+    }
+
+    #ifdef PSYCH_PA_ZEROCOPY
+    if (view) {
+        // Adopt the memory of the sound data array as buffer, keeping the reference to it:
+        bufferhandle = PsychPAGetFreeBufferSlot();
+        bufferList[bufferhandle].outputbuffer = (float*) view->buf;
+        bufferList[bufferhandle].outputbuffersize = inchannels * insamples * PsychPASampleFormatBytes(sampleFormat);
+        bufferList[bufferhandle].outchannels = inchannels;
+        bufferList[bufferhandle].format = sampleFormat;
+        bufferList[bufferhandle].owner = (void*) view;
+
+        PsychCopyOutDoubleArg(1, FALSE, (double) bufferhandle);
+        return(PsychError_none);
+    }
+    #endif
 
     // Create buffer and assign bufferhandle:
-    bufferhandle = PsychPACreateAudioBuffer(inchannels, insamples);
+    bufferhandle = PsychPACreateAudioBuffer(inchannels, insamples, sampleFormat);
 
-    // Deref bufferHandle:
+    // Deref bufferHandle and copy the data into it, converting it into its sample format:
     buffer = PsychPAGetAudioBuffer(bufferhandle);
-    outdata = buffer->outputbuffer;
-    buffersize = sizeof(float) * (size_t) inchannels * (size_t) insamples;
-
-    if (indata) {
-        // Copy the data, convert it from double to float:
-        while(buffersize > 0) {
-            *(outdata++) = (float) (PA_ANTICLAMPGAIN *  *(indata++));
-            buffersize-=sizeof(float);
-        }
-    } else {
-        // Copy the float data:
-        while(buffersize > 0) {
-            *(outdata++) = (float) (PA_ANTICLAMPGAIN *  *(indatafloat++));
-            buffersize-=sizeof(float);
-        }
-    }
+    PsychPAStoreSamples(buffer->outputbuffer, buffer->format, 0, indata, indatafloat, PA_ANTICLAMPGAIN, inchannels * insamples);
 
     // Return bufferhandle:
     PsychCopyOutDoubleArg(1, FALSE, (double) bufferhandle);
@@ -4762,7 +5939,7 @@ PsychError PSYCHPORTAUDIORescheduleStart(void)
     }
 
     // Audio engine running? That is the minimum requirement for this function to work:
-    if (!Pa_IsStreamActive(audiodevices[pahandle].stream)) PsychErrorExitMsg(PsychError_user, "Audio device not started. You need to call the 'Start' function first!");
+    if (!PsychPAIsStreamActive(&audiodevices[pahandle])) PsychErrorExitMsg(PsychError_user, "Audio device not started. You need to call the 'Start' function first!");
 
     // Lock the device:
     PsychPALockDeviceMutex(&audiodevices[pahandle]);
@@ -4828,7 +6005,7 @@ PsychError PSYCHPORTAUDIORescheduleStart(void)
 
     // Safety check for deadlock avoidance with waiting slaves:
     if ((waitForStart > 0) && (audiodevices[pahandle].opmode & kPortAudioIsSlave) &&
-        (!Pa_IsStreamActive(audiodevices[pahandle].stream) || Pa_IsStreamStopped(audiodevices[pahandle].stream) ||
+        (!PsychPAIsStreamActive(&audiodevices[pahandle]) || PsychPAIsStreamStopped(&audiodevices[pahandle]) ||
         audiodevices[audiodevices[pahandle].pamaster].state < 1)) {
         // We are a slave that shall wait for start, but the master audio device hasn't even
         // started its engine. This looks like a deadlock to avoid:
@@ -4842,7 +6019,7 @@ PsychError PSYCHPORTAUDIORescheduleStart(void)
         // Wait for real start of device: We enter the first while() loop iteration with
         // the device lock still held from above, so the while() loop will iterate at
         // least once...
-        while (audiodevices[pahandle].state == 1 && Pa_IsStreamActive(audiodevices[pahandle].stream)) {
+        while (audiodevices[pahandle].state == 1 && PsychPAIsStreamActive(&audiodevices[pahandle])) {
             // Wait for a state-change before reevaluating the .state:
             PsychPAWaitForChange(&audiodevices[pahandle]);
         }
@@ -4959,25 +6136,29 @@ PsychError PSYCHPORTAUDIOStartAudioDevice(void)
     // Make sure current state is zero, aka fully stopped and engine is really stopped: Output a warning if this looks like an
     // unintended "too early" restart: [No need to mutex-lock here, as iff these .state setting is not met,
     // then we are good and they can't change by themselves behind our back -- paCallback() can't change .state to > 0]
-    if ((audiodevices[pahandle].state > 0) && Pa_IsStreamActive(audiodevices[pahandle].stream)) {
+    if ((audiodevices[pahandle].state > 0) && PsychPAIsStreamActive(&audiodevices[pahandle])) {
         if (verbosity > 1) {
             printf("PsychPortAudio-WARNING: 'Start' method on audiodevice %i called, although playback on device not yet completely stopped.\nWill forcefully restart with possible audible artifacts or timing glitches.\nCheck your playback timing or use the 'Stop' function properly!\n", pahandle);
         }
     }
 
     // Safeguard: If the stream is not stopped in runMode 0, do it now:
-    if (!Pa_IsStreamStopped(audiodevices[pahandle].stream)) {
-        if (audiodevices[pahandle].runMode == 0) Pa_StopStream(audiodevices[pahandle].stream);
+    if (!PsychPAIsStreamStopped(&audiodevices[pahandle])) {
+        if (audiodevices[pahandle].runMode == 0) PsychPAStopStream(&audiodevices[pahandle]);
     }
 
     // Mutex-lock here: Needed if engine already/still running in runMode1, doesn't hurt if engine is stopped
     PsychPALockDeviceMutex(&audiodevices[pahandle]);
 
+    // Apply pending state changes from the command queue, so they can't override settings of this start:
+    PsychPAApplyCommands(&audiodevices[pahandle]);
+
     // Reset statistics values:
     audiodevices[pahandle].batchsize = 0;
     audiodevices[pahandle].xruns = 0;
     audiodevices[pahandle].paCalls = 0;
     audiodevices[pahandle].noTime = 0;
+    PsychPARequestCallbackStatsReset(&audiodevices[pahandle]);
     audiodevices[pahandle].captureStartTime = 0;
     audiodevices[pahandle].startTime = 0.0;
     audiodevices[pahandle].reqStopTime = stopTime;
@@ -5011,7 +6192,7 @@ PsychError PSYCHPORTAUDIOStartAudioDevice(void)
 
     if (!(audiodevices[pahandle].opmode & kPortAudioIsSlave)) {
         // Engine running?
-        if (!Pa_IsStreamActive(audiodevices[pahandle].stream) || Pa_IsStreamStopped(audiodevices[pahandle].stream)) {
+        if (!PsychPAIsStreamActive(&audiodevices[pahandle]) || PsychPAIsStreamStopped(&audiodevices[pahandle])) {
             // Try to start stream if the engine isn't running, either because it is the very
             // first call to 'Start' in any runMode, or because the engine got stopped in
             // preparation for a restart in runMode zero. Need to drop the lock during
@@ -5019,13 +6200,13 @@ PsychError PSYCHPORTAUDIOStartAudioDevice(void)
             PsychPAUnlockDeviceMutex(&audiodevices[pahandle]);
 
             // Safeguard: If the stream is not stopped, do it now:
-            if (!Pa_IsStreamStopped(audiodevices[pahandle].stream)) Pa_StopStream(audiodevices[pahandle].stream);
+            if (!PsychPAIsStreamStopped(&audiodevices[pahandle])) PsychPAStopStream(&audiodevices[pahandle]);
 
             // Reset paCalls to special value to mark 1st call ever:
             audiodevices[pahandle].paCalls = 0xffffffffffffffff;
 
             // Start engine:
-            if ((err=Pa_StartStream(audiodevices[pahandle].stream))!=paNoError) {
+            if ((err=PsychPAStartStream(&audiodevices[pahandle]))!=paNoError) {
                 printf("PTB-ERROR: Failed to start audio device %i. PortAudio reports this error: %s \n", pahandle, Pa_GetErrorText(err));
                 PsychErrorExitMsg(PsychError_system, "Failed to start PortAudio audio device.");
             }
@@ -5044,7 +6225,7 @@ PsychError PSYCHPORTAUDIOStartAudioDevice(void)
 
     // Safety check for deadlock avoidance with waiting slaves:
     if ((waitForStart > 0) && (audiodevices[pahandle].opmode & kPortAudioIsSlave) &&
-        (!Pa_IsStreamActive(audiodevices[pahandle].stream) || Pa_IsStreamStopped(audiodevices[pahandle].stream) ||
+        (!PsychPAIsStreamActive(&audiodevices[pahandle]) || PsychPAIsStreamStopped(&audiodevices[pahandle]) ||
         audiodevices[audiodevices[pahandle].pamaster].state < 1)) {
         // We are a slave that shall wait for start, but the master audio device hasn't even
         // started its engine. This looks like a deadlock to avoid:
@@ -5060,7 +6241,7 @@ PsychError PSYCHPORTAUDIOStartAudioDevice(void)
         // We need to enter the first while() loop iteration with
         // the device lock held from above, so the while() loop will iterate at
         // least once...
-        while (audiodevices[pahandle].state == 1 && Pa_IsStreamActive(audiodevices[pahandle].stream)) {
+        while (audiodevices[pahandle].state == 1 && PsychPAIsStreamActive(&audiodevices[pahandle])) {
             // Wait for a state-change before reevaluating the .state:
             PsychPAWaitForChange(&audiodevices[pahandle]);
         }
@@ -5194,9 +6375,38 @@ PsychError PSYCHPORTAUDIOStopAudioDevice(void)
         stopTime = -1;
     }
 
+    // Purely asynchronous requests which neither wait for end of playback, nor block until stopped,
+    // are sent to a running engine via the lock-free command queue, if enabled:
+    if ((waitforend != 1) && (blockUntilStopped <= 0) && PsychPAUseCommandQueue(&audiodevices[pahandle])) {
+        psych_bool posted = TRUE;
+
+        if (repetitions >= 0)
+            posted = PsychPAPostCommand(&audiodevices[pahandle], kPsychPACmdRepetitions, 0, (repetitions == 0) ? -1 : repetitions, 0);
+
+        if (posted && (stopTime > 0))
+            posted = PsychPAPostCommand(&audiodevices[pahandle], kPsychPACmdStopTime, 0, stopTime, 0);
+
+        // Request soft stop (reqstate 0) or fast stop (reqstate 3), unless this is only a parameter update:
+        if (posted && (waitforend != 3))
+            posted = PsychPAPostCommand(&audiodevices[pahandle], kPsychPACmdReqState, (waitforend != 2) ? 0 : 3, 0, 0);
+
+        if (PsychPACommitCommands(&audiodevices[pahandle], posted)) {
+            // No block until stopped, so no meaningful return arguments available:
+            PsychCopyOutDoubleArg(1, kPsychArgOptional, -1);
+            PsychCopyOutDoubleArg(2, kPsychArgOptional, -1);
+            PsychCopyOutDoubleArg(3, kPsychArgOptional, -1);
+            PsychCopyOutDoubleArg(4, kPsychArgOptional, -1);
+
+            return(PsychError_none);
+        }
+    }
+
     // Lock device:
     PsychPALockDeviceMutex(&audiodevices[pahandle]);
 
+    // Apply pending commands first, so they can't override this request later:
+    PsychPAApplyCommands(&audiodevices[pahandle]);
+
     // New repetitions provided?
     if (repetitions >=0) {
         // Set number of requested repetitions: 0 means loop forever, default is 1 time.
@@ -5215,9 +6425,9 @@ PsychError PSYCHPORTAUDIOStopAudioDevice(void)
     // allowed if we have infinite repetitions set, but a finite stopTime is defined, so
     // the engine will eventually stop by itself. Same goes for an operative schedule which
     // will run empty if not regularly updated:
-    if ((waitforend == 1) && Pa_IsStreamActive(audiodevices[pahandle].stream) && (audiodevices[pahandle].state > 0) &&
+    if ((waitforend == 1) && PsychPAIsStreamActive(&audiodevices[pahandle]) && (audiodevices[pahandle].state > 0) &&
         (audiodevices[pahandle].opmode & kPortAudioPlayBack) && ((audiodevices[pahandle].repeatCount != -1) || (audiodevices[pahandle].schedule) || (audiodevices[pahandle].reqStopTime < DBL_MAX))) {
-        while ( ((audiodevices[pahandle].runMode == 0) && Pa_IsStreamActive(audiodevices[pahandle].stream) && (audiodevices[pahandle].state > 0)) ||
+        while ( ((audiodevices[pahandle].runMode == 0) && PsychPAIsStreamActive(&audiodevices[pahandle]) && (audiodevices[pahandle].state > 0)) ||
             ((audiodevices[pahandle].runMode == 1) && (audiodevices[pahandle].state > 0))) {
 
             // Wait for a state-change before reevaluating:
@@ -5247,7 +6457,7 @@ PsychError PSYCHPORTAUDIOStopAudioDevice(void)
             PsychPAUnlockDeviceMutex(&audiodevices[pahandle]);
 
             // If blockUntilStopped is non-zero, then explicitely stop as well:
-            if ((blockUntilStopped > 0) && (audiodevices[pahandle].runMode == 0) && (!Pa_IsStreamStopped(audiodevices[pahandle].stream)) && (err=Pa_StopStream(audiodevices[pahandle].stream))!=paNoError) {
+            if ((blockUntilStopped > 0) && (audiodevices[pahandle].runMode == 0) && (!PsychPAIsStreamStopped(&audiodevices[pahandle])) && (err=PsychPAStopStream(&audiodevices[pahandle]))!=paNoError) {
                 printf("PTB-ERROR: Failed to stop audio device %i. PortAudio reports this error: %s \n", pahandle, Pa_GetErrorText(err));
                 PsychErrorExitMsg(PsychError_system, "Failed to stop PortAudio audio device.");
             }
@@ -5266,7 +6476,7 @@ PsychError PSYCHPORTAUDIOStopAudioDevice(void)
             PsychPAUnlockDeviceMutex(&audiodevices[pahandle]);
 
             // If blockUntilStopped is non-zero, then send abort request to hardware:
-            if ((blockUntilStopped > 0) && (audiodevices[pahandle].runMode == 0) && (!Pa_IsStreamStopped(audiodevices[pahandle].stream)) && ((err=Pa_AbortStream(audiodevices[pahandle].stream))!=paNoError)) {
+            if ((blockUntilStopped > 0) && (audiodevices[pahandle].runMode == 0) && (!PsychPAIsStreamStopped(&audiodevices[pahandle])) && ((err=PsychPAAbortStream(&audiodevices[pahandle]))!=paNoError)) {
                 printf("PTB-ERROR: Failed to abort audio device %i. PortAudio reports this error: %s \n", pahandle, Pa_GetErrorText(err));
                 PsychErrorExitMsg(PsychError_system, "Failed to fast stop (abort) PortAudio audio device.");
             }
@@ -5281,8 +6491,8 @@ PsychError PSYCHPORTAUDIOStopAudioDevice(void)
         PsychPALockDeviceMutex(&audiodevices[pahandle]);
 
         // Wait for stop / idle:
-        if (Pa_IsStreamActive(audiodevices[pahandle].stream)) {
-            while ( ((audiodevices[pahandle].runMode == 0) && Pa_IsStreamActive(audiodevices[pahandle].stream) && (audiodevices[pahandle].state > 0)) ||
+        if (PsychPAIsStreamActive(&audiodevices[pahandle])) {
+            while ( ((audiodevices[pahandle].runMode == 0) && PsychPAIsStreamActive(&audiodevices[pahandle]) && (audiodevices[pahandle].state > 0)) ||
                 ((audiodevices[pahandle].runMode == 1) && (audiodevices[pahandle].state > 0))) {
 
                 // Wait for a state-change before reevaluating:
@@ -5396,7 +6606,23 @@ PsychError PSYCHPORTAUDIOGetStatus(void)
     "InDeviceIndex: Is the deviceindex of the capture device, or -1 if not opened for capture.\n"
     "RecordedSecs: Is the total amount of recorded sound data (in seconds) since start of capture.\n"
     "ReadSecs: Is the total amount of sound data (in seconds) that has been fetched from the internal buffer. "
-    "The difference between RecordedSecs and ReadSecs is the amount of recorded sound data pending for retrieval. ";
+    "The difference between RecordedSecs and ReadSecs is the amount of recorded sound data pending for retrieval.\n"
+    "MaxLockWait: Is the longest time in seconds that the audio callback had to wait for access to the devices "
+    "internal data, because it was locked by some other operation, since start of playback or capture.\n"
+    "LockWaitHistogram: A 16 element histogram of these wait times. The first bin counts waits of less than 1 "
+    "microsecond, bin i (counting from zero) counts waits of at least 2^(i-1) and less than 2^i microseconds, the "
+    "last bin all waits of 16384 microseconds or longer.\n"
+    "LockMisses: With the lock-free command queue enabled via PsychPortAudio('EngineTunables'), the audio callback "
+    "never blocks on the lock. If the lock stays busy for more than a tenth of the buffer duration, it skips "
+    "processing of that buffer and outputs silence. This counts the number of skipped buffers. The sound data "
+    "of the skipped sample frames is lost, but playback continues at the position and schedule slot where it would be "
+    "without the skip, so the timing of the remaining sound is unaffected.\n"
+    "LockMissFrames: The total number of sample frames in these skipped buffers.\n"
+    "MaxExecTime: Is the longest execution time of the audio callback in seconds, since start of playback or "
+    "capture. For master devices, this includes processing of all attached slaves.\n"
+    "ExecTimeHistogram: A 16 element histogram of execution times, with the same bins as LockWaitHistogram.\n"
+    "Inserts: Number of filters in the insert chain of the device, as added via 'AddInsert'.\n"
+    "InsertLatency: Latency in seconds which the insert chain adds to the sound output of the device.\n";
 
     static char seeAlsoString[] = "Open GetDeviceSettings ";
     PsychGenericScriptType     *status;
@@ -5406,8 +6632,11 @@ PsychError PSYCHPORTAUDIOGetStatus(void)
 
     const char *FieldNames[]={    "Active", "State", "RequestedStartTime", "StartTime", "CaptureStartTime", "RequestedStopTime", "EstimatedStopTime", "CurrentStreamTime", "ElapsedOutSamples", "PositionSecs", "RecordedSecs", "ReadSecs", "SchedulePosition",
         "XRuns", "TotalCalls", "TimeFailed", "BufferSize", "CPULoad", "PredictedLatency", "LatencyBias", "SampleRate",
-        "OutDeviceIndex", "InDeviceIndex" };
+        "OutDeviceIndex", "InDeviceIndex", "MaxLockWait", "LockWaitHistogram", "LockMisses", "LockMissFrames", "MaxExecTime", "ExecTimeHistogram", "Inserts", "InsertLatency" };
     int pahandle = -1;
+    PsychGenericScriptType *outMat;
+    double *v;
+    int i, nrInserts, insertLatency;
 
     // Setup online help:
     PsychPushHelp(useString, synopsisString, seeAlsoString);
@@ -5423,7 +6652,7 @@ PsychError PSYCHPORTAUDIOGetStatus(void)
     PsychCopyInIntegerArg(1, kPsychArgRequired, &pahandle);
     if (pahandle < 0 || pahandle>=MAX_PSYCH_AUDIO_DEVS || audiodevices[pahandle].stream == NULL) PsychErrorExitMsg(PsychError_user, "Invalid audio device handle provided.");
 
-    PsychAllocOutStructArray(1, kPsychArgOptional, -1, 23, FieldNames, &status);
+    PsychAllocOutStructArray(1, kPsychArgOptional, -1, 31, FieldNames, &status);
 
     // Ok, in a perfect world we should hold the device mutex while querying all the device state.
     // However, we don't: This reduces lock contention at the price of a small chance that the
@@ -5458,12 +6687,32 @@ PsychError PSYCHPORTAUDIOGetStatus(void)
     PsychSetStructArrayDoubleElement("TotalCalls", 0, nrtotalcalls, status);
     PsychSetStructArrayDoubleElement("TimeFailed", 0, nrnotime, status);
     PsychSetStructArrayDoubleElement("BufferSize", 0, (double) audiodevices[pahandle].batchsize, status);
-    PsychSetStructArrayDoubleElement("CPULoad", 0, (Pa_IsStreamActive(audiodevices[pahandle].stream)) ? Pa_GetStreamCpuLoad(audiodevices[pahandle].stream) : 0.0, status);
+    PsychSetStructArrayDoubleElement("CPULoad", 0, (PsychPAIsStreamActive(&audiodevices[pahandle])) ? PsychPAGetStreamCpuLoad(&audiodevices[pahandle]) : 0.0, status);
     PsychSetStructArrayDoubleElement("PredictedLatency", 0, audiodevices[pahandle].predictedLatency, status);
     PsychSetStructArrayDoubleElement("LatencyBias", 0, audiodevices[pahandle].latencyBias, status);
     PsychSetStructArrayDoubleElement("SampleRate", 0, audiodevices[pahandle].streaminfo->sampleRate, status);
     PsychSetStructArrayDoubleElement("OutDeviceIndex", 0, audiodevices[pahandle].outdeviceidx, status);
     PsychSetStructArrayDoubleElement("InDeviceIndex", 0, audiodevices[pahandle].indeviceidx, status);
+
+    PsychSetStructArrayDoubleElement("LockMisses", 0, (double) audiodevices[pahandle].lockMisses, status);
+    PsychSetStructArrayDoubleElement("LockMissFrames", 0, (double) audiodevices[pahandle].lockMissFrames, status);
+    PsychSetStructArrayDoubleElement("MaxLockWait", 0, audiodevices[pahandle].maxLockWait, status);
+    v = NULL;
+    PsychAllocateNativeDoubleMat(1, PSYCH_PA_TIMING_HISTOGRAM_BINS, 1, &v, &outMat);
+    for (i = 0; i < PSYCH_PA_TIMING_HISTOGRAM_BINS; i++) v[i] = (double) audiodevices[pahandle].lockWaitHistogram[i];
+    PsychSetStructArrayNativeElement("LockWaitHistogram", 0, outMat, status);
+
+    PsychSetStructArrayDoubleElement("MaxExecTime", 0, audiodevices[pahandle].maxExecTime, status);
+    v = NULL;
+    PsychAllocateNativeDoubleMat(1, PSYCH_PA_TIMING_HISTOGRAM_BINS, 1, &v, &outMat);
+    for (i = 0; i < PSYCH_PA_TIMING_HISTOGRAM_BINS; i++) v[i] = (double) audiodevices[pahandle].execTimeHistogram[i];
+    PsychSetStructArrayNativeElement("ExecTimeHistogram", 0, outMat, status);
+
+    // The insert chain is only modified by our thread, so no need for locking:
+    nrInserts = PsychPAGetDSPChainLength(audiodevices[pahandle].dspChain, &insertLatency);
+    PsychSetStructArrayDoubleElement("Inserts", 0, (double) nrInserts, status);
+    PsychSetStructArrayDoubleElement("InsertLatency", 0, (double) insertLatency / (double) audiodevices[pahandle].streaminfo->sampleRate, status);
+
     return(PsychError_none);
 }
 
@@ -5584,7 +6833,7 @@ PsychError PSYCHPORTAUDIOLatencyBias(void)
     // Set new bias, if one was provided:
     if (bias!=DBL_MAX) {
         if (audiodevices[pahandle].opmode & kPortAudioIsSlave) PsychErrorExitMsg(PsychError_user, "Change of latency bias is not allowed on slave devices! Set it on associated master device.");
-        if (Pa_IsStreamActive(audiodevices[pahandle].stream) && (audiodevices[pahandle].state > 0)) PsychErrorExitMsg(PsychError_user, "Tried to change 'biasSecs' while device is active! Forbidden!");
+        if (PsychPAIsStreamActive(&audiodevices[pahandle]) && (audiodevices[pahandle].state > 0)) PsychErrorExitMsg(PsychError_user, "Tried to change 'biasSecs' while device is active! Forbidden!");
         audiodevices[pahandle].latencyBias = bias;
     }
 
@@ -5680,11 +6929,22 @@ PsychError PSYCHPORTAUDIOVolume(void)
             // Valid?
             if (m * n != audiodevices[pahandle].outchannels || p != 1) PsychErrorExitMsg(PsychError_user, "Invalid channelVolumes vector for audio slave device provided. Number of elements doesn't match number of audio output channels!");
 
-            // Assign, but with device mutex of master device held, so we don't update in
-            // the middle of a mix cycle for our slave device:
-            PsychPALockDeviceMutex(&audiodevices[audiodevices[pahandle].pamaster]);
-            for (i = 0; i < audiodevices[pahandle].outchannels; i++) audiodevices[pahandle].outChannelVolumes[i]  = (float) channelVolumes[i];
-            PsychPAUnlockDeviceMutex(&audiodevices[audiodevices[pahandle].pamaster]);
+            // Send all new volumes to the running slave in one go via the lock-free command queue, if enabled:
+            i = 0;
+            if (PsychPAUseCommandQueue(&audiodevices[pahandle])) {
+                for (i = 0; i < audiodevices[pahandle].outchannels; i++)
+                    if (!PsychPAPostCommand(&audiodevices[pahandle], kPsychPACmdChannelVolume, i, channelVolumes[i], 0)) break;
+            }
+
+            if (!PsychPACommitCommands(&audiodevices[pahandle], (i > 0) && (i == audiodevices[pahandle].outchannels))) {
+                // Assign, but with device mutex of master device held, so we don't update in
+                // the middle of a mix cycle for our slave device. Apply pending commands first,
+                // so they can't override our new settings later:
+                PsychPALockDeviceMutex(&audiodevices[audiodevices[pahandle].pamaster]);
+                PsychPAApplyCommands(&audiodevices[pahandle]);
+                for (i = 0; i < audiodevices[pahandle].outchannels; i++) audiodevices[pahandle].outChannelVolumes[i]  = (float) channelVolumes[i];
+                PsychPAUnlockDeviceMutex(&audiodevices[audiodevices[pahandle].pamaster]);
+            }
         }
     }
     else {
@@ -5862,7 +7122,7 @@ PsychError PSYCHPORTAUDIORunMode(void)
         if (audiodevices[pahandle].opmode & kPortAudioIsSlave) PsychErrorExitMsg(PsychError_user, "Change of runmode is not allowed on slave devices!");
 
         // Stop engine if it is running:
-        if (!Pa_IsStreamStopped(audiodevices[pahandle].stream)) Pa_StopStream(audiodevices[pahandle].stream);
+        if (!PsychPAIsStreamStopped(&audiodevices[pahandle])) PsychPAStopStream(&audiodevices[pahandle]);
 
         // Reset state:
         audiodevices[pahandle].state = 0;
@@ -5941,8 +7201,14 @@ PsychError PSYCHPORTAUDIOSetLoop(void)
 
     if (endSample < startSample) PsychErrorExitMsg(PsychError_user, "Invalid 'endSample' provided. Must be greater or equal than 'startSample'!");
 
-    // Ok, range is valid. Assign it:
+    // Ok, range is valid. Send it to a running engine via the lock-free command queue, if enabled:
+    if (PsychPAUseCommandQueue(&audiodevices[pahandle]) &&
+        PsychPACommitCommands(&audiodevices[pahandle], PsychPAPostCommand(&audiodevices[pahandle], kPsychPACmdLoop, 0, startSample, endSample)))
+        return(PsychError_none);
+
+    // Otherwise assign it, after applying pending commands:
     PsychPALockDeviceMutex(&audiodevices[pahandle]);
+    PsychPAApplyCommands(&audiodevices[pahandle]);
     audiodevices[pahandle].loopStartFrame = (psych_int64) startSample;
     audiodevices[pahandle].loopEndFrame = (psych_int64) endSample;
     PsychPAUnlockDeviceMutex(&audiodevices[pahandle]);
@@ -5954,7 +7220,7 @@ PsychError PSYCHPORTAUDIOSetLoop(void)
  */
 PsychError PSYCHPORTAUDIOEngineTunables(void)
 {
-    static char useString[] = "[oldyieldInterval, oldMutexEnable, lockToCore1, audioserver_autosuspend, workarounds] = PsychPortAudio('EngineTunables' [, yieldInterval][, MutexEnable][, lockToCore1][, audioserver_autosuspend][, workarounds]);";
+    static char useString[] = "[oldyieldInterval, oldMutexEnable, lockToCore1, audioserver_autosuspend, workarounds, mixKernels, slaveWorkerThreads, commandQueue] = PsychPortAudio('EngineTunables' [, yieldInterval][, MutexEnable][, lockToCore1][, audioserver_autosuspend][, workarounds][, mixKernels][, slaveWorkerThreads][, commandQueue]);";
     static char synopsisString[] =
     "Return, and optionally set low-level tuneable driver parameters.\n"
     "The driver must be idle, ie., no audio device must be open, if you want to change tuneables! "
@@ -5985,20 +7251,45 @@ PsychError PSYCHPORTAUDIOEngineTunables(void)
     "session is active. Sometimes this isn't needed or not even desireable. Therefore this option "
     "allows to inhibit this automatic suspending of audio servers.\n"
     "'workarounds' A bitmask to enable various workarounds: +1 = Ignore Pa_IsFormatSupported() errors, "
-    "+2 = Don't even call Pa_IsFormatSupported().\n";
+    "+2 = Don't even call Pa_IsFormatSupported().\n"
+    "'mixKernels' Implementation of the sample processing kernels used for mixing, volume control and "
+    "AM modulation: -1 = Auto-select the fastest one supported by the cpu (default), 0 = Portable scalar code, "
+    "1 = SSE2, 2 = AVX, 3 = NEON. Requesting an implementation that the cpu doesn't support selects the "
+    "scalar code. The return value is the currently active implementation. All implementations produce "
+    "identical results, so this is only useful for performance comparisons or to work around bugs.\n"
+    "'slaveWorkerThreads' Number of realtime worker threads for parallel rendering of the slave devices of "
+    "each master device opened afterwards. Default is 0 for rendering all slaves serially on the audio "
+    "callback thread of the master. With a setting n > 0, the audio thread and n worker threads render "
+    "independent slaves in parallel on multiple cpu cores, and the audio thread then mixes all slave output "
+    "in the same fixed order as with serial rendering, so the sound output is identical. Timing, schedules "
+    "and all other per-slave behaviour are unaffected. Worth it if many slaves are active at the same time, "
+    "or if slaves use expensive processing. Valid are values between 0 and 64. Workers are pinned to "
+    "individual cpu cores on Linux and Windows. Requires 'MutexEnable' to be enabled.\n"
+    "'commandQueue' Enable (1) or Disable (0) lock-free command queues for devices opened afterwards. Default "
+    "is 0. If enabled, changes of 'channelVolumes' via 'Volume', of the playloop via 'SetLoop', and 'Stop' "
+    "requests which don't wait for the end of playback and don't block until stopped, are sent to running "
+    "devices via a lock-free queue, instead of locking the device. The audio callback applies them at the "
+    "start of its next buffer, and never waits for the calling script: If the device is locked by some other "
+    "operation for more than a tenth of a buffer duration, the callback outputs silence for that buffer, see "
+    "the 'LockMisses' field of 'GetStatus'. Playback then continues where it would be without the skipped buffer. "
+    "This can reduce timing jitter of the audio callback if a script updates such settings at a high rate, see the "
+    "'MaxLockWait' and 'LockWaitHistogram' fields of 'GetStatus'. Other operations on a running device, e.g., "
+    "'FillBuffer', 'AddToSchedule', 'GetStatus' or a blocking 'Stop', still lock it, but only for bookkeeping, not "
+    "while copying sound data or waiting. On a heavily loaded system they can still cause an occasional skipped "
+    "buffer, ie., an audible glitch. Requires 'MutexEnable' to be enabled.\n";
 
     static char seeAlsoString[] = "Open ";
 
-    int mutexenable, mylockToCore1, mysuspend, myworkaroundsMask;
+    int mutexenable, mylockToCore1, mysuspend, myworkaroundsMask, mymixKernels, myslaveWorkerThreads, mycommandQueue;
     double myyieldInterval;
 
     // Setup online help:
     PsychPushHelp(useString, synopsisString, seeAlsoString);
     if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none); };
 
-    PsychErrorExit(PsychCapNumInputArgs(5));     // The maximum number of inputs
+    PsychErrorExit(PsychCapNumInputArgs(8));     // The maximum number of inputs
     PsychErrorExit(PsychRequireNumInputArgs(0)); // The required number of inputs
-    PsychErrorExit(PsychCapNumOutputArgs(5));    // The maximum number of outputs
+    PsychErrorExit(PsychCapNumOutputArgs(8));    // The maximum number of outputs
 
     // Make sure no settings are changed while an audio device is open:
     if ((PsychGetNumInputArgs() > 0) && (audiodevicecount > 0))
@@ -6059,6 +7350,49 @@ PsychError PSYCHPORTAUDIOEngineTunables(void)
         if (verbosity > 3) printf("PsychPortAudio: INFO: Setting workaroundsMask to %i.\n", workaroundsMask);
     }
 
+    // Return currently active mix kernels. Make sure they are selected if we're not yet initialized:
+    if (!pa_initialized) PsychPASelectMixKernels(mixKernelsRequest);
+    PsychCopyOutDoubleArg(6, kPsychArgOptional, (double) psychPAMix.id);
+
+    // Get optional new mix kernels selection:
+    if (PsychCopyInIntegerArg(6, kPsychArgOptional, &mymixKernels)) {
+        if (mymixKernels < kPsychPAMixKernelsAuto || mymixKernels > kPsychPAMixKernelsNEON)
+            PsychErrorExitMsg(PsychError_user, "Invalid setting for 'mixKernels' provided. Valid are -1 to 3.");
+
+        mixKernelsRequest = mymixKernels;
+        PsychPASelectMixKernels(mixKernelsRequest);
+
+        if (verbosity > 3) printf("PsychPortAudio: INFO: Using %s sample mixing kernels.\n", psychPAMix.name);
+    }
+
+    // Return current/old number of slave worker threads:
+    PsychCopyOutDoubleArg(7, kPsychArgOptional, (double) slaveWorkerThreads);
+
+    // Get optional new number of slave worker threads:
+    if (PsychCopyInIntegerArg(7, kPsychArgOptional, &myslaveWorkerThreads)) {
+        if (myslaveWorkerThreads < 0 || myslaveWorkerThreads > MAX_PSYCH_AUDIO_SLAVE_WORKERS)
+            PsychErrorExitMsg(PsychError_user, "Invalid setting for 'slaveWorkerThreads' provided. Valid are 0 to 64.");
+
+        slaveWorkerThreads = myslaveWorkerThreads;
+
+        if (verbosity > 3) {
+            if (slaveWorkerThreads > 0)
+                printf("PsychPortAudio: INFO: Slaves of new master devices will be rendered in parallel on %i worker threads.\n", slaveWorkerThreads);
+            else
+                printf("PsychPortAudio: INFO: Slaves of new master devices will be rendered serially.\n");
+        }
+    }
+
+    // Return current/old command queue enable:
+    PsychCopyOutDoubleArg(8, kPsychArgOptional, (double) ((useCommandQueue) ? 1 : 0));
+
+    // Get optional new command queue enable:
+    if (PsychCopyInIntegerArg(8, kPsychArgOptional, &mycommandQueue)) {
+        if (mycommandQueue < 0 || mycommandQueue > 1) PsychErrorExitMsg(PsychError_user, "Invalid setting for 'commandQueue' provided. Valid are 0 and 1.");
+        useCommandQueue = (mycommandQueue > 0) ? TRUE : FALSE;
+        if (verbosity > 3) printf("PsychPortAudio: INFO: Lock-free command queues for new devices %s.\n", (useCommandQueue) ? "enabled" : "disabled");
+    }
+
     return(PsychError_none);
 }
 
@@ -6112,7 +7446,7 @@ PsychError PSYCHPORTAUDIOUseSchedule(void)
     // Make sure the device is fully idle: We can check without mutex held, as a device which is
     // already idle (state == 0) can't switch by itself out of idle state (state > 0), neither
     // can an inactive stream start itself.
-    if ((audiodevices[pahandle].state > 0) && Pa_IsStreamActive(audiodevices[pahandle].stream)) PsychErrorExitMsg(PsychError_user, "Tried to enable/disable audio schedule while audio device is active. Forbidden! Call 'Stop' first.");
+    if ((audiodevices[pahandle].state > 0) && PsychPAIsStreamActive(&audiodevices[pahandle])) PsychErrorExitMsg(PsychError_user, "Tried to enable/disable audio schedule while audio device is active. Forbidden! Call 'Stop' first.");
 
     // At this point the deivce is idle and will remain so during this routines execution,
     // so it won't touch any of the schedule related variables and we can manipulate them
@@ -6451,7 +7785,7 @@ PsychError PSYCHPORTAUDIOSetOpMode(void)
     // Set new opMode, if one was provided:
     if (opMode != -1) {
         // Stop engine if it is running:
-        if (!Pa_IsStreamStopped(audiodevices[pahandle].stream)) Pa_StopStream(audiodevices[pahandle].stream);
+        if (!PsychPAIsStreamStopped(&audiodevices[pahandle])) PsychPAStopStream(&audiodevices[pahandle]);
 
         // Reset state:
         audiodevices[pahandle].state = 0;
@@ -6555,7 +7889,7 @@ PsychError PSYCHPORTAUDIODirectInputMonitoring(void)
     if (PsychCopyInIntegerArg(3, kPsychArgOptional, &inputChannel)) {
         // Find out how many real input channels the device has and check provided index against them:
         padev = Pa_GetDeviceInfo((PaDeviceIndex) audiodevices[pahandle].indeviceidx);
-        if (inputChannel < -1 || inputChannel >= (int) padev->maxInputChannels) PsychErrorExitMsg(PsychError_user, "Invalid inputChannel provided. No such input channel available on device!");
+        if (!padev || inputChannel < -1 || inputChannel >= (int) padev->maxInputChannels) PsychErrorExitMsg(PsychError_user, "Invalid inputChannel provided. No such input channel available on device!");
     }
     else {
         inputChannel = -1;
@@ -6565,7 +7899,7 @@ PsychError PSYCHPORTAUDIODirectInputMonitoring(void)
     if (PsychCopyInIntegerArg(4, kPsychArgOptional, &outputChannel)) {
         // Find out how many real output channels the device has and check provided index against them:
         padev = Pa_GetDeviceInfo((PaDeviceIndex) audiodevices[pahandle].outdeviceidx);
-        if (outputChannel < 0 || outputChannel >= (int) padev->maxOutputChannels) PsychErrorExitMsg(PsychError_user, "Invalid outputChannel provided. No such outputChannel channel available on device!");
+        if (!padev || outputChannel < 0 || outputChannel >= (int) padev->maxOutputChannels) PsychErrorExitMsg(PsychError_user, "Invalid outputChannel provided. No such outputChannel channel available on device!");
     }
     else {
         outputChannel = 0;
@@ -6651,3 +7985,206 @@ PsychError PSYCHPORTAUDIODirectInputMonitoring(void)
 
     return(PsychError_none);
 }
+
+/* PsychPortAudio('SlaveSampleRate') - Set own samplerate of a slave device.
+ */
+PsychError PSYCHPORTAUDIOSlaveSampleRate(void)
+{
+    static char useString[] = "oldRate = PsychPortAudio('SlaveSampleRate', pahandle [, sampleRate]);";
+    static char synopsisString[] =
+    "Set the samplerate of playback slave device 'pahandle' to 'sampleRate' Hz, and/or return its current samplerate 'oldRate'.\n"
+    "By default, a slave device plays sound at the samplerate of its master device. If you assign a different "
+    "'sampleRate', the sound of the slave gets converted to the samplerate of the master in realtime by a "
+    "high quality polyphase sample rate converter, so you can play sounds prepared for different samplerates "
+    "simultaneously on one sound card, without resampling them beforehand. All sound data, positions and timing "
+    "values of the slave, e.g., in 'FillBuffer', 'GetStatus' or 'SetLoop', are then expressed at its new "
+    "samplerate. Start and stop times are still exact, as the converter compensates for its own processing delay.\n"
+    "'sampleRate' must be within a factor of 8 of the masters samplerate. Assigning the masters samplerate "
+    "disables conversion again. The samplerate can only be changed while the slave is stopped, and only on "
+    "regular playback slaves, not on AM modulators, output capture slaves or slaves with audio capture.\n"
+    "Conversion costs cpu time for each active slave, so use it only if your sounds actually need it.\n";
+    static char seeAlsoString[] = "OpenSlave GetStatus ";
+
+    int pahandle = -1;
+    int pamaster;
+    double sampleRate, masterRate;
+    PsychPAResampler* resampler;
+    PsychPAResampler* oldResampler;
+
+    // Setup online help:
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(2));     // The maximum number of inputs
+    PsychErrorExit(PsychRequireNumInputArgs(1)); // The required number of inputs
+    PsychErrorExit(PsychCapNumOutputArgs(1));    // The maximum number of outputs
+
+    // Make sure PortAudio is online:
+    PsychPortAudioInitialize();
+
+    PsychCopyInIntegerArg(1, kPsychArgRequired, &pahandle);
+    if (pahandle < 0 || pahandle>=MAX_PSYCH_AUDIO_DEVS || audiodevices[pahandle].stream == NULL) PsychErrorExitMsg(PsychError_user, "Invalid audio device handle provided.");
+
+    // Return current samplerate:
+    PsychCopyOutDoubleArg(1, kPsychArgOptional, audiodevices[pahandle].streaminfo->sampleRate);
+
+    if (!PsychCopyInDoubleArg(2, kPsychArgOptional, &sampleRate)) return(PsychError_none);
+
+    if (!(audiodevices[pahandle].opmode & kPortAudioIsSlave) || !(audiodevices[pahandle].opmode & kPortAudioPlayBack) ||
+        (audiodevices[pahandle].opmode & (kPortAudioCapture | kPortAudioMonitoring | kPortAudioIsAMModulator | kPortAudioIsOutputCapture)))
+        PsychErrorExitMsg(PsychError_user, "Samplerate can only be changed on regular playback slave devices, not on other types of devices.");
+
+    if (audiodevices[pahandle].state > 0) PsychErrorExitMsg(PsychError_user, "Tried to change samplerate of slave device while it is active! Forbidden! Stop it first.");
+
+    pamaster = audiodevices[pahandle].pamaster;
+    masterRate = audiodevices[pamaster].streaminfo->sampleRate;
+    if ((sampleRate < masterRate / 8) || (sampleRate > masterRate * 8)) {
+        printf("PTB-ERROR: Requested samplerate %f Hz is not within a factor of 8 of the masters samplerate %f Hz.\n", sampleRate, masterRate);
+        PsychErrorExitMsg(PsychError_user, "Invalid 'sampleRate' provided.");
+    }
+
+    // Conversion needed?
+    resampler = NULL;
+    if (sampleRate != masterRate) {
+        resampler = PsychPACreateResampler((int) audiodevices[pahandle].outchannels, sampleRate, masterRate, PSYCH_PA_SRC_CHUNK);
+        if (NULL == resampler) PsychErrorExitMsg(PsychError_outofMemory, "Failed to create sample rate converter for slave device.");
+    }
+
+    // Swap converter and stream info with the masters mutex held, so the master doesn't render us meanwhile:
+    PsychPALockDeviceMutex(&audiodevices[pamaster]);
+    oldResampler = audiodevices[pahandle].resampler;
+    audiodevices[pahandle].resampler = resampler;
+    if (resampler) {
+        audiodevices[pahandle].resampledStreamInfo = *(audiodevices[pamaster].streaminfo);
+        audiodevices[pahandle].resampledStreamInfo.sampleRate = sampleRate;
+        audiodevices[pahandle].streaminfo = &(audiodevices[pahandle].resampledStreamInfo);
+    }
+    else {
+        audiodevices[pahandle].streaminfo = audiodevices[pamaster].streaminfo;
+    }
+    PsychPAUnlockDeviceMutex(&audiodevices[pamaster]);
+
+    PsychPADeleteResampler(oldResampler);
+
+    return(PsychError_none);
+}
+
+/* PsychPortAudio('AddInsert') - Append a filter to the insert chain of a device.
+ */
+PsychError PSYCHPORTAUDIOAddInsert(void)
+{
+    static char useString[] = "nrInserts = PsychPortAudio('AddInsert', pahandle, type, coefficients);";
+    static char synopsisString[] =
+    "Append a realtime filter to the insert chain of playback device 'pahandle', and return the total number "
+    "of filters 'nrInserts' in its chain.\n"
+    "Inserts process the sound output of a device, after all its sound data, volume settings and AM modulation "
+    "has been applied, e.g., for equalization of headphones or speakers, or to apply filtering to all sounds "
+    "of a slave. Inserts of a slave filter only that slaves sound, inserts of a master or regular device filter "
+    "the final sound output to the hardware. Multiple inserts are applied in the order in which they were added. "
+    "Inserts are applied to all output channels of the device.\n"
+    "'type' selects the type of filter:\n"
+    "'biquad' A cascade of biquad IIR filter sections. 'coefficients' is a n-by-6 matrix with one row "
+    "[b0 b1 b2 a0 a1 a2] per section, e.g., as returned by tf2sos() or zp2sos(). Up to 64 sections are "
+    "supported. Biquads don't add any latency.\n"
+    "'fir' A FIR filter with up to 96000 taps. 'coefficients' is a row vector of filter taps to apply to all "
+    "channels, or a matrix with one row of taps per output channel. Filters with up to 64 taps are applied "
+    "directly without added latency. Longer filters use fast FFT convolution, which adds a latency of 64 "
+    "sample frames to the sound output, as reported by 'GetStatus' in the 'InsertLatency' field.\n"
+    "Filters are computed in single precision floating point. Their computational cost counts towards the "
+    "'CPULoad' of the device, so check that your setup doesn't overload the system, especially with long FIR "
+    "filters on many channels or slaves. You can add inserts at any time, also while the device is playing, but "
+    "a filter starts with a silent history, so expect a short transient on a running device.\n";
+    static char seeAlsoString[] = "DeleteInserts GetStatus OpenSlave ";
+
+    int pahandle = -1;
+    int m, n, p;
+    char* type;
+    double* coeffs;
+    const char* errmsg = NULL;
+    PsychPADSPStage* stage = NULL;
+    int nrInserts;
+
+    // Setup online help:
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(3));     // The maximum number of inputs
+    PsychErrorExit(PsychRequireNumInputArgs(3)); // The required number of inputs
+    PsychErrorExit(PsychCapNumOutputArgs(1));    // The maximum number of outputs
+
+    // Make sure PortAudio is online:
+    PsychPortAudioInitialize();
+
+    PsychCopyInIntegerArg(1, kPsychArgRequired, &pahandle);
+    if (pahandle < 0 || pahandle>=MAX_PSYCH_AUDIO_DEVS || audiodevices[pahandle].stream == NULL) PsychErrorExitMsg(PsychError_user, "Invalid audio device handle provided.");
+    if (((audiodevices[pahandle].opmode & kPortAudioPlayBack) == 0) || (audiodevices[pahandle].opmode & kPortAudioIsAMModulator))
+        PsychErrorExitMsg(PsychError_user, "Inserts are only supported on playback devices, excluding AM modulator slaves.");
+
+    PsychAllocInCharArg(2, kPsychArgRequired, &type);
+    PsychAllocInDoubleMatArg(3, kPsychArgRequired, &m, &n, &p, &coeffs);
+    if (p != 1) PsychErrorExitMsg(PsychError_user, "Invalid 'coefficients' provided. Must be a 2D matrix.");
+
+    if (PsychMatch(type, "biquad")) {
+        if (n != 6) PsychErrorExitMsg(PsychError_user, "Invalid biquad 'coefficients' provided. Must be a matrix with 6 columns.");
+        stage = PsychPACreateBiquadStage((int) audiodevices[pahandle].outchannels, m, coeffs, &errmsg);
+    }
+    else if (PsychMatch(type, "fir")) {
+        stage = PsychPACreateFIRStage((int) audiodevices[pahandle].outchannels, m, n, coeffs, &errmsg);
+    }
+    else {
+        printf("PTB-ERROR: Unknown insert type '%s'. Must be 'biquad' or 'fir'.\n", type);
+        PsychErrorExitMsg(PsychError_user, "Invalid insert 'type' provided.");
+    }
+
+    if (NULL == stage) {
+        printf("PTB-ERROR: %s\n", errmsg);
+        PsychErrorExitMsg(PsychError_user, "Failed to create insert.");
+    }
+
+    // Append the fully initialized stage to the tail of the chain with a single atomic pointer store,
+    // so the audio thread can keep processing the chain meanwhile. We are the only thread which
+    // modifies the chain:
+    PsychPAAtomicStorePtr(PsychPAGetDSPChainTail((PsychPADSPStage**) &(audiodevices[pahandle].dspChain)), stage);
+
+    nrInserts = PsychPAGetDSPChainLength(audiodevices[pahandle].dspChain, NULL);
+
+    PsychCopyOutDoubleArg(1, kPsychArgOptional, (double) nrInserts);
+
+    return(PsychError_none);
+}
+
+/* PsychPortAudio('DeleteInserts') - Delete the insert chain of a device.
+ */
+PsychError PSYCHPORTAUDIODeleteInserts(void)
+{
+    static char useString[] = "PsychPortAudio('DeleteInserts', pahandle);";
+    static char synopsisString[] =
+    "Delete all inserts of device 'pahandle', as added via 'AddInsert'. Sound output continues unfiltered.\n";
+    static char seeAlsoString[] = "AddInsert ";
+
+    int pahandle = -1;
+    PsychPADSPStage* chain;
+
+    // Setup online help:
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(1));     // The maximum number of inputs
+    PsychErrorExit(PsychRequireNumInputArgs(1)); // The required number of inputs
+    PsychErrorExit(PsychCapNumOutputArgs(0));    // The maximum number of outputs
+
+    // Make sure PortAudio is online:
+    PsychPortAudioInitialize();
+
+    PsychCopyInIntegerArg(1, kPsychArgRequired, &pahandle);
+    if (pahandle < 0 || pahandle>=MAX_PSYCH_AUDIO_DEVS || audiodevices[pahandle].stream == NULL) PsychErrorExitMsg(PsychError_user, "Invalid audio device handle provided.");
+
+    // Detach chain via atomic exchange, then wait for the audio thread to finish processing it, if it
+    // is processing it right now, before releasing it here on the interpreter thread:
+    chain = PsychPAAtomicExchangePtr(&(audiodevices[pahandle].dspChain), NULL);
+    while (chain && (PsychPAAtomicLoadPtr(&(audiodevices[pahandle].dspChainInUse)) == chain)) PsychYieldIntervalSeconds(yieldInterval);
+
+    PsychPADeleteDSPChain(chain);
+
+    return(PsychError_none);
+}
@@ -91,5 +91,11 @@ PsychError PSYCHPORTAUDIOSetOpMode(void);
 PsychError PSYCHPORTAUDIODirectInputMonitoring(void);
 // Set per-device volume:
 PsychError PSYCHPORTAUDIOVolume(void);
+// Set own samplerate of slave device:
+PsychError PSYCHPORTAUDIOSlaveSampleRate(void);
+// Append filter to insert chain of device:
+PsychError PSYCHPORTAUDIOAddInsert(void);
+// Delete insert chain of device:
+PsychError PSYCHPORTAUDIODeleteInserts(void);
 //end include once
 #endif
@@ -668,6 +668,543 @@ void PsychWaitPixelSyncToken(PsychWindowRecordType *windowRecord, psych_bool flu
     if (flushOnly && (PsychPrefStateGet_Verbosity() > 15)) printf("PTB-DEBUG: PixelSyncToken write + glFlush().\n");
 }
 
+/* PsychMapStreamingVBO()
+ *
+ * Get cpu write access to 'size' bytes of memory in the streaming vertex buffer object of
+ * the OpenGL context of 'windowRecord', for vertex data of batch drawing functions like
+ * 'DrawDots' and 'DrawLines'. The VBO is bound as GL_ARRAY_BUFFER on return, so calls to
+ * gl*Pointer() take byte offsets into the VBO instead of pointers. The offset of the returned
+ * memory is stored in '*offset'. After writing the data, PsychUnmapStreamingVBO() must be
+ * called before drawing, and the VBO must be unbound via glBindBuffer(GL_ARRAY_BUFFER, 0) after
+ * drawing, before any client-side vertex arrays get used again.
+ *
+ * The VBO is used as a ring buffer, which is grown as needed to hold at least four batches.
+ * Each batch is written behind the previous one, so the gpu can still draw from older batches
+ * while new ones get written. If supported, the VBO is persistently mapped, and split into four
+ * segments, each protected by a fence against overwriting while the gpu still uses it. Otherwise
+ * each batch gets mapped unsynchronized, and the VBO gets orphaned on wraparound.
+ *
+ * Returns NULL if streaming VBO's are unsupported, e.g., on OpenGL-ES, or disabled via the
+ * ConserveVRAM setting kPsychDontUseStreamingVBOs. Callers must use client-side vertex arrays
+ * instead then.
+ */
+void* PsychMapStreamingVBO(PsychWindowRecordType *windowRecord, size_t size, GLintptr *offset)
+{
+    PsychWindowRecordType *parentWindowRecord;
+    GLbitfield flags;
+    size_t newSize;
+    int segment, lastSegment;
+    void *mem;
+
+    if ((size == 0) || !PsychIsGLClassic(windowRecord) || !(GLEW_VERSION_3_0 || GLEW_ARB_map_buffer_range) ||
+        (PsychPrefStateGet_ConserveVRAM() & kPsychDontUseStreamingVBOs))
+        return(NULL);
+
+    // The VBO belongs to the onscreen window, as all its offscreen windows and textures share its OpenGL context:
+    parentWindowRecord = PsychGetParentWindow(windowRecord);
+
+    // Keep all batches 16 Byte aligned:
+    size = (size + 15) & ~((size_t) 15);
+
+    // Need to create a VBO, or a bigger one which can hold at least four batches of this size?
+    if (4 * size > parentWindowRecord->streamVBOSize) {
+        for (newSize = 4 * 1024 * 1024; newSize < 4 * size; newSize *= 2);
+
+        // Creation of a VBO of this size failed before? Don't retry on each batch drawing call, but
+        // use the fallback for batches of this size. Smaller batches can still use a smaller VBO:
+        if (parentWindowRecord->streamVBOFailedSize && (newSize >= parentWindowRecord->streamVBOFailedSize))
+            return(NULL);
+
+        PsychDeleteStreamingVBO(parentWindowRecord);
+
+        while (glGetError());
+        glGenBuffers(1, &parentWindowRecord->streamVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, parentWindowRecord->streamVBO);
+
+        if ((GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) && (GLEW_VERSION_3_2 || GLEW_ARB_sync)) {
+            // Immutable storage, persistently and coherently mapped for the whole lifetime of the VBO:
+            flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_ARRAY_BUFFER, newSize, NULL, flags);
+            parentWindowRecord->streamVBOMapping = glMapBufferRange(GL_ARRAY_BUFFER, 0, newSize, flags);
+        }
+        else {
+            glBufferData(GL_ARRAY_BUFFER, newSize, NULL, GL_STREAM_DRAW);
+        }
+
+        if ((glGetError() != GL_NO_ERROR) || ((GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) && (GLEW_VERSION_3_2 || GLEW_ARB_sync) && !parentWindowRecord->streamVBOMapping)) {
+            if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Failed to create streaming vertex buffer of %i KB for batch drawing. Using slower fallback path for such big batches.\n", (int) (newSize / 1024));
+            PsychDeleteStreamingVBO(parentWindowRecord);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            parentWindowRecord->streamVBOFailedSize = newSize;
+            return(NULL);
+        }
+
+        parentWindowRecord->streamVBOSize = newSize;
+        parentWindowRecord->streamVBOOffset = 0;
+        parentWindowRecord->streamVBOSegment = 0;
+
+        if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Created %s streaming vertex buffer of %i KB for batch drawing.\n", (parentWindowRecord->streamVBOMapping) ? "persistently mapped" : "orphaning", (int) (newSize / 1024));
+    }
+    else {
+        glBindBuffer(GL_ARRAY_BUFFER, parentWindowRecord->streamVBO);
+    }
+
+    // Wrap around to the start of the ring if this batch doesn't fit at the end:
+    if (parentWindowRecord->streamVBOOffset + size > parentWindowRecord->streamVBOSize) {
+        parentWindowRecord->streamVBOOffset = 0;
+
+        // Orphan the old storage, unless persistently mapped, so the driver can hand us fresh memory
+        // without waiting for the gpu to finish drawing from the old one:
+        if (!parentWindowRecord->streamVBOMapping) glBufferData(GL_ARRAY_BUFFER, parentWindowRecord->streamVBOSize, NULL, GL_STREAM_DRAW);
+    }
+
+    *offset = (GLintptr) parentWindowRecord->streamVBOOffset;
+
+    if (parentWindowRecord->streamVBOMapping) {
+        // Fence each segment when leaving it, and wait for the gpu to be done with a segment before writing to it again:
+        lastSegment = (int) ((parentWindowRecord->streamVBOOffset + size - 1) / (parentWindowRecord->streamVBOSize / 4));
+        while (parentWindowRecord->streamVBOSegment != lastSegment) {
+            segment = parentWindowRecord->streamVBOSegment;
+            parentWindowRecord->streamVBOFences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+            segment = (segment + 1) % 4;
+            if (parentWindowRecord->streamVBOFences[segment]) {
+                if ((glClientWaitSync(parentWindowRecord->streamVBOFences[segment], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) &&
+                    (PsychPrefStateGet_Verbosity() > 1))
+                    printf("PTB-WARNING: Timeout while waiting for gpu to release streaming vertex buffer segment. Drawing may be corrupted!\n");
+
+                glDeleteSync(parentWindowRecord->streamVBOFences[segment]);
+                parentWindowRecord->streamVBOFences[segment] = NULL;
+            }
+
+            parentWindowRecord->streamVBOSegment = segment;
+        }
+
+        mem = (void*) ((unsigned char*) parentWindowRecord->streamVBOMapping + parentWindowRecord->streamVBOOffset);
+    }
+    else {
+        // Map only the range for this batch. No need to synchronize with the gpu, as the range isn't used by any pending drawing:
+        mem = glMapBufferRange(GL_ARRAY_BUFFER, *offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (NULL == mem) {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            return(NULL);
+        }
+    }
+
+    parentWindowRecord->streamVBOOffset += size;
+
+    return(mem);
+}
+
+/* PsychUnmapStreamingVBO()
+ *
+ * Finish writing of a batch of vertex data, started by PsychMapStreamingVBO().
+ */
+void PsychUnmapStreamingVBO(PsychWindowRecordType *windowRecord)
+{
+    // Persistently mapped VBO's stay mapped, everything else needs unmapping before drawing:
+    if (!PsychGetParentWindow(windowRecord)->streamVBOMapping) glUnmapBuffer(GL_ARRAY_BUFFER);
+}
+
+/* PsychDeleteStreamingVBO()
+ *
+ * Release the streaming VBO of onscreen window 'windowRecord' and its fences, if any.
+ * Its OpenGL context must be bound.
+ */
+void PsychDeleteStreamingVBO(PsychWindowRecordType *windowRecord)
+{
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        if (windowRecord->streamVBOFences[i]) glDeleteSync(windowRecord->streamVBOFences[i]);
+        windowRecord->streamVBOFences[i] = NULL;
+    }
+
+    if (windowRecord->streamVBO) {
+        if (windowRecord->streamVBOMapping) {
+            glBindBuffer(GL_ARRAY_BUFFER, windowRecord->streamVBO);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+
+        glDeleteBuffers(1, &windowRecord->streamVBO);
+    }
+
+    windowRecord->streamVBO = 0;
+    windowRecord->streamVBOSize = 0;
+    windowRecord->streamVBOOffset = 0;
+    windowRecord->streamVBOMapping = NULL;
+    windowRecord->streamVBOSegment = 0;
+}
+
+/* PsychSetupStreamingVertexArrays()
+ *
+ * Helper routine for batch drawing functions: Convert 'nrvertices' 2D vertex positions 'xy', and
+ * optionally per vertex 'mc' component colors in 'colors' or 'bytecolors', and per vertex 'sizes',
+ * to single precision float in one pass over each array, writing them directly into the streaming
+ * VBO. Then setup the vertex, color and texture coordinate set 2 arrays to source from the VBO, like
+ * glVertexPointer() and PsychSetupVertexColorArrays() would do for client-side arrays. 'mc' must be
+ * zero if no per vertex colors are used, and 'sizes' NULL if no per vertex sizes are used.
+ *
+ * Returns TRUE on success, in which case the caller must glBindBuffer(GL_ARRAY_BUFFER, 0) after drawing,
+ * before it resets the vertex array pointers. Returns FALSE if the streaming VBO is unavailable, in which
+ * case the caller must setup client-side vertex arrays instead.
+ */
+psych_bool PsychSetupStreamingVertexArrays(PsychWindowRecordType *windowRecord, int nrvertices, double *xy, int mc, double *colors, unsigned char *bytecolors, double *sizes)
+{
+    size_t size, colorOffset, sizesOffset;
+    GLintptr offset;
+    unsigned char *mem;
+    float *dst;
+    int i;
+
+    // No streaming of uint8 colors into the unclamped color path, it can't accept them anyway:
+    if ((mc > 0) && bytecolors && windowRecord->defaultDrawShader)
+        return(FALSE);
+
+    // Layout: Float xy positions, followed by float sizes, followed by float or uint8 colors:
+    sizesOffset = (size_t) nrvertices * 2 * sizeof(float);
+    colorOffset = sizesOffset + ((sizes) ? (size_t) nrvertices * sizeof(float) : 0);
+    size = colorOffset + ((mc > 0) ? (size_t) nrvertices * mc * ((colors) ? sizeof(float) : 1) : 0);
+
+    mem = (unsigned char*) PsychMapStreamingVBO(windowRecord, size, &offset);
+    if (NULL == mem)
+        return(FALSE);
+
+    dst = (float*) mem;
+    for (i = 0; i < 2 * nrvertices; i++)
+        dst[i] = (float) xy[i];
+
+    if (sizes) {
+        dst = (float*) (mem + sizesOffset);
+        for (i = 0; i < nrvertices; i++)
+            dst[i] = (float) sizes[i];
+    }
+
+    if (mc > 0) {
+        if (colors) {
+            dst = (float*) (mem + colorOffset);
+            for (i = 0; i < nrvertices * mc; i++)
+                dst[i] = (float) colors[i];
+        }
+        else {
+            memcpy(mem + colorOffset, bytecolors, (size_t) nrvertices * mc);
+        }
+    }
+
+    PsychUnmapStreamingVBO(windowRecord);
+
+    // Setup vertex arrays to source from the VBO:
+    glVertexPointer(2, GL_FLOAT, 0, (const GLvoid*) offset);
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    if (sizes) {
+        // Per vertex sizes go via texture coordinate set 2:
+        glClientActiveTexture(GL_TEXTURE2);
+        glTexCoordPointer(1, GL_FLOAT, 0, (const GLvoid*) (offset + sizesOffset));
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glClientActiveTexture(GL_TEXTURE0);
+    }
+
+    if (mc > 0) {
+        if (windowRecord->defaultDrawShader) {
+            // Shader based unclamped path:
+            glTexCoordPointer(mc, GL_FLOAT, 0, (const GLvoid*) (offset + colorOffset));
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        }
+        else {
+            // Standard path:
+            glColorPointer(mc, (colors) ? GL_FLOAT : GL_UNSIGNED_BYTE, 0, (const GLvoid*) (offset + colorOffset));
+            glEnableClientState(GL_COLOR_ARRAY);
+        }
+    }
+
+    return(TRUE);
+}
+
+// Shaders for instanced drawing of batches of ovals and rects:
+static char ShapeFragmentShaderSrc[] =
+"/* Fragment shader for instanced drawing of ovals and rects: Just passes through the */\n"
+"/* unclamped color of the shape.                                                     */\n"
+"\n"
+"varying vec4 unclampedFragColor;\n"
+"\n"
+"void main()\n"
+"{\n"
+"    gl_FragColor = unclampedFragColor;\n"
+"}\n\0";
+
+static char ShapeVertexShaderSrc[] =
+"/* Vertex shader for instanced drawing of ovals and rects: Each oval instance is a     */\n"
+"/* ring shaped triangle strip around the shape, whose vertices alternate between the  */\n"
+"/* outer and inner border. gl_Vertex.x is the index of the ring segment, gl_Vertex.y  */\n"
+"/* is 1.0 for inner vertices. Filled ovals have their inner border collapsed onto the */\n"
+"/* center. Each rect instance uses the same strip for up to four separate quads.      */\n"
+"/* Per instance attributes define the bounding rect, the inner border, ie., the pen   */\n"
+"/* size in pixels for rects, negative for filled rects, or the inner radius relative  */\n"
+"/* to the outer radius for ovals, the number of oval slices, and optionally the color */\n"
+"/* of each shape.                                                                     */\n"
+"\n"
+"uniform int shape;\n"
+"uniform int colorSource;\n"
+"attribute vec4 instanceRect;\n"
+"attribute vec2 instanceParams;\n"
+"attribute vec4 instanceColor;\n"
+"varying vec4 unclampedFragColor;\n"
+"\n"
+"void main()\n"
+"{\n"
+"    vec2 pos;\n"
+"    vec2 halfSize = 0.5 * (instanceRect.zw - instanceRect.xy);\n"
+"\n"
+"    if (shape == 0) {\n"
+"        /* Rect: Vertex n of the strip is corner c of quad k, with 6 vertices per quad: The 4 corners, */\n"
+"        /* enclosed by repeats of the first and last corner to join the quads by degenerate triangles. */\n"
+"        /* Filled rects are one quad. Framed rects are the top, bottom, left and right side of the     */\n"
+"        /* frame, exactly as drawn by Screen('FrameRect') one rect at a time, even for wide pens.      */\n"
+"        float n = 2.0 * gl_Vertex.x + gl_Vertex.y;\n"
+"        float k = floor(n / 6.0);\n"
+"        float c = clamp(n - 6.0 * k - 1.0, 0.0, 3.0);\n"
+"        float pen = instanceParams.x;\n"
+"        vec4 quad;\n"
+"\n"
+"        if (pen < 0.0)\n"
+"            quad = instanceRect;\n"
+"        else if (k == 0.0)\n"
+"            quad = vec4(instanceRect.xyz, instanceRect.y + pen);\n"
+"        else if (k == 1.0)\n"
+"            quad = vec4(instanceRect.x, instanceRect.w - pen, instanceRect.zw);\n"
+"        else if (k == 2.0)\n"
+"            quad = vec4(instanceRect.x, instanceRect.y + pen, instanceRect.x + pen, instanceRect.w - pen);\n"
+"        else\n"
+"            quad = vec4(instanceRect.z - pen, instanceRect.y + pen, instanceRect.z, instanceRect.w - pen);\n"
+"\n"
+"        pos = mix(quad.xy, quad.zw, vec2(mod(c, 2.0), floor(c / 2.0)));\n"
+"    }\n"
+"    else {\n"
+"        /* Oval: Same vertex placement as gluDisk(). Vertices beyond the number of slices of */\n"
+"        /* this instance collapse onto the closing vertex, forming degenerate triangles.      */\n"
+"        float slices = instanceParams.y;\n"
+"        float angle = 6.28318530717958647692 * min(gl_Vertex.x, slices) / slices;\n"
+"        float r = (gl_Vertex.y > 0.5) ? instanceParams.x : 1.0;\n"
+"        pos = 0.5 * (instanceRect.xy + instanceRect.zw) + r * halfSize * vec2(sin(angle), cos(angle));\n"
+"    }\n"
+"\n"
+"    gl_Position = gl_ModelViewProjectionMatrix * vec4(pos, 0.0, 1.0);\n"
+"\n"
+"    /* Per instance color, unclamped high precision color from texture coordinate set 0, or regular color: */\n"
+"    if (colorSource == 2)\n"
+"        unclampedFragColor = instanceColor;\n"
+"    else if (colorSource == 1)\n"
+"        unclampedFragColor = gl_MultiTexCoord0;\n"
+"    else\n"
+"        unclampedFragColor = gl_Color;\n"
+"}\n\0";
+
+/* PsychDrawInstancedShapes()
+ *
+ * Helper routine for batch drawing functions: Draw 'numRects' filled or framed ovals or rects, as selected by
+ * 'shape' kPsychShapeOval or kPsychShapeRect, with one instanced draw call. 'xy' contains the bounding rects, 4
+ * values per shape. If 'nc' > 1, then 'colors' or 'bytecolors' define per shape colors with 'mc' components each,
+ * otherwise the current color set up by PsychPrepareRenderBatch() is used. If 'penSizes' is NULL, the shapes are
+ * filled, otherwise framed with a pen size of 'penSizes[0]', or of 'penSizes[i]' for shape i if 'nrsize' > 1.
+ * Ovals are made of 'numSlices' slices, or of one slice per pixel of circumference if 'numSlices' is zero.
+ * Empty rects are skipped. Framed rects are made of the same four quads as drawn by Screen('FrameRect') one by
+ * one, so pens wider than half the rect overlap or extend beyond the rect the same way.
+ *
+ * The per shape data is written to the streaming VBO, one ring shaped triangle strip shared by all shapes is
+ * stored in a static VBO, and a vertex shader places the strip of each instance.
+ *
+ * Returns FALSE if instanced drawing is unsupported, e.g., on OpenGL-ES or without GL_ARB_instanced_arrays,
+ * or if instanced drawing or the streaming VBO it needs are disabled via the ConserveVRAM settings
+ * kPsychDontUseInstancedShapes or kPsychDontUseStreamingVBOs. Callers must draw the shapes one by one instead then.
+ */
+psych_bool PsychDrawInstancedShapes(PsychWindowRecordType *windowRecord, int shape, int numRects, double *xy, int nc, int mc, double *colors, unsigned char *bytecolors, int nrsize, double *penSizes, int numSlices)
+{
+    PsychWindowRecordType *parentWindowRecord;
+    GLint rectLoc, paramsLoc, colorLoc;
+    GLintptr offset;
+    size_t colorOffset, colorSize;
+    unsigned char *mem;
+    float *dst, *ring;
+    double *rect, outerRadius, penSize;
+    int i, j, count, slices, maxSlices, oldverbosity;
+
+    // Shader and ring geometry belong to the onscreen window, shared by all its offscreen windows:
+    parentWindowRecord = PsychGetParentWindow(windowRecord);
+
+    if (parentWindowRecord->shapeShaderFailed || (numRects < 2) || !PsychIsGLClassic(windowRecord) || !(GLEW_VERSION_3_3 || (GLEW_ARB_instanced_arrays && GLEW_ARB_draw_instanced)) ||
+        (PsychPrefStateGet_ConserveVRAM() & (kPsychDontUseInstancedShapes | kPsychDontUseStreamingVBOs)))
+        return(FALSE);
+
+    if (!parentWindowRecord->shapeShader) {
+        // Build shader, but allow this to silently fail:
+        oldverbosity = PsychPrefStateGet_Verbosity();
+        PsychPrefStateSet_Verbosity(0);
+        parentWindowRecord->shapeShader = PsychCreateGLSLProgram(ShapeFragmentShaderSrc, ShapeVertexShaderSrc, NULL);
+        PsychPrefStateSet_Verbosity(oldverbosity);
+
+        if (!parentWindowRecord->shapeShader) {
+            // Failed. Record this failure so we can avoid retrying at next invocation:
+            if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Instanced drawing of oval and rect batches unsupported. Using slower fallback path.\n");
+            parentWindowRecord->shapeShaderFailed = TRUE;
+            return(FALSE);
+        }
+    }
+
+    // Per shape data: Float rect, float inner border and slices, and colors after the data of all shapes:
+    colorOffset = (size_t) numRects * 6 * sizeof(float);
+    colorSize = (nc > 1) ? (size_t) numRects * mc * ((colors) ? sizeof(float) : 1) : 0;
+
+    mem = (unsigned char*) PsychMapStreamingVBO(windowRecord, colorOffset + colorSize, &offset);
+    if (NULL == mem)
+        return(FALSE);
+
+    dst = (float*) mem;
+    count = 0;
+
+    // Ring segments to draw: Two vertices each, 6 vertices per rect quad, 4 quads for framed rects:
+    maxSlices = (shape == kPsychShapeOval) ? 4 : ((penSizes) ? 11 : 2);
+    for (i = 0; i < numRects; i++) {
+        rect = &xy[i * 4];
+        if (IsPsychRectEmpty(rect))
+            continue;
+
+        penSize = (penSizes) ? penSizes[(nrsize > 1) ? i : 0] : 0;
+
+        if (shape == kPsychShapeOval) {
+            outerRadius = ((rect[kPsychRight] - rect[kPsychLeft]) > (rect[kPsychBottom] - rect[kPsychTop])) ? (rect[kPsychRight] - rect[kPsychLeft]) / 2 : (rect[kPsychBottom] - rect[kPsychTop]) / 2;
+            slices = (numSlices > 0) ? numSlices : (int) (3.14159265358979323846 * 2 * outerRadius);
+            if (slices < 3) slices = 3;
+            if (slices > maxSlices) maxSlices = slices;
+
+            // Inner radius, relative to outer radius:
+            dst[4] = (penSizes && (outerRadius > penSize)) ? (float) ((outerRadius - penSize) / outerRadius) : 0;
+            dst[5] = (float) slices;
+        }
+        else {
+            // Pen size, or negative for filled rects:
+            dst[4] = (penSizes) ? (float) penSize : -1;
+            dst[5] = 0;
+        }
+
+        dst[0] = (float) rect[kPsychLeft];
+        dst[1] = (float) rect[kPsychTop];
+        dst[2] = (float) rect[kPsychRight];
+        dst[3] = (float) rect[kPsychBottom];
+        dst += 6;
+
+        if (nc > 1) {
+            if (colors) {
+                for (j = 0; j < mc; j++)
+                    ((float*) (mem + colorOffset))[count * mc + j] = (float) colors[i * mc + j];
+            }
+            else {
+                memcpy(mem + colorOffset + count * mc, &bytecolors[i * mc], mc);
+            }
+        }
+
+        count++;
+    }
+
+    PsychUnmapStreamingVBO(windowRecord);
+
+    // All shapes empty?
+    if (count == 0) {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return(TRUE);
+    }
+
+    // Need to create a ring strip VBO, or a bigger one with more slices?
+    if (parentWindowRecord->shapeVBOSlices < maxSlices) {
+        for (slices = 256; slices < maxSlices; slices *= 2);
+
+        // Two vertices per ring segment, one outer, one inner:
+        ring = (float*) PsychMallocTemp((slices + 1) * 4 * sizeof(float));
+        for (i = 0; i <= slices; i++) {
+            ring[i * 4 + 0] = (float) i;
+            ring[i * 4 + 1] = 0;
+            ring[i * 4 + 2] = (float) i;
+            ring[i * 4 + 3] = 1;
+        }
+
+        if (!parentWindowRecord->shapeVBO) glGenBuffers(1, &parentWindowRecord->shapeVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, parentWindowRecord->shapeVBO);
+        glBufferData(GL_ARRAY_BUFFER, (slices + 1) * 4 * sizeof(float), ring, GL_STATIC_DRAW);
+        parentWindowRecord->shapeVBOSlices = slices;
+    }
+
+    // Shared ring strip as per vertex positions:
+    glBindBuffer(GL_ARRAY_BUFFER, parentWindowRecord->shapeVBO);
+    glVertexPointer(2, GL_FLOAT, 0, NULL);
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    PsychSetShader(windowRecord, parentWindowRecord->shapeShader);
+    glUniform1i(glGetUniformLocation(parentWindowRecord->shapeShader, "shape"), (shape == kPsychShapeOval) ? 1 : 0);
+    glUniform1i(glGetUniformLocation(parentWindowRecord->shapeShader, "colorSource"), (nc > 1) ? 2 : ((windowRecord->defaultDrawShader) ? 1 : 0));
+
+    rectLoc = glGetAttribLocation(parentWindowRecord->shapeShader, "instanceRect");
+    paramsLoc = glGetAttribLocation(parentWindowRecord->shapeShader, "instanceParams");
+    colorLoc = (nc > 1) ? glGetAttribLocation(parentWindowRecord->shapeShader, "instanceColor") : -1;
+
+    // Per instance data from the streaming VBO:
+    glBindBuffer(GL_ARRAY_BUFFER, parentWindowRecord->streamVBO);
+    glVertexAttribPointer(rectLoc, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (const GLvoid*) offset);
+    glEnableVertexAttribArray(rectLoc);
+    glVertexAttribPointer(paramsLoc, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (const GLvoid*) (offset + 4 * sizeof(float)));
+    glEnableVertexAttribArray(paramsLoc);
+    if (colorLoc >= 0) {
+        // Normalized uint8 colors work in unclamped mode as well, as they are converted to float:
+        glVertexAttribPointer(colorLoc, mc, (colors) ? GL_FLOAT : GL_UNSIGNED_BYTE, (colors) ? GL_FALSE : GL_TRUE, 0, (const GLvoid*) (offset + colorOffset));
+        glEnableVertexAttribArray(colorLoc);
+    }
+
+    if (GLEW_VERSION_3_3) {
+        glVertexAttribDivisor(rectLoc, 1);
+        glVertexAttribDivisor(paramsLoc, 1);
+        if (colorLoc >= 0) glVertexAttribDivisor(colorLoc, 1);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, (maxSlices + 1) * 2, count);
+        glVertexAttribDivisor(rectLoc, 0);
+        glVertexAttribDivisor(paramsLoc, 0);
+        if (colorLoc >= 0) glVertexAttribDivisor(colorLoc, 0);
+    }
+    else {
+        glVertexAttribDivisorARB(rectLoc, 1);
+        glVertexAttribDivisorARB(paramsLoc, 1);
+        if (colorLoc >= 0) glVertexAttribDivisorARB(colorLoc, 1);
+        glDrawArraysInstancedARB(GL_TRIANGLE_STRIP, 0, (maxSlices + 1) * 2, count);
+        glVertexAttribDivisorARB(rectLoc, 0);
+        glVertexAttribDivisorARB(paramsLoc, 0);
+        if (colorLoc >= 0) glVertexAttribDivisorARB(colorLoc, 0);
+    }
+
+    // Back to client-side arrays and default shader:
+    glDisableVertexAttribArray(rectLoc);
+    glDisableVertexAttribArray(paramsLoc);
+    if (colorLoc >= 0) glDisableVertexAttribArray(colorLoc);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, PSYCHGLFLOAT, 0, NULL);
+    PsychSetShader(windowRecord, 0);
+
+    return(TRUE);
+}
+
+/* PsychDeleteInstancedShapes()
+ *
+ * Release the shader and ring strip VBO for instanced drawing of shapes of onscreen window
+ * 'windowRecord', if any. Its OpenGL context must be bound.
+ */
+void PsychDeleteInstancedShapes(PsychWindowRecordType *windowRecord)
+{
+    if (windowRecord->shapeVBO) glDeleteBuffers(1, &windowRecord->shapeVBO);
+    if (windowRecord->shapeShader) glDeleteProgram(windowRecord->shapeShader);
+
+    windowRecord->shapeVBO = 0;
+    windowRecord->shapeVBOSlices = 0;
+    windowRecord->shapeShader = 0;
+}
+
 GLenum PsychGLFloatType(PsychWindowRecordType *windowRecord)
 {
     // On OpenGL-ES we only have GL_FLOAT data type, not GL_DOUBLE, so we need
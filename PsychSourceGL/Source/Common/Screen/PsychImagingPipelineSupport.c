@@ -410,6 +410,7 @@ void PsychInitImagingPipelineDefaultsForWindowRecord(PsychWindowRecordType *wind
     for (i=0; i<MAX_SCREEN_HOOKS; i++) {
         windowRecord->HookChainEnabled[i]=FALSE;
         windowRecord->HookChain[i]=NULL;
+        windowRecord->HookChainPlan[i]=NULL;
     }
 
     // Disable all special framebuffer objects by default:
@@ -3432,6 +3433,725 @@ void PsychNormalizeTextureOrientation(PsychWindowRecordType *sourceRecord)
     return;
 }
 
+/* Compiled hook chain execution plans:
+ *
+ * On first execution of a hook chain after any change to it, the linked list of hook slots gets compiled
+ * into a flat array of PsychHookPlanStep's, with the builtin commands which PsychPipelineExecuteHook()
+ * handles itself already decoded, and the number of Builtin:FlipFBOs ping-pong buffer swaps precomputed.
+ * Any change to the chain discards the plan again.
+ *
+ * If enabled via Screen('Preference', 'FuseHookChainShaders', 1), runs of two or more shader slots of image
+ * processing chains, only separated by Builtin:FlipFBOs slots, get fused into one pass with a single generated GLSL program, if all shaders of the run are point operations,
+ * i.e., the output color of a pixel only depends on the input color of the same pixel. This saves the write and
+ * read of one full intermediate framebuffer per fused slot. A shader is recognized as point operation if it follows
+ * the conventions of PsychColorCorrection() and PsychImaging(): A main shader which only does
+ * gl_FragColor = icmTransformColor(texture2DRect(Image, ...)) at the location of the fragment, and one or more
+ * linked fragment shaders which implement icmTransformColor(). The fused program links the icmTransformColor()
+ * implementations of all slots, with their functions and uniforms renamed via preprocessor defines, and chains
+ * them in a generated main shader. Uniform values get copied from the original programs before each execution,
+ * so usercode can keep changing the parameters of the original shaders, e.g., via PsychColorCorrection().
+ * Fusion is off by default, as skipping the intermediate framebuffers changes the rounding of results, e.g.,
+ * for 8 or 16 bpc intermediate buffers, so fused chains are not bit-identical to unfused ones.
+ */
+
+// Maximum number of shaders in a point operation slot, texture bindings and slots in a fused pass:
+#define kPsychMaxFusedShaders       16
+#define kPsychMaxFusedTexBindings   16
+#define kPsychMaxFusedStages        16
+
+// The only two main shaders accepted for point operation slots, without whitespace, comments and #extension lines:
+static const char* pointOpMainShaderSrc[2] = {
+    "uniformsampler2DRectImage;vec4icmTransformColor(vec4incolor);voidmain(){gl_FragColor=icmTransformColor(texture2DRect(Image,gl_TexCoord[0].st));}",
+    "uniformsampler2DRectImage;vec4icmTransformColor(vec4incolor);voidmain(){gl_FragColor=icmTransformColor(texture2DRect(Image,gl_FragCoord.xy));}"
+};
+
+// Corresponding input texture coordinates for the generated main shader of a fused pass:
+static const char* pointOpTexCoord[2] = { "gl_TexCoord[0].st", "gl_FragCoord.xy" };
+
+// Texture targets which can be bound in the blitter string of a shader slot:
+static const char* texBindingTargets[4] = { "TEXTURE1D", "TEXTURE2D", "TEXTURERECT2D", "TEXTURE3D" };
+
+typedef struct PsychFusionTexBinding {
+    int                     target;         // Index into texBindingTargets[].
+    int                     unit;
+    int                     texid;
+} PsychFusionTexBinding;
+
+// Description of a point operation shader slot as input to fusion:
+typedef struct PsychFusionStage {
+    PtrPsychHookFunction    hookfunc;
+    GLuint                  program;
+    int                     texcoord;       // Index into pointOpTexCoord[].
+    GLuint                  snippets[kPsychMaxFusedShaders];
+    int                     numSnippets;
+    PsychFusionTexBinding   bindings[kPsychMaxFusedTexBindings];
+    int                     numBindings;
+} PsychFusionStage;
+
+/* PsychPipelineFreeHookChainPlan() - Discard compiled execution plan of hook chain 'hookId', if any.
+ * Generated fused GLSL programs are deleted if 'deleteGL' is TRUE, ie., if the OpenGL context still exists.
+ */
+static void PsychPipelineFreeHookChainPlan(PsychWindowRecordType *windowRecord, int hookId, psych_bool deleteGL)
+{
+    PsychHookPlan* plan = windowRecord->HookChainPlan[hookId];
+    PtrPsychHookFunction hookfunc;
+    int i;
+
+    if (plan == NULL) return;
+
+    for (i = 0; i < plan->numSteps[1]; i++) {
+        if (plan->steps[1][i].op != kPsychHookStepFused) continue;
+
+        // Generated hook slot of a fused pass:
+        hookfunc = plan->steps[1][i].hookfunc;
+        if (deleteGL && glDeleteProgram) {
+            PsychSetGLContext(windowRecord);
+            glDeleteProgram(hookfunc->shaderid);
+        }
+
+        free(hookfunc->idString);
+        free(hookfunc->pString1);
+        free(hookfunc);
+    }
+
+    free(plan->steps[0]);
+    free(plan->steps[1]);
+    free(plan->uniformLinks);
+    free(plan);
+
+    windowRecord->HookChainPlan[hookId] = NULL;
+
+    return;
+}
+
+/* PsychPipelineCompileHookChain() - Compile the execution plan of the non-empty hook chain 'hookId'.
+ * Only creates the unfused steps. Fusion is done on demand by PsychPipelineCompileHookChainFusion().
+ */
+static PsychHookPlan* PsychPipelineCompileHookChain(PsychWindowRecordType *windowRecord, int hookId)
+{
+    PsychHookPlan* plan;
+    PsychHookPlanStep* step;
+    PtrPsychHookFunction hookfunc;
+    int n = 0;
+
+    for (hookfunc = windowRecord->HookChain[hookId]; hookfunc; hookfunc = hookfunc->next) n++;
+
+    plan = (PsychHookPlan*) calloc(1, sizeof(PsychHookPlan));
+    if (plan) plan->steps[0] = (PsychHookPlanStep*) calloc(n, sizeof(PsychHookPlanStep));
+    if ((plan == NULL) || (plan->steps[0] == NULL)) {
+        free(plan);
+        PsychErrorExitMsg(PsychError_outofMemory, "Failed to allocate memory for hook chain execution plan.");
+        return(NULL);
+    }
+
+    n = 0;
+    for (hookfunc = windowRecord->HookChain[hookId]; hookfunc; hookfunc = hookfunc->next) {
+        step = &(plan->steps[0][n]);
+        step->hookfunc = hookfunc;
+        step->op = kPsychHookStepSlot;
+        step->slot = n++;
+        step->numSlots = 1;
+
+        // Decode builtins which are executed by PsychPipelineExecuteHook() itself:
+        if (hookfunc->hookfunctype == kPsychBuiltinFunc) {
+            if (strcmp(hookfunc->idString, "Builtin:FlipFBOs") == 0) {
+                step->op = kPsychHookStepFlipFBOs;
+                plan->pingpongs[0]++;
+            }
+            else if (strstr(hookfunc->idString, "Builtin:RestrictToScissorROI")) {
+                step->op = kPsychHookStepScissorROI;
+            }
+            else if (strstr(hookfunc->idString, "Builtin:ActivateOpenGLContext")) {
+                step->op = kPsychHookStepActivateContext;
+            }
+        }
+    }
+
+    plan->numSteps[0] = n;
+    windowRecord->HookChainPlan[hookId] = plan;
+
+    return(plan);
+}
+
+/* Parse blitter string of a shader slot into texture bindings. Returns FALSE if the string contains anything
+ * else, e.g., a blitter or blitter parameters, or a binding to texture unit 0, which is the input image.
+ */
+static psych_bool PsychPipelineParseTexBindings(const char* pString, PsychFusionTexBinding* bindings, int* numBindings)
+{
+    char token[128];
+    int i, n, len;
+
+    while (sscanf(pString, "%127s%n", token, &n) == 1) {
+        pString += n;
+
+        for (i = 0; i < 4; i++) {
+            len = (int) strlen(texBindingTargets[i]);
+            if ((strncmp(token, texBindingTargets[i], len) == 0) && (token[len] == '(')) break;
+        }
+
+        if ((i == 4) || (*numBindings >= kPsychMaxFusedTexBindings)) return(FALSE);
+
+        n = 0;
+        if ((sscanf(token + len, "(%i)=%i%n", &bindings[*numBindings].unit, &bindings[*numBindings].texid, &n) != 2) ||
+            (token[len + n] != 0) || (bindings[*numBindings].unit <= 0))
+            return(FALSE);
+
+        bindings[*numBindings].target = i;
+        (*numBindings)++;
+    }
+
+    return(TRUE);
+}
+
+/* Merge texture bindings of 'stage' into the bindings of a fused pass. Returns FALSE, without changing
+ * the bindings of the fused pass, if a texture unit would need to be bound to two different textures.
+ */
+static psych_bool PsychPipelineMergeTexBindings(PsychFusionTexBinding* bindings, int* numBindings, PsychFusionStage* stage)
+{
+    PsychFusionTexBinding merged[kPsychMaxFusedTexBindings];
+    int i, j, n = *numBindings;
+
+    memcpy(merged, bindings, n * sizeof(PsychFusionTexBinding));
+    for (i = 0; i < stage->numBindings; i++) {
+        for (j = 0; j < n; j++) {
+            if (merged[j].unit == stage->bindings[i].unit) break;
+        }
+
+        if (j < n) {
+            // Unit already bound. Ok if it is the same texture:
+            if ((merged[j].target != stage->bindings[i].target) || (merged[j].texid != stage->bindings[i].texid)) return(FALSE);
+        }
+        else {
+            if (n >= kPsychMaxFusedTexBindings) return(FALSE);
+            merged[n++] = stage->bindings[i];
+        }
+    }
+
+    memcpy(bindings, merged, n * sizeof(PsychFusionTexBinding));
+    *numBindings = n;
+
+    return(TRUE);
+}
+
+// Return malloc'ed source code of shader object, or NULL if none:
+static char* PsychPipelineGetShaderSource(GLuint shader)
+{
+    GLint len = 0;
+    char* src;
+
+    glGetShaderiv(shader, GL_SHADER_SOURCE_LENGTH, &len);
+    if ((len <= 0) || ((src = (char*) calloc(1, len + 1)) == NULL)) return(NULL);
+    glGetShaderSource(shader, len + 1, NULL, (GLchar*) src);
+
+    return(src);
+}
+
+// Return malloc'ed copy of GLSL source code without comments, #extension lines and any whitespace:
+static char* PsychPipelineNormalizeGLSL(const char* src)
+{
+    char* out = (char*) malloc(strlen(src) + 1);
+    char* dst = out;
+    psych_bool linestart = TRUE;
+
+    if (out == NULL) return(NULL);
+
+    while (*src) {
+        if (src[0] == '/' && src[1] == '*') {
+            src = strstr(src + 2, "*/");
+            if (src == NULL) break;
+            src += 2;
+        }
+        else if ((src[0] == '/' && src[1] == '/') || (linestart && (strncmp(src, "#extension", 10) == 0))) {
+            while (*src && *src != '\n') src++;
+        }
+        else if (isspace((int) *src)) {
+            if (*src == '\n') linestart = TRUE;
+            src++;
+        }
+        else {
+            linestart = FALSE;
+            *(dst++) = *(src++);
+        }
+    }
+    *dst = 0;
+
+    return(out);
+}
+
+static psych_bool PsychPipelineIsSamplerUniformType(GLenum type)
+{
+    return((type == GL_SAMPLER_1D || type == GL_SAMPLER_2D || type == GL_SAMPLER_3D || type == GL_SAMPLER_2D_RECT_ARB) ? TRUE : FALSE);
+}
+
+static psych_bool PsychPipelineIsSupportedUniformType(GLenum type)
+{
+    switch (type) {
+        case GL_FLOAT: case GL_FLOAT_VEC2: case GL_FLOAT_VEC3: case GL_FLOAT_VEC4:
+        case GL_INT: case GL_INT_VEC2: case GL_INT_VEC3: case GL_INT_VEC4:
+        case GL_BOOL: case GL_BOOL_VEC2: case GL_BOOL_VEC3: case GL_BOOL_VEC4:
+        case GL_FLOAT_MAT2: case GL_FLOAT_MAT3: case GL_FLOAT_MAT4:
+            return(TRUE);
+    }
+
+    return(PsychPipelineIsSamplerUniformType(type));
+}
+
+// Copy base name of uniform 'name', ie., without array index, into 'base':
+static void PsychPipelineUniformBaseName(const char* name, char* base, int maxlen)
+{
+    int i;
+
+    for (i = 0; (i < maxlen - 1) && name[i] && (name[i] != '['); i++) base[i] = name[i];
+    base[i] = 0;
+}
+
+/* PsychPipelineAnalyzePointOpSlot() - Check if 'hookfunc' is a point operation shader slot which can be fused.
+ * Fills 'stage' with the info needed for fusion and returns TRUE if so.
+ */
+static psych_bool PsychPipelineAnalyzePointOpSlot(PtrPsychHookFunction hookfunc, PsychFusionStage* stage)
+{
+    GLuint shaders[kPsychMaxFusedShaders + 1];
+    GLint count = 0, status, type, size, unit, numUniforms, i, j;
+    GLenum utype;
+    char name[256];
+    char *src, *norm, *p;
+    psych_bool foundmain = FALSE;
+    psych_bool rc = TRUE;
+
+    memset(stage, 0, sizeof(PsychFusionStage));
+    stage->hookfunc = hookfunc;
+    stage->program = hookfunc->shaderid;
+
+    // Shader slot with a valid linked program, and only texture bindings in its blitter string, ie. default blitter without offsets, scaling etc.:
+    if ((hookfunc->hookfunctype != kPsychShaderFunc) || (hookfunc->shaderid == 0) || !glIsProgram(hookfunc->shaderid) ||
+        !PsychPipelineParseTexBindings(hookfunc->pString1, stage->bindings, &stage->numBindings))
+        return(FALSE);
+
+    glGetProgramiv(stage->program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) return(FALSE);
+
+    glGetAttachedShaders(stage->program, kPsychMaxFusedShaders + 1, &count, shaders);
+    if (count > kPsychMaxFusedShaders) return(FALSE);
+
+    for (i = 0; (i < count) && rc; i++) {
+        // Only fragment shaders, no vertex or geometry shaders:
+        glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+        if ((type != GL_FRAGMENT_SHADER) || ((src = PsychPipelineGetShaderSource(shaders[i])) == NULL)) {
+            rc = FALSE;
+            break;
+        }
+
+        norm = PsychPipelineNormalizeGLSL(src);
+        free(src);
+        if (norm == NULL) {
+            rc = FALSE;
+            break;
+        }
+
+        if ((p = strstr(norm, "voidmain("))) {
+            // Main shader: Must be one of the standard point operation main shaders. Accept main(void) as well:
+            if (strncmp(p, "voidmain(void)", 14) == 0) memmove(p + 9, p + 13, strlen(p + 13) + 1);
+            for (j = 0; j < 2; j++) {
+                if (strcmp(norm, pointOpMainShaderSrc[j]) == 0) break;
+            }
+
+            if ((j == 2) || foundmain) {
+                rc = FALSE;
+            }
+            else {
+                stage->texcoord = j;
+                foundmain = TRUE;
+            }
+        }
+        else {
+            // icmTransformColor() implementation: Must not have a #version, as our renaming defines get prepended,
+            // and must not touch the input image, as a point operation only gets passed its input color:
+            if (strstr(norm, "#version") || strstr(norm, "Image")) {
+                rc = FALSE;
+            }
+            else {
+                stage->snippets[stage->numSnippets++] = shaders[i];
+            }
+        }
+
+        free(norm);
+    }
+
+    if (!rc || !foundmain || (stage->numSnippets == 0)) return(FALSE);
+
+    // All uniforms must be of types which we can copy to the fused program. Samplers must access texture units bound by this slot:
+    glGetProgramiv(stage->program, GL_ACTIVE_UNIFORMS, &numUniforms);
+    for (i = 0; i < numUniforms; i++) {
+        glGetActiveUniform(stage->program, i, sizeof(name), NULL, &size, &utype, (GLchar*) name);
+        if (strncmp(name, "gl_", 3) == 0) continue;
+
+        if (strcmp(name, "Image") == 0) {
+            // Input image must be sampled from unit 0:
+            glGetUniformiv(stage->program, glGetUniformLocation(stage->program, "Image"), &unit);
+            if ((utype != GL_SAMPLER_2D_RECT_ARB) || (unit != 0)) return(FALSE);
+            continue;
+        }
+
+        if (strchr(name, '.') || !PsychPipelineIsSupportedUniformType(utype)) return(FALSE);
+
+        if (PsychPipelineIsSamplerUniformType(utype)) {
+            if (size > 1) return(FALSE);
+
+            glGetUniformiv(stage->program, glGetUniformLocation(stage->program, name), &unit);
+            for (j = 0; j < stage->numBindings; j++) {
+                if (stage->bindings[j].unit == unit) break;
+            }
+
+            if (j == stage->numBindings) return(FALSE);
+        }
+    }
+
+    return(TRUE);
+}
+
+/* PsychPipelineCreateFusedProgram() - Create GLSL program which executes the point operations of all 'stages'.
+ * Appends links for copying the uniforms of the original programs to the plans uniformLinks. Returns the program
+ * handle on success, 0 on failure, e.g., due to name clashes between the global functions of different slots.
+ */
+static GLuint PsychPipelineCreateFusedProgram(PsychFusionStage* stages, int numStages, PsychHookPlan* plan)
+{
+    GLuint program, shader;
+    GLint status = GL_TRUE, numUniforms, size, i, j, k;
+    GLenum type;
+    GLint srcloc, dstloc;
+    PsychHookUniformLink* links;
+    char name[256], base[256], srcname[300], dstname[300];
+    char errtxt[10000];
+    char *prefix, *mainsrc, *src, *p;
+    const char* srcs[2];
+
+    while (glGetError());
+
+    program = glCreateProgram();
+
+    for (k = 0; (k < numStages) && (status == GL_TRUE); k++) {
+        // Build prefix of defines which renames the global functions and uniforms of this stage:
+        glGetProgramiv(stages[k].program, GL_ACTIVE_UNIFORMS, &numUniforms);
+        prefix = (char*) calloc(1, 256 + numUniforms * (2 * sizeof(base) + 32));
+        if (prefix == NULL) {
+            status = GL_FALSE;
+            break;
+        }
+
+        p = prefix + sprintf(prefix, "#define icmTransformColor icmTransformColor_%i\n#define icmTransformColor1 icmTransformColor1_%i\n", k, k);
+        for (i = 0; i < numUniforms; i++) {
+            glGetActiveUniform(stages[k].program, i, sizeof(name), NULL, &size, &type, (GLchar*) name);
+            if ((strncmp(name, "gl_", 3) == 0) || (strcmp(name, "Image") == 0)) continue;
+            PsychPipelineUniformBaseName(name, base, sizeof(base));
+            p += sprintf(p, "#define %s %s_%i\n", base, base, k);
+        }
+
+        // Compile renamed copies of all icmTransformColor() implementation shaders of the stage:
+        for (j = 0; (j < stages[k].numSnippets) && (status == GL_TRUE); j++) {
+            if ((src = PsychPipelineGetShaderSource(stages[k].snippets[j])) == NULL) {
+                status = GL_FALSE;
+                break;
+            }
+
+            srcs[0] = prefix;
+            srcs[1] = src;
+            shader = glCreateShader(GL_FRAGMENT_SHADER);
+            glShaderSource(shader, 2, (const GLchar**) srcs, NULL);
+            glCompileShader(shader);
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+            if ((status != GL_TRUE) && (PsychPrefStateGet_Verbosity() > 4)) {
+                glGetShaderInfoLog(shader, 9999, NULL, (GLchar*) &errtxt);
+                printf("PTB-DEBUG: Compile of renamed shader for fused hook chain pass failed:\n%s\n\n", errtxt);
+            }
+
+            // Attach. Shader gets deleted automatically with the program:
+            glAttachShader(program, shader);
+            glDeleteShader(shader);
+            free(src);
+        }
+
+        free(prefix);
+    }
+
+    // Build main shader which chains all point operations on the input image color:
+    mainsrc = (char*) calloc(1, 512 + numStages * 128);
+    if (mainsrc && (status == GL_TRUE)) {
+        p = mainsrc + sprintf(mainsrc, "\n#extension GL_ARB_texture_rectangle : enable\n\nuniform sampler2DRect Image;\n\n");
+        for (k = 0; k < numStages; k++) p += sprintf(p, "vec4 icmTransformColor_%i(vec4 incolor);\n", k);
+        p += sprintf(p, "\nvoid main()\n{\n    vec4 incolor = texture2DRect(Image, %s);\n", pointOpTexCoord[stages[0].texcoord]);
+        for (k = 0; k < numStages; k++) p += sprintf(p, "    incolor = icmTransformColor_%i(incolor);\n", k);
+        sprintf(p, "    gl_FragColor = incolor;\n}\n");
+
+        if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-INFO: Creating the following main shader for fused hook chain pass:\n\n%s\n\n", mainsrc);
+
+        shader = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(shader, 1, (const GLchar**) &mainsrc, NULL);
+        glCompileShader(shader);
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+        glAttachShader(program, shader);
+        glDeleteShader(shader);
+
+        if (status == GL_TRUE) {
+            glLinkProgram(program);
+            glGetProgramiv(program, GL_LINK_STATUS, &status);
+            if ((status != GL_TRUE) && (PsychPrefStateGet_Verbosity() > 4)) {
+                glGetProgramInfoLog(program, 9999, NULL, (GLchar*) &errtxt);
+                printf("PTB-DEBUG: Link of fused hook chain pass failed:\n%s\n\n", errtxt);
+            }
+        }
+    }
+    else {
+        status = GL_FALSE;
+    }
+    free(mainsrc);
+
+    if (status != GL_TRUE) {
+        glDeleteProgram(program);
+        while (glGetError());
+        return(0);
+    }
+
+    // Input image is sampled from texture unit 0:
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "Image"), 0);
+    glUseProgram(0);
+
+    // Link each active uniform (element) of the original programs to its renamed copy in the fused program:
+    for (k = 0; k < numStages; k++) {
+        glGetProgramiv(stages[k].program, GL_ACTIVE_UNIFORMS, &numUniforms);
+        for (i = 0; i < numUniforms; i++) {
+            glGetActiveUniform(stages[k].program, i, sizeof(name), NULL, &size, &type, (GLchar*) name);
+            if ((strncmp(name, "gl_", 3) == 0) || (strcmp(name, "Image") == 0)) continue;
+            PsychPipelineUniformBaseName(name, base, sizeof(base));
+
+            for (j = 0; j < size; j++) {
+                if (size > 1) {
+                    sprintf(srcname, "%s[%i]", base, j);
+                    sprintf(dstname, "%s_%i[%i]", base, k, j);
+                }
+                else {
+                    sprintf(srcname, "%s", base);
+                    sprintf(dstname, "%s_%i", base, k);
+                }
+
+                srcloc = glGetUniformLocation(stages[k].program, srcname);
+                dstloc = glGetUniformLocation(program, dstname);
+                if ((srcloc < 0) || (dstloc < 0)) continue;
+
+                links = (PsychHookUniformLink*) realloc(plan->uniformLinks, (plan->numUniformLinks + 1) * sizeof(PsychHookUniformLink));
+                if (links == NULL) PsychErrorExitMsg(PsychError_outofMemory, "Failed to allocate memory for fused hook chain pass.");
+
+                plan->uniformLinks = links;
+                links[plan->numUniformLinks].srcprogram = stages[k].program;
+                links[plan->numUniformLinks].srcloc = srcloc;
+                links[plan->numUniformLinks].dstloc = dstloc;
+                links[plan->numUniformLinks].type = type;
+                plan->numUniformLinks++;
+            }
+        }
+    }
+
+    while (glGetError());
+
+    return(program);
+}
+
+/* PsychPipelineCompileHookChainFusion() - Create the fused steps[1] of 'plan' for image processing chain 'hookId'.
+ * Leaves numSteps[1] at zero if no slots could be fused.
+ */
+static void PsychPipelineCompileHookChainFusion(PsychWindowRecordType *windowRecord, int hookId, PsychHookPlan* plan)
+{
+    PsychHookPlanStep *steps = plan->steps[0];
+    PsychHookPlanStep *fusedsteps;
+    PsychFusionStage *stages, *run;
+    PsychFusionTexBinding bindings[kPsychMaxFusedTexBindings];
+    PtrPsychHookFunction hookfunc;
+    psych_bool *pointop;
+    psych_bool anyfused = FALSE;
+    int n = plan->numSteps[0];
+    int i, j, k, numStages, numBindings, nfused = 0, firstLink;
+    size_t len;
+    GLuint program;
+
+    plan->fusionCompiled = TRUE;
+
+    // Need at least a shader, a Builtin:FlipFBOs and another shader:
+    if (n < 3) return;
+
+    stages = (PsychFusionStage*) calloc(n, sizeof(PsychFusionStage));
+    run = (PsychFusionStage*) calloc(kPsychMaxFusedStages, sizeof(PsychFusionStage));
+    pointop = (psych_bool*) calloc(n, sizeof(psych_bool));
+    fusedsteps = (PsychHookPlanStep*) calloc(n, sizeof(PsychHookPlanStep));
+    if (!stages || !run || !pointop || !fusedsteps) {
+        free(stages); free(run); free(pointop); free(fusedsteps);
+        return;
+    }
+
+    PsychSetGLContext(windowRecord);
+
+    for (i = 0; i < n; i++) pointop[i] = (steps[i].op == kPsychHookStepSlot) && PsychPipelineAnalyzePointOpSlot(steps[i].hookfunc, &stages[i]);
+
+    for (i = 0; i < n; ) {
+        // Find longest run of point operation slots, separated by FBO ping-pongs and with compatible texture bindings, starting at step i:
+        numStages = 0;
+        numBindings = 0;
+        j = i;
+        if (pointop[i] && PsychPipelineMergeTexBindings(bindings, &numBindings, &stages[i])) {
+            run[numStages++] = stages[i];
+            while ((j + 2 < n) && (steps[j + 1].op == kPsychHookStepFlipFBOs) && pointop[j + 2] && (numStages < kPsychMaxFusedStages) &&
+                   PsychPipelineMergeTexBindings(bindings, &numBindings, &stages[j + 2])) {
+                run[numStages++] = stages[j + 2];
+                j += 2;
+            }
+        }
+
+        if (numStages < 2) {
+            fusedsteps[nfused++] = steps[i++];
+            continue;
+        }
+
+        firstLink = plan->numUniformLinks;
+        program = PsychPipelineCreateFusedProgram(run, numStages, plan);
+        if (program == 0) {
+            if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Failed to fuse slots %i to %i of hook chain '%s'. Executing them as separate passes.\n", i, j, PsychHookPointNames[hookId]);
+            while (i <= j) fusedsteps[nfused++] = steps[i++];
+            continue;
+        }
+
+        // Generated hook slot for the fused pass, with the id's and texture bindings of all fused slots:
+        hookfunc = (PtrPsychHookFunction) calloc(1, sizeof(PsychHookFunction));
+        len = 16;
+        for (k = 0; k < numStages; k++) len += strlen(run[k].hookfunc->idString) + 3;
+        if (hookfunc) hookfunc->idString = (char*) calloc(1, len);
+        if (hookfunc) hookfunc->pString1 = (char*) calloc(1, numBindings * 40 + 1);
+        if (!hookfunc || !hookfunc->idString || !hookfunc->pString1) PsychErrorExitMsg(PsychError_outofMemory, "Failed to allocate memory for fused hook chain pass.");
+
+        strcpy(hookfunc->idString, "Fused:");
+        for (k = 0; k < numStages; k++) {
+            if (k > 0) strcat(hookfunc->idString, " + ");
+            strcat(hookfunc->idString, run[k].hookfunc->idString);
+        }
+
+        for (k = 0; k < numBindings; k++) {
+            sprintf(hookfunc->pString1 + strlen(hookfunc->pString1), "%s%s(%i)=%i", (k > 0) ? " " : "",
+                    texBindingTargets[bindings[k].target], bindings[k].unit, bindings[k].texid);
+        }
+
+        hookfunc->hookfunctype = kPsychShaderFunc;
+        hookfunc->shaderid = program;
+
+        fusedsteps[nfused].hookfunc = hookfunc;
+        fusedsteps[nfused].op = kPsychHookStepFused;
+        fusedsteps[nfused].slot = steps[i].slot;
+        fusedsteps[nfused].numSlots = j - i + 1;
+        fusedsteps[nfused].firstLink = firstLink;
+        fusedsteps[nfused].numLinks = plan->numUniformLinks - firstLink;
+        nfused++;
+
+        if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Fused %i shader slots %i to %i of hook chain '%s' into a single pass.\n", numStages, i, j, PsychHookPointNames[hookId]);
+
+        // The FBO ping-pongs between the fused slots are gone:
+        anyfused = TRUE;
+        i = j + 1;
+    }
+
+    if (anyfused) {
+        plan->steps[1] = fusedsteps;
+        plan->numSteps[1] = nfused;
+        plan->pingpongs[1] = 0;
+        for (i = 0; i < nfused; i++) {
+            if (fusedsteps[i].op == kPsychHookStepFlipFBOs) plan->pingpongs[1]++;
+        }
+    }
+    else {
+        free(fusedsteps);
+    }
+
+    free(stages);
+    free(run);
+    free(pointop);
+
+    return;
+}
+
+// Copy current uniform values of the original programs of a fused step into its fused program. Leaves the fused program bound:
+static void PsychPipelineSyncFusedUniforms(PsychHookPlan* plan, PsychHookPlanStep* step)
+{
+    PsychHookUniformLink* link;
+    GLfloat fv[16];
+    GLint iv[4];
+    int i;
+
+    glUseProgram(step->hookfunc->shaderid);
+
+    for (i = 0; i < step->numLinks; i++) {
+        link = &(plan->uniformLinks[step->firstLink + i]);
+        switch (link->type) {
+            case GL_FLOAT:      glGetUniformfv(link->srcprogram, link->srcloc, fv); glUniform1fv(link->dstloc, 1, fv); break;
+            case GL_FLOAT_VEC2: glGetUniformfv(link->srcprogram, link->srcloc, fv); glUniform2fv(link->dstloc, 1, fv); break;
+            case GL_FLOAT_VEC3: glGetUniformfv(link->srcprogram, link->srcloc, fv); glUniform3fv(link->dstloc, 1, fv); break;
+            case GL_FLOAT_VEC4: glGetUniformfv(link->srcprogram, link->srcloc, fv); glUniform4fv(link->dstloc, 1, fv); break;
+            case GL_FLOAT_MAT2: glGetUniformfv(link->srcprogram, link->srcloc, fv); glUniformMatrix2fv(link->dstloc, 1, GL_FALSE, fv); break;
+            case GL_FLOAT_MAT3: glGetUniformfv(link->srcprogram, link->srcloc, fv); glUniformMatrix3fv(link->dstloc, 1, GL_FALSE, fv); break;
+            case GL_FLOAT_MAT4: glGetUniformfv(link->srcprogram, link->srcloc, fv); glUniformMatrix4fv(link->dstloc, 1, GL_FALSE, fv); break;
+            case GL_INT_VEC2: case GL_BOOL_VEC2:
+                glGetUniformiv(link->srcprogram, link->srcloc, iv); glUniform2iv(link->dstloc, 1, iv); break;
+            case GL_INT_VEC3: case GL_BOOL_VEC3:
+                glGetUniformiv(link->srcprogram, link->srcloc, iv); glUniform3iv(link->dstloc, 1, iv); break;
+            case GL_INT_VEC4: case GL_BOOL_VEC4:
+                glGetUniformiv(link->srcprogram, link->srcloc, iv); glUniform4iv(link->dstloc, 1, iv); break;
+            default:
+                // Scalar int, bool and sampler uniforms:
+                glGetUniformiv(link->srcprogram, link->srcloc, iv); glUniform1iv(link->dstloc, 1, iv); break;
+        }
+    }
+
+    return;
+}
+
+/* Check if a fused plan can be executed with the given buffers: Fused passes skip the intermediate buffers,
+ * so this is only equivalent to unfused execution if all buffers have the same size. The input must be
+ * a rectangle texture, as sampled by the point operation main shaders.
+ */
+static psych_bool PsychPipelineCanExecuteFused(PsychFBO** srcfbo1, PsychFBO** bouncefbo, PsychFBO** bouncefbo2, PsychFBO** dstfbo)
+{
+    PsychFBO* fbos[3];
+    int i;
+
+    if (!(srcfbo1 && *srcfbo1) || ((*srcfbo1)->textarget != GL_TEXTURE_RECTANGLE_EXT)) return(FALSE);
+
+    fbos[0] = (bouncefbo) ? *bouncefbo : NULL;
+    fbos[1] = (bouncefbo2) ? *bouncefbo2 : NULL;
+    fbos[2] = *dstfbo;
+
+    for (i = 0; i < 3; i++) {
+        if (fbos[i] && ((fbos[i]->width != (*srcfbo1)->width) || (fbos[i]->height != (*srcfbo1)->height))) return(FALSE);
+    }
+
+    return(TRUE);
+}
+
+/* Select 2nd bounce buffer for a chain with 'pingpongs' FBO ping-pongs:
+ *
+ * Slightly ugly, because it is a layering violation, but kind'a unavoidable,
+ * as the final output formatting blit chain is a special case...
+ * Assign bouncefbo2 if it is available and needed, otherwise assign dstfbo:
+ * It is available if preConversionFBO[3]>=0. It is needed if pendingFBOpingpongs > 1
+ * and this is one of the final output formatting blit chains. Other chains don't need
+ * this special treatment with a 2nd bounce buffer:
+ */
+static PsychFBO** PsychPipelineGetBounceFBO2(PsychWindowRecordType *windowRecord, int hookId, int pingpongs, PsychFBO** dstfbo)
+{
+    if ((windowRecord->preConversionFBO[3]>=0) && (pingpongs > 1) &&
+        (hookId == kPsychFinalOutputFormattingBlit || hookId == kPsychFinalOutputFormattingBlit0 || hookId == kPsychFinalOutputFormattingBlit1)) {
+        // Assign special 2nd bounce buffer:
+        return(&(windowRecord->fboTable[windowRecord->preConversionFBO[3]]));
+    }
+
+    // Standard case, dstfbo acts as final target and as 2nd bounce buffer if needed for multi-slot chains:
+    return(dstfbo);
+}
+
 /* PsychShutdownImagingPipeline()
  * Shutdown imaging pipeline for a windowRecord and free all ressources associated with it.
  */
@@ -3456,6 +4176,9 @@ void PsychShutdownImagingPipeline(PsychWindowRecordType *windowRecord, psych_boo
                 PsychDeleteFBO(fboptr);
             }
         }
+
+        // Delete compiled hook chain execution plans and their fused GLSL programs:
+        for (i = 0; i < MAX_SCREEN_HOOKS; i++) PsychPipelineFreeHookChainPlan(windowRecord, i, TRUE);
     }
 
     // The following cleanup must only happen after OpenGL rendering context is already detached and
@@ -3464,6 +4187,7 @@ void PsychShutdownImagingPipeline(PsychWindowRecordType *windowRecord, psych_boo
         // Clear all hook chains:
         for (i=0; i<MAX_SCREEN_HOOKS; i++) {
             windowRecord->HookChainEnabled[i]=FALSE;
+            PsychPipelineFreeHookChainPlan(windowRecord, i, FALSE);
             PsychPipelineResetHook(windowRecord, PsychHookPointNames[i]);
         }
 
@@ -3544,6 +4268,9 @@ PsychHookFunction* PsychAddNewHookFunction(PsychWindowRecordType *windowRecord,
     // Lookup hook-chain idx for this name, if any:
     if ((hookidx=PsychGetHookByName(hookString))==-1) PsychErrorExitMsg(PsychError_user, "AddHook: Unknown (non-existent) hook name provided.");
 
+    // Chain changes, so its execution plan needs to be recompiled:
+    PsychPipelineFreeHookChainPlan(windowRecord, hookidx, TRUE);
+
     // Allocate a hook structure:
     hookfunc = (PtrPsychHookFunction) calloc(1, sizeof(PsychHookFunction));
     if (hookfunc==NULL) PsychErrorExitMsg(PsychError_outofMemory, "Failed to allocate memory for new hook function.");
@@ -3617,6 +4344,7 @@ void PsychPipelineResetHook(PsychWindowRecordType *windowRecord, const char* hoo
     PtrPsychHookFunction hookfunc, hookiter;
     int hookidx=PsychGetHookByName(hookString);
     if (hookidx==-1) PsychErrorExitMsg(PsychError_user, "ResetHook: Unknown (non-existent) hook name provided.");
+    PsychPipelineFreeHookChainPlan(windowRecord, hookidx, TRUE);
     hookiter = windowRecord->HookChain[hookidx];
     while(hookiter) {
         hookfunc = hookiter;
@@ -3751,6 +4479,9 @@ void PsychPipelineDeleteHookSlot(PsychWindowRecordType *windowRecord, const char
     // Detach it from hookchain, update predecessors next pointer so it points to successor:
     *prehookfunc = hookfunc->next;
 
+    // Chain changed, so its execution plan needs to be recompiled:
+    PsychPipelineFreeHookChainPlan(windowRecord, hookidx, TRUE);
+
     // Detached. Delete hookfunc:
     free(hookfunc->pString1);
     free(hookfunc->idString);
@@ -3925,16 +4656,21 @@ psych_bool PsychIsHookChainOperational(PsychWindowRecordType *windowRecord, int
 /* PsychPipelineExecuteHook()
  * Execute the full hook processing chain for a specific hook and a specific windowRecord.
  * This checks if the chain is enabled. If it isn't enabled, it skips processing.
- * If it is enabled, it iterates over the full chain, executes all assigned hook functions in order and uses the FBO's between minfbo and maxfbo
- * as pingpong buffers if neccessary.
+ * If it is enabled, it executes the compiled execution plan of the chain, ie., all assigned hook functions in order,
+ * possibly with fused point-operation shader slots, and uses the FBO's between minfbo and maxfbo as pingpong buffers
+ * if neccessary. The plan gets compiled on first execution after any change to the chain.
  */
 psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hookId, void* hookUserData, void* hookBlitterFunction, psych_bool srcIsReadonly, psych_bool allowFBOSwizzle, PsychFBO** srcfbo1, PsychFBO** srcfbo2, PsychFBO** dstfbo, PsychFBO** bouncefbo)
 {
     PtrPsychHookFunction hookfunc;
-    int i=0;
+    PsychHookPlan *plan;
+    PsychHookPlanStep *step;
+    int s, numSteps, profileStage;
+    int fused = 0;
     int pendingFBOpingpongs = 0;
     PsychFBO *mysrcfbo1, *mysrcfbo2, *mydstfbo, *mynxtfbo;
     PsychFBO **bouncefbo2 = NULL;
+    PsychFBO **fusedbouncefbo2;
     psych_bool gfxprocessing;
     GLint restorefboid = 0;
     psych_bool scissor_ignore = FALSE;
@@ -3953,35 +4689,16 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
     // Is this an image processing hook?
     gfxprocessing = (dstfbo!=NULL) ? TRUE : FALSE;
 
-    // Get start of enabled chain:
-    hookfunc = windowRecord->HookChain[hookId];
+    // Get compiled execution plan of the chain, compile it if chain changed since last execution:
+    plan = windowRecord->HookChainPlan[hookId];
+    if (plan == NULL) plan = PsychPipelineCompileHookChain(windowRecord, hookId);
 
-    // Count number of needed ping-pong FBO switches inside this chain:
-    while(hookfunc) {
-        // Pingpong command?
-        if (hookfunc->hookfunctype == kPsychBuiltinFunc && strcmp(hookfunc->idString, "Builtin:FlipFBOs")==0) pendingFBOpingpongs++;
-        // Process next hookfunc slot in chain, if any:
-        hookfunc = hookfunc->next;
-    }
+    // Number of needed ping-pong FBO switches inside this chain, without fusion:
+    pendingFBOpingpongs = plan->pingpongs[0];
 
     if (gfxprocessing) {
         // Prepare gfx-processing:
-
-        // Slightly ugly, because it is a layering violation, but kind'a unavoidable,
-        // as the final output formatting blit chain is a special case...
-        // Assign bouncefbo2 if it is available and needed, otherwise assign dstfbo:
-        // It is available if preConversionFBO[3]>=0. It is needed if pendingFBOpingpongs > 1
-        // and this is one of the final output formatting blit chains. Other chains don't need
-        // this special treatment with a 2nd bounce buffer:
-        if ((windowRecord->preConversionFBO[3]>=0) && (pendingFBOpingpongs > 1) &&
-            (hookId == kPsychFinalOutputFormattingBlit || hookId == kPsychFinalOutputFormattingBlit0 || hookId == kPsychFinalOutputFormattingBlit1)) {
-            // Assign special 2nd bounce buffer:
-            bouncefbo2 = &(windowRecord->fboTable[windowRecord->preConversionFBO[3]]);
-        }
-        else {
-            // Standard case, dstfbo acts as final target and as 2nd bounce buffer if needed for multi-slot chains:
-            bouncefbo2 = dstfbo;
-        }
+        bouncefbo2 = PsychPipelineGetBounceFBO2(windowRecord, hookId, pendingFBOpingpongs, dstfbo);
 
         // Backup scissoring state:
         scissor_enabled = glIsEnabled(GL_SCISSOR_TEST);
@@ -3996,6 +4713,22 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
             PsychErrorExitMsg(PsychError_user, "Insufficient pipeline configuration for processing. Adapt the 'imagingmode' flag according to my tips!");
         }
 
+        // Use plan with fused point-operation shader passes, if enabled, any and applicable. Not
+        // with override blitters or blitter parameters from the caller, as the fused plan only
+        // replicates default identity blits:
+        if (PsychPrefStateGet_FuseHookChainShaders() && (hookUserData == NULL) && (hookBlitterFunction == NULL) && glUseProgram) {
+            if (!plan->fusionCompiled) PsychPipelineCompileHookChainFusion(windowRecord, hookId, plan);
+
+            if (plan->numSteps[1] > 0) {
+                fusedbouncefbo2 = PsychPipelineGetBounceFBO2(windowRecord, hookId, plan->pingpongs[1], dstfbo);
+                if (PsychPipelineCanExecuteFused(srcfbo1, bouncefbo, fusedbouncefbo2, dstfbo)) {
+                    fused = 1;
+                    pendingFBOpingpongs = plan->pingpongs[1];
+                    bouncefbo2 = fusedbouncefbo2;
+                }
+            }
+        }
+
         if ((pendingFBOpingpongs % 2) == 0) {
             // Even number of ping-pongs needed in this chain. We stream from source fbo to
             // destination fbo in first pass.
@@ -4032,60 +4765,69 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
         PsychPipelineSetupRenderFlow(mysrcfbo1, mysrcfbo2, mydstfbo, scissor_ignore);
     }
 
-    // Reget start of enabled chain:
-    hookfunc = windowRecord->HookChain[hookId];
+    numSteps = plan->numSteps[fused];
+
+    // Iterate over all steps:
+    for (s = 0; s < numSteps; s++) {
+        step = &(plan->steps[fused][s]);
+        hookfunc = step->hookfunc;
 
-    // Iterate over all slots:
-    while(hookfunc) {
         // Debug output, if requested:
         if (PsychPrefStateGet_Verbosity()>4) {
-            printf("Hookchain '%s' : Slot %i: Id='%s' : ", PsychHookPointNames[hookId], i, hookfunc->idString);
-            switch(hookfunc->hookfunctype) {
-                case kPsychShaderFunc:
-                    printf("GLSL-Shader      : id=%i , luttex1=%i , blitter=%s\n", hookfunc->shaderid, hookfunc->luttexid1, hookfunc->pString1);
-                    break;
-
-                case kPsychCFunc:
-                    printf("C-Callback       : void*= %p\n", hookfunc->cprocfunc);
-                    break;
-
-                case kPsychMFunc:
-                    printf("Runtime-Function : Evalstring= %s\n", hookfunc->pString1);
-                    break;
-
-                case kPsychBuiltinFunc:
-                    printf("Builtin-Function : Name= %s : Params= %s\n", hookfunc->idString, hookfunc->pString1);
-                    break;
-            }
-        }
-
-        // Is this a ping-pong command?
-        if ((hookfunc->hookfunctype == kPsychBuiltinFunc) && gfxprocessing && (strcmp(hookfunc->idString, "Builtin:FlipFBOs")==0)) {
-            // Ping pong buffer swap requested:
-            pendingFBOpingpongs--;
-            mysrcfbo1 = mydstfbo;
-            mydstfbo  = mynxtfbo;
-            if ((pendingFBOpingpongs % 2) == 0) {
-                // Even number of ping-pongs remaining in this chain.
-                mynxtfbo  = (bouncefbo) ? *bouncefbo : NULL;
+            if (step->op == kPsychHookStepFused) {
+                printf("Hookchain '%s' : Slots %i-%i: Id='%s' : ", PsychHookPointNames[hookId], step->slot, step->slot + step->numSlots - 1, hookfunc->idString);
+                printf("Fused GLSL-Shader : id=%i , blitter=%s\n", hookfunc->shaderid, hookfunc->pString1);
             }
             else {
-                // Odd number of ping-pongs remaining.
-                mynxtfbo  = *bouncefbo2;
+                printf("Hookchain '%s' : Slot %i: Id='%s' : ", PsychHookPointNames[hookId], step->slot, hookfunc->idString);
+                switch(hookfunc->hookfunctype) {
+                    case kPsychShaderFunc:
+                        printf("GLSL-Shader      : id=%i , luttex1=%i , blitter=%s\n", hookfunc->shaderid, hookfunc->luttexid1, hookfunc->pString1);
+                        break;
+
+                    case kPsychCFunc:
+                        printf("C-Callback       : void*= %p\n", hookfunc->cprocfunc);
+                        break;
+
+                    case kPsychMFunc:
+                        printf("Runtime-Function : Evalstring= %s\n", hookfunc->pString1);
+                        break;
+
+                    case kPsychBuiltinFunc:
+                        printf("Builtin-Function : Name= %s : Params= %s\n", hookfunc->idString, hookfunc->pString1);
+                        break;
+                }
             }
+        }
 
-            // Special case: If this is the last processing slot, aka pendingFBOpingpongs == 0,
-            // then mydstfbo must be our real destination framebuffer:
-            if (pendingFBOpingpongs == 0) mydstfbo = *dstfbo;
+        switch (step->op) {
+            case kPsychHookStepFlipFBOs:
+                // Ping pong buffer swap requested. Only meaningful for image processing:
+                if (!gfxprocessing) break;
 
-            if (PsychPrefStateGet_Verbosity()>4) printf("PTB-DEBUG: SWAPPING PING-PONG FBOS, %i swaps pending...\n", pendingFBOpingpongs);
+                pendingFBOpingpongs--;
+                mysrcfbo1 = mydstfbo;
+                mydstfbo  = mynxtfbo;
+                if ((pendingFBOpingpongs % 2) == 0) {
+                    // Even number of ping-pongs remaining in this chain.
+                    mynxtfbo  = (bouncefbo) ? *bouncefbo : NULL;
+                }
+                else {
+                    // Odd number of ping-pongs remaining.
+                    mynxtfbo  = *bouncefbo2;
+                }
 
-            // Set new src -> dst binding:
-            PsychPipelineSetupRenderFlow(mysrcfbo1, mysrcfbo2, mydstfbo, scissor_ignore);
-        }
-        else {
-            // Restricted area processing?
-            if (hookfunc->hookfunctype == kPsychBuiltinFunc && strstr(hookfunc->idString, "Builtin:RestrictToScissorROI")) {
+                // Special case: If this is the last processing slot, aka pendingFBOpingpongs == 0,
+                // then mydstfbo must be our real destination framebuffer:
+                if (pendingFBOpingpongs == 0) mydstfbo = *dstfbo;
+
+                if (PsychPrefStateGet_Verbosity()>4) printf("PTB-DEBUG: SWAPPING PING-PONG FBOS, %i swaps pending...\n", pendingFBOpingpongs);
+
+                // Set new src -> dst binding:
+                PsychPipelineSetupRenderFlow(mysrcfbo1, mysrcfbo2, mydstfbo, scissor_ignore);
+                break;
+
+            case kPsychHookStepScissorROI:
                 // Restrict pixel processing to specified region of interest ROI by setting
                 // up a proper scissor rectangle and enabling scissor tests. The special
                 // ROI (-1,-1,-1,-1) means: Disable scissor testing -> Unrestrict.
@@ -4106,26 +4848,34 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
                     // Make sure PsychSetupRenderFlow() ignores scissor setup:
                     scissor_ignore = TRUE;
                 }
-            }
-            else if (hookfunc->hookfunctype == kPsychBuiltinFunc && strstr(hookfunc->idString, "Builtin:ActivateOpenGLContext")) {
+                break;
+
+            case kPsychHookStepActivateContext:
                 // Enable associated GL context with no other side effects:
                 PsychSetGLContext(windowRecord);
-            }
-            else {
+                break;
+
+            default:
+                // Fused pass? Update its uniforms from the original shaders of its slots:
+                if (step->op == kPsychHookStepFused) PsychPipelineSyncFusedUniforms(plan, step);
+
+                // Time the slot if pipeline profiling is enabled. GPU time only for image processing in our own
+                // OpenGL context, which may not be bound after execution of runtime functions:
+                profileStage = PsychProfilerBeginStage(windowRecord, PsychHookPointNames[hookId], hookfunc->idString, gfxprocessing && (hookfunc->hookfunctype != kPsychMFunc));
+
                 // Normal hook function - Process this hook function:
                 if (!PsychPipelineExecuteHookSlot(windowRecord, hookId, hookfunc, hookUserData, hookBlitterFunction, srcIsReadonly, allowFBOSwizzle, &mysrcfbo1, &mysrcfbo2, &mydstfbo, &mynxtfbo)) {
+                    PsychProfilerEndStage(windowRecord, profileStage);
+
                     // Failed!
                     if (PsychPrefStateGet_Verbosity()>0) {
-                        printf("PTB-ERROR: Failed in processing of Hookchain '%s' : Slot %i: Id='%s'  --> Aborting chain processing. Set verbosity to 5 for extended debug output.\n", PsychHookPointNames[hookId], i, hookfunc->idString);
+                        printf("PTB-ERROR: Failed in processing of Hookchain '%s' : Slot %i: Id='%s'  --> Aborting chain processing. Set verbosity to 5 for extended debug output.\n", PsychHookPointNames[hookId], step->slot, hookfunc->idString);
                     }
                     return(FALSE);
                 }
-            }
-        }
 
-        // Process next hookfunc slot in chain, if any:
-        i++;
-        hookfunc = hookfunc->next;
+                PsychProfilerEndStage(windowRecord, profileStage);
+        }
     }
 
     if (gfxprocessing) {
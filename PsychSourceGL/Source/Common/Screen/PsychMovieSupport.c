@@ -275,3 +275,29 @@ void PsychCopyOutMovieHDRMetaData(int moviehandle, int argPosition)
 
     PsychErrorExitMsg(PsychError_unimplemented, "Sorry, Movie playback support not supported on your configuration.");
 }
+
+/*
+ *  PsychCopyOutMovieDecodeStats() -- Return a struct with decode-ahead and frame drop statistics of this movie to scripting environment.
+ */
+void PsychCopyOutMovieDecodeStats(int moviehandle, int argPosition)
+{
+    #ifdef PTB_USE_GSTREAMER
+    PsychGSCopyOutMovieDecodeStats(moviehandle, argPosition);
+    return;
+    #endif
+
+    PsychErrorExitMsg(PsychError_unimplemented, "Sorry, Movie playback support not supported on your configuration.");
+}
+
+/*
+ *  PsychCopyOutMovieSeekStats() -- Return a struct with frame index, frame cache and seek statistics of this movie to scripting environment.
+ */
+void PsychCopyOutMovieSeekStats(int moviehandle, int argPosition)
+{
+    #ifdef PTB_USE_GSTREAMER
+    PsychGSCopyOutMovieSeekStats(moviehandle, argPosition);
+    return;
+    #endif
+
+    PsychErrorExitMsg(PsychError_unimplemented, "Sorry, Movie playback support not supported on your configuration.");
+}
@@ -48,5 +48,7 @@ void PsychExitMovies(void);
 double PsychGetMovieTimeIndex(int moviehandle);
 double PsychSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames);
 void PsychCopyOutMovieHDRMetaData(int moviehandle, int argPosition);
+void PsychCopyOutMovieDecodeStats(int moviehandle, int argPosition);
+void PsychCopyOutMovieSeekStats(int moviehandle, int argPosition);
 //end include once
 #endif
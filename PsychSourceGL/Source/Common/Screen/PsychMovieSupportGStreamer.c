@@ -34,6 +34,10 @@
 #include <dlfcn.h>
 #endif
 
+// For validation of frame index sidecar cache files against their movie file:
+#include <sys/types.h>
+#include <sys/stat.h>
+
 #if GST_CHECK_VERSION(1,0,0)
 #include <gst/app/gstappsink.h>
 #include <gst/video/video.h>
@@ -66,6 +70,15 @@ typedef enum {
 
 #define PSYCH_MAX_MOVIES 100
 
+// Maximum number of frames in the decode-ahead ring of a movie:
+#define PSYCH_MAX_DECODEAHEAD 16
+
+// Maximum number of decoded frames in the frame cache of a movie:
+#define PSYCH_MAX_FRAMECACHE 64
+
+// Tolerance in seconds for matching target times against presentation timestamps of frames:
+#define PSYCH_FRAMEINDEX_TOLERANCE 0.0001
+
 typedef struct {
     psych_bool valid;
     int type;
@@ -79,6 +92,39 @@ typedef struct {
     double maxContentLightLevel;
 } PsychMovieHDRMetaData;
 
+// One slot of the decode-ahead ring of a movie: A decoded video frame, which the decoder thread
+// pulled from the videosink ahead of time and copied into a mapped pixel unpack buffer, so the
+// master thread only needs to unmap the buffer and kick off an asynchronous texture upload from it:
+typedef struct {
+    GLuint              pbo;                // Pixel unpack buffer of this slot, 0 if not yet created.
+    void                *mem;               // Mapped pbo memory if the slot can receive a frame, NULL while owned by master thread.
+    size_t              size;               // Size of mapped pbo in bytes.
+    size_t              neededSize;         // Size of the last frame which did not fit into the pbo, for remapping at a bigger size.
+    GstSample           *sample;            // Sample of the queued frame if it did not fit into the pbo, NULL if it was copied.
+    double              pts;                // Presentation timestamp of the queued frame in seconds.
+    double              duration;           // Duration of the queued frame in seconds, or 0 if unknown.
+    gint64              bufferIndex;        // Buffer offset of the queued frame.
+    unsigned int        strideBytes;        // Row stride of first plane of the queued frame in bytes, or 0 if unknown.
+    int                 width;              // Width of the queued frame in pixels, or 0 if unknown.
+    int                 height;             // Height of the queued frame in pixels, or 0 if unknown.
+} PsychMovieDecodeSlot;
+
+// One entry of the frame index of a movie, as built by an index pass over the parsed, but not decoded,
+// video stream at movie open time, or loaded from its sidecar cache file:
+typedef struct {
+    double              pts;                // Presentation timestamp of the frame in seconds.
+    int                 keyframe;           // Is this frame a keyframe, ie. decodable without any other frames?
+} PsychMovieIndexEntry;
+
+// One slot of the frame cache of a movie: A deep copy of a decoded video frame which was the target
+// of a seek in manual fetch mode, so repeated seeks to the same target don't need to decode again:
+typedef struct {
+    GstSample           *sample;            // Copy of decoded frame, NULL if slot is unused.
+    double              pts;                // Presentation timestamp of the frame in seconds.
+    double              duration;           // Duration of the frame in seconds.
+    unsigned int        lastUse;            // Value of frameCacheClock at last use, for least recently used replacement.
+} PsychMovieCachedFrame;
+
 typedef struct {
     psych_mutex         mutex;
     psych_condition     condition;
@@ -114,6 +160,41 @@ typedef struct {
     GstVideoInfo        codecVideoInfo;
     GstVideoInfo        sinkVideoInfo;
     GLuint              texturePlanarHDRDecodeShader;
+    int                 decodeAheadDepth;   // Number of slots in decodeRing, as requested via 'movieOptions' DecodeAhead=n. 0 = Disabled.
+    psych_bool          decodeAheadActive;  // Decoder thread running and decodeRing set up?
+    psych_bool          decoderShutdown;    // Request to decoder thread to exit.
+    psych_bool          decodeHold;         // Request to decoder thread to not pull any new frames, e.g., during seeks.
+    psych_thread        decoderThread;
+    psych_condition     decoderCondition;   // Signals new frames in the videosink or free slots in decodeRing to the decoder thread.
+    PsychMovieDecodeSlot decodeRing[PSYCH_MAX_DECODEAHEAD];
+    int                 decodeReadIdx;      // Slot of the oldest queued frame in decodeRing.
+    int                 decodeQueued;       // Number of queued frames in decodeRing.
+    unsigned int        decodeGeneration;   // Incremented whenever decodeRing is flushed, to discard frames in flight.
+    psych_bool          decodePulling;      // Decoder thread is pulling a frame which is not yet queued.
+    int                 decodeFetches;      // Statistics since start of playback: Number of frame fetches from decodeRing,
+    double              decodeQueuedSum;    // sum of queued frames at each fetch,
+    int                 decodeMaxQueued;    // maximum number of queued frames,
+    int                 decodeUnderruns;    // number of fetches which had to wait for a frame, as decodeRing was empty,
+    int                 decodeSkipped;      // number of queued frames skipped to reach a requested target timeindex,
+    int                 decodeFallbacks;    // number of frames which did not fit into a pbo and got uploaded synchronously,
+    int                 decodeSinkDrops;    // and number of frames dropped by the videosink because its queue was full.
+    int                 frameIndexMode;     // Frame index as requested via 'movieOptions' MovieIndex=n: 0 = Off, 1 = With sidecar cache file, 2 = Without.
+    PsychMovieIndexEntry *frameIndex;       // Frame index, sorted by presentation timestamp, or NULL if none.
+    int                 frameIndexCount;    // Number of frames in frameIndex.
+    int                 frameIndexKeyframes;// Number of keyframes in frameIndex.
+    int                 frameIndexPos;      // Index of the currently prerolled frame in manual fetch mode, or -1 if unknown.
+    int                 frameCacheSize;     // Number of slots in frameCache, as requested via 'movieOptions' FrameCache=n. 0 = Disabled.
+    PsychMovieCachedFrame frameCache[PSYCH_MAX_FRAMECACHE];
+    unsigned int        frameCacheClock;    // Incremented at each use of a frameCache slot.
+    PsychMovieCachedFrame *cachedFetch;     // Cached seek target to return at next fetch in manual fetch mode, instead of seeking.
+    psych_bool          cacheInsertPending; // Next fetched frame in manual fetch mode is a seek target and goes into frameCache.
+    psych_bool          seekPending;        // Seek to seekPendingTime is deferred until a frame is needed from the videosink.
+    double              seekPendingTime;
+    int                 seekCount;          // Statistics since movie open: Number of seeks,
+    int                 seekSteps;          // number of seeks done by stepping forward,
+    int                 seekSkips;          // number of seeks to the already prerolled frame,
+    int                 cacheHits;          // number of seeks served from frameCache,
+    int                 cacheMisses;        // and number of seeks not served from frameCache.
 } PsychMovieRecordType;
 
 static PsychMovieRecordType movieRecordBANK[PSYCH_MAX_MOVIES];
@@ -1432,6 +1513,7 @@ static GstFlowReturn PsychNewBufferCallback(GstAppSink *sink, gpointer user_data
     //printf("PTB-DEBUG: New Buffer received.\n");
     movie->frameAvail++;
     PsychSignalCondition(&movie->condition);
+    PsychSignalCondition(&movie->decoderCondition);
     PsychUnlockMutex(&movie->mutex);
 
     return(GST_FLOW_OK);
@@ -1618,6 +1700,663 @@ hwPluginEnableOut:
     return(rc);
 }
 
+/* PsychMovieDecoderThreadMain() -- Main routine of the decode-ahead thread of a movie.
+ *
+ * Pulls new video frames from the videosink as soon as they are decoded during active playback,
+ * and copies them into the mapped pixel unpack buffer of the next free slot of the decodeRing.
+ * This moves the copy of the video data out of PsychGSGetTextureFromMovie(), which then only
+ * needs to start an asynchronous texture upload from the buffer. The thread doesn't use OpenGL.
+ */
+static void* PsychMovieDecoderThreadMain(void* moviePtr)
+{
+    PsychMovieRecordType* movie = (PsychMovieRecordType*) moviePtr;
+    PsychMovieDecodeSlot* slot;
+    GstSample*      sample;
+    GstBuffer*      buffer;
+    GstVideoMeta*   videoMetaData;
+    GstCaps*        caps;
+    unsigned int    generation;
+    int             maxBuffers;
+#if PSYCH_SYSTEM == PSYCH_WINDOWS
+    #pragma warning( disable : 4068 )
+#endif
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+    GstMapInfo      mapinfo = GST_MAP_INFO_INIT;
+    #pragma GCC diagnostic pop
+
+    PsychSetThreadName("PsychMovieDecode");
+
+    PsychLockMutex(&movie->mutex);
+    while (!movie->decoderShutdown) {
+        slot = &(movie->decodeRing[(movie->decodeReadIdx + movie->decodeQueued) % movie->decodeAheadDepth]);
+
+        // Wait until playback is active, the videosink has a new frame and the next slot can receive it:
+        if ((movie->rate == 0) || movie->decodeHold || (movie->frameAvail <= 0) ||
+            (movie->decodeQueued >= movie->decodeAheadDepth) || (slot->mem == NULL)) {
+            PsychTimedWaitCondition(&movie->decoderCondition, &movie->mutex, 0.1);
+            continue;
+        }
+
+        // Clamp frameAvail to maximum queue capacity of the videosink, as in PsychGSGetTextureFromMovie().
+        // Any excess frames got dropped by the videosink:
+        maxBuffers = (int) gst_app_sink_get_max_buffers(GST_APP_SINK(movie->videosink));
+        if ((maxBuffers > 0) && (movie->frameAvail > maxBuffers)) {
+            movie->decodeSinkDrops += movie->frameAvail - maxBuffers;
+            movie->frameAvail = maxBuffers;
+        }
+
+        movie->frameAvail--;
+        movie->decodePulling = TRUE;
+        generation = movie->decodeGeneration;
+        PsychUnlockMutex(&movie->mutex);
+
+        // Pull the oldest frame. Use a timeout, as frameAvail can be stale after a flushing seek:
+        #if GST_CHECK_VERSION(1,10,0)
+        sample = gst_app_sink_try_pull_sample(GST_APP_SINK(movie->videosink), (GstClockTime) (0.1 * 1e9));
+        #else
+        sample = NULL;
+        #endif
+
+        if (sample) {
+            buffer = gst_sample_get_buffer(sample);
+            slot->pts = (double) GST_BUFFER_PTS(buffer) / (double) 1e9;
+            slot->duration = (GST_CLOCK_TIME_IS_VALID(GST_BUFFER_DURATION(buffer))) ? (double) GST_BUFFER_DURATION(buffer) / (double) 1e9 : 0;
+            slot->bufferIndex = GST_BUFFER_OFFSET(buffer);
+
+            videoMetaData = (GstVideoMeta *) gst_buffer_get_meta(buffer, GST_VIDEO_META_API_TYPE);
+            slot->strideBytes = (videoMetaData && videoMetaData->stride[0]) ? videoMetaData->stride[0] : 0;
+
+            slot->width = slot->height = 0;
+            caps = gst_sample_get_caps(sample);
+            if (caps) {
+                GstStructure *str = gst_caps_get_structure(caps, 0);
+                gst_structure_get_int(str, "width", &slot->width);
+                gst_structure_get_int(str, "height", &slot->height);
+            }
+
+            // Copy the video data into the pbo if it fits. Otherwise keep the sample, so the frame
+            // gets uploaded synchronously from it, and the pbo gets remapped at the needed size:
+            slot->sample = sample;
+            if (gst_buffer_map(buffer, &mapinfo, GST_MAP_READ)) {
+                if (mapinfo.size <= slot->size) {
+                    memcpy(slot->mem, mapinfo.data, mapinfo.size);
+                    slot->sample = NULL;
+                }
+                else {
+                    slot->neededSize = mapinfo.size;
+                }
+
+                gst_buffer_unmap(buffer, &mapinfo);
+            }
+
+            if (NULL == slot->sample) gst_sample_unref(sample);
+        }
+
+        PsychLockMutex(&movie->mutex);
+        movie->decodePulling = FALSE;
+        if (sample) {
+            if (generation == movie->decodeGeneration) {
+                // Queue the frame and signal its arrival to a waiting PsychGSGetTextureFromMovie():
+                movie->decodeQueued++;
+                if (movie->decodeQueued > movie->decodeMaxQueued) movie->decodeMaxQueued = movie->decodeQueued;
+                PsychSignalCondition(&movie->condition);
+            }
+            else if (slot->sample) {
+                // decodeRing got flushed meanwhile by a seek or playback rate change. Discard the stale frame:
+                gst_sample_unref(slot->sample);
+                slot->sample = NULL;
+            }
+        }
+    }
+    PsychUnlockMutex(&movie->mutex);
+
+    return(NULL);
+}
+
+/* PsychMovieMapDecodeSlots() -- Map the pixel unpack buffers of all unmapped slots of the decodeRing of 'movie'.
+ *
+ * A slot is unmapped at decode-ahead startup, after PsychGSGetTextureFromMovie() took its frame, or if
+ * mapping failed before. The previous storage of the buffer gets orphaned, so a pending upload from it
+ * doesn't stall us. Only called on the master thread.
+ */
+static void PsychMovieMapDecodeSlots(PsychWindowRecordType *win, PsychMovieRecordType* movie)
+{
+    PsychMovieDecodeSlot* slot;
+    size_t size;
+    void* mem;
+    int i;
+
+    for (i = 0; i < movie->decodeAheadDepth; i++) {
+        // Only the master thread sets mem to NULL, so no need to lock for this check. An unmapped slot
+        // is never queued, so the decoder thread doesn't touch it until we've mapped it:
+        slot = &(movie->decodeRing[i]);
+        if (slot->mem) continue;
+
+        PsychSetGLContext(win);
+        size = (slot->neededSize > slot->size) ? slot->neededSize : slot->size;
+        if (slot->pbo == 0) glGenBuffers(1, &slot->pbo);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->pbo);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) size, NULL, GL_STREAM_DRAW);
+        mem = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (NULL == mem) {
+            // Retry at next frame fetch. Until then the decoder thread stalls at this slot:
+            while (glGetError());
+            if (PsychPrefStateGet_Verbosity() > 5)
+                printf("PTB-DEBUG: Could not map %i MB upload buffer for decode-ahead slot %i. Will retry.\n", (int) (size / 1024 / 1024), i);
+            continue;
+        }
+
+        PsychLockMutex(&movie->mutex);
+        slot->mem = mem;
+        slot->size = size;
+        PsychSignalCondition(&movie->decoderCondition);
+        PsychUnlockMutex(&movie->mutex);
+    }
+}
+
+/* PsychMovieStopDecodeAhead() -- Stop the decoder thread of 'movie' and release its decodeRing. */
+static void PsychMovieStopDecodeAhead(PsychMovieRecordType* movie)
+{
+    PsychMovieDecodeSlot* slot;
+    int i;
+
+    if (movie->decodeAheadActive) {
+        PsychLockMutex(&movie->mutex);
+        movie->decoderShutdown = TRUE;
+        PsychSignalCondition(&movie->decoderCondition);
+        PsychUnlockMutex(&movie->mutex);
+        PsychDeleteThread(&movie->decoderThread);
+        movie->decodeAheadActive = FALSE;
+    }
+
+    for (i = 0; i < PSYCH_MAX_DECODEAHEAD; i++) {
+        slot = &(movie->decodeRing[i]);
+        if (slot->sample) gst_sample_unref(slot->sample);
+
+        if (slot->pbo) {
+            PsychSetGLContext(movie->parentRecord);
+            if (slot->mem) {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->pbo);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            glDeleteBuffers(1, &slot->pbo);
+        }
+    }
+
+    memset(movie->decodeRing, 0, sizeof(movie->decodeRing));
+    movie->decodeReadIdx = 0;
+    movie->decodeQueued = 0;
+    movie->decoderShutdown = FALSE;
+}
+
+/* PsychMovieStartDecodeAhead() -- Set up the decodeRing of 'movie' and start its decoder thread.
+ *
+ * Disables decode-ahead for the movie if the OpenGL implementation or movie format don't support it.
+ */
+static void PsychMovieStartDecodeAhead(PsychWindowRecordType *win, PsychMovieRecordType* movie)
+{
+    size_t size;
+    int i, rc;
+
+    // Need pixel unpack buffers, mapping of buffer ranges and fences for asynchronous uploads, the same window
+    // for upload as for cleanup, and no post-processing of video data on the cpu for Bayer filtering or the
+    // swizzling of 16 bpc RGBA data:
+    if (PsychIsGLES(win) || !(GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object) || !(GLEW_VERSION_3_2 || GLEW_ARB_sync) ||
+        !(GLEW_VERSION_3_0 || GLEW_ARB_map_buffer_range) || (win != movie->parentRecord) || (movie->specialFlags1 & 1024) ||
+        ((movie->pixelFormat == 4) && (movie->bitdepth > 8))) {
+        if (PsychPrefStateGet_Verbosity() > 2)
+            printf("PTB-INFO: Decode-ahead of video frames is not supported for this movie format or graphics driver. Disabled.\n");
+
+        movie->decodeAheadDepth = 0;
+        return;
+    }
+
+    // Initial pbo size from the video format negotiated by the videosink. This gets increased on demand:
+    size = GST_VIDEO_INFO_SIZE(&movie->sinkVideoInfo);
+    if (size == 0) size = (size_t) movie->width * (size_t) movie->height * 4 * ((movie->bitdepth > 8) ? 2 : 1);
+
+    for (i = 0; i < movie->decodeAheadDepth; i++) movie->decodeRing[i].size = size;
+    PsychMovieMapDecodeSlots(win, movie);
+
+    if ((rc = PsychCreateThread(&movie->decoderThread, NULL, PsychMovieDecoderThreadMain, (void*) movie))) {
+        if (PsychPrefStateGet_Verbosity() > 1)
+            printf("PTB-WARNING: Could not create decoder thread for decode-ahead of video frames [%s]. Disabled.\n", strerror(rc));
+
+        PsychMovieStopDecodeAhead(movie);
+        movie->decodeAheadDepth = 0;
+        return;
+    }
+
+    movie->decodeAheadActive = TRUE;
+
+    if (PsychPrefStateGet_Verbosity() > 3)
+        printf("PTB-INFO: Decode-ahead of up to %i video frames enabled for movie.\n", movie->decodeAheadDepth);
+}
+
+/* PsychMovieHoldDecodeAhead() -- Stop or resume pulling of new frames by the decoder thread of 'movie'.
+ *
+ * Stopping also discards all queued frames. Used around seeks and playback rate changes, so no stale
+ * frames from before the change end up in the decodeRing.
+ */
+static void PsychMovieHoldDecodeAhead(PsychMovieRecordType* movie, psych_bool hold)
+{
+    PsychMovieDecodeSlot* slot;
+    int i;
+
+    if (!movie->decodeAheadActive) return;
+
+    PsychLockMutex(&movie->mutex);
+    movie->decodeHold = hold;
+    if (hold) {
+        for (i = 0; i < movie->decodeQueued; i++) {
+            slot = &(movie->decodeRing[(movie->decodeReadIdx + i) % movie->decodeAheadDepth]);
+            if (slot->sample) gst_sample_unref(slot->sample);
+            slot->sample = NULL;
+        }
+
+        movie->decodeQueued = 0;
+        movie->decodeGeneration++;
+    }
+    PsychSignalCondition(&movie->decoderCondition);
+    PsychUnlockMutex(&movie->mutex);
+}
+
+/* PsychMovieFramesAvailable() -- Number of new video frames available for fetch from 'movie' at playback 'rate'. */
+static int PsychMovieFramesAvailable(PsychMovieRecordType* movie, double rate)
+{
+    if (0 == rate) return((movie->cachedFetch) ? 1 : movie->preRollAvail);
+
+    return((movie->decodeAheadActive) ? movie->decodeQueued : movie->frameAvail);
+}
+
+/* PsychMovieFrameIndexLookup() -- Index of the frame in the frame index of 'movie' which is shown at time 'timeindex'.
+ *
+ * Returns the last frame with a presentation timestamp not later than 'timeindex', or -1 if there isn't one.
+ */
+static int PsychMovieFrameIndexLookup(PsychMovieRecordType* movie, double timeindex)
+{
+    int lo, hi, mid;
+
+    if (!movie->frameIndex || (movie->frameIndex[0].pts > timeindex + PSYCH_FRAMEINDEX_TOLERANCE)) return(-1);
+
+    // Binary search, with invariant pts[lo] <= timeindex:
+    lo = 0;
+    hi = movie->frameIndexCount - 1;
+    while (lo < hi) {
+        mid = (lo + hi + 1) / 2;
+        if (movie->frameIndex[mid].pts <= timeindex + PSYCH_FRAMEINDEX_TOLERANCE)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    return(lo);
+}
+
+/* PsychMovieFrameIndexKeyframe() -- Index of the last keyframe at or before frame 'frame' in the frame index of 'movie'. */
+static int PsychMovieFrameIndexKeyframe(PsychMovieRecordType* movie, int frame)
+{
+    while ((frame > 0) && !movie->frameIndex[frame].keyframe) frame--;
+
+    return(frame);
+}
+
+/* Comparison function for qsort() of frame index entries by presentation timestamp: */
+static int PsychMovieCompareIndexEntries(const void* a, const void* b)
+{
+    double d = ((const PsychMovieIndexEntry*) a)->pts - ((const PsychMovieIndexEntry*) b)->pts;
+
+    return((d < 0) ? -1 : ((d > 0) ? 1 : 0));
+}
+
+#if GST_CHECK_VERSION(1,10,0)
+/* Called by the parsebin of the index pass whenever it found a new elementary stream in the movie.
+ * Links the first video stream to the appsink of the index pass, and all other streams to fakesinks.
+ */
+static void PsychMovieIndexPadAdded(GstElement *parser, GstPad *pad, gpointer user_data)
+{
+    GstElement  *pipeline = (GstElement*) user_data;
+    GstElement  *sink;
+    GstPad      *sinkpad = NULL;
+    GstCaps     *caps;
+    (void) parser;
+
+    caps = gst_pad_get_current_caps(pad);
+    if (!caps) caps = gst_pad_query_caps(pad, NULL);
+
+    sink = gst_bin_get_by_name(GST_BIN(pipeline), "ptbmovieindexsink");
+    if (sink) {
+        sinkpad = gst_element_get_static_pad(sink, "sink");
+        gst_object_unref(sink);
+    }
+
+    if (!caps || gst_caps_is_empty(caps) || !g_str_has_prefix(gst_structure_get_name(gst_caps_get_structure(caps, 0)), "video/") ||
+        !sinkpad || gst_pad_is_linked(sinkpad)) {
+        // Not the first video stream: Discard it.
+        if (sinkpad) gst_object_unref(sinkpad);
+        sink = gst_element_factory_make("fakesink", NULL);
+        g_object_set(G_OBJECT(sink), "sync", FALSE, NULL);
+        gst_bin_add(GST_BIN(pipeline), sink);
+        gst_element_sync_state_with_parent(sink);
+        sinkpad = gst_element_get_static_pad(sink, "sink");
+    }
+
+    // A failed link shows up as a stuck or failed index pass in PsychMovieBuildFrameIndex():
+    gst_pad_link(pad, sinkpad);
+    gst_object_unref(sinkpad);
+    if (caps) gst_caps_unref(caps);
+}
+#endif
+
+/* PsychMovieBuildFrameIndex() -- Build the frame index of 'movie' by an index pass over its video stream.
+ *
+ * Runs the movie through a separate pipeline which only demuxes and parses, but doesn't decode,
+ * and records the presentation timestamp and keyframe flag of each video frame. This is mostly
+ * limited by i/o speed, so it is much faster than a decoding pass. Returns TRUE on success.
+ */
+static psych_bool PsychMovieBuildFrameIndex(PsychMovieRecordType* movie, psych_bool printErrors)
+{
+#if GST_CHECK_VERSION(1,10,0)
+    GstElement              *pipeline, *source, *parser, *indexsink;
+    GstSample               *sample;
+    GstBuffer               *buffer;
+    GstBus                  *bus;
+    GstMessage              *msg;
+    PsychMovieIndexEntry    *entries = NULL;
+    int                     count = 0, capacity = 0, keyframes = 0;
+    psych_bool              failed = FALSE;
+    double                  tStart, tLast, tNow;
+
+    pipeline = gst_pipeline_new("ptbmovieindexpipeline");
+    source = gst_element_make_from_uri(GST_URI_SRC, movie->movieLocation, NULL, NULL);
+    parser = gst_element_factory_make("parsebin", NULL);
+    indexsink = gst_element_factory_make("appsink", "ptbmovieindexsink");
+    if (!pipeline || !source || !parser || !indexsink) {
+        if (printErrors && (PsychPrefStateGet_Verbosity() > 1))
+            printf("PTB-WARNING: Could not create pipeline for index pass over movie %s. Frame index disabled.\n", movie->movieName);
+
+        if (pipeline) gst_object_unref(pipeline);
+        if (source) gst_object_unref(source);
+        if (parser) gst_object_unref(parser);
+        if (indexsink) gst_object_unref(indexsink);
+        return(FALSE);
+    }
+
+    // Pull parsed frames as fast as possible, without any buffering limit:
+    g_object_set(G_OBJECT(indexsink), "sync", FALSE, NULL);
+    gst_bin_add_many(GST_BIN(pipeline), source, parser, indexsink, NULL);
+    g_signal_connect(parser, "pad-added", G_CALLBACK(PsychMovieIndexPadAdded), pipeline);
+    if (!gst_element_link(source, parser) || (GST_STATE_CHANGE_FAILURE == gst_element_set_state(pipeline, GST_STATE_PLAYING))) failed = TRUE;
+
+    bus = gst_element_get_bus(pipeline);
+    PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+    tLast = tStart;
+
+    while (!failed && !gst_app_sink_is_eos(GST_APP_SINK(indexsink))) {
+        sample = gst_app_sink_try_pull_sample(GST_APP_SINK(indexsink), GST_SECOND / 10);
+        PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+
+        if (!sample) {
+            // Nothing parsed within 0.1 seconds. Check for errors, or a stuck pass, e.g., if no stream got linked to our sink:
+            msg = gst_bus_pop_filtered(bus, GST_MESSAGE_ERROR);
+            if (msg) {
+                gst_message_unref(msg);
+                failed = TRUE;
+            }
+
+            if (tNow - tLast > 10) failed = TRUE;
+            continue;
+        }
+
+        tLast = tNow;
+        buffer = gst_sample_get_buffer(sample);
+
+        // Skip codec headers and other buffers which don't correspond to displayed frames:
+        if (buffer && GST_BUFFER_PTS_IS_VALID(buffer) && !GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DECODE_ONLY)) {
+            if (count == capacity) {
+                capacity = (capacity > 0) ? capacity * 2 : 4096;
+                entries = (PsychMovieIndexEntry*) realloc(entries, capacity * sizeof(PsychMovieIndexEntry));
+                if (NULL == entries) {
+                    gst_sample_unref(sample);
+                    failed = TRUE;
+                    break;
+                }
+            }
+
+            entries[count].pts = (double) GST_BUFFER_PTS(buffer) / (double) 1e9;
+            entries[count].keyframe = (GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT)) ? 0 : 1;
+            if (entries[count].keyframe) keyframes++;
+            count++;
+        }
+
+        gst_sample_unref(sample);
+    }
+
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    gst_object_unref(bus);
+    gst_object_unref(pipeline);
+
+    if (failed || (count == 0) || (keyframes == 0)) {
+        if (printErrors && (PsychPrefStateGet_Verbosity() > 1))
+            printf("PTB-WARNING: Index pass over movie %s failed, or found no timestamped video frames. Frame index disabled.\n", movie->movieName);
+
+        free(entries);
+        return(FALSE);
+    }
+
+    // Frames are parsed in decode order. Sort them into presentation order:
+    qsort(entries, count, sizeof(PsychMovieIndexEntry), PsychMovieCompareIndexEntries);
+
+    movie->frameIndex = entries;
+    movie->frameIndexCount = count;
+    movie->frameIndexKeyframes = keyframes;
+
+    if (printErrors && (PsychPrefStateGet_Verbosity() > 3))
+        printf("PTB-INFO: Index pass over movie %s found %i frames with %i keyframes in %f seconds.\n", movie->movieName, count, keyframes, tNow - tStart);
+
+    return(TRUE);
+#else
+    (void) movie;
+    (void) printErrors;
+    return(FALSE);
+#endif
+}
+
+/* PsychMovieFrameIndexFilename() -- Build filename of the sidecar cache file for the frame index of 'movie'.
+ *
+ * The cache file is stored next to the movie file, with an added .ptbindex extension. Returns FALSE if the
+ * movie is not a local file. On success, 'moviePath' receives the filesystem path of the movie file itself.
+ */
+static psych_bool PsychMovieFrameIndexFilename(PsychMovieRecordType* movie, char* indexPath, char* moviePath)
+{
+    const char* name = movie->movieName;
+
+    // Only local files, specified by path or as file:// URI:
+    if (strstr(name, "file://") == name) {
+        name += strlen("file://");
+        #if PSYCH_SYSTEM == PSYCH_WINDOWS
+        if (name[0] == '/') name++;
+        #endif
+    }
+    else if (strstr(name, "://") || (strstr(name, "v4l") == name)) {
+        return(FALSE);
+    }
+
+    snprintf(moviePath, FILENAME_MAX, "%s", name);
+    snprintf(indexPath, FILENAME_MAX, "%s.ptbindex", name);
+
+    return(TRUE);
+}
+
+// Header of a frame index sidecar cache file, followed by 'count' PsychMovieIndexEntry records:
+typedef struct {
+    char            magic[8];       // "PTBMIDX" + version.
+    psych_int64     entrySize;      // sizeof(PsychMovieIndexEntry), to reject files from incompatible builds.
+    psych_int64     movieSize;      // Size of the movie file in bytes, ...
+    psych_int64     movieMTime;     // ... and time of its last modification, to reject stale cache files.
+    psych_int64     count;
+    psych_int64     keyframes;
+} PsychMovieIndexFileHeader;
+
+/* PsychMovieLoadFrameIndex() -- Load the frame index of 'movie' from its sidecar cache file, if a valid one exists. */
+static psych_bool PsychMovieLoadFrameIndex(PsychMovieRecordType* movie)
+{
+    PsychMovieIndexFileHeader   header;
+    char                        indexPath[FILENAME_MAX];
+    char                        moviePath[FILENAME_MAX];
+    struct stat                 movieStat;
+    FILE                        *fd;
+    PsychMovieIndexEntry        *entries;
+
+    if (!PsychMovieFrameIndexFilename(movie, indexPath, moviePath) || stat(moviePath, &movieStat)) return(FALSE);
+
+    fd = fopen(indexPath, "rb");
+    if (NULL == fd) return(FALSE);
+
+    if ((1 != fread(&header, sizeof(header), 1, fd)) || memcmp(header.magic, "PTBMIDX1", 8) ||
+        (header.entrySize != (psych_int64) sizeof(PsychMovieIndexEntry)) || (header.movieSize != (psych_int64) movieStat.st_size) ||
+        (header.movieMTime != (psych_int64) movieStat.st_mtime) || (header.count <= 0) || (header.count > INT_MAX / (int) sizeof(PsychMovieIndexEntry))) {
+        fclose(fd);
+        return(FALSE);
+    }
+
+    entries = (PsychMovieIndexEntry*) malloc((size_t) header.count * sizeof(PsychMovieIndexEntry));
+    if ((NULL == entries) || ((size_t) header.count != fread(entries, sizeof(PsychMovieIndexEntry), (size_t) header.count, fd))) {
+        free(entries);
+        fclose(fd);
+        return(FALSE);
+    }
+
+    fclose(fd);
+
+    movie->frameIndex = entries;
+    movie->frameIndexCount = (int) header.count;
+    movie->frameIndexKeyframes = (int) header.keyframes;
+
+    return(TRUE);
+}
+
+/* PsychMovieSaveFrameIndex() -- Save the frame index of 'movie' to its sidecar cache file, for fast reopen. */
+static psych_bool PsychMovieSaveFrameIndex(PsychMovieRecordType* movie)
+{
+    PsychMovieIndexFileHeader   header;
+    char                        indexPath[FILENAME_MAX];
+    char                        moviePath[FILENAME_MAX];
+    struct stat                 movieStat;
+    FILE                        *fd;
+    psych_bool                  rc;
+
+    if (!PsychMovieFrameIndexFilename(movie, indexPath, moviePath) || stat(moviePath, &movieStat)) return(FALSE);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "PTBMIDX1", 8);
+    header.entrySize = (psych_int64) sizeof(PsychMovieIndexEntry);
+    header.movieSize = (psych_int64) movieStat.st_size;
+    header.movieMTime = (psych_int64) movieStat.st_mtime;
+    header.count = movie->frameIndexCount;
+    header.keyframes = movie->frameIndexKeyframes;
+
+    // Movie directory may be read-only, which is fine - we just can't speed up the next open then:
+    fd = fopen(indexPath, "wb");
+    if (NULL == fd) return(FALSE);
+
+    rc = (1 == fwrite(&header, sizeof(header), 1, fd)) &&
+         ((size_t) movie->frameIndexCount == fwrite(movie->frameIndex, sizeof(PsychMovieIndexEntry), (size_t) movie->frameIndexCount, fd));
+    if (fclose(fd) || !rc) {
+        remove(indexPath);
+        return(FALSE);
+    }
+
+    return(TRUE);
+}
+
+/* PsychMovieReleaseFrameIndex() -- Release the frame index and the frame cache of 'movie'. */
+static void PsychMovieReleaseFrameIndex(PsychMovieRecordType* movie)
+{
+    int i;
+
+    for (i = 0; i < PSYCH_MAX_FRAMECACHE; i++) {
+        if (movie->frameCache[i].sample) gst_sample_unref(movie->frameCache[i].sample);
+        movie->frameCache[i].sample = NULL;
+    }
+
+    movie->cachedFetch = NULL;
+    movie->cacheInsertPending = FALSE;
+    movie->seekPending = FALSE;
+
+    free(movie->frameIndex);
+    movie->frameIndex = NULL;
+    movie->frameIndexCount = 0;
+    movie->frameIndexKeyframes = 0;
+    movie->frameIndexPos = -1;
+}
+
+/* PsychMovieFrameCacheLookup() -- Find the cached frame of 'movie' which is shown at time 'timeindex', or NULL if none. */
+static PsychMovieCachedFrame* PsychMovieFrameCacheLookup(PsychMovieRecordType* movie, double timeindex)
+{
+    PsychMovieCachedFrame* frame;
+    int i;
+
+    for (i = 0; i < movie->frameCacheSize; i++) {
+        frame = &(movie->frameCache[i]);
+        if (frame->sample && ((fabs(timeindex - frame->pts) <= PSYCH_FRAMEINDEX_TOLERANCE) ||
+            ((timeindex > frame->pts) && (timeindex < frame->pts + frame->duration - PSYCH_FRAMEINDEX_TOLERANCE)))) {
+            frame->lastUse = ++movie->frameCacheClock;
+            return(frame);
+        }
+    }
+
+    return(NULL);
+}
+
+/* PsychMovieFrameCacheInsert() -- Insert a copy of the decoded frame 'sample' into the frame cache of 'movie'.
+ *
+ * Replaces the least recently used frame if the cache is full. The frame gets copied, so the decoder
+ * gets its buffer back, as some decoders only have a small fixed pool of them.
+ */
+static void PsychMovieFrameCacheInsert(PsychMovieRecordType* movie, GstSample* sample)
+{
+#if GST_CHECK_VERSION(1,6,0)
+    PsychMovieCachedFrame* frame = NULL;
+    GstBuffer* buffer = gst_sample_get_buffer(sample);
+    GstBuffer* copy;
+    double pts;
+    int i;
+
+    if (!buffer || !GST_BUFFER_PTS_IS_VALID(buffer)) return;
+    pts = (double) GST_BUFFER_PTS(buffer) / (double) 1e9;
+
+    // Already cached? Otherwise take a free slot, or the least recently used one:
+    for (i = 0; i < movie->frameCacheSize; i++) {
+        if (movie->frameCache[i].sample && (fabs(movie->frameCache[i].pts - pts) <= PSYCH_FRAMEINDEX_TOLERANCE)) {
+            movie->frameCache[i].lastUse = ++movie->frameCacheClock;
+            return;
+        }
+
+        if (!frame || (frame->sample && (!movie->frameCache[i].sample || (movie->frameCache[i].lastUse < frame->lastUse))))
+            frame = &(movie->frameCache[i]);
+    }
+
+    if (!frame || !(copy = gst_buffer_copy_deep(buffer))) return;
+
+    if (frame->sample) gst_sample_unref(frame->sample);
+    frame->sample = gst_sample_new(copy, gst_sample_get_caps(sample), gst_sample_get_segment(sample), NULL);
+    gst_buffer_unref(copy);
+
+    frame->pts = pts;
+    frame->duration = (GST_CLOCK_TIME_IS_VALID(GST_BUFFER_DURATION(buffer))) ? (double) GST_BUFFER_DURATION(buffer) / (double) 1e9 :
+                      ((movie->fps > 0) ? 1.0 / movie->fps : 0);
+    frame->lastUse = ++movie->frameCacheClock;
+#else
+    (void) movie;
+    (void) sample;
+#endif
+}
+
 /*
  *      PsychGSCreateMovie() -- Create a movie object.
  *
@@ -1695,6 +2434,9 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
         strncpy(movieRecordBANK[*moviehandle].movieLocation, movieLocation, FILENAME_MAX);
         strncpy(movieRecordBANK[*moviehandle].movieName, moviename, FILENAME_MAX);
 
+        // Frame index and cached frames belong to the previous movie, so drop them:
+        PsychMovieReleaseFrameIndex(&movieRecordBANK[*moviehandle]);
+
         // Assign name of movie to play to pipeline. If the pipeline is not in playing
         // state, this will switch to the specified movieLocation immediately. If it
         // is playing, it will switch to it at the end of the current playback iteration:
@@ -1762,6 +2504,9 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
     // Store specialFlags1 from open call:
     movieRecordBANK[slotid].specialFlags1 = specialFlags1;
 
+    // Position of prerolled frame in frame index unknown as of yet:
+    movieRecordBANK[slotid].frameIndexPos = -1;
+
     // Create name-string for moviename: If an URI qualifier is at the beginning,
     // we're fine and just pass the URI as-is. Otherwise we add the file:// URI prefix.
     if (strstr(moviename, "://") || ((strstr(moviename, "v4l") == moviename) && strstr(moviename, "//"))) {
@@ -2181,6 +2926,63 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
         }
     }
 
+    // Decode-ahead of video frames by a decoder thread into a ring of upload buffers requested?
+    if ((pstring = strstr((char*) movieOptions, "DecodeAhead="))) {
+        if ((1 != sscanf(pstring, "DecodeAhead=%i", &movieRecordBANK[slotid].decodeAheadDepth)) ||
+            (movieRecordBANK[slotid].decodeAheadDepth < 0) || (movieRecordBANK[slotid].decodeAheadDepth > PSYCH_MAX_DECODEAHEAD)) {
+            movieRecordBANK[slotid].decodeAheadDepth = 0;
+            printf("PTB-ERROR: Invalid DecodeAhead parameter specified in 'movieOptions' [= '%s']: Must be a number of frames between 0 and %i!\n", pstring, PSYCH_MAX_DECODEAHEAD);
+            if (printErrors)
+                PsychErrorExitMsg(PsychError_user, "Invalid DecodeAhead parameter specified in 'movieOptions' parameter.");
+            else
+                return;
+        }
+
+        #if !GST_CHECK_VERSION(1,10,0)
+        if (movieRecordBANK[slotid].decodeAheadDepth && (PsychPrefStateGet_Verbosity() > 1))
+            printf("PTB-WARNING: Decode-ahead of video frames requested via 'movieOptions', but this needs GStreamer 1.10 or later. Disabled.\n");
+        movieRecordBANK[slotid].decodeAheadDepth = 0;
+        #endif
+    }
+
+    // Frame index for fast and frame accurate random access requested?
+    if ((pstring = strstr((char*) movieOptions, "MovieIndex="))) {
+        if ((1 != sscanf(pstring, "MovieIndex=%i", &movieRecordBANK[slotid].frameIndexMode)) ||
+            (movieRecordBANK[slotid].frameIndexMode < 0) || (movieRecordBANK[slotid].frameIndexMode > 2)) {
+            movieRecordBANK[slotid].frameIndexMode = 0;
+            printf("PTB-ERROR: Invalid MovieIndex parameter specified in 'movieOptions' [= '%s']: Must be 0, 1 or 2!\n", pstring);
+            if (printErrors)
+                PsychErrorExitMsg(PsychError_user, "Invalid MovieIndex parameter specified in 'movieOptions' parameter.");
+            else
+                return;
+        }
+
+        #if !GST_CHECK_VERSION(1,10,0)
+        if (movieRecordBANK[slotid].frameIndexMode && (PsychPrefStateGet_Verbosity() > 1))
+            printf("PTB-WARNING: Frame index requested via 'movieOptions', but this needs GStreamer 1.10 or later. Disabled.\n");
+        movieRecordBANK[slotid].frameIndexMode = 0;
+        #endif
+    }
+
+    // Cache of decoded frames at seek targets requested?
+    if ((pstring = strstr((char*) movieOptions, "FrameCache="))) {
+        if ((1 != sscanf(pstring, "FrameCache=%i", &movieRecordBANK[slotid].frameCacheSize)) ||
+            (movieRecordBANK[slotid].frameCacheSize < 0) || (movieRecordBANK[slotid].frameCacheSize > PSYCH_MAX_FRAMECACHE)) {
+            movieRecordBANK[slotid].frameCacheSize = 0;
+            printf("PTB-ERROR: Invalid FrameCache parameter specified in 'movieOptions' [= '%s']: Must be a number of frames between 0 and %i!\n", pstring, PSYCH_MAX_FRAMECACHE);
+            if (printErrors)
+                PsychErrorExitMsg(PsychError_user, "Invalid FrameCache parameter specified in 'movieOptions' parameter.");
+            else
+                return;
+        }
+
+        #if !GST_CHECK_VERSION(1,6,0)
+        if (movieRecordBANK[slotid].frameCacheSize && (PsychPrefStateGet_Verbosity() > 1))
+            printf("PTB-WARNING: Frame cache requested via 'movieOptions', but this needs GStreamer 1.6 or later. Disabled.\n");
+        movieRecordBANK[slotid].frameCacheSize = 0;
+        #endif
+    }
+
     // Preload / Preroll the pipeline:
     if (!PsychMoviePipelineSetState(theMovie, GST_STATE_PAUSED, 30.0)) {
         PsychGSProcessMovieContext(&(movieRecordBANK[slotid]), TRUE);
@@ -2330,6 +3132,7 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
 
     PsychInitMutex(&movieRecordBANK[slotid].mutex);
     PsychInitCondition(&movieRecordBANK[slotid].condition, NULL);
+    PsychInitCondition(&movieRecordBANK[slotid].decoderCondition, NULL);
 
     // Install callbacks used by the videosink (appsink) to announce various events:
     gst_app_sink_set_callbacks(GST_APP_SINK(videosink), &videosinkCallbacks, &(movieRecordBANK[slotid]), PsychDestroyNotifyCallback);
@@ -2495,6 +3298,42 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
     movieRecordBANK[slotid].nrframes = (int)(movieRecordBANK[slotid].fps * movieRecordBANK[slotid].movieduration + 0.5);
     //printf("PTB-DEBUG: Number of frames in movie %i [%s] is %i.\n", slotid, moviename, movieRecordBANK[slotid].nrframes);
 
+    // Frame index requested? Load it from its sidecar cache file if allowed and valid, otherwise build it by an index pass:
+    if (movieRecordBANK[slotid].frameIndexMode && (movieRecordBANK[slotid].nrVideoTracks > 0)) {
+        if ((movieRecordBANK[slotid].frameIndexMode != 1) || !PsychMovieLoadFrameIndex(&movieRecordBANK[slotid])) {
+            if (PsychMovieBuildFrameIndex(&movieRecordBANK[slotid], printErrors) && (movieRecordBANK[slotid].frameIndexMode == 1) &&
+                !PsychMovieSaveFrameIndex(&movieRecordBANK[slotid]) && printErrors && (PsychPrefStateGet_Verbosity() > 3)) {
+                printf("PTB-INFO: Could not save frame index of movie %s to a sidecar cache file next to it.\n", moviename);
+            }
+        }
+        else if (printErrors && (PsychPrefStateGet_Verbosity() > 3)) {
+            printf("PTB-INFO: Loaded frame index of movie %s with %i frames from its sidecar cache file.\n", moviename, movieRecordBANK[slotid].frameIndexCount);
+        }
+
+        #if GST_CHECK_VERSION(1,10,0)
+        // Frame index timestamps must match the timestamps of decoded frames, as verified with the prerolled first frame:
+        if (movieRecordBANK[slotid].frameIndex) {
+            GstSample *sample = gst_app_sink_try_pull_preroll(GST_APP_SINK(videosink), GST_SECOND);
+            GstBuffer *buffer = (sample) ? gst_sample_get_buffer(sample) : NULL;
+
+            if (buffer && GST_BUFFER_PTS_IS_VALID(buffer) &&
+                (fabs((double) GST_BUFFER_PTS(buffer) / (double) 1e9 - movieRecordBANK[slotid].frameIndex[0].pts) <= PSYCH_FRAMEINDEX_TOLERANCE)) {
+                movieRecordBANK[slotid].frameIndexPos = 0;
+            }
+            else {
+                if (printErrors && (PsychPrefStateGet_Verbosity() > 1))
+                    printf("PTB-WARNING: Frame index of movie %s does not match its decoded frames. Frame index disabled.\n", moviename);
+                PsychMovieReleaseFrameIndex(&movieRecordBANK[slotid]);
+            }
+
+            if (sample) gst_sample_unref(sample);
+        }
+        #endif
+
+        // Frame count from the index is exact:
+        if (movieRecordBANK[slotid].frameIndex) movieRecordBANK[slotid].nrframes = movieRecordBANK[slotid].frameIndexCount;
+    }
+
     // Is this movie supposed to be encoded in Psychtoolbox special proprietary "16 bpc stuffed into 8 bpc" format?
     if (specialFlags1 & 512) {
         // Yes. Invert the hacks applied during encoding/writing of movie:
@@ -2606,6 +3445,12 @@ void PsychGSDeleteMovie(int moviehandle)
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
     }
 
+    // Stop decoder thread and release upload buffers for decode-ahead, if any:
+    PsychMovieStopDecodeAhead(&movieRecordBANK[moviehandle]);
+
+    // Release frame index and cached frames:
+    PsychMovieReleaseFrameIndex(&movieRecordBANK[moviehandle]);
+
     // Stop movie playback immediately:
     PsychMoviePipelineSetState(movieRecordBANK[moviehandle].theMovie, GST_STATE_NULL, 20.0);
 
@@ -2618,6 +3463,7 @@ void PsychGSDeleteMovie(int moviehandle)
 
     PsychDestroyMutex(&movieRecordBANK[moviehandle].mutex);
     PsychDestroyCondition(&movieRecordBANK[moviehandle].condition);
+    PsychDestroyCondition(&movieRecordBANK[moviehandle].decoderCondition);
 
     free(movieRecordBANK[moviehandle].imageBuffer);
     movieRecordBANK[moviehandle].imageBuffer = NULL;
@@ -2704,6 +3550,11 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     double          preT, postT;
     unsigned char*  releaseMemPtr = NULL;
     unsigned int    strideBytes = 0;
+    PsychMovieRecordType* movie;
+    PsychMovieDecodeSlot* decodeSlot = NULL;
+    PsychMovieCachedFrame* cachedFrame = NULL;
+    int             nextFrame;
+    psych_bool      decodeAhead;
 #if PSYCH_SYSTEM == PSYCH_WINDOWS
     #pragma warning( disable : 4068 )
 #endif
@@ -2755,9 +3606,18 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     // as those certainly don't have movie frames associated.
     if (movieRecordBANK[moviehandle].nrVideoTracks == 0) return((checkForImage) ? -1 : FALSE);
 
+    // Decode-ahead requested? Set it up on first use, now that we know the OpenGL context for texture upload,
+    // and remap any upload buffers which the previous fetch took:
+    movie = &movieRecordBANK[moviehandle];
+    if (movie->decodeAheadDepth && !movie->decodeAheadActive) PsychMovieStartDecodeAhead(win, movie);
+    if (movie->decodeAheadActive) PsychMovieMapDecodeSlots(win, movie);
+
     // Get current playback rate:
     rate = movieRecordBANK[moviehandle].rate;
 
+    // Fetch frames from the decodeRing instead of the videosink during active playback with decode-ahead:
+    decodeAhead = (0 != rate) && movie->decodeAheadActive;
+
     // Is movie actively playing (automatic async playback, possibly with synced sound)?
     // If so, then we ignore the 'timeindex' parameter, because the automatic playback
     // process determines which frames should be delivered to PTB when. This function will
@@ -2778,16 +3638,28 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
             }
             // Check for frame availability happens down there in the shared check code...
         }
+
+        // Seek deferred by a previous fetch from the frame cache? Perform it now, unless another
+        // seek target is served from the frame cache. A target from the frame cache is always available:
+        if (movie->seekPending && !movie->cachedFetch) PsychGSSetMovieTimeIndex(moviehandle, movie->seekPendingTime, FALSE);
+        if (movie->cachedFetch && checkForImage) return(TRUE);
     }
 
     // Should we just check for new image? If so, just return availability status:
     if (checkForImage) {
-        // Take reference timestamps of fetch start:
-        if (tStart == 0) PsychGetAdjustedPrecisionTimerSeconds(&tStart);
         PsychLockMutex(&movieRecordBANK[moviehandle].mutex);
 
-        if ((((0 != rate) && movieRecordBANK[moviehandle].frameAvail) || ((0 == rate) && movieRecordBANK[moviehandle].preRollAvail)) &&
-            !gst_app_sink_is_eos(GST_APP_SINK(movieRecordBANK[moviehandle].videosink))) {
+        // Take reference timestamps of fetch start. If decode-ahead has no frame ready at the start of a fetch,
+        // count this as an underrun of the decodeRing:
+        if (tStart == 0) {
+            PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+            if (decodeAhead && (movie->decodeQueued == 0)) movie->decodeUnderruns++;
+        }
+
+        // The videosink reports eos already when its last frame got pulled into the decodeRing, so
+        // only check for eos if there is no decode-ahead:
+        if (PsychMovieFramesAvailable(movie, rate) &&
+            (decodeAhead || !gst_app_sink_is_eos(GST_APP_SINK(movieRecordBANK[moviehandle].videosink)))) {
             // New frame available. Unlock and report success:
             //printf("PTB-DEBUG: NEW FRAME %d\n", movieRecordBANK[moviehandle].frameAvail);
             PsychUnlockMutex(&movieRecordBANK[moviehandle].mutex);
@@ -2795,7 +3667,8 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         }
 
         // None available. Any chance there will be one in the future?
-        if (((rate != 0) && gst_app_sink_is_eos(GST_APP_SINK(movieRecordBANK[moviehandle].videosink)) && (movieRecordBANK[moviehandle].loopflag == 0)) ||
+        if (((rate != 0) && gst_app_sink_is_eos(GST_APP_SINK(movieRecordBANK[moviehandle].videosink)) && (movieRecordBANK[moviehandle].loopflag == 0) &&
+             !(decodeAhead && movie->decodePulling)) ||
             ((rate == 0) && (movieRecordBANK[moviehandle].endOfFetch))) {
             // No new frame available and there won't be any in the future, because this is a non-looping
             // movie that has reached its end.
@@ -2820,8 +3693,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     PsychLockMutex(&movieRecordBANK[moviehandle].mutex);
     // printf("PTB-DEBUG: Blocking fetch start %d\n", movieRecordBANK[moviehandle].frameAvail);
 
-    if (((0 != rate) && !movieRecordBANK[moviehandle].frameAvail) ||
-        ((0 == rate) && !movieRecordBANK[moviehandle].preRollAvail)) {
+    if (!PsychMovieFramesAvailable(movie, rate)) {
         // No new frame available. Perform a blocking wait with timeout of 0.5 seconds:
         PsychTimedWaitCondition(&movieRecordBANK[moviehandle].condition, &movieRecordBANK[moviehandle].mutex, 0.5);
 
@@ -2829,8 +3701,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         PsychGSProcessMovieContext(&(movieRecordBANK[moviehandle]), FALSE);
 
         // Recheck:
-        if (((0 != rate) && !movieRecordBANK[moviehandle].frameAvail) ||
-            ((0 == rate) && !movieRecordBANK[moviehandle].preRollAvail)) {
+        if (!PsychMovieFramesAvailable(movie, rate)) {
             // Wait timed out after 0.5 secs.
             PsychUnlockMutex(&movieRecordBANK[moviehandle].mutex);
             if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: No frame received after timed blocking wait of 0.5 seconds.\n");
@@ -2856,12 +3727,65 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     // If we reach this point, then at least 1 frame should be available and we are
     // asked to fetch it now and return it as a new OpenGL texture. The mutex is locked:
 
-    // Preroll case is simple:
-    movieRecordBANK[moviehandle].preRollAvail = 0;
+    // Preroll case is simple, but a frame from the frame cache doesn't consume the prerolled frame:
+    if (!movie->cachedFetch) movieRecordBANK[moviehandle].preRollAvail = 0;
 
     // Perform texture fetch & creation:
-    // Active playback mode?
-    if (0 != rate) {
+    // Active playback mode with decode-ahead?
+    if (decodeAhead) {
+        // Take the oldest queued frame from the decodeRing. Skip queued frames older than a requested target
+        // timeindex, as long as newer ones are queued. If the videosink drops frames to keep audio-video sync,
+        // also skip to the newest frame, as the videosink would have dropped the older ones:
+        movie->decodeFetches++;
+        movie->decodeQueuedSum += movie->decodeQueued;
+        decodeSlot = &(movie->decodeRing[movie->decodeReadIdx]);
+        while ((movie->decodeQueued > 1) && (gst_app_sink_get_drop(GST_APP_SINK(movie->videosink)) ||
+               ((rate > 0) && (timeindex >= 0) && (decodeSlot->pts < timeindex)))) {
+            if (PsychPrefStateGet_Verbosity() > 5)
+                printf("PTB-DEBUG: Skipped queued buffer id %i with pts %f secs.\n", (int) decodeSlot->bufferIndex, decodeSlot->pts);
+
+            if (decodeSlot->sample) gst_sample_unref(decodeSlot->sample);
+            decodeSlot->sample = NULL;
+            movie->decodeSkipped++;
+            movie->decodeReadIdx = (movie->decodeReadIdx + 1) % movie->decodeAheadDepth;
+            movie->decodeQueued--;
+            decodeSlot = &(movie->decodeRing[movie->decodeReadIdx]);
+        }
+
+        movie->decodeReadIdx = (movie->decodeReadIdx + 1) % movie->decodeAheadDepth;
+        movie->decodeQueued--;
+
+        // Take ownership of the slot and its pbo. The decoder thread won't touch it until it gets remapped:
+        videoSample = decodeSlot->sample;
+        decodeSlot->sample = NULL;
+        decodeSlot->mem = NULL;
+        PsychUnlockMutex(&movieRecordBANK[moviehandle].mutex);
+
+        PsychSetGLContext(win);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, decodeSlot->pbo);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (videoSample) {
+            // Frame didn't fit into the pbo. Upload it from the sample, like without decode-ahead:
+            movie->decodeFallbacks++;
+        }
+        else {
+            movie->pts = decodeSlot->pts;
+            deltaT = decodeSlot->duration;
+            bufferIndex = decodeSlot->bufferIndex;
+            strideBytes = decodeSlot->strideBytes;
+
+            if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: pts %f secs, dT %f secs, bufferId %i, from decode-ahead.\n", movie->pts, deltaT, (int) bufferIndex);
+
+            // Texture content gets sourced from the pbo:
+            if (out_texture) {
+                out_texture->textureMemory = NULL;
+                out_texture->textureUploadBuffer = decodeSlot->pbo;
+            }
+        }
+    }
+    else if (0 != rate) {
         // Active playback mode:
         if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: Pulling buffer from videosink, %d buffers decoded and queued.\n", movieRecordBANK[moviehandle].frameAvail);
 
@@ -2881,6 +3805,12 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         // but that won't happen as we wouldn't reach this statement if none were available. It would return
         // NULL if the stream would be EOS or the pipeline off, but that shouldn't ever happen:
         videoSample = gst_app_sink_pull_sample(GST_APP_SINK(movieRecordBANK[moviehandle].videosink));
+    } else if (movie->cachedFetch) {
+        // Passive fetch mode with the seek target served from the frame cache:
+        PsychUnlockMutex(&movieRecordBANK[moviehandle].mutex);
+        cachedFrame = movie->cachedFetch;
+        movie->cachedFetch = NULL;
+        videoSample = gst_sample_ref(cachedFrame->sample);
     } else {
         // Passive fetch mode: Use prerolled buffers after seek:
         // These are available even after eos...
@@ -2888,6 +3818,10 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         // We can unlock early, thanks to videosink's internal buffering: XXX FIXME: Perfectly race-free to do this before the pull?
         PsychUnlockMutex(&movieRecordBANK[moviehandle].mutex);
         videoSample = gst_app_sink_pull_preroll(GST_APP_SINK(movieRecordBANK[moviehandle].videosink));
+
+        // First frame after a seek? Keep a copy in the frame cache for repeated access to the same target:
+        if (videoSample && movie->cacheInsertPending && movie->frameCacheSize) PsychMovieFrameCacheInsert(movie, videoSample);
+        movie->cacheInsertPending = FALSE;
     }
 
     // Sample received?
@@ -2901,7 +3835,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         // Iff forward playback is active and a target timeindex was specified and this buffer is not at least of
         // that timeindex and at least one more buffer is queued, then skip this buffer, pull the next one and check
         // if that one meets the required pts:
-        while ((rate > 0) && (timeindex >= 0) && (movieRecordBANK[moviehandle].pts < timeindex) && (movieRecordBANK[moviehandle].frameAvail > 0)) {
+        while (!decodeAhead && (rate > 0) && (timeindex >= 0) && (movieRecordBANK[moviehandle].pts < timeindex) && (movieRecordBANK[moviehandle].frameAvail > 0)) {
             // Tell user about reason for rejecting this buffer:
             if (PsychPrefStateGet_Verbosity() > 5) {
                 printf("PTB-DEBUG: Fast-Skipped buffer id %i with pts %f secs < targetpts %f secs.\n", (int) GST_BUFFER_OFFSET(videoBuffer), movieRecordBANK[moviehandle].pts, timeindex);
@@ -2951,7 +3885,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
             }
             out_texture->textureMemory = (GLuint*) mapinfo.data;
         }
-    } else {
+    } else if (!decodeSlot) {
         printf("PTB-ERROR: No new video frame received in gst_app_sink_pull_sample! Something's wrong. Aborting fetch.\n");
         return(FALSE);
     }
@@ -2980,8 +3914,12 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
             // Yes. Parse and assign it from this individual frame:
             int width, height;
 
-            GstCaps *caps = gst_sample_get_caps(videoSample);
-            if (caps) {
+            GstCaps *caps = (videoSample) ? gst_sample_get_caps(videoSample) : NULL;
+            if (decodeSlot && !videoSample && decodeSlot->width && decodeSlot->height) {
+                movieRecordBANK[moviehandle].width = decodeSlot->width;
+                movieRecordBANK[moviehandle].height = decodeSlot->height;
+            }
+            else if (caps) {
                 GstStructure *str = gst_caps_get_structure(caps, 0);
                 gst_structure_get_int(str,"width", &width);
                 gst_structure_get_int(str,"height", &height);
@@ -2993,15 +3931,18 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
             }
         }
 
-        // Get video metadata for this frame and parse it, if any:
-        videoMetaData = (GstVideoMeta *) gst_buffer_get_meta(videoBuffer, GST_VIDEO_META_API_TYPE);
-        if (videoMetaData) {
-            if (PsychPrefStateGet_Verbosity() > 6)
-                printf("PTB-DEBUG: Frame reported n_planes %i stride %i\n", videoMetaData->n_planes, videoMetaData->stride[0]);
-        }
+        // Get video metadata for this frame and parse it, if any. For frames from the decodeRing, the
+        // decoder thread already did this:
+        if (videoSample) {
+            videoMetaData = (GstVideoMeta *) gst_buffer_get_meta(videoBuffer, GST_VIDEO_META_API_TYPE);
+            if (videoMetaData) {
+                if (PsychPrefStateGet_Verbosity() > 6)
+                    printf("PTB-DEBUG: Frame reported n_planes %i stride %i\n", videoMetaData->n_planes, videoMetaData->stride[0]);
+            }
 
-        // Assign pixel row stride of 1st plane if valid, zero for "invalid" otherwise:
-        strideBytes = (videoMetaData && videoMetaData->stride[0]) ? videoMetaData->stride[0] : 0;
+            // Assign pixel row stride of 1st plane if valid, zero for "invalid" otherwise:
+            strideBytes = (videoMetaData && videoMetaData->stride[0]) ? videoMetaData->stride[0] : 0;
+        }
 
         // Build a standard PTB texture record:
         PsychMakeRect(out_texture->rect, 0, 0, movieRecordBANK[moviehandle].width, movieRecordBANK[moviehandle].height);
@@ -3468,12 +4409,39 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     }
 
     // Unlock.
-    gst_buffer_unmap(videoBuffer, &mapinfo);
-    gst_sample_unref(videoSample);
-    videoBuffer = NULL;
+    if (videoSample) {
+        gst_buffer_unmap(videoBuffer, &mapinfo);
+        gst_sample_unref(videoSample);
+        videoBuffer = NULL;
+    }
+
+    // Remap the pbo of the decodeRing slot of this frame, so the decoder thread can reuse it. This orphans
+    // the storage of the just started upload, so it doesn't stall:
+    if (decodeSlot) PsychMovieMapDecodeSlots(win, movie);
 
     // Manually advance movie time, if in fetch mode:
-    if (0 == rate) {
+    if ((0 == rate) && cachedFrame) {
+        // Frame came from the frame cache, so the videosink didn't move. Defer the seek to the next frame until
+        // a frame is actually needed from the videosink, as the next fetch may be served from the frame cache as well:
+        movieRecordBANK[moviehandle].endOfFetch = 0;
+        movie->seekPending = TRUE;
+        if (movie->frameIndex) {
+            nextFrame = PsychMovieFrameIndexLookup(movie, cachedFrame->pts) + 1;
+            if (nextFrame < movie->frameIndexCount)
+                movie->seekPendingTime = movie->frameIndex[nextFrame].pts;
+            else
+                movie->seekPending = FALSE;
+        }
+        else {
+            movie->seekPendingTime = cachedFrame->pts + cachedFrame->duration;
+            if ((cachedFrame->duration <= 0) || (movie->seekPendingTime > movie->movieduration - 0.5 * cachedFrame->duration))
+                movie->seekPending = FALSE;
+        }
+
+        // Cached frame was the last frame of the movie:
+        if (!movie->seekPending) movieRecordBANK[moviehandle].endOfFetch = 1;
+    }
+    else if (0 == rate) {
         // We are in manual fetch mode: Need to manually advance movie to next
         // media sample:
         movieRecordBANK[moviehandle].endOfFetch = 0;
@@ -3494,6 +4462,13 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
 
         // Signal end-of-fetch if time no longer progresses signficiantly:
         if (postT - preT < 0.001) movieRecordBANK[moviehandle].endOfFetch = 1;
+
+        // Track the now prerolled frame in the frame index, for seeks by stepping forward:
+        if (movie->frameIndex && (movie->frameIndexPos >= 0)) {
+            nextFrame = PsychMovieFrameIndexLookup(movie, movieRecordBANK[moviehandle].pts);
+            movie->frameIndexPos = (!movieRecordBANK[moviehandle].endOfFetch && (nextFrame >= 0) &&
+                                    (fabs(movie->frameIndex[nextFrame].pts - movieRecordBANK[moviehandle].pts) <= PSYCH_FRAMEINDEX_TOLERANCE)) ? nextFrame + 1 : -1;
+        }
     }
 
     PsychGetAdjustedPrecisionTimerSeconds(&tNow);
@@ -3587,6 +4562,16 @@ int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double s
         // is needed to avoid jumps in movies with bad encoding or keyframe placement:
         timeindex = PsychGSGetMovieTimeIndex(moviehandle);
 
+        // This seek also performs any seek deferred by the frame cache. Playback moves the pipeline, so the position of
+        // the prerolled frame in the frame index is unknown afterwards:
+        movieRecordBANK[moviehandle].cachedFetch = NULL;
+        movieRecordBANK[moviehandle].seekPending = FALSE;
+        movieRecordBANK[moviehandle].cacheInsertPending = FALSE;
+        movieRecordBANK[moviehandle].frameIndexPos = -1;
+
+        // Hold decode-ahead during the seek:
+        PsychMovieHoldDecodeAhead(&movieRecordBANK[moviehandle], TRUE);
+
         // Which loop setting?
         if (loop <= 0) {
             // Looped playback disabled. Set to well defined off value zero:
@@ -3629,6 +4614,16 @@ int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double s
         movieRecordBANK[moviehandle].frameAvail = 0;
         movieRecordBANK[moviehandle].preRollAvail = 0;
 
+        // Reset decode-ahead statistics and resume decode-ahead:
+        movieRecordBANK[moviehandle].decodeFetches = 0;
+        movieRecordBANK[moviehandle].decodeQueuedSum = 0;
+        movieRecordBANK[moviehandle].decodeMaxQueued = 0;
+        movieRecordBANK[moviehandle].decodeUnderruns = 0;
+        movieRecordBANK[moviehandle].decodeSkipped = 0;
+        movieRecordBANK[moviehandle].decodeFallbacks = 0;
+        movieRecordBANK[moviehandle].decodeSinkDrops = 0;
+        PsychMovieHoldDecodeAhead(&movieRecordBANK[moviehandle], FALSE);
+
         // Is this a movie with actual videotracks and frame-dropping on videosink full enabled?
         if ((movieRecordBANK[moviehandle].nrVideoTracks > 0) && gst_app_sink_get_drop(GST_APP_SINK(movieRecordBANK[moviehandle].videosink))) {
             // Yes: We only schedule deferred start of playback at first Screen('GetMovieImage')
@@ -3650,6 +4645,9 @@ int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double s
         movieRecordBANK[moviehandle].loopflag = 0;
         movieRecordBANK[moviehandle].endOfFetch = 0;
 
+        // Discard all frames queued for decode-ahead. Decoder thread stays idle until restart of playback:
+        PsychMovieHoldDecodeAhead(&movieRecordBANK[moviehandle], TRUE);
+
         // Print name of audio sink - the output device which was actually playing the sound, if requested:
         // This is a Linux only feature, as GStreamer for MS-Windows doesn't support such queries at all,
         // and GStreamer for OSX doesn't expose the information in a way that would be in any way meaningful for us.
@@ -3745,6 +4743,10 @@ double PsychGSGetMovieTimeIndex(int moviehandle)
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
     }
 
+    // Seek target served from the frame cache, or seek deferred after that? Then the pipeline is not there yet:
+    if (movieRecordBANK[moviehandle].cachedFetch) return(movieRecordBANK[moviehandle].cachedFetch->pts);
+    if (movieRecordBANK[moviehandle].seekPending) return(movieRecordBANK[moviehandle].seekPendingTime);
+
     if (!gst_element_query_position(theMovie, GST_FORMAT_TIME, &pos_nsecs)) {
         if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Could not query position in movie %i in seconds. Returning zero.\n", moviehandle);
         pos_nsecs = 0;
@@ -3763,6 +4765,9 @@ double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool in
     double          oldtime;
     gint64          targetIndex;
     GstSeekFlags    flags;
+    GstEvent        *event;
+    PsychMovieRecordType* movie;
+    int             targetFrame = -1;
 
     if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIES) {
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided!");
@@ -3777,9 +4782,79 @@ double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool in
     // Retrieve current timeindex:
     oldtime = PsychGSGetMovieTimeIndex(moviehandle);
 
+    // This seek replaces any seek target from the frame cache or deferred seek:
+    movie = &movieRecordBANK[moviehandle];
+    movie->cachedFetch = NULL;
+    movie->seekPending = FALSE;
+    movie->seekCount++;
+
+    // Frame index available? Then map the target to the exact presentation timestamp of the target frame, so frame
+    // based seeking doesn't depend on support by the demuxer, and repeated seeks to the same frame match exactly:
+    if (movie->frameIndex) {
+        targetFrame = (indexIsFrames) ? (int) (timeindex + 0.5) : PsychMovieFrameIndexLookup(movie, timeindex);
+        if ((targetFrame >= 0) && (targetFrame < movie->frameIndexCount)) {
+            timeindex = movie->frameIndex[targetFrame].pts;
+            indexIsFrames = FALSE;
+        }
+        else {
+            targetFrame = -1;
+        }
+    }
+
+    // In manual fetch mode, the next fetched frame is a seek target, which goes into the frame cache:
+    movie->cacheInsertPending = (movie->rate == 0) ? TRUE : FALSE;
+
+    // Manual fetch mode also allows to avoid the seek in some cases:
+    if ((movie->rate == 0) && !indexIsFrames) {
+        // Target frame already prerolled, e.g., after fetching its predecessor? Then the seek would be a no-op:
+        if ((targetFrame >= 0) && (targetFrame == movie->frameIndexPos) && (movie->preRollAvail > 0) && !movie->endOfFetch) {
+            movie->seekSkips++;
+            return(oldtime);
+        }
+
+        // Target frame in the frame cache? Then the next fetch returns it from there, and the seek gets deferred until a
+        // frame is needed from the videosink. Often that never happens, if successive seeks hit the frame cache as well:
+        if (movie->frameCacheSize) {
+            if ((movie->cachedFetch = PsychMovieFrameCacheLookup(movie, timeindex))) {
+                movie->cacheHits++;
+                movie->endOfFetch = 0;
+                return(oldtime);
+            }
+
+            movie->cacheMisses++;
+        }
+
+        // Target frame ahead of the prerolled frame, with no keyframe in between? Then stepping forward decodes fewer frames
+        // than a seek, which restarts decoding at the keyframe preceding the target:
+        if ((targetFrame > movie->frameIndexPos) && (movie->frameIndexPos >= 0) && !movie->endOfFetch &&
+            (PsychMovieFrameIndexKeyframe(movie, targetFrame) <= movie->frameIndexPos)) {
+            PsychLockMutex(&movie->mutex);
+            movie->preRollAvail = 0;
+            PsychUnlockMutex(&movie->mutex);
+
+            // Step only the videosink, as in PsychGSGetTextureFromMovie(), and block until step completed:
+            event = gst_event_new_step(GST_FORMAT_BUFFERS, (guint64) (targetFrame - movie->frameIndexPos), 1.0, TRUE, FALSE);
+            if (gst_element_send_event(movie->videosink, event) &&
+                (GST_STATE_CHANGE_SUCCESS == gst_element_get_state(theMovie, NULL, NULL, (GstClockTime) (10 * 1e9)))) {
+                if (PsychPrefStateGet_Verbosity() > 5)
+                    printf("PTB-DEBUG: Stepped forward by %i frames from frame %i in movie %i.\n", targetFrame - movie->frameIndexPos, movie->frameIndexPos, moviehandle);
+
+                movie->frameIndexPos = targetFrame;
+                movie->seekSteps++;
+                return(oldtime);
+            }
+
+            // Stepping failed. Do a regular seek:
+            if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: Stepping forward in movie %i failed. Seeking instead.\n", moviehandle);
+        }
+    }
+
     // NOTE: We could use GST_SEEK_FLAG_SKIP to allow framedropping on fast forward/reverse playback...
     flags = GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE;
 
+    // Hold decode-ahead during the seek, discarding all frames queued from before the seek:
+    PsychMovieHoldDecodeAhead(&movieRecordBANK[moviehandle], TRUE);
+
     // Need segment seek flag for seek during active looped playback if also flag 0x4 is set:
     if ((movieRecordBANK[moviehandle].rate != 0) && (movieRecordBANK[moviehandle].loopflag & 0x1) && (movieRecordBANK[moviehandle].loopflag & 0x4)) {
         flags |= GST_SEEK_FLAG_SEGMENT;
@@ -3830,9 +4905,15 @@ double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool in
 
     if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-INFO: Seeked to position %f secs in movie %i.\n", PsychGSGetMovieTimeIndex(moviehandle), moviehandle);
 
+    // Resume decode-ahead:
+    PsychMovieHoldDecodeAhead(&movieRecordBANK[moviehandle], FALSE);
+
     // Reset fetch flag:
     movieRecordBANK[moviehandle].endOfFetch = 0;
 
+    // Accurate seek to the presentation timestamp of a frame from the frame index prerolls exactly that frame:
+    movie->frameIndexPos = (movie->rate == 0) ? targetFrame : -1;
+
     // Return old time value of previous position:
     return(oldtime);
 }
@@ -3900,6 +4981,100 @@ void PsychGSCopyOutMovieHDRMetaData(int moviehandle, int argPosition)
     }
 }
 
+/*
+ *  PsychGSCopyOutMovieDecodeStats() -- Return a struct with decode-ahead and frame drop statistics of this movie to scripting environment.
+ */
+void PsychGSCopyOutMovieDecodeStats(int moviehandle, int argPosition)
+{
+    PsychGenericScriptType *s;
+    PsychMovieRecordType *movie;
+    const char *fieldNames[] = { "DecodeAhead", "Queued", "MaxQueued", "MeanQueued", "Fetches", "Underruns", "Skipped", "Fallbacks",
+                                 "SinkDrops", "DroppedFrames" };
+    const int fieldCount = 10;
+
+    if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIES) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided!");
+    }
+
+    if (movieRecordBANK[moviehandle].theMovie == NULL) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
+    }
+
+    // Userscript wants this info?
+    if (PsychIsArgPresent(PsychArgOut, argPosition)) {
+        movie = &movieRecordBANK[moviehandle];
+        PsychAllocOutStructArray(argPosition, kPsychArgOptional, -1, fieldCount, fieldNames, &s);
+
+        PsychLockMutex(&movie->mutex);
+
+        // Size of decodeRing, zero if decode-ahead is disabled or unsupported, and current and maximum number of queued frames:
+        PsychSetStructArrayDoubleElement("DecodeAhead", 0, (double) movie->decodeAheadDepth, s);
+        PsychSetStructArrayDoubleElement("Queued", 0, (double) movie->decodeQueued, s);
+        PsychSetStructArrayDoubleElement("MaxQueued", 0, (double) movie->decodeMaxQueued, s);
+
+        // Mean number of queued frames at time of frame fetch, ie. effective decode-ahead depth:
+        PsychSetStructArrayDoubleElement("MeanQueued", 0, (movie->decodeFetches > 0) ? movie->decodeQueuedSum / (double) movie->decodeFetches : 0, s);
+
+        // Frame fetches from decodeRing, fetches which found it empty, and frames skipped in it:
+        PsychSetStructArrayDoubleElement("Fetches", 0, (double) movie->decodeFetches, s);
+        PsychSetStructArrayDoubleElement("Underruns", 0, (double) movie->decodeUnderruns, s);
+        PsychSetStructArrayDoubleElement("Skipped", 0, (double) movie->decodeSkipped, s);
+        PsychSetStructArrayDoubleElement("Fallbacks", 0, (double) movie->decodeFallbacks, s);
+
+        // Frames dropped by the videosink, and dropped frames as detected from gaps in presentation timestamps:
+        PsychSetStructArrayDoubleElement("SinkDrops", 0, (double) movie->decodeSinkDrops, s);
+        PsychSetStructArrayDoubleElement("DroppedFrames", 0, (double) movie->nr_droppedframes, s);
+
+        PsychUnlockMutex(&movie->mutex);
+    }
+}
+
+/*
+ *  PsychGSCopyOutMovieSeekStats() -- Return a struct with frame index, frame cache and seek statistics of this movie to scripting environment.
+ */
+void PsychGSCopyOutMovieSeekStats(int moviehandle, int argPosition)
+{
+    PsychGenericScriptType *s;
+    PsychMovieRecordType *movie;
+    const char *fieldNames[] = { "IndexedFrames", "Keyframes", "FrameCache", "CachedFrames", "Seeks", "SkippedSeeks", "SteppedSeeks",
+                                 "CacheHits", "CacheMisses" };
+    const int fieldCount = 9;
+    int i, cachedFrames = 0;
+
+    if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIES) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided!");
+    }
+
+    if (movieRecordBANK[moviehandle].theMovie == NULL) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
+    }
+
+    // Userscript wants this info?
+    if (PsychIsArgPresent(PsychArgOut, argPosition)) {
+        movie = &movieRecordBANK[moviehandle];
+        PsychAllocOutStructArray(argPosition, kPsychArgOptional, -1, fieldCount, fieldNames, &s);
+
+        // Size of frame index, zero if disabled or unsupported, and its number of keyframes:
+        PsychSetStructArrayDoubleElement("IndexedFrames", 0, (double) movie->frameIndexCount, s);
+        PsychSetStructArrayDoubleElement("Keyframes", 0, (double) movie->frameIndexKeyframes, s);
+
+        // Capacity and current occupancy of frame cache:
+        for (i = 0; i < movie->frameCacheSize; i++) {
+            if (movie->frameCache[i].sample) cachedFrames++;
+        }
+
+        PsychSetStructArrayDoubleElement("FrameCache", 0, (double) movie->frameCacheSize, s);
+        PsychSetStructArrayDoubleElement("CachedFrames", 0, (double) cachedFrames, s);
+
+        // Seeks, and how they were done:
+        PsychSetStructArrayDoubleElement("Seeks", 0, (double) movie->seekCount, s);
+        PsychSetStructArrayDoubleElement("SkippedSeeks", 0, (double) movie->seekSkips, s);
+        PsychSetStructArrayDoubleElement("SteppedSeeks", 0, (double) movie->seekSteps, s);
+        PsychSetStructArrayDoubleElement("CacheHits", 0, (double) movie->cacheHits, s);
+        PsychSetStructArrayDoubleElement("CacheMisses", 0, (double) movie->cacheMisses, s);
+    }
+}
+
 // #if GST_CHECK_VERSION(1,0,0)
 #endif
 // #ifdef PTB_USE_GSTREAMER
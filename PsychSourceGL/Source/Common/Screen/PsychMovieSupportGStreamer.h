@@ -37,6 +37,8 @@ void PsychGSExitMovies(void);
 double PsychGSGetMovieTimeIndex(int moviehandle);
 double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames);
 void PsychGSCopyOutMovieHDRMetaData(int moviehandle, int argPosition);
+void PsychGSCopyOutMovieDecodeStats(int moviehandle, int argPosition);
+void PsychGSCopyOutMovieSeekStats(int moviehandle, int argPosition);
 //end include once
 #endif
 
@@ -127,6 +127,14 @@ void PsychInitWindowRecordTextureFields(PsychWindowRecordType *win)
     // setting will be used for the GL_UNPACK_ALIGNMENT setting in PsychCreateTexture() and friends
     // to optimize texture upload:
     win->textureByteAligned=0;
+
+    // Not eligible for, and not resident in, a texture atlas for Screen('DrawTextures') by default:
+    win->atlasEligible=FALSE;
+    win->atlasPage=0;
+
+    // Texture content gets sourced from textureMemory, no asynchronous upload pending:
+    win->textureUploadBuffer=0;
+    win->textureUploadFence=NULL;
 }
 
 void PsychCreateTexture(PsychWindowRecordType *win)
@@ -218,6 +226,10 @@ void PsychCreateTexture(PsychWindowRecordType *win)
     // Desktop-GL only:
     if (!PsychIsGLES(win)) glPixelStorei(GL_UNPACK_ROW_LENGTH, (win->textureStridePixels > 0) ? win->textureStridePixels : (int) sourceWidth);
 
+    // Asynchronous upload for 'MakeTexture'? Then the gpu sources the texture content from offset zero of
+    // a pixel unpack buffer, as textureMemory == NULL, and the glTexImage2D() call below returns immediately:
+    if (win->textureUploadBuffer) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, win->textureUploadBuffer);
+
     // We used to have different cases for Luminance, Luminance+Alpha, RGB, RGBA.
     // This way we saved texture memory for the source->textureMemory -- Arrays, as well as copy-time
     // in MakeTexture - In theory...
@@ -352,6 +364,8 @@ void PsychCreateTexture(PsychWindowRecordType *win)
                 // Our error checking for ES is very limited:
                 if ((!avoidCPUGPUSync || (verbosity > 10)) && ((glerr = glGetError()) !=0 )) {
                     glBindTexture(texturetarget, 0);
+                    if (win->textureUploadBuffer) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                    win->textureUploadBuffer = 0;
                     win->textureNumber = 0;
                     if (win->textureMemory && (win->textureMemorySizeBytes > 0)) free(win->textureMemory);
                     win->textureMemory=NULL;
@@ -397,6 +411,8 @@ void PsychCreateTexture(PsychWindowRecordType *win)
                     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
                     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
                     glDeleteTextures(1, &win->textureNumber);
+                    if (win->textureUploadBuffer) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                    win->textureUploadBuffer = 0;
                     win->textureNumber = 0;
                     if (win->textureMemory && (win->textureMemorySizeBytes > 0)) free(win->textureMemory);
                     win->textureMemory=NULL;
@@ -563,6 +579,15 @@ void PsychCreateTexture(PsychWindowRecordType *win)
     if (!PsychIsGLES(win)) glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+    // Asynchronous upload: Fence its completion for PsychWaitForTextureUpload(), and flush to kick off the
+    // transfer. The pixel unpack buffer can be reused right away, as 'MakeTexture' orphans its storage:
+    if (win->textureUploadBuffer) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        win->textureUploadBuffer = 0;
+        win->textureUploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+    }
+
     // Client rect of a texture is always == rect of it:
     PsychCopyRect(win->clientrect, win->rect);
 
@@ -570,6 +595,39 @@ void PsychCreateTexture(PsychWindowRecordType *win)
     return;
 }
 
+/*
+ *    PsychWaitForTextureUpload()
+ *
+ *    Wait up to 'timeoutSecs' seconds for completion of a pending asynchronous upload of
+ *    texture content by Screen('MakeTexture'). A timeout of zero only polls, a timeout
+ *    of infinity waits until completion. Returns TRUE if the texture content is ready,
+ *    ie. if the upload completed or if no upload was pending, FALSE on timeout.
+ *
+ *    Drawing from the texture never needs this, as the gpu executes the upload before any
+ *    later submitted drawing commands anyway.
+ */
+psych_bool PsychWaitForTextureUpload(PsychWindowRecordType *win, double timeoutSecs)
+{
+    GLenum rc;
+    GLuint64 timeout;
+
+    if (NULL == win->textureUploadFence) return(TRUE);
+
+    PsychSetGLContext(win);
+    timeout = (timeoutSecs >= 1e9) ? 0xFFFFFFFFFFFFFFFFULL : (GLuint64) (((timeoutSecs > 0) ? timeoutSecs : 0) * 1e9);
+    rc = glClientWaitSync(win->textureUploadFence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    if (rc == GL_TIMEOUT_EXPIRED) return(FALSE);
+
+    // Upload completed - or waiting failed, which is no reason to consider the texture not ready forever:
+    if ((rc == GL_WAIT_FAILED) && (PsychPrefStateGet_Verbosity() > 1))
+        printf("PTB-WARNING: Waiting for completion of asynchronous upload to texture %i failed. Assuming it completed.\n", win->windowIndex);
+
+    glDeleteSync(win->textureUploadFence);
+    win->textureUploadFence = NULL;
+
+    return(TRUE);
+}
+
 /*
  *    PsychFreeTextureForWindowRecord()
  *
@@ -599,6 +657,13 @@ void PsychFreeTextureForWindowRecord(PsychWindowRecordType *win)
         // work for some strange reason :(
         if ((win->textureMemory) && (win->textureNumber > 0)) glFinish(); // FinishObjectAPPLE(GL_TEXTURE_2D, win->textureNumber);
 
+        // Release the textures space in the texture atlas of its parent window, if any:
+        PsychReleaseAtlasTexture(win);
+
+        // Delete fence of a still pending asynchronous upload, if any:
+        if (win->textureUploadFence) glDeleteSync(win->textureUploadFence);
+        win->textureUploadFence = NULL;
+
         // Perform standard OpenGL texture cleanup if needed:
         if (win->textureNumber != 0) {
             glDeleteTextures(1, &win->textureNumber);
@@ -1869,3 +1934,409 @@ void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, Ps
     // Finished!
     return;
 }
+
+// Texture atlas support for Screen('DrawTextures'):
+//
+// Drawing many different small textures with one Screen('DrawTextures') call used to cost one texture
+// bind and one glBegin/glEnd quad per texture. Instead, textures from Screen('MakeTexture') whose content
+// never changes get copied on first use into big atlas textures ("pages"), owned by their onscreen parent
+// window. All items of a call then get drawn from the pages with one draw call per run of items with
+// identical page and filterMode, with all per item rotation, color and alpha encoded in the vertex data.
+//
+// Each page holds textures of one internal format, packed into horizontal shelves. Each texture gets a
+// one texel border of replicated edge texels, so bilinear filtering at its edges behaves like the
+// GL_CLAMP_TO_EDGE mode of the original texture. Space of a page is only reclaimed once all textures in
+// it are closed, which is fine for the typical use case of a fixed set of stimulus textures.
+#define PSYCH_ATLAS_PAGE_SIZE       2048
+#define PSYCH_ATLAS_MAX_TEXSIZE     256
+
+typedef struct PsychAtlasItem {
+    PsychWindowRecordType   *source;
+    double                  sourceRect[4];
+    double                  targetRect[4];
+    double                  rotationAngle;
+    float                   color[4];
+    int                     filterMode;
+} PsychAtlasItem;
+
+/* PsychReleaseAtlasTexture()
+ *
+ * Remove texture 'win' from its texture atlas page, if it is resident in one. A page is
+ * reset to empty once its last resident texture is released.
+ */
+void PsychReleaseAtlasTexture(PsychWindowRecordType *win)
+{
+    PsychTextureAtlasPage *page;
+
+    if (win->atlasPage > 0) {
+        page = &(PsychGetParentWindow(win)->atlasPages[win->atlasPage - 1]);
+        if (--page->refCount <= 0) {
+            page->refCount = 0;
+            page->shelfX = 0;
+            page->shelfY = 0;
+            page->shelfHeight = 0;
+        }
+    }
+
+    win->atlasPage = 0;
+}
+
+/* PsychDeleteTextureAtlas()
+ *
+ * Release all texture atlas pages of onscreen window 'windowRecord'. Its OpenGL context must be bound.
+ */
+void PsychDeleteTextureAtlas(PsychWindowRecordType *windowRecord)
+{
+    int i;
+
+    for (i = 0; i < PSYCH_MAX_ATLAS_PAGES; i++) {
+        if (windowRecord->atlasPages[i].texture) glDeleteTextures(1, &(windowRecord->atlasPages[i].texture));
+    }
+
+    memset(windowRecord->atlasPages, 0, sizeof(windowRecord->atlasPages));
+}
+
+// Copy 'width' x 'height' texels at (srcX, srcY) of rectangle texture 'source' to (dstX, dstY) in atlas page texture 'page':
+static void PsychCopyToAtlas(GLuint source, int srcX, int srcY, GLuint page, int dstX, int dstY, int width, int height)
+{
+    glCopyImageSubData(source, GL_TEXTURE_RECTANGLE_EXT, 0, srcX, srcY, 0, page, GL_TEXTURE_RECTANGLE_EXT, 0, dstX, dstY, 0, width, height, 1);
+}
+
+// Make texture 'source' resident in a texture atlas page of its onscreen window 'parent', if it isn't already.
+// Returns TRUE if it is resident, FALSE if it doesn't fit or the copy failed:
+static psych_bool PsychMakeAtlasResident(PsychWindowRecordType *parent, PsychWindowRecordType *source)
+{
+    PsychTextureAtlasPage *page = NULL;
+    GLint width, height, internalFormat;
+    int i, x, y;
+
+    if (source->atlasPage > 0)
+        return(TRUE);
+
+    // Query true size and format of the texture object:
+    glBindTexture(GL_TEXTURE_RECTANGLE_EXT, source->textureNumber);
+    glGetTexLevelParameteriv(GL_TEXTURE_RECTANGLE_EXT, 0, GL_TEXTURE_WIDTH, &width);
+    glGetTexLevelParameteriv(GL_TEXTURE_RECTANGLE_EXT, 0, GL_TEXTURE_HEIGHT, &height);
+    glGetTexLevelParameteriv(GL_TEXTURE_RECTANGLE_EXT, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+    glBindTexture(GL_TEXTURE_RECTANGLE_EXT, 0);
+
+    if ((width < 1) || (height < 1) || (width > PSYCH_ATLAS_MAX_TEXSIZE) || (height > PSYCH_ATLAS_MAX_TEXSIZE)) {
+        source->atlasEligible = FALSE;
+        return(FALSE);
+    }
+
+    // Find a page of matching format with enough space left, either in its current shelf or in a new one:
+    for (i = 0; i < PSYCH_MAX_ATLAS_PAGES && !page; i++) {
+        page = &(parent->atlasPages[i]);
+        if (!page->texture || (page->internalFormat != internalFormat) ||
+            (((page->shelfX + width + 2 > page->width) || (page->shelfY + height + 2 > page->height)) &&
+             (page->shelfY + page->shelfHeight + height + 2 > page->height)))
+            page = NULL;
+    }
+
+    // Otherwise create a new page, or recycle an empty one:
+
+    for (i = 0; i < PSYCH_MAX_ATLAS_PAGES && !page; i++) {
+        if (!parent->atlasPages[i].texture || (parent->atlasPages[i].refCount == 0)) {
+            page = &(parent->atlasPages[i]);
+            if (page->texture) glDeleteTextures(1, &(page->texture));
+            memset(page, 0, sizeof(PsychTextureAtlasPage));
+
+            page->internalFormat = internalFormat;
+            page->width = page->height = (parent->maxTextureSize > 0 && parent->maxTextureSize < PSYCH_ATLAS_PAGE_SIZE) ? parent->maxTextureSize : PSYCH_ATLAS_PAGE_SIZE;
+
+            while (glGetError());
+            glGenTextures(1, &(page->texture));
+            glBindTexture(GL_TEXTURE_RECTANGLE_EXT, page->texture);
+            glTexStorage2D(GL_TEXTURE_RECTANGLE_EXT, 1, (GLenum) internalFormat, page->width, page->height);
+            glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glBindTexture(GL_TEXTURE_RECTANGLE_EXT, 0);
+
+            if (glGetError() != GL_NO_ERROR) {
+                if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Failed to create texture atlas page of format 0x%x for 'DrawTextures'.\n", (unsigned int) internalFormat);
+                glDeleteTextures(1, &(page->texture));
+                memset(page, 0, sizeof(PsychTextureAtlasPage));
+                source->atlasEligible = FALSE;
+                return(FALSE);
+            }
+
+            if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Created %i x %i texture atlas page %i of format 0x%x for 'DrawTextures'.\n", page->width, page->height, i, (unsigned int) internalFormat);
+        }
+    }
+
+    // All pages in use by other formats or full?
+    if (!page)
+        return(FALSE);
+
+    // Start a new shelf if the texture doesn't fit into the current one:
+    if (page->shelfX + width + 2 > page->width) {
+        page->shelfY += page->shelfHeight;
+        page->shelfX = 0;
+        page->shelfHeight = 0;
+    }
+
+    // Texture content goes inside a one texel border:
+    x = page->shelfX + 1;
+    y = page->shelfY + 1;
+
+    while (glGetError());
+
+    // Content, then replicated edges and corners for the border:
+    PsychCopyToAtlas(source->textureNumber, 0, 0, page->texture, x, y, width, height);
+    PsychCopyToAtlas(source->textureNumber, 0, 0, page->texture, x - 1, y, 1, height);
+    PsychCopyToAtlas(source->textureNumber, width - 1, 0, page->texture, x + width, y, 1, height);
+    PsychCopyToAtlas(source->textureNumber, 0, 0, page->texture, x, y - 1, width, 1);
+    PsychCopyToAtlas(source->textureNumber, 0, height - 1, page->texture, x, y + height, width, 1);
+    PsychCopyToAtlas(source->textureNumber, 0, 0, page->texture, x - 1, y - 1, 1, 1);
+    PsychCopyToAtlas(source->textureNumber, width - 1, 0, page->texture, x + width, y - 1, 1, 1);
+    PsychCopyToAtlas(source->textureNumber, 0, height - 1, page->texture, x - 1, y + height, 1, 1);
+    PsychCopyToAtlas(source->textureNumber, width - 1, height - 1, page->texture, x + width, y + height, 1, 1);
+
+    if (glGetError() != GL_NO_ERROR) {
+        // Copy failed, e.g., due to a format unsupported for copies. Don't try again with this texture:
+        if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Failed to copy texture %i into texture atlas for 'DrawTextures'.\n", source->windowIndex);
+        source->atlasEligible = FALSE;
+        return(FALSE);
+    }
+
+    page->shelfX += width + 2;
+    if (page->shelfHeight < height + 2) page->shelfHeight = height + 2;
+    page->refCount++;
+
+    source->atlasPage = (int) (page - parent->atlasPages) + 1;
+    source->atlasX = x;
+    source->atlasY = y;
+
+    return(TRUE);
+}
+
+/* PsychAtlasBlitTexturesToDisplay()
+ *
+ * Fast path of Screen('DrawTextures') for drawing 'numRef' items from multiple textures 'texids' into
+ * window 'target'. All other arguments have the same meaning as in SCREENDrawTextures(), which must have
+ * validated them and setup 'target' via PsychPrepareRenderBatch() already. Draws all items from texture
+ * atlas pages, with their vertex data streamed into the streaming VBO, and one draw call per run of items
+ * in the same page and with the same filterMode.
+ *
+ * Returns TRUE if all items got drawn, FALSE if nothing got drawn, because any texture can't be drawn
+ * from an atlas, or the needed OpenGL functionality is unsupported or disabled via the ConserveVRAM flags
+ * kPsychDontUseTextureAtlas or kPsychDontUseStreamingVBOs. The caller must draw the items the regular way then.
+ */
+psych_bool PsychAtlasBlitTexturesToDisplay(PsychWindowRecordType *target, int numRef, int numTexs, double *texids, int numsrcRects, double *srcRects,
+                                           int numdstRects, double *dstRects, int numAngles, double *rotationAngles, int numFilterModes, double *filterModes,
+                                           int numAlphas, double *globalAlphas, int nc, int mc, double *colors, unsigned char *bytecolors, int specialFlags)
+{
+    PsychWindowRecordType *parent, *source;
+    PsychAtlasItem *items, *item;
+    PsychRectType tempRect;
+    GLintptr offset;
+    GLfloat *v;
+    double sourceX, sourceY, sourceXEnd, sourceYEnd, transX, transY, crt, srt, rotAngleRad, x, y;
+    double tx[4], ty[4], vx[4], vy[4];
+    int i, j, count, first, filterMode;
+
+    if (!PsychIsGLClassic(target) || (numTexs < 2) || (PsychPrefStateGet_ConserveVRAM() & (kPsychDontUseTextureAtlas | kPsychDontUseStreamingVBOs)) ||
+        !(GLEW_VERSION_4_3 || GLEW_ARB_copy_image) || !(GLEW_VERSION_4_2 || GLEW_ARB_texture_storage))
+        return(FALSE);
+
+    // Rotation of texture coordinates would sample outside of the items texture:
+    if ((specialFlags & kPsychUseTextureMatrixForRotation) && !(specialFlags & kPsychDontDoRotation))
+        for (i = 0; i < numAngles; i++)
+            if (rotationAngles[i] != 0) return(FALSE);
+
+    parent = PsychGetParentWindow(target);
+    items = (PsychAtlasItem*) PsychMallocTemp(numRef * sizeof(PsychAtlasItem));
+    count = 0;
+
+    // Validate all items and make their textures resident in the atlas, before anything gets drawn:
+    for (i = 0; i < numRef; i++) {
+        if (!IsWindowIndex((PsychWindowIndexType) texids[i]))
+            return(FALSE);
+
+        FindWindowRecord((PsychWindowIndexType) texids[i], &source);
+        if ((source->windowType != kPsychTexture) || !source->atlasEligible || (source->textureNumber == 0) ||
+            (PsychGetParentWindow(source) != parent) || (source->textureFilterShader != 0) || (source->textureLookupShader != 0) ||
+            ((source->textureOrientation != 0) && (source->textureOrientation != 2) && (source->textureOrientation != 3)) ||
+            (PsychGetTextureTarget(source) != GL_TEXTURE_RECTANGLE_EXT) ||
+            (source->specialflags & (kPsychUseTextureMatrixForRotation | kPsychPlanarTexture)) ||
+            (PsychGetWidthFromRect(source->rect) > PSYCH_ATLAS_MAX_TEXSIZE) || (PsychGetHeightFromRect(source->rect) > PSYCH_ATLAS_MAX_TEXSIZE))
+            return(FALSE);
+
+        // Texture content may have changed by rendering into it via its FBO, so the atlas copy is stale:
+        if (source->drawBufferFBO[0] != -1) {
+            PsychReleaseAtlasTexture(source);
+            return(FALSE);
+        }
+
+        item = &items[count];
+        item->source = source;
+
+        if (numsrcRects > 1) PsychCopyRect(item->sourceRect, &(srcRects[i*4]));
+        else if (numsrcRects == 1) PsychCopyRect(item->sourceRect, &(srcRects[0]));
+        else PsychCopyRect(item->sourceRect, source->clientrect);
+
+        if (IsPsychRectEmpty(item->sourceRect)) continue;
+
+        // Sampling outside the texture would hit neighbouring textures in the atlas:
+        if ((item->sourceRect[kPsychLeft] < 0) || (item->sourceRect[kPsychTop] < 0) ||
+            (item->sourceRect[kPsychRight] > PsychGetWidthFromRect(source->rect)) || (item->sourceRect[kPsychBottom] > PsychGetHeightFromRect(source->rect)))
+            return(FALSE);
+
+        if (numdstRects > 1) PsychCopyRect(item->targetRect, &(dstRects[i*4]));
+        else if (numdstRects == 1) PsychCopyRect(item->targetRect, &(dstRects[0]));
+        else {
+            PsychCopyRect(tempRect, target->clientrect);
+            PsychCenterRectInRect(item->sourceRect, tempRect, item->targetRect);
+        }
+
+        if (IsPsychRectEmpty(item->targetRect)) continue;
+
+        filterMode = (numFilterModes > 1) ? (int) filterModes[i] : ((numFilterModes == 1) ? (int) filterModes[0] : 1);
+        if ((filterMode != 0) && (filterMode != 1))
+            return(FALSE);
+
+        item->filterMode = filterMode;
+        item->rotationAngle = (specialFlags & kPsychDontDoRotation) ? 0 : ((numAngles > 1) ? rotationAngles[i] : ((numAngles == 1) ? rotationAngles[0] : 0));
+
+        // Same color assignment as for regular drawing: modulateColor if any, otherwise (1,1,1,globalAlpha):
+        if (nc > 1) {
+            for (j = 0; j < mc; j++) item->color[j] = (colors) ? (float) colors[i * mc + j] : (float) bytecolors[i * mc + j] / 255.0f;
+            if (mc == 3) item->color[3] = 1.0f;
+        }
+        else if (nc == 1) {
+            for (j = 0; j < 4; j++) item->color[j] = (float) target->currentColor[j];
+        }
+        else {
+            item->color[0] = item->color[1] = item->color[2] = 1.0f;
+            item->color[3] = (float) ((numAlphas > 1) ? globalAlphas[i] : ((numAlphas == 1) ? globalAlphas[0] : 1.0));
+        }
+
+        if (!PsychMakeAtlasResident(parent, source))
+            return(FALSE);
+
+        count++;
+    }
+
+    // Keep the last items modulateColor as current color, as regular drawing would:
+    if ((nc > 1) && (count > 0))
+        for (j = 0; j < 4; j++) target->currentColor[j] = items[count - 1].color[j];
+
+    if (count == 0)
+        return(TRUE);
+
+    // 4 vertices per item, each with 2D position, 2D texture coordinate and RGBA color:
+    v = (GLfloat*) PsychMapStreamingVBO(target, (size_t) count * 4 * 8 * sizeof(GLfloat), &offset);
+    if (NULL == v)
+        return(FALSE);
+
+    for (i = 0; i < count; i++) {
+        item = &items[i];
+        source = item->source;
+
+        // Texture coordinates, as in PsychBatchBlitTexturesToDisplay(), but shifted to the textures location in its atlas page:
+        if (source->textureOrientation == 2) {
+            sourceX = item->sourceRect[kPsychLeft];
+            sourceY = PsychGetHeightFromRect(source->rect) - item->sourceRect[kPsychBottom];
+            sourceXEnd = item->sourceRect[kPsychRight];
+            sourceYEnd = PsychGetHeightFromRect(source->rect) - item->sourceRect[kPsychTop];
+
+            tx[0] = sourceX;    ty[0] = sourceYEnd;
+            tx[1] = sourceX;    ty[1] = sourceY;
+            tx[2] = sourceXEnd; ty[2] = sourceY;
+            tx[3] = sourceXEnd; ty[3] = sourceYEnd;
+        }
+        else if (source->textureOrientation == 3) {
+            // Upside-down texture, e.g., from C memory layout image matrices:
+            sourceX = item->sourceRect[kPsychLeft];
+            sourceY = item->sourceRect[kPsychBottom];
+            sourceXEnd = item->sourceRect[kPsychRight];
+            sourceYEnd = item->sourceRect[kPsychTop];
+
+            tx[0] = sourceX;    ty[0] = sourceYEnd;
+            tx[1] = sourceX;    ty[1] = sourceY;
+            tx[2] = sourceXEnd; ty[2] = sourceY;
+            tx[3] = sourceXEnd; ty[3] = sourceYEnd;
+        }
+        else {
+            sourceX = item->sourceRect[kPsychTop];
+            sourceY = item->sourceRect[kPsychLeft];
+            sourceXEnd = item->sourceRect[kPsychBottom];
+            sourceYEnd = item->sourceRect[kPsychRight];
+
+            tx[0] = sourceX;    ty[0] = sourceY;
+            tx[1] = sourceXEnd; ty[1] = sourceY;
+            tx[2] = sourceXEnd; ty[2] = sourceYEnd;
+            tx[3] = sourceX;    ty[3] = sourceYEnd;
+        }
+
+        vx[0] = item->targetRect[kPsychLeft];  vy[0] = item->targetRect[kPsychTop];
+        vx[1] = item->targetRect[kPsychLeft];  vy[1] = item->targetRect[kPsychBottom];
+        vx[2] = item->targetRect[kPsychRight]; vy[2] = item->targetRect[kPsychBottom];
+        vx[3] = item->targetRect[kPsychRight]; vy[3] = item->targetRect[kPsychTop];
+
+        // Rotate quad around its center:
+        if (item->rotationAngle != 0) {
+            rotAngleRad = item->rotationAngle * M_PI / 180.0;
+            crt = cos(rotAngleRad);
+            srt = sin(rotAngleRad);
+            transX = (item->targetRect[kPsychRight] + item->targetRect[kPsychLeft]) * 0.5;
+            transY = (item->targetRect[kPsychTop] + item->targetRect[kPsychBottom]) * 0.5;
+
+            for (j = 0; j < 4; j++) {
+                x = vx[j] - transX;
+                y = vy[j] - transY;
+                vx[j] = crt * x - srt * y + transX;
+                vy[j] = srt * x + crt * y + transY;
+            }
+        }
+
+        for (j = 0; j < 4; j++) {
+            *(v++) = (GLfloat) vx[j];
+            *(v++) = (GLfloat) vy[j];
+            *(v++) = (GLfloat) (tx[j] + source->atlasX);
+            *(v++) = (GLfloat) (ty[j] + source->atlasY);
+            *(v++) = item->color[0];
+            *(v++) = item->color[1];
+            *(v++) = item->color[2];
+            *(v++) = item->color[3];
+        }
+    }
+
+    PsychUnmapStreamingVBO(target);
+
+    // Fixed function texture mapping with GL_MODULATE, like PsychBatchBlitTexturesToDisplay():
+    PsychSetShader(target, 0);
+    glDisable(GL_TEXTURE_2D);
+    glEnable(GL_TEXTURE_RECTANGLE_EXT);
+    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    glVertexPointer(2, GL_FLOAT, 8 * sizeof(GLfloat), (const GLvoid*) offset);
+    glTexCoordPointer(2, GL_FLOAT, 8 * sizeof(GLfloat), (const GLvoid*) (offset + 2 * sizeof(GLfloat)));
+    glColorPointer(4, GL_FLOAT, 8 * sizeof(GLfloat), (const GLvoid*) (offset + 4 * sizeof(GLfloat)));
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    // One draw call per run of items with the same atlas page and filterMode:
+    for (first = 0, i = 1; i <= count; i++) {
+        if ((i < count) && (items[i].source->atlasPage == items[first].source->atlasPage) && (items[i].filterMode == items[first].filterMode))
+            continue;
+
+        glBindTexture(GL_TEXTURE_RECTANGLE_EXT, parent->atlasPages[items[first].source->atlasPage - 1].texture);
+        glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_MIN_FILTER, (items[first].filterMode) ? GL_LINEAR : GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_MAG_FILTER, (items[first].filterMode) ? GL_LINEAR : GL_NEAREST);
+        glDrawArrays(GL_QUADS, first * 4, (i - first) * 4);
+        first = i;
+    }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindTexture(GL_TEXTURE_RECTANGLE_EXT, 0);
+    glDisable(GL_TEXTURE_RECTANGLE_EXT);
+
+    return(TRUE);
+}
@@ -24,6 +24,7 @@ HISTORY:
 void PsychInitWindowRecordTextureFields(PsychWindowRecordType *winRec);
 void PsychCreateTexture(PsychWindowRecordType *win);
 void PsychFreeTextureForWindowRecord(PsychWindowRecordType *win);
+psych_bool PsychWaitForTextureUpload(PsychWindowRecordType *win, double timeoutSecs);
 void PsychBlitTextureToDisplay(PsychWindowRecordType *source, PsychWindowRecordType *target, double *sourceRect, double *targetRect,
                                double rotationAngle, int filterMode, double globalAlpha);
 GLenum PsychGetTextureTarget(PsychWindowRecordType *win);
@@ -31,5 +32,10 @@ void PsychMapTexCoord(PsychWindowRecordType *tex, double* tx, double* ty);
 void PsychDetectTextureTarget(PsychWindowRecordType *win);
 void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, PsychWindowRecordType *source, PsychWindowRecordType *target, double *sourceRect, double *targetRect,
                                      double rotationAngle, int filterMode, double globalAlpha);
+psych_bool PsychAtlasBlitTexturesToDisplay(PsychWindowRecordType *target, int numRef, int numTexs, double *texids, int numsrcRects, double *srcRects,
+                                           int numdstRects, double *dstRects, int numAngles, double *rotationAngles, int numFilterModes, double *filterModes,
+                                           int numAlphas, double *globalAlphas, int nc, int mc, double *colors, unsigned char *bytecolors, int specialFlags);
+void PsychReleaseAtlasTexture(PsychWindowRecordType *win);
+void PsychDeleteTextureAtlas(PsychWindowRecordType *windowRecord);
 //end include once
 #endif
@@ -126,6 +126,15 @@ static unsigned int frameSeqStereoActive = 0;
 // Count of onscreen windows which have our own threaded VRR scheduler implementation active:
 static unsigned int vrrSchedulersActive = 0;
 
+// Atomic operations on the frame counters of flip queues, shared between the master thread and flipper threads:
+#if defined(_MSC_VER)
+#define PsychFlipQueueAtomicStore(p, v) InterlockedExchange64((volatile LONG64*) (p), (LONG64) (v))
+#define PsychFlipQueueAtomicLoad(p)     ((psych_uint64) InterlockedCompareExchange64((volatile LONG64*) (p), 0, 0))
+#else
+#define PsychFlipQueueAtomicStore(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define PsychFlipQueueAtomicLoad(p)     __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#endif
+
 // Return count of currently async-flipping onscreen windows:
 unsigned int PsychGetNrAsyncFlipsActive(void)
 {
@@ -409,7 +418,7 @@ psych_bool PsychOpenOnscreenWindow(PsychScreenSettingsType *screenSettings, Psyc
     psych_bool did_pageflip = FALSE;
     int skip_synctests;
     int visual_debuglevel = PsychPrefStateGet_VisualDebugLevel();
-    int conserveVRAM = PsychPrefStateGet_ConserveVRAM();
+    int conserveVRAM = (int) PsychPrefStateGet_ConserveVRAM();
     GLboolean isFloatBuffer = FALSE;
     GLint bpc;
     double maxStddev, maxDeviation, maxDuration;    // Sync thresholds and settings...
@@ -2303,6 +2312,9 @@ void PsychCloseWindow(PsychWindowRecordType *windowRecord)
         // Make sure our main OpenGL context is active for final cleanup:
         PsychSetGLContext(windowRecord);
 
+        // Release slots of the flip queue, if any, before their redirection could confuse imaging pipeline shutdown:
+        PsychFlipQueueRelease(windowRecord);
+
         // Shutdown only OpenGL related parts of imaging pipeline for this windowRecord, i.e.
         // do the shutdown work which still requires a fully functional OpenGL context and
         // hook-chains:
@@ -2311,6 +2323,22 @@ void PsychCloseWindow(PsychWindowRecordType *windowRecord)
         // Call cleanup routine of text renderers to cleanup anything text related for this windowRecord:
         PsychCleanupTextRenderer(windowRecord);
 
+        // Release streaming vertex buffer of batch drawing functions, if any:
+        PsychDeleteStreamingVBO(windowRecord);
+
+        // Release shader and geometry for instanced drawing of shape batches, if any:
+        PsychDeleteInstancedShapes(windowRecord);
+
+        // Release texture atlas pages of 'DrawTextures', if any:
+        PsychDeleteTextureAtlas(windowRecord);
+
+        // Release pixel pack buffers of asynchronous 'GetImage', if any:
+        PsychDeleteAsyncReadbacks(windowRecord);
+
+        // Release pixel unpack buffer of asynchronous 'MakeTexture', if any:
+        if (windowRecord->textureUploadPBO) glDeleteBuffers(1, &windowRecord->textureUploadPBO);
+        windowRecord->textureUploadPBO = 0;
+
         // Destroy a potentially orphaned GPU rendertime query:
         if (windowRecord->gpuRenderTimeQuery) {
             glGetQueryiv(GL_TIME_ELAPSED_EXT, GL_CURRENT_QUERY, &queryState);
@@ -2319,6 +2347,9 @@ void PsychCloseWindow(PsychWindowRecordType *windowRecord)
             windowRecord->gpuRenderTimeQuery = 0;
         }
 
+        // Release query objects and results of the pipeline profiler, if any:
+        PsychProfilerEnable(windowRecord, FALSE);
+
         // Sync and idle the pipeline again:
         glFinish();
 
@@ -2329,6 +2360,7 @@ void PsychCloseWindow(PsychWindowRecordType *windowRecord)
                 (windowRecordArray[i]->windowType==kPsychTexture || windowRecordArray[i]->windowType==kPsychProxyWindow)) {
                 windowRecordArray[i]->targetSpecific.contextObject = NULL;
                 windowRecordArray[i]->targetSpecific.glusercontextObject = NULL;
+                windowRecordArray[i]->atlasPage = 0;
             }
         }
         PsychDestroyVolatileWindowRecordPointerList(windowRecordArray);
@@ -2784,6 +2816,10 @@ void PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord)
         // function in a running session! (WTF?!?)
         PsychSetThreadPriority(&(flipRequest->flipperThread), 0, 0);
 
+        // The flipper thread of a flip queue sleeps on the condition variable with the lock held by itself,
+        // so we need to take the lock, to make sure it doesn't miss our signal:
+        if (windowRecord->flipQueue) PsychLockMutex(&(flipRequest->performFlipLock));
+
         // Set opmode to "terminate please":
         flipRequest->opmode = -1;
 
@@ -2943,8 +2979,8 @@ void* PsychFlipperThreadMain(void* windowRecordToCast)
     if (windowRecord->imagingMode & kPsychEnableSRGBRendering)
         glEnable(GL_FRAMEBUFFER_SRGB);
 
-    // Is this a true async flip and not something else like stereo or vrr?
-    if ((windowRecord->stereomode != kPsychFrameSequentialStereo) && (windowRecord->vrrMode != kPsychVRROwnScheduled)) {
+    // Is this a true async flip and not something else like stereo or vrr or a flip queue?
+    if ((windowRecord->stereomode != kPsychFrameSequentialStereo) && (windowRecord->vrrMode != kPsychVRROwnScheduled) && !windowRecord->flipQueue) {
         // Set our state as "initialized, ready & waiting":
         flipRequest->flipperState = 1;
 
@@ -3371,6 +3407,80 @@ void* PsychFlipperThreadMain(void* windowRecordToCast)
         // Exit from VRR scheduling dispatch loop.
     } // End of VRR scheduler code.
 
+    if (windowRecord->flipQueue) {
+        // Flip queue dispatch loop: Presents the frames submitted by the masterthread into the flip queue
+        // in order, each at its requested onset time, until we receive a shutdown request...
+        PsychFlipQueue *queue = windowRecord->flipQueue;
+        PsychFlipQueueSlot *slot;
+        PsychFlipQueueResult *result;
+        psych_uint64 frameId;
+
+        // Setup view: We set the full backbuffer area of the window.
+        PsychSetupView(windowRecord, TRUE);
+
+        // Set our state as "initialized and ready":
+        flipRequest->flipperState = 6;
+
+        // Dispatch loop: We hold the lock, except while sleeping or presenting a frame:
+        while (TRUE) {
+            // Check if we are supposed to terminate:
+            if (flipRequest->opmode == -1) {
+                // We hold the mutex, so set us to state "terminating with lock held" and exit the loop:
+                flipRequest->flipperState = 4;
+                break;
+            }
+
+            // Any submitted frame waiting for presentation? We are the only writer of 'presented':
+            frameId = queue->presented;
+            if (frameId == PsychFlipQueueAtomicLoad(&(queue->submitted))) {
+                // Nope. Sleep until the masterthread submits a frame or wants us to terminate:
+                PsychWaitCondition(&(flipRequest->flipperGoGoGo), &(flipRequest->performFlipLock));
+                continue;
+            }
+
+            // Yes. Is its onset deadline close enough to schedule the flip? If not, sleep until it
+            // is, but stay responsive to shutdown requests:
+            slot = &(queue->slots[frameId % queue->length]);
+            PsychGetAdjustedPrecisionTimerSeconds(&tnow);
+            if (slot->flipwhen - tnow > 2 * windowRecord->VideoRefreshInterval) {
+                PsychTimedWaitCondition(&(flipRequest->flipperGoGoGo), &(flipRequest->performFlipLock), slot->flipwhen - tnow - 2 * windowRecord->VideoRefreshInterval);
+                continue;
+            }
+
+            PsychUnlockMutex(&(flipRequest->performFlipLock));
+
+            // Make the gpu wait for completion of the masterthreads rendering into the slot:
+            if (slot->fence) {
+                glWaitSync(slot->fence, 0, GL_TIMEOUT_IGNORED);
+                glDeleteSync(slot->fence);
+                slot->fence = NULL;
+            }
+
+            // Copy the frame from the slot into the backbuffer:
+            glBindFramebufferEXT(GL_READ_FRAMEBUFFER_EXT, slot->fbo->fboid);
+            glBindFramebufferEXT(GL_DRAW_FRAMEBUFFER_EXT, 0);
+            glDrawBuffer(GL_BACK);
+            glBlitFramebufferEXT(0, 0, slot->fbo->width, slot->fbo->height, 0, 0, slot->fbo->width, slot->fbo->height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+
+            // Execute synchronous flip to make it the frontbuffer, and record its results:
+            result = &(queue->results[frameId % kPsychFlipQueueResultsLength]);
+            result->flipwhen = slot->flipwhen;
+            result->vbl_timestamp = PsychFlipWindowBuffers(windowRecord, 0, slot->vbl_synclevel, 2, slot->flipwhen, &(result->beamPosAtFlip),
+                                                           &(result->miss_estimate), &(result->time_at_flipend), &(result->time_at_onset));
+
+            // We glFinish() here, to make sure the copy from the slot is finished. This means the slot
+            // is "used up" and ready for refill by the masterthread:
+            glFinish();
+
+            // Hand the slot back to the masterthread. The atomic store orders all writes to result before it:
+            PsychLockMutex(&(flipRequest->performFlipLock));
+            PsychFlipQueueAtomicStore(&(queue->presented), frameId + 1);
+            PsychSignalCondition(&(queue->presentedSignal));
+        }
+        // Exit from flip queue dispatch loop.
+    } // End of flip queue code.
+
     // Exit path from thread at thread termination...
 
     // Make sure our thread detaches from its private OpenGL context before it dies:
@@ -3830,6 +3940,277 @@ psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord)
     return(TRUE);
 }
 
+/* PsychFlipQueueCreate() -- Create a queue of 'length' pre-rendered frames for an onscreen window.
+ *
+ * Allocates one FBO per queue slot and starts the flipper thread of the window in flip queue mode.
+ * From then on, PsychPreFlipOperations() renders the final image of each frame into the next free
+ * slot instead of into the system backbuffer, PsychFlipQueueSubmit() submits it for presentation,
+ * and the flipper thread presents the submitted frames in order, each at its requested onset time.
+ * The masterthread and flipper thread communicate via the 'submitted' and 'presented' frame counters
+ * of the queue. Each submit and each present takes the performFlipLock once, to update its counter and
+ * wake up the other thread, which may sleep on a condition variable. The frames in the slots are accessed
+ * without the lock. The queue exists until the window is closed.
+ */
+void PsychFlipQueueCreate(PsychWindowRecordType *windowRecord, int length)
+{
+    PsychFlipInfoStruct* flipRequest = windowRecord->flipInfo;
+    PsychFlipQueue *queue;
+    GLint redbits;
+    GLenum fboFormat;
+    psych_bool ready;
+    int i, rc;
+
+    if (windowRecord->flipQueue)
+        PsychErrorExitMsg(PsychError_user, "Tried to create a flip queue for a window which already has one!");
+
+    if ((NULL == flipRequest) || (flipRequest->flipperThread != (psych_thread) NULL) || (flipRequest->asyncstate != 0))
+        PsychErrorExitMsg(PsychError_user, "Flip queues can only be created for onscreen windows which did not use async flips before!");
+
+    if ((windowRecord->specialflags & (kPsychDontUseFlipperThread | kPsychExternalDisplayMethod | kPsychIsEGLWindow)) ||
+        (PsychPrefStateGet_ConserveVRAM() & kPsychUseOldStyleAsyncFlips))
+        PsychErrorExitMsg(PsychError_user, "Flip queues are not supported with the display backend, specialFlags or ConserveVRAM settings of this window!");
+
+    // The final image of a frame must be a single monoscopic image or merged stereo image, which
+    // the pipeline would write into the system backbuffer:
+    if (!(windowRecord->imagingMode & kPsychNeedFastBackingStore) || (windowRecord->imagingMode & kPsychNeedDualWindowOutput) ||
+        (windowRecord->fboTable[windowRecord->finalizedFBO[0]]->fboid != 0) || (windowRecord->finalizedFBO[0] != windowRecord->finalizedFBO[1]) ||
+        (windowRecord->stereomode == kPsychOpenGLStereo) || (windowRecord->stereomode == kPsychFrameSequentialStereo) ||
+        (windowRecord->stereomode == kPsychDualWindowStereo) || (windowRecord->stereomode == kPsychDualStreamStereo) ||
+        (windowRecord->vrrMode == kPsychVRROwnScheduled) || windowRecord->slaveWindow)
+        PsychErrorExitMsg(PsychError_user, "Flip queues need the imaging pipeline, and are not supported with dual-stream stereo or output modes, or our own VRR scheduler!");
+
+    if (!(windowRecord->gfxcaps & kPsychGfxCapFBOBlit))
+        PsychErrorExitMsg(PsychError_user, "Flip queues are not supported on this graphics hardware, as it lacks support for framebuffer blits!");
+
+    // Query bit depth of the system backbuffer, to choose the format of the slots like for finalizedFBOs:
+    PsychSetDrawingTarget(NULL);
+    PsychSetGLContext(windowRecord);
+    glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+    glGetIntegerv(GL_RED_BITS, &redbits);
+    fboFormat = (redbits <= 8) ? GL_RGBA8 : ((windowRecord->gfxcaps & kPsychGfxCapFPFBO32) ? GL_RGBA_FLOAT32_APPLE : GL_RGBA16_SNORM);
+
+    queue = (PsychFlipQueue*) calloc(1, sizeof(PsychFlipQueue));
+    if (NULL == queue) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while trying to create flip queue!");
+
+    queue->length = length;
+    queue->sysFBO = windowRecord->fboTable[windowRecord->finalizedFBO[0]];
+
+    for (i = 0; i < length; i++) {
+        if (!PsychCreateFBO(&(queue->slots[i].fbo), fboFormat, FALSE, queue->sysFBO->width, queue->sysFBO->height, 0, 0)) {
+            while (--i >= 0) PsychDeleteFBO(queue->slots[i].fbo);
+            free(queue);
+            PsychErrorExitMsg(PsychError_system, "Could not create framebuffers for the slots of the flip queue!");
+        }
+    }
+
+    // Previous preflip operations already rendered into the backbuffer must be redone into a slot:
+    windowRecord->PipelineFlushDone = false;
+    windowRecord->backBufferBackupDone = false;
+
+    // Detach from our OpenGL context, so the flipper thread can attach its own context to the window:
+    PsychSetDrawingTarget(NULL);
+    PsychOSUnsetGLContext(windowRecord);
+
+    // Create & Init the mutex and condition variable, as they are used for thread shutdown:
+    if ((rc=PsychInitMutex(&(flipRequest->performFlipLock)))) {
+        printf("PTB-ERROR: In PsychFlipQueueCreate(): Could not create performFlipLock mutex lock [%s].\n", strerror(rc));
+        PsychErrorExitMsg(PsychError_system, "Insufficient system ressources for mutex creation as part of flip queue setup!");
+    }
+
+    if ((rc=PsychInitCondition(&(flipRequest->flipperGoGoGo), NULL)) || (rc=PsychInitCondition(&(queue->presentedSignal), NULL))) {
+        printf("PTB-ERROR: In PsychFlipQueueCreate(): Could not create condition variables [%s].\n", strerror(rc));
+        PsychErrorExitMsg(PsychError_system, "Insufficient system ressources for condition variable creation as part of flip queue setup!");
+    }
+
+    // Set initial thread state to "inactive, not initialized at all":
+    flipRequest->flipperState = 0;
+
+    // The flipper thread selects its flip queue dispatch loop if flipQueue is set:
+    windowRecord->flipQueue = queue;
+
+    // Create and startup thread:
+    if ((rc=PsychCreateThread(&(flipRequest->flipperThread), NULL, PsychFlipperThreadMain, (void*) windowRecord))) {
+        printf("PTB-ERROR: In PsychFlipQueueCreate(): Could not create flipper  [%s].\n", strerror(rc));
+        PsychErrorExitMsg(PsychError_system, "Insufficient system ressources for thread creation as part of flip queue setup!");
+    }
+
+    // Boost priority of flipperThread, as for regular async flips:
+    if (PSYCH_SYSTEM == PSYCH_WINDOWS) PsychSetThreadPriority((psych_thread*) 0x1, 0, 0);
+    PsychSetThreadPriority(&(flipRequest->flipperThread), 10, 2);
+
+    // Wait for the thread to become ready. See PsychFlipWindowBuffersIndirect() for the logic:
+    while (TRUE) {
+        if ((rc=PsychLockMutex(&(flipRequest->performFlipLock)))) {
+            printf("PTB-ERROR: In PsychFlipQueueCreate(): First mutex_lock in init failed  [%s].\n", strerror(rc));
+            PsychErrorExitMsg(PsychError_system, "Internal error or deadlock avoided as part of flip queue setup!");
+        }
+
+        ready = (flipRequest->flipperState == 6) ? TRUE : FALSE;
+
+        if ((rc=PsychUnlockMutex(&(flipRequest->performFlipLock)))) {
+            printf("PTB-ERROR: In PsychFlipQueueCreate(): First mutex_unlock in init failed  [%s].\n", strerror(rc));
+            PsychErrorExitMsg(PsychError_system, "Internal error or deadlock avoided as part of flip queue setup!");
+        }
+
+        if (ready) break;
+
+        // Thread not ready. Sleep a millisecond and repeat...
+        PsychYieldIntervalSeconds(0.001);
+    }
+
+    return;
+}
+
+/* PsychFlipQueueBeginFrame() -- Redirect the final image of the current frame into the next free slot.
+ *
+ * Called by PsychPreFlipOperations() before the imaging pipeline runs. Waits for a free slot if all
+ * slots are still waiting for presentation.
+ */
+static void PsychFlipQueueBeginFrame(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipQueue *queue = windowRecord->flipQueue;
+    PsychFlipInfoStruct *flipRequest = windowRecord->flipInfo;
+
+    // All slots waiting for presentation? Sleep until the flipper thread presented one. Wake up
+    // once in a while, to check if the flipper thread died from an error:
+    if (queue->submitted - PsychFlipQueueAtomicLoad(&(queue->presented)) >= (psych_uint64) queue->length) {
+        PsychLockMutex(&(flipRequest->performFlipLock));
+        while (queue->submitted - PsychFlipQueueAtomicLoad(&(queue->presented)) >= (psych_uint64) queue->length) {
+            if (flipRequest->flipperState == 5) {
+                PsychUnlockMutex(&(flipRequest->performFlipLock));
+                PsychErrorExitMsg(PsychError_system, "Flipper thread of the flip queue failed! Presentation of queued frames impossible.");
+            }
+
+            PsychTimedWaitCondition(&(queue->presentedSignal), &(flipRequest->performFlipLock), 0.1);
+        }
+        PsychUnlockMutex(&(flipRequest->performFlipLock));
+    }
+
+    windowRecord->fboTable[windowRecord->finalizedFBO[0]] = queue->slots[queue->submitted % queue->length].fbo;
+}
+
+/* PsychFlipQueueEndFrame() -- Undo the redirection of PsychFlipQueueBeginFrame() at the end of preflip operations.
+ *
+ * Fences the rendering into the slot, so the flipper thread can wait for its completion on the gpu.
+ */
+static void PsychFlipQueueEndFrame(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipQueue *queue = windowRecord->flipQueue;
+    PsychFlipQueueSlot *slot = &(queue->slots[queue->submitted % queue->length]);
+
+    windowRecord->fboTable[windowRecord->finalizedFBO[0]] = queue->sysFBO;
+
+    if (glFenceSync) {
+        slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+    }
+    else {
+        glFinish();
+    }
+
+    queue->frameRendered = TRUE;
+}
+
+/* PsychFlipQueueSubmit() -- Submit the current frame to the flip queue for presentation at time 'flipwhen'.
+ *
+ * Runs the preflip operations, unless Screen('DrawingFinished') already did, to render the frame into
+ * the next free slot, submits it to the flipper thread, then prepares the drawBufferFBOs for drawing the
+ * next frame according to 'dont_clear', like after a regular flip. Returns the zero-based index of the
+ * submitted frame.
+ */
+psych_uint64 PsychFlipQueueSubmit(PsychWindowRecordType *windowRecord, double flipwhen, int dont_clear, int vbl_synclevel)
+{
+    PsychFlipQueue *queue = windowRecord->flipQueue;
+    PsychFlipQueueSlot *slot;
+    psych_uint64 frameId;
+
+    PsychPreFlipOperations(windowRecord, dont_clear);
+    if (!queue->frameRendered)
+        PsychErrorExitMsg(PsychError_internal, "Preflip operations did not render the frame into the flip queue!");
+
+    // We are the only writer of 'submitted':
+    frameId = queue->submitted;
+    slot = &(queue->slots[frameId % queue->length]);
+    slot->flipwhen = flipwhen;
+    slot->vbl_synclevel = vbl_synclevel;
+    queue->frameRendered = FALSE;
+
+    // Hand the slot to the flipper thread and wake it up. The atomic store orders all writes to slot before it:
+    PsychLockMutex(&(windowRecord->flipInfo->performFlipLock));
+    PsychFlipQueueAtomicStore(&(queue->submitted), frameId + 1);
+    PsychSignalCondition(&(windowRecord->flipInfo->flipperGoGoGo));
+    PsychUnlockMutex(&(windowRecord->flipInfo->performFlipLock));
+
+    // Prepare for drawing of the next frame:
+    PsychPostFlipOperations(windowRecord, dont_clear);
+    PsychProfilerFinishFrame(windowRecord);
+    windowRecord->PipelineFlushDone = false;
+    windowRecord->backBufferBackupDone = false;
+
+    PsychPipelineExecuteHook(windowRecord, kPsychScreenFlipImpliedOperations, NULL, NULL, FALSE, FALSE, NULL, NULL, NULL, NULL);
+    PsychPipelineExecuteHook(windowRecord, kPsychUserspaceBufferDrawingPrepare, NULL, NULL, FALSE, FALSE, NULL, NULL, NULL, NULL);
+
+    return(frameId);
+}
+
+/* PsychFlipQueueWaitPresented() -- Wait until at least 'count' frames of the flip queue have been presented.
+ *
+ * Waits at most 'maxWaitSecs' seconds, then returns the number of presented frames.
+ */
+psych_uint64 PsychFlipQueueWaitPresented(PsychWindowRecordType *windowRecord, psych_uint64 count, double maxWaitSecs)
+{
+    PsychFlipQueue *queue = windowRecord->flipQueue;
+    PsychFlipInfoStruct *flipRequest = windowRecord->flipInfo;
+    psych_uint64 presented;
+    double tnow, tdeadline;
+
+    if ((presented = PsychFlipQueueAtomicLoad(&(queue->presented))) >= count) return(presented);
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tnow);
+    tdeadline = tnow + maxWaitSecs;
+
+    // Sleep until enough frames are presented or the deadline is reached. Wake up once in
+    // a while, to check if the flipper thread died from an error:
+    PsychLockMutex(&(flipRequest->performFlipLock));
+    while (((presented = PsychFlipQueueAtomicLoad(&(queue->presented))) < count) && (tnow < tdeadline)) {
+        if (flipRequest->flipperState == 5) {
+            PsychUnlockMutex(&(flipRequest->performFlipLock));
+            PsychErrorExitMsg(PsychError_system, "Flipper thread of the flip queue failed! Presentation of queued frames impossible.");
+        }
+
+        PsychTimedWaitCondition(&(queue->presentedSignal), &(flipRequest->performFlipLock), (tdeadline - tnow < 0.1) ? tdeadline - tnow : 0.1);
+        PsychGetAdjustedPrecisionTimerSeconds(&tnow);
+    }
+    PsychUnlockMutex(&(flipRequest->performFlipLock));
+
+    return(presented);
+}
+
+/* PsychFlipQueueRelease() -- Release the flip queue of an onscreen window at window close time.
+ *
+ * The flipper thread must already be shut down by PsychReleaseFlipInfoStruct(), and the OpenGL
+ * context of the window must be bound.
+ */
+void PsychFlipQueueRelease(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipQueue *queue = windowRecord->flipQueue;
+    int i;
+
+    if (NULL == queue) return;
+
+    // Undo a redirection into a slot, which may be left over from an error abort during preflip operations:
+    windowRecord->fboTable[windowRecord->finalizedFBO[0]] = queue->sysFBO;
+
+    for (i = 0; i < queue->length; i++) {
+        if (queue->slots[i].fence) glDeleteSync(queue->slots[i].fence);
+        PsychDeleteFBO(queue->slots[i].fbo);
+    }
+
+    PsychDestroyCondition(&(queue->presentedSignal));
+    free(queue);
+    windowRecord->flipQueue = NULL;
+}
+
 #if PSYCH_SYSTEM == PSYCH_WINDOWS
 #undef strerror
 #endif
@@ -3940,6 +4321,10 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
     if (windowRecord->windowType!=kPsychDoubleBufferOnscreen)
         PsychErrorExitMsg(PsychError_internal,"Attempt to swap a single window buffer");
 
+    // With a flip queue, only its flipper thread may swap the buffers:
+    if (windowRecord->flipQueue && PsychIsMasterThread())
+        PsychErrorExitMsg(PsychError_user, "Tried to flip an onscreen window with a flip queue directly! Only flips via the flip queue are allowed.");
+
     // Retrieve estimate of interframe flip-interval:
     if (windowRecord->nrIFISamples > 0) {
         currentflipestimate=windowRecord->IFIRunningSum / ((double) windowRecord->nrIFISamples);
@@ -5136,6 +5521,9 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
     // for drawing of next stim.
     PsychPostFlipOperations(windowRecord, dont_clear);
 
+    // Frame done: Queue its timing results for collection, if pipeline profiling is enabled:
+    PsychProfilerFinishFrame(windowRecord);
+
     // Special imaging mode active? in that case we need to restore drawing engine state to preflip state.
     if (windowRecord->imagingMode > 0) {
         if (PsychIsMasterThread()) {
@@ -5785,6 +6173,7 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
     int queryState;
     GLenum blitscalemode;
     char overridepString1[100];
+    int profileStage, resolveStage;
 
     // Early reject: If this flag is set, then there's no need for any processing:
     // We only continue processing textures, aka offscreen windows...
@@ -5819,6 +6208,9 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
     // Enable this windowRecords framebuffer as current drawingtarget:
     PsychSetDrawingTarget(windowRecord);
 
+    // Start timing of all preflip operations, if pipeline profiling is enabled:
+    profileStage = PsychProfilerBeginStage(windowRecord, "PreFlip", NULL, TRUE);
+
     if (demoOnlyMode)
         PsychDrawDemoSplash(windowRecord);
 
@@ -5826,7 +6218,10 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
     PsychPipelineExecuteHook(windowRecord, kPsychUserspaceBufferDrawingFinished, NULL, NULL, FALSE, FALSE, NULL, NULL, NULL, NULL);
 
     // We stop processing here if window is a texture, aka offscreen window...
-    if (windowRecord->windowType==kPsychTexture) return;
+    if (windowRecord->windowType==kPsychTexture) {
+        PsychProfilerEndStage(windowRecord, profileStage);
+        return;
+    }
 
     #if PSYCH_SYSTEM == PSYCH_WINDOWS
         // Enforce a one-shot GUI event queue dispatch via this dummy call to PsychGetMouseButtonState() to
@@ -5842,6 +6237,10 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
         PsychErrorExitMsg(PsychError_internal, "PsychPreFlipOperations() called on onscreen window with pending async flip?!? Forbidden!");
     }
 
+    // Flip queue active? Then the flipper thread owns the system backbuffer, so redirect the final
+    // image of this frame into the next free slot of the queue:
+    if (windowRecord->flipQueue) PsychFlipQueueBeginFrame(windowRecord);
+
     // Disable any shaders:
     PsychSetShader(windowRecord, 0);
 
@@ -6000,6 +6399,7 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
             if (windowRecord->inputBufferFBO[viewid] != windowRecord->drawBufferFBO[viewid]) {
                 // Separate draw- and inputbuffers: We need to copy the drawBufferFBO to its
                 // corresponding inputBufferFBO, applying a special conversion operation.
+                resolveStage = PsychProfilerBeginStage(windowRecord, (windowRecord->imagingMode & kPsychNeedGPUPanelFitter) ? "PanelFitter" : "MSAAResolve", NULL, TRUE);
 
                 // Set proper binding of source and destination FBO for blit, unless we use the texture
                 // blitter fallback below, in which case these separte low-level bindings are not needed:
@@ -6111,6 +6511,8 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
                                                 &(windowRecord->fboTable[windowRecord->inputBufferFBO[viewid]]), NULL);
                     }
                 }
+
+                PsychProfilerEndStage(windowRecord, resolveStage);
             }
         }
 
@@ -6325,6 +6727,9 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
         }
     }    // End of preflip operations for imaging mode:
 
+    // Frame rendered into a slot of the flip queue? Undo the redirection:
+    if (windowRecord->flipQueue) PsychFlipQueueEndFrame(windowRecord);
+
     // Tell Flip that backbuffer backup has been done already to avoid redundant backups. This is a bit of a
     // unlucky name. It actually signals that all the preflip processing has been done, the old name is historical.
     windowRecord->backBufferBackupDone = true;
@@ -6360,6 +6765,8 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
         PsychTestForGLErrors();
     }
 
+    PsychProfilerEndStage(windowRecord, profileStage);
+
     return;
 }
 
@@ -6389,10 +6796,14 @@ void PsychPostFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
     int screenheight=(int) PsychGetHeightFromRect(windowRecord->rect);
     int stereo_mode=windowRecord->stereomode;
     GLint blending_on, auxbuffers;
+    int profileStage;
 
     // Switch to associated GL-Context of windowRecord:
     PsychSetGLContext(windowRecord);
 
+    // Start timing of all postflip operations, if pipeline profiling is enabled:
+    profileStage = PsychProfilerBeginStage(windowRecord, "PostFlip", NULL, TRUE);
+
     // Peform extensive checking for OpenGL errors, unless instructed not to do so:
     if (!(PsychPrefStateGet_ConserveVRAM() & kPsychAvoidCPUGPUSync)) {
         glerr = glGetError();
@@ -6553,10 +6964,234 @@ void PsychPostFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
     // Fixup possible low-level framebuffer layout changes caused by commands above this point. Needed from native 10bpc FB support to work reliably.
     PsychFixupNative10BitFramebufferEnableAfterEndOfSceneMarker(windowRecord);
 
+    PsychProfilerEndStage(windowRecord, profileStage);
+
     // Done.
     return;
 }
 
+/* PsychProfilerRetireFrame() - Move oldest in-flight frame of profiler into the result history.
+ *
+ * Reads the results of the GPU timestamp queries of all stages of the frame, if 'readGPU'
+ * is TRUE, otherwise the GPU times of the frame are marked unavailable and stay NaN. The caller must make sure that
+ * all query results are available if 'readGPU' is TRUE, and that the OpenGL context of
+ * the window is bound.
+ */
+static void PsychProfilerRetireFrame(PsychProfiler *profiler, psych_bool readGPU)
+{
+    PsychProfileFrame *frame = &(profiler->inflight[profiler->inflightHead]);
+    GLuint64 tstart, tend;
+    int i;
+
+    for (i = 0; i < frame->numStages; i++) {
+        if (frame->stages[i].gpuState != 2) continue;
+
+        if (readGPU) {
+            glGetQueryObjectui64v(frame->queries[i][0], GL_QUERY_RESULT, &tstart);
+            glGetQueryObjectui64v(frame->queries[i][1], GL_QUERY_RESULT, &tend);
+            frame->stages[i].gpuTime = (double) (tend - tstart) / 1e9;
+        }
+        else {
+            // Mark GPU time of stage as unavailable:
+            frame->stages[i].gpuState = 0;
+        }
+    }
+
+    // Append to history ring, overwriting the oldest frame if the history is full:
+    if (profiler->historyCount == kPsychProfileHistoryLength) {
+        profiler->historyHead = (profiler->historyHead + 1) % kPsychProfileHistoryLength;
+        profiler->historyCount--;
+    }
+    memcpy(&(profiler->history[(profiler->historyHead + profiler->historyCount) % kPsychProfileHistoryLength]), frame, sizeof(PsychProfileFrame));
+    profiler->historyCount++;
+
+    profiler->inflightHead = (profiler->inflightHead + 1) % kPsychProfileFramesInFlight;
+    profiler->inflightCount--;
+}
+
+/* PsychProfilerCollect() - Collect finished frames of the per-stage timing profiler of an onscreen window.
+ *
+ * Moves all finished frames, whose GPU timestamp queries have results available, from the in-flight
+ * ring into the result history, oldest first. Never waits for the GPU. Must be called with
+ * the OpenGL context of the window bound.
+ */
+void PsychProfilerCollect(PsychWindowRecordType *windowRecord)
+{
+    PsychProfiler *profiler = windowRecord->profiler;
+    PsychProfileFrame *frame;
+    GLint available;
+    int i;
+
+    if ((profiler == NULL) || !PsychIsMasterThread()) return;
+
+    while (profiler->inflightCount > 0) {
+        frame = &(profiler->inflight[profiler->inflightHead]);
+
+        // Results of all issued queries of the oldest frame available?
+        available = 1;
+        for (i = 0; (i < frame->numStages) && available; i++) {
+            if (frame->stages[i].gpuState == 2) glGetQueryObjectiv(frame->queries[i][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        }
+
+        // No: Later frames can't be finished either, try again later:
+        if (!available) break;
+
+        PsychProfilerRetireFrame(profiler, TRUE);
+    }
+
+    return;
+}
+
+/* PsychProfilerEnable() - Enable or disable per-stage timing profiler of imaging pipeline and flips.
+ *
+ * When enabled, all hook chain slots, the drawbuffer to inputbuffer multisample resolve or panelfitter
+ * blits, and the Screen('Flip') pre- and postflip operations are timed on the CPU via GetSecs and,
+ * if GL_ARB_timer_query is supported, on the GPU via GL_TIMESTAMP queries. Disabling releases all
+ * resources, including recorded results. Must be called with the OpenGL context of the window bound.
+ */
+void PsychProfilerEnable(PsychWindowRecordType *windowRecord, psych_bool enable)
+{
+    PsychProfiler *profiler = windowRecord->profiler;
+    int i;
+
+    if (enable && (profiler == NULL)) {
+        profiler = (PsychProfiler*) calloc(1, sizeof(PsychProfiler));
+        if (profiler) profiler->history = (PsychProfileFrame*) calloc(kPsychProfileHistoryLength, sizeof(PsychProfileFrame));
+        if ((profiler == NULL) || (profiler->history == NULL)) {
+            free(profiler);
+            PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while trying to enable the pipeline profiler!");
+        }
+
+        profiler->useGPU = (glewIsSupported("GL_ARB_timer_query") && glQueryCounter && glGetQueryObjectui64v) ? TRUE : FALSE;
+        if (profiler->useGPU) {
+            for (i = 0; i < kPsychProfileFramesInFlight; i++) glGenQueries(kPsychMaxProfileStages * 2, &(profiler->inflight[i].queries[0][0]));
+        }
+        else if (PsychPrefStateGet_Verbosity() > 2) {
+            printf("PTB-INFO: Pipeline profiler: GPU timestamp queries unsupported on this platform and GPU. Only CPU times will be measured.\n");
+        }
+
+        windowRecord->profiler = profiler;
+    }
+
+    if (!enable && profiler) {
+        if (profiler->useGPU) {
+            for (i = 0; i < kPsychProfileFramesInFlight; i++) glDeleteQueries(kPsychMaxProfileStages * 2, &(profiler->inflight[i].queries[0][0]));
+        }
+
+        free(profiler->history);
+        free(profiler);
+        windowRecord->profiler = NULL;
+    }
+
+    return;
+}
+
+/* PsychProfilerBeginStage() - Start timing of a named stage of the current frame.
+ *
+ * The stage name is 'name1', or 'name1:name2' if 'name2' is given. GPU timestamps are only
+ * taken if 'gpu' is TRUE, which the caller must only request if the OpenGL context of the
+ * window is bound. Starts a new frame if none is being recorded. Returns the stage handle
+ * for PsychProfilerEndStage(), or -1 if the stage isn't timed, e.g., because profiling is
+ * disabled, the caller is not the master thread, or the frame has too many stages.
+ */
+int PsychProfilerBeginStage(PsychWindowRecordType *windowRecord, const char *name1, const char *name2, psych_bool gpu)
+{
+    PsychProfiler *profiler = windowRecord->profiler;
+    PsychProfileFrame *frame;
+    PsychProfileStage *stage;
+    int stageId;
+
+    if ((profiler == NULL) || !PsychIsMasterThread()) return(-1);
+
+    if (!profiler->frameOpen) {
+        // Need a new frame. If all in-flight frames are still pending on the GPU, retire the oldest
+        // one without its GPU results instead of stalling on them:
+        if (gpu) PsychProfilerCollect(windowRecord);
+        if (profiler->inflightCount == kPsychProfileFramesInFlight) PsychProfilerRetireFrame(profiler, FALSE);
+
+        frame = &(profiler->inflight[(profiler->inflightHead + profiler->inflightCount) % kPsychProfileFramesInFlight]);
+        frame->numStages = 0;
+        frame->flipCount = -1;
+        profiler->depth = 0;
+        profiler->frameOpen = TRUE;
+    }
+    else {
+        frame = &(profiler->inflight[(profiler->inflightHead + profiler->inflightCount) % kPsychProfileFramesInFlight]);
+    }
+
+    if (frame->numStages >= kPsychMaxProfileStages) return(-1);
+
+    stageId = frame->numStages++;
+    stage = &(frame->stages[stageId]);
+    if (name2) {
+        snprintf(stage->name, sizeof(stage->name), "%s:%s", name1, name2);
+    }
+    else {
+        snprintf(stage->name, sizeof(stage->name), "%s", name1);
+    }
+
+    stage->level = profiler->depth++;
+    stage->gpuTime = PsychGetNanValue();
+    stage->gpuState = 0;
+    if (gpu && profiler->useGPU) {
+        glQueryCounter(frame->queries[stageId][0], GL_TIMESTAMP);
+        stage->gpuState = 1;
+    }
+
+    PsychGetAdjustedPrecisionTimerSeconds(&(stage->cpuStart));
+    stage->cpuEnd = stage->cpuStart;
+
+    return(stageId);
+}
+
+/* PsychProfilerEndStage() - Stop timing of stage 'stageId' returned by PsychProfilerBeginStage().
+ *
+ * A no-op for stageId -1. Issues the end GPU timestamp query if the start query was issued.
+ */
+void PsychProfilerEndStage(PsychWindowRecordType *windowRecord, int stageId)
+{
+    PsychProfiler *profiler = windowRecord->profiler;
+    PsychProfileFrame *frame;
+    PsychProfileStage *stage;
+
+    if ((stageId < 0) || (profiler == NULL) || !profiler->frameOpen || !PsychIsMasterThread()) return;
+
+    frame = &(profiler->inflight[(profiler->inflightHead + profiler->inflightCount) % kPsychProfileFramesInFlight]);
+    if (stageId >= frame->numStages) return;
+
+    stage = &(frame->stages[stageId]);
+    PsychGetAdjustedPrecisionTimerSeconds(&(stage->cpuEnd));
+    if (stage->gpuState == 1) {
+        glQueryCounter(frame->queries[stageId][1], GL_TIMESTAMP);
+        stage->gpuState = 2;
+    }
+
+    if (profiler->depth > 0) profiler->depth--;
+
+    return;
+}
+
+/* PsychProfilerFinishFrame() - Finish recording of the current frame after a completed Screen('Flip').
+ *
+ * Queues the frame for collection of its GPU timing results and collects all frames whose
+ * results are available. Must be called with the OpenGL context of the window bound.
+ */
+void PsychProfilerFinishFrame(PsychWindowRecordType *windowRecord)
+{
+    PsychProfiler *profiler = windowRecord->profiler;
+
+    if ((profiler == NULL) || !profiler->frameOpen || !PsychIsMasterThread()) return;
+
+    profiler->inflight[(profiler->inflightHead + profiler->inflightCount) % kPsychProfileFramesInFlight].flipCount = windowRecord->flipCount;
+    profiler->inflightCount++;
+    profiler->frameOpen = FALSE;
+    profiler->depth = 0;
+
+    PsychProfilerCollect(windowRecord);
+
+    return;
+}
+
 PsychWindowRecordType* PsychGetDrawingTarget(void)
 {
     return(currentRendertarget);
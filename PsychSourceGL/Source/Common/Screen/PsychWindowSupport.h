@@ -39,6 +39,11 @@ double  PsychGetMonitorRefreshInterval(PsychWindowRecordType *windowRecord, int*
 void    PsychVisualBell(PsychWindowRecordType *windowRecord, double duration, int belltype);
 void    PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode);
 void    PsychPostFlipOperations(PsychWindowRecordType *windowRecord, int clearmode);
+void    PsychProfilerEnable(PsychWindowRecordType *windowRecord, psych_bool enable);
+int     PsychProfilerBeginStage(PsychWindowRecordType *windowRecord, const char *name1, const char *name2, psych_bool gpu);
+void    PsychProfilerEndStage(PsychWindowRecordType *windowRecord, int stageId);
+void    PsychProfilerFinishFrame(PsychWindowRecordType *windowRecord);
+void    PsychProfilerCollect(PsychWindowRecordType *windowRecord);
 PsychWindowRecordType* PsychGetDrawingTarget(void);
 void    PsychSetDrawingTarget(PsychWindowRecordType *windowRecord);
 void    PsychColdResetDrawingTarget(void);
@@ -51,6 +56,10 @@ void    PsychSwitchFixedFunctionStereoDrawbuffer(PsychWindowRecordType *windowRe
 int     PsychRessourceCheckAndReminder(psych_bool displayMessage);
 psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord);
 void    PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord);
+void    PsychFlipQueueCreate(PsychWindowRecordType *windowRecord, int length);
+psych_uint64 PsychFlipQueueSubmit(PsychWindowRecordType *windowRecord, double flipwhen, int dont_clear, int vbl_synclevel);
+psych_uint64 PsychFlipQueueWaitPresented(PsychWindowRecordType *windowRecord, psych_uint64 count, double maxWaitSecs);
+void    PsychFlipQueueRelease(PsychWindowRecordType *windowRecord);
 int     PsychSetShader(PsychWindowRecordType *windowRecord, int shader);
 void    PsychDetectAndAssignGfxCapabilities(PsychWindowRecordType *windowRecord);
 void    PsychExecuteBufferSwapPrefix(PsychWindowRecordType *windowRecord);
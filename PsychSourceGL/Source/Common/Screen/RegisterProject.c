@@ -198,6 +198,9 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("AsyncFlipEnd", &SCREENFlip));
     PsychErrorExit(PsychRegister("AsyncFlipCheckEnd", &SCREENFlip));
     PsychErrorExit(PsychRegister("WaitUntilAsyncFlipCertain" , &SCREENWaitUntilAsyncFlipCertain));
+    PsychErrorExit(PsychRegister("AsyncFlipQueueCreate", &SCREENAsyncFlipQueue));
+    PsychErrorExit(PsychRegister("AsyncFlipQueue", &SCREENAsyncFlipQueue));
+    PsychErrorExit(PsychRegister("AsyncFlipQueueResults", &SCREENAsyncFlipQueue));
     PsychErrorExit(PsychRegister("FillRect", &SCREENFillRect));
     PsychErrorExit(PsychRegister("GetImage", &SCREENGetImage));
     PsychErrorExit(PsychRegister("PutImage", &SCREENPutImage));
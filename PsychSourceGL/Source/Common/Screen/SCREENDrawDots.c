@@ -156,8 +156,8 @@ PsychError SCREENDrawDots(void)
 {
     PsychWindowRecordType                   *windowRecord, *parentWindowRecord;
     int                                     m,n,p,mc,nc,idot_type;
-    int                                     i, nrpoints, nrsize;
-    psych_bool                              isArgThere, usecolorvector;
+    int                                     i, j, nrpoints, nrsize;
+    psych_bool                              isArgThere, usecolorvector, streamed;
     double                                  *xy, *size, *center, *dot_type, *colors;
     float                                   *sizef;
     unsigned char                           *bytecolors;
@@ -342,20 +342,40 @@ PsychError SCREENDrawDots(void)
     // Apply a global translation of (center(x,y)) pixels to all following points:
     glTranslatef((float) center[0], (float) center[1], 0);
 
+    // Validate individual sizes for each dot, if any, before drawing anything:
+    if ((nrsize > 1) && !lenient) {
+        for (i = 0; i < nrpoints; i++) {
+            if ((sizef && (sizef[i] > pointsizerange[1] || sizef[i] < pointsizerange[0])) ||
+                (!sizef && (size[i] > pointsizerange[1] || size[i] < pointsizerange[0]))) {
+                printf("PTB-ERROR: You requested a point size of %f units, which is not in the range (%f to %f) supported by your graphics hardware.\n",
+                       (sizef) ? sizef[i] : size[i], pointsizerange[0], pointsizerange[1]);
+                PsychErrorExitMsg(PsychError_user, "Unsupported point size requested in Screen('DrawDots').");
+            }
+        }
+    }
+
     // Render the array of 2D-Points - Efficient version:
     // This command sequence allows fast processing of whole arrays
     // of vertices (or points, in this case). It saves the call overhead
     // associated with the original implementation below and is potentially
     // optimized in specific OpenGL implementations.
 
-    // Pass a pointer to the start of the point-coordinate array:
-    glVertexPointer(2, PSYCHGLFLOAT, 0, &xy[0]);
+    // Try to convert all positions, colors and - for the shader based path - sizes
+    // into the streaming VBO in one go. This avoids the driver copying double precision
+    // client-side arrays on each draw call:
+    streamed = (sizef) ? FALSE : PsychSetupStreamingVertexArrays(windowRecord, nrpoints, xy, (usecolorvector) ? mc : 0, colors, bytecolors,
+                                                                  ((nrsize > 1) && usePointSizeArray) ? size : NULL);
+
+    if (!streamed) {
+        // Pass a pointer to the start of the point-coordinate array:
+        glVertexPointer(2, PSYCHGLFLOAT, 0, &xy[0]);
 
-    // Enable fast rendering of arrays:
-    glEnableClientState(GL_VERTEX_ARRAY);
+        // Enable fast rendering of arrays:
+        glEnableClientState(GL_VERTEX_ARRAY);
 
-    if (usecolorvector) {
-        PsychSetupVertexColorArrays(windowRecord, TRUE, mc, colors, bytecolors);
+        if (usecolorvector) {
+            PsychSetupVertexColorArrays(windowRecord, TRUE, mc, colors, bytecolors);
+        }
     }
 
     // Render all n points, starting at point 0, render them as POINTS:
@@ -364,18 +384,10 @@ PsychError SCREENDrawDots(void)
         // path in use. We can use the fast path of only submitting
         // one glDrawArrays call to draw all GL_POINTS. For a single
         // common size, no further setup is needed.
-        if (nrsize > 1) {
+        if ((nrsize > 1) && !streamed) {
             // Individual size for each dot provided. Setup texture unit 2
             // with a 1D texcoord array that stores per point size info in
-            // texture coordinate set 2. But first validate point sizes:
-            for (i = 0; i < nrpoints; i++) {
-                if (!lenient && ((sizef && (sizef[i] > pointsizerange[1] || sizef[i] < pointsizerange[0])) ||
-                    (!sizef && (size[i] > pointsizerange[1] || size[i] < pointsizerange[0])))) {
-                    printf("PTB-ERROR: You requested a point size of %f units, which is not in the range (%f to %f) supported by your graphics hardware.\n",
-                           (sizef) ? sizef[i] : size[i], pointsizerange[0], pointsizerange[1]);
-                    PsychErrorExitMsg(PsychError_user, "Unsupported point size requested in Screen('DrawDots').");
-                }
-            }
+            // texture coordinate set 2.
 
             // Do we need the GL_FLOAT data glTexCoordPointer(1, ...) workaround?
             // See explanation in PsychWindowSupport.c: PsychDetectAndAssignGfxCapabilities():
@@ -396,8 +408,12 @@ PsychError SCREENDrawDots(void)
         // Draw all points:
         glDrawArrays(GL_POINTS, 0, nrpoints);
 
+        // Done with the VBO, back to client-side arrays, before resetting the array pointers:
+        if (streamed) glBindBuffer(GL_ARRAY_BUFFER, 0);
+
         if (nrsize > 1) {
             // Individual size for each dot provided. Reset texture unit 2:
+            glClientActiveTexture(GL_TEXTURE2);
             glTexCoordPointer(1, (sizef) ? GL_FLOAT : GL_DOUBLE, 0, (const GLvoid*) NULL);
             glDisableClientState(GL_TEXTURE_COORD_ARRAY);
 
@@ -407,21 +423,24 @@ PsychError SCREENDrawDots(void)
     }
     else {
         // Different size for each dot provided and we can't use our shader based implementation:
-        // We have to do One GL - call per dot:
-        for (i = 0; i < nrpoints; i++) {
-            if (!lenient && ((sizef && (sizef[i] > pointsizerange[1] || sizef[i] < pointsizerange[0])) ||
-                (!sizef && (size[i] > pointsizerange[1] || size[i] < pointsizerange[0])))) {
-                printf("PTB-ERROR: You requested a point size of %f units, which is not in the range (%f to %f) supported by your graphics hardware.\n",
-                        (sizef) ? sizef[i] : size[i], pointsizerange[0], pointsizerange[1]);
-                PsychErrorExitMsg(PsychError_user, "Unsupported point size requested in Screen('DrawDots').");
+        // We have to do one GL - call per run of consecutive dots with the same size:
+        for (i = 0; i < nrpoints; i = j) {
+            if (sizef) {
+                for (j = i + 1; (j < nrpoints) && (sizef[j] == sizef[i]); j++);
+            }
+            else {
+                for (j = i + 1; (j < nrpoints) && (size[j] == size[i]); j++);
             }
 
-            // Setup point size for this point:
+            // Setup point size for this run of points:
             glPointSize((sizef) ? sizef[i] : (float) size[i]);
 
-            // Render point:
-            glDrawArrays(GL_POINTS, i, 1);
+            // Render points:
+            glDrawArrays(GL_POINTS, i, j - i);
         }
+
+        // Done with the VBO, back to client-side arrays, before resetting the array pointers:
+        if (streamed) glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
     // Disable fast rendering of arrays:
@@ -83,8 +83,8 @@ PsychError SCREENDrawLines(void)
 {
     PsychWindowRecordType       *windowRecord;
     int                         m,n,p, smooth;
-    int                         nrsize, nrvertices, mc, nc, i;
-    psych_bool                  isArgThere, usecolorvector;
+    int                         nrsize, nrvertices, mc, nc, i, j;
+    psych_bool                  isArgThere, usecolorvector, streamed;
     double                      *xy, *size, *center, *dot_type, *colors;
     unsigned char               *bytecolors;
     float                       linesizerange[2];
@@ -198,43 +198,63 @@ PsychError SCREENDrawLines(void)
     // Apply a global translation of (center(x,y)) pixels to all following lines:
     glTranslatef((float) center[0], (float) center[1], (float) 0);
 
+    // Validate individual width for each line, if any, before drawing anything:
+    if ((nrsize > 1) && !lenient) {
+        for (i = 0; i < nrvertices / 2; i++) {
+            if ((sizef && (sizef[i] > linesizerange[1] || sizef[i] < linesizerange[0])) ||
+                (!sizef && (size[i] > linesizerange[1] || size[i] < linesizerange[0]))) {
+                printf("PTB-ERROR: You requested a line width of %f units, which is not in the range (%f to %f) supported by your graphics hardware.\n",
+                       (sizef) ? sizef[i] : size[i], linesizerange[0], linesizerange[1]);
+                PsychErrorExitMsg(PsychError_user, "Unsupported line width requested.");
+            }
+        }
+    }
+
     // Render the array of 2D-Lines - Efficient version:
     // This command sequence allows fast processing of whole arrays
     // of vertices (or lines, in this case). It saves the call overhead
     // associated with the original implementation below and is potentially
     // optimized in specific OpenGL implementations.
 
-    // Pass a pointer to the start of the arrays:
-    glVertexPointer(2, PSYCHGLFLOAT, 0, &xy[0]);
+    // Try to convert all positions and colors into the streaming VBO in one go, otherwise
+    // pass pointers to the start of the client-side arrays:
+    streamed = (sizef) ? FALSE : PsychSetupStreamingVertexArrays(windowRecord, nrvertices, xy, (usecolorvector) ? mc : 0, colors, bytecolors, NULL);
 
-    if (usecolorvector) {
-        PsychSetupVertexColorArrays(windowRecord, TRUE, mc, colors, bytecolors);
-    }
+    if (!streamed) {
+        glVertexPointer(2, PSYCHGLFLOAT, 0, &xy[0]);
 
-    // Enable fast rendering of arrays:
-    glEnableClientState(GL_VERTEX_ARRAY);
+        if (usecolorvector) {
+            PsychSetupVertexColorArrays(windowRecord, TRUE, mc, colors, bytecolors);
+        }
+
+        // Enable fast rendering of arrays:
+        glEnableClientState(GL_VERTEX_ARRAY);
+    }
 
     if (nrsize==1) {
         // Common line-width for all lines: Render all lines, starting at line 0:
         glDrawArrays(GL_LINES, 0, nrvertices);
     }
     else {
-        // Different line-width per line: Need to manually loop through this mess:
-        for (i=0; i < nrvertices/2; i++) {
-            if (!lenient && ((sizef && (sizef[i] > linesizerange[1] || sizef[i] < linesizerange[0])) ||
-                             (!sizef && (size[i] > linesizerange[1] || size[i] < linesizerange[0])))) {
-                printf("PTB-ERROR: You requested a line width of %f units, which is not in the range (%f to %f) supported by your graphics hardware.\n",
-                       (sizef) ? sizef[i] : size[i], linesizerange[0], linesizerange[1]);
-                PsychErrorExitMsg(PsychError_user, "Unsupported line width requested.");
+        // Different line-width per line: Need one call per run of consecutive lines with the same width:
+        for (i = 0; i < nrvertices / 2; i = j) {
+            if (sizef) {
+                for (j = i + 1; (j < nrvertices / 2) && (sizef[j] == sizef[i]); j++);
+            }
+            else {
+                for (j = i + 1; (j < nrvertices / 2) && (size[j] == size[i]); j++);
             }
 
             glLineWidth((sizef) ? sizef[i] : (float) size[i]);
 
-            // Render line:
-            glDrawArrays(GL_LINES, i * 2, 2);
+            // Render lines:
+            glDrawArrays(GL_LINES, i * 2, (j - i) * 2);
         }
     }
 
+    // Done with the VBO, back to client-side arrays, before resetting the array pointers:
+    if (streamed) glBindBuffer(GL_ARRAY_BUFFER, 0);
+
     // Disable fast rendering of arrays:
     glDisableClientState(GL_VERTEX_ARRAY);
     glVertexPointer(2, PSYCHGLFLOAT, 0, NULL);
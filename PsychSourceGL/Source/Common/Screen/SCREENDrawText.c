@@ -64,6 +64,7 @@ void (*PsychPluginSetTextVerbosity)(unsigned int verbosity) = NULL;
 void (*PsychPluginSetTextAntiAliasing)(int context, int antiAliasing) = NULL;
 void (*PsychPluginSetAffineTransformMatrix)(int context, double matrix[2][3]) = NULL;
 void (*PsychPluginGetTextCursor)(int context, double* xp, double* yp, double* height) = NULL;
+int (*PsychPluginGetTextCacheStats)(int context, double* glyphHits, double* glyphMisses, double* layoutHits, double* layoutMisses) = NULL;
 
 // External renderplugins not yet supported on MS-Windows:
 #if PSYCH_SYSTEM != PSYCH_WINDOWS
@@ -1629,6 +1630,7 @@ psych_bool PsychLoadTextRendererPlugin(PsychWindowRecordType* windowRecord)
             PsychPluginSetTextAntiAliasing = dlsym(drawtext_plugin, "PsychSetTextAntiAliasing");
             PsychPluginSetAffineTransformMatrix = dlsym(drawtext_plugin, "PsychSetAffineTransformMatrix");
             PsychPluginGetTextCursor = dlsym(drawtext_plugin, "PsychGetTextCursor");
+            PsychPluginGetTextCacheStats = dlsym(drawtext_plugin, "PsychGetTextCacheStats");
         #else
             PsychPluginInitText = (void*) GetProcAddress(drawtext_plugin, "PsychInitText");
             PsychPluginShutdownText = (void*) GetProcAddress(drawtext_plugin, "PsychShutdownText");
@@ -1646,6 +1648,7 @@ psych_bool PsychLoadTextRendererPlugin(PsychWindowRecordType* windowRecord)
             PsychPluginSetTextAntiAliasing = (void*) GetProcAddress(drawtext_plugin, "PsychSetTextAntiAliasing");
             PsychPluginSetAffineTransformMatrix = (void*) GetProcAddress(drawtext_plugin, "PsychSetAffineTransformMatrix");
             PsychPluginGetTextCursor = (void*) GetProcAddress(drawtext_plugin, "PsychGetTextCursor");
+            PsychPluginGetTextCacheStats = (void*) GetProcAddress(drawtext_plugin, "PsychGetTextCacheStats");
         #endif
 
         // Assign current level of verbosity:
@@ -1731,6 +1734,20 @@ void PsychCleanupTextRenderer(PsychWindowRecordType* windowRecord)
     return;
 }
 
+// Return glyph and layout cache statistics of the drawtext plugin for the onscreen window
+// of 'windowRecord' in stats[0-3]: Glyph cache hits, glyph cache misses, layout cache hits
+// and layout cache misses. Returns FALSE and all zeros if no plugin is loaded, or if the
+// plugin does not keep such statistics:
+psych_bool PsychGetTextRendererCacheStats(PsychWindowRecordType* windowRecord, double* stats)
+{
+    stats[0] = stats[1] = stats[2] = stats[3] = 0;
+
+    if (!drawtext_plugin || !PsychPluginGetTextCacheStats)
+        return(FALSE);
+
+    return((PsychPluginGetTextCacheStats((PsychGetParentWindow(windowRecord))->windowIndex, &stats[0], &stats[1], &stats[2], &stats[3])) ? FALSE : TRUE);
+}
+
 #if PSYCH_SYSTEM == PSYCH_WINDOWS
 // MS-Windows:
 #include <locale.h>
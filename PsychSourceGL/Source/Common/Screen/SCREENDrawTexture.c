@@ -447,6 +447,16 @@ PsychError SCREENDrawTextures(void)
     if (PsychPrefStateGet_Verbosity() > 5)
         printf("PTB-DEBUG: DrawTextures optimized batch submit: %i\n", (int) batchIt);
 
+    // Many different textures without override shader? Try to draw them all at once from a texture atlas:
+    if (isclassic && (numTexs > 1) && (textureShader == -1) &&
+        PsychAtlasBlitTexturesToDisplay(target, numRef, numTexs, texids, numsrcRects, srcRects, numdstRects, dstRects, numAngles, rotationAngles,
+                                        numFilterModes, filterModes, numAlphas, globalAlphas, nc, mc, colors, bytecolors, specialFlags)) {
+        // Mark end of drawing op. This is needed for single buffered drawing:
+        PsychFlushGL(target);
+
+        return(PsychError_none);
+    }
+
     if (batchIt) {
         // Signal start of new batch with numRef drawn textures, all sourced from source and
         // drawn into windo target with filterMode:
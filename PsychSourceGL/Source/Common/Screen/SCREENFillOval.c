@@ -116,6 +116,12 @@ PsychError SCREENFillOval(void)
 	// NULL means - don't want a size's vector.
 	PsychPrepareRenderBatch(windowRecord, -3, &numRects, &xy, 2, &nc, &mc, &colors, &bytecolors, 0, &nrsize, NULL, FALSE);
 
+	// Multiple ovals provided? Try to draw them all with one instanced draw call:
+	if ((numRects > 1) && PsychDrawInstancedShapes(windowRecord, kPsychShapeOval, numRects, xy, nc, mc, colors, bytecolors, 0, NULL, (int) numSlices)) {
+		PsychFlushGL(windowRecord);
+		return(PsychError_none);
+	}
+
 	// Only up to one rect provided?
 	if (numRects <= 1) {
 		// Get the oval and draw it:
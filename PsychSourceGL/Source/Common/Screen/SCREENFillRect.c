@@ -153,16 +153,18 @@ PsychError SCREENFillRect(void)
 	  } else {
 	    // Partial fill: Draw provided rects:
 		if (numRects>1) {
-			// Multiple rects provided: Draw the whole batch:
-			for (i=0; i<numRects; i++) {
-				// Per rect color provided?
-				if (nc>1) {
-					// Yes. Set color for this specific rect:
-					PsychSetArrayColor(windowRecord, i, mc, colors, bytecolors);
+			// Multiple rects provided: Draw the whole batch, with one instanced draw call if possible:
+			if (!PsychDrawInstancedShapes(windowRecord, kPsychShapeRect, numRects, xy, nc, mc, colors, bytecolors, 0, NULL, 0)) {
+				for (i=0; i<numRects; i++) {
+					// Per rect color provided?
+					if (nc>1) {
+						// Yes. Set color for this specific rect:
+						PsychSetArrayColor(windowRecord, i, mc, colors, bytecolors);
+					}
+
+					// Submit rect for drawing:
+					if (!IsPsychRectEmpty(rect)) PsychGLRect(&(xy[i*4]));
 				}
-				
-				// Submit rect for drawing:
-				if (!IsPsychRectEmpty(rect)) PsychGLRect(&(xy[i*4]));
 			}
 		}
 		else {
@@ -183,6 +183,8 @@ PsychError SCREENFlip(void)
     double time_at_onset;
     unsigned int opmode;
     psych_bool flipstate;
+    psych_uint64 frameId;
+    PsychFlipQueueResult *result;
 
     // Change our "personality" depending on the name with which we were called:
     if (PsychMatch(PsychGetFunctionName(), "AsyncFlipBegin")) {
@@ -296,6 +298,24 @@ PsychError SCREENFlip(void)
             PsychErrorExitMsg(PsychError_user, "\nYou specified a 'when' value to Flip that's over 1000 seconds in the future?!? Aborting, assuming that's an error.\n\n");
         }
 
+        // Flip queue active? Then submit the frame to the queue, wait for its presentation and return its results:
+        if (windowRecord->flipQueue) {
+            if ((opmode != 0) || (multiflip != 0))
+                PsychErrorExitMsg(PsychError_user, "Only Screen('Flip') without 'multiflip' is allowed on windows with a flip queue. Use Screen('AsyncFlipQueue') for asynchronous flips.");
+
+            frameId = PsychFlipQueueSubmit(windowRecord, flipwhen, dont_clear, vbl_synclevel);
+            PsychFlipQueueWaitPresented(windowRecord, frameId + 1, DBL_MAX);
+            result = &(windowRecord->flipQueue->results[frameId % kPsychFlipQueueResultsLength]);
+
+            PsychCopyOutDoubleArg(1, FALSE, result->vbl_timestamp);
+            PsychCopyOutDoubleArg(2, FALSE, result->time_at_onset);
+            PsychCopyOutDoubleArg(3, FALSE, result->time_at_flipend);
+            PsychCopyOutDoubleArg(4, FALSE, result->miss_estimate);
+            PsychCopyOutDoubleArg(5, FALSE, (double) result->beamPosAtFlip);
+
+            return(PsychError_none);
+        }
+
         // Pack all parameters of the fliprequest into the flipinfo struct:
         // At least our part of the struct. Initial setup of threds and locks etc. is done by the actual
         // PsychFlipWindowBuffersIndirect() routine:
@@ -442,6 +462,176 @@ PsychError SCREENFlip(void)
     return(PsychError_none);
 }
 
+// SCREENAsyncFlipQueue implements Screen('AsyncFlipQueueCreate'), Screen('AsyncFlipQueue') and Screen('AsyncFlipQueueResults'):
+PsychError SCREENAsyncFlipQueue(void)
+{
+    // If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
+    static char useString0[] = "queueLength = Screen('AsyncFlipQueueCreate', windowPtr [, queueLength=3]);";
+    static char synopsisString0[] =
+    "Create a flip queue for pipelined presentation of pre-rendered frames on onscreen window \"windowPtr\".\n"
+    "A flip queue allows to render up to \"queueLength\" frames ahead of their presentation, e.g., for "
+    "stimuli whose rendering time varies a lot from frame to frame, but where each frame must be shown at "
+    "a precise time. Each frame is submitted with its own requested onset time via Screen('AsyncFlipQueue'), "
+    "then immediately returns control to your code, so you can draw the next frame. A background thread "
+    "presents the submitted frames in order, each at its requested onset time, and records their flip "
+    "timestamps, which you can collect later in bulk via Screen('AsyncFlipQueueResults').\n"
+    "\"queueLength\" must be between 1 and 16 and defaults to 3. Each queued frame needs one framebuffer "
+    "of the size of the window in video memory. The queue length is returned.\n"
+    "Flip queues need the Psychtoolbox imaging pipeline, e.g., enabled via PsychImaging('AddTask', 'General', "
+    "'UseVirtualFramebuffer'), and they can not be used with dual-stream stereo or output modes, our own "
+    "VRR scheduler, special display backends like Vulkan or VR displays, or on windows which already used "
+    "Screen('AsyncFlipBegin'). The queue exists until the window is closed. Screen('AsyncFlipBegin') is not "
+    "allowed on the window while it has a flip queue, and Screen('Flip') submits the frame to the queue, waits "
+    "for its presentation and returns its results, as usual. Gamma table updates and other operations which "
+    "Screen('Flip') would execute at stimulus onset are executed at submission of a frame instead.\n";
+
+    static char useString1[] = "[frameIndex, numPresented] = Screen('AsyncFlipQueue', windowPtr [, when=0] [, dontclear=0] [, dontsync=0]);";
+    static char synopsisString1[] =
+    "Submit the current frame of onscreen window \"windowPtr\" to its flip queue (see Screen AsyncFlipQueueCreate? for help).\n"
+    "Finishes the current frame, queues it for presentation at the first video retrace after system time \"when\", "
+    "or at the next possible retrace for the default \"when\" of zero, then returns immediately, so you can draw "
+    "the next frame. If the queue is full, it waits for presentation of the oldest queued frame first. For the "
+    "meaning of \"when\", \"dontclear\" and \"dontsync\" see the help for 'Screen Flip?'.\n"
+    "Returns the one-based index \"frameIndex\" of the submitted frame, and the number of frames presented so "
+    "far \"numPresented\".\n";
+
+    static char useString2[] = "[results, numPending] = Screen('AsyncFlipQueueResults', windowPtr [, waitForAll=0]);";
+    static char synopsisString2[] =
+    "Return the flip results of all frames presented from the flip queue of onscreen window \"windowPtr\" since "
+    "the last call (see Screen AsyncFlipQueueCreate? for help).\n"
+    "If \"waitForAll\" is set to 1, waits for presentation of all submitted frames first.\n"
+    "The results are returned in the struct \"results\", which has the fields 'FrameIndex', 'When', 'VBLTimestamp', "
+    "'StimulusOnsetTime', 'FlipTimestamp', 'Missed' and 'Beampos'. Each field is a column vector with one row "
+    "per presented frame, in order of presentation. 'FrameIndex' is the \"frameIndex\" returned by "
+    "Screen('AsyncFlipQueue') for the frame, 'When' its requested onset time, all other fields have the same "
+    "meaning as the corresponding return values of 'Screen Flip?'. Results of roughly the most recent 1000 presented "
+    "frames are kept, so results of older frames are lost if you don't collect them often enough.\n"
+    "The number of submitted frames still waiting for presentation is returned in \"numPending\".\n";
+
+    static char seeAlsoString[] = "AsyncFlipQueueCreate AsyncFlipQueue AsyncFlipQueueResults Flip";
+
+    PsychWindowRecordType *windowRecord;
+    PsychFlipQueue *queue;
+    PsychFlipQueueResult *result;
+    PsychGenericScriptType *results, *outMat[7];
+    const char *FieldNames[] = { "FrameIndex", "When", "VBLTimestamp", "StimulusOnsetTime", "FlipTimestamp", "Missed", "Beampos" };
+    double *v[7];
+    double flipwhen, tNow;
+    psych_uint64 frameId, presented, first;
+    int queueLength, dont_clear, vbl_synclevel, waitForAll, count, i, j;
+    unsigned int opmode;
+
+    // Change our "personality" depending on the name with which we were called:
+    if (PsychMatch(PsychGetFunctionName(), "AsyncFlipQueueCreate")) {
+        opmode = 0;
+        PsychPushHelp(useString0, synopsisString0, seeAlsoString);
+    }
+    else if (PsychMatch(PsychGetFunctionName(), "AsyncFlipQueue")) {
+        opmode = 1;
+        PsychPushHelp(useString1, synopsisString1, seeAlsoString);
+    }
+    else {
+        opmode = 2;
+        PsychPushHelp(useString2, synopsisString2, seeAlsoString);
+    }
+
+    // Give online help, if requested:
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs((opmode == 1) ? 4 : 2));        // The maximum number of inputs
+    PsychErrorExit(PsychRequireNumInputArgs(1));                        // The required number of inputs
+    PsychErrorExit(PsychCapNumOutputArgs(2));                           // The maximum number of outputs
+
+    // Get the window record from the window record argument and get info from the window record
+    PsychAllocInWindowRecordArg(kPsychUseDefaultArgPosition, TRUE, &windowRecord);
+
+    if (!PsychIsOnscreenWindow(windowRecord) || (windowRecord->windowType != kPsychDoubleBufferOnscreen))
+        PsychErrorExitMsg(PsychError_user, "Flip queues are only supported on double-buffered onscreen windows.");
+
+    if (opmode == 0) {
+        queueLength = 3;
+        PsychCopyInIntegerArg(2, FALSE, &queueLength);
+        if ((queueLength < 1) || (queueLength > kPsychMaxFlipQueueLength)) {
+            printf("PTB-ERROR: Invalid 'queueLength' %i specified. Must be between 1 and %i.\n", queueLength, kPsychMaxFlipQueueLength);
+            PsychErrorExitMsg(PsychError_user, "Invalid 'queueLength' specified.");
+        }
+
+        PsychFlipQueueCreate(windowRecord, queueLength);
+        PsychCopyOutDoubleArg(1, FALSE, (double) queueLength);
+
+        return(PsychError_none);
+    }
+
+    queue = windowRecord->flipQueue;
+    if (NULL == queue)
+        PsychErrorExitMsg(PsychError_user, "This window does not have a flip queue. Create one first via Screen('AsyncFlipQueueCreate').");
+
+    if (opmode == 1) {
+        // Same parameters and defaults as for Screen('Flip'):
+        dont_clear = 0;
+        PsychCopyInIntegerArg(3, FALSE, &dont_clear);
+        if (dont_clear < 0 || dont_clear > 2)
+            PsychErrorExitMsg(PsychError_user, "Only 'dontclear' values 0 (== clear after flip), 1 (== don't clear) and 2 (== don't do anything) are supported");
+
+        vbl_synclevel = 0;
+        PsychCopyInIntegerArg(4, FALSE, &vbl_synclevel);
+        if (vbl_synclevel < 0 || vbl_synclevel > 2)
+            PsychErrorExitMsg(PsychError_user, "Only 'dontsync' values 0 (== fully synchronize with VBL), 1 (== don't wait for VBL) and 2 (== Ignore VBL) are supported");
+
+        flipwhen = 0;
+        PsychCopyInDoubleArg(2, FALSE, &flipwhen);
+        if (flipwhen < 0)
+            PsychErrorExitMsg(PsychError_user, "Only 'when' values greater or equal to 0 are supported");
+
+        PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+        if (flipwhen - tNow > 1000)
+            PsychErrorExitMsg(PsychError_user, "\nYou specified a 'when' value that's over 1000 seconds in the future?!? Aborting, assuming that's an error.\n\n");
+
+        frameId = PsychFlipQueueSubmit(windowRecord, flipwhen, dont_clear, vbl_synclevel);
+        presented = PsychFlipQueueWaitPresented(windowRecord, 0, 0);
+
+        PsychCopyOutDoubleArg(1, FALSE, (double) (frameId + 1));
+        PsychCopyOutDoubleArg(2, FALSE, (double) presented);
+
+        return(PsychError_none);
+    }
+
+    waitForAll = 0;
+    PsychCopyInIntegerArg(2, FALSE, &waitForAll);
+    presented = PsychFlipQueueWaitPresented(windowRecord, (waitForAll) ? queue->submitted : 0, (waitForAll) ? DBL_MAX : 0);
+
+    // The flipper thread can present at most queue->length more frames while we copy out results,
+    // so only results which it can't overwrite during that time are safe to return:
+    first = queue->retrieved;
+    if (presented - first > (psych_uint64) (kPsychFlipQueueResultsLength - queue->length))
+        first = presented - (kPsychFlipQueueResultsLength - queue->length);
+
+    count = (int) (presented - first);
+    for (j = 0; j < 7; j++)
+        PsychAllocateNativeDoubleMat(count, 1, 1, &v[j], &outMat[j]);
+
+    for (i = 0; i < count; i++) {
+        result = &(queue->results[(first + i) % kPsychFlipQueueResultsLength]);
+        v[0][i] = (double) (first + i + 1);
+        v[1][i] = result->flipwhen;
+        v[2][i] = result->vbl_timestamp;
+        v[3][i] = result->time_at_onset;
+        v[4][i] = result->time_at_flipend;
+        v[5][i] = result->miss_estimate;
+        v[6][i] = (double) result->beamPosAtFlip;
+    }
+
+    queue->retrieved = presented;
+
+    PsychAllocOutStructArray(1, kPsychArgOptional, -1, 7, FieldNames, &results);
+    for (j = 0; j < 7; j++)
+        PsychSetStructArrayNativeElement(FieldNames[j], 0, outMat[j], results);
+
+    PsychCopyOutDoubleArg(2, FALSE, (double) (queue->submitted - presented));
+
+    return(PsychError_none);
+}
+
 PsychError SCREENWaitUntilAsyncFlipCertain(void)
 {
     // If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
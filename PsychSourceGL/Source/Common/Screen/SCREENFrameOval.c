@@ -105,6 +105,12 @@ PsychError SCREENFrameOval(void)
     PsychPrepareRenderBatch(windowRecord, -3, &numRects, &xy, 2, &nc, &mc, &colors, &bytecolors, 4, &nrsize, &penSizes, FALSE);
     isclassic = PsychIsGLClassic(windowRecord);
 
+    // Multiple ovals provided? Try to draw them all with one instanced draw call:
+    if ((numRects > 1) && PsychDrawInstancedShapes(windowRecord, kPsychShapeOval, numRects, xy, nc, mc, colors, bytecolors, nrsize, penSizes, 0)) {
+        PsychFlushGL(windowRecord);
+        return(PsychError_none);
+    }
+
     // Only up to one rect provided?
     if (numRects <= 1) {
         // Get the oval and draw it:
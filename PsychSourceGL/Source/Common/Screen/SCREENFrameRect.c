@@ -90,6 +90,12 @@ PsychError SCREENFrameRect(void)
 		numRects = 1;
 	}
 
+	// Multiple rects provided and new style rendering? Try to draw them all with one instanced draw call:
+	if ((numRects > 1) && (lf == -1) && PsychDrawInstancedShapes(windowRecord, kPsychShapeRect, numRects, xy, nc, mc, colors, bytecolors, nrsize, penSizes, 0)) {
+		PsychFlushGL(windowRecord);
+		return(PsychError_none);
+	}
+
 	// Pen size starts as "undefined", just to make sure it gets initially set:
 	penSize = -DBL_MAX;
 	
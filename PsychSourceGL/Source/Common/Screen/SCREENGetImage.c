@@ -21,8 +21,8 @@
 #include "Screen.h"
 
 // If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
-static char useString[] =  "imageArray=Screen('GetImage', windowPtr [,rect] [,bufferName] [,floatprecision=0] [,nrchannels=3])";
-//                                                        1           2       3             4                   5
+static char useString[] =  "imageArray=Screen('GetImage', windowPtr [,rect] [,bufferName] [,floatprecision=0] [,nrchannels=3] [,async=0])";
+//                                                        1           2       3             4                   5               6
 
 static char synopsisString[] =
 "Slowly copy an image from a window or texture to Matlab/Octave, by default returning a uint8 array.\n\n"
@@ -79,7 +79,25 @@ static char synopsisString[] =
 "framebuffers do support 'floatprecision' readback.\n"
 "\"nrchannels\" Number of color channels to return. By default, 3 channels (RGB) are "
 "returned. Specify 1 for Red/Luminance only, 2 for Red+Green or Luminance+Alpha, 3 for "
-"RGB and 4 for RGBA. A setting of 2 is not supported on OpenGL-ES hardware. \n\n";
+"RGB and 4 for RGBA. A setting of 2 is not supported on OpenGL-ES hardware. \n\n"
+"\"async\" Optional asynchronous readback mode, only for onscreen windows. The default "
+"setting 0 returns the image immediately, which stalls execution until the graphics card "
+"has finished all pending drawing and the readback. A setting of 1 only starts the readback "
+"of the image into one of up to 8 pixel buffers on the graphics card. Then the function "
+"returns the image of the oldest pending asynchronous readback if that one has finished, "
+"or an empty matrix otherwise. If all 8 pixel buffers are pending, it waits for the oldest "
+"readback to finish and returns its image. A setting of 2 does not start a readback, but "
+"waits for the oldest pending readback to finish and returns its image, or returns an empty "
+"matrix if no readbacks are pending. Images are always returned in the order in which their "
+"readbacks were started, with the 'rect', 'floatprecision' and 'nrchannels' settings of the "
+"call which started them. E.g., to record all frames of a stimulus, call 'GetImage' with "
+"async=1 after each Screen('Flip'), keep all non-empty returned images, and after the last "
+"frame call it with async=2 until it returns an empty matrix. Pending readbacks are discarded "
+"when the window gets closed. If the graphics hardware does not support asynchronous readback, "
+"e.g., on OpenGL-ES, each call with async=1 returns its own image immediately.\n\n"
+"Under Python, the image is returned as a NumPy array in C row-major memory order, which "
+"avoids the costly transposition of the image data needed for Matlab/Octave column-major "
+"order.\n\n";
 
 static char useString2[] = "Screen('AddFrameToMovie', windowPtr [,rect] [,bufferName] [,moviePtr=0] [,frameduration=1])";
 //                                                    1           2       3             4             5
@@ -144,6 +162,206 @@ static char synopsisString2[] =
 
 static char seeAlsoString[] = "PutImage CopyWindow CreateMovie FinalizeMovie";
 
+// Edge length in pixels of the tiles of an image which get transposed from glReadPixels() row-major
+// order to column-major order at once. This keeps both the source rows and the destination columns
+// of a tile in the cpu caches:
+#define kPsychReadbackTileSize 64
+
+/* PsychCopyOutReadbackImage()
+ *
+ * Return an image of 'width' x 'height' pixels with 'stride' color channels per pixel, as read back
+ * by glReadPixels() into 'pixels' as uint8 or float values, as uint8 or double image matrix with
+ * 'nrchannels' channels in return argument 1. glReadPixels() returns the rows of the image bottom-up,
+ * so they get flipped. For Matlab/Octave column-major order the image also gets transposed, tile by
+ * tile, one color channel after the other, so the innermost loops write consecutive destination
+ * values without any index computations. For C row-major order ('c_layout') no transpose is needed,
+ * and whole rows get copied at once.
+ */
+static void PsychCopyOutReadbackImage(const void* pixels, psych_bool floatprecision, size_t width, size_t height, int nrchannels, int stride, psych_bool c_layout)
+{
+    const psych_uint8   *src8 = (const psych_uint8*) pixels;
+    const float         *srcf = (const float*) pixels;
+    psych_uint8         *dst8 = NULL;
+    double              *dstd = NULL;
+    size_t              x, y, x0, y0, x1, y1, i, o, rowLength, srcRowLength;
+    int                 c;
+
+    if (floatprecision)
+        PsychAllocOutDoubleMatArg(1, TRUE, (int) height, (int) width, (int) nrchannels, &dstd);
+    else
+        PsychAllocOutUnsignedByteMatArg(1, TRUE, (int) height, (int) width, (int) nrchannels, &dst8);
+
+    rowLength = width * (size_t) nrchannels;
+    srcRowLength = width * (size_t) stride;
+
+    if (c_layout) {
+        // Row-major order: Only flip the rows.
+        for (y = 0; y < height; y++) {
+            i = (height - 1 - y) * srcRowLength;
+            o = y * rowLength;
+
+            if (floatprecision) {
+                if (stride == nrchannels) {
+                    for (x = 0; x < rowLength; x++) dstd[o + x] = (double) srcf[i + x];
+                }
+                else {
+                    for (x = 0; x < width; x++, i += stride)
+                        for (c = 0; c < nrchannels; c++) dstd[o++] = (double) srcf[i + c];
+                }
+            }
+            else {
+                if (stride == nrchannels) {
+                    memcpy(dst8 + o, src8 + i, rowLength);
+                }
+                else {
+                    for (x = 0; x < width; x++, i += stride)
+                        for (c = 0; c < nrchannels; c++) dst8[o++] = src8[i + c];
+                }
+            }
+        }
+
+        return;
+    }
+
+    // Column-major order: Transpose and flip. Pixel (x, y) of the returned image is pixel
+    // (x, height - 1 - y) of the readback image:
+    for (x0 = 0; x0 < width; x0 += kPsychReadbackTileSize) {
+        x1 = (x0 + kPsychReadbackTileSize < width) ? x0 + kPsychReadbackTileSize : width;
+        for (y0 = 0; y0 < height; y0 += kPsychReadbackTileSize) {
+            y1 = (y0 + kPsychReadbackTileSize < height) ? y0 + kPsychReadbackTileSize : height;
+            for (c = 0; c < nrchannels; c++) {
+                for (x = x0; x < x1; x++) {
+                    i = (height - 1 - y0) * srcRowLength + x * (size_t) stride + (size_t) c;
+                    o = ((size_t) c * width + x) * height;
+
+                    if (floatprecision) {
+                        for (y = y0; y < y1; y++, i -= srcRowLength) dstd[o + y] = (double) srcf[i];
+                    }
+                    else {
+                        for (y = y0; y < y1; y++, i -= srcRowLength) dst8[o + y] = src8[i];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* PsychIsAsyncReadbackSupported()
+ *
+ * Asynchronous readback needs pixel buffer objects, fences and buffer range mapping.
+ * OpenGL-ES is not supported.
+ */
+static psych_bool PsychIsAsyncReadbackSupported(PsychWindowRecordType *windowRecord)
+{
+    return(!PsychIsGLES(windowRecord) && (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object) &&
+           (GLEW_VERSION_3_2 || GLEW_ARB_sync) && (GLEW_VERSION_3_0 || GLEW_ARB_map_buffer_range));
+}
+
+/* PsychStartAsyncReadback()
+ *
+ * Start glReadPixels() of the image of 'width' x 'height' pixels at 'x', 'y' in the current read
+ * buffer into the next free pixel pack buffer in the ring of onscreen window 'windowRecord', which
+ * must have a free slot. A fence gets inserted after the readback, so PsychFinishAsyncReadback()
+ * can check for its completion without stalling.
+ */
+static void PsychStartAsyncReadback(PsychWindowRecordType *windowRecord, int x, int y, int width, int height, GLenum format,
+                                    int nrchannels, int stride, psych_bool floatprecision)
+{
+    PsychAsyncReadback *slot = &windowRecord->asyncReadbacks[(windowRecord->asyncReadbackHead + windowRecord->asyncReadbackCount) % PSYCH_MAX_ASYNC_READBACKS];
+    size_t size = (size_t) width * (size_t) height * (size_t) stride * ((floatprecision) ? sizeof(float) : sizeof(psych_uint8));
+
+    while (glGetError());
+
+    if (0 == slot->pbo) glGenBuffers(1, &slot->pbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+
+    // Need a bigger buffer?
+    if (size > slot->size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        slot->size = size;
+    }
+
+    glReadPixels(x, y, width, height, format, (floatprecision) ? GL_FLOAT : GL_UNSIGNED_BYTE, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (glGetError() != GL_NO_ERROR) {
+        glDeleteBuffers(1, &slot->pbo);
+        slot->pbo = 0;
+        slot->size = 0;
+        printf("PTB-ERROR: Failed to start asynchronous readback of %i x %i pixels into a pixel buffer of %i KB.\n", width, height, (int) (size / 1024));
+        PsychErrorExitMsg(PsychError_outofMemory, "Asynchronous 'GetImage' failed, maybe out of graphics memory?");
+    }
+
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot->width = width;
+    slot->height = height;
+    slot->nrchannels = nrchannels;
+    slot->stride = stride;
+    slot->floatprecision = floatprecision;
+    windowRecord->asyncReadbackCount++;
+}
+
+/* PsychFinishAsyncReadback()
+ *
+ * Return the image of the oldest pending asynchronous readback of onscreen window 'windowRecord'
+ * in return argument 1, and release its slot in the ring. If 'wait' is FALSE and the gpu has not
+ * finished that readback yet, nothing happens.
+ *
+ * Returns TRUE if an image was returned, FALSE if no readback was pending or finished.
+ */
+static psych_bool PsychFinishAsyncReadback(PsychWindowRecordType *windowRecord, psych_bool wait, psych_bool c_layout)
+{
+    PsychAsyncReadback *slot = &windowRecord->asyncReadbacks[windowRecord->asyncReadbackHead];
+    const void *pixels;
+
+    if (windowRecord->asyncReadbackCount == 0)
+        return(FALSE);
+
+    // Poll the fence. This also flushes the pipeline, so the readback will start soon if it didn't already.
+    // Mapping the buffer below implicitly waits for readback completion, so no need to wait on the fence:
+    if (!wait && (glClientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED))
+        return(FALSE);
+
+    glDeleteSync(slot->fence);
+    slot->fence = NULL;
+    windowRecord->asyncReadbackHead = (windowRecord->asyncReadbackHead + 1) % PSYCH_MAX_ASYNC_READBACKS;
+    windowRecord->asyncReadbackCount--;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+    pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (size_t) slot->width * (size_t) slot->height * (size_t) slot->stride *
+                              ((slot->floatprecision) ? sizeof(float) : sizeof(psych_uint8)), GL_MAP_READ_BIT);
+    if (NULL == pixels) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        PsychErrorExitMsg(PsychError_system, "Failed to map pixel buffer of asynchronous 'GetImage' readback.");
+    }
+
+    PsychCopyOutReadbackImage(pixels, slot->floatprecision, (size_t) slot->width, (size_t) slot->height, slot->nrchannels, slot->stride, c_layout);
+
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    return(TRUE);
+}
+
+/* PsychDeleteAsyncReadbacks()
+ *
+ * Release the ring of pixel pack buffers for asynchronous 'GetImage' of onscreen window
+ * 'windowRecord', discarding all pending readbacks. Its OpenGL context must be bound.
+ */
+void PsychDeleteAsyncReadbacks(PsychWindowRecordType *windowRecord)
+{
+    int i;
+
+    for (i = 0; i < PSYCH_MAX_ASYNC_READBACKS; i++) {
+        if (windowRecord->asyncReadbacks[i].fence) glDeleteSync(windowRecord->asyncReadbacks[i].fence);
+        if (windowRecord->asyncReadbacks[i].pbo) glDeleteBuffers(1, &windowRecord->asyncReadbacks[i].pbo);
+    }
+
+    memset(windowRecord->asyncReadbacks, 0, sizeof(windowRecord->asyncReadbacks));
+    windowRecord->asyncReadbackHead = 0;
+    windowRecord->asyncReadbackCount = 0;
+}
+
 // This also works as 'AddFrameToMovie', as almost all code is shared with 'GetImage'.
 // Only difference is where the fetched pixeldata is sent: To the movie encoder or to
 // a matlab/octave matrix.
@@ -151,10 +369,9 @@ PsychError SCREENGetImage(void)
 {
     PsychRectType   windowRect, sampleRect;
     int             nrchannels, invertedY, stride;
-    size_t          ix, iy, sampleRectWidth, sampleRectHeight, redReturnIndex, greenReturnIndex, blueReturnIndex, alphaReturnIndex;
+    size_t          sampleRectWidth, sampleRectHeight;
     int             viewid = 0;
-    psych_uint8     *returnArrayBase, *redPlane;
-    float           *dredPlane;
+    void            *readbackPixels;
     double          *returnArrayBaseDouble;
     PsychWindowRecordType *windowRecord;
     GLboolean       isDoubleBuffer, isStereo;
@@ -168,6 +385,10 @@ PsychError SCREENGetImage(void)
     psych_bool      isOES;
     psych_bool      readFromfinalizedFBO = FALSE;
     PsychFBO*       resolveFBO = NULL;
+    int             asyncMode = 0;
+    psych_bool      asyncReturned = FALSE;
+    GLenum          format;
+    psych_bool      c_layout;
 
     // Called as 2nd personality "AddFrameToMovie" ?
     psych_bool isAddMovieFrame = PsychMatch(PsychGetFunctionName(), "AddFrameToMovie");
@@ -183,9 +404,12 @@ PsychError SCREENGetImage(void)
     if(PsychIsGiveHelp()){PsychGiveHelp();return(PsychError_none);};
 
     //cap the numbers of inputs and outputs
-    PsychErrorExit(PsychCapNumInputArgs(5));   //The maximum number of inputs
+    PsychErrorExit(PsychCapNumInputArgs((isAddMovieFrame) ? 5 : 6));   //The maximum number of inputs
     PsychErrorExit(PsychCapNumOutputArgs(1));  //The maximum number of outputs
 
+    // Return images in C row-major order to Python/NumPy, as that needs no transpose:
+    c_layout = PsychUseCMemoryLayoutIfOptimal(TRUE);
+
     // Get windowRecord for this window:
     PsychAllocInWindowRecordArg(kPsychUseDefaultArgPosition, TRUE, &windowRecord);
 
@@ -207,6 +431,22 @@ PsychError SCREENGetImage(void)
         PsychErrorExitMsg(PsychError_user, "Calling this function on an onscreen window with a pending asynchronous flip is not allowed!");
     }
 
+    // Get optional asynchronous readback mode:
+    if (!isAddMovieFrame) {
+        PsychCopyInIntegerArg(6, FALSE, &asyncMode);
+        if (asyncMode < 0 || asyncMode > 2) PsychErrorExitMsg(PsychError_user, "Invalid 'async' mode provided. Must be 0, 1 or 2!");
+        if (asyncMode && !PsychIsOnscreenWindow(windowRecord)) PsychErrorExitMsg(PsychError_user, "Asynchronous readback via 'async' is only supported for onscreen windows!");
+
+        // Only retrieval of the image of the oldest pending readback requested?
+        if (asyncMode == 2) {
+            PsychSetGLContext(windowRecord);
+            if (!PsychFinishAsyncReadback(windowRecord, TRUE, c_layout))
+                PsychAllocOutDoubleMatArg(1, FALSE, 0, 0, 0, &returnArrayBaseDouble);
+
+            return(PsychError_none);
+        }
+    }
+
     // Set window as drawingtarget: Even important if this binding is changed later on!
     // We need to make sure all needed transitions are done - esp. in non-imaging mode,
     // so backbuffer is in a useable state:
@@ -495,110 +735,45 @@ PsychError SCREENGetImage(void)
         PsychCopyInIntegerArg(5, FALSE, &nrchannels);
         if (nrchannels < 1 || nrchannels > 4) PsychErrorExitMsg(PsychError_user, "Number of requested channels 'nrchannels' must be between 1 and 4!");
 
-        if (!floatprecision) {
-            // Readback of standard 8bpc uint8 pixels:
-
-            // No Luminance + Alpha on OES:
-            if (isOES && (nrchannels == 2)) PsychErrorExitMsg(PsychError_user, "Number of requested channels 'nrchannels' == 2 not supported on OpenGL-ES!");
-
-            PsychAllocOutUnsignedByteMatArg(1, TRUE, (int) sampleRectHeight, (int) sampleRectWidth, (int) nrchannels, &returnArrayBase);
-            if (isOES) {
-                // We only do RGBA reads on OES, then discard unwanted stuff ourselves:
-                redPlane  = (psych_uint8*) PsychMallocTemp((size_t) 4 * sampleRectWidth * sampleRectHeight);
-            }
-            else {
-                redPlane  = (psych_uint8*) PsychMallocTemp((size_t) nrchannels * sampleRectWidth * sampleRectHeight);
-            }
-
-            glPixelStorei(GL_PACK_ALIGNMENT,1);
-            invertedY = (int) (windowRect[kPsychBottom] - sampleRect[kPsychBottom]);
+        // No Luminance + Alpha on OES:
+        if (isOES && (nrchannels == 2)) PsychErrorExitMsg(PsychError_user, "Number of requested channels 'nrchannels' == 2 not supported on OpenGL-ES!");
 
-            if (isOES) {
-                glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGBA, GL_UNSIGNED_BYTE, redPlane);
-                stride = 4;
-            }
-            else {
-                stride = nrchannels;
-                if (nrchannels==1) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RED, GL_UNSIGNED_BYTE, redPlane);
-                if (nrchannels==2) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, redPlane);
-                if (nrchannels==3) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGB, GL_UNSIGNED_BYTE, redPlane);
-                if (nrchannels==4) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGBA, GL_UNSIGNED_BYTE, redPlane);
-            }
+        // Only float readback on floating point FBO's with EXT_color_buffer_float support:
+        if (floatprecision && isOES && ((whichBuffer != GL_COLOR_ATTACHMENT0_EXT) || (windowRecord->bpc < 16) || !glewIsSupported("GL_EXT_color_buffer_float"))) {
+            printf("PTB-ERROR: Tried to 'GetImage' pixels in floating point format from a non-floating point surface, or not supported by your hardware.\n");
+            PsychErrorExitMsg(PsychError_user, "'GetImage' of floating point values from given object not supported on OpenGL-ES!");
+        }
 
-            //in one pass transpose and flip what we read with glReadPixels before returning.
-            //-glReadPixels insists on filling up memory in sequence by reading the screen row-wise whearas Matlab reads up memory into columns.
-            //-the Psychtoolbox screen as setup by gluOrtho puts 0,0 at the top left of the window but glReadPixels always believes that it's at the bottom left.
-            for(ix=0; ix < sampleRectWidth; ix++){
-                for(iy=0; iy < sampleRectHeight; iy++){
-                    // Compute write-indices for returned data:
-                    redReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth, nrchannels, iy, ix, 0);
-                    greenReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 1);
-                    blueReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 2);
-                    alphaReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 3);
-
-                    // Always return RED/LUMINANCE channel:
-                    returnArrayBase[redReturnIndex] = redPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 0];
-                    // Other channels on demand:
-                    if (nrchannels>1) returnArrayBase[greenReturnIndex] = redPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 1];
-                    if (nrchannels>2) returnArrayBase[blueReturnIndex]  = redPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 2];
-                    if (nrchannels>3) returnArrayBase[alphaReturnIndex] = redPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 3];
-                }
-            }
+        if (isOES) {
+            // We only do RGBA reads on OES, then discard unwanted stuff ourselves:
+            format = GL_RGBA;
+            stride = 4;
         }
         else {
-            // Readback of standard 32bpc float pixels into a double matrix:
+            format = (nrchannels == 1) ? GL_RED : ((nrchannels == 2) ? GL_LUMINANCE_ALPHA : ((nrchannels == 3) ? GL_RGB : GL_RGBA));
+            stride = nrchannels;
+        }
 
-            // No Luminance + Alpha on OES:
-            if (isOES && (nrchannels == 2)) PsychErrorExitMsg(PsychError_user, "Number of requested channels 'nrchannels' == 2 not supported on OpenGL-ES!");
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        invertedY = (int) (windowRect[kPsychBottom] - sampleRect[kPsychBottom]);
 
-            // Only float readback on floating point FBO's with EXT_color_buffer_float support:
-            if (isOES && ((whichBuffer != GL_COLOR_ATTACHMENT0_EXT) || (windowRecord->bpc < 16) || !glewIsSupported("GL_EXT_color_buffer_float"))) {
-                printf("PTB-ERROR: Tried to 'GetImage' pixels in floating point format from a non-floating point surface, or not supported by your hardware.\n");
-                PsychErrorExitMsg(PsychError_user, "'GetImage' of floating point values from given object not supported on OpenGL-ES!");
-            }
+        if (asyncMode && PsychIsAsyncReadbackSupported(windowRecord)) {
+            // Asynchronous readback: If all slots of the ring are pending, wait for the oldest one and return its image:
+            if (windowRecord->asyncReadbackCount == PSYCH_MAX_ASYNC_READBACKS)
+                asyncReturned = PsychFinishAsyncReadback(windowRecord, TRUE, c_layout);
 
-            PsychAllocOutDoubleMatArg(1, TRUE, (int) sampleRectHeight, (int) sampleRectWidth, (int) nrchannels, &returnArrayBaseDouble);
-            if (isOES) {
-                dredPlane = (float*) PsychMallocTemp((size_t) 4 * sizeof(float) * sampleRectWidth * sampleRectHeight);
-                stride = 4;
-            }
-            else {
-                dredPlane = (float*) PsychMallocTemp((size_t) nrchannels * sizeof(float) * sampleRectWidth * sampleRectHeight);
-                stride = nrchannels;
-            }
-
-            glPixelStorei(GL_PACK_ALIGNMENT, 1);
-            invertedY = (int) (windowRect[kPsychBottom]-sampleRect[kPsychBottom]);
-
-            if (!isOES) {
-                if (nrchannels==1) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RED, GL_FLOAT, dredPlane);
-                if (nrchannels==2) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_LUMINANCE_ALPHA, GL_FLOAT, dredPlane);
-                if (nrchannels==3) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGB, GL_FLOAT, dredPlane);
-                if (nrchannels==4) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGBA, GL_FLOAT, dredPlane);
-            }
-            else {
-                glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGBA, GL_FLOAT, dredPlane);
-            }
+            PsychStartAsyncReadback(windowRecord, (int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight,
+                                    format, nrchannels, stride, floatprecision);
 
-            //in one pass transpose and flip what we read with glReadPixels before returning.
-            //-glReadPixels insists on filling up memory in sequence by reading the screen row-wise whearas Matlab reads up memory into columns.
-            //-the Psychtoolbox screen as setup by gluOrtho puts 0,0 at the top left of the window but glReadPixels always believes that it's at the bottom left.
-            for(ix=0; ix < sampleRectWidth; ix++){
-                for(iy=0; iy < sampleRectHeight; iy++){
-                    // Compute write-indices for returned data:
-                    redReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth, nrchannels, iy, ix, 0);
-                    greenReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 1);
-                    blueReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 2);
-                    alphaReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 3);
-
-                    // Always return RED/LUMINANCE channel:
-                    returnArrayBaseDouble[redReturnIndex] = dredPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 0];
-                    // Other channels on demand:
-                    if (nrchannels>1) returnArrayBaseDouble[greenReturnIndex] = dredPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 1];
-                    if (nrchannels>2) returnArrayBaseDouble[blueReturnIndex]  = dredPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 2];
-                    if (nrchannels>3) returnArrayBaseDouble[alphaReturnIndex] = dredPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 3];
-                }
-            }
+            // Otherwise return the image of the oldest readback if it is finished, or an empty matrix if not:
+            if (!asyncReturned && !PsychFinishAsyncReadback(windowRecord, FALSE, c_layout))
+                PsychAllocOutDoubleMatArg(1, FALSE, 0, 0, 0, &returnArrayBaseDouble);
+        }
+        else {
+            // Synchronous readback into temporary memory, then flip - and transpose for column-major order - into returned matrix:
+            readbackPixels = PsychMallocTemp((size_t) stride * ((floatprecision) ? sizeof(float) : sizeof(psych_uint8)) * sampleRectWidth * sampleRectHeight);
+            glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, format, (floatprecision) ? GL_FLOAT : GL_UNSIGNED_BYTE, readbackPixels);
+            PsychCopyOutReadbackImage(readbackPixels, floatprecision, sampleRectWidth, sampleRectHeight, nrchannels, stride, c_layout);
         }
     }
 
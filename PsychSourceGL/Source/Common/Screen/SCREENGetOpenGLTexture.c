@@ -65,6 +65,10 @@ PsychError SCREENGetOpenGLTexture(void)
     // Query optional y-pos:
     PsychCopyInDoubleArg(4, FALSE, &y);
 
+    // External code may modify the texture from now on, so it must not be drawn from a stale copy in a texture atlas:
+    textureRecord->atlasEligible = FALSE;
+    PsychReleaseAtlasTexture(textureRecord);
+
     // Return the OpenGL texture handle:
     PsychCopyOutDoubleArg(1, FALSE, (double) textureRecord->textureNumber);
     
@@ -177,6 +177,20 @@ static char synopsisString[] =
     "An 'infoType' of 8 returns 1 if the X-Screens primary gpu uses the modesetting-ddx under Linux.\n\n"
     "An 'infoType' of 9 returns a struct with interop info needed for interop with certain clients, "
     "currently tailored to the needs of OpenGL interop with the OpenXR api on Linux and Windows.\n\n"
+    "An 'infoType' of 10 controls the per-stage timing profiler of the imaging pipeline and Screen('Flip'). If "
+    "'auxArg1' is 1, profiling is enabled, if it is 0, profiling is disabled and all recorded results are discarded. "
+    "Both return 0 if profiling is disabled, 1 if only CPU times are measured, and 2 if GPU times are measured as well, "
+    "which needs support for GL_ARB_timer_query. While enabled, each execution of a hook chain slot, each multisample "
+    "resolve or panelfitter blit, and the complete pre- and postflip operations of each Screen('Flip') are timed "
+    "on the CPU via GetSecs, and on the GPU via timestamp queries, which are collected asynchronously without "
+    "waiting for the GPU. Results of the last 1000 completed frames are kept. If 'auxArg1' is omitted, all completed "
+    "frames are returned as struct array 'info', oldest first, and removed from the profiler. A frame is completed "
+    "once its GPU results are available, usually a few flips later. Each frame has the fields 'FlipCount' of the flip "
+    "which finished the frame, 'CPUTime' and 'GPUTime' with the total time of all top-level stages in seconds, and the "
+    "struct array 'Stages'. Each stage has a 'Name', e.g., 'PreFlip', 'PostFlip', 'MSAAResolve', 'PanelFitter' or "
+    "'HookChainName:SlotIdString', a nesting 'Level', with 0 for top-level stages, a 'CPUStart' GetSecs timestamp, "
+    "and its 'CPUTime' and 'GPUTime' in seconds. 'GPUTime' is NaN if unavailable. At most 32 stages per frame are timed. "
+    "Stages of asynchronous flips are attributed to the next synchronous Screen('Flip').\n\n"
     "\n"
     "The default info struct for 'infoType' 7 and the default 'infoType' 0 contains all kinds of information. "
     "Just check its output to see what is returned. Most of this info is not interesting for normal users, "
@@ -214,6 +228,10 @@ static char synopsisString[] =
     "VRRMode: Actual selected mode for VRR stimulus onset scheduling (1 = auto maps to actual choice): 0 = Off, 2 = Simple, 3 = OwnScheduled.\n"
     "VRRStyleHint: Style hint code for the current active VRR stimulation timing style, ie. what is assumed about timing behaviour of the paradigm.\n"
     "VRRLatencyCompensation: Current estimate of average VRR swapbuffers latency, used for compensating during VRR scheduling in 'OwnScheduled' mode.\n"
+    "TextGlyphCacheHits, TextGlyphCacheMisses: Number of glyphs found in, or added to, the glyph texture atlas of the DrawText plugin "
+    "while laying out text strings for this window. Zero if unsupported by the current text renderer.\n"
+    "TextLayoutCacheHits, TextLayoutCacheMisses: Number of text strings for which the DrawText plugin found, or had to create, "
+    "a cached layout during Screen('DrawText') or Screen('TextBounds') for this window. Zero if unsupported by the current text renderer.\n"
     "\n"
     "The following settings are derived from a builtin detection heuristic, which works on most common GPU's:\n\n"
     "GPUCoreId: Symbolic name string that roughly describes the name of the GPU core of the graphics card. This string is arbitrarily\n"
@@ -242,12 +260,14 @@ PsychError SCREENGetWindowInfo(void)
                                 "GuesstimatedMemoryUsageMB", "VBLStartline", "VBLEndline", "VideoRefreshFromBeamposition", "GLVendor", "GLRenderer", "GLVersion", "GPUCoreId", "GPUMinorType",
                                 "DisplayCoreId", "GLSupportsFBOUpToBpc", "GLSupportsBlendingUpToBpc", "GLSupportsTexturesUpToBpc", "GLSupportsFilteringUpToBpc", "GLSupportsPrecisionColors",
                                 "GLSupportsFP32Shading", "BitsPerColorComponent", "IsFullscreen", "SpecialFlags", "SwapGroup", "SwapBarrier", "SysWindowHandle", "ExternalMouseMultFactor", "VRRMode",
-                                "VRRStyleHint", "VRRLatencyCompensation", "GLDeviceUUID", "SysWindowInteropHandle" };
-    const int fieldCount = 44;
+                                "VRRStyleHint", "VRRLatencyCompensation", "GLDeviceUUID", "SysWindowInteropHandle", "TextGlyphCacheHits", "TextGlyphCacheMisses",
+                                "TextLayoutCacheHits", "TextLayoutCacheMisses" };
+    const int fieldCount = 48;
     PsychGenericScriptType *s;
 
     PsychWindowRecordType *windowRecord;
     double beamposition, lastvbl;
+    double textCacheStats[4];
     int infoType = 0;
     double auxArg1, auxArg2, auxArg3;
     CGDirectDisplayID displayId;
@@ -267,7 +287,7 @@ PsychError SCREENGetWindowInfo(void)
 
     // Query infoType flag: Defaults to zero.
     PsychCopyInIntegerArg(2, FALSE, &infoType);
-    if (infoType < -1 || infoType > 9) PsychErrorExitMsg(PsychError_user, "Invalid 'infoType' argument specified! Valid are -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9.");
+    if (infoType < -1 || infoType > 10) PsychErrorExitMsg(PsychError_user, "Invalid 'infoType' argument specified! Valid are -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10.");
 
     // Windowserver info requested?
     if (infoType == 2 || infoType == 3) {
@@ -468,6 +488,83 @@ PsychError SCREENGetWindowInfo(void)
             PsychSetStructArrayUnsignedInt64Element("OpenGLVisualId", 0, (psych_uint64) (size_t) 0, s);
         #endif
     }
+    else if (infoType == 10) {
+        // Per-stage timing profiler of imaging pipeline and flips:
+        const char* FieldNamesFrame[] = { "FlipCount", "CPUTime", "GPUTime", "Stages" };
+        const int fieldCountFrame = 4;
+        const char* FieldNamesStage[] = { "Name", "Level", "CPUStart", "CPUTime", "GPUTime" };
+        const int fieldCountStage = 5;
+        PsychGenericScriptType *stages;
+        PsychProfiler *profiler;
+        PsychProfileFrame *frame;
+        PsychProfileStage *stage;
+        double cpuTotal, gpuTotal;
+        int i, j, numFrames, numGPU;
+
+        if (!PsychIsOnscreenWindow(windowRecord)) {
+            PsychErrorExitMsg(PsychError_user, "Tried to use the pipeline profiler on a texture or offscreen window. Only supported on onscreen windows!");
+        }
+
+        // No OpenGL operations while async flips are active, just return what is already collected:
+        if ((NULL == windowRecord->flipInfo) || (0 == windowRecord->flipInfo->asyncstate)) {
+            // Only need OpenGL mastercontext, not full drawingtarget:
+            PsychSetGLContext(windowRecord);
+
+            if (PsychCopyInDoubleArg(3, FALSE, &auxArg1)) {
+                // Enable or disable profiling:
+                PsychProfilerEnable(windowRecord, (auxArg1 > 0) ? TRUE : FALSE);
+                PsychCopyOutDoubleArg(1, FALSE, (windowRecord->profiler) ? ((windowRecord->profiler->useGPU) ? 2 : 1) : 0);
+                return(PsychError_none);
+            }
+
+            // Collect frames with GPU results available:
+            PsychProfilerCollect(windowRecord);
+        }
+        else if (PsychCopyInDoubleArg(3, FALSE, &auxArg1)) {
+            PsychErrorExitMsg(PsychError_user, "Tried to enable or disable the pipeline profiler while async flips are active!");
+        }
+
+        // Return and remove all completed frames, oldest first:
+        profiler = windowRecord->profiler;
+        numFrames = (profiler) ? profiler->historyCount : 0;
+        PsychAllocOutStructArray(1, FALSE, numFrames, fieldCountFrame, FieldNamesFrame, &s);
+        for (i = 0; i < numFrames; i++) {
+            frame = &(profiler->history[(profiler->historyHead + i) % kPsychProfileHistoryLength]);
+            cpuTotal = gpuTotal = 0;
+            numGPU = 0;
+
+            PsychAllocOutStructArray(-1, FALSE, frame->numStages, fieldCountStage, FieldNamesStage, &stages);
+            for (j = 0; j < frame->numStages; j++) {
+                stage = &(frame->stages[j]);
+                PsychSetStructArrayStringElement("Name", j, stage->name, stages);
+                PsychSetStructArrayDoubleElement("Level", j, (double) stage->level, stages);
+                PsychSetStructArrayDoubleElement("CPUStart", j, stage->cpuStart, stages);
+                PsychSetStructArrayDoubleElement("CPUTime", j, stage->cpuEnd - stage->cpuStart, stages);
+                PsychSetStructArrayDoubleElement("GPUTime", j, stage->gpuTime, stages);
+
+                // Totals over top-level stages, as nested stages are part of their parents:
+                if (stage->level == 0) {
+                    cpuTotal += stage->cpuEnd - stage->cpuStart;
+                    if (stage->gpuState == 2) {
+                        gpuTotal += stage->gpuTime;
+                        numGPU++;
+                    }
+                }
+            }
+
+            if (numGPU == 0) gpuTotal = PsychGetNanValue();
+
+            PsychSetStructArrayDoubleElement("FlipCount", i, (double) frame->flipCount, s);
+            PsychSetStructArrayDoubleElement("CPUTime", i, cpuTotal, s);
+            PsychSetStructArrayDoubleElement("GPUTime", i, gpuTotal, s);
+            PsychSetStructArrayStructElement("Stages", i, stages, s);
+        }
+
+        if (profiler) {
+            profiler->historyHead = 0;
+            profiler->historyCount = 0;
+        }
+    }
     else {
         // Set OpenGL context (always needed) and drawing target, as setting
         // our windowRecord as a drawingtarget is an expected side-effect of
@@ -615,6 +712,13 @@ PsychError SCREENGetWindowInfo(void)
         // Current assumption about VRR system latency:
         PsychSetStructArrayDoubleElement("VRRLatencyCompensation", 0, windowRecord->vrrLatencyCompensation, s);
 
+        // Glyph and layout cache statistics of the DrawText plugin, all zero if unsupported:
+        PsychGetTextRendererCacheStats(windowRecord, textCacheStats);
+        PsychSetStructArrayDoubleElement("TextGlyphCacheHits", 0, textCacheStats[0], s);
+        PsychSetStructArrayDoubleElement("TextGlyphCacheMisses", 0, textCacheStats[1], s);
+        PsychSetStructArrayDoubleElement("TextLayoutCacheHits", 0, textCacheStats[2], s);
+        PsychSetStructArrayDoubleElement("TextLayoutCacheMisses", 0, textCacheStats[3], s);
+
         // Which basic GPU architecture is this?
         PsychSetStructArrayStringElement("GPUCoreId", 0, windowRecord->gpuCoreId, s);
 
@@ -65,6 +65,13 @@ static char synopsisString[] =
 "A 'specialFlags' == 8 will prevent automatic mipmap-generation for GL_TEXTURE_2D textures.\n"
 "A 'specialFlags' == 32 setting will prevent automatic closing of the texture if Screen('Close'); is called. Only "
 "Screen('Close', textureIndex); would close the texture.\n"
+"A 'specialFlags' == 64 setting asks for asynchronous upload of the texture content to the graphics card: The image matrix "
+"gets converted directly into a transfer buffer of the driver, and 'MakeTexture' returns without waiting for the upload. "
+"Drawing the texture waits for completion of its upload only if it is still in progress, so a script can create textures "
+"for its next trials while the gpu still displays the current trial. Screen('PreloadTextures', WindowIndex, textureIndex, "
+"waitSecs) allows to check or wait for upload completion. This setting is ignored on graphics hardware without support "
+"for pixel buffer objects and sync objects, on OpenGL-ES, and for 16 bpc textures, planar textures or power-of-two "
+"emulated GL_TEXTURE_2D textures.\n"
 "'floatprecision' defines the precision with which the texture should be stored and processed. If omitted, the default value "
 "in normal display mode is zero, which asks to store textures with 8 bit per color component precision in unsigned normalized "
 "(unorm) color range, a suitable format for standard images read via imread() and displayed on normal display devices. If the "
@@ -90,6 +97,10 @@ static char synopsisString[] =
 "so no further processing is needed. A value of 3 tells PTB that the texture is completely isotropic, with no real orientation, "
 "therefore no conversion is required. This latter setting only makes sense for random noise textures or other textures generated "
 "from a distribution with uncorrelated noise-like pixels, e.g., some power spectrum distribution.\n"
+"Image matrices from Python, ie. NumPy arrays, are used in their native row-major memory layout, without conversion "
+"into Matlab's column-major layout, unless 'textureOrientation' is 2.\n"
+"Conversion of big image matrices into textures is split across multiple processor cores. Use "
+"Screen('Preference', 'MakeTextureThreads') to select the number of threads to use.\n"
 "'textureShader' - optional: If you provide the handle of an OpenGL GLSL shader program, then this shader program will be "
 "executed (bound) during drawing of this texture via the Screen('DrawTexture',...); command -- The normal texture drawing "
 "operation is replaced by your customized algorithm. This is useful for two purposes: a) Very basic on-the-fly image processing "
@@ -101,6 +112,460 @@ static char synopsisString[] =
 
 static char seeAlsoString[] = "DrawTexture TransformTexture BlendFunction";
 
+// Maximum number of threads, including the calling thread, for conversion of image matrices into texel buffers:
+#define kPsychMaxMakeTextureThreads         8
+
+// Minimum number of image matrix elements for parallel conversion. Smaller matrices convert faster on the calling thread alone:
+#define kPsychMinParallelConversionSize     (256 * 1024)
+
+// Number of texels converted per block. The destination texels of a block stay in the cpu cache while their channels get written.
+// Work gets split into chunks of multiples of this size:
+#define kPsychConversionBlockSize           4096
+
+// Description of the conversion of an image matrix into a texel buffer, ready for upload via PsychCreateTexture():
+typedef struct PsychTexelConversion {
+    size_t          numTexels;          // Number of texels to convert.
+    int             numChannels;        // Number of channels per texel.
+    int             srcPlane[4];        // Source matrix plane of each destination channel.
+    size_t          srcPlaneStride;     // Distance between planes of a source texel, in elements.
+    size_t          srcTexelStride;     // Distance between consecutive source texels, in elements.
+    size_t          dstChannelStride;   // Distance between channels of a destination texel, in elements.
+    size_t          dstTexelStride;     // Distance between consecutive destination texels, in elements.
+    const double*   srcDouble;          // Source matrix if double, otherwise NULL.
+    const GLubyte*  srcByte;            // Source matrix if uint8, otherwise NULL.
+    GLfloat*        dstFloat;           // Destination buffer if float, otherwise NULL.
+    GLubyte*        dstByte;            // Destination buffer if uint8, otherwise NULL.
+    double          offset;             // Offset added for double -> uint8 conversion.
+    double          scale[4];           // Per channel scale factor for double -> uint8 and uint8 -> float conversion.
+    double          divisor[4];         // Per channel divisor for uint8 -> float conversion.
+} PsychTexelConversion;
+
+struct PsychMakeTextureWorkerPool;
+
+// A conversion worker thread. Each worker has its own condition variable, as PsychBroadcastCondition()
+// is not supported on MS-Windows:
+typedef struct PsychMakeTextureWorker {
+    struct PsychMakeTextureWorkerPool*  pool;
+    psych_thread                        thread;
+    psych_condition                     workSignal;     // Signalled by calling thread when a new conversion is available.
+} PsychMakeTextureWorker;
+
+// Pool of worker threads for parallel conversion, shared by all calls to MakeTexture:
+typedef struct PsychMakeTextureWorkerPool {
+    psych_bool                  initialized;    // Mutex and condition variables initialized?
+    int                         numWorkers;     // Number of running worker threads, not counting the calling thread.
+    int                         wantedWorkers;  // Number of worker threads requested at last (re-)creation of the pool.
+    PsychMakeTextureWorker      workers[kPsychMaxMakeTextureThreads];
+    psych_mutex                 mutex;          // Protects all following fields.
+    psych_condition             doneSignal;     // Signalled by the worker which completes the last chunk of a conversion.
+    psych_bool                  shutdown;       // Request to workers to terminate.
+    unsigned int                generation;     // Conversion counter. Incremented for each new conversion.
+    const PsychTexelConversion* conv;           // Current conversion.
+    size_t                      chunkSize;      // Number of texels per chunk of work.
+    size_t                      numChunks;      // Number of chunks of current conversion.
+    size_t                      nextChunk;      // Index of next unclaimed chunk.
+    size_t                      chunksDone;     // Number of completed chunks.
+} PsychMakeTextureWorkerPool;
+
+static PsychMakeTextureWorkerPool makeTextureWorkers;
+
+// Setup 'conv' for conversion of 'numTexels' texels with 'numChannels' channels. Source matrix is planar, as
+// from Matlab/Octave, unless 'interleavedInput' is set for a C memory layout matrix, e.g., a NumPy array.
+// Destination buffer is interleaved, unless 'planarOutput' is set:
+static void PsychInitTexelConversion(PsychTexelConversion* conv, size_t numTexels, int numChannels, psych_bool interleavedInput, psych_bool planarOutput)
+{
+    int c;
+
+    memset(conv, 0, sizeof(PsychTexelConversion));
+    conv->numTexels = numTexels;
+    conv->numChannels = numChannels;
+    conv->srcPlaneStride = (interleavedInput) ? 1 : numTexels;
+    conv->srcTexelStride = (interleavedInput) ? (size_t) numChannels : 1;
+    conv->dstChannelStride = (planarOutput) ? numTexels : 1;
+    conv->dstTexelStride = (planarOutput) ? 1 : (size_t) numChannels;
+
+    for (c = 0; c < 4; c++) {
+        conv->srcPlane[c] = c;
+        conv->scale[c] = 1.0;
+        conv->divisor[c] = 1.0;
+    }
+}
+
+// Setup 'conv' for double -> uint8 conversion, with the same rounding as the graphics hardware:
+static void PsychSetByteTexelConversion(PsychTexelConversion* conv, double offset, double scale)
+{
+    int c;
+
+    conv->offset = offset;
+    for (c = 0; c < 4; c++) conv->scale[c] = scale;
+}
+
+// Setup 'conv' for uint8 -> float conversion with remapping of SDR to HDR range. Non-alpha channels
+// get scaled by 'hdrScale', an alpha channel, if any, only by 1/255th:
+static void PsychSetHDRTexelConversion(PsychTexelConversion* conv, double hdrScale)
+{
+    int c;
+
+    for (c = 0; c < conv->numChannels; c++) conv->scale[c] = hdrScale;
+
+    if ((conv->numChannels == 2) || (conv->numChannels == 4)) {
+        conv->scale[conv->numChannels - 1] = 1.0;
+        conv->divisor[conv->numChannels - 1] = 255.0;
+    }
+}
+
+// Convert 'count' texels, starting with texel 'first', of destination channel 'channel'. Used for
+// planar destination buffers and single channel conversions, where the loops without strides are
+// the common case, written so the compiler can vectorize them:
+static void PsychConvertTexelChannel(const PsychTexelConversion* conv, int channel, size_t first, size_t count)
+{
+    size_t i;
+    size_t ss = conv->srcTexelStride;
+    size_t ds = conv->dstTexelStride;
+    size_t srcOffset = (size_t) conv->srcPlane[channel] * conv->srcPlaneStride + first * ss;
+    size_t dstOffset = (size_t) channel * conv->dstChannelStride + first * ds;
+    double offset = conv->offset;
+    double scale = conv->scale[channel];
+    double divisor = conv->divisor[channel];
+
+    if (conv->srcDouble && conv->dstFloat) {
+        const double* src = conv->srcDouble + srcOffset;
+        GLfloat* dst = conv->dstFloat + dstOffset;
+
+        if ((ss == 1) && (ds == 1)) {
+            for (i = 0; i < count; i++) dst[i] = (GLfloat) src[i];
+        }
+        else {
+            for (i = 0; i < count; i++) dst[i * ds] = (GLfloat) src[i * ss];
+        }
+    }
+    else if (conv->srcDouble) {
+        const double* src = conv->srcDouble + srcOffset;
+        GLubyte* dst = conv->dstByte + dstOffset;
+
+        if ((ss == 1) && (ds == 1)) {
+            for (i = 0; i < count; i++) dst[i] = (GLubyte) (offset + scale * src[i]);
+        }
+        else {
+            for (i = 0; i < count; i++) dst[i * ds] = (GLubyte) (offset + scale * src[i * ss]);
+        }
+    }
+    else if (conv->dstFloat) {
+        const GLubyte* src = conv->srcByte + srcOffset;
+        GLfloat* dst = conv->dstFloat + dstOffset;
+
+        for (i = 0; i < count; i++) dst[i * ds] = (GLfloat) ((((double) src[i * ss]) * scale) / divisor);
+    }
+    else {
+        const GLubyte* src = conv->srcByte + srcOffset;
+        GLubyte* dst = conv->dstByte + dstOffset;
+
+        if ((ss == 1) && (ds == 1)) {
+            memcpy(dst, src, count);
+        }
+        else {
+            for (i = 0; i < count; i++) dst[i * ds] = src[i * ss];
+        }
+    }
+}
+
+// Convert 'count' texels, starting with texel 'first', into an interleaved destination buffer with
+// 'nc' channels per texel. Called with constant 'nc', so the compiler can unroll the channel loops:
+static void PsychInterleaveTexels(const PsychTexelConversion* conv, int nc, size_t first, size_t count)
+{
+    size_t i, ss = conv->srcTexelStride;
+    size_t src[4];
+    int c;
+
+    for (c = 0; c < nc; c++) src[c] = (size_t) conv->srcPlane[c] * conv->srcPlaneStride + first * ss;
+
+    if (conv->srcDouble && conv->dstFloat) {
+        GLfloat* dst = conv->dstFloat + first * nc;
+
+        for (i = 0; i < count; i++)
+            for (c = 0; c < nc; c++) *(dst++) = (GLfloat) conv->srcDouble[src[c] + i * ss];
+    }
+    else if (conv->srcDouble) {
+        GLubyte* dst = conv->dstByte + first * nc;
+        double offset = conv->offset;
+        double scale = conv->scale[0];
+
+        for (i = 0; i < count; i++)
+            for (c = 0; c < nc; c++) *(dst++) = (GLubyte) (offset + scale * conv->srcDouble[src[c] + i * ss]);
+    }
+    else if (conv->dstFloat) {
+        GLfloat* dst = conv->dstFloat + first * nc;
+
+        for (i = 0; i < count; i++)
+            for (c = 0; c < nc; c++) *(dst++) = (GLfloat) ((((double) conv->srcByte[src[c] + i * ss]) * conv->scale[c]) / conv->divisor[c]);
+    }
+    else {
+        GLubyte* dst = conv->dstByte + first * nc;
+
+        for (i = 0; i < count; i++)
+            for (c = 0; c < nc; c++) *(dst++) = conv->srcByte[src[c] + i * ss];
+    }
+}
+
+// Convert texels 'first' to 'last' - 1:
+static void PsychConvertTexelRange(const PsychTexelConversion* conv, size_t first, size_t last)
+{
+    size_t count;
+    int c;
+
+    // Interleaved destination buffer with multiple channels? Convert texel by texel:
+    if ((conv->numChannels > 1) && (conv->dstChannelStride == 1)) {
+        switch (conv->numChannels) {
+            case 2:
+                PsychInterleaveTexels(conv, 2, first, last - first);
+                break;
+
+            case 3:
+                PsychInterleaveTexels(conv, 3, first, last - first);
+                break;
+
+            default:
+                PsychInterleaveTexels(conv, 4, first, last - first);
+        }
+
+        return;
+    }
+
+    // Otherwise convert channel by channel, block by block:
+    for (; first < last; first += count) {
+        count = last - first;
+        if (count > kPsychConversionBlockSize) count = kPsychConversionBlockSize;
+
+        for (c = 0; c < conv->numChannels; c++) PsychConvertTexelChannel(conv, c, first, count);
+    }
+}
+
+// Claim and convert chunks of the current conversion until no unclaimed chunks are left. Executed by
+// the calling thread and all worker threads in parallel. Must be called with the pool mutex locked:
+static void PsychRunConversionChunks(PsychMakeTextureWorkerPool* pool)
+{
+    const PsychTexelConversion* conv;
+    size_t first, last;
+
+    while (pool->nextChunk < pool->numChunks) {
+        conv = pool->conv;
+        first = (pool->nextChunk++) * pool->chunkSize;
+        last = first + pool->chunkSize;
+        if (last > conv->numTexels) last = conv->numTexels;
+
+        PsychUnlockMutex(&pool->mutex);
+        PsychConvertTexelRange(conv, first, last);
+        PsychLockMutex(&pool->mutex);
+
+        // Last chunk of this conversion done? Wake up the calling thread if it is waiting for completion:
+        if (++pool->chunksDone == pool->numChunks) PsychSignalCondition(&pool->doneSignal);
+    }
+}
+
+// Main routine of conversion worker threads:
+static void* PsychMakeTextureWorkerMain(void* arg)
+{
+    PsychMakeTextureWorker* worker = (PsychMakeTextureWorker*) arg;
+    PsychMakeTextureWorkerPool* pool = worker->pool;
+    unsigned int generation;
+
+    PsychSetThreadName("ScreenMakeTex");
+
+    PsychLockMutex(&pool->mutex);
+    generation = pool->generation;
+
+    while (!pool->shutdown) {
+        // Sleep until a new conversion is available:
+        if (pool->generation == generation) {
+            PsychWaitCondition(&worker->workSignal, &pool->mutex);
+            continue;
+        }
+
+        generation = pool->generation;
+        PsychRunConversionChunks(pool);
+    }
+
+    PsychUnlockMutex(&pool->mutex);
+
+    return(NULL);
+}
+
+// Shutdown all conversion worker threads. Called at Screen shutdown and when the number of threads changes:
+void PsychCleanupSCREENMakeTexture(void)
+{
+    PsychMakeTextureWorkerPool* pool = &makeTextureWorkers;
+    int i;
+
+    if (!pool->initialized) return;
+
+    PsychLockMutex(&pool->mutex);
+    pool->shutdown = TRUE;
+    for (i = 0; i < pool->numWorkers; i++) PsychSignalCondition(&(pool->workers[i].workSignal));
+    PsychUnlockMutex(&pool->mutex);
+
+    for (i = 0; i < pool->numWorkers; i++) PsychDeleteThread(&(pool->workers[i].thread));
+
+    for (i = 0; i < kPsychMaxMakeTextureThreads; i++) PsychDestroyCondition(&(pool->workers[i].workSignal));
+    PsychDestroyCondition(&pool->doneSignal);
+    PsychDestroyMutex(&pool->mutex);
+    memset(pool, 0, sizeof(PsychMakeTextureWorkerPool));
+}
+
+// Return number of threads to use for conversion, as selected by Screen('Preference', 'MakeTextureThreads'):
+static int PsychGetMakeTextureThreadCount(void)
+{
+    int numThreads = PsychPrefStateGet_MakeTextureThreads();
+
+    // Auto-select: One thread per processor core:
+    if (numThreads == 0) {
+        #if PSYCH_SYSTEM == PSYCH_WINDOWS
+            SYSTEM_INFO sysinfo;
+            GetSystemInfo(&sysinfo);
+            numThreads = (int) sysinfo.dwNumberOfProcessors;
+        #else
+            numThreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+        #endif
+    }
+
+    if (numThreads < 1) numThreads = 1;
+    if (numThreads > kPsychMaxMakeTextureThreads) numThreads = kPsychMaxMakeTextureThreads;
+
+    return(numThreads);
+}
+
+// (Re-)Create the pool with 'numWorkers' worker threads, unless it already has that size:
+static void PsychStartMakeTextureWorkers(int numWorkers)
+{
+    PsychMakeTextureWorkerPool* pool = &makeTextureWorkers;
+    int i, rc;
+
+    if (pool->initialized && (pool->wantedWorkers == numWorkers)) return;
+
+    PsychCleanupSCREENMakeTexture();
+
+    PsychInitMutex(&pool->mutex);
+    PsychInitCondition(&pool->doneSignal, NULL);
+    for (i = 0; i < kPsychMaxMakeTextureThreads; i++) {
+        pool->workers[i].pool = pool;
+        PsychInitCondition(&(pool->workers[i].workSignal), NULL);
+    }
+    pool->initialized = TRUE;
+    pool->wantedWorkers = numWorkers;
+
+    for (i = 0; i < numWorkers; i++) {
+        if ((rc = PsychCreateThread(&(pool->workers[i].thread), NULL, PsychMakeTextureWorkerMain, (void*) &(pool->workers[i])))) {
+            if (PsychPrefStateGet_Verbosity() > 1)
+                printf("PTB-WARNING: MakeTexture: Could only create %i of %i worker threads for image conversion [%s].\n", i, numWorkers, strerror(rc));
+            break;
+        }
+    }
+
+    pool->numWorkers = i;
+}
+
+// Execute conversion 'conv', split across the worker pool for big image matrices:
+static void PsychConvertTexels(PsychTexelConversion* conv)
+{
+    PsychMakeTextureWorkerPool* pool = &makeTextureWorkers;
+    int c, numThreads;
+    psych_bool uniform = TRUE;
+
+    // Same layout of source and destination, no channel reordering and the same conversion for all channels? Then
+    // all channels of all texels can be converted as one contiguous run of single channel texels:
+    for (c = 1; c < conv->numChannels; c++) {
+        if ((conv->srcPlane[c] != c) || (conv->scale[c] != conv->scale[0]) || (conv->divisor[c] != conv->divisor[0]))
+            uniform = FALSE;
+    }
+
+    if (uniform && (conv->srcPlane[0] == 0) && (conv->srcPlaneStride == conv->dstChannelStride) && (conv->srcTexelStride == conv->dstTexelStride)) {
+        conv->numTexels *= (size_t) conv->numChannels;
+        conv->numChannels = 1;
+        conv->srcPlaneStride = conv->dstChannelStride = conv->numTexels;
+        conv->srcTexelStride = conv->dstTexelStride = 1;
+    }
+
+    numThreads = PsychGetMakeTextureThreadCount();
+    if ((numThreads > 1) && (conv->numTexels * (size_t) conv->numChannels >= kPsychMinParallelConversionSize))
+        PsychStartMakeTextureWorkers(numThreads - 1);
+    else
+        numThreads = 1;
+
+    if ((numThreads == 1) || (pool->numWorkers == 0)) {
+        PsychConvertTexelRange(conv, 0, conv->numTexels);
+        return;
+    }
+
+    // Split into a few chunks per thread, for load balancing if some cores are busy with other work:
+    PsychLockMutex(&pool->mutex);
+    pool->conv = conv;
+    pool->chunkSize = conv->numTexels / ((size_t) (pool->numWorkers + 1) * 4) + 1;
+    pool->chunkSize = ((pool->chunkSize + kPsychConversionBlockSize - 1) / kPsychConversionBlockSize) * kPsychConversionBlockSize;
+    pool->numChunks = (conv->numTexels + pool->chunkSize - 1) / pool->chunkSize;
+    pool->nextChunk = 0;
+    pool->chunksDone = 0;
+    pool->generation++;
+    for (c = 0; c < pool->numWorkers; c++) PsychSignalCondition(&(pool->workers[c].workSignal));
+
+    // Participate in conversion, then wait for the workers to finish their last chunks:
+    PsychRunConversionChunks(pool);
+    while (pool->chunksDone < pool->numChunks) PsychWaitCondition(&pool->doneSignal, &pool->mutex);
+
+    pool->conv = NULL;
+    PsychUnlockMutex(&pool->mutex);
+}
+
+/* PsychMapTextureUploadBuffer()
+ *
+ * Map 'size' bytes of the pixel unpack buffer of onscreen window 'windowRecord' for writing, for
+ * asynchronous upload of texture content via PsychCreateTexture(). The buffer gets created on first
+ * use. Its previous storage gets orphaned, so an upload from it which is still in progress does not
+ * stall us. Returns a pointer to the mapped buffer, or NULL on failure.
+ */
+static void* PsychMapTextureUploadBuffer(PsychWindowRecordType *windowRecord, size_t size)
+{
+    void* mem;
+
+    if (PsychIsGLES(windowRecord) || !(GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object) ||
+        !(GLEW_VERSION_3_2 || GLEW_ARB_sync) || !(GLEW_VERSION_3_0 || GLEW_ARB_map_buffer_range))
+        return(NULL);
+
+    PsychSetGLContext(windowRecord);
+    while (glGetError());
+
+    if (windowRecord->textureUploadPBO == 0) glGenBuffers(1, &windowRecord->textureUploadPBO);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, windowRecord->textureUploadPBO);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) size, NULL, GL_STREAM_DRAW);
+    mem = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if ((mem == NULL) || glGetError()) {
+        while (glGetError());
+        if (PsychPrefStateGet_Verbosity() > 3)
+            printf("PTB-INFO: MakeTexture: Could not map a %i MB upload buffer. Using synchronous texture upload.\n", (int) (size / 1024 / 1024));
+
+        return(NULL);
+    }
+
+    return(mem);
+}
+
+/* PsychUnmapTextureUploadBuffer()
+ *
+ * Finish writing into the pixel unpack buffer mapped by PsychMapTextureUploadBuffer(), and
+ * assign it as source of the texture content of 'textureRecord' for PsychCreateTexture().
+ */
+static void PsychUnmapTextureUploadBuffer(PsychWindowRecordType *windowRecord, PsychWindowRecordType *textureRecord)
+{
+    PsychSetGLContext(windowRecord);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, windowRecord->textureUploadPBO);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    textureRecord->textureMemory = NULL;
+    textureRecord->textureMemorySizeBytes = 0;
+    textureRecord->textureUploadBuffer = windowRecord->textureUploadPBO;
+}
+
 PsychError SCREENMakeTexture(void)
 {
     size_t                      ix, iters;
@@ -112,10 +577,8 @@ PsychError SCREENMakeTexture(void)
     unsigned char               *byteMatrix;
     double                      *doubleMatrix;
     GLuint                      *texturePointer;
-    GLubyte                     *texturePointer_b;
     GLfloat                     *texturePointer_f;
-    double                      *rp, *gp, *bp, *ap;
-    GLubyte                     *rpb, *gpb, *bpb, *apb;
+    GLubyte                     *rpb;
     int                         usepoweroftwo, usefloatformat, assume_texorientation, textureShader;
     double                      optimized_orientation;
     psych_bool                  bigendian;
@@ -123,6 +586,9 @@ PsychError SCREENMakeTexture(void)
     double                      scaled = 1.0;
     double                      offsetd;
     double                      uint8tohdrscalef;
+    psych_bool                  c_layout = FALSE;
+    psych_bool                  async_upload = FALSE;
+    PsychTexelConversion        conv;
 
     // Detect endianity (byte-order) of machine:
     ix=255;
@@ -190,6 +656,12 @@ PsychError SCREENMakeTexture(void)
     textureShader = 0;
     PsychCopyInIntegerArg(7, FALSE, &textureShader);
 
+    // Image matrices in C memory layout, e.g., NumPy arrays from Python, are already interleaved and stored
+    // row by row, top row first, so they can be used without transposing them. Pre-transposed matrices
+    // keep the classic layout for backwards compatibility:
+    if (assume_texorientation != 2)
+        c_layout = PsychUseCMemoryLayoutIfOptimal(TRUE);
+
     //get the argument and sanity check it.
     isImageMatrixBytes=PsychAllocInUnsignedByteMatArg(2, kPsychArgAnything, &ySize, &xSize, &numMatrixPlanes, &byteMatrix);
     isImageMatrixDoubles=PsychAllocInDoubleMatArg(2, kPsychArgAnything, &ySize, &xSize, &numMatrixPlanes, &doubleMatrix);
@@ -301,7 +773,7 @@ PsychError SCREENMakeTexture(void)
     // Is texture storage in planar format explicitely requested by usercode? Do the gpu and its size
     // constraints on textures support planar storage for this image?
     // Can a proper planar -> interleaved remapping GLSL shader be generated and assigned for this texture?
-    if ((usepoweroftwo == 4) && (numMatrixPlanes > 1) && (windowRecord->gfxcaps & kPsychGfxCapFBO) &&
+    if ((usepoweroftwo == 4) && (numMatrixPlanes > 1) && !c_layout && (windowRecord->gfxcaps & kPsychGfxCapFBO) &&
         (ySize * numMatrixPlanes <= windowRecord->maxTextureSize) && PsychAssignPlanarTextureShaders(textureRecord, windowRecord, numMatrixPlanes)) {
         // Yes: Use the planar texture storage fast-path.
         planar_storage = TRUE;
@@ -327,11 +799,19 @@ PsychError SCREENMakeTexture(void)
         textureRecord->textureMemorySizeBytes = (size_t) numMatrixPlanes * (size_t) xSize * (size_t) ySize;
     }
 
+    // Asynchronous upload requested? Not for planar storage, power-of-two emulated GL_TEXTURE_2D textures, which
+    // PsychCreateTexture() fills via glTexSubImage2D(), or 16 bpc float textures, whose texels get post-processed below:
+    if ((usepoweroftwo & 64) && !planar_storage && (usefloatformat != 1) &&
+        !((usepoweroftwo & 1) && !(windowRecord->gfxcaps & kPsychGfxCapNPOTTex)))
+        async_upload = TRUE;
+
     // We allocate our own intermediate conversion buffer unless this is
     // creation of a single-layer luminance8 integer texture from a single
-    // layer uint8 input matrix and client storage is disabled. In that case, we can use a zero-copy path:
-    if ((isImageMatrixBytes && (numMatrixPlanes == 1) && !usefloatformat) ||
-        (isImageMatrixBytes && planar_storage && !(windowRecord->imagingMode & kPsychNeedHDRWindow))) {
+    // layer uint8 input matrix and client storage is disabled. In that case, we can use a zero-copy path.
+    // The same goes for LA and RGB uint8 input matrices in C memory layout, which are already interleaved:
+    // Asynchronous uploads always convert into the drivers upload buffer instead:
+    if (!async_upload && ((isImageMatrixBytes && ((numMatrixPlanes == 1) || (c_layout && (numMatrixPlanes < 4))) && !usefloatformat) ||
+        (isImageMatrixBytes && planar_storage && !(windowRecord->imagingMode & kPsychNeedHDRWindow)))) {
         // Zero copy path:
         texturePointer = NULL;
         // Set usefloatformat = 0 to prevent false compiler warnings about iters
@@ -339,11 +819,15 @@ PsychError SCREENMakeTexture(void)
         usefloatformat = 0;
     }
     else {
-        // Allocate memory:
+        // Allocate memory, or map the upload buffer:
         if(PsychPrefStateGet_DebugMakeTexture()) StoreNowTime();
-        textureRecord->textureMemory = malloc(textureRecord->textureMemorySizeBytes);
+        texturePointer = (async_upload) ? (GLuint*) PsychMapTextureUploadBuffer(windowRecord, textureRecord->textureMemorySizeBytes) : NULL;
+        if (texturePointer == NULL) {
+            async_upload = FALSE;
+            textureRecord->textureMemory = malloc(textureRecord->textureMemorySizeBytes);
+            texturePointer = textureRecord->textureMemory;
+        }
         if(PsychPrefStateGet_DebugMakeTexture()) StoreNowTime();
-        texturePointer = textureRecord->textureMemory;
     }
 
     // Does script explicitely request usage of a GL_TEXTURE_2D texture?
@@ -376,6 +860,8 @@ PsychError SCREENMakeTexture(void)
             // We always cast from double to float, potentially with
             // normalization and/or checking of value range.
             textureRecord->textureexternalformat = GL_LUMINANCE;
+            iters = (size_t) xSize * (size_t) ySize;
+            PsychInitTexelConversion(&conv, iters, numMatrixPlanes, FALSE, TRUE);
 
             if (usefloatformat) {
                 // Floating point or other high precision format:
@@ -387,36 +873,20 @@ PsychError SCREENMakeTexture(void)
                 if ((usefloatformat == 1) && !(windowRecord->gfxcaps & kPsychGfxCapFPTex16)) textureRecord->textureinternalformat = GL_LUMINANCE16_SNORM;
 
                 // Perform copy with double -> float cast:
-                texturePointer_f = (GLfloat*) texturePointer;
+                conv.dstFloat = (GLfloat*) texturePointer;
 
                 if (isImageMatrixDoubles) {
                     // Double matrix as input: Just cast to float and assign:
-                    iters = (size_t) xSize * (size_t) ySize * (size_t) numMatrixPlanes;
-                    for(ix = 0; ix < iters; ix++) {
-                        *(texturePointer_f++) = (GLfloat) *(doubleMatrix++);
-                    }
+                    conv.srcDouble = doubleMatrix;
                 }
                 else {
                     // HDR mode with uint8 matrix as input: Cast to float and remap LDR to HDR:
-
-                    // First deal with non-alpha planes, which need SDR -> HDR scaling:
-                    iters = (size_t) xSize * (size_t) ySize * ((numMatrixPlanes == 1 || numMatrixPlanes == 3) ? numMatrixPlanes : numMatrixPlanes - 1);
-
                     if (PsychPrefStateGet_Verbosity() > 7)
                         printf("PTB-DEBUG: Planar uint8 SDR input to HDR float (%i) conversion with scaling factor %f [%f].\n", usefloatformat, uint8tohdrscalef, windowRecord->maxSDRToHDRScaleFactor);
 
-                    for(ix = 0; ix < iters; ix++)
-                        *(texturePointer_f++) = (GLfloat) (((double) *(byteMatrix++)) * uint8tohdrscalef);
-
-                    // Then, if there is an alpha channel, deal with it, only scaling by 1/255th:
-                    if (numMatrixPlanes == 2 || numMatrixPlanes == 4) {
-                        iters = (size_t) xSize * (size_t) ySize;
-                        for(ix = 0; ix < iters; ix++)
-                            *(texturePointer_f++) = (GLfloat) (((double) *(byteMatrix++)) / 255.0);
-                    }
+                    conv.srcByte = byteMatrix;
+                    PsychSetHDRTexelConversion(&conv, uint8tohdrscalef);
                 }
-
-                iters = (size_t) xSize * (size_t) ySize;
             }
             else {
                 // 8 Bit format, but from double input matrix -> cast to uint8:
@@ -424,56 +894,40 @@ PsychError SCREENMakeTexture(void)
                 textureRecord->textureexternaltype = GL_UNSIGNED_BYTE;
                 textureRecord->textureinternalformat = GL_LUMINANCE8;
 
-                iters = (size_t) xSize * (size_t) ySize * (size_t) numMatrixPlanes;
-                texturePointer_b = (GLubyte*) texturePointer;
-                for(ix = 0; ix < iters; ix++) {
-                    *(texturePointer_b++) = (GLubyte) (offsetd + scaled * *(doubleMatrix++));
-                }
-
-                iters = (size_t) xSize * (size_t) ySize;
+                conv.srcDouble = doubleMatrix;
+                conv.dstByte = (GLubyte*) texturePointer;
+                PsychSetByteTexelConversion(&conv, offsetd, scaled);
             }
+
+            PsychConvertTexels(&conv);
         }
     }
     else if (usefloatformat) {
         // Conversion routines for HDR 16 bpc or 32 bpc textures -- Slow path.
-        // Our input is always double matrices...
         iters = (size_t) xSize * (size_t) ySize;
 
         // Our input buffer is always of GL_FLOAT precision:
         textureRecord->textureexternaltype = GL_FLOAT;
-        texturePointer_f=(GLfloat*) texturePointer;
+        PsychInitTexelConversion(&conv, iters, numMatrixPlanes, c_layout, FALSE);
+        conv.dstFloat = (GLfloat*) texturePointer;
 
         // Special case: Convert uint8 input matrix into float texture in HDR mode?
         if (isImageMatrixBytes) {
-            // Yes: Use intermediate bounce buffer for uint8->double conversion and range rescaling:
-            // Note: This is somewhat inefficient, but saves us replicating a lot of code for optimized
-            // uint8 -> float conversion. Also, this code path is only used on HDR configurations where
-            // uint8 content has to be transparently converted to float textures. This will be mostly the
-            // exception in HDR scripts, which will rarely use original uint8 content for anything, so this
-            // tradeoff should be acceptable:
-            size_t myiters;
-            double *texturePointer_d = (double*) PsychMallocTemp(iters * numMatrixPlanes * sizeof(double));
-            doubleMatrix = texturePointer_d;
-
+            // Yes: Convert with range rescaling. This code path is only used on HDR configurations where
+            // uint8 content has to be transparently converted to float textures:
             if (PsychPrefStateGet_Verbosity() > 7)
                 printf("PTB-DEBUG: Interleaved uint8 SDR input to HDR float (%i) conversion with scaling factor %f [%f].\n", usefloatformat, uint8tohdrscalef, windowRecord->maxSDRToHDRScaleFactor);
 
-            // First deal with non-alpha planes, which need SDR -> HDR scaling:
-            myiters = iters * ((numMatrixPlanes == 1 || numMatrixPlanes == 3) ? numMatrixPlanes : numMatrixPlanes - 1);
-            for (ix = 0; ix < myiters; ix++)
-                *(texturePointer_d++) = ((double) *(byteMatrix++)) * uint8tohdrscalef;
-
-            // Then, if there is an alpha channel, deal with it, only scaling by 1/255th:
-            if (numMatrixPlanes == 2 || numMatrixPlanes == 4) {
-                for (ix = 0; ix < iters; ix++)
-                    *(texturePointer_d++) = ((double) *(byteMatrix++)) / 255.0;
-            }
+            conv.srcByte = byteMatrix;
+            PsychSetHDRTexelConversion(&conv, uint8tohdrscalef);
+        }
+        else {
+            conv.srcDouble = doubleMatrix;
         }
 
+        PsychConvertTexels(&conv);
+
         if (numMatrixPlanes==1) {
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_f++)= (GLfloat) *(doubleMatrix++);
-            }
             textureRecord->depth=(usefloatformat==1) ? 16 : 32;
 
             textureRecord->textureinternalformat = (usefloatformat==1) ? GL_LUMINANCE_FLOAT16_APPLE : GL_LUMINANCE_FLOAT32_APPLE;
@@ -484,13 +938,6 @@ PsychError SCREENMakeTexture(void)
         }
 
         if (numMatrixPlanes==2) {
-            rp=(double*) ((size_t) doubleMatrix);
-            ap=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_f++)= (GLfloat) *(rp++);
-                *(texturePointer_f++)= (GLfloat) *(ap++);
-            }
             textureRecord->depth=(usefloatformat==1) ? 32 : 64;
             textureRecord->textureinternalformat = (usefloatformat==1) ? GL_LUMINANCE_ALPHA_FLOAT16_APPLE : GL_LUMINANCE_ALPHA_FLOAT32_APPLE;
             textureRecord->textureexternalformat = GL_LUMINANCE_ALPHA;
@@ -500,15 +947,6 @@ PsychError SCREENMakeTexture(void)
         }
 
         if (numMatrixPlanes==3) {
-            rp=(double*) ((size_t) doubleMatrix);
-            gp=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            bp=(double*) ((size_t) gp + (size_t) iters * sizeof(double));
-
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_f++)= (GLfloat) *(rp++);
-                *(texturePointer_f++)= (GLfloat) *(gp++);
-                *(texturePointer_f++)= (GLfloat) *(bp++);
-            }
             textureRecord->depth=(usefloatformat==1) ? 48 : 96;
             textureRecord->textureinternalformat = (usefloatformat==1) ? GL_RGB_FLOAT16_APPLE : GL_RGB_FLOAT32_APPLE;
             textureRecord->textureexternalformat = GL_RGB;
@@ -518,17 +956,6 @@ PsychError SCREENMakeTexture(void)
         }
 
         if (numMatrixPlanes==4) {
-            rp=(double*) ((size_t) doubleMatrix);
-            gp=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            bp=(double*) ((size_t) gp + (size_t) iters * sizeof(double));
-            ap=(double*) ((size_t) bp + (size_t) iters * sizeof(double));
-
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_f++)= (GLfloat) *(rp++);
-                *(texturePointer_f++)= (GLfloat) *(gp++);
-                *(texturePointer_f++)= (GLfloat) *(bp++);
-                *(texturePointer_f++)= (GLfloat) *(ap++);
-            }
             textureRecord->depth=(usefloatformat==1) ? 64 : 128;
             textureRecord->textureinternalformat = (usefloatformat==1) ? GL_RGBA_FLOAT16_APPLE : GL_RGBA_FLOAT32_APPLE;
             textureRecord->textureexternalformat = GL_RGBA;
@@ -542,149 +969,43 @@ PsychError SCREENMakeTexture(void)
         // Standard LDR texture 8 bpc conversion routines -- Fast path.
         iters = (size_t) xSize * (size_t) ySize;
 
-        // Improved implementation: Takes 13 ms on a 800x800 texture...
-        if (isImageMatrixDoubles && numMatrixPlanes==1){
-            texturePointer_b=(GLubyte*) texturePointer;
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(doubleMatrix++));
-            }
-            textureRecord->depth=8;
-        }
+        // Luminance, Luminance+Alpha, RGB or RGBA texels of 8 bits per channel:
+        textureRecord->depth = 8 * numMatrixPlanes;
 
-        // Improved version: Takes 3 ms on a 800x800 texture...
-        // NB: Implementing memcpy manually by a for-loop takes 10 ms! This is a huge difference.
-        // -> That's because memcpy on MacOS-X is implemented with hand-coded, highly tuned Assembler code for PowerPC.
-        // -> It's always wise to use system-routines if available, instead of coding it by yourself!
-        if (isImageMatrixBytes && numMatrixPlanes==1) {
-            if (texturePointer) {
-                // Need to do a copy. Use optimized memcpy():
-                memcpy((void*) texturePointer, (void*) byteMatrix, iters);
-
-                //texturePointer_b=(GLubyte*) texturePointer;
-                //for(ix=0;ix<iters;ix++){
-                //    *(texturePointer_b++) = *(byteMatrix++);
-                //}
-            }
-            else {
-                // Zero-Copy path. Just pass a pointer to our input matrix:
-                texturePointer = (GLuint*) byteMatrix;
-                textureRecord->textureMemory = texturePointer;
-                // Set size to zero, so PsychCreateTexture() does not free() our
-                // input buffer:
-                textureRecord->textureMemorySizeBytes = 0;
-            }
-
-            textureRecord->depth=8;
-        }
-
-        // New version: Takes 33 ms on a 800x800 texture...
-        if (isImageMatrixDoubles && numMatrixPlanes==2){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rp=(double*) ((size_t) doubleMatrix);
-            ap=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(rp++));
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(ap++));
-            }
-            textureRecord->depth=16;
-        }
-
-        // New version: Takes 20 ms on a 800x800 texture...
-        if (isImageMatrixBytes && numMatrixPlanes==2){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rpb=(GLubyte*) ((size_t) byteMatrix);
-            apb=(GLubyte*) ((size_t) rpb + (size_t) iters);
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= *(rpb++);
-                *(texturePointer_b++)= *(apb++);
-            }
-            textureRecord->depth=16;
-        }
-
-        // Improved version: Takes 43 ms on a 800x800 texture...
-        if (isImageMatrixDoubles && numMatrixPlanes==3){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rp=(double*) ((size_t) doubleMatrix);
-            gp=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            bp=(double*) ((size_t) gp + (size_t) iters * sizeof(double));
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(rp++));
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(gp++));
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(bp++));
-            }
-            textureRecord->depth=24;
-        }
-
-        // Improved version: Takes 25 ms on a 800x800 texture...
-        if (isImageMatrixBytes && numMatrixPlanes==3){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rpb=(GLubyte*) ((size_t) byteMatrix);
-            gpb=(GLubyte*) ((size_t) rpb + (size_t) iters);
-            bpb=(GLubyte*) ((size_t) gpb + (size_t) iters);
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= *(rpb++);
-                *(texturePointer_b++)= *(gpb++);
-                *(texturePointer_b++)= *(bpb++);
-            }
-            textureRecord->depth=24;
+        if (texturePointer == NULL) {
+            // Zero-Copy path. Just pass a pointer to our input matrix:
+            texturePointer = (GLuint*) byteMatrix;
+            textureRecord->textureMemory = texturePointer;
+            // Set size to zero, so PsychCreateTexture() does not free() our
+            // input buffer:
+            textureRecord->textureMemorySizeBytes = 0;
         }
+        else {
+            // Interleave the planes of the input matrix, or just copy an already interleaved one:
+            PsychInitTexelConversion(&conv, iters, numMatrixPlanes, c_layout, FALSE);
+            conv.dstByte = (GLubyte*) texturePointer;
 
-        // Improved version: Takes 55 ms on a 800x800 texture...
-        if (isImageMatrixDoubles && numMatrixPlanes==4){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rp=(double*) ((size_t) doubleMatrix);
-            gp=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            bp=(double*) ((size_t) gp + (size_t) iters * sizeof(double));
-            ap=(double*) ((size_t) bp + (size_t) iters * sizeof(double));
-            if (bigendian) {
-                // Code for big-endian machines like PowerPC:
-                for(ix=0;ix<iters;ix++){
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(ap++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(rp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(gp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(bp++));
-                }
+            if (isImageMatrixDoubles) {
+                conv.srcDouble = doubleMatrix;
+                PsychSetByteTexelConversion(&conv, offsetd, scaled);
             }
             else {
-                // Code for little-endian machines like Intel Pentium:
-                for(ix=0;ix<iters;ix++){
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(bp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(gp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(rp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(ap++));
-                }
+                conv.srcByte = byteMatrix;
             }
 
-            textureRecord->depth=32;
-        }
-
-        // Improved version: Takes 33 ms on a 800x800 texture...
-        if (isImageMatrixBytes && numMatrixPlanes==4){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rpb=(GLubyte*) ((size_t) byteMatrix);
-            gpb=(GLubyte*) ((size_t) rpb + (size_t) iters);
-            bpb=(GLubyte*) ((size_t) gpb + (size_t) iters);
-            apb=(GLubyte*) ((size_t) bpb + (size_t) iters);
-            if (bigendian) {
-                // Code for big-endian machines like PowerPC:
-                for(ix=0;ix<iters;ix++){
-                    *(texturePointer_b++)= *(apb++);
-                    *(texturePointer_b++)= *(rpb++);
-                    *(texturePointer_b++)= *(gpb++);
-                    *(texturePointer_b++)= *(bpb++);
+            // RGBA texels are stored as one 32 bit BGRA pixel in native byte order:
+            if (numMatrixPlanes == 4) {
+                if (bigendian) {
+                    // Code for big-endian machines like PowerPC: ARGB byte order.
+                    conv.srcPlane[0] = 3; conv.srcPlane[1] = 0; conv.srcPlane[2] = 1; conv.srcPlane[3] = 2;
                 }
-            }
-            else {
-                // Code for little-endian machines like Intel Pentium:
-                for(ix=0;ix<iters;ix++){
-                    *(texturePointer_b++)= *(bpb++);
-                    *(texturePointer_b++)= *(gpb++);
-                    *(texturePointer_b++)= *(rpb++);
-                    *(texturePointer_b++)= *(apb++);
+                else {
+                    // Code for little-endian machines like Intel Pentium: BGRA byte order.
+                    conv.srcPlane[0] = 2; conv.srcPlane[1] = 1; conv.srcPlane[2] = 0; conv.srcPlane[3] = 3;
                 }
             }
 
-            textureRecord->depth=32;
+            PsychConvertTexels(&conv);
         }
     } // End of 8 bpc texture conversion code (fast-path for LDR textures)
 
@@ -742,11 +1063,17 @@ PsychError SCREENMakeTexture(void)
 
     // The memory buffer now contains our texture data in a format ready to submit to OpenGL.
 
+    // Done with writing the upload buffer? PsychCreateTexture() sources the texture content from it then:
+    if (async_upload) PsychUnmapTextureUploadBuffer(windowRecord, textureRecord);
+
     // Assign parent window and copy its inheritable properties:
     PsychAssignParentWindow(textureRecord, windowRecord);
 
-    // Texture orientation is zero aka transposed aka non-renderswapped.
-    textureRecord->textureOrientation = ((assume_texorientation != 2) && (assume_texorientation != 3)) ? 0 : 2;
+    // Texture orientation is zero aka transposed aka non-renderswapped, or upside-down (3) for C memory layout matrices.
+    if ((assume_texorientation == 2) || (assume_texorientation == 3))
+        textureRecord->textureOrientation = 2;
+    else
+        textureRecord->textureOrientation = (c_layout) ? 3 : 0;
 
     // This is our best guess about the number of image channels:
     textureRecord->nrchannels = numMatrixPlanes;
@@ -779,6 +1106,10 @@ PsychError SCREENMakeTexture(void)
 
         // Assign GLSL filter-/lookup-shaders if needed:
         PsychAssignHighPrecisionTextureShaders(textureRecord, windowRecord, usefloatformat, (usepoweroftwo & 2) ? 1 : 0);
+
+        // Content of this texture never changes, unless it gets drawn into, so it can be
+        // packed into a texture atlas for fast drawing via Screen('DrawTextures'):
+        textureRecord->atlasEligible = TRUE;
     }
 
     // User specified override shader for this texture provided? This is useful for
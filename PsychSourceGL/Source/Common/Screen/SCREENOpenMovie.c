@@ -143,6 +143,25 @@ static char synopsisString[] =
         "Please note that OverrideEOTF is only accepted at the moment for playback with pixelFormat 11, otherwise it is rejected.\n"
         "You rarely need this override, unless you try to play back a movie format on a GStreamer version too old to detect the "
         "proper EOTF. Most likely if you try to play back HDR content on a GStreamer version older than 1.18.0.\n"
+        "DecodeAhead=n -- Use a decoder thread during active playback, which copies up to n decoded video frames ahead of time "
+        "into upload buffers of the graphics driver, with n at most 16. Screen('GetMovieImage') then only needs to start an "
+        "asynchronous upload of the next frame, which avoids stalls of your drawing loop on the copy of high resolution frames, "
+        "e.g., of 4k or HDR movies. Combine with an 'async' flag of 4 and a suitable 'preloadSecs' to also allow the decoder to "
+        "work ahead. Not supported for OpenGL-ES, Bayer filtered movies and 16 bpc RGBA pixelFormats, and needs GStreamer 1.10 "
+        "or later. Decode-ahead statistics are returned by Screen('PlayMovie').\n"
+        "MovieIndex=n -- Build an index of all video frames with their presentation timestamps and keyframes at open time, for "
+        "fast and frame accurate random access with Screen('SetMovieTimeIndex') and Screen('GetMovieImage') with a 'timeindex'. "
+        "Seeks to frame indices become seeks to the exact timestamp of the frame, and in manual fetch mode seeks to the "
+        "next frames, or to later frames before the next keyframe, step forward without restarting decoding at a keyframe. "
+        "The index pass only parses, but doesn't decode, the movie. n = 1 stores the index in a cache file next to the movie, "
+        "with extension .ptbindex, and loads it from there when the unchanged movie gets opened again. n = 2 never uses a cache "
+        "file. n = 0 disables the index, which is the default. Needs GStreamer 1.10 or later and a local movie file for the cache "
+        "file. The index gets disabled if its timestamps do not match the decoded frames.\n"
+        "FrameCache=n -- Keep copies of up to n decoded frames, with n at most 64, which were the targets of seeks in manual fetch "
+        "mode, and replace the least recently used one when full. Repeated seeks to cached frames, e.g., jumps between the same "
+        "clip segments in each trial, then return the frame from memory, without any seek in the movie. Best combined with "
+        "MovieIndex. Beware of memory consumption with high resolution movies. Needs GStreamer 1.6 or later. Frame index and "
+        "seek statistics are returned by Screen('SetMovieTimeIndex').\n"
         "AudioSink=GStreamerSinkSpec -- GStreamerSinkSpec is a GStreamer gst-launch line style specification for a audio sink "
         "plugin and its parameters. This allows to customize where the audio of a movie is sent during playback and with which "
         "parameters. By default, the autoaudiosink plugin is used, which automatically chooses audio output and parameters, based "
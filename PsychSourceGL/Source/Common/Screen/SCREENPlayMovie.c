@@ -24,7 +24,7 @@
 
 #include "Screen.h"
 
-static char useString[] = "[droppedframes] = Screen('PlayMovie', moviePtr, rate, [loop], [soundvolume]);";
+static char useString[] = "[droppedframes] [, decodeStats] = Screen('PlayMovie', moviePtr, rate, [loop], [soundvolume]);";
 static char synopsisString[] = 
 "Start playback of movie associated with movieobject 'moviePtr'. 'rate' defines the desired playback rate: 0 == Stop playback, "
 "1 == Normal speed forward, -1 == Normal speed backward, ... . Not all movie files allow reverse playback or playback at other "
@@ -40,7 +40,18 @@ static char synopsisString[] =
 "You can choose the sound volume with low overhead while playback is active by calling this function, as long as you provide the "
 "same parameters for all other settings as the ones you used when starting playback, ie. only 'soundvolume' may differ.\n"
 "If the function is called to stop playback, it will return the number of frames that needed to be dropped in order to keep "
-"video playback in sync with realtime and audio playback. Otherwise it returns zero.\n";
+"video playback in sync with realtime and audio playback. Otherwise it returns zero.\n"
+"The optional 'decodeStats' struct reports statistics since start of playback about decode-ahead of video frames, as "
+"enabled via the 'movieOptions' keyword DecodeAhead in Screen('OpenMovie'), and about dropped frames: 'DecodeAhead' "
+"Maximum number of decoded frames queued ahead, or zero if decode-ahead is disabled or unsupported. 'Queued' Number of "
+"frames currently queued. 'MaxQueued' and 'MeanQueued' Maximum and mean number of queued frames at the time of a "
+"frame fetch by Screen('GetMovieImage'). 'Fetches' Number of frame fetches from the queue. 'Underruns' Number of "
+"fetches which found no decoded frame ready. 'Skipped' Number of queued frames skipped, either to reach a requested "
+"'timeindex' in Screen('GetMovieImage'), or to keep audio-video sync. 'Fallbacks' Number of frames which did not fit "
+"into their upload buffer and got uploaded synchronously. 'SinkDrops' Number of frames dropped by the playback engine "
+"because its queue was full. 'DroppedFrames' Number of dropped frames, as detected from gaps in the presentation "
+"timestamps of fetched frames - the same as 'droppedframes'. To query statistics while playback is active, call "
+"the function with the same parameters as were used to start playback.\n";
 
 static char seeAlsoString[] = "CloseMovie PlayMovie GetMovieImage GetMovieTimeIndex SetMovieTimeIndex";	 
 
@@ -59,7 +70,7 @@ PsychError SCREENPlayMovie(void)
 
     PsychErrorExit(PsychCapNumInputArgs(4));            // Max. 4 input args.
     PsychErrorExit(PsychRequireNumInputArgs(2));        // Min. 2 input args required.
-    PsychErrorExit(PsychCapNumOutputArgs(1));           // Max. 1 output args.
+    PsychErrorExit(PsychCapNumOutputArgs(2));           // Max. 2 output args.
 
     // Get the movie handle:
     PsychCopyInIntegerArg(1, TRUE, &moviehandle);
@@ -84,6 +95,9 @@ PsychError SCREENPlayMovie(void)
     // Return optional count of dropped frames:
     PsychCopyOutDoubleArg(1, FALSE, dropped);
 
+    // Return optional decode-ahead and frame drop statistics:
+    PsychCopyOutMovieDecodeStats(moviehandle, 2);
+
     // Ready!
     return(PsychError_none);
 }
@@ -128,6 +128,8 @@ static char synopsisString[] =
     "\noldMode = Screen('Preference', 'DefaultVideocaptureEngine', [newmode (0=Quicktime - unsupported, 1=LibDC1394-Firewire, 2=LibARVideo - unsupported, 3=GStreamer)]);"
     "\noldMode = Screen('Preference', 'OverrideMultimediaEngine', [newmode (0=Legacy-Quicktime - unsupported, 1=GStreamer)]);"
     "\noldLevel = Screen('Preference', 'WindowShieldingLevel', [newLevel (0 = Behind all other windows - 2000 = In front of all other windows, the default)]);"
+    "\noldNumThreads = Screen('Preference', 'MakeTextureThreads', [numThreads (0 = One per processor core up to 8, the default. 1 = Single-threaded)]);"
+    "\noldEnable = Screen('Preference', 'FuseHookChainShaders', [enable (1 = Fuse point-operation shader passes of imaging pipeline hook chains. 0 = Don't fuse, the default)]);"
     "\nresiduals = Screen('Preference', 'SynchronizeDisplays', syncMethod [, screenId]);"
     "\noldMappings = Screen('Preference', 'ScreenToHead', screenId [, newHeadId, newCrtcId][, rank=0]);"
 
@@ -171,6 +173,7 @@ PsychError SCREENPreference(void)
     psych_bool          preferenceNameArgumentValid, booleanInput, ignoreCase, tempFlag, textAlphaBlendingFlag, suppressAllWarningsFlag;
     int                 numInputArgs, i, newFontStyleNumber, newFontSize, tempInt, tempInt2, tempInt3, tempInt4;
     double              returnDoubleValue, inputDoubleValue;
+    psych_int64         tempInt64;
     double              maxStddev, maxDeviation, maxDuration;
     int                 minSamples;
     double              *dheads = NULL;
@@ -387,12 +390,30 @@ PsychError SCREENPreference(void)
                     PsychPrefStateSet_WindowShieldingLevel(tempInt);
                 }
             preferenceNameArgumentValid=TRUE;
+        }else
+            if(PsychMatch(preferenceName, "MakeTextureThreads")){
+                PsychCopyOutDoubleArg(1, kPsychArgOptional, PsychPrefStateGet_MakeTextureThreads());
+                if(numInputArgs==2){
+                    PsychCopyInIntegerArg(2, kPsychArgRequired, &tempInt);
+                    if (tempInt < 0) PsychErrorExitMsg(PsychError_user, "Invalid negative number of 'MakeTextureThreads' provided!");
+                    PsychPrefStateSet_MakeTextureThreads(tempInt);
+                }
+            preferenceNameArgumentValid=TRUE;
+        }else
+            if(PsychMatch(preferenceName, "FuseHookChainShaders")){
+                PsychCopyOutDoubleArg(1, kPsychArgOptional, PsychPrefStateGet_FuseHookChainShaders());
+                if(numInputArgs==2){
+                    PsychCopyInIntegerArg(2, kPsychArgRequired, &tempInt);
+                    PsychPrefStateSet_FuseHookChainShaders((tempInt > 0) ? TRUE : FALSE);
+                }
+            preferenceNameArgumentValid=TRUE;
         }else
             if(PsychMatch(preferenceName, "ConserveVRAM") || PsychMatch(preferenceName, "Workarounds1")){
-                    PsychCopyOutDoubleArg(1, kPsychArgOptional, PsychPrefStateGet_ConserveVRAM());
+                    PsychCopyOutDoubleArg(1, kPsychArgOptional, (double) PsychPrefStateGet_ConserveVRAM());
                     if(numInputArgs==2){
-                        PsychCopyInIntegerArg(2, kPsychArgRequired, &tempInt);
-                        PsychPrefStateSet_ConserveVRAM(tempInt);
+                        PsychCopyInIntegerArg64(2, kPsychArgRequired, &tempInt64);
+                        if (tempInt64 < 0) PsychErrorExitMsg(PsychError_user, "Invalid negative 'ConserveVRAM' flags provided!");
+                        PsychPrefStateSet_ConserveVRAM((psych_uint64) tempInt64);
                     }
             preferenceNameArgumentValid=TRUE;
         }else
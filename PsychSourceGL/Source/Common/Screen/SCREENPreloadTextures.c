@@ -26,8 +26,8 @@
 #include "Screen.h"
 
 // If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
-static char useString[] = "[resident [texidresident]] = Screen('PreloadTextures', windowPtr [, texids]);";
-//                                                                                1          2
+static char useString[] = "[resident [texidresident]] = Screen('PreloadTextures', windowPtr [, texids][, waitSecs]);";
+//                                                                                1          2          3
 static char synopsisString[] = 
 "Try to preload textures into VRAM to facilitate fast drawing. This method tries "
 "to upload textures into the local (and fast) VRAM of your graphics hardware before "
@@ -39,7 +39,13 @@ static char synopsisString[] =
 "The return value 'resident' tells you, if all requested textures could be preloaded. A value of 1 "
 "means full success. The 'texidresident' vector tells you for each texture, if that "
 "specific texture could be preloaded. Preloading requested textures can fail if your gfx-hardware "
-"has an insufficient amount of free VRAM memory. ";
+"has an insufficient amount of free VRAM memory.\n"
+"If the optional \"waitSecs\" is given, no preloading is done. Instead, the function waits up to \"waitSecs\" "
+"seconds for completion of asynchronous uploads of texture content, as requested by Screen('MakeTexture') "
+"with specialFlags 64. If no \"texids\" are given, it waits for all textures of \"windowPtr\". A \"waitSecs\" of zero only checks for completion, a value of Inf waits until all "
+"requested textures are ready. 'resident' and 'texidresident' then tell if all requested textures, or each "
+"specific texture, is ready for drawing without waiting for its upload. Drawing a texture whose upload is "
+"still in progress is fine, it just waits for the upload to complete. ";
 
 static char seeAlsoString[] = "MakeTexture DrawTexture GetMovieImage";	 
 
@@ -57,13 +63,14 @@ PsychError SCREENPreloadTextures(void)
         psych_bool                                 failed = false;
         GLclampf                                maxprio = 1.0f;
         GLenum                                  target;
+        double                                  waitSecs, now;
 
 	//all sub functions should have these two lines
 	PsychPushHelp(useString, synopsisString,seeAlsoString);
 	if(PsychIsGiveHelp()){PsychGiveHelp();return(PsychError_none);};
 	
 	//check for superfluous arguments
-	PsychErrorExit(PsychCapNumInputArgs(2));        //The maximum number of inputs
+	PsychErrorExit(PsychCapNumInputArgs(3));        //The maximum number of inputs
 	PsychErrorExit(PsychRequireNumInputArgs(1));    //The minimum number of inputs
 	PsychErrorExit(PsychCapNumOutputArgs(2));       //The maximum number of outputs
 	
@@ -74,7 +81,53 @@ PsychError SCREENPreloadTextures(void)
 	isArgThere = PsychIsArgPresent(PsychArgIn, 2);
         PsychAllocInIntegerListArg(2, FALSE, &n, &texhandles);
         if (n < 1) isArgThere=FALSE;
-        
+
+        // Optional 'waitSecs' provided? Then only check or wait for completion of asynchronous texture uploads:
+        if (PsychCopyInDoubleArg(3, FALSE, &waitSecs)) {
+            if (waitSecs < 0) PsychErrorExitMsg(PsychError_user, "Invalid 'waitSecs' provided. Must be zero or positive.");
+
+            PsychCreateVolatileWindowRecordPointerList(&numWindows, &windowRecordArray);
+
+            // Collect all requested textures, or all textures of windowRecord if no handles are provided:
+            if (!isArgThere) {
+                n=0;
+                for(i=0; i<numWindows; i++) {
+                    if ((windowRecordArray[i]->windowType==kPsychTexture) && (PsychGetParentWindow(windowRecordArray[i]) == PsychGetParentWindow(windowRecord)))
+                        windowRecordArray[n++] = windowRecordArray[i];
+                }
+            }
+            else {
+                for (i=0; i<n; i++) {
+                    texwin = NULL;
+                    if (IsWindowIndex(texhandles[i])) FindWindowRecord(texhandles[i], &texwin);
+                    if (!texwin || texwin->windowType!=kPsychTexture) {
+                        printf("PTB-ERROR! Screen('PreloadTextures'): Entry %i of texture handle vector (handle %i) is not a texture handle!\n", i, texhandles[i]);
+                        PsychDestroyVolatileWindowRecordPointerList(windowRecordArray);
+                        PsychErrorExitMsg(PsychError_user, "At least one texture handle in texids-vector was invalid! Aborted.");
+                    }
+                }
+            }
+
+            success = NULL;
+            PsychAllocOutDoubleArg(1, FALSE, &success);
+            PsychAllocOutBooleanMatArg(2, FALSE, n, 1, 1, (PsychNativeBooleanType **) &residency);
+            *success = 1;
+
+            // Wait for each texture in turn, within the total time budget:
+            PsychGetAdjustedPrecisionTimerSeconds(&now);
+            waitSecs += now;
+            for (i=0; i<n; i++) {
+                if (isArgThere) FindWindowRecord(texhandles[i], &texwin); else texwin = windowRecordArray[i];
+                PsychGetAdjustedPrecisionTimerSeconds(&now);
+                residency[i] = PsychWaitForTextureUpload(texwin, waitSecs - now);
+                if (!residency[i]) *success = 0;
+            }
+
+            PsychDestroyVolatileWindowRecordPointerList(windowRecordArray);
+
+            return(PsychError_none);
+        }
+
         // Enable this windowRecords framebuffer as current drawingtarget:
         PsychSetDrawingTarget(windowRecord);
 
@@ -24,7 +24,7 @@
 
 #include "Screen.h"
 
-static char useString[] = "[oldtimeindex] = Screen('SetMovieTimeIndex', moviePtr, timeindex [, indexIsFrames=0]);";
+static char useString[] = "[oldtimeindex] [, seekStats] = Screen('SetMovieTimeIndex', moviePtr, timeindex [, indexIsFrames=0]);";
 static char synopsisString[] =	"Set current time index for movie object with handle 'moviePtr'.\n\n"
 								"The new time index is specified in 'timeindex'. By default, or if the "
 								"optional 'indexIsFrames' flag is set to zero, 'timeindex' is in seconds "
@@ -34,7 +34,17 @@ static char synopsisString[] =	"Set current time index for movie object with han
 								"Specifying a new timeindex in seconds is usually faster than specifying a "
 								"timeindex in frames.\n\n"
 								"The function optionally returns the old position in seconds in the return "
-								"argument 'oldtimeindex'.\n";
+								"argument 'oldtimeindex'.\n\n"
+								"The optional 'seekStats' struct reports statistics since opening of the movie about "
+								"the frame index and frame cache, as enabled via the 'movieOptions' keywords MovieIndex "
+								"and FrameCache in Screen('OpenMovie'), and about seeks: 'IndexedFrames' Number of frames "
+								"in the frame index, or zero if there isn't one. 'Keyframes' Number of keyframes in the "
+								"frame index. 'FrameCache' Maximum number of cached frames, or zero if the frame cache is "
+								"disabled. 'CachedFrames' Number of currently cached frames. 'Seeks' Number of seeks, "
+								"including seeks by Screen('GetMovieImage') with a 'timeindex'. 'SkippedSeeks' Number of "
+								"seeks to the frame which was already the next one. 'SteppedSeeks' Number of seeks done "
+								"by stepping forward. 'CacheHits' and 'CacheMisses' Number of seeks whose target frame was "
+								"and was not in the frame cache.\n";
 
 static char seeAlsoString[] = "CloseMovie PlayMovie GetMovieImage GetMovieTimeIndex SetMovieTimeIndex";
 
@@ -50,7 +60,7 @@ PsychError SCREENSetMovieTimeIndex(void)
 
     PsychErrorExit(PsychCapNumInputArgs(3));            // Max. 3 input args.
     PsychErrorExit(PsychRequireNumInputArgs(2));        // Min. 2 input args required.
-    PsychErrorExit(PsychCapNumOutputArgs(1));           // One output arg.
+    PsychErrorExit(PsychCapNumOutputArgs(2));           // Max. 2 output args.
 
     // Get the movie handle:
     PsychCopyInIntegerArg(1, TRUE, &moviehandle);
@@ -73,6 +83,9 @@ PsychError SCREENSetMovieTimeIndex(void)
     // Setup and return current movie time index:
     PsychCopyOutDoubleArg(1, FALSE, PsychSetMovieTimeIndex(moviehandle, timeindex, (psych_bool) indexIsFrames));
 
+    // Return optional frame index, frame cache and seek statistics:
+    PsychCopyOutMovieSeekStats(moviehandle, 2);
+
     // Ready!
     return(PsychError_none);
 }
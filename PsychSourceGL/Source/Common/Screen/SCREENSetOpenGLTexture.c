@@ -143,7 +143,8 @@ PsychError SCREENSetOpenGLTexture(void)
         PsychErrorExitMsg(PsychError_user, "You tried to set invalid (negative) texture depth.");
     }
     
-    // Ok, setup texture record for texture:
+    // Ok, setup texture record for texture, after removing its old content from the texture atlas, if any:
+    PsychReleaseAtlasTexture(textureRecord);
     PsychInitWindowRecordTextureFields(textureRecord);
     textureRecord->depth = d;
 	
@@ -113,6 +113,14 @@ void            PsychTestForGLErrorsC(int lineNum, const char *funcName, const c
 GLdouble        *PsychExtractQuadVertexFromRect(double *rect, int vertexNumber, GLdouble *vertex);
 void            PsychPrepareRenderBatch(PsychWindowRecordType *windowRecord, int coords_pos, int* coords_count, double** xy, int colors_pos, int* colors_count, int* colorcomponent_count, double** colors, unsigned char** bytecolors, int sizes_pos, int* sizes_count, double** size, psych_bool usefloat);
 void            PsychWaitPixelSyncToken(PsychWindowRecordType *windowRecord, psych_bool flushOnly);
+void*           PsychMapStreamingVBO(PsychWindowRecordType *windowRecord, size_t size, GLintptr *offset);
+void            PsychUnmapStreamingVBO(PsychWindowRecordType *windowRecord);
+void            PsychDeleteStreamingVBO(PsychWindowRecordType *windowRecord);
+psych_bool      PsychSetupStreamingVertexArrays(PsychWindowRecordType *windowRecord, int nrvertices, double *xy, int mc, double *colors, unsigned char *bytecolors, double *sizes);
+#define         kPsychShapeRect     0
+#define         kPsychShapeOval     1
+psych_bool      PsychDrawInstancedShapes(PsychWindowRecordType *windowRecord, int shape, int numRects, double *xy, int nc, int mc, double *colors, unsigned char *bytecolors, int nrsize, double *penSizes, int numSlices);
+void            PsychDeleteInstancedShapes(PsychWindowRecordType *windowRecord);
 psych_bool      PsychIsGLClassic(PsychWindowRecordType *windowRecord);
 GLenum          PsychGLFloatType(PsychWindowRecordType *windowRecord);
 #define PSYCHGLFLOAT PsychGLFloatType(windowRecord)
@@ -138,9 +146,13 @@ void PsychDrawDisc(PsychWindowRecordType *windowRecord, float xc, float yc, floa
 int PsychSwitchCompressedStereoDrawBuffer(PsychWindowRecordType *windowRecord, int newbuffer);
 void PsychComposeCompressedStereoBuffer(PsychWindowRecordType *windowRecord);
 
+// Helper routine for asynchronous readback via 'GetImage': Defined in SCREENGetImage.c
+void PsychDeleteAsyncReadbacks(PsychWindowRecordType *windowRecord);
+
 // Helper routines for text renderers:
 void            PsychCleanupTextRenderer(PsychWindowRecordType* windowRecord);
 psych_bool      PsychLoadTextRendererPlugin(PsychWindowRecordType* windowRecord);
+psych_bool      PsychGetTextRendererCacheStats(PsychWindowRecordType* windowRecord, double* stats);
 void            PsychDrawCharText(PsychWindowRecordType* winRec, const char* textString, double* xp, double* yp, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor, PsychRectType* boundingbox);
 PsychError      PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* boundingbox, unsigned int stringLengthChars, double* textUniDoubleString, double* xp, double* yp, double* theight, double* xAdvance, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor, int swapTextDirection);
 PsychError      PsychOSDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* boundingbox, unsigned int stringLengthChars, double* textUniDoubleString, double* xp, double* yp, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor);
@@ -251,6 +263,7 @@ PsychError SCREENGetMouseHelper(void);
 PsychError SCREENResolution(void);
 PsychError SCREENResolutions(void);
 PsychError SCREENWaitUntilAsyncFlipCertain(void);
+PsychError SCREENAsyncFlipQueue(void);
 PsychError SCREENCreateMovie(void);
 PsychError SCREENFinalizeMovie(void);
 PsychError SCREENAddAudioBufferToMovie(void);
@@ -24,6 +24,7 @@
 #include "Screen.h"
 
 void PsychCleanupSCREENFillPoly(void);
+void PsychCleanupSCREENMakeTexture(void);
 
 PsychError ScreenExitFunction(void)
 {
@@ -43,6 +44,10 @@ PsychError ScreenExitFunction(void)
 	// This is defined in Common/Screen/SCREENFillPoly.c
 	PsychCleanupSCREENFillPoly();
 
+	// Shutdown worker threads of SCREEN('MakeTexture');
+	// This is defined in Common/Screen/SCREENMakeTexture.c
+	PsychCleanupSCREENMakeTexture();
+
 	// Release our internal locale object for character <-> unicode conversion:
 	PsychSetUnicodeTextConversionLocale(NULL);
 
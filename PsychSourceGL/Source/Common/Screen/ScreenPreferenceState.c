@@ -75,7 +75,7 @@ static int                              screenSkipSyncTests;            // 0=Do
 //Debug preference state
 static psych_bool                       TimeMakeTextureFlag;
 static int                              screenVisualDebugLevel;
-static int                              screenConserveVRAM;
+static psych_uint64                     screenConserveVRAM;
 // If EmulateOldPTB is set to true, then try to behave like the old OS-9 PTB:
 static psych_bool                       EmulateOldPTB;
 // Support for real 3D rendering enabled? Any non-zero value enables 3D rendering, a setting of 1 with defaults, values > 1 enable additional features. Disabled by default.
@@ -89,6 +89,8 @@ static int                              windowShieldingLevel;           // Level
                                                                         // number is OS specific. This value is used at window open time for each window.
 static double                           frameRectLadderCorrection;      // Tweak factor to apply in SCREENFrameRect.c for different GPU's.
 static psych_bool                       suppressAllWarnings;
+static int                              makeTextureThreads;             // Number of threads for image matrix conversion in 'MakeTexture'. 0 = Auto-select.
+static psych_bool                       fuseHookChainShaders;           // Fuse point-operation shader slots of imaging pipeline hook chains into single passes?
 
 // General level of verbosity:
 // 0 = Shut up.
@@ -136,6 +138,8 @@ void PrepareScreenPreferences(void)
     windowShieldingLevel=2000;
     frameRectLadderCorrection=-1.0;
     suppressAllWarnings=FALSE;
+    makeTextureThreads=0;
+    fuseHookChainShaders=FALSE;
 
     // Default level of verbosity is 3:
     Verbosity=3;
@@ -348,12 +352,12 @@ void PsychPrefStateSet_VBLEndlineMaxFactor(double inputDoubleValue)
 
 // Settings for conserving VRAM usage by disabling certain features.
 // Also used for various workarounds and special op modes.
-int PsychPrefStateGet_ConserveVRAM(void)
+psych_uint64 PsychPrefStateGet_ConserveVRAM(void)
 {
     return(screenConserveVRAM);
 }
 
-void PsychPrefStateSet_ConserveVRAM(int level)
+void PsychPrefStateSet_ConserveVRAM(psych_uint64 level)
 {
     screenConserveVRAM = level;
 }
@@ -419,6 +423,26 @@ void PsychPrefStateSet_WindowShieldingLevel(int level)
     windowShieldingLevel = level;
 }
 
+int PsychPrefStateGet_MakeTextureThreads(void)
+{
+    return(makeTextureThreads);
+}
+
+void PsychPrefStateSet_MakeTextureThreads(int numThreads)
+{
+    makeTextureThreads = numThreads;
+}
+
+psych_bool PsychPrefStateGet_FuseHookChainShaders(void)
+{
+    return(fuseHookChainShaders);
+}
+
+void PsychPrefStateSet_FuseHookChainShaders(psych_bool enable)
+{
+    fuseHookChainShaders = enable;
+}
+
 // Correction tweak offset for proper Screen('FrameRect') behaviour:
 void PsychPrefStateSet_FrameRectCorrection(double level)
 {
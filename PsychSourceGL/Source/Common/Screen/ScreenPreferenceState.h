@@ -72,8 +72,8 @@ void PsychPrefStateSet_SkipSyncTests(int level);
 int PsychPrefStateGet_VisualDebugLevel(void);
 void PsychPrefStateSet_VisualDebugLevel(int level);
 
-int PsychPrefStateGet_ConserveVRAM(void);
-void PsychPrefStateSet_ConserveVRAM(int level);
+psych_uint64 PsychPrefStateGet_ConserveVRAM(void);
+void PsychPrefStateSet_ConserveVRAM(psych_uint64 level);
 
 psych_bool PsychPrefStateGet_EmulateOldPTB(void);
 void PsychPrefStateSet_EmulateOldPTB(psych_bool level);
@@ -114,6 +114,14 @@ void PsychPrefStateSet_VideoCaptureEngine(int mode);
 void PsychPrefStateSet_WindowShieldingLevel(int level);
 int PsychPrefStateGet_WindowShieldingLevel(void);
 
+// Number of threads for image matrix conversion in 'MakeTexture':
+int PsychPrefStateGet_MakeTextureThreads(void);
+void PsychPrefStateSet_MakeTextureThreads(int numThreads);
+
+// Fusion of point-operation shader slots in imaging pipeline hook chains:
+psych_bool PsychPrefStateGet_FuseHookChainShaders(void);
+void PsychPrefStateSet_FuseHookChainShaders(psych_bool enable);
+
 // Correction tweak offset for proper Screen('FrameRect') behaviour:
 void PsychPrefStateSet_FrameRectCorrection(double level);
 double PsychPrefStateGet_FrameRectCorrection(void);
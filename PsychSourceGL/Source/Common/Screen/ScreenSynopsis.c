@@ -118,14 +118,14 @@ const char** InitializeSynopsis(void)
 
     // Copy an image, very quickly, between textures and onscreen windows
     synopsis[i++] = "\n% Copy an image, very quickly, between textures, offscreen windows and onscreen windows.";
-    synopsis[i++] = "[resident [texidresident]] = Screen('PreloadTextures', windowPtr [, texids]);";
+    synopsis[i++] = "[resident [texidresident]] = Screen('PreloadTextures', windowPtr [, texids][, waitSecs]);";
     synopsis[i++] = "Screen('DrawTexture', windowPointer, texturePointer [,sourceRect] [,destinationRect] [,rotationAngle] [, filterMode] [, globalAlpha] [, modulateColor] [, textureShader] [, specialFlags] [, auxParameters]);";
     synopsis[i++] = "Screen('DrawTextures', windowPointer, texturePointer(s) [, sourceRect(s)] [, destinationRect(s)] [, rotationAngle(s)] [, filterMode(s)] [, globalAlpha(s)] [, modulateColor(s)] [, textureShader] [, specialFlags] [, auxParameters]);";
     synopsis[i++] = "Screen('CopyWindow', srcWindowPtr, dstWindowPtr, [srcRect], [dstRect], [copyMode])";
 
     // Copy an image, slowly, between matrices and windows
     synopsis[i++] = "\n% Copy an image, slowly, between matrices and windows :";
-    synopsis[i++] = "imageArray=Screen('GetImage', windowPtr [,rect] [,bufferName] [,floatprecision=0] [,nrchannels=3])";
+    synopsis[i++] = "imageArray=Screen('GetImage', windowPtr [,rect] [,bufferName] [,floatprecision=0] [,nrchannels=3] [,async=0])";
     synopsis[i++] = "Screen('PutImage', windowPtr, imageArray [,rect]);";
 
     // Synchronize with the window's screen (on-screen only):
@@ -135,6 +135,9 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[VBLTimestamp StimulusOnsetTime FlipTimestamp Missed Beampos] = Screen('AsyncFlipEnd', windowPtr);";
     synopsis[i++] = "[VBLTimestamp StimulusOnsetTime FlipTimestamp Missed Beampos] = Screen('AsyncFlipCheckEnd', windowPtr);";
     synopsis[i++] = "[VBLTimestamp StimulusOnsetTime swapCertainTime] = Screen('WaitUntilAsyncFlipCertain', windowPtr);";
+    synopsis[i++] = "queueLength = Screen('AsyncFlipQueueCreate', windowPtr [, queueLength=3]);";
+    synopsis[i++] = "[frameIndex, numPresented] = Screen('AsyncFlipQueue', windowPtr [, when=0] [, dontclear=0] [, dontsync=0]);";
+    synopsis[i++] = "[results, numPending] = Screen('AsyncFlipQueueResults', windowPtr [, waitForAll=0]);";
     synopsis[i++] = "[info] = Screen('GetFlipInfo', windowPtr [, infoType=0] [, auxArg1]);";
     synopsis[i++] = "[telapsed] = Screen('DrawingFinished', windowPtr [, dontclear] [, sync]);";
     synopsis[i++] = "framesSinceLastWait = Screen('WaitBlanking', windowPtr [, waitFrames]);";
@@ -203,9 +206,9 @@ const char** InitializeSynopsis(void)
     synopsis[i++] =  "[ moviePtr [duration] [fps] [width] [height] [count] [aspectRatio] [hdrStaticMetaData]]=Screen('OpenMovie', windowPtr, moviefile [, async=0] [, preloadSecs=1] [, specialFlags1=0][, pixelFormat=4][, maxNumberThreads=-1][, movieOptions]);";
     synopsis[i++] =  "Screen('CloseMovie' [, moviePtr=all]);";
     synopsis[i++] =  "[ texturePtr [timeindex]]=Screen('GetMovieImage', windowPtr, moviePtr, [waitForImage], [fortimeindex], [specialFlags = 0] [, specialFlags2 = 0]);";
-    synopsis[i++] =  "[droppedframes] = Screen('PlayMovie', moviePtr, rate, [loop], [soundvolume]);";
+    synopsis[i++] =  "[droppedframes] [, decodeStats] = Screen('PlayMovie', moviePtr, rate, [loop], [soundvolume]);";
     synopsis[i++] =  "timeindex = Screen('GetMovieTimeIndex', moviePtr);";
-    synopsis[i++] =  "[oldtimeindex] = Screen('SetMovieTimeIndex', moviePtr, timeindex [, indexIsFrames=0]);";
+    synopsis[i++] =  "[oldtimeindex] [, seekStats] = Screen('SetMovieTimeIndex', moviePtr, timeindex [, indexIsFrames=0]);";
     synopsis[i++] =  "moviePtr = Screen('CreateMovie', windowPtr, movieFile [, width][, height][, frameRate=30][, movieOptions][, numChannels=4][, bitdepth=8]);";
     synopsis[i++] =  "Screen('FinalizeMovie', moviePtr);";
     synopsis[i++] =  "Screen('AddFrameToMovie', windowPtr [,rect] [,bufferName] [,moviePtr=0] [,frameduration=1]);";
@@ -266,6 +266,16 @@ typedef struct {
 // Skip wait until scanout out-of-vblank before issuing swaprequest:
 #define kPsychSkipOutOfVblankWait (1 << 29)
 
+// Do not use streaming vertex buffer objects for batch drawing in 'DrawDots', 'DrawLines' et al.,
+// but classic client-side vertex arrays:
+#define kPsychDontUseStreamingVBOs (1 << 30)
+
+// Do not draw batches of ovals or rects with one instanced draw call, but one shape at a time:
+#define kPsychDontUseInstancedShapes ((psych_uint64) 1 << 31)
+
+// Do not draw batches of different textures in 'DrawTextures' from texture atlases, but one texture at a time:
+#define kPsychDontUseTextureAtlas ((psych_uint64) 1 << 32)
+
 //function protoptypes
 
 //Accessors for PsychDepthType
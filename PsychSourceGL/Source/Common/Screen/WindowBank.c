@@ -294,6 +294,26 @@ void PsychCreateWindowRecord(PsychWindowRecordType **winRec)
     (*winRec)->fillOvalDisplayList = 0;
     (*winRec)->frameOvalDisplayList = 0;
 
+    // No streaming vertex buffer yet:
+    (*winRec)->streamVBO = 0;
+    (*winRec)->streamVBOSize = 0;
+    (*winRec)->streamVBOOffset = 0;
+    (*winRec)->streamVBOMapping = NULL;
+    (*winRec)->streamVBOSegment = 0;
+    memset((*winRec)->streamVBOFences, 0, sizeof((*winRec)->streamVBOFences));
+
+    // No asynchronous 'GetImage' readbacks yet:
+    memset((*winRec)->asyncReadbacks, 0, sizeof((*winRec)->asyncReadbacks));
+    (*winRec)->asyncReadbackHead = 0;
+    (*winRec)->asyncReadbackCount = 0;
+
+    // No pixel unpack buffer for asynchronous 'MakeTexture' uploads yet:
+    (*winRec)->textureUploadPBO = 0;
+
+    (*winRec)->shapeShader = 0;
+    (*winRec)->shapeVBO = 0;
+    (*winRec)->shapeVBOSlices = 0;
+
     // No special flags set by default:
     (*winRec)->specialflags = 0;
     // No capabilities setup yet:
@@ -308,6 +328,7 @@ void PsychCreateWindowRecord(PsychWindowRecordType **winRec)
 
     // NULL out flipinfo struct:
     (*winRec)->flipInfo = NULL;
+    (*winRec)->flipQueue = NULL;
 
     // Init our shader handles to zero -- Off by default:
     (*winRec)->unclampedDrawShader = 0;
@@ -335,6 +356,7 @@ void PsychCreateWindowRecord(PsychWindowRecordType **winRec)
     (*winRec)->gpuCoreId[0] = 0;
     (*winRec)->gpuRenderTimeQuery = 0;
     (*winRec)->gpuRenderTime = 0.0;
+    (*winRec)->profiler = NULL;
 
     // No swap group or barrier assigned:
     (*winRec)->swapGroup = 0;
@@ -193,6 +193,78 @@ typedef struct PsychHookFunction {
     unsigned int            luttexid1;
 } PsychHookFunction;
 
+// Operations of the steps of a compiled hook chain execution plan:
+#define kPsychHookStepSlot              0       // Execute hook slot via PsychPipelineExecuteHookSlot().
+#define kPsychHookStepFlipFBOs          1       // Builtin:FlipFBOs ping-pong buffer swap.
+#define kPsychHookStepScissorROI        2       // Builtin:RestrictToScissorROI scissor setup.
+#define kPsychHookStepActivateContext   3       // Builtin:ActivateOpenGLContext.
+#define kPsychHookStepFused             4       // Single pass with a generated GLSL program for a run of fused point-operation shader slots.
+
+// Copy instruction for one uniform from the GLSL program of a fused shader slot into the generated fused program:
+typedef struct PsychHookUniformLink {
+    GLuint                  srcprogram;     // Program of original hook slot.
+    GLint                   srcloc;         // Location of uniform in srcprogram.
+    GLint                   dstloc;         // Location of renamed uniform in fused program.
+    GLenum                  type;           // GLSL type of uniform.
+} PsychHookUniformLink;
+
+// Single step of a compiled hook chain execution plan:
+typedef struct PsychHookPlanStep {
+    PtrPsychHookFunction    hookfunc;       // Hook slot to execute, or generated hook slot with fused program for kPsychHookStepFused.
+    int                     op;             // Operation to perform, one of kPsychHookStepXXX.
+    int                     slot;           // Index of (first) executed slot in the hook chain.
+    int                     numSlots;       // Number of hook chain slots executed by this step, including skipped Builtin:FlipFBOs slots.
+    int                     firstLink;      // Index of first uniform link of a fused step in the plans uniformLinks array.
+    int                     numLinks;       // Number of uniform links of a fused step.
+} PsychHookPlanStep;
+
+// Compiled execution plan of a hook chain. Created on first execution of a chain after any change to it:
+typedef struct PsychHookPlan {
+    PsychHookPlanStep*      steps[2];       // [0] = One step per hook slot. [1] = Steps with fused shader passes, if any.
+    int                     numSteps[2];    // Number of steps in steps[0] and steps[1]. numSteps[1] == 0 if nothing could be fused.
+    int                     pingpongs[2];   // Number of Builtin:FlipFBOs ping-pong buffer swaps in steps[0] and steps[1].
+    psych_bool              fusionCompiled; // Was fusion of steps[0] into steps[1] already attempted?
+    PsychHookUniformLink*   uniformLinks;   // Uniform links of all fused steps.
+    int                     numUniformLinks;
+} PsychHookPlan;
+
+// Per-stage GPU and CPU timing profiler of imaging pipeline and Flip, see Screen('GetWindowInfo', win, 10):
+#define kPsychMaxProfileStages          32      // Maximum number of timed stages per frame. Further stages are not timed.
+#define kPsychProfileFramesInFlight     8       // Number of frames whose GPU timestamp queries can be pending at a time.
+#define kPsychProfileHistoryLength      1000    // Number of completed frames kept in the result ring buffer.
+#define kPsychMaxProfileStageName       64
+
+// Timing of one stage, e.g., a hook slot, of a frame:
+typedef struct PsychProfileStage {
+    char                    name[kPsychMaxProfileStageName];
+    double                  cpuStart;       // GetSecs time at start of stage.
+    double                  cpuEnd;         // GetSecs time at end of stage.
+    double                  gpuTime;        // GPU time between start and end timestamp in seconds. NaN if not available.
+    int                     level;          // Nesting level of stage, 0 = top-level stage like 'PreFlip'.
+    int                     gpuState;       // 0 = No GPU timestamps, 1 = Start timestamp query issued, 2 = Start and end query issued.
+} PsychProfileStage;
+
+// Timing of all stages of one frame, ie., of the work for one Flip:
+typedef struct PsychProfileFrame {
+    int                     flipCount;      // windowRecord->flipCount after the Flip which finished this frame.
+    int                     numStages;      // Number of recorded stages.
+    PsychProfileStage       stages[kPsychMaxProfileStages];
+    GLuint                  queries[kPsychMaxProfileStages][2]; // GL_TIMESTAMP query objects for start and end of each stage.
+} PsychProfileFrame;
+
+// Profiler state of an onscreen window. Only allocated while profiling is enabled:
+typedef struct PsychProfiler {
+    PsychProfileFrame       inflight[kPsychProfileFramesInFlight];  // Ring of recorded frames with possibly pending queries.
+    int                     inflightHead;   // Index of oldest frame in inflight[].
+    int                     inflightCount;  // Number of finished frames in inflight[], waiting for query results.
+    psych_bool              frameOpen;      // Is the frame inflight[(inflightHead + inflightCount) % kPsychProfileFramesInFlight] being recorded?
+    psych_bool              useGPU;         // Are GL_TIMESTAMP queries supported?
+    int                     depth;          // Current stage nesting depth.
+    PsychProfileFrame*      history;        // Ring buffer of kPsychProfileHistoryLength completed frames.
+    int                     historyHead;    // Index of oldest frame in history[].
+    int                     historyCount;   // Number of completed frames in history[].
+} PsychProfiler;
+
 // Definition of an OpenGL Framebuffer object (FBO) for internal use.
 typedef struct PsychFBO {
     GLuint                  fboid;          // Handle to FBO.
@@ -208,6 +280,32 @@ typedef struct PsychFBO {
     GLuint                  renderCompleteSemaphore; // Handle to semaphore which signals render completion to this FBO for use with memoryObject.
 } PsychFBO;
 
+// Definition of a texture atlas page for batched drawing of many small textures via Screen('DrawTextures'):
+#define PSYCH_MAX_ATLAS_PAGES 8
+typedef struct PsychTextureAtlasPage {
+    GLuint                  texture;        // Handle of GL_TEXTURE_RECTANGLE_EXT atlas texture, zero if page unused.
+    GLint                   internalFormat; // Internal format of atlas texture. Only textures of identical format get packed into a page.
+    int                     width;          // Width of atlas texture.
+    int                     height;         // Height of atlas texture.
+    int                     shelfX;         // Next free x position in current shelf.
+    int                     shelfY;         // Top y position of current shelf.
+    int                     shelfHeight;    // Height of current shelf.
+    int                     refCount;       // Number of textures resident in this page.
+} PsychTextureAtlasPage;
+
+// Definition of a slot in the ring of pixel pack buffers for asynchronous readback via Screen('GetImage'):
+#define PSYCH_MAX_ASYNC_READBACKS 8
+typedef struct PsychAsyncReadback {
+    GLuint                  pbo;            // Handle of GL_PIXEL_PACK_BUFFER, zero if not yet allocated.
+    size_t                  size;           // Size of pbo in bytes.
+    GLsync                  fence;          // Fence for gpu completion of the pending readback into pbo.
+    int                     width;          // Width of the image in pbo.
+    int                     height;         // Height of the image in pbo.
+    int                     nrchannels;     // Number of color channels to return to the caller.
+    int                     stride;         // Number of color channels per pixel in pbo, 4 on OpenGL-ES, nrchannels otherwise.
+    psych_bool              floatprecision; // TRUE if pbo contains float pixels, FALSE for uint8 pixels.
+} PsychAsyncReadback;
+
 // Typedefs for WindowRecord in WindowBank.h
 
 // This support structure for async flips is supported on all non-Windows platforms, aka all Unix platforms:
@@ -233,6 +331,46 @@ typedef struct PsychFlipInfoStruct {
     psych_condition         flipperGoGoGo;      // Signalling condition variable to trigger execution of a flip request by the flipper thread.
 } PsychFlipInfoStruct;
 
+// Queue of pre-rendered frames for presentation by the flipper thread, see Screen('AsyncFlipQueueCreate'):
+#define kPsychMaxFlipQueueLength        16      // Maximum number of frames in a flip queue.
+#define kPsychFlipQueueResultsLength    1024    // Number of presented frames whose flip results are kept for retrieval.
+
+// One pre-rendered frame, waiting for presentation:
+typedef struct PsychFlipQueueSlot {
+    PsychFBO*               fbo;                // Final image of the frame.
+    GLsync                  fence;              // Fence for gpu completion of rendering into fbo, or NULL.
+    double                  flipwhen;           // Requested stimulus onset time.
+    int                     vbl_synclevel;      // 'dontsync' flag of the flip.
+} PsychFlipQueueSlot;
+
+// Flip results of one presented frame:
+typedef struct PsychFlipQueueResult {
+    double                  flipwhen;
+    double                  vbl_timestamp;
+    double                  time_at_onset;
+    double                  time_at_flipend;
+    double                  miss_estimate;
+    int                     beamPosAtFlip;
+} PsychFlipQueueResult;
+
+// Single-producer single-consumer queue: The master thread renders into slots[submitted % length] and then
+// increments 'submitted', the flipper thread presents slots[presented % length] and then increments 'presented'.
+// Both counters only grow and are only written by their owning thread, so no locking is needed for access to
+// the slots. The counters are updated with the performFlipLock of the window held, so the flipper thread can
+// sleep on the flipperGoGoGo condition until a frame is submitted, and the master thread can sleep on the
+// presentedSignal condition until a frame is presented:
+typedef struct PsychFlipQueue {
+    PsychFlipQueueSlot      slots[kPsychMaxFlipQueueLength];
+    int                     length;             // Number of slots in use.
+    volatile psych_uint64   submitted;          // Number of frames submitted by the master thread.
+    volatile psych_uint64   presented;          // Number of frames presented by the flipper thread.
+    psych_uint64            retrieved;          // Number of frames whose results were returned to usercode.
+    psych_bool              frameRendered;      // Has the next slot been rendered into, but not yet been submitted?
+    PsychFBO*               sysFBO;             // The pseudo-FBO of the system backbuffer, redirected to slots during preflip.
+    psych_condition         presentedSignal;    // Signalled by the flipper thread whenever a frame got presented.
+    PsychFlipQueueResult    results[kPsychFlipQueueResultsLength];
+} PsychFlipQueue;
+
 
 #if PSYCH_SYSTEM == PSYCH_OSX
 // Definition of OS-X core graphics and Core OpenGL handles:
@@ -389,6 +527,12 @@ typedef struct _PsychWindowRecordType_{
     GLint                       textureI420PlanarShader; // Optional GLSL program handle for shader to convert a YUV-I420 planar texture into a standard RGBA8 texture.
     GLint                       textureI800PlanarShader; // Optional GLSL program handle for shader to convert a Y8-I800 planar texture into a standard RGBA8 texture.
     GLint                       multiSampleFetchShader;  // Optional GLSL program handler for shader to fetch from multisample texture.
+    psych_bool                  atlasEligible;          // TRUE if texture content is immutable, so a copy may reside in a texture atlas page of the parent window.
+    int                         atlasPage;              // Zero if not resident in a texture atlas, otherwise 1 + index of atlas page in parent window.
+    int                         atlasX;                 // x position of texture content inside the atlas page (excluding border).
+    int                         atlasY;                 // y position of texture content inside the atlas page (excluding border).
+    GLuint                      textureUploadBuffer;    // Pixel unpack buffer to source texture content from in PsychCreateTexture(), or zero for textureMemory.
+    GLsync                      textureUploadFence;     // Fence for completion of an asynchronous texture upload by 'MakeTexture', or NULL if none pending.
 
     psych_bool                  needsViewportSetup;     // Set on userspace OpenGL contexts of onscreen windows to signal need for glViewport setup and other one-time
                                                         // stuff on first Screen('BeginOpenGL'). Also (ab)used for textures and offscreen windows to track "dirty" state.
@@ -430,6 +574,7 @@ typedef struct _PsychWindowRecordType_{
     double                      osbuiltin_swaptime;     // Optional timestamp of swap completion computed via PsychOSGetSwapCompletionTimestamp();
     double                      gpuRenderTime;          // GPU time spent on rendering. Only returned if a query object is successfully generated.
     GLuint                      gpuRenderTimeQuery;     // Handle to the GPU time query object. 0 if none assigned.
+    PsychProfiler*              profiler;               // Per-stage GPU/CPU timing profiler of imaging pipeline and Flip. NULL if disabled.
     psych_int64                 reference_ust;          // UST reference timestamp of vblank with count reference_msc from OpenML. (Optional)
     psych_int64                 reference_msc;          // MSC reference vblank count from OpenML. (Optional)
     psych_int64                 reference_sbc;          // SBC reference swapbuffers count from OpenML. (Optional)
@@ -462,6 +607,7 @@ typedef struct _PsychWindowRecordType_{
     int                         imagingMode;                                // Master mode switch for imaging and callback hook pipeline.
     PtrPsychHookFunction        HookChain[MAX_SCREEN_HOOKS];                // Array of pointers to the hook-chains for different hooks.
     psych_bool                  HookChainEnabled[MAX_SCREEN_HOOKS];         // Array of Booleans to en-/disable single chains temporarily.
+    PsychHookPlan*              HookChainPlan[MAX_SCREEN_HOOKS];            // Array of pointers to cached compiled execution plans of the hook-chains. NULL if not yet compiled.
 
     // Indices into our FBO table: The special value -1 means: Don't use.
     int                         drawBufferFBO[2];                   // Storage for drawing FBOs: These are the targets of all drawing operations before
@@ -492,6 +638,24 @@ typedef struct _PsychWindowRecordType_{
     GLuint                      fillOvalDisplayList;
     GLuint                      frameOvalDisplayList;
 
+    // Streaming vertex buffer ring for batch drawing functions like 'DrawDots'. Only used in onscreen windows, see PsychGLGlue.c:
+    GLuint                      streamVBO;                          // Handle of streaming VBO, zero if none allocated yet.
+    size_t                      streamVBOSize;                      // Size of streamVBO in bytes.
+    size_t                      streamVBOOffset;                    // Write offset for next batch of vertex data in streamVBO.
+    void*                       streamVBOMapping;                   // Persistent mapping of the whole streamVBO, or NULL if ranges get mapped per batch.
+    int                         streamVBOSegment;                   // Segment (0-3) of persistently mapped streamVBO which is currently written.
+    GLsync                      streamVBOFences[4];                 // Fences for gpu completion of drawing from each segment, or NULL.
+    size_t                      streamVBOFailedSize;                // Smallest size in bytes for which creation of streamVBO failed, zero if none.
+    GLuint                      shapeShader;                        // GLSL shader for instanced drawing of batches of ovals and rects, zero if none.
+    GLuint                      shapeVBO;                           // Static VBO with ring strip vertex indices for instanced shape drawing.
+    int                         shapeVBOSlices;                     // Maximum number of ring segments (slices) shapeVBO can provide.
+    psych_bool                  shapeShaderFailed;                  // TRUE if shapeShader creation failed, so instanced shape drawing is unsupported.
+    PsychTextureAtlasPage       atlasPages[PSYCH_MAX_ATLAS_PAGES];  // Texture atlas pages for batched drawing of small textures, see PsychTextureSupport.c.
+    PsychAsyncReadback          asyncReadbacks[PSYCH_MAX_ASYNC_READBACKS]; // Ring of pixel pack buffers for asynchronous 'GetImage', see SCREENGetImage.c.
+    int                         asyncReadbackHead;                  // Ring index of the oldest pending asynchronous readback.
+    int                         asyncReadbackCount;                 // Number of pending asynchronous readbacks.
+    GLuint                      textureUploadPBO;                   // Pixel unpack buffer for asynchronous 'MakeTexture' uploads, see SCREENMakeTexture.c.
+
     // Pointer to double-array of auxiliary parameters for bound shaders - or NULL by default.
     double*                     auxShaderParams;
     int                         auxShaderParamsCount;
@@ -505,6 +669,7 @@ typedef struct _PsychWindowRecordType_{
                                                                     // needed for implementing asynchronous flip operations. Its always NULL on
                                                                     // MS-Windows, non-NULL on Linux/OSX as soon as async flips are used at least once.
                                                                     // See SCREENFlip.c and flipping routines in PsychWindowSupport.c for more details...
+    PsychFlipQueue*             flipQueue;                          // Queue of pre-rendered frames for the flipper thread, or NULL if none.
 
     psych_uint64                gpu_preflip_Surfaces[2];            // Framebuffer addresses of the primary-/secondary surfaces on GPU before flip.
 
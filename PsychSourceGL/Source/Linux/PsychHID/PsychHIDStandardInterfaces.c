@@ -43,6 +43,24 @@ static XEvent KbQueue_xevent;
 static XIM x_inputMethod = NULL;
 static XIC x_inputContext = NULL;
 
+// State for the optional evdev backend of keyboard queues, selected via KbQueueCreate flag 8:
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
+static int     psychHIDKbQueueEvdevFd[PSYCH_HID_MAX_DEVICES];
+static clockid_t psychHIDKbQueueEvdevClock[PSYCH_HID_MAX_DEVICES];
+static unsigned int psychHIDKbQueueEvdevMods[PSYCH_HID_MAX_DEVICES];
+static unsigned int psychHIDKbQueueEvdevButtons[PSYCH_HID_MAX_DEVICES];
+static psych_bool psychHIDKbQueueEvdevMotion[PSYCH_HID_MAX_DEVICES];
+static float   psychHIDKbQueueEvdevRel[PSYCH_HID_MAX_DEVICES][2];
+static int EvdevEpollFd = -1;
+static int EvdevWakeupFd = -1;
+static psych_thread EvdevThread;
+static psych_bool EvdevThreadRunning = FALSE;
+static Display *evdev_dpy = NULL;
+
 static XDevice* GetXDevice(int deviceIndex)
 {
     if (deviceIndex < 0 || deviceIndex >= PSYCH_HID_MAX_DEVICES) PsychErrorExitMsg(PsychError_user, "Invalid deviceIndex specified. No such device!");
@@ -57,6 +75,9 @@ void PsychHIDInitializeHIDStandardInterfaces(void)
     // Init x_dev array:
     for (i = 0; i < PSYCH_HID_MAX_DEVICES; i++) x_dev[i] = NULL;
 
+    // No evdev devices open yet:
+    for (i = 0; i < PSYCH_HID_MAX_DEVICES; i++) psychHIDKbQueueEvdevFd[i] = -1;
+
     // Init keyboard queue arrays:
     memset(&psychHIDKbQueueFirstPress[0], 0, sizeof(psychHIDKbQueueFirstPress));
     memset(&psychHIDKbQueueFirstRelease[0], 0, sizeof(psychHIDKbQueueFirstRelease));
@@ -1063,6 +1084,407 @@ void* KbQueueWorkerThreadMain(void* dummy)
     return(NULL);
 }
 
+// Optional evdev backend for keyboard queues, selected via KbQueueCreate flag 8:
+//
+// Instead of receiving key, button and motion events via the X-Server, read them
+// directly from the Linux kernel evdev device node which backs the XInput2 slave
+// device. This avoids the X-Server and its event processing in the input path, and
+// provides the timestamps of the kernel input_event's, taken in the kernels input
+// interrupt handling, instead of timestamps taken when our thread finally dequeues
+// the events. All evdev devices are serviced by one common epoll() driven thread,
+// separate from the X-Event processing thread of the regular XInput2 queues.
+//
+// Key indices are mapped to the X keycode convention as used by XInput2, ie., evdev
+// key code + 8, and mouse buttons to X button numbers minus 1, so the results are the
+// same as with the regular XInput2 queues. Virtual devices created via uinput can be
+// used for testing, as they also show up as XInput2 slave devices.
+
+// Open the evdev device node associated with XInput2 device 'deviceIndex', return fd or -1:
+static int KbQueueEvdevOpen(int deviceIndex, clockid_t* clockid)
+{
+    Atom prop, act_type;
+    int act_format, fd = -1;
+    unsigned long nitems, bytes_after;
+    unsigned char *data = NULL;
+    int clk = CLOCK_MONOTONIC;
+
+    // The X-Server input driver (evdev or libinput) exports the device node path as property:
+    prop = XInternAtom(dpy, "Device Node", True);
+    if ((prop == None) ||
+        (XIGetProperty(dpy, info[deviceIndex].deviceid, prop, 0, 1024, False, AnyPropertyType, &act_type, &act_format, &nitems, &bytes_after, &data) != Success) ||
+        !data || (act_format != 8) || (nitems == 0)) {
+        printf("PsychHID-WARNING: KbQueueCreate: Could not find evdev device node of deviceIndex %i. Using X-Server input instead.\n", deviceIndex);
+        if (data) XFree(data);
+        return(-1);
+    }
+
+    fd = open((const char*) data, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        printf("PsychHID-WARNING: KbQueueCreate: Could not open evdev device node %s of deviceIndex %i [%s].\n", (const char*) data, deviceIndex, strerror(errno));
+        printf("PsychHID-WARNING: KbQueueCreate: Maybe you need to be a member of the 'input' group? Using X-Server input instead.\n");
+        XFree(data);
+        return(-1);
+    }
+
+    if (getenv("PSYCHHID_TELLME"))
+        printf("PsychHID-INFO: KbQueueCreate: Using evdev device node %s for deviceIndex %i.\n", (const char*) data, deviceIndex);
+
+    XFree(data);
+
+    // Ask the kernel for CLOCK_MONOTONIC event timestamps. Older kernels only provide CLOCK_REALTIME:
+    *clockid = (ioctl(fd, EVIOCSCLOCKID, &clk) == 0) ? CLOCK_MONOTONIC : CLOCK_REALTIME;
+
+    return(fd);
+}
+
+// Enqueue a key or button press or release into keyboard queue 'i'. Called with KbQueueMutex locked:
+static void KbQueueEvdevAddKeyEvent(int i, int index, psych_bool pressed, double tnow, PsychHIDEventRecord* evt)
+{
+    // This keyboard queue started? Interested in this keycode?
+    if (!psychHIDKbQueueActive[i] || (psychHIDKbQueueScanKeys[i][index] == 0))
+        return;
+
+    if (pressed) {
+        if (psychHIDKbQueueFirstPress[i][index] == 0) psychHIDKbQueueFirstPress[i][index] = tnow;
+        psychHIDKbQueueLastPress[i][index] = tnow;
+        evt->status |= (1 << 0);
+    } else {
+        if (psychHIDKbQueueFirstRelease[i][index] == 0) psychHIDKbQueueFirstRelease[i][index] = tnow;
+        psychHIDKbQueueLastRelease[i][index] = tnow;
+        evt->status &= ~(1 << 0);
+    }
+
+    // Update event buffer. No absolute pointer position available from evdev:
+    evt->timestamp = tnow;
+    evt->rawEventCode = index + 1;
+    evt->buttonStates = psychHIDKbQueueEvdevButtons[i];
+    PsychHIDAddEventToEventBuffer(i, evt);
+
+    // Tell waiting userspace something interesting has changed:
+    PsychSignalCondition(&KbQueueCondition);
+}
+
+// Process one kernel input_event from the evdev device of keyboard queue 'i'. Called with KbQueueMutex locked,
+// which also protects the evdev modifier, button and motion state, and evdev_dpy against concurrent use by
+// KbQueueEvdevStart() on the main thread:
+static void KbQueueEvdevProcessEvent(int i, struct input_event* ie)
+{
+    PsychHIDEventRecord evt;
+    XKeyEvent key;
+    char asciiChar;
+    double tnow;
+    unsigned int modmask = 0;
+    int index, j, n;
+
+    // Map kernel timestamp into GetSecs time:
+    tnow = (double) ie->input_event_sec + ((double) ie->input_event_usec / 1e6);
+    tnow = (psychHIDKbQueueEvdevClock[i] == CLOCK_MONOTONIC) ? PsychOSMonotonicToRefTime(tnow) : PsychOSRealtimeToRefTime(tnow);
+
+    memset(&evt, 0, sizeof(evt));
+    evt.cookedEventCode = -1;
+
+    if (ie->type == EV_KEY) {
+        // Autorepeat events are only accepted with flag 2:
+        if ((ie->value == 2) && !(psychHIDKbQueueFlags[i] & 0x2))
+            return;
+
+        if ((ie->code >= BTN_LEFT) && (ie->code <= BTN_TASK)) {
+            // Mouse button: Map to X button number, as X input drivers do, minus 1, as the XInput2 queues do:
+            switch (ie->code) {
+                case BTN_LEFT:
+                    index = 0;
+                    break;
+                case BTN_RIGHT:
+                    index = 2;
+                    break;
+                case BTN_MIDDLE:
+                    index = 1;
+                    break;
+                default:
+                    index = ie->code - BTN_SIDE + 7;
+            }
+
+            if (ie->value)
+                psychHIDKbQueueEvdevButtons[i] |= (1 << index);
+            else
+                psychHIDKbQueueEvdevButtons[i] &= ~(1 << index);
+        }
+        else if (ie->code < 256 - 8) {
+            // Keyboard key: Map to X keycode:
+            index = ie->code + 8;
+
+            // Track modifier state for mapping to characters:
+            switch (ie->code) {
+                case KEY_LEFTSHIFT:
+                case KEY_RIGHTSHIFT:
+                    modmask = ShiftMask;
+                    break;
+                case KEY_LEFTCTRL:
+                case KEY_RIGHTCTRL:
+                    modmask = ControlMask;
+                    break;
+                case KEY_LEFTALT:
+                    modmask = Mod1Mask;
+                    break;
+                case KEY_RIGHTALT:
+                    modmask = Mod5Mask;
+                    break;
+                case KEY_CAPSLOCK:
+                    if (ie->value == 1) psychHIDKbQueueEvdevMods[i] ^= LockMask;
+                    break;
+                case KEY_NUMLOCK:
+                    if (ie->value == 1) psychHIDKbQueueEvdevMods[i] ^= Mod2Mask;
+                    break;
+            }
+
+            if (modmask) {
+                if (ie->value)
+                    psychHIDKbQueueEvdevMods[i] |= modmask;
+                else
+                    psychHIDKbQueueEvdevMods[i] &= ~modmask;
+            }
+
+            // Key release on keyboard maps to character code 0, key press to character code, if possible:
+            evt.cookedEventCode = 0;
+            if (ie->value && evdev_dpy) {
+                memset(&key, 0, sizeof(key));
+                key.type    = KeyPress;
+                key.display = evdev_dpy;
+                key.keycode = index;
+                key.state   = psychHIDKbQueueEvdevMods[i];
+
+                if (1 == XLookupString(&key, &asciiChar, 1, NULL, NULL))
+                    evt.cookedEventCode = (int) (unsigned char) asciiChar;
+
+                // CTRL + C interrupt request? Tell ConsoleInputHelper() to reenable keystroke dispatch:
+                if (evt.cookedEventCode == 3)
+                    ConsoleInputHelper(-1);
+
+                ConsoleInputHelper(evt.cookedEventCode);
+            }
+        }
+        else {
+            // Joystick buttons etc. are not handled by this backend:
+            return;
+        }
+
+        KbQueueEvdevAddKeyEvent(i, index, (ie->value) ? TRUE : FALSE, tnow, &evt);
+
+        return;
+    }
+
+    if (ie->type == EV_REL) {
+        if ((ie->code == REL_X) || (ie->code == REL_Y)) {
+            // Accumulate relative motion until the next SYN_REPORT:
+            psychHIDKbQueueEvdevRel[i][(ie->code == REL_X) ? 0 : 1] += (float) ie->value;
+            psychHIDKbQueueEvdevMotion[i] = TRUE;
+        }
+        else if (((ie->code == REL_WHEEL) || (ie->code == REL_HWHEEL)) && !(psychHIDKbQueueFlags[i] & 0x1)) {
+            // Scroll wheels map to press + release of X buttons 4/5 and 6/7, like in the X-Server.
+            // Flag 1 suppresses them, as it does for the XInput2 queues:
+            if (ie->code == REL_WHEEL)
+                index = (ie->value > 0) ? 3 : 4;
+            else
+                index = (ie->value > 0) ? 6 : 5;
+
+            n = abs(ie->value);
+            for (j = 0; j < n; j++) {
+                KbQueueEvdevAddKeyEvent(i, index, TRUE, tnow, &evt);
+                KbQueueEvdevAddKeyEvent(i, index, FALSE, tnow, &evt);
+            }
+        }
+
+        return;
+    }
+
+    if ((ie->type == EV_SYN) && (ie->code == SYN_REPORT) && psychHIDKbQueueEvdevMotion[i]) {
+        // End of a motion report: Enqueue accumulated relative motion as raw motion event:
+        if (psychHIDKbQueueActive[i] && (psychHIDKbQueueNumValuators[i] >= 2)) {
+            evt.type = 1;
+            evt.status |= (1 << 1);
+            if (psychHIDKbQueueEvdevButtons[i]) evt.status |= (1 << 0);
+            evt.buttonStates = psychHIDKbQueueEvdevButtons[i];
+            evt.timestamp = tnow;
+            evt.rawEventCode = 0;
+            evt.numValuators = 2;
+            evt.valuators[0] = evt.X = psychHIDKbQueueEvdevRel[i][0];
+            evt.valuators[1] = evt.Y = psychHIDKbQueueEvdevRel[i][1];
+            PsychHIDAddEventToEventBuffer(i, &evt);
+            PsychSignalCondition(&KbQueueCondition);
+        }
+
+        psychHIDKbQueueEvdevRel[i][0] = psychHIDKbQueueEvdevRel[i][1] = 0;
+        psychHIDKbQueueEvdevMotion[i] = FALSE;
+    }
+
+    return;
+}
+
+// Async processing thread for all evdev backed keyboard queues:
+static void* KbQueueEvdevThreadMain(void* dummy)
+{
+    struct epoll_event events[16];
+    struct input_event ie[64];
+    int rc, n, k, j, i;
+
+    // Assign a name to ourselves, for debugging:
+    PsychSetThreadName("PsychHIDEvdev");
+
+    // Try to raise our priority to rt_fifo realtime scheduling, like the X-Event thread:
+    if ((rc = PsychSetThreadPriority(NULL, 2, 1)) > 0) {
+        printf("PsychHID: KbQueueStart: Failed to switch evdev thread to realtime priority [%s].\n", strerror(rc));
+    }
+
+    while (1) {
+        // Wait until at least one device has events pending, or we are told to terminate:
+        n = epoll_wait(EvdevEpollFd, events, 16, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            printf("PsychHID-ERROR: evdev event processing failed [%s]. Keyboard queues using evdev will stop working!\n", strerror(errno));
+            break;
+        }
+
+        for (k = 0; k < n; k++) {
+            i = (int) events[k].data.u32;
+
+            // Termination request via EvdevWakeupFd?
+            if (i == PSYCH_HID_MAX_DEVICES)
+                return(NULL);
+
+            while (1) {
+                // Only read from queues which are still started, so we never read from a
+                // device which got stopped and closed in the meantime:
+                PsychLockMutex(&KbQueueMutex);
+                rc = (psychHIDKbQueueActive[i]) ? (int) read(psychHIDKbQueueEvdevFd[i], ie, sizeof(ie)) : 0;
+                if ((rc < 0) && (errno == ENODEV)) {
+                    printf("PsychHID-WARNING: evdev device of keyboard queue %i disconnected.\n", i);
+                    epoll_ctl(EvdevEpollFd, EPOLL_CTL_DEL, psychHIDKbQueueEvdevFd[i], NULL);
+                }
+
+                for (j = 0; j < rc / (int) sizeof(ie[0]); j++)
+                    KbQueueEvdevProcessEvent(i, &ie[j]);
+
+                PsychUnlockMutex(&KbQueueMutex);
+
+                // No more events pending (EAGAIN), or error?
+                if (rc <= 0)
+                    break;
+            }
+        }
+    }
+
+    return(NULL);
+}
+
+// Start evdev backed keyboard queue 'deviceIndex', and the evdev thread if this is the first one:
+static void KbQueueEvdevStart(int deviceIndex)
+{
+    struct epoll_event ev;
+    struct input_event ie;
+    Window rootRet, childRet;
+    int rx, ry, wx, wy;
+    unsigned int mask;
+
+    if (!EvdevThreadRunning) {
+        EvdevEpollFd = epoll_create1(EPOLL_CLOEXEC);
+        EvdevWakeupFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if ((EvdevEpollFd < 0) || (EvdevWakeupFd < 0)) {
+            if (EvdevEpollFd >= 0) close(EvdevEpollFd);
+            if (EvdevWakeupFd >= 0) close(EvdevWakeupFd);
+            EvdevEpollFd = EvdevWakeupFd = -1;
+            printf("PsychHID-ERROR: Start of evdev keyboard queue processing failed [%s]!\n", strerror(errno));
+            PsychErrorExitMsg(PsychError_system, "Creation of evdev keyboard queue event polling failed!");
+        }
+
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u32 = PSYCH_HID_MAX_DEVICES;
+        epoll_ctl(EvdevEpollFd, EPOLL_CTL_ADD, EvdevWakeupFd, &ev);
+
+        // Private X-Display connection for mapping keycodes to characters for the evdev thread:
+        evdev_dpy = XOpenDisplay(NULL);
+
+        if (PsychCreateThread(&EvdevThread, NULL, KbQueueEvdevThreadMain, NULL)) {
+            close(EvdevEpollFd);
+            close(EvdevWakeupFd);
+            EvdevEpollFd = EvdevWakeupFd = -1;
+            if (evdev_dpy) XCloseDisplay(evdev_dpy);
+            evdev_dpy = NULL;
+            printf("PsychHID-ERROR: Start of evdev keyboard queue processing failed!\n");
+            PsychErrorExitMsg(PsychError_system, "Creation of evdev keyboard queue background processing thread failed!");
+        }
+
+        EvdevThreadRunning = TRUE;
+    }
+
+    PsychLockMutex(&KbQueueMutex);
+
+    // Discard stale events from before the start:
+    while (read(psychHIDKbQueueEvdevFd[deviceIndex], &ie, sizeof(ie)) > 0);
+
+    // Clear out current state for this queue:
+    memset(psychHIDKbQueueFirstPress[deviceIndex]   , 0, (256 * sizeof(double)));
+    memset(psychHIDKbQueueFirstRelease[deviceIndex] , 0, (256 * sizeof(double)));
+    memset(psychHIDKbQueueLastPress[deviceIndex]    , 0, (256 * sizeof(double)));
+    memset(psychHIDKbQueueLastRelease[deviceIndex]  , 0, (256 * sizeof(double)));
+    psychHIDKbQueueEvdevButtons[deviceIndex] = 0;
+    psychHIDKbQueueEvdevMotion[deviceIndex] = FALSE;
+    psychHIDKbQueueEvdevRel[deviceIndex][0] = psychHIDKbQueueEvdevRel[deviceIndex][1] = 0;
+
+    // Start with the current CapsLock and NumLock state of the X-Server:
+    psychHIDKbQueueEvdevMods[deviceIndex] = 0;
+    if (evdev_dpy && XQueryPointer(evdev_dpy, DefaultRootWindow(evdev_dpy), &rootRet, &childRet, &rx, &ry, &wx, &wy, &mask))
+        psychHIDKbQueueEvdevMods[deviceIndex] = mask & (LockMask | Mod2Mask);
+
+    // Mark this queue as logically started and add its device to the polled set:
+    psychHIDKbQueueActive[deviceIndex] = TRUE;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = (unsigned int) deviceIndex;
+    epoll_ctl(EvdevEpollFd, EPOLL_CTL_ADD, psychHIDKbQueueEvdevFd[deviceIndex], &ev);
+
+    PsychUnlockMutex(&KbQueueMutex);
+
+    return;
+}
+
+// Stop evdev backed keyboard queue 'deviceIndex', and the evdev thread if this was the last one:
+static void KbQueueEvdevStop(int deviceIndex)
+{
+    psych_uint64 one = 1;
+    psych_bool queueActive = FALSE;
+    int i;
+
+    PsychLockMutex(&KbQueueMutex);
+    epoll_ctl(EvdevEpollFd, EPOLL_CTL_DEL, psychHIDKbQueueEvdevFd[deviceIndex], NULL);
+    psychHIDKbQueueActive[deviceIndex] = FALSE;
+    PsychUnlockMutex(&KbQueueMutex);
+
+    // Was this the last active evdev queue?
+    for (i = 0; i < PSYCH_HID_MAX_DEVICES; i++) {
+        if (psychHIDKbQueueEvdevFd[i] >= 0) queueActive |= psychHIDKbQueueActive[i];
+    }
+
+    if (queueActive || !EvdevThreadRunning) return;
+
+    // Yes. Wake up the thread for termination, wait for its termination:
+    if (write(EvdevWakeupFd, &one, sizeof(one)) != sizeof(one))
+        printf("PsychHID-WARNING: Failed to signal termination to evdev keyboard queue thread [%s].\n", strerror(errno));
+
+    PsychDeleteThread(&EvdevThread);
+    EvdevThreadRunning = FALSE;
+
+    close(EvdevEpollFd);
+    close(EvdevWakeupFd);
+    EvdevEpollFd = EvdevWakeupFd = -1;
+
+    if (evdev_dpy) XCloseDisplay(evdev_dpy);
+    evdev_dpy = NULL;
+
+    return;
+}
+
 psych_bool PsychHIDIsNotSpecialButtonOrXTest(XIDeviceInfo* dev)
 {
     return(!strstr(dev->name, "XTEST") && !strstr(dev->name, "utton") && !strstr(dev->name, "Bus") &&
@@ -1193,6 +1615,15 @@ PsychError PsychHIDOSKbQueueCreate(int deviceIndex, int numScankeys, int* scanKe
     // Store associated X-Window handle, or zero for unspecified:
     psychHIDKbQueueXWindow[deviceIndex] = (unsigned int) windowHandle;
 
+    // Use the evdev backend with kernel timestamps instead of X-Server input? Touch devices are
+    // not supported by it, as their processing needs the X-Server's coordinate transformations:
+    if (flags & 0x8) {
+        if ((numValuators >= 4) && (PsychHIDIsTouchDevice(deviceIndex, NULL) >= 0))
+            printf("PsychHID-WARNING: KbQueueCreate: evdev input not supported for touch devices. Using X-Server input instead.\n");
+        else
+            psychHIDKbQueueEvdevFd[deviceIndex] = KbQueueEvdevOpen(deviceIndex, &psychHIDKbQueueEvdevClock[deviceIndex]);
+    }
+
     if (x_inputMethod == NULL) {
         // Create an input method and context in the currently set locale
         // for use in translation to the currently set keyboard layout. This
@@ -1296,6 +1727,12 @@ void PsychHIDOSKbQueueRelease(int deviceIndex)
     // Ok, we have a keyboard queue. Stop any operation on it first:
     PsychHIDOSKbQueueStop(deviceIndex);
 
+    // Close evdev device, if any:
+    if (psychHIDKbQueueEvdevFd[deviceIndex] >= 0) {
+        close(psychHIDKbQueueEvdevFd[deviceIndex]);
+        psychHIDKbQueueEvdevFd[deviceIndex] = -1;
+    }
+
     // Release its data structures:
     free(psychHIDKbQueueFirstPress[deviceIndex]); psychHIDKbQueueFirstPress[deviceIndex] = NULL;
     free(psychHIDKbQueueFirstRelease[deviceIndex]); psychHIDKbQueueFirstRelease[deviceIndex] = NULL;
@@ -1372,6 +1809,12 @@ void PsychHIDOSKbQueueStop(int deviceIndex)
     // Keyboard queue already stopped?
     if (!psychHIDKbQueueActive[deviceIndex]) return;
 
+    // Queue using the evdev backend? That one is independent of X-Event processing:
+    if (psychHIDKbQueueEvdevFd[deviceIndex] >= 0) {
+        KbQueueEvdevStop(deviceIndex);
+        return;
+    }
+
     // Queue is active. Stop it:
     PsychLockMutex(&KbQueueMutex);
 
@@ -1393,10 +1836,10 @@ void PsychHIDOSKbQueueStop(int deviceIndex)
 
     PsychUnlockMutex(&KbQueueMutex);
 
-    // Was this the last active queue?
+    // Was this the last active queue which uses X-Server input?
     queueActive = FALSE;
     for (i = 0; i < PSYCH_HID_MAX_DEVICES; i++) {
-        queueActive |= psychHIDKbQueueActive[i];
+        if (psychHIDKbQueueEvdevFd[i] < 0) queueActive |= psychHIDKbQueueActive[i];
     }
 
     // If more queues are active then we're done:
@@ -1472,12 +1915,18 @@ void PsychHIDOSKbQueueStart(int deviceIndex)
     // Keyboard queue already stopped? Then we ain't nothing to do:
     if (psychHIDKbQueueActive[deviceIndex]) return;
 
+    // Queue using the evdev backend? That one is independent of X-Event processing:
+    if (psychHIDKbQueueEvdevFd[deviceIndex] >= 0) {
+        KbQueueEvdevStart(deviceIndex);
+        return;
+    }
+
     // Queue is inactive. Start it:
 
-    // Will this be the first active queue, ie., aren't there any queues running so far?
+    // Will this be the first active queue using X-Server input, ie., aren't there any such queues running so far?
     queueActive = FALSE;
     for (i = 0; i < PSYCH_HID_MAX_DEVICES; i++) {
-        queueActive |= psychHIDKbQueueActive[i];
+        if (psychHIDKbQueueEvdevFd[i] < 0) queueActive |= psychHIDKbQueueActive[i];
     }
 
     PsychLockMutex(&KbQueueMutex);
@@ -28,4 +28,13 @@
 #include <X11/extensions/XInput.h>
 #include <X11/extensions/XInput2.h>
 
+// For the optional evdev backend of keyboard queues:
+#include <linux/input.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
 #endif
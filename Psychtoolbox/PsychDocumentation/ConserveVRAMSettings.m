@@ -338,6 +338,37 @@
 % drivers and advice the user to use this flag in such situations.
 %
 %
+% 2^30 == kPsychDontUseStreamingVBOs
+% Don't use a streaming vertex buffer object for the vertex data of
+% Screen('DrawDots') and Screen('DrawLines'). By default, Psychtoolbox writes
+% the dot and line positions, sizes and colors of these batch drawing
+% functions directly into a persistently mapped or orphaned OpenGL vertex
+% buffer, which saves conversion passes and copies, and allows the gpu to
+% draw previous batches while new ones get written. This flag forces use of
+% the old client-side vertex arrays instead, in case a buggy graphics driver
+% has trouble with this, or for performance comparisons, see
+% DrawDotsLinesBenchmark. Instanced shape drawing and texture atlas drawing,
+% as controlled by the following two flags, source their vertex data from
+% the same buffer, so this flag disables them as well.
+%
+%
+% 2^31 == kPsychDontUseInstancedShapes
+% Don't draw batches of multiple ovals or rects in Screen('FillOval'),
+% Screen('FrameOval'), Screen('FillRect') and Screen('FrameRect') with one
+% instanced draw call, but draw one shape at a time, as older Psychtoolbox
+% versions did. Use this if a buggy graphics driver draws such batches
+% wrongly, or for performance comparisons, see ShapeBatchDrawingTest.
+%
+%
+% 2^32 == kPsychDontUseTextureAtlas
+% Don't pack small textures from Screen('MakeTexture'), drawn in batches of
+% different textures via Screen('DrawTextures'), into texture atlases to
+% draw them with one draw call per atlas, but draw one texture at a time, as
+% older Psychtoolbox versions did. Use this if a buggy graphics driver has
+% trouble with texture atlases, or for performance comparisons, see
+% DrawTexturesAtlasTest.
+%
+%
 % --> It's always better to update your graphics drivers with fixed
 % versions or buy proper hardware than using these workarounds. They are
 % meant as a last ressort, e.g., if you need to get something going quickly
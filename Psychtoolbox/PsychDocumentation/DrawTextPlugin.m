@@ -122,6 +122,13 @@
 % layout, measurement of text dimensions and bounding boxes and the actual
 % drawing of the text.
 %
+% Small glyphs are packed into shared atlas textures, and the layout of
+% recently drawn text strings is cached for each font setting. Therefore
+% redrawing a text string, even in a different color, usually only takes a
+% single batch of textured quads. Screen('GetWindowInfo') reports the hit
+% and miss counts of these caches in its 'TextGlyphCache...' and
+% 'TextLayoutCache...' fields, see DrawTextCacheTest for an example.
+%
 % Our actual plugin coordinates all these operations and communicates with
 % Screen().
 %
@@ -0,0 +1,102 @@
+function results = AsyncFlipQueueTest(queueLength, nrFrames, screenid)
+% results = AsyncFlipQueueTest([queueLength=3][, nrFrames=300][, screenid=max])
+%
+% Test presentation of pre-rendered frames via a flip queue, ie.
+% Screen('AsyncFlipQueueCreate'), Screen('AsyncFlipQueue') and
+% Screen('AsyncFlipQueueResults').
+%
+% The test shows 'nrFrames' frames of a stimulus, each scheduled for onset
+% one video refresh duration after the previous one. Every 10th frame is
+% expensive to draw, taking about 1.5 refresh durations. First the frames
+% are shown via regular Screen('Flip'), where each expensive frame misses
+% its deadline. Then they are shown via a flip queue of 'queueLength'
+% frames, which allows the cheap frames to make up for the time lost on the
+% expensive ones, so no deadlines should be missed. The flip results of the
+% queued frames are collected in bulk and checked for completeness and
+% order.
+%
+% The function returns a struct 'results' with fields 'flipMisses' and
+% 'queueMisses', the number of missed deadlines in each mode, and prints
+% them.
+
+if nargin < 1 || isempty(queueLength)
+    queueLength = 3;
+end
+
+if nargin < 2 || isempty(nrFrames)
+    nrFrames = 300;
+end
+
+if nargin < 3 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+misses = zeros(1, 2);
+
+try
+    for useQueue = [0, 1]
+        PsychImaging('PrepareConfiguration');
+        PsychImaging('AddTask', 'General', 'UseVirtualFramebuffer');
+        win = PsychImaging('OpenWindow', screenid, 0);
+        ifi = Screen('GetFlipInterval', win);
+        [w, h] = Screen('WindowSize', win);
+
+        if useQueue
+            Screen('AsyncFlipQueueCreate', win, queueLength);
+        end
+
+        vbl = Screen('Flip', win);
+        tdeadline = vbl + ifi;
+        when = zeros(nrFrames, 1);
+        vbls = zeros(nrFrames, 1);
+
+        for i = 1:nrFrames
+            Screen('FillRect', win, 255 * mod(i, 2), [0, 0, 100, 100]);
+            Screen('DrawText', win, sprintf('Frame %i', i), 200, 200, 255);
+
+            % Simulate an expensive frame, e.g., with CPU heavy stimulus computation:
+            if mod(i, 10) == 0
+                WaitSecs(1.5 * ifi);
+            end
+
+            when(i) = tdeadline - 0.5 * ifi;
+            if useQueue
+                frameIndex = Screen('AsyncFlipQueue', win, when(i));
+                if frameIndex ~= i
+                    fprintf('AsyncFlipQueueTest: Frame %i got wrong frameIndex %i!\n', i, frameIndex);
+                end
+            else
+                vbls(i) = Screen('Flip', win, when(i));
+            end
+            tdeadline = tdeadline + ifi;
+        end
+
+        if useQueue
+            [res, numPending] = Screen('AsyncFlipQueueResults', win, 1);
+            if numPending ~= 0 || ~isequal(res.FrameIndex, (1:nrFrames)') || any(res.When ~= when)
+                fprintf('AsyncFlipQueueTest: Incomplete or out of order flip queue results!\n');
+            end
+
+            if ~issorted(res.VBLTimestamp)
+                fprintf('AsyncFlipQueueTest: Frames not presented in order!\n');
+            end
+
+            vbls = res.VBLTimestamp;
+        end
+
+        % A deadline is missed if a frame is shown more than half a refresh late:
+        misses(useQueue + 1) = sum(vbls - when > ifi);
+        sca;
+    end
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+results.flipMisses = misses(1);
+results.queueMisses = misses(2);
+
+fprintf('%i frames at %i x %i pixels: %i missed deadlines with Flip, %i missed deadlines with flip queue of length %i.\n', ...
+        nrFrames, w, h, results.flipMisses, results.queueMisses, queueLength);
+
+return;
@@ -0,0 +1,105 @@
+function AsyncMakeTextureTest(nrTextures, screenid)
+% AsyncMakeTextureTest([nrTextures=20][, screenid=max])
+%
+% Test asynchronous upload of image matrices into textures by
+% Screen('MakeTexture') with specialFlags 64.
+%
+% With specialFlags 64, 'MakeTexture' converts the image matrix into a
+% pixel buffer object of the driver and returns without waiting for the
+% upload into the texture. Drawing the texture waits for the upload if it
+% is still in progress, and Screen('PreloadTextures', win, texids,
+% waitSecs) checks or waits for completion.
+%
+% The test creates 'nrTextures' textures of 1024 x 1024 pixels from uint8
+% and double RGB matrices with synchronous upload, and the same ones with
+% asynchronous upload. The last asynchronously uploaded texture gets drawn
+% immediately, while its upload is likely still in progress, the others
+% after waiting for all uploads with Screen('PreloadTextures', win,
+% texids, Inf). Then all textures must be reported as ready, and the drawn
+% image of each texture must be identical to the one of the synchronously
+% uploaded texture. Otherwise the test aborts with an error.
+%
+% It prints the time per 'MakeTexture' call with synchronous and
+% asynchronous upload, and the total time from the first asynchronous
+% 'MakeTexture' call until all asynchronous uploads are completed.
+
+if nargin < 1 || isempty(nrTextures)
+    nrTextures = 20;
+end
+
+if nargin < 2 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+
+try
+    win = Screen('OpenWindow', screenid, 0);
+    dstRect = [0 0 256 256];
+
+    for isbyte = [1, 0]
+        imgs = cell(1, nrTextures);
+        for i = 1:nrTextures
+            imgs{i} = rand(1024, 1024, 3) * 255;
+            if isbyte
+                imgs{i} = uint8(imgs{i});
+            end
+        end
+
+        % Reference: Synchronous upload, drawn image of each texture:
+        refImgs = cell(1, nrTextures);
+        syncTex = zeros(1, nrTextures);
+        t0 = GetSecs;
+        for i = 1:nrTextures
+            syncTex(i) = Screen('MakeTexture', win, imgs{i});
+        end
+        syncMsecs = 1000 * (GetSecs - t0) / nrTextures;
+
+        for i = 1:nrTextures
+            Screen('DrawTexture', win, syncTex(i), [], dstRect);
+            refImgs{i} = Screen('GetImage', win, dstRect, 'backBuffer');
+        end
+        Screen('Close', syncTex);
+
+        % Asynchronous upload:
+        asyncTex = zeros(1, nrTextures);
+        mismatch = 0;
+        t0 = GetSecs;
+        for i = 1:nrTextures
+            asyncTex(i) = Screen('MakeTexture', win, imgs{i}, [], 64);
+        end
+        asyncMsecs = 1000 * (GetSecs - t0) / nrTextures;
+
+        % Draw the last texture while its upload may still be in progress, the others after all uploads completed:
+        for i = [nrTextures, 1:nrTextures-1]
+            Screen('DrawTexture', win, asyncTex(i), [], dstRect);
+            if ~isequal(refImgs{i}, Screen('GetImage', win, dstRect, 'backBuffer'))
+                mismatch = i;
+            end
+
+            if i == nrTextures
+                ready = Screen('PreloadTextures', win, asyncTex, Inf);
+                readyMsecs = 1000 * (GetSecs - t0);
+            end
+        end
+        Screen('Close', asyncTex);
+
+        fprintf('%-6s matrices: Synchronous %8.3f msecs, asynchronous %8.3f msecs per texture, %8.3f msecs until all uploaded.\n', ...
+                class(imgs{1}), syncMsecs, asyncMsecs, readyMsecs);
+
+        if mismatch
+            error('Asynchronously uploaded texture %i from %s matrix differs from synchronously uploaded one!', mismatch, class(imgs{1}));
+        end
+
+        if ~ready
+            error('Not all asynchronously uploaded textures were ready after waiting for them!');
+        end
+    end
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+sca;
+
+return;
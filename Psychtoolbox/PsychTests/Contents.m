@@ -9,7 +9,9 @@
 %   AlphaMultiplicationTest         - Test alpha multiplication by 0 and 1 for perfect precision.
 %   AlphaMultiplicationAccuracyTest - Test precision of alpha multiplication for values between 0 and 1.
 %   AnalyzeTiming                   - Analyze timing logs from FlipTimingWithRTBoxPhotoDiodeTest.
+%   AsyncFlipQueueTest              - Test presentation of pre-rendered frames via flip queues, ie. Screen('AsyncFlipQueue').
 %   AsyncFlipTest                   - Test robustness and performance of Screen('AsyncFlipBegin') et al.
+%   AsyncMakeTextureTest            - Test correctness and speed of asynchronous texture upload in Screen('MakeTexture').
 %   BatchAnalyzeTiming              - Batch version of AnalyzeTiming.
 %   BeampositionTest                - Test GPU scanout position ("beamposition") queries.
 %   CIEConeFundamentalsTest         - Test/demonstrate routines for producing cone fundamentals according to CIE 170-1:2006
@@ -20,8 +22,11 @@
 %   ConvolutionKernelTest           - Test routine for correctness, accuracy and speed of PTB imaging convolution shaders.
 %   DatapixxGPUDitherpatternTest    - Low level diagnostic of GPU dithering bugs via Datapixx et al.
 %   DeinterlacerTest                - Simple correctness test for GLSL video image deinterlacer. INCOMPLETE.
+%   DrawDotsLinesBenchmark          - Benchmark DrawDots and DrawLines with streaming vertex buffers vs. client-side vertex arrays.
 %   DrawingIntoTexturesTest         - Tests if using a texture as an offscreen window, i.e., for drawing, works.
+%   DrawTextCacheTest               - Test correctness and speed of the glyph atlas and text layout cache of the DrawText plugin.
 %   DrawTextFontSwitchSpeedTest - Test speed of text drawing when switching between different font type/style/size settings.
+%   DrawTexturesAtlasTest           - Test correctness and speed of texture atlas drawing of many different textures with DrawTextures.
 %   DriftTexturePrecisionTest       - Test subpixel accuracy of texture interpolators: What is the smallest
 %                                     fraction of a pixel that one can scroll, using built-in bilinear interpolation?
 %   eGalaxTrace-*.evemu             - Linux evdev traces with recorded single/multi-touch input from an eGalax touchscreen.
@@ -38,6 +43,7 @@
 %   FloatTexturePrecisionTest       - Test effective precision of floating point 16bpc textures.
 %   FrameSequentialStereoTest       - Test routine for timing and stimulus onset on quad-buffered frame-sequential stereo hardware.
 %   GetCharTest                     - Tests of GetChar.
+%   GetImageAsyncTest               - Test correctness and speed of asynchronous Screen('GetImage') readback of all frames of a stimulus.
 %   GetSecsTest                     - Timing test of clock used by Psychtoolbox, e.g., GetSecs, WaitSecs, Screen...
 %   GraphicsDisplaySyncAcrossDualHeadsTest - Test synchronization of refresh cycles of different display heads.
 %   GraphicsDisplaySyncAcrossDualHeadsTestLinux - Linux version of the test.
@@ -45,14 +51,23 @@
 %   HIDIntervalTest                 - Sample HID keyboard and mouse, plot distribution of detected event times.
 %   HighColorPrecisionDrawingTest   - Test drawing precision of a variety of Screen() functions, esp. wrt. high precision framebuffers.
 %   HighPrecisionLuminanceOutputDriversImagingPipelineTest - Test precision of a variety of high precision luminance device output drivers.
+%   HookChainFusionTest             - Test correctness and speed of fused point-operation shader passes in imaging pipeline hook chains.
+%   IOPortLoopbackTest              - Test IOPort network sockets and pseudo-terminals via loopback connections.
+%   IOPortPtyBenchmark              - Benchmark latency, throughput and cpu cost of IOPort background serial reads on a virtual pty connection.
+%   IOPortRecordDecoderTest         - Test and benchmark IOPort decoding of binary records in background reads.
 %   JavaClockTest                   - Timing test of clock used by Java functions (e.g. GetChar)
+%   KbQueueEvdevTest                - Compare keyboard queues with X-Server input and with Linux evdev input.
+%   KbQueueGetEventsTest            - Compare speed of fetching keyboard queue events one at a time or all at once.
 %   KeyboardLatencyTest             - Get a feeling for keyboard and mouse latency via some sound-based measurement procedure.
 %   LabLuvTest                      - Test routines that convert to CIELAB and CIELUV.
 %   LoadGenerator                   - Create cpu load by spinning in an infinite loop. Used in conjunction with FlipTimingWithRTBoxPhotoDiodeTest.
 %   LosslessMovieWritingTest        - Test lossless encoding and decoding of video in movie files.
 %   MakeTextureTimingTest           - Time texture creation -> upload -> destruction for given texture by MakeTexture et al.
+%   MakeTextureThreadsTest          - Test correctness and speed of multi-threaded image matrix conversion in Screen('MakeTexture').
 %   MelanopsinFundamentalTest       - Test the PTB routines generate a good melanopsin fundamental.
 %   MonoImageToSRGBTest             - Test/demo for routine PsychColorimetric/MonoImageToSRGB.
+%   MovieDecodeAheadTest            - Test correctness and speed of decode-ahead of video frames in movie playback.
+%   MovieRandomAccessTest           - Test correctness and speed of random access to movie frames with frame index and frame cache.
 %   MultiWindowLockStepTest         - Exercise asynchronous flip scheduling and timestamping on multiple onscreen windows in parallel.
 %   MultiWindowVulkanTest           - Test multi-window / multi-display exclusive operation under Vulkan.
 %   OSAUCSTest                      - Test OSA UCS <-> XYZ conversion routines.
@@ -60,14 +75,19 @@
 %   OMLBasicTest                    - Very basic correctness test for OpenML flip timestamping.
 %   OSSchedulingAccuracyTest        - Test timing accuracy of operating system scheduler for timed waits.
 %   PBTAndIsetbioColorimetryTest    - Compare PTB and VSET colorimetric calculations.
+%   PipelineProfilingTest           - Report per-stage GPU and CPU times of imaging pipeline hook chains and flips.
 %   PosterBatchAnalyzeTimestamps    - Batch analysis of timestamp logs generated by FlipTimingWithRTBoxPhotoDiodeTest for ECVP 2010 poster.
 %   PupilDiameterTest               - Test functions that compute pupil diameter from luminance.
 %   PutImageTest                    - Test Screen('PutImage') when used with 'NormalizedHighresColorRange'.
 %   PsychPortAudioDataPixxTimingTest - Test PsychPortAudio's timing with a DataPixx device and a audio line cable.
+%   PsychPortAudioEngineBenchmark   - Benchmark audio engine cost per sample frame for various setups on the virtual null device.
+%   PsychPortAudioSlaveMixBenchmark - Benchmark cost of mixing up to 512 slaves, with serial or parallel slave rendering.
 %   PsychPortAudioTimingTest        - Testsignal generator for test of PsychPortAudios timing with external measurement equipment.
 %   QuestTest                       - Some Quest simulations, more elaborate than QuestDemo.
 %   ResolutionTest                  - Use Screen Resolutions to print table of display resolutions.
 %   RodFundamentalTest              - Test the PTB routines generate a good rod fundamental.
+%   ScreenDispatchProfileTest       - Test the per-subfunction call profiler of Screen and measure subfunction dispatch overhead.
+%   ShapeBatchDrawingTest           - Test correctness and speed of instanced batch drawing of ovals and rects vs. one draw call per shape.
 %   StructsFileTest                 - Test routines for reading and writing struct arrays to text files.
 %   SyncedCLUTUpdateTest            - Visual test of clut write synching to vertical retrace.
 %   TextBoundsTest                  - Test Screen('TestBounds')
@@ -0,0 +1,77 @@
+function DrawDotsLinesBenchmark(nrDots, screenid)
+% DrawDotsLinesBenchmark([nrDots=[50000, 100000, 200000]][, screenid=max])
+%
+% Benchmark Screen('DrawDots') and Screen('DrawLines') with large numbers
+% of dots and lines, with and without the streaming vertex buffer.
+%
+% By default, Screen writes the vertex data of these functions directly into
+% a persistently mapped, or orphaned, OpenGL vertex buffer object. Setting
+% the Screen('Preference', 'ConserveVRAM') flag 2^30, aka
+% kPsychDontUseStreamingVBOs, disables this and uses client-side vertex
+% arrays instead. For each number of dots in the vector 'nrDots', the
+% benchmark draws 100 frames of moving random dots or lines with both ways,
+% and prints the time per frame for:
+%
+% 'Dots'          Dots of one size and color.
+% 'DotsPerDot'    Dots with per dot sizes and colors.
+% 'Lines'         nrDots / 2 lines of one width and color.
+% 'LinesPerLine'  nrDots / 2 lines with per line colors.
+%
+% The vertex data is the same either way, so the benchmark aborts with an
+% error if the first frame drawn with the streaming vertex buffer is not
+% identical to the one drawn from client-side vertex arrays.
+
+if nargin < 1 || isempty(nrDots)
+    nrDots = [50000, 100000, 200000];
+end
+
+if nargin < 2 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+
+try
+    win = Screen('OpenWindow', screenid, 0);
+    [w, h] = Screen('WindowSize', win);
+    [minSize, maxSize] = Screen('DrawDots', win);
+    maxSize = min(maxSize, 8);
+
+    fprintf('%-14s %7s %18s %18s\n', 'Case', 'Dots', 'Streaming [ms]', 'Client [ms]');
+    for n = nrDots
+        xy = [rand(1, n) * w; rand(1, n) * h];
+        sizes = minSize + rand(1, n) * (maxSize - minSize);
+        colors = rand(3, n) * 255;
+
+        for drawCase = {'Dots', 'DotsPerDot', 'Lines', 'LinesPerLine'}
+            [img, msecs] = CompareConserveVRAMDrawing(win, 2^30, @(i) drawFrame(win, drawCase{1}, xy, i, sizes, colors), 100);
+            fprintf('%-14s %7i %18.3f %18.3f\n', drawCase{1}, n, msecs(1), msecs(2));
+
+            if ~isequal(img{1}, img{2})
+                error('%s with %i dots differ between streaming vertex buffer and client-side vertex arrays!', drawCase{1}, n);
+            end
+        end
+    end
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+sca;
+
+return;
+
+function drawFrame(win, drawCase, xy, i, sizes, colors)
+    % Every other dot or line end moves by one pixel per frame:
+    xy(1, 1:2:end) = xy(1, 1:2:end) + i;
+    switch drawCase
+        case 'Dots'
+            Screen('DrawDots', win, xy, 2, 255);
+        case 'DotsPerDot'
+            Screen('DrawDots', win, xy, sizes, colors);
+        case 'Lines'
+            Screen('DrawLines', win, xy, 1, 255);
+        case 'LinesPerLine'
+            Screen('DrawLines', win, xy, 1, colors);
+    end
+return;
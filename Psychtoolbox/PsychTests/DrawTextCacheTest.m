@@ -0,0 +1,111 @@
+function DrawTextCacheTest(nrStrings, screenid)
+% DrawTextCacheTest([nrStrings=100][, screenid=max])
+%
+% Test the glyph atlas and text layout cache of the Screen('DrawText')
+% plugin text renderer.
+%
+% The plugin packs the images of glyphs into shared atlas textures, and
+% caches the layout of recently drawn text strings, so redrawing a string,
+% even in a different color, usually takes a single batch of textured
+% quads. Screen('GetWindowInfo') returns the hit and miss counts of these
+% caches in its 'TextGlyphCacheHits', 'TextGlyphCacheMisses',
+% 'TextLayoutCacheHits' and 'TextLayoutCacheMisses' fields.
+%
+% The test draws 'nrStrings' random strings of printable ASCII characters
+% into empty caches, then draws them again in inverted colors, then once
+% more in their original colors. The first and last image must be
+% identical, and the last pass must not miss the layout cache, otherwise
+% the test aborts with an error. The layout cache holds 256 strings per
+% font, so 'nrStrings' must not exceed that. Then the test prints the time
+% per frame of redrawing the same strings in new colors, and of drawing new
+% strings, and the overall cache hit rates.
+%
+% This needs the plugin text renderer, ie. Screen('Preference',
+% 'TextRenderer', 1), the default on Linux and macOS.
+
+if nargin < 1 || isempty(nrStrings)
+    nrStrings = 100;
+end
+
+if nargin < 2 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+
+try
+    win = Screen('OpenWindow', screenid, 0);
+    [w, h] = Screen('WindowSize', win);
+    Screen('TextSize', win, 18);
+
+    [strings, xy, colors] = randomStrings(nrStrings, w, h);
+
+    Screen('FillRect', win, 0);
+    drawStrings(win, strings, xy, colors);
+    uncachedImg = Screen('GetImage', win, [], 'backBuffer');
+
+    Screen('FillRect', win, 0);
+    drawStrings(win, strings, xy, 255 - colors);
+
+    before = Screen('GetWindowInfo', win);
+    if before.TextLayoutCacheHits + before.TextLayoutCacheMisses == 0
+        error('Text renderer does not report cache statistics. Plugin text renderer not in use?');
+    end
+
+    Screen('FillRect', win, 0);
+    drawStrings(win, strings, xy, colors);
+    cachedImg = Screen('GetImage', win, [], 'backBuffer');
+    after = Screen('GetWindowInfo', win);
+
+    if ~isequal(uncachedImg, cachedImg)
+        error('Text drawn from the caches differs from text drawn into empty caches!');
+    end
+
+    if after.TextLayoutCacheMisses ~= before.TextLayoutCacheMisses
+        error('%i of %i redrawn strings missed the layout cache!', after.TextLayoutCacheMisses - before.TextLayoutCacheMisses, nrStrings);
+    end
+
+    % Speed of cached strings in new colors, then of new strings:
+    msecs = zeros(1, 2);
+    for newStrings = [0, 1]
+        Screen('Flip', win);
+        t0 = GetSecs;
+        for i = 1:50
+            if newStrings
+                [strings, xy] = randomStrings(nrStrings, w, h);
+            end
+            drawStrings(win, strings, xy, round(rand(3, nrStrings) * 255));
+            Screen('Flip', win, [], [], 2);
+        end
+        Screen('DrawingFinished', win, [], 1);
+        msecs(newStrings + 1) = 1000 * (GetSecs - t0) / 50;
+    end
+
+    info = Screen('GetWindowInfo', win);
+    fprintf('%i strings per frame: Cached %8.3f msecs, new strings %8.3f msecs per frame.\n', nrStrings, msecs(1), msecs(2));
+    fprintf('Glyph cache hit rate %6.2f%%, layout cache hit rate %6.2f%%.\n', ...
+            100 * info.TextGlyphCacheHits / max(1, info.TextGlyphCacheHits + info.TextGlyphCacheMisses), ...
+            100 * info.TextLayoutCacheHits / max(1, info.TextLayoutCacheHits + info.TextLayoutCacheMisses));
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+sca;
+
+return;
+
+function [strings, xy, colors] = randomStrings(n, w, h)
+    strings = cell(1, n);
+    for i = 1:n
+        strings{i} = char(32 + floor(rand(1, 5 + floor(rand * 20)) * 95));
+    end
+    xy = [rand(1, n) * w * 0.8; 20 + rand(1, n) * (h - 40)];
+    colors = round(rand(3, n) * 255);
+return;
+
+function drawStrings(win, strings, xy, colors)
+    for i = 1:length(strings)
+        Screen('DrawText', win, strings{i}, xy(1, i), xy(2, i), colors(:, i));
+    end
+return;
@@ -0,0 +1,105 @@
+function DrawTexturesAtlasTest(nrItems, screenid)
+% DrawTexturesAtlasTest([nrItems=2000][, screenid=max])
+%
+% Test texture atlas drawing of many different small textures with one
+% call to Screen('DrawTextures').
+%
+% If supported by the graphics driver, Screen copies small textures created
+% by Screen('MakeTexture') into big atlas textures on first use, and draws
+% all items of a Screen('DrawTextures') call from these with one draw call
+% per atlas. Setting the Screen('Preference', 'ConserveVRAM') flag 2^32,
+% aka kPsychDontUseTextureAtlas, disables this, so each item is drawn from
+% its own texture with its own draw call.
+%
+% The test creates 100 random RGBA textures of random size up to 64 x 64
+% pixels, and draws 'nrItems' items of them with random source and
+% destination rectangles and rotation angles, once with atlas drawing and
+% once without, with these options:
+%
+% 'Bilinear'     Bilinear filtering and random modulateColors.
+% 'Nearest'      Nearest neighbour sampling and random modulateColors.
+% 'GlobalAlpha'  Bilinear filtering and random globalAlphas.
+%
+% Texture coordinates into an atlas page differ from those into the
+% original texture, and so does their rounding in the gpu's interpolators.
+% Bilinear filtering therefore may differ by up to two units per color
+% channel, and nearest neighbour sampling may pick a neighbouring texel for
+% a few pixels whose sample position falls exactly on a texel boundary. The
+% test aborts with an error if the images differ by more than that.
+%
+% It then prints the time per frame of 'nrItems' items with both ways.
+
+if nargin < 1 || isempty(nrItems)
+    nrItems = 2000;
+end
+
+if nargin < 2 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+
+try
+    win = Screen('OpenWindow', screenid, 0);
+    [w, h] = Screen('WindowSize', win);
+    Screen('BlendFunction', win, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    texids = zeros(1, 100);
+    for i = 1:length(texids)
+        texids(i) = Screen('MakeTexture', win, uint8(rand(1 + round(rand * 63), 1 + round(rand * 63), 4) * 255));
+    end
+
+    items = randomItems(texids, nrItems, w, h);
+
+    for filterMode = {'Bilinear', 'Nearest', 'GlobalAlpha'}
+        [img, msecs] = CompareConserveVRAMDrawing(win, 2^32, @(i) drawItems(win, filterMode{1}, items));
+
+        d = abs(img{1} - img{2});
+        nrDiffPixels = nnz(any(d, 3));
+        fprintf('%-12s: Max difference %3i in %6i pixels. Atlas %8.3f msecs, one texture per draw %8.3f msecs per frame.\n', ...
+                filterMode{1}, max(d(:)), nrDiffPixels, msecs(1), msecs(2));
+
+        if strcmp(filterMode{1}, 'Nearest')
+            if nrDiffPixels > 0.001 * w * h
+                error('Nearest neighbour sampling from the atlas differs in %i pixels!', nrDiffPixels);
+            end
+        elseif max(d(:)) > 2
+            error('%s drawing from the atlas differs by up to %i units!', filterMode{1}, max(d(:)));
+        end
+    end
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+sca;
+
+return;
+
+function items = randomItems(texids, n, w, h)
+    items.texids = texids(ceil(rand(1, n) * length(texids)));
+    items.srcRects = zeros(4, n);
+    for i = 1:n
+        texrect = Screen('Rect', items.texids(i));
+        x = rand(1, 2) * texrect(3) / 3;
+        y = rand(1, 2) * texrect(4) / 3;
+        items.srcRects(:, i) = round([x(1); y(1); texrect(3) - x(2); texrect(4) - y(2)]);
+    end
+    x = rand(1, n) * w;
+    y = rand(1, n) * h;
+    items.dstRects = round([x; y; x + 4 + rand(1, n) * 100; y + 4 + rand(1, n) * 100]);
+    items.angles = rand(1, n) * 360;
+    items.colors = round(rand(4, n) * 255);
+    items.alphas = rand(1, n);
+return;
+
+function drawItems(win, filterMode, items)
+    switch filterMode
+        case 'Bilinear'
+            Screen('DrawTextures', win, items.texids, items.srcRects, items.dstRects, items.angles, 1, [], items.colors);
+        case 'Nearest'
+            Screen('DrawTextures', win, items.texids, items.srcRects, items.dstRects, items.angles, 0, [], items.colors);
+        case 'GlobalAlpha'
+            Screen('DrawTextures', win, items.texids, items.srcRects, items.dstRects, items.angles, 1, items.alphas);
+    end
+return;
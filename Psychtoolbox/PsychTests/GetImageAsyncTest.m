@@ -0,0 +1,111 @@
+function GetImageAsyncTest(nrFrames, nrchannels, floatprecision, screenid)
+% GetImageAsyncTest([nrFrames=100][, nrchannels=3][, floatprecision=0][, screenid=max])
+%
+% Test asynchronous readback of all frames of a stimulus with
+% Screen('GetImage', ..., async).
+%
+% With async=1, 'GetImage' only starts the readback of the requested image
+% into a ring of pixel buffer objects, and returns the image of an earlier
+% readback once that one has completed, or an empty matrix if none has.
+% With async=2, it waits for and returns the oldest pending image.
+%
+% The test draws 'nrFrames' frames of random colored rectangles, reads
+% each one back synchronously before its Screen('Flip'), then draws the
+% same frames again and reads them back asynchronously. The asynchronous
+% readback must return exactly the same images, in the same order,
+% otherwise the test aborts with an error. It prints the time per frame of
+% both ways of readback, and how many frames the asynchronous images lagged
+% behind the drawing on average.
+%
+% 'nrchannels' and 'floatprecision' are passed to 'GetImage', see
+% Screen('GetImage?') for their meaning.
+
+if nargin < 1 || isempty(nrFrames)
+    nrFrames = 100;
+end
+
+if nargin < 2 || isempty(nrchannels)
+    nrchannels = 3;
+end
+
+if nargin < 3 || isempty(floatprecision)
+    floatprecision = 0;
+end
+
+if nargin < 4 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+
+try
+    win = Screen('OpenWindow', screenid, 0);
+    [w, h] = Screen('WindowSize', win);
+
+    rects = cell(1, nrFrames);
+    colors = cell(1, nrFrames);
+    for i = 1:nrFrames
+        x = rand(1, 50) * w;
+        y = rand(1, 50) * h;
+        rects{i} = round([x; y; x + 10 + rand(1, 50) * 200; y + 10 + rand(1, 50) * 200]);
+        colors{i} = round(rand(4, 50) * 255);
+    end
+
+    % Synchronous reference readback:
+    syncImgs = cell(1, nrFrames);
+    Screen('Flip', win);
+    t0 = GetSecs;
+    for i = 1:nrFrames
+        Screen('FillRect', win, 0);
+        Screen('FillRect', win, colors{i}, rects{i});
+        Screen('DrawingFinished', win);
+        syncImgs{i} = Screen('GetImage', win, [], 'backBuffer', floatprecision, nrchannels);
+        Screen('Flip', win);
+    end
+    syncMsecs = 1000 * (GetSecs - t0) / nrFrames;
+
+    % Asynchronous readback: Image n may arrive during any later frame:
+    asyncImgs = {};
+    lag = 0;
+    Screen('Flip', win);
+    t0 = GetSecs;
+    for i = 1:nrFrames
+        Screen('FillRect', win, 0);
+        Screen('FillRect', win, colors{i}, rects{i});
+        Screen('DrawingFinished', win);
+        img = Screen('GetImage', win, [], 'backBuffer', floatprecision, nrchannels, 1);
+        if ~isempty(img)
+            asyncImgs{end+1} = img; %#ok<AGROW>
+            lag = lag + i - length(asyncImgs);
+        end
+        Screen('Flip', win);
+    end
+
+    img = Screen('GetImage', win, [], [], [], [], 2);
+    while ~isempty(img)
+        asyncImgs{end+1} = img; %#ok<AGROW>
+        lag = lag + nrFrames - length(asyncImgs);
+        img = Screen('GetImage', win, [], [], [], [], 2);
+    end
+    asyncMsecs = 1000 * (GetSecs - t0) / nrFrames;
+
+    fprintf('%i frames of %i x %i pixels: Synchronous %8.3f msecs, asynchronous %8.3f msecs per frame, mean lag %5.2f frames.\n', ...
+            nrFrames, w, h, syncMsecs, asyncMsecs, lag / max(1, length(asyncImgs)));
+
+    if length(asyncImgs) ~= nrFrames
+        error('Got %i images instead of %i from asynchronous readback!', length(asyncImgs), nrFrames);
+    end
+
+    for i = 1:nrFrames
+        if ~isequal(syncImgs{i}, asyncImgs{i})
+            error('Asynchronous readback image %i differs from synchronous readback!', i);
+        end
+    end
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+sca;
+
+return;
@@ -0,0 +1,101 @@
+function HookChainFusionTest(nrStages, tolerance, screenid)
+% HookChainFusionTest([nrStages=4][, tolerance=1e-4][, screenid=max])
+%
+% Test fused point-operation shader passes in imaging pipeline hook chains.
+%
+% If enabled via Screen('Preference', 'FuseHookChainShaders', 1), Screen
+% fuses runs of hook chain shader slots, which are only separated by
+% 'Builtin:FlipFBOs' slots, into a single pass with one generated shader,
+% if all slots are point operations in the style of PsychColorCorrection(),
+% ie. a main shader which only calls icmTransformColor() on the input
+% image color. Fusion is disabled by default.
+%
+% The test attaches a chain of 'nrStages' gamma correction shaders with
+% gammas between 0.5 and 2.0 to the 'StereoLeftCompositingBlit' chain of a
+% 32 bpc floating point window, and draws a color gradient through it with
+% and without fusion. The fused pass skips the rounding of intermediate
+% results to the 32 bpc float framebuffers, so the results may differ a
+% bit, but the test aborts with an error if any color component differs by
+% more than 'tolerance'. Then it prints the time per flip of the gradient
+% without sync to retrace, with and without fusion.
+
+if nargin < 1 || isempty(nrStages)
+    nrStages = 4;
+end
+
+if nargin < 2 || isempty(tolerance)
+    tolerance = 1e-4;
+end
+
+if nargin < 3 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+oldfuse = Screen('Preference', 'FuseHookChainShaders');
+
+try
+    PsychImaging('PrepareConfiguration');
+    PsychImaging('AddTask', 'General', 'FloatingPoint32Bit');
+    win = PsychImaging('OpenWindow', screenid, 0, [], [], [], [], [], mor(kPsychNeedImageProcessing, kPsychNeedMultiPass));
+    [w, h] = Screen('WindowSize', win);
+
+    gammas = linspace(0.5, 2.0, nrStages);
+    for k = 1:nrStages
+        shader = LoadGLSLProgramFromFiles({'GammaCorrectionShader.frag.txt', 'ICMSimpleGammaCorrectionShader.frag.txt'});
+        glUseProgram(shader);
+        glUniform1i(glGetUniformLocation(shader, 'Image'), 0);
+        glUniform3f(glGetUniformLocation(shader, 'ICMEncodingGamma'), gammas(k), gammas(k), gammas(k));
+        glUniform3f(glGetUniformLocation(shader, 'ICMMinInLuminance'), 0.0, 0.0, 0.0);
+        glUniform3f(glGetUniformLocation(shader, 'ICMMaxInLuminance'), 1.0, 1.0, 1.0);
+        glUniform3f(glGetUniformLocation(shader, 'ICMReciprocalLuminanceRange'), 1.0, 1.0, 1.0);
+        glUniform3f(glGetUniformLocation(shader, 'ICMOutputGain'), 1.0, 1.0, 1.0);
+        glUniform3f(glGetUniformLocation(shader, 'ICMOutputBias'), 0.0, 0.0, 0.0);
+        glUniform2f(glGetUniformLocation(shader, 'ICMClampToColorRange'), 0.0, 1.0);
+        glUseProgram(0);
+
+        if k > 1
+            Screen('HookFunction', win, 'AppendBuiltin', 'StereoLeftCompositingBlit', 'Builtin:FlipFBOs', '');
+        end
+        Screen('HookFunction', win, 'AppendShader', 'StereoLeftCompositingBlit', sprintf('GammaStage%i', k), shader);
+    end
+    Screen('HookFunction', win, 'Enable', 'StereoLeftCompositingBlit');
+
+    [x, y] = meshgrid(linspace(0, 1, w), linspace(0, 1, h));
+    tex = Screen('MakeTexture', win, cat(3, x, y, (x + y) / 2), [], [], 2);
+
+    img = cell(1, 2);
+    msecs = zeros(1, 2);
+    for fuse = [0, 1]
+        Screen('Preference', 'FuseHookChainShaders', fuse);
+
+        Screen('DrawTexture', win, tex, [], [], [], 0);
+        Screen('Flip', win);
+        img{fuse + 1} = Screen('GetImage', win, [], 'frontBuffer', 1, 3);
+
+        % Flips without sync to retrace, finished by a tiny readback:
+        t0 = GetSecs;
+        for i = 1:300
+            Screen('DrawTexture', win, tex, [], [], [], 0);
+            Screen('Flip', win, 0, 0, 2);
+        end
+        Screen('GetImage', win, [0 0 1 1], 'frontBuffer');
+        msecs(fuse + 1) = 1000 * (GetSecs - t0) / 300;
+    end
+
+    maxDiff = max(abs(img{1}(:) - img{2}(:)));
+    fprintf('%i stages: Max difference %g. Unfused %8.3f msecs, fused %8.3f msecs per flip.\n', nrStages, maxDiff, msecs(1), msecs(2));
+
+    if maxDiff > tolerance
+        error('Fused hook chain differs by up to %g from unfused chain, more than the tolerance of %g!', maxDiff, tolerance);
+    end
+catch
+    sca;
+    Screen('Preference', 'FuseHookChainShaders', oldfuse);
+    psychrethrow(psychlasterror);
+end
+
+sca;
+Screen('Preference', 'FuseHookChainShaders', oldfuse);
+
+return;
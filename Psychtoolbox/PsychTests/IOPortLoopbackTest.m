@@ -0,0 +1,151 @@
+function IOPortLoopbackTest(port)
+% IOPortLoopbackTest([port=45678])
+%
+% Correctness test for IOPort's network socket and pseudo-terminal port
+% types, via loopback connections on the local machine.
+%
+% The following connections are tested, each in both directions:
+%
+% 'tcp'   A TCP server, opened via 'tcplisten:127.0.0.1:port', and a client
+%         connected to it via 'tcp:127.0.0.1:port'.
+% 'udp'   Two UDP sockets at local ports 'port' + 1 and 'port' + 2, each
+%         connected to the other one.
+% 'unix'  A Unix domain socket server and client, with a socket file in
+%         the temporary directory.
+% 'pty'   A pseudo-terminal, opened via IOPort('OpenPty'), with its slave
+%         side opened via IOPort('OpenSerialPort').
+%
+% For each connection, the test checks blocking and non-blocking reads and
+% writes, read timeouts, 'BytesAvailable' and 'Purge', line buffered
+% background reads with per line receive timestamps, and the timing of a
+% scheduled trigger byte emission.
+%
+% Optional parameter 'port' selects the TCP and UDP ports to use.
+%
+% Only works on Linux and macOS.
+
+if nargin < 1 || isempty(port)
+    port = 45678;
+end
+
+if IsWin
+    error('Sorry, this test only works on Linux and macOS.');
+end
+
+config = 'ReceiveTimeout=0.2 InputBufferSize=4096';
+unixSocket = [tempdir 'IOPortLoopbackTest.sock'];
+if exist(unixSocket, 'file')
+    delete(unixSocket);
+end
+
+oldverbosity = IOPort('Verbosity', 2);
+failed = 0;
+
+try
+    % TCP:
+    server = IOPort('OpenSocket', sprintf('tcplisten:127.0.0.1:%i', port), config);
+    client = IOPort('OpenSocket', sprintf('tcp:127.0.0.1:%i', port), config);
+    failed = failed + testPair('tcp', client, server);
+    failed = failed + testPair('tcp-reverse', server, client);
+    IOPort('Close', client);
+    IOPort('Close', server);
+
+    % UDP:
+    a = IOPort('OpenSocket', sprintf('udp:127.0.0.1:%i', port + 2), sprintf('%s LocalPort=%i', config, port + 1));
+    b = IOPort('OpenSocket', sprintf('udp:127.0.0.1:%i', port + 1), sprintf('%s LocalPort=%i', config, port + 2));
+    failed = failed + testPair('udp', a, b);
+    failed = failed + testPair('udp-reverse', b, a);
+    IOPort('Close', a);
+    IOPort('Close', b);
+
+    % Unix domain sockets:
+    server = IOPort('OpenSocket', ['unixlisten:' unixSocket], config);
+    client = IOPort('OpenSocket', ['unix:' unixSocket], config);
+    failed = failed + testPair('unix', client, server);
+    failed = failed + testPair('unix-reverse', server, client);
+    IOPort('Close', client);
+    IOPort('Close', server);
+    failed = failed + check(~exist(unixSocket, 'file'), 'unix', 'Socket file removed at close');
+
+    % Pseudo-terminal: 'Lenient', as the slave has no modem control lines:
+    [master, errmsg, slaveName] = IOPort('OpenPty', config);
+    slave = IOPort('OpenSerialPort', slaveName, ['Lenient ' config]);
+    failed = failed + testPair('pty', master, slave);
+    failed = failed + testPair('pty-reverse', slave, master);
+    IOPort('Close', slave);
+    IOPort('Close', master);
+catch
+    IOPort('CloseAll');
+    IOPort('Verbosity', oldverbosity);
+    psychrethrow(psychlasterror);
+end
+
+IOPort('Verbosity', oldverbosity);
+
+if failed
+    fprintf('\nIOPortLoopbackTest: %i checks FAILED!\n', failed);
+else
+    fprintf('\nIOPortLoopbackTest: All checks passed.\n');
+end
+
+return;
+
+function failed = testPair(name, sender, receiver)
+    failed = 0;
+
+    % Blocking write and blocking read:
+    msg = 'Hello loopback!';
+    nw = IOPort('Write', sender, msg);
+    data = IOPort('Read', receiver, 1, length(msg));
+    failed = failed + check(nw == length(msg) && strcmp(char(data), msg), name, 'Blocking write and read');
+
+    % Non-blocking read without pending data, and blocking read timeout:
+    data = IOPort('Read', receiver);
+    failed = failed + check(isempty(data), name, 'Non-blocking read of empty port');
+    t = GetSecs;
+    data = IOPort('Read', receiver, 1, 10);
+    failed = failed + check(isempty(data) && (GetSecs - t > 0.15), name, 'Blocking read timeout');
+
+    % BytesAvailable and Purge:
+    IOPort('Write', sender, uint8(1:3));
+    WaitSecs('YieldSecs', 0.05);
+    failed = failed + check(IOPort('BytesAvailable', receiver) == 3, name, 'BytesAvailable');
+    IOPort('Purge', receiver);
+    failed = failed + check(IOPort('BytesAvailable', receiver) == 0, name, 'Purge');
+
+    % Line buffered background reads with timestamps:
+    IOPort('ConfigureSerialPort', receiver, 'Lenient ReadFilterFlags=4 Terminator=10');
+    IOPort('ConfigureSerialPort', receiver, 'Lenient StartBackgroundRead=32');
+    bad = 0;
+    latency = zeros(1, 100);
+    for i = 1:100
+        line = sprintf('Line %i\n', i);
+        [nw, tSend] = IOPort('Write', sender, line); %#ok<ASGLU>
+        [data, tRecv] = IOPort('Read', receiver, 1, 32);
+        if length(data) ~= 32 || ~strcmp(char(data(1:length(line))), line) || any(data(length(line)+1:end))
+            bad = bad + 1;
+        end
+        latency(i) = tRecv - tSend;
+    end
+    failed = failed + check(bad == 0, name, 'Background line reads');
+    failed = failed + check(all(latency > -0.001) && all(latency < 0.1), name, 'Background read timestamps');
+    IOPort('ConfigureSerialPort', receiver, 'Lenient StopBackgroundRead');
+    IOPort('ConfigureSerialPort', receiver, 'Lenient ReadFilterFlags=0');
+
+    % Scheduled trigger byte emission:
+    tTrigger = GetSecs + 0.1;
+    IOPort('ConfigureSerialPort', sender, sprintf('Lenient JLFireTrigger=%f', tTrigger));
+    [data, tRecv] = IOPort('Read', receiver, 1, 1);
+    failed = failed + check(isequal(data, 255) && (tRecv >= tTrigger) && (tRecv < tTrigger + 0.01), name, 'Scheduled trigger byte');
+
+    fprintf('%-12s: Median line latency %f msecs, trigger byte received %f msecs after deadline.\n', name, 1000 * median(latency), 1000 * (tRecv - tTrigger));
+return;
+
+function failed = check(condition, name, what)
+    if condition
+        failed = 0;
+    else
+        failed = 1;
+        fprintf('%-12s: FAILED: %s\n', name, what);
+    end
+return;
@@ -0,0 +1,141 @@
+function results = IOPortPtyBenchmark(nrLines, nrBytes)
+% results = IOPortPtyBenchmark([nrLines=2000][, nrBytes=4MB])
+%
+% Benchmark latency, throughput and cpu cost of IOPort's background serial
+% port reader, independent of serial port hardware and drivers.
+%
+% The benchmark uses a pseudo-terminal (pty) as a virtual serial port
+% connection: Data is sent to its master side, opened via IOPort('OpenPty'),
+% and received from its slave side, opened via IOPort('OpenSerialPort') like
+% any real serial port. It only works on Linux and macOS.
+%
+% Two measurements are done, each once with the event driven background
+% reader, ie., 'EventDrivenBackgroundRead=1', which is the default, and once
+% with the classic polling background reader, 'EventDrivenBackgroundRead=0':
+%
+% 'Lines'  'nrLines' text lines are sent one at a time, and received with
+%          line buffered background reading, ie., 'ReadFilterFlags=4'. For
+%          each line, the latency between sending it and the background
+%          reader timestamping its reception is measured.
+%
+% 'Raw'    'nrBytes' bytes of random data are sent in 4096 byte blocks, and
+%          received with a background read granularity of 1 byte. The
+%          throughput is measured and the received data is verified.
+%
+% The function returns a struct array 'results' with one element per
+% measurement, with fields 'mode', 'test', 'meanLatencyMsecs',
+% 'maxLatencyMsecs', 'mbPerSec', 'errors' and 'cpuSecs', and prints them as a
+% table. 'cpuSecs' is the cpu time consumed by Octave or Matlab during the
+% measurement, including the background reader thread.
+
+if nargin < 1 || isempty(nrLines)
+    nrLines = 2000;
+end
+
+if nargin < 2 || isempty(nrBytes)
+    nrBytes = 4 * 1024 * 1024;
+end
+
+if IsWin
+    error('Sorry, this benchmark only works on Linux and macOS.');
+end
+
+% 'Lenient' is needed, as pty's don't support modem control lines:
+config = 'BaudRate=115200 ProcessingMode=Raw Lenient ReceiveTimeout=1.0 InputBufferSize=1048576 OutputBufferSize=65536 Terminator=10';
+oldverbosity = IOPort('Verbosity', 2);
+results = struct('mode', {}, 'test', {}, 'meanLatencyMsecs', {}, 'maxLatencyMsecs', {}, 'mbPerSec', {}, 'errors', {}, 'cpuSecs', {});
+
+try
+    for eventDriven = [1, 0]
+        if eventDriven
+            mode = 'Event';
+        else
+            mode = 'Polling';
+        end
+
+        [sender, errmsg, slaveName] = IOPort('OpenPty', config);
+        receiver = IOPort('OpenSerialPort', slaveName, sprintf('%s EventDrivenBackgroundRead=%i', config, eventDriven));
+
+        % Line test:
+        IOPort('ConfigureSerialPort', receiver, 'Lenient ReadFilterFlags=4');
+        IOPort('ConfigureSerialPort', receiver, 'Lenient StartBackgroundRead=64');
+
+        latencies = zeros(1, nrLines);
+        errors = 0;
+        c0 = cputime;
+        for i = 1:nrLines
+            line = sprintf('L%06i,payload-abcdefghijklmnopqrstuvwxyz\n', i);
+            [nw, tSend] = IOPort('Write', sender, line);
+            [data, tRecv] = IOPort('Read', receiver, 1, 64);
+            if length(data) < length(line) || ~strcmp(char(data(1:length(line))), line)
+                errors = errors + 1;
+            end
+            latencies(i) = tRecv - tSend;
+        end
+        cpuSecs = cputime - c0;
+
+        IOPort('ConfigureSerialPort', receiver, 'Lenient StopBackgroundRead');
+        IOPort('ConfigureSerialPort', receiver, 'Lenient ReadFilterFlags=0');
+
+        r.mode = mode;
+        r.test = 'Lines';
+        r.meanLatencyMsecs = 1000 * mean(latencies);
+        r.maxLatencyMsecs = 1000 * max(latencies);
+        r.mbPerSec = NaN;
+        r.errors = errors;
+        r.cpuSecs = cpuSecs;
+        results(end+1) = r; %#ok<AGROW>
+        fprintf('%-8s %-6s: Latency mean %8.3f msecs, max %8.3f msecs, %3i errors, cpu %6.3f secs.\n', r.mode, r.test, r.meanLatencyMsecs, r.maxLatencyMsecs, r.errors, r.cpuSecs);
+
+        % Raw throughput test:
+        IOPort('ConfigureSerialPort', receiver, 'Lenient StartBackgroundRead=1');
+
+        block = uint8(floor(rand(1, 4096) * 256));
+        received = zeros(1, nrBytes, 'uint8');
+        nrecv = 0;
+        nsent = 0;
+        c0 = cputime;
+        t0 = GetSecs;
+        while nrecv < nrBytes
+            if nsent < nrBytes
+                nsent = nsent + IOPort('Write', sender, block);
+            end
+
+            data = IOPort('Read', receiver, 0, min(nrBytes - nrecv, 1048576));
+            if ~isempty(data)
+                received(nrecv+1:nrecv+length(data)) = data;
+                nrecv = nrecv + length(data);
+            elseif nsent >= nrBytes
+                WaitSecs('YieldSecs', 0.0001);
+            end
+
+            if GetSecs - t0 > 60
+                break;
+            end
+        end
+        t1 = GetSecs;
+        cpuSecs = cputime - c0;
+
+        expected = repmat(block, 1, ceil(nrBytes / length(block)));
+        r.mode = mode;
+        r.test = 'Raw';
+        r.meanLatencyMsecs = NaN;
+        r.maxLatencyMsecs = NaN;
+        r.mbPerSec = nrecv / (t1 - t0) / 1e6;
+        r.errors = sum(received ~= expected(1:nrBytes));
+        r.cpuSecs = cpuSecs;
+        results(end+1) = r; %#ok<AGROW>
+        fprintf('%-8s %-6s: Throughput %8.3f MB/sec, %8i errors, cpu %6.3f secs.\n', r.mode, r.test, r.mbPerSec, r.errors, r.cpuSecs);
+
+        IOPort('Close', receiver);
+        IOPort('Close', sender);
+    end
+catch
+    IOPort('CloseAll');
+    IOPort('Verbosity', oldverbosity);
+    psychrethrow(psychlasterror);
+end
+
+IOPort('Verbosity', oldverbosity);
+
+return;
@@ -0,0 +1,146 @@
+function IOPortRecordDecoderTest(nrRecords)
+% IOPortRecordDecoderTest([nrRecords=20000])
+%
+% Test and benchmark IOPort's decoding of binary records in background
+% reads, ie., the 'RecordLayout' and 'RecordSync' settings and the
+% IOPort('ReadRecords') function.
+%
+% 'nrRecords' binary records of 22 bytes each are sent through a
+% pseudo-terminal, opened via IOPort('OpenPty'), and received on its slave
+% side with a background read with 'RecordLayout' set. Each record mimics a
+% sample packet of an amplifier or eye tracker: A sync byte, a sample
+% counter, two big endian 24 bit channels, a little endian 16 bit value, a
+% 32 bit float and a big endian 64 bit float. A few garbage bytes are
+% inserted between some records, to test resynchronization to the sync byte.
+%
+% All decoded values and the monotonicity of the record timestamps are
+% verified, the test aborts with an error on any mismatch. The time needed
+% for fetching and decoding the records with IOPort('ReadRecords') is
+% compared to fetching them with IOPort('Read') and decoding them in the
+% script via typecast().
+%
+% Only works on Linux and macOS.
+
+if nargin < 1 || isempty(nrRecords)
+    nrRecords = 20000;
+end
+
+if IsWin
+    error('Sorry, this test only works on Linux and macOS.');
+end
+
+recSize = 22;
+layout = 'RecordLayout=u8@1,i24be@2x2,i16le@8,f32@10,f64be@14 RecordSync=170';
+config = sprintf('Lenient ReceiveTimeout=1.0 InputBufferSize=%i', recSize * (nrRecords + 100));
+
+% Build the test stream, with 2 garbage bytes after every 97th record:
+i = 0:nrRecords-1;
+ch1 = -1000 * mod(i, 8000);
+ch2 = 77 * mod(i, 100000);
+s16 = -mod(i, 32768);
+f32 = single(i * 0.5);
+f64 = i * 1.25;
+stream = zeros(nrRecords, recSize, 'uint8');
+stream(:, 1) = 170;
+stream(:, 2) = mod(i, 256);
+stream(:, 3:5) = int24be(ch1);
+stream(:, 6:8) = int24be(ch2);
+for k = 1:nrRecords
+    stream(k, 9:10) = typecast(int16(s16(k)), 'uint8');
+    stream(k, 11:14) = typecast(f32(k), 'uint8');
+    stream(k, 15:22) = fliplr(typecast(f64(k), 'uint8'));
+end
+expected = [mod(i, 256); ch1; ch2; s16; double(f32); f64];
+stream = stream';
+garbage = 97:97:nrRecords;
+
+oldverbosity = IOPort('Verbosity', 2);
+
+try
+    [master, errmsg, slaveName] = IOPort('OpenPty', config);
+    receiver = IOPort('OpenSerialPort', slaveName, config);
+
+    % Decoding in the background reader:
+    IOPort('ConfigureSerialPort', receiver, ['Lenient ' layout]);
+    IOPort('ConfigureSerialPort', receiver, sprintf('Lenient StartBackgroundRead=%i', recSize));
+    sendStream(master, stream, garbage);
+    WaitSecs('YieldSecs', 0.5);
+
+    t0 = GetSecs;
+    [records, when] = IOPort('ReadRecords', receiver);
+    tDecoder = GetSecs - t0;
+    IOPort('ConfigureSerialPort', receiver, 'Lenient StopBackgroundRead');
+
+    if ~isequal(size(records), size(expected)) || any(records(:) ~= expected(:))
+        error('Got %i records, expected %i, or mismatching values!', size(records, 2), nrRecords);
+    end
+
+    if any(diff(when) < 0)
+        error('Record timestamps not monotonic!');
+    end
+
+    fprintf('IOPortRecordDecoderTest: All %i records decoded correctly.\n', nrRecords);
+
+    % Reference: Raw background read and decoding in the script:
+    IOPort('ConfigureSerialPort', receiver, 'Lenient RecordLayout=None RecordSync=-1');
+    IOPort('ConfigureSerialPort', receiver, sprintf('Lenient StartBackgroundRead=%i', recSize));
+    sendStream(master, stream, []);
+    WaitSecs('YieldSecs', 0.5);
+
+    t0 = GetSecs;
+    data = uint8(IOPort('Read', receiver));
+    data = reshape(data, recSize, []);
+    n = size(data, 2);
+    decoded = zeros(6, n);
+    for k = 1:n
+        r = data(:, k);
+        decoded(1, k) = double(r(2));
+        decoded(2, k) = double(typecast(uint8([0, r(5:-1:3)']), 'int32')) / 256;
+        decoded(3, k) = double(typecast(uint8([0, r(8:-1:6)']), 'int32')) / 256;
+        decoded(4, k) = double(typecast(r(9:10)', 'int16'));
+        decoded(5, k) = double(typecast(r(11:14)', 'single'));
+        decoded(6, k) = typecast(r(22:-1:15)', 'double');
+    end
+    tScript = GetSecs - t0;
+    IOPort('ConfigureSerialPort', receiver, 'Lenient StopBackgroundRead');
+
+    if ~isequal(decoded, expected)
+        error('Script reference decoding mismatch!');
+    end
+
+    fprintf('ReadRecords: %f msecs for %i records. Read + script decoding: %f msecs.\n', 1000 * tDecoder, nrRecords, 1000 * tScript);
+
+    IOPort('Close', receiver);
+    IOPort('Close', master);
+catch
+    IOPort('CloseAll');
+    IOPort('Verbosity', oldverbosity);
+    psychrethrow(psychlasterror);
+end
+
+IOPort('Verbosity', oldverbosity);
+
+return;
+
+function bytes = int24be(values)
+    % Two's complement 24 bit big endian bytes, one row per value:
+    values = mod(values(:), 2^24);
+    bytes = uint8([floor(values / 65536), mod(floor(values / 256), 256), mod(values, 256)]);
+return;
+
+function sendStream(port, stream, garbage)
+    % Send records in blocks of 100, with garbage bytes after selected records:
+    isGarbage = false(1, size(stream, 2));
+    isGarbage(garbage) = true;
+    for k = 1:100:size(stream, 2)
+        idx = k:min(k + 99, size(stream, 2));
+        block = [];
+        for j = idx
+            block = [block, stream(:, j)']; %#ok<AGROW>
+            if isGarbage(j)
+                block = [block, uint8([18, 52])]; %#ok<AGROW>
+            end
+        end
+        IOPort('Write', port, block);
+    end
+return;
@@ -0,0 +1,85 @@
+function results = KbQueueEvdevTest(deviceIndex, duration)
+% results = KbQueueEvdevTest([deviceIndex=default keyboard][, duration=10])
+%
+% Compare keyboard queues with X-Server input against keyboard queues with
+% the Linux evdev backend and its kernel timestamps, on Linux/X11.
+%
+% KbQueueCreate flag 8 makes a keyboard queue read its events directly from
+% the kernel evdev device file of the input device 'deviceIndex', bypassing
+% the X-Server, and assign the timestamps taken by the kernel when the
+% input was received. This needs read access to the /dev/input/event*
+% device files, usually by membership of the user in the Unix group
+% 'input'. PsychHID prints a warning and falls back to X-Server input if
+% that is not possible.
+%
+% For 'duration' seconds each, first with X-Server input, then with evdev
+% input, press and release keys on the keyboard. The test polls the queue
+% with KbEventGet in a tight loop and measures for each event the age of
+% its timestamp at the time of retrieval. The age is the delay between the
+% event and its delivery to the script with X-Server input, and usually
+% larger with evdev input, as the kernel timestamp is closer to the real
+% key press.
+%
+% Without a keyboard, a virtual keyboard created via Linux uinput, e.g.,
+% with the python-evdev module, can be used for automatic testing. Create
+% it before the first call to PsychHID, as PsychHID only enumerates its
+% devices at startup, and use its 'deviceIndex' from GetKeyboardIndices.
+%
+% The function returns a struct 'results' with fields 'xNumEvents',
+% 'xMeanAgeMsecs', 'evdevNumEvents' and 'evdevMeanAgeMsecs', and prints
+% them.
+
+if ~IsLinux
+    error('KbQueueEvdevTest: This test only works on Linux.');
+end
+
+if nargin < 1
+    deviceIndex = [];
+end
+
+if nargin < 2 || isempty(duration)
+    duration = 10;
+end
+
+KbName('UnifyKeyNames');
+ages = cell(1, 2);
+names = {'X-Server', 'evdev'};
+
+for evdev = [0, 1]
+    KbQueueCreate(deviceIndex, [], [], [], 8 * evdev);
+    KbQueueStart(deviceIndex);
+
+    fprintf('\n%s input: Press and release some keys within the next %i seconds...\n', names{evdev + 1}, duration);
+    ListenChar(2);
+
+    age = [];
+    tend = GetSecs + duration;
+    while GetSecs < tend
+        [evt, navail] = KbEventGet(deviceIndex); %#ok<ASGLU>
+        if ~isempty(evt)
+            t = GetSecs;
+            age(end + 1) = t - evt.Time; %#ok<AGROW>
+            if evt.Pressed
+                action = 'Press  ';
+            else
+                action = 'Release';
+            end
+            fprintf('%s %-12s CookedKey %4i at %f, age %7.3f msecs.\n', action, ...
+                    KbName(evt.Keycode), evt.CookedKey, evt.Time, 1000 * age(end));
+        end
+    end
+
+    ListenChar(0);
+    KbQueueRelease(deviceIndex);
+    ages{evdev + 1} = age;
+end
+
+results.xNumEvents = length(ages{1});
+results.xMeanAgeMsecs = 1000 * mean(ages{1});
+results.evdevNumEvents = length(ages{2});
+results.evdevMeanAgeMsecs = 1000 * mean(ages{2});
+
+fprintf('\nX-Server input: %i events, mean age %8.3f msecs. evdev input: %i events, mean age %8.3f msecs.\n', ...
+        results.xNumEvents, results.xMeanAgeMsecs, results.evdevNumEvents, results.evdevMeanAgeMsecs);
+
+return;
@@ -0,0 +1,89 @@
+function results = KbQueueGetEventsTest(deviceIndex, duration)
+% results = KbQueueGetEventsTest([deviceIndex=first mouse][, duration=5])
+%
+% Compare the speed of fetching keyboard queue events one at a time via
+% PsychHID('KbQueueGetEvent') against fetching them all at once via
+% PsychHID('KbQueueGetEvents').
+%
+% For 'duration' seconds, move the mouse with index 'deviceIndex' around,
+% to record many mouse motion events with 2 valuators. The first half of
+% the recorded events is then fetched one at a time, the second half all in
+% one go, and the time per fetched event is measured for both methods.
+%
+% Both halves must form one sequence of events with the same layout: The
+% bulk fetched events must have the same fields of the same type as the
+% single fetched ones, as many valuators, and all event timestamps must be
+% in chronological order across both halves. Otherwise the test aborts with
+% an error.
+%
+% The function returns a struct 'results' with fields 'singleNumEvents',
+% 'singleUsecs', 'bulkNumEvents' and 'bulkUsecs', and prints them.
+
+if nargin < 1 || isempty(deviceIndex)
+    deviceIndex = GetMouseIndices;
+    deviceIndex = deviceIndex(1);
+end
+
+if nargin < 2 || isempty(duration)
+    duration = 5;
+end
+
+PsychHID('KbQueueCreate', deviceIndex, [], 2, 100000);
+
+try
+    PsychHID('KbQueueStart', deviceIndex);
+    fprintf('\nMove the mouse around for the next %i seconds...\n', duration);
+    WaitSecs(duration);
+    PsychHID('KbQueueStop', deviceIndex);
+
+    % Fetch the first half of the recorded events one at a time:
+    [first, navail] = PsychHID('KbQueueGetEvent', deviceIndex);
+    if isempty(first) || navail < 1
+        error('Less than 2 events recorded. Did you move the mouse?');
+    end
+
+    singles = repmat(first, 1, ceil((navail + 1) / 2));
+    t0 = GetSecs;
+    for i = 2:length(singles)
+        singles(i) = PsychHID('KbQueueGetEvent', deviceIndex);
+    end
+    t1 = GetSecs;
+
+    results.singleNumEvents = length(singles);
+    results.singleUsecs = 1e6 * (t1 - t0) / max(1, length(singles) - 1);
+
+    % Fetch the second half all in one go:
+    t0 = GetSecs;
+    events = PsychHID('KbQueueGetEvents', deviceIndex);
+    t1 = GetSecs;
+
+    results.bulkNumEvents = length(events.Time);
+    results.bulkUsecs = 1e6 * (t1 - t0) / max(1, results.bulkNumEvents);
+catch
+    PsychHID('KbQueueRelease', deviceIndex);
+    psychrethrow(psychlasterror);
+end
+
+PsychHID('KbQueueRelease', deviceIndex);
+
+fprintf('\nOne at a time: %i events, %8.3f usecs per event. All at once: %i events, %8.3f usecs per event.\n', ...
+        results.singleNumEvents, results.singleUsecs, results.bulkNumEvents, results.bulkUsecs);
+
+% Events of both methods must have the same layout:
+names = fieldnames(first);
+if ~isequal(fieldnames(events), names) || length(first.Valuators) ~= size(events.Valuators, 2)
+    error('Mismatch in layout of single and bulk fetched events!');
+end
+
+for k = 1:length(names)
+    if ~strcmp(class(events.(names{k})), class(first.(names{k})))
+        error('Field %s of bulk fetched events is of class %s instead of %s!', names{k}, class(events.(names{k})), class(first.(names{k})));
+    end
+end
+
+% Both halves are consecutive parts of one recording:
+if ~issorted([singles.Time, events.Time'])
+    error('Single and bulk fetched events are not in chronological order!');
+end
+
+return;
@@ -0,0 +1,80 @@
+function MakeTextureThreadsTest(texSize, screenid)
+% MakeTextureThreadsTest([texSize=1024][, screenid=max])
+%
+% Test multi-threaded conversion of image matrices into textures by
+% Screen('MakeTexture').
+%
+% Screen splits the conversion of image matrices with at least 256k
+% components into chunks, which are converted in parallel by up to
+% Screen('Preference', 'MakeTextureThreads') threads, by default one per
+% processor core up to 8 threads.
+%
+% The test creates textures of about 'texSize' x 'texSize' pixels from
+% uint8 and double image matrices with 1 to 4 layers, as 8 bpc and 32 bpc
+% float textures, single-threaded and with 2, 3 and 8 threads. The image
+% size is chosen so the chunks don't end at row or texel boundaries. All
+% textures must be identical to the single-threaded one, otherwise the test
+% aborts with an error. It then prints the time per texture for creating
+% 'texSize' x 'texSize' RGB textures from double matrices with each number
+% of threads.
+
+if nargin < 1 || isempty(texSize)
+    texSize = 1024;
+end
+
+if nargin < 2 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+oldthreads = Screen('Preference', 'MakeTextureThreads');
+threadCounts = [1, 2, 3, 8];
+
+try
+    win = Screen('OpenWindow', screenid, 0);
+
+    % Matrix class and texture floatprecision of each case:
+    cases = {'double', 0; 'double', 2; 'uint8', 0};
+
+    for layers = 1:4
+        for c = 1:size(cases, 1)
+            img = cast(rand(texSize + 1, round(texSize * 0.75) + 3, layers) * 255, cases{c, 1});
+            floatprecision = cases{c, 2};
+
+            for numThreads = threadCounts
+                Screen('Preference', 'MakeTextureThreads', numThreads);
+                tex = Screen('MakeTexture', win, img, [], [], floatprecision);
+                texImg = Screen('GetImage', tex, [], [], double(floatprecision > 0), layers);
+                Screen('Close', tex);
+
+                if numThreads == 1
+                    refImg = texImg;
+                elseif ~isequal(refImg, texImg)
+                    error('%i layer %s matrix, floatprecision %i: Texture made with %i threads differs from single-threaded one!', ...
+                          layers, class(img), floatprecision, numThreads);
+                end
+            end
+        end
+    end
+
+    img = rand(texSize, texSize, 3);
+    for numThreads = threadCounts
+        Screen('Preference', 'MakeTextureThreads', numThreads);
+        tex = zeros(1, 20);
+        t0 = GetSecs;
+        for i = 1:length(tex)
+            tex(i) = Screen('MakeTexture', win, img);
+        end
+        fprintf('%i threads: %8.3f msecs per %i x %i RGB texture.\n', numThreads, 1000 * (GetSecs - t0) / length(tex), texSize, texSize);
+        Screen('Close', tex);
+    end
+catch
+    sca;
+    Screen('Preference', 'MakeTextureThreads', oldthreads);
+    psychrethrow(psychlasterror);
+end
+
+sca;
+Screen('Preference', 'MakeTextureThreads', oldthreads);
+
+return;
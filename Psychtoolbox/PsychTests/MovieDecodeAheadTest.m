@@ -0,0 +1,92 @@
+function MovieDecodeAheadTest(moviename, decodeAhead, screenid)
+% MovieDecodeAheadTest([moviename=DualDiscs.mov][, decodeAhead=8][, screenid=max])
+%
+% Test decode-ahead of video frames during movie playback, as enabled by
+% the 'movieOptions' keyword DecodeAhead=n in Screen('OpenMovie').
+%
+% With decode-ahead, a decoder thread copies up to 'decodeAhead' decoded
+% frames ahead of time into upload buffers of the graphics driver, so
+% Screen('GetMovieImage') only needs to start an asynchronous upload of
+% the next frame, instead of copying it itself.
+%
+% The test plays the movie 'moviename' twice without frame dropping, ie.
+% with an 'async' flag of 4 in Screen('OpenMovie'), once without and once
+% with decode-ahead. Both playbacks must return the same number of frames,
+% with the same presentation timestamps and the same image content,
+% otherwise the test aborts with an error. It prints the mean and maximum
+% time taken by Screen('GetMovieImage') to return a frame in both cases,
+% and the decode-ahead statistics returned by Screen('PlayMovie').
+%
+% For a meaningful speed comparison, use a high resolution movie, e.g., a
+% 4k movie. The default DualDiscs.mov demo movie is small and mostly tests
+% correctness.
+
+if nargin < 1 || isempty(moviename)
+    moviename = [PsychtoolboxRoot 'PsychDemos/MovieDemos/DualDiscs.mov'];
+end
+
+if nargin < 2 || isempty(decodeAhead)
+    decodeAhead = 8;
+end
+
+if nargin < 3 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+
+try
+    win = Screen('OpenWindow', screenid, 0);
+
+    pts = cell(1, 2);
+    checksums = cell(1, 2);
+    msecs = cell(1, 2);
+    for useDecodeAhead = [0, 1]
+        if useDecodeAhead
+            movie = Screen('OpenMovie', win, moviename, 4, 1, [], [], [], sprintf('DecodeAhead=%i', decodeAhead));
+        else
+            movie = Screen('OpenMovie', win, moviename, 4, 1);
+        end
+        Screen('PlayMovie', movie, 1);
+
+        while 1
+            t0 = GetSecs;
+            [tex, ts] = Screen('GetMovieImage', win, movie, 1);
+            if tex <= 0
+                break;
+            end
+
+            msecs{useDecodeAhead + 1}(end+1) = 1000 * (GetSecs - t0);
+            pts{useDecodeAhead + 1}(end+1) = ts;
+            img = double(Screen('GetImage', tex));
+            checksums{useDecodeAhead + 1}(end+1) = sum(img(:) .* (1:numel(img))');
+
+            Screen('DrawTexture', win, tex);
+            Screen('Flip', win, 0, 0, 2);
+            Screen('Close', tex);
+        end
+
+        [droppedframes, decodeStats] = Screen('PlayMovie', movie, 0); %#ok<ASGLU>
+        Screen('CloseMovie', movie);
+    end
+
+    fprintf('%i frames. GetMovieImage without decode-ahead: mean %8.3f msecs, max %8.3f msecs.\n', numel(pts{1}), mean(msecs{1}), max(msecs{1}));
+    fprintf('%i frames. GetMovieImage with decode-ahead:    mean %8.3f msecs, max %8.3f msecs.\n', numel(pts{2}), mean(msecs{2}), max(msecs{2}));
+    disp(decodeStats);
+
+    if ~isequal(pts{1}, pts{2})
+        error('Frame count or presentation timestamps differ with decode-ahead!');
+    end
+
+    mismatch = find(checksums{1} ~= checksums{2}, 1);
+    if ~isempty(mismatch)
+        error('Image of frame %i differs with decode-ahead!', mismatch);
+    end
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+sca;
+
+return;
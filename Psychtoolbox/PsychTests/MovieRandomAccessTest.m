@@ -0,0 +1,126 @@
+function MovieRandomAccessTest(moviename, nrSegments, segmentLength, frameCache, screenid)
+% MovieRandomAccessTest([moviename=DualDiscs.mov][, nrSegments=4][, segmentLength=5][, frameCache=32][, screenid=max])
+%
+% Test correctness and speed of frame accurate random access to movie
+% frames with a frame index and a frame cache, as enabled by the
+% 'movieOptions' keywords MovieIndex=n and FrameCache=n in
+% Screen('OpenMovie').
+%
+% The test picks 'nrSegments' random clip segments of 'segmentLength'
+% successive frames each in the movie 'moviename', and fetches all frames
+% of all segments in manual fetch mode, by seeking to each frame with
+% Screen('SetMovieTimeIndex') in frames, followed by Screen('GetMovieImage').
+% This is done once for the movie opened without any options as reference,
+% and twice for the movie opened with MovieIndex=1 and FrameCache=frameCache,
+% the second time in reverse segment order, as a trial paradigm which jumps
+% between the same clip segments would do. The fetched frames and their
+% presentation timestamps must be identical to the reference, otherwise the
+% test aborts with an error. It prints the mean time for seek and fetch of
+% a frame in each pass, and the seek statistics of the last pass.
+%
+% For a meaningful speed comparison, use a long movie with long groups of
+% pictures, e.g., a H.264 movie with a keyframe only every few seconds.
+% The first run on a movie creates a .ptbindex frame index cache file next
+% to the movie, if the movie directory is writable.
+
+if nargin < 1 || isempty(moviename)
+    moviename = [PsychtoolboxRoot 'PsychDemos/MovieDemos/DualDiscs.mov'];
+end
+
+if nargin < 2 || isempty(nrSegments)
+    nrSegments = 4;
+end
+
+if nargin < 3 || isempty(segmentLength)
+    segmentLength = 5;
+end
+
+if nargin < 4 || isempty(frameCache)
+    frameCache = 32;
+end
+
+if nargin < 5 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+
+try
+    win = Screen('OpenWindow', screenid, 0);
+
+    % Random segment start frames, reproducible across runs:
+    [movie, duration, fps, w, h, count] = Screen('OpenMovie', win, moviename); %#ok<ASGLU>
+    Screen('CloseMovie', movie);
+    rand('seed', 42); %#ok<RAND>
+    starts = floor(rand(1, nrSegments) * (count - segmentLength));
+    frames = repmat(starts, segmentLength, 1) + repmat((0:segmentLength-1)', 1, nrSegments);
+    frames = frames(:)';
+
+    % Pass 1 is the reference without options, passes 2 and 3 with frame index and frame cache:
+    checksums = cell(1, 3);
+    pts = cell(1, 3);
+    msecs = zeros(1, 3);
+    for pass = 1:3
+        if pass == 1
+            movie = Screen('OpenMovie', win, moviename);
+            perm = 1:numel(frames);
+        elseif pass == 2
+            movie = Screen('OpenMovie', win, moviename, [], [], [], [], [], sprintf('MovieIndex=1:::FrameCache=%i', frameCache));
+        else
+            % Same segments again, in reverse segment order:
+            perm = reshape(1:numel(frames), segmentLength, nrSegments);
+            perm = perm(:, end:-1:1);
+            perm = perm(:)';
+        end
+        order = frames(perm);
+
+        sums = zeros(1, numel(order));
+        ts = zeros(1, numel(order));
+        durs = zeros(1, numel(order));
+        for i = 1:numel(order)
+            t0 = GetSecs;
+            Screen('SetMovieTimeIndex', movie, order(i), 1);
+            [tex, ts(i)] = Screen('GetMovieImage', win, movie, 1);
+            durs(i) = GetSecs - t0;
+
+            img = double(Screen('GetImage', tex));
+            sums(i) = sum(img(:) .* (1:numel(img))');
+            Screen('Close', tex);
+        end
+
+        % Store in order of the reference pass:
+        checksums{pass}(perm) = sums;
+        pts{pass}(perm) = ts;
+        msecs(pass) = 1000 * mean(durs);
+
+        if pass ~= 2
+            [~, seekStats] = Screen('SetMovieTimeIndex', movie, 0);
+            Screen('CloseMovie', movie);
+        end
+    end
+
+    fprintf('%i frames in %i segments.\n', numel(frames), nrSegments);
+    fprintf('Seek and fetch without index and cache:       mean %8.3f msecs.\n', msecs(1));
+    fprintf('Seek and fetch with index, first access:      mean %8.3f msecs.\n', msecs(2));
+    fprintf('Seek and fetch with index and cache, repeat:  mean %8.3f msecs.\n', msecs(3));
+    disp(seekStats);
+
+    for pass = 2:3
+        mismatch = find(checksums{pass} ~= checksums{1}, 1);
+        if ~isempty(mismatch)
+            error('Pass %i: Image of frame %i differs with frame index and cache!', pass, frames(mismatch));
+        end
+
+        mismatch = find(pts{pass} ~= pts{1}, 1);
+        if ~isempty(mismatch)
+            error('Pass %i: Presentation timestamp of frame %i differs with frame index and cache!', pass, frames(mismatch));
+        end
+    end
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+sca;
+
+return;
@@ -0,0 +1,95 @@
+function frames = PipelineProfilingTest(nrFlips, screenid)
+% frames = PipelineProfilingTest([nrFlips=100][, screenid=max])
+%
+% Report per-stage GPU and CPU times of imaging pipeline hook chains and
+% flips, as measured by the pipeline profiler of Screen.
+%
+% Screen('GetWindowInfo', win, 10, 1) enables the profiler of onscreen
+% window 'win'. From then on, the pre- and postflip operations of each
+% Screen('Flip'), each multisample resolve or panelfitter blit, and each
+% hook chain slot are timed on the CPU, and on the GPU via asynchronously
+% collected timestamp queries if the GPU supports GL_ARB_timer_query.
+% Screen('GetWindowInfo', win, 10) returns and removes all completed
+% frames, see "Screen GetWindowInfo?" for details.
+%
+% The test opens a multisampled 32 bpc floating point window with gamma
+% correction via PsychColorCorrection, draws and flips 'nrFlips' frames
+% without sync to retrace, and prints the mean GPU and CPU times of each
+% stage. It aborts with an error if no frame got completed, if a frame
+% lacks the stages of the multisample resolve or gamma correction, or if
+% the CPU times of its top-level stages don't add up to its total CPU
+% time. It also works on headless Mesa, e.g., with the llvmpipe software
+% renderer under Xvfb.
+%
+% The function returns the struct array 'frames' of all completed frames.
+
+if nargin < 1 || isempty(nrFlips)
+    nrFlips = 100;
+end
+
+if nargin < 2 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+
+try
+    PsychImaging('PrepareConfiguration');
+    PsychImaging('AddTask', 'General', 'FloatingPoint32Bit');
+    PsychImaging('AddTask', 'FinalFormatting', 'DisplayColorCorrection', 'SimpleGamma');
+    win = PsychImaging('OpenWindow', screenid, 0, [], [], [], [], 4);
+    PsychColorCorrection('SetEncodingGamma', win, 1 / 2.2);
+
+    modes = {'CPU times only.', 'GPU and CPU times.'};
+    mode = Screen('GetWindowInfo', win, 10, 1);
+    fprintf('Profiler enabled: %s\n', modes{mode});
+
+    frames = [];
+    for i = 1:nrFlips
+        Screen('FillOval', win, [1 1 0], CenterRect([0 0 200 200], Screen('Rect', win)) + [mod(i, 100) 0 mod(i, 100) 0]);
+        Screen('Flip', win, 0, 0, 2);
+        frames = [frames, Screen('GetWindowInfo', win, 10)]; %#ok<AGROW>
+    end
+
+    % Wait for the results of the last frames:
+    Screen('Flip', win);
+    WaitSecs(0.2);
+    frames = [frames, Screen('GetWindowInfo', win, 10)];
+
+    Screen('GetWindowInfo', win, 10, 0);
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+sca;
+
+if isempty(frames)
+    error('The profiler did not complete any of the %i frames!', nrFlips + 1);
+end
+
+fprintf('%i of %i frames completed. Mean per frame: GPU %8.3f msecs, CPU %8.3f msecs.\n', length(frames), ...
+        nrFlips + 1, 1000 * mean([frames.GPUTime]), 1000 * mean([frames.CPUTime]));
+
+% Mean times per stage name over all frames:
+stages = [frames.Stages];
+names = unique({stages.Name});
+for k = 1:length(names)
+    sel = stages(strcmp({stages.Name}, names{k}));
+    fprintf('%s%-60s GPU %8.3f msecs, CPU %8.3f msecs.\n', repmat('  ', 1, sel(1).Level), names{k}, ...
+            1000 * mean([sel.GPUTime]), 1000 * mean([sel.CPUTime]));
+end
+
+for i = 1:length(frames)
+    frameStages = frames(i).Stages;
+    if ~any(strcmp({frameStages.Name}, 'MSAAResolve')) || ~any(strncmp({frameStages.Name}, 'FinalOutputFormattingBlit:', 26))
+        error('Frame %i lacks the stages of the multisample resolve or gamma correction!', i);
+    end
+
+    top = frameStages([frameStages.Level] == 0);
+    if abs(sum([top.CPUTime]) - frames(i).CPUTime) > 1e-6
+        error('Frame %i: The CPU times of its top-level stages do not add up to its total CPU time!', i);
+    end
+end
+
+return;
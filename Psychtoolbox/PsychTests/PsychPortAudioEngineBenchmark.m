@@ -0,0 +1,175 @@
+function results = PsychPortAudioEngineBenchmark(slaveCounts, duration, realtime, sinkFile)
+% results = PsychPortAudioEngineBenchmark([slaveCounts=[1, 8, 64]][, duration=2][, realtime=0][, sinkFile])
+%
+% Benchmark the processing cost of the PsychPortAudio audio engine for
+% various typical setups, independent of sound hardware and sound drivers.
+%
+% The benchmark uses the virtual null audio device, 'deviceid' -2 in
+% PsychPortAudio('Open'), which doesn't output any sound, but runs the
+% regular audio engine, either in realtime like a real sound card would, or
+% by default as fast as possible. See "PsychPortAudio Open?" for details.
+%
+% The following setups are tested, each for each number of slave devices
+% in 'slaveCounts':
+%
+% 'Plain'     A regular device playing a sound in a loop. Doesn't use slaves.
+% 'Slaves'    A master device with the given number of playing slaves.
+% 'Modulated' Like 'Slaves', but each slave is modulated by its own playing
+%             AM modulator slave.
+% 'Schedule'  Like 'Slaves', but each slave plays a looping schedule of four
+%             different sound buffers.
+% 'Resampled' Like 'Slaves', but each slave plays at 44.1 kHz, converted in
+%             realtime to the 48 kHz of the master.
+% 'Filtered'  Like 'Slaves', but each slave has an insert chain of a 4 section
+%             biquad filter and a 1024 tap FIR filter.
+%
+% Each setup runs for 'duration' seconds, then the cost of the audio
+% callback per sample frame is computed from the CPULoad reported by
+% PsychPortAudio('GetStatus'). When rendering as fast as possible, the
+% achieved speedup over realtime is measured as well.
+%
+% Optional parameters:
+%
+% 'slaveCounts' Vector of slave counts to test. Default is [1, 8, 64].
+%
+% 'duration'    Run time in seconds per measurement. Default 2 secs.
+%
+% 'realtime'    0 = Render as fast as possible (default), 1 = In realtime.
+%
+% 'sinkFile'    Optional name of a file to write the sound output of each
+%               measurement to, as raw interleaved 32 bit float samples.
+%               Only the output of the last measurement remains in it.
+%
+% The function returns a struct array 'results' with one element per
+% setup and slave count, with fields 'setup', 'nrSlaves', 'usecsPerFrame'
+% and 'speedup' over realtime, and prints them as a table.
+
+if nargin < 1 || isempty(slaveCounts)
+    slaveCounts = [1, 8, 64];
+end
+
+if nargin < 2 || isempty(duration)
+    duration = 2;
+end
+
+if nargin < 3 || isempty(realtime)
+    realtime = 0;
+end
+
+if nargin < 4
+    sinkFile = [];
+end
+
+% Initialize driver:
+InitializePsychSound(1);
+
+% Be less chatty during the many open/close cycles:
+oldverbosity = PsychPortAudio('Verbosity', 2);
+
+nrchannels = 2;
+freq = 48000;
+buffersize = 256;
+setups = {'Plain', 'Slaves', 'Modulated', 'Schedule', 'Resampled', 'Filtered'};
+
+% specialFlags 32 = Render as fast as possible:
+if realtime
+    specialFlags = 0;
+else
+    specialFlags = 32;
+end
+
+results = struct('setup', {}, 'nrSlaves', {}, 'usecsPerFrame', {}, 'speedup', {});
+
+try
+    for si = 1:length(setups)
+        setup = setups{si};
+
+        if strcmp(setup, 'Plain')
+            counts = 0;
+        else
+            counts = slaveCounts;
+        end
+
+        for nrSlaves = counts
+            if strcmp(setup, 'Plain')
+                % Regular playback device:
+                pahandle = PsychPortAudio('Open', -2, 1, 1, freq, nrchannels, buffersize, [], [], specialFlags, sinkFile);
+                PsychPortAudio('FillBuffer', pahandle, 0.1 * (2 * rand(nrchannels, freq) - 1));
+                PsychPortAudio('Start', pahandle, 0, 0, 1);
+            else
+                % Master device with slaves:
+                pahandle = PsychPortAudio('Open', -2, 1 + 8, 1, freq, nrchannels, buffersize, [], [], specialFlags, sinkFile);
+                PsychPortAudio('Start', pahandle, 0, 0, 1);
+
+                for i = 1:nrSlaves
+                    slave = PsychPortAudio('OpenSlave', pahandle, 1);
+
+                    switch setup
+                        case 'Slaves'
+                            PsychPortAudio('FillBuffer', slave, 0.01 * (2 * rand(nrchannels, freq) - 1));
+
+                        case 'Modulated'
+                            PsychPortAudio('FillBuffer', slave, 0.01 * (2 * rand(nrchannels, freq) - 1));
+
+                            % AM modulator with a 4 Hz envelope:
+                            modulator = PsychPortAudio('OpenSlave', slave, 32);
+                            envelope = 0.5 + 0.5 * sin(2 * pi * 4 * (0:freq-1) / freq);
+                            PsychPortAudio('FillBuffer', modulator, repmat(envelope, nrchannels, 1));
+                            PsychPortAudio('Start', modulator, 0, 0, 1);
+
+                        case 'Schedule'
+                            PsychPortAudio('UseSchedule', slave, 1, 4);
+                            for j = 1:4
+                                buffer = PsychPortAudio('CreateBuffer', [], 0.01 * (2 * rand(nrchannels, freq / 4) - 1));
+                                PsychPortAudio('AddToSchedule', slave, buffer);
+                            end
+
+                        case 'Resampled'
+                            PsychPortAudio('SlaveSampleRate', slave, 44100);
+                            PsychPortAudio('FillBuffer', slave, 0.01 * (2 * rand(nrchannels, 44100) - 1));
+
+                        case 'Filtered'
+                            PsychPortAudio('FillBuffer', slave, 0.01 * (2 * rand(nrchannels, freq) - 1));
+
+                            % Four identical lowpass sections, and a decaying noise FIR:
+                            PsychPortAudio('AddInsert', slave, 'biquad', repmat([0.2 0.4 0.2 1 -0.3 0.1], 4, 1));
+                            PsychPortAudio('AddInsert', slave, 'fir', 0.01 * randn(1, 1024) .* exp(-(0:1023) / 200));
+                    end
+
+                    % Play in an endless loop:
+                    PsychPortAudio('Start', slave, 0, 0, 1);
+                end
+            end
+
+            % Let it settle, then measure over 'duration' seconds:
+            WaitSecs('YieldSecs', 0.5);
+            s1 = PsychPortAudio('GetStatus', pahandle);
+            t1 = GetSecs;
+            WaitSecs('YieldSecs', duration);
+            s2 = PsychPortAudio('GetStatus', pahandle);
+            t2 = GetSecs;
+
+            % CPULoad is the fraction of the duration of each buffer spent in the callback:
+            r.setup = setup;
+            r.nrSlaves = nrSlaves;
+            r.usecsPerFrame = 1e6 * s2.CPULoad / freq;
+            r.speedup = ((s2.ElapsedOutSamples - s1.ElapsedOutSamples) / freq) / (t2 - t1);
+            results(end+1) = r; %#ok<AGROW>
+
+            fprintf('%-10s Slaves %4i: %8.4f usecs per sample frame, %8.2f x realtime.\n', setup, nrSlaves, r.usecsPerFrame, r.speedup);
+
+            % Closing the master also closes all its slaves and modulators:
+            PsychPortAudio('Stop', pahandle);
+            PsychPortAudio('Close', pahandle);
+            PsychPortAudio('DeleteBuffer');
+        end
+    end
+catch
+    PsychPortAudio('Close');
+    PsychPortAudio('Verbosity', oldverbosity);
+    psychrethrow(psychlasterror);
+end
+
+PsychPortAudio('Verbosity', oldverbosity);
+
+return;
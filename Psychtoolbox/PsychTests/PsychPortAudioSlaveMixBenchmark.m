@@ -0,0 +1,117 @@
+function results = PsychPortAudioSlaveMixBenchmark(workerCounts, slaveCounts, deviceid, duration)
+% results = PsychPortAudioSlaveMixBenchmark([workerCounts=[0, 1, 2, 3]][, slaveCounts=[1, 2, 4, ..., 512]][, deviceid=-1][, duration=2])
+%
+% Benchmark the cost of mixing many playing slave devices on a
+% PsychPortAudio master device, with serial slave rendering on the audio
+% thread, and with parallel slave rendering on a pool of worker threads.
+%
+% For each number of worker threads in 'workerCounts', and each number of
+% slaves in 'slaveCounts', the script opens a master device, attaches the
+% given number of playback slaves to it, each playing a different noise
+% sound at low volume, lets them play for 'duration' seconds and then
+% measures the CPULoad of the master device, as reported by
+% PsychPortAudio('GetStatus'). CPULoad is the fraction of the available
+% time per audio buffer that is spent in the audio callback, ie., values
+% approaching 1.0 mean that the system is about to underrun and glitch.
+%
+% A worker count of 0 selects traditional serial rendering of slaves. See
+% "PsychPortAudio EngineTunables?" for the 'slaveWorkerThreads' setting.
+%
+% Optional parameters:
+%
+% 'workerCounts' Vector of worker thread counts to test. Default is [0,1,2,3].
+%
+% 'slaveCounts' Vector of slave counts to test. Default is 2.^(0:9), ie.,
+%               1, 2, 4, ..., 512 slaves.
+%
+% 'deviceid'    Output device to use. Default is -1 for the default device.
+%
+% 'duration'    Playback duration in seconds per measurement. Default 2 secs.
+%
+% The function returns a matrix 'results' with one row per worker count
+% and one column per slave count, containing the measured CPULoad. It also
+% plots the results.
+%
+% The sound output will be a low volume noise. Turn down your speakers.
+
+if nargin < 1 || isempty(workerCounts)
+    workerCounts = [0, 1, 2, 3];
+end
+
+if nargin < 2 || isempty(slaveCounts)
+    slaveCounts = 2.^(0:9);
+end
+
+if nargin < 3 || isempty(deviceid)
+    deviceid = -1;
+end
+
+if nargin < 4 || isempty(duration)
+    duration = 2;
+end
+
+% Initialize driver, request low-latency preinit:
+InitializePsychSound(1);
+
+% Be less chatty during the many open/close cycles:
+oldverbosity = PsychPortAudio('Verbosity', 2);
+
+nrchannels = 2;
+freq = 48000;
+results = nan(length(workerCounts), length(slaveCounts));
+
+try
+    for wi = 1:length(workerCounts)
+        % Select number of slave worker threads for new masters. Only possible
+        % while no devices are open:
+        PsychPortAudio('Close');
+        PsychPortAudio('EngineTunables', [], [], [], [], [], [], workerCounts(wi));
+
+        for si = 1:length(slaveCounts)
+            nrSlaves = slaveCounts(si);
+
+            % Open master in low latency mode 2 for playback:
+            pamaster = PsychPortAudio('Open', deviceid, 1 + 8, 2, freq, nrchannels);
+            PsychPortAudio('Start', pamaster, 0, 0, 1);
+
+            % Attach and start slaves, each with its own 1 second low volume
+            % noise sound, played in an endless loop:
+            slaves = zeros(1, nrSlaves);
+            for i = 1:nrSlaves
+                slaves(i) = PsychPortAudio('OpenSlave', pamaster, 1);
+                PsychPortAudio('FillBuffer', slaves(i), 0.01 * (2 * rand(nrchannels, freq) - 1));
+                PsychPortAudio('Start', slaves(i), 0, 0, 1);
+            end
+
+            % Let it settle, then measure:
+            WaitSecs('YieldSecs', duration);
+            status = PsychPortAudio('GetStatus', pamaster);
+            results(wi, si) = status.CPULoad;
+
+            fprintf('Workers %i, Slaves %4i: CPULoad %f\n', workerCounts(wi), nrSlaves, results(wi, si));
+
+            % Closing the master also closes all its slaves:
+            PsychPortAudio('Stop', pamaster);
+            PsychPortAudio('Close', pamaster);
+        end
+    end
+catch
+    PsychPortAudio('Close');
+    PsychPortAudio('EngineTunables', [], [], [], [], [], [], 0);
+    PsychPortAudio('Verbosity', oldverbosity);
+    psychrethrow(psychlasterror);
+end
+
+% Back to default serial rendering:
+PsychPortAudio('EngineTunables', [], [], [], [], [], [], 0);
+PsychPortAudio('Verbosity', oldverbosity);
+
+% Plot results:
+figure;
+semilogx(slaveCounts, results', '-o');
+xlabel('Number of slaves');
+ylabel('CPULoad of master');
+title('PsychPortAudio slave mixing cost');
+legend(arrayfun(@(n) sprintf('%i workers', n), workerCounts, 'UniformOutput', false), 'Location', 'NorthWest');
+
+return;
@@ -0,0 +1,50 @@
+function profile = ScreenDispatchProfileTest(nrCalls)
+% profile = ScreenDispatchProfileTest([nrCalls=10000])
+%
+% Test the per-subfunction call profiler of Screen, and measure the
+% overhead of subfunction dispatch by name.
+%
+% Every Psychtoolbox mex module supports the hidden subfunction
+% 'ProfileModuleFunctionsHelper', which profiles the number of calls,
+% total and maximum execution time, and the time spent in the scripting
+% glue outside the subfunction itself, for each subfunction. Type
+% Screen('ProfileModuleFunctionsHelper?') for help.
+%
+% This test calls a few cheap Screen subfunctions 'nrCalls' times each,
+% prints their time per call and returns the profile as struct array
+% 'profile'. It aborts with an error if the profiler did not count exactly
+% 'nrCalls' calls of each.
+
+if nargin < 1 || isempty(nrCalls)
+    nrCalls = 10000;
+end
+
+% Reset and enable profiling:
+Screen('ProfileModuleFunctionsHelper', 1);
+
+for i = 1:nrCalls
+    Screen('Null');
+    Screen('Screens');
+    Screen('Windows');
+    Screen('Preference', 'Verbosity');
+end
+
+% Print and disable profiling:
+profile = Screen('ProfileModuleFunctionsHelper', 3);
+Screen('ProfileModuleFunctionsHelper', 2);
+
+for name = {'Null', 'Screens', 'Windows', 'Preference'}
+    idx = find(strcmp({profile.Name}, name{1}));
+    if isempty(idx)
+        error('The profiler did not count any calls of Screen(''%s'')!', name{1});
+    end
+
+    if profile(idx).CallCount ~= nrCalls
+        error('The profiler counted %i calls of Screen(''%s''), instead of %i!', profile(idx).CallCount, name{1}, nrCalls);
+    end
+
+    fprintf('Screen(''%s''): %8.3f usecs per call, thereof %8.3f usecs in scripting glue.\n', ...
+            name{1}, 1e6 * profile(idx).TotalSecs / nrCalls, 1e6 * profile(idx).GlueSecs / nrCalls);
+end
+
+return;
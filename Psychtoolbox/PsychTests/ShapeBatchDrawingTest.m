@@ -0,0 +1,76 @@
+function ShapeBatchDrawingTest(nrShapes, ovalTolerance, screenid)
+% ShapeBatchDrawingTest([nrShapes=2000][, ovalTolerance=0.001][, screenid=max])
+%
+% Test instanced batch drawing of ovals and rects with Screen('FillOval'),
+% Screen('FrameOval'), Screen('FillRect') and Screen('FrameRect').
+%
+% If supported by the graphics driver, Screen draws a batch of multiple
+% shapes with one instanced draw call. Setting the Screen('Preference',
+% 'ConserveVRAM') flag 2^31, aka kPsychDontUseInstancedShapes, disables
+% this, so each shape is drawn with its own draw calls.
+%
+% For each function, 'nrShapes' alpha blended shapes of random position,
+% size, color and pen width are drawn both ways. Pens are up to 8 pixels
+% wide, shapes down to 2 pixels, so many frame sides overlap each other.
+% Rects must be identical both ways. The vertices of instanced ovals are
+% computed on the gpu, whereas one by one drawing computes them on the cpu,
+% so float rounding can move a few pixels on oval edges. Ovals may differ
+% in up to a fraction 'ovalTolerance' of all pixels. The test aborts with
+% an error if the images differ by more than that. It then prints the time
+% per frame of 'nrShapes' shapes with both ways.
+
+if nargin < 1 || isempty(nrShapes)
+    nrShapes = 2000;
+end
+
+if nargin < 2 || isempty(ovalTolerance)
+    ovalTolerance = 0.001;
+end
+
+if nargin < 3 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+PsychDefaultSetup(1);
+
+try
+    win = Screen('OpenWindow', screenid, 0);
+    [w, h] = Screen('WindowSize', win);
+    Screen('BlendFunction', win, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    x = rand(1, nrShapes) * w;
+    y = rand(1, nrShapes) * h;
+    rects = round([x; y; x + 2 + rand(1, nrShapes) * 60; y + 2 + rand(1, nrShapes) * 60]);
+    colors = round(rand(4, nrShapes) * 255);
+    pens = 1 + round(rand(1, nrShapes) * 7);
+
+    for func = {'FillOval', 'FrameOval', 'FillRect', 'FrameRect'}
+        if strfind(func{1}, 'Frame')
+            args = {colors, rects, pens};
+        else
+            args = {colors, rects};
+        end
+
+        [img, msecs] = CompareConserveVRAMDrawing(win, 2^31, @(i) Screen(func{1}, win, args{:}));
+
+        nrDiffPixels = nnz(any(img{1} ~= img{2}, 3));
+        fprintf('%-10s: %6i pixels differ. Instanced %8.3f msecs, one by one %8.3f msecs per frame.\n', func{1}, nrDiffPixels, msecs(1), msecs(2));
+
+        if isempty(strfind(func{1}, 'Oval'))
+            maxDiffPixels = 0;
+        else
+            maxDiffPixels = ovalTolerance * w * h;
+        end
+
+        if nrDiffPixels > maxDiffPixels
+            error('Instanced %s differs in %i pixels from one by one drawing, more than the tolerance of %i pixels!', func{1}, nrDiffPixels, floor(maxDiffPixels));
+        end
+    end
+catch
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+sca;
+
+return;
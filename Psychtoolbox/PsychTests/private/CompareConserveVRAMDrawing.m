@@ -0,0 +1,48 @@
+function [img, msecs] = CompareConserveVRAMDrawing(win, flag, drawFunc, nrFrames)
+% [img, msecs] = CompareConserveVRAMDrawing(win, flag, drawFunc [, nrFrames=50])
+%
+% Helper for tests of drawing paths that a Screen('Preference',
+% 'ConserveVRAM') flag can disable: Draws with the ConserveVRAM flag 'flag'
+% cleared, then with it set. Each time, the function handle 'drawFunc' is
+% called as drawFunc(i) to draw frame i into onscreen window 'win'. Frame 0
+% is drawn into a cleared backbuffer and read back, frames 1 to 'nrFrames'
+% are drawn and flipped without sync to retrace.
+%
+% Returns the backbuffer images of frame 0 as double matrices in img{1}
+% with the flag cleared, and img{2} with the flag set, and the time per
+% frame in msecs for frames 1 to 'nrFrames' in msecs(1) and msecs(2). The
+% previous ConserveVRAM setting is restored on return, also on error.
+
+if nargin < 4 || isempty(nrFrames)
+    nrFrames = 50;
+end
+
+oldconserve = Screen('Preference', 'ConserveVRAM');
+img = cell(1, 2);
+msecs = zeros(1, 2);
+
+try
+    for k = 1:2
+        Screen('Preference', 'ConserveVRAM', bitor(oldconserve, flag * (k - 1)));
+
+        Screen('FillRect', win, 0);
+        drawFunc(0);
+        img{k} = double(Screen('GetImage', win, [], 'backBuffer'));
+
+        Screen('Flip', win);
+        t0 = GetSecs;
+        for i = 1:nrFrames
+            drawFunc(i);
+            Screen('Flip', win, [], [], 2);
+        end
+        Screen('DrawingFinished', win, [], 1);
+        msecs(k) = 1000 * (GetSecs - t0) / nrFrames;
+    end
+catch
+    Screen('Preference', 'ConserveVRAM', oldconserve);
+    psychrethrow(psychlasterror);
+end
+
+Screen('Preference', 'ConserveVRAM', oldconserve);
+
+return;